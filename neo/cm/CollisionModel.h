@@ -117,6 +117,9 @@ public:
 	virtual void			Translation( trace_t *results, const idVec3 &start, const idVec3 &end,
 								const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
 								cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis ) = 0;
+	// Translates points and reports the first collision of each point if any, results[i] is the trace from starts[i] to ends[i].
+	virtual void			TracePoints( trace_t *results, const idVec3 *starts, const idVec3 *ends, const int numPoints, int contentMask,
+								cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis ) = 0;
 	// Rotates a trace model and reports the first collision if any.
 	virtual void			Rotation( trace_t *results, const idVec3 &start, const idRotation &rotation,
 								const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
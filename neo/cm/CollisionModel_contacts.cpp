@@ -57,19 +57,21 @@ int idCollisionModelManagerLocal::Contacts( contactInfo_t *contacts, const int m
 								cmHandle_t model, const idVec3 &origin, const idMat3 &modelAxis ) {
 	trace_t results;
 	idVec3 end;
+	cm_threadWork_t *work;
 
 	// same as Translation but instead of storing the first collision we store all collisions as contacts
-	idCollisionModelManagerLocal::getContacts = true;
-	idCollisionModelManagerLocal::contacts = contacts;
-	idCollisionModelManagerLocal::maxContacts = maxContacts;
-	idCollisionModelManagerLocal::numContacts = 0;
+	work = idCollisionModelManagerLocal::GetThreadWork();
+	work->getContacts = true;
+	work->contacts = contacts;
+	work->maxContacts = maxContacts;
+	work->numContacts = 0;
 	end = start + dir.SubVec3(0) * depth;
 	idCollisionModelManagerLocal::Translation( &results, start, end, trm, trmAxis, contentMask, model, origin, modelAxis );
 	if ( dir.SubVec3(1).LengthSqr() != 0.0f ) {
 		// FIXME: rotational contacts
 	}
-	idCollisionModelManagerLocal::getContacts = false;
-	idCollisionModelManagerLocal::maxContacts = 0;
+	work->getContacts = false;
+	work->maxContacts = 0;
 
-	return idCollisionModelManagerLocal::numContacts;
+	return work->numContacts;
 }
@@ -59,10 +59,10 @@ bool idCollisionModelManagerLocal::TestTrmVertsInBrush( cm_traceWork_t *tw, cm_b
 	float d, bestd;
 	idVec3 *p;
 
-	if ( b->checkcount == idCollisionModelManagerLocal::checkCount ) {
+	if ( tw->brushChecks[b->checkNum] == tw->checkCount ) {
 		return false;
 	}
-	b->checkcount = idCollisionModelManagerLocal::checkCount;
+	tw->brushChecks[b->checkNum] = tw->checkCount;
 
 	if ( !(b->contents & tw->contents) ) {
 		return false;
@@ -131,18 +131,18 @@ CM_SetTrmEdgeSidedness
 CM_SetTrmPolygonSidedness
 ================
 */
-#define CM_SetTrmPolygonSidedness( v, plane, bitNum ) {								\
-	if ( !((v)->sideSet & (1<<bitNum)) ) {											\
+#define CM_SetTrmPolygonSidedness( v, vc, plane, bitNum ) {							\
+	if ( !((vc)->sideSet & (1<<bitNum)) ) {											\
 		float fl;																	\
 		fl = plane.Distance( (v)->p );												\
 		/* cannot use float sign bit because it is undetermined when fl == 0.0f */	\
 		if ( fl < 0.0f ) {															\
-			(v)->side |= (1 << bitNum);												\
+			(vc)->side |= (1 << bitNum);											\
 		}																			\
 		else {																		\
-			(v)->side &= ~(1 << bitNum);											\
+			(vc)->side &= ~(1 << bitNum);											\
 		}																			\
-		(v)->sideSet |= (1 << bitNum);												\
+		(vc)->sideSet |= (1 << bitNum);												\
 	}																				\
 }
 
@@ -160,12 +160,13 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t *tw, cm_poly
 	cm_trmEdge_t *trmEdge;
 	cm_edge_t *edge;
 	cm_vertex_t *v, *v1, *v2;
+	cm_featureCheck_t *edgeCheck, *vc, *vc1, *vc2;
 
 	// if already checked this polygon
-	if ( p->checkcount == idCollisionModelManagerLocal::checkCount ) {
+	if ( tw->polygonChecks[p->checkNum] == tw->checkCount ) {
 		return false;
 	}
-	p->checkcount = idCollisionModelManagerLocal::checkCount;
+	tw->polygonChecks[p->checkNum] = tw->checkCount;
 
 	// if this polygon does not have the right contents behind it
 	if ( !(p->contents & tw->contents) ) {
@@ -197,14 +198,14 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t *tw, cm_poly
 			edgeNum = p->edges[i];
 			edge = tw->model->edges + abs(edgeNum);
 			// if this edge is already tested
-			if ( edge->checkcount == idCollisionModelManagerLocal::checkCount ) {
+			if ( tw->edgeChecks[abs(edgeNum)].checkcount == tw->checkCount ) {
 				continue;
 			}
 
 			for ( j = 0; j < 2; j++ ) {
 				v = &tw->model->vertices[edge->vertexNum[j]];
 				// if this vertex is already tested
-				if ( v->checkcount == idCollisionModelManagerLocal::checkCount ) {
+				if ( tw->vertexChecks[edge->vertexNum[j]].checkcount == tw->checkCount ) {
 					continue;
 				}
 
@@ -239,19 +240,20 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t *tw, cm_poly
 	for ( i = 0; i < p->numEdges; i++ ) {
 		edgeNum = p->edges[i];
 		edge = tw->model->edges + abs(edgeNum);
+		edgeCheck = tw->edgeChecks + abs(edgeNum);
 		// reset sidedness cache if this is the first time we encounter this edge
-		if ( edge->checkcount != idCollisionModelManagerLocal::checkCount ) {
-			edge->sideSet = 0;
+		if ( edgeCheck->checkcount != tw->checkCount ) {
+			edgeCheck->sideSet = 0;
 		}
 		// pluecker coordinate for edge
 		tw->polygonEdgePlueckerCache[i].FromLine( tw->model->vertices[edge->vertexNum[0]].p,
 													tw->model->vertices[edge->vertexNum[1]].p );
-		v = &tw->model->vertices[edge->vertexNum[INTSIGNBITSET(edgeNum)]];
+		vc = tw->vertexChecks + edge->vertexNum[INTSIGNBITSET(edgeNum)];
 		// reset sidedness cache if this is the first time we encounter this vertex
-		if ( v->checkcount != idCollisionModelManagerLocal::checkCount ) {
-			v->sideSet = 0;
+		if ( vc->checkcount != tw->checkCount ) {
+			vc->sideSet = 0;
 		}
-		v->checkcount = idCollisionModelManagerLocal::checkCount;
+		vc->checkcount = tw->checkCount;
 	}
 
 	// get side of polygon for each trm vertex
@@ -273,8 +275,9 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t *tw, cm_poly
 			edgeNum = p->edges[j];
 			edge = tw->model->edges + abs(edgeNum);
 #if 1
-			CM_SetTrmEdgeSidedness( edge, tw->edges[i].pl, tw->polygonEdgePlueckerCache[j], i );
-			if ( INTSIGNBITSET(edgeNum) ^ ((edge->side >> i) & 1) ^ flip ) {
+			edgeCheck = tw->edgeChecks + abs(edgeNum);
+			CM_SetTrmEdgeSidedness( edgeCheck, tw->edges[i].pl, tw->polygonEdgePlueckerCache[j], i );
+			if ( INTSIGNBITSET(edgeNum) ^ ((edgeCheck->side >> i) & 1) ^ flip ) {
 				break;
 			}
 #else
@@ -312,22 +315,25 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t *tw, cm_poly
 	for ( i = 0; i < p->numEdges; i++ ) {
 		edgeNum = p->edges[i];
 		edge = tw->model->edges + abs(edgeNum);
-		if ( edge->checkcount == idCollisionModelManagerLocal::checkCount ) {
+		edgeCheck = tw->edgeChecks + abs(edgeNum);
+		if ( edgeCheck->checkcount == tw->checkCount ) {
 			continue;
 		}
-		edge->checkcount = idCollisionModelManagerLocal::checkCount;
+		edgeCheck->checkcount = tw->checkCount;
 
 		for ( j = 0; j < tw->numPolys; j++ ) {
 #if 1
 			v1 = tw->model->vertices + edge->vertexNum[0];
-			CM_SetTrmPolygonSidedness( v1, tw->polys[j].plane, j );
+			vc1 = tw->vertexChecks + edge->vertexNum[0];
+			CM_SetTrmPolygonSidedness( v1, vc1, tw->polys[j].plane, j );
 			v2 = tw->model->vertices + edge->vertexNum[1];
-			CM_SetTrmPolygonSidedness( v2, tw->polys[j].plane, j );
+			vc2 = tw->vertexChecks + edge->vertexNum[1];
+			CM_SetTrmPolygonSidedness( v2, vc2, tw->polys[j].plane, j );
 			// if the polygon edge does not cross the trm polygon plane
-			if ( !(((v1->side ^ v2->side) >> j) & 1) ) {
+			if ( !(((vc1->side ^ vc2->side) >> j) & 1) ) {
 				continue;
 			}
-			flip = (v1->side >> j) & 1;
+			flip = (vc1->side >> j) & 1;
 #else
 			float d1, d2;
 
@@ -350,8 +356,8 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t *tw, cm_poly
 				trmEdge = tw->edges + abs(trmEdgeNum);
 #if 1
 				bitNum = abs(trmEdgeNum);
-				CM_SetTrmEdgeSidedness( edge, trmEdge->pl, tw->polygonEdgePlueckerCache[i], bitNum );
-				if ( INTSIGNBITSET(trmEdgeNum) ^ ((edge->side >> bitNum) & 1) ^ flip ) {
+				CM_SetTrmEdgeSidedness( edgeCheck, trmEdge->pl, tw->polygonEdgePlueckerCache[i], bitNum );
+				if ( INTSIGNBITSET(trmEdgeNum) ^ ((edgeCheck->side >> bitNum) & 1) ^ flip ) {
 					break;
 				}
 #else
@@ -423,7 +429,11 @@ int idCollisionModelManagerLocal::PointContents( const idVec3 p, cmHandle_t mode
 	cm_brush_t *b;
 	idPlane *plane;
 
-	node = idCollisionModelManagerLocal::PointNode( p, idCollisionModelManagerLocal::models[model] );
+	if ( model == TRACE_MODEL_HANDLE ) {
+		node = idCollisionModelManagerLocal::PointNode( p, idCollisionModelManagerLocal::GetThreadWork()->trmModel );
+	} else {
+		node = idCollisionModelManagerLocal::PointNode( p, idCollisionModelManagerLocal::models[model] );
+	}
 	for ( bref = node->brushes; bref; bref = bref->next ) {
 		b = bref->b;
 		// test if the point is within the brush bounds
@@ -482,6 +492,7 @@ int idCollisionModelManagerLocal::ContentsTrm( trace_t *results, const idVec3 &s
 	bool model_rotated, trm_rotated;
 	idMat3 invModelAxis, tmpAxis;
 	idVec3 dir;
+	cm_threadWork_t *work;
 	ALIGN16( cm_traceWork_t tw );
 
 	// fast point case
@@ -497,7 +508,7 @@ int idCollisionModelManagerLocal::ContentsTrm( trace_t *results, const idVec3 &s
 		return results->c.contents;
 	}
 
-	idCollisionModelManagerLocal::checkCount++;
+	work = idCollisionModelManagerLocal::GetThreadWork();
 
 	tw.trace.fraction = 1.0f;
 	tw.trace.c.contents = 0;
@@ -509,7 +520,8 @@ int idCollisionModelManagerLocal::ContentsTrm( trace_t *results, const idVec3 &s
 	tw.pointTrace = false;
 	tw.quickExit = false;
 	tw.numContacts = 0;
-	tw.model = idCollisionModelManagerLocal::models[model];
+	tw.model = idCollisionModelManagerLocal::ThreadModel( model, work );
+	idCollisionModelManagerLocal::SetupTraceWork( &tw, work );
 	tw.start = start - modelOrigin;
 	tw.end = tw.start;
 
@@ -632,7 +644,7 @@ int idCollisionModelManagerLocal::Contents( const idVec3 &start,
 		common->Printf("idCollisionModelManagerLocal::Contents: invalid model handle\n");
 		return 0;
 	}
-	if ( !idCollisionModelManagerLocal::models || !idCollisionModelManagerLocal::models[model] ) {
+	if ( !idCollisionModelManagerLocal::models || ( model != TRACE_MODEL_HANDLE && !idCollisionModelManagerLocal::models[model] ) ) {
 		common->Printf("idCollisionModelManagerLocal::Contents: invalid model\n");
 		return 0;
 	}
@@ -323,7 +323,7 @@ void idCollisionModelManagerLocal::DrawModel( cmHandle_t handle, const idVec3 &m
 		cm_drawColor.ClearModified();
 	}
 
-	model = models[ handle ];
+	model = ThreadModel( handle, GetThreadWork() );
 	viewPos = (viewOrigin - modelOrigin) * modelAxis.Transpose();
 	checkCount++;
 	DrawNodePolygons( model, model->node, modelOrigin, modelAxis, viewPos, radius );
@@ -350,6 +350,8 @@ static idCVar cm_testWalk(			"cm_testWalk",			"1",					CVAR_GAME | CVAR_BOOL,		"
 static idCVar cm_testLength(		"cm_testLength",		"1024",					CVAR_GAME | CVAR_FLOAT,		"" );
 static idCVar cm_testRadius(		"cm_testRadius",		"64",					CVAR_GAME | CVAR_FLOAT,		"" );
 static idCVar cm_testAngle(			"cm_testAngle",			"60",					CVAR_GAME | CVAR_FLOAT,		"" );
+static idCVar cm_testThreads(		"cm_testThreads",		"0",					CVAR_GAME | CVAR_BOOL,		"compare collision detection on the job threads with the results of a single thread" );
+static idCVar cm_testTracePoints(	"cm_testTracePoints",	"0",					CVAR_GAME | CVAR_BOOL,		"compare batched point traces with single point traces" );
 
 static int total_translation;
 static int min_translation = 999999;
@@ -364,6 +366,235 @@ static idVec3 *testend;
 
 #include "../sys/sys_public.h"
 
+typedef struct cm_threadTest_s {
+	const idTraceModel *	trm;
+	idMat3					trmAxis;
+	cmHandle_t				model;
+	idVec3					start;
+	const idVec3 *			ends;
+	const idRotation *		rotations;
+	trace_t *				translations;
+	trace_t *				rotationTraces;
+	int *					contents;
+} cm_threadTest_t;
+
+/*
+================
+CM_ThreadTestJob
+================
+*/
+static void CM_ThreadTestJob( void *data, int first, int last ) {
+	cm_threadTest_t *test = (cm_threadTest_t *) data;
+
+	for ( int i = first; i < last; i++ ) {
+		collisionModelManager->Translation( &test->translations[i], test->start, test->ends[i], test->trm, test->trmAxis,
+											CONTENTS_SOLID|CONTENTS_PLAYERCLIP, test->model, vec3_origin, mat3_identity );
+		collisionModelManager->Rotation( &test->rotationTraces[i], test->start, test->rotations[i], test->trm, test->trmAxis,
+											CONTENTS_SOLID|CONTENTS_PLAYERCLIP, test->model, vec3_origin, mat3_identity );
+		test->contents[i] = collisionModelManager->Contents( test->ends[i], test->trm, test->trmAxis, -1, test->model, vec3_origin, mat3_identity );
+	}
+}
+
+/*
+================
+CM_TracesEqual
+================
+*/
+static bool CM_TracesEqual( const trace_t &a, const trace_t &b ) {
+	if ( a.fraction != b.fraction || a.endpos != b.endpos || a.endAxis != b.endAxis ) {
+		return false;
+	}
+	if ( a.fraction >= 1.0f ) {
+		return true;
+	}
+	return ( a.c.type == b.c.type && a.c.normal == b.c.normal && a.c.dist == b.c.dist && a.c.point == b.c.point &&
+				a.c.contents == b.c.contents && a.c.material == b.c.material &&
+				a.c.modelFeature == b.c.modelFeature && a.c.trmFeature == b.c.trmFeature );
+}
+
+/*
+================
+CM_TestThreads
+
+  runs the same translations, rotations and contents tests in a single thread and on the job threads
+================
+*/
+static void CM_TestThreads( const idTraceModel &itm, const idMat3 &boxAxis, idRandom &random ) {
+	int i, numTests, numErrors, serialTime, threadTime;
+	cm_threadTest_t serial, threaded;
+	idVec3 *ends;
+	idRotation *rotations;
+	idTimer timer;
+
+	numTests = cm_testTimes.GetInteger();
+
+	ends = new idVec3[numTests];
+	rotations = new idRotation[numTests];
+	for ( i = 0; i < numTests; i++ ) {
+		ends[i] = start + idVec3( random.CRandomFloat(), random.CRandomFloat(), random.CRandomFloat() ) * cm_testLength.GetFloat();
+		idVec3 vec( random.CRandomFloat(), random.CRandomFloat(), random.RandomFloat() );
+		vec.Normalize();
+		rotations[i].Set( start + idVec3( random.CRandomFloat(), random.CRandomFloat(), random.CRandomFloat() ) * cm_testRadius.GetFloat(),
+							vec, cm_testAngle.GetFloat() );
+	}
+
+	serial.trm = threaded.trm = &itm;
+	serial.trmAxis = threaded.trmAxis = boxAxis;
+	serial.model = threaded.model = cm_testModel.GetInteger();
+	serial.start = threaded.start = start;
+	serial.ends = threaded.ends = ends;
+	serial.rotations = threaded.rotations = rotations;
+	serial.translations = new trace_t[numTests];
+	serial.rotationTraces = new trace_t[numTests];
+	serial.contents = new int[numTests];
+	threaded.translations = new trace_t[numTests];
+	threaded.rotationTraces = new trace_t[numTests];
+	threaded.contents = new int[numTests];
+
+	timer.Clear();
+	timer.Start();
+	CM_ThreadTestJob( &serial, 0, numTests );
+	timer.Stop();
+	serialTime = timer.Milliseconds();
+
+	timer.Clear();
+	timer.Start();
+	jobSystem->ParallelFor( CM_ThreadTestJob, &threaded, numTests, 16 );
+	timer.Stop();
+	threadTime = timer.Milliseconds();
+
+	numErrors = 0;
+	for ( i = 0; i < numTests; i++ ) {
+		if ( !CM_TracesEqual( serial.translations[i], threaded.translations[i] ) ) {
+			common->Printf( "translation %d differs: fraction %f != %f\n", i, serial.translations[i].fraction, threaded.translations[i].fraction );
+			numErrors++;
+		}
+		if ( !CM_TracesEqual( serial.rotationTraces[i], threaded.rotationTraces[i] ) ) {
+			common->Printf( "rotation %d differs: fraction %f != %f\n", i, serial.rotationTraces[i].fraction, threaded.rotationTraces[i].fraction );
+			numErrors++;
+		}
+		if ( serial.contents[i] != threaded.contents[i] ) {
+			common->Printf( "contents %d differs: %d != %d\n", i, serial.contents[i], threaded.contents[i] );
+			numErrors++;
+		}
+	}
+
+	common->Printf( "%d x 3 tests: %4d milliseconds single thread, %4d milliseconds on %d threads, %d differences\n",
+					numTests, serialTime, threadTime, jobSystem->NumThreads(), numErrors );
+
+	delete[] serial.translations;
+	delete[] serial.rotationTraces;
+	delete[] serial.contents;
+	delete[] threaded.translations;
+	delete[] threaded.rotationTraces;
+	delete[] threaded.contents;
+	delete[] rotations;
+	delete[] ends;
+}
+
+/*
+================
+CM_CompareTracePoints
+
+  traces the same points one by one and all at once, returns the number of differing traces
+================
+*/
+static int CM_CompareTracePoints( const idVec3 *starts, const idVec3 *ends, const int numTests, trace_t *singleTraces, double &singleTime, double &batchTime ) {
+	int i, numErrors;
+	trace_t *batchTraces;
+	idTimer timer;
+
+	batchTraces = new trace_t[numTests];
+
+	timer.Clear();
+	timer.Start();
+	for ( i = 0; i < numTests; i++ ) {
+		collisionModelManager->Translation( &singleTraces[i], starts[i], ends[i], NULL, mat3_identity, CONTENTS_SOLID|CONTENTS_PLAYERCLIP, cm_testModel.GetInteger(), vec3_origin, mat3_identity );
+	}
+	timer.Stop();
+	singleTime = timer.Milliseconds();
+
+	timer.Clear();
+	timer.Start();
+	collisionModelManager->TracePoints( batchTraces, starts, ends, numTests, CONTENTS_SOLID|CONTENTS_PLAYERCLIP, cm_testModel.GetInteger(), vec3_origin, mat3_identity );
+	timer.Stop();
+	batchTime = timer.Milliseconds();
+
+	numErrors = 0;
+	for ( i = 0; i < numTests; i++ ) {
+		if ( !CM_TracesEqual( singleTraces[i], batchTraces[i] ) ) {
+			common->Printf( "point trace %d differs: fraction %f != %f\n", i, singleTraces[i].fraction, batchTraces[i].fraction );
+			numErrors++;
+		}
+	}
+
+	delete[] batchTraces;
+
+	return numErrors;
+}
+
+/*
+================
+CM_TestTracePoints
+
+  traces the same points one by one and all at once, then traces again from the
+  surfaces that were hit, once starting on the surface and once starting inside
+  the solid, where the coplanar and overlapping polygons of touching brushes all
+  give a zero fraction
+================
+*/
+static void CM_TestTracePoints( idRandom &random ) {
+	int i, numTests, numErrors, numSolidTests, numSolidErrors;
+	double singleTime, batchTime, solidSingleTime, solidBatchTime;
+	idVec3 *starts, *ends, *solidStarts, *solidEnds, dir;
+	trace_t *singleTraces, *solidTraces;
+
+	numTests = cm_testTimes.GetInteger();
+
+	starts = new idVec3[numTests];
+	ends = new idVec3[numTests];
+	singleTraces = new trace_t[numTests];
+	for ( i = 0; i < numTests; i++ ) {
+		starts[i] = start;
+		ends[i] = start + idVec3( random.CRandomFloat(), random.CRandomFloat(), random.CRandomFloat() ) * cm_testLength.GetFloat();
+	}
+
+	numErrors = CM_CompareTracePoints( starts, ends, numTests, singleTraces, singleTime, batchTime );
+
+	common->Printf( "%d point traces: %1.3f microseconds per trace single, %1.3f microseconds per trace batched, %d differences\n",
+					numTests, singleTime * 1000.0 / numTests, batchTime * 1000.0 / numTests, numErrors );
+
+	solidStarts = new idVec3[numTests * 2];
+	solidEnds = new idVec3[numTests * 2];
+	solidTraces = new trace_t[numTests * 2];
+	numSolidTests = 0;
+	for ( i = 0; i < numTests; i++ ) {
+		if ( singleTraces[i].fraction >= 1.0f ) {
+			continue;
+		}
+		dir = ends[i] - starts[i];
+		dir.Normalize();
+		solidStarts[numSolidTests] = singleTraces[i].c.point;
+		solidEnds[numSolidTests] = singleTraces[i].c.point + dir * cm_testLength.GetFloat();
+		numSolidTests++;
+		solidStarts[numSolidTests] = singleTraces[i].c.point + dir;
+		solidEnds[numSolidTests] = singleTraces[i].c.point + dir * cm_testLength.GetFloat();
+		numSolidTests++;
+	}
+
+	if ( numSolidTests ) {
+		numSolidErrors = CM_CompareTracePoints( solidStarts, solidEnds, numSolidTests, solidTraces, solidSingleTime, solidBatchTime );
+		common->Printf( "%d point traces from the surfaces hit: %d differences\n", numSolidTests, numSolidErrors );
+	}
+
+	delete[] solidTraces;
+	delete[] solidEnds;
+	delete[] solidStarts;
+	delete[] singleTraces;
+	delete[] ends;
+	delete[] starts;
+}
+
 void idCollisionModelManagerLocal::DebugOutput( const idVec3 &origin ) {
 	int i, k, t;
 	char buf[128];
@@ -483,6 +714,14 @@ void idCollisionModelManagerLocal::DebugOutput( const idVec3 &origin ) {
 		common->Printf("%s rotation: %4d milliseconds, (min = %d, max = %d, av = %1.1f)\n", buf, t, min_rotation, max_rotation, (float) total_rotation / num_rotation );
 	}
 
+	if ( cm_testThreads.GetBool() ) {
+		CM_TestThreads( itm, boxAxis, random );
+	}
+
+	if ( cm_testTracePoints.GetBool() ) {
+		CM_TestTracePoints( random );
+	}
+
 	Mem_Free( testend );
 	testend = NULL;
 }
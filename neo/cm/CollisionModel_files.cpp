@@ -328,8 +328,6 @@ void idCollisionModelManagerLocal::ParseVertices( idLexer *src, cm_model_t *mode
 	model->vertices = (cm_vertex_t *) Mem_Alloc( model->maxVertices * sizeof( cm_vertex_t ) );
 	for ( i = 0; i < model->numVertices; i++ ) {
 		src->Parse1DMatrix( 3, model->vertices[i].p.ToFloatPtr() );
-		model->vertices[i].side = 0;
-		model->vertices[i].sideSet = 0;
 		model->vertices[i].checkcount = 0;
 	}
 	src->ExpectTokenString( "}" );
@@ -352,8 +350,6 @@ void idCollisionModelManagerLocal::ParseEdges( idLexer *src, cm_model_t *model )
 		model->edges[i].vertexNum[0] = src->ParseInt();
 		model->edges[i].vertexNum[1] = src->ParseInt();
 		src->ExpectTokenString( ")" );
-		model->edges[i].side = 0;
-		model->edges[i].sideSet = 0;
 		model->edges[i].internal = src->ParseInt();
 		model->edges[i].numUsers = src->ParseInt();
 		model->edges[i].normal = vec3_origin;
@@ -557,6 +553,12 @@ bool idCollisionModelManagerLocal::LoadCollisionModelFile( const char *name, uns
 	idToken token;
 	idLexer *src;
 	unsigned int crc;
+	int firstModel;
+
+	// load the binary file if it was written for this map
+	if ( LoadBinaryCollisionModelFile( name, mapFileCRC ) ) {
+		return true;
+	}
 
 	// load it
 	fileName = name;
@@ -594,6 +596,7 @@ bool idCollisionModelManagerLocal::LoadCollisionModelFile( const char *name, uns
 	}
 
 	// parse the file
+	firstModel = numModels;
 	while ( 1 ) {
 		if ( !src->ReadToken( &token ) ) {
 			break;
@@ -612,5 +615,614 @@ bool idCollisionModelManagerLocal::LoadCollisionModelFile( const char *name, uns
 
 	delete src;
 
+	// write the binary file for the next time this map is loaded
+	WriteBinaryCollisionModelsToFile( name, firstModel, numModels, mapFileCRC );
+
+	return true;
+}
+
+
+/*
+===============================================================================
+
+Binary collision model cache
+
+  The .cmb file is written next to the .cm file and is only used when it was
+  written for the same map file CRC. Every model is stored as a single block
+  with the vertices, edges, nodes, references, polygons and brushes laid out
+  in the same way as they are used at run time. Pointers are stored as offsets
+  into the block plus one and polygon materials as indexes into the material
+  names of the model plus one. Loading a model is one read followed by fixing
+  up the pointers. The data is stored in native byte order and the file is
+  rejected on platforms with a different byte order or structure layout.
+
+===============================================================================
+*/
+
+#define CMB_FILE_EXT		"cmb"
+#define CMB_FILEID			( ( '1' << 24 ) | ( 'B' << 16 ) | ( 'M' << 8 ) | 'C' )
+#define CMB_FILEVERSION		1
+#define CMB_ALIGN( x )		( ( (x) + 15 ) & ~15 )
+
+typedef struct cmb_layout_s {
+	int						verticesOffset;
+	int						edgesOffset;
+	int						nodesOffset;
+	int						polygonRefsOffset;
+	int						brushRefsOffset;
+	int						polygonsOffset;
+	int						brushesOffset;
+	int						dataSize;
+} cmb_layout_t;
+
+typedef struct cmb_writer_s {
+	byte *					data;				// model data block being written
+	cmb_layout_t			layout;
+	int *					polygonOffsets;		// polygon offsets indexed with cm_polygon_t::checkNum
+	int *					brushOffsets;		// brush offsets indexed with cm_brush_t::checkNum
+	int						numNodes;
+	int						numPolygonRefs;
+	int						numBrushRefs;
+	int						polygonMemory;
+	int						brushMemory;
+	idList<const idMaterial *> materials;
+	idHashIndex				materialHash;
+} cmb_writer_t;
+
+/*
+================
+CMB_SetupLayout
+================
+*/
+static void CMB_SetupLayout( cmb_layout_t &layout, int numVertices, int numEdges, int numNodes, int numPolygonRefs, int numBrushRefs, int polygonMemory, int brushMemory ) {
+	layout.verticesOffset = 0;
+	layout.edgesOffset = CMB_ALIGN( layout.verticesOffset + numVertices * sizeof( cm_vertex_t ) );
+	layout.nodesOffset = CMB_ALIGN( layout.edgesOffset + numEdges * sizeof( cm_edge_t ) );
+	layout.polygonRefsOffset = CMB_ALIGN( layout.nodesOffset + numNodes * sizeof( cm_node_t ) );
+	layout.brushRefsOffset = CMB_ALIGN( layout.polygonRefsOffset + numPolygonRefs * sizeof( cm_polygonRef_t ) );
+	layout.polygonsOffset = CMB_ALIGN( layout.brushRefsOffset + numBrushRefs * sizeof( cm_brushRef_t ) );
+	layout.brushesOffset = CMB_ALIGN( layout.polygonsOffset + polygonMemory );
+	layout.dataSize = CMB_ALIGN( layout.brushesOffset + brushMemory );
+}
+
+/*
+================
+CMB_EncodePointer
+================
+*/
+ID_INLINE static void *CMB_EncodePointer( int offset ) {
+	return (void *) (intptr_t) ( offset + 1 );
+}
+
+/*
+================
+CMB_DecodePointer
+
+  returns false if the pointer is outside the given range of the data block
+================
+*/
+template< class type >
+ID_INLINE static bool CMB_DecodePointer( type *&ptr, byte *data, int start, int end ) {
+	int offset;
+
+	offset = (int) (intptr_t) ptr - 1;
+	if ( offset == -1 ) {
+		ptr = NULL;
+		return true;
+	}
+	if ( offset < start || offset >= end ) {
+		return false;
+	}
+	ptr = (type *) ( data + offset );
+	return true;
+}
+
+/*
+================
+CMB_CountTree_r
+
+  counts the nodes and references and assigns the polygons and brushes their offsets in the data block
+================
+*/
+static void CMB_CountTree_r( cmb_writer_t &w, cm_node_t *node, int checkCount ) {
+	cm_polygonRef_t *pref;
+	cm_brushRef_t *bref;
+
+	w.numNodes++;
+	for ( pref = node->polygons; pref; pref = pref->next ) {
+		w.numPolygonRefs++;
+		if ( pref->p->checkcount == checkCount ) {
+			continue;
+		}
+		pref->p->checkcount = checkCount;
+		w.polygonOffsets[pref->p->checkNum] = w.polygonMemory;
+		w.polygonMemory += sizeof( cm_polygon_t ) + ( pref->p->numEdges - 1 ) * sizeof( pref->p->edges[0] );
+	}
+	for ( bref = node->brushes; bref; bref = bref->next ) {
+		w.numBrushRefs++;
+		if ( bref->b->checkcount == checkCount ) {
+			continue;
+		}
+		bref->b->checkcount = checkCount;
+		w.brushOffsets[bref->b->checkNum] = w.brushMemory;
+		w.brushMemory += sizeof( cm_brush_t ) + ( bref->b->numPlanes - 1 ) * sizeof( bref->b->planes[0] );
+	}
+	if ( node->planeType != -1 ) {
+		CMB_CountTree_r( w, node->children[0], checkCount );
+		CMB_CountTree_r( w, node->children[1], checkCount );
+	}
+}
+
+/*
+================
+CMB_WriteTree_r
+
+  copies the tree into the data block in depth first order, returns the offset of the node
+================
+*/
+static int CMB_WriteTree_r( cmb_writer_t &w, cm_node_t *node, int parentOffset ) {
+	int i, offset, size;
+	cm_node_t *out;
+	cm_polygonRef_t *pref, *outPref, **prevPref;
+	cm_brushRef_t *bref, *outBref, **prevBref;
+	cm_polygon_t *p;
+	cm_brush_t *b;
+
+	offset = w.layout.nodesOffset + w.numNodes * sizeof( cm_node_t );
+	w.numNodes++;
+	out = (cm_node_t *) ( w.data + offset );
+	out->planeType = node->planeType;
+	out->planeDist = node->planeDist;
+	out->parent = ( parentOffset >= 0 ) ? (cm_node_t *) CMB_EncodePointer( parentOffset ) : NULL;
+
+	prevPref = &out->polygons;
+	for ( pref = node->polygons; pref; pref = pref->next ) {
+		p = (cm_polygon_t *) ( w.data + w.layout.polygonsOffset + w.polygonOffsets[pref->p->checkNum] );
+		// copy the polygon when it is referenced for the first time
+		if ( p->numEdges == 0 ) {
+			size = sizeof( cm_polygon_t ) + ( pref->p->numEdges - 1 ) * sizeof( pref->p->edges[0] );
+			memcpy( p, pref->p, size );
+			p->checkcount = 0;
+			i = w.materialHash.First( w.materialHash.GenerateKey( pref->p->material->GetName(), false ) );
+			for ( ; i != -1; i = w.materialHash.Next( i ) ) {
+				if ( w.materials[i] == pref->p->material ) {
+					break;
+				}
+			}
+			if ( i == -1 ) {
+				i = w.materials.Append( pref->p->material );
+				w.materialHash.Add( w.materialHash.GenerateKey( pref->p->material->GetName(), false ), i );
+			}
+			p->material = (const idMaterial *) CMB_EncodePointer( i );
+		}
+		outPref = (cm_polygonRef_t *) ( w.data + w.layout.polygonRefsOffset + w.numPolygonRefs * sizeof( cm_polygonRef_t ) );
+		*prevPref = (cm_polygonRef_t *) CMB_EncodePointer( (byte *) outPref - w.data );
+		outPref->p = (cm_polygon_t *) CMB_EncodePointer( (byte *) p - w.data );
+		prevPref = &outPref->next;
+		w.numPolygonRefs++;
+	}
+
+	prevBref = &out->brushes;
+	for ( bref = node->brushes; bref; bref = bref->next ) {
+		b = (cm_brush_t *) ( w.data + w.layout.brushesOffset + w.brushOffsets[bref->b->checkNum] );
+		// copy the brush when it is referenced for the first time, brush materials are not stored
+		if ( b->numPlanes == 0 ) {
+			size = sizeof( cm_brush_t ) + ( bref->b->numPlanes - 1 ) * sizeof( bref->b->planes[0] );
+			memcpy( b, bref->b, size );
+			b->checkcount = 0;
+			b->material = NULL;
+		}
+		outBref = (cm_brushRef_t *) ( w.data + w.layout.brushRefsOffset + w.numBrushRefs * sizeof( cm_brushRef_t ) );
+		*prevBref = (cm_brushRef_t *) CMB_EncodePointer( (byte *) outBref - w.data );
+		outBref->b = (cm_brush_t *) CMB_EncodePointer( (byte *) b - w.data );
+		prevBref = &outBref->next;
+		w.numBrushRefs++;
+	}
+
+	if ( node->planeType != -1 ) {
+		out->children[0] = (cm_node_t *) CMB_EncodePointer( CMB_WriteTree_r( w, node->children[0], offset ) );
+		out->children[1] = (cm_node_t *) CMB_EncodePointer( CMB_WriteTree_r( w, node->children[1], offset ) );
+	}
+	return offset;
+}
+
+/*
+================
+idCollisionModelManagerLocal::WriteBinaryCollisionModel
+================
+*/
+void idCollisionModelManagerLocal::WriteBinaryCollisionModel( idFile *fp, cm_model_t *model ) {
+	int i;
+	cm_vertex_t *vertices;
+	cm_edge_t *edges;
+	cmb_writer_t w;
+
+	w.polygonOffsets = (int *) Mem_Alloc( ( model->numPolygonChecks + 1 ) * sizeof( int ) );
+	w.brushOffsets = (int *) Mem_Alloc( ( model->numBrushChecks + 1 ) * sizeof( int ) );
+	w.numNodes = w.numPolygonRefs = w.numBrushRefs = 0;
+	w.polygonMemory = w.brushMemory = 0;
+	if ( model->node ) {
+		checkCount++;
+		CMB_CountTree_r( w, model->node, checkCount );
+	}
+
+	CMB_SetupLayout( w.layout, model->numVertices, model->numEdges, w.numNodes, w.numPolygonRefs, w.numBrushRefs, w.polygonMemory, w.brushMemory );
+	w.data = (byte *) Mem_ClearedAlloc( w.layout.dataSize );
+
+	vertices = (cm_vertex_t *) ( w.data + w.layout.verticesOffset );
+	memcpy( vertices, model->vertices, model->numVertices * sizeof( cm_vertex_t ) );
+	for ( i = 0; i < model->numVertices; i++ ) {
+		vertices[i].checkcount = 0;
+	}
+	edges = (cm_edge_t *) ( w.data + w.layout.edgesOffset );
+	memcpy( edges, model->edges, model->numEdges * sizeof( cm_edge_t ) );
+	for ( i = 0; i < model->numEdges; i++ ) {
+		edges[i].checkcount = 0;
+	}
+
+	w.numNodes = w.numPolygonRefs = w.numBrushRefs = 0;
+	if ( model->node ) {
+		CMB_WriteTree_r( w, model->node, -1 );
+	}
+
+	fp->WriteString( model->name );
+	fp->WriteVec3( model->bounds[0] );
+	fp->WriteVec3( model->bounds[1] );
+	fp->WriteInt( model->contents );
+	fp->WriteBool( model->isConvex );
+	fp->WriteInt( model->numVertices );
+	fp->WriteInt( model->numEdges );
+	fp->WriteInt( w.numNodes );
+	fp->WriteInt( w.numPolygonRefs );
+	fp->WriteInt( w.numBrushRefs );
+	fp->WriteInt( model->numPolygons );
+	fp->WriteInt( w.polygonMemory );
+	fp->WriteInt( model->numBrushes );
+	fp->WriteInt( w.brushMemory );
+	fp->WriteInt( model->numInternalEdges );
+	fp->WriteInt( model->numSharpEdges );
+	fp->WriteInt( model->numRemovedPolys );
+	fp->WriteInt( model->numMergedPolys );
+	fp->WriteInt( w.materials.Num() );
+	for ( i = 0; i < w.materials.Num(); i++ ) {
+		fp->WriteString( w.materials[i]->GetName() );
+	}
+	fp->WriteInt( w.layout.dataSize );
+	fp->Write( w.data, w.layout.dataSize );
+
+	Mem_Free( w.data );
+	Mem_Free( w.brushOffsets );
+	Mem_Free( w.polygonOffsets );
+}
+
+/*
+================
+idCollisionModelManagerLocal::WriteBinaryCollisionModelsToFile
+================
+*/
+void idCollisionModelManagerLocal::WriteBinaryCollisionModelsToFile( const char *filename, int firstModel, int lastModel, unsigned int mapFileCRC ) {
+	int i, byteOrder;
+	idFile *fp;
+	idStr name;
+
+	// the binary file is only used to load the collision models of a map faster
+	if ( !mapFileCRC ) {
+		return;
+	}
+
+	name = filename;
+	name.SetFileExtension( CMB_FILE_EXT );
+
+	common->Printf( "writing %s\n", name.c_str() );
+	fp = fileSystem->OpenFileWrite( name, "fs_devpath" );
+	if ( !fp ) {
+		common->Warning( "idCollisionModelManagerLocal::WriteBinaryCollisionModelsToFile: Error opening file %s\n", name.c_str() );
+		return;
+	}
+
+	// write file id, version and the layout of the data
+	byteOrder = 1;
+	fp->WriteInt( CMB_FILEID );
+	fp->WriteInt( CMB_FILEVERSION );
+	fp->Write( &byteOrder, sizeof( byteOrder ) );
+	fp->WriteInt( sizeof( void * ) );
+	fp->WriteInt( sizeof( cm_vertex_t ) );
+	fp->WriteInt( sizeof( cm_edge_t ) );
+	fp->WriteInt( sizeof( cm_node_t ) );
+	fp->WriteInt( sizeof( cm_polygon_t ) );
+	fp->WriteInt( sizeof( cm_brush_t ) );
+	// write the map file crc
+	fp->WriteUnsignedInt( mapFileCRC );
+
+	// write the collision models
+	fp->WriteInt( lastModel - firstModel );
+	for ( i = firstModel; i < lastModel; i++ ) {
+		WriteBinaryCollisionModel( fp, models[ i ] );
+	}
+
+	fileSystem->CloseFile( fp );
+}
+
+/*
+================
+idCollisionModelManagerLocal::ReadBinaryCollisionModel
+================
+*/
+cm_model_t *idCollisionModelManagerLocal::ReadBinaryCollisionModel( idFile *fp, const char *fileName ) {
+	int i, j, numNodes, numPolygonRefs, numBrushRefs, polygonMemory, brushMemory, numMaterials, dataSize, offset, size, materialNum;
+	idStr name;
+	idList<const idMaterial *> materials;
+	cmb_layout_t layout;
+	cm_model_t *model;
+	cm_node_t *node;
+	cm_polygonRef_t *pref;
+	cm_brushRef_t *bref;
+	cm_polygon_t *p;
+	cm_brush_t *b;
+	byte *data;
+
+	model = AllocModel();
+	fp->ReadString( model->name );
+	fp->ReadVec3( model->bounds[0] );
+	fp->ReadVec3( model->bounds[1] );
+	fp->ReadInt( model->contents );
+	fp->ReadBool( model->isConvex );
+	fp->ReadInt( model->numVertices );
+	fp->ReadInt( model->numEdges );
+	fp->ReadInt( numNodes );
+	fp->ReadInt( numPolygonRefs );
+	fp->ReadInt( numBrushRefs );
+	fp->ReadInt( model->numPolygons );
+	fp->ReadInt( polygonMemory );
+	fp->ReadInt( model->numBrushes );
+	fp->ReadInt( brushMemory );
+	fp->ReadInt( model->numInternalEdges );
+	fp->ReadInt( model->numSharpEdges );
+	fp->ReadInt( model->numRemovedPolys );
+	fp->ReadInt( model->numMergedPolys );
+	fp->ReadInt( numMaterials );
+	if ( numMaterials < 0 || numMaterials > model->numPolygons ) {
+		common->Warning( "%s has a bad material count", fileName );
+		delete model;
+		return NULL;
+	}
+	materials.SetNum( numMaterials );
+	for ( i = 0; i < numMaterials; i++ ) {
+		fp->ReadString( name );
+		materials[i] = declManager->FindMaterial( name );
+	}
+	fp->ReadInt( dataSize );
+
+	CMB_SetupLayout( layout, model->numVertices, model->numEdges, numNodes, numPolygonRefs, numBrushRefs, polygonMemory, brushMemory );
+	if ( model->numVertices < 0 || model->numEdges < 0 || numNodes < 1 || numPolygonRefs < 0 || numBrushRefs < 0 ||
+			polygonMemory < 0 || brushMemory < 0 || dataSize != layout.dataSize ) {
+		common->Warning( "%s has a bad layout for model %s", fileName, model->name.c_str() );
+		delete model;
+		return NULL;
+	}
+
+	// read all model data at once
+	data = (byte *) Mem_Alloc( dataSize );
+	if ( fp->Read( data, dataSize ) != dataSize ) {
+		common->Warning( "%s is truncated", fileName );
+		Mem_Free( data );
+		delete model;
+		return NULL;
+	}
+
+	model->binaryData = data;
+	model->maxVertices = model->numVertices;
+	model->vertices = (cm_vertex_t *) ( data + layout.verticesOffset );
+	model->maxEdges = model->numEdges;
+	model->edges = (cm_edge_t *) ( data + layout.edgesOffset );
+	model->node = (cm_node_t *) ( data + layout.nodesOffset );
+	model->numNodes = numNodes;
+	model->numPolygonRefs = numPolygonRefs;
+	model->numBrushRefs = numBrushRefs;
+	model->polygonMemory = polygonMemory;
+	model->brushMemory = brushMemory;
+	model->usedMemory = dataSize;
+
+	// fix up the pointers in the nodes and references
+	for ( i = 0; i < numNodes; i++ ) {
+		node = model->node + i;
+		if ( !CMB_DecodePointer( node->polygons, data, layout.polygonRefsOffset, layout.brushRefsOffset ) ||
+				!CMB_DecodePointer( node->brushes, data, layout.brushRefsOffset, layout.polygonsOffset ) ||
+					!CMB_DecodePointer( node->parent, data, layout.nodesOffset, layout.polygonRefsOffset ) ) {
+			break;
+		}
+		if ( node->planeType != -1 ) {
+			if ( !CMB_DecodePointer( node->children[0], data, layout.nodesOffset, layout.polygonRefsOffset ) ||
+					!CMB_DecodePointer( node->children[1], data, layout.nodesOffset, layout.polygonRefsOffset ) ||
+						!node->children[0] || !node->children[1] ) {
+				break;
+			}
+		}
+	}
+	if ( i < numNodes ) {
+		common->Warning( "%s has bad nodes for model %s", fileName, model->name.c_str() );
+		FreeModel( model );
+		return NULL;
+	}
+	for ( i = 0; i < numPolygonRefs; i++ ) {
+		pref = (cm_polygonRef_t *) ( data + layout.polygonRefsOffset ) + i;
+		if ( !CMB_DecodePointer( pref->p, data, layout.polygonsOffset, layout.brushesOffset ) || !pref->p ||
+				!CMB_DecodePointer( pref->next, data, layout.polygonRefsOffset, layout.brushRefsOffset ) ) {
+			break;
+		}
+	}
+	if ( i < numPolygonRefs ) {
+		common->Warning( "%s has bad polygon references for model %s", fileName, model->name.c_str() );
+		FreeModel( model );
+		return NULL;
+	}
+	for ( i = 0; i < numBrushRefs; i++ ) {
+		bref = (cm_brushRef_t *) ( data + layout.brushRefsOffset ) + i;
+		if ( !CMB_DecodePointer( bref->b, data, layout.brushesOffset, layout.dataSize ) || !bref->b ||
+				!CMB_DecodePointer( bref->next, data, layout.brushRefsOffset, layout.polygonsOffset ) ) {
+			break;
+		}
+	}
+	if ( i < numBrushRefs ) {
+		common->Warning( "%s has bad brush references for model %s", fileName, model->name.c_str() );
+		FreeModel( model );
+		return NULL;
+	}
+
+	// the edges and polygons index the vertices and edges without further checks in the traces
+	for ( i = 0; i < model->numEdges; i++ ) {
+		const cm_edge_t *edge = model->edges + i;
+		if ( edge->vertexNum[0] < 0 || edge->vertexNum[0] >= model->numVertices ||
+				edge->vertexNum[1] < 0 || edge->vertexNum[1] >= model->numVertices ) {
+			break;
+		}
+	}
+	if ( i < model->numEdges ) {
+		common->Warning( "%s has bad edges for model %s", fileName, model->name.c_str() );
+		FreeModel( model );
+		return NULL;
+	}
+
+	// setup the polygons
+	for ( offset = 0, i = 0; offset < polygonMemory; offset += size, i++ ) {
+		if ( offset + (int)sizeof( cm_polygon_t ) > polygonMemory ) {
+			break;
+		}
+		p = (cm_polygon_t *) ( data + layout.polygonsOffset + offset );
+		materialNum = (int) (intptr_t) p->material - 1;
+		if ( p->numEdges < 1 || p->numEdges > ( polygonMemory - offset - (int)sizeof( cm_polygon_t ) ) / (int)sizeof( p->edges[0] ) + 1 ||
+				materialNum < 0 || materialNum >= numMaterials ) {
+			break;
+		}
+		size = sizeof( cm_polygon_t ) + ( p->numEdges - 1 ) * sizeof( p->edges[0] );
+		for ( j = 0; j < p->numEdges; j++ ) {
+			if ( p->edges[j] <= -model->numEdges || p->edges[j] >= model->numEdges ) {
+				break;
+			}
+		}
+		if ( j < p->numEdges ) {
+			break;
+		}
+		p->material = materials[materialNum];
+		p->contents = p->material->GetContentFlags();
+		p->checkcount = 0;
+		p->checkNum = model->numPolygonChecks++;
+	}
+	if ( offset != polygonMemory || i != model->numPolygons ) {
+		common->Warning( "%s has bad polygons for model %s", fileName, model->name.c_str() );
+		FreeModel( model );
+		return NULL;
+	}
+
+	// setup the brushes
+	for ( offset = 0, i = 0; offset < brushMemory; offset += size, i++ ) {
+		b = (cm_brush_t *) ( data + layout.brushesOffset + offset );
+		if ( b->numPlanes < 1 ) {
+			break;
+		}
+		size = sizeof( cm_brush_t ) + ( b->numPlanes - 1 ) * sizeof( b->planes[0] );
+		b->checkcount = 0;
+		b->checkNum = model->numBrushChecks++;
+	}
+	if ( offset != brushMemory || i != model->numBrushes ) {
+		common->Warning( "%s has bad brushes for model %s", fileName, model->name.c_str() );
+		FreeModel( model );
+		return NULL;
+	}
+
+	return model;
+}
+
+/*
+================
+idCollisionModelManagerLocal::LoadBinaryCollisionModelFile
+================
+*/
+bool idCollisionModelManagerLocal::LoadBinaryCollisionModelFile( const char *name, unsigned int mapFileCRC ) {
+	int i, id, version, byteOrder, pointerSize, vertexSize, edgeSize, nodeSize, polygonSize, brushSize, num, firstModel;
+	unsigned int crc;
+	idStr fileName, textFileName;
+	ID_TIME_T textTimestamp;
+	idFile *fp;
+	cm_model_t *model;
+
+	// the binary file is keyed by the map file CRC
+	if ( !mapFileCRC ) {
+		return false;
+	}
+
+	fileName = name;
+	fileName.SetFileExtension( CMB_FILE_EXT );
+	fp = fileSystem->OpenFileRead( fileName );
+	if ( !fp ) {
+		return false;
+	}
+
+	// ignore the binary file if the text file was written after it
+	textFileName = name;
+	textFileName.SetFileExtension( CM_FILE_EXT );
+	if ( fileSystem->ReadFile( textFileName, NULL, &textTimestamp ) > 0 && textTimestamp > fp->Timestamp() ) {
+		common->Printf( "%s is older than %s\n", fileName.c_str(), textFileName.c_str() );
+		fileSystem->CloseFile( fp );
+		return false;
+	}
+
+	fp->ReadInt( id );
+	fp->ReadInt( version );
+	if ( id != CMB_FILEID || version != CMB_FILEVERSION ) {
+		common->Warning( "%s is not a version %d CMB file", fileName.c_str(), CMB_FILEVERSION );
+		fileSystem->CloseFile( fp );
+		return false;
+	}
+
+	byteOrder = 0;
+	fp->Read( &byteOrder, sizeof( byteOrder ) );
+	fp->ReadInt( pointerSize );
+	fp->ReadInt( vertexSize );
+	fp->ReadInt( edgeSize );
+	fp->ReadInt( nodeSize );
+	fp->ReadInt( polygonSize );
+	fp->ReadInt( brushSize );
+	if ( byteOrder != 1 || pointerSize != sizeof( void * ) || vertexSize != sizeof( cm_vertex_t ) || edgeSize != sizeof( cm_edge_t ) ||
+			nodeSize != sizeof( cm_node_t ) || polygonSize != sizeof( cm_polygon_t ) || brushSize != sizeof( cm_brush_t ) ) {
+		common->Printf( "%s was written on a different platform\n", fileName.c_str() );
+		fileSystem->CloseFile( fp );
+		return false;
+	}
+
+	fp->ReadUnsignedInt( crc );
+	if ( crc != mapFileCRC ) {
+		common->Printf( "%s is out of date\n", fileName.c_str() );
+		fileSystem->CloseFile( fp );
+		return false;
+	}
+
+	fp->ReadInt( num );
+	if ( num < 0 || numModels + num > MAX_SUBMODELS ) {
+		common->Warning( "%s has a bad model count", fileName.c_str() );
+		fileSystem->CloseFile( fp );
+		return false;
+	}
+
+	// read the collision models
+	firstModel = numModels;
+	for ( i = 0; i < num; i++ ) {
+		model = ReadBinaryCollisionModel( fp, fileName );
+		if ( !model ) {
+			// remove the models read so far and fall back to the text file
+			while ( numModels > firstModel ) {
+				numModels--;
+				FreeModel( models[numModels] );
+				models[numModels] = NULL;
+			}
+			fileSystem->CloseFile( fp );
+			return false;
+		}
+		models[numModels] = model;
+		numModels++;
+	}
+
+	fileSystem->CloseFile( fp );
+
 	return true;
 }
@@ -58,6 +58,10 @@ cm_windingList_t *				cm_windingList;
 cm_windingList_t *				cm_outList;
 cm_windingList_t *				cm_tmpList;
 
+static int						cm_threadWorkSerial = 1;	// changes whenever the work of all threads is freed
+static ID_THREAD_LOCAL cm_threadWork_t *	cm_localThreadWork;	// collision detection data of the calling thread
+static ID_THREAD_LOCAL int		cm_localThreadWorkSerial;
+
 idHashIndex *					cm_vertexHash;
 idHashIndex *					cm_edgeHash;
 
@@ -183,15 +187,9 @@ void idCollisionModelManagerLocal::Clear( void ) {
 	maxModels = 0;
 	numModels = 0;
 	models = NULL;
-	memset( trmPolygons, 0, sizeof( trmPolygons ) );
-	trmBrushes[0] = NULL;
 	trmMaterial = NULL;
 	numProcNodes = 0;
 	procNodes = NULL;
-	getContacts = false;
-	contacts = NULL;
-	maxContacts = 0;
-	numContacts = 0;
 }
 
 /*
@@ -368,6 +366,13 @@ void idCollisionModelManagerLocal::FreeModel( cm_model_t *model ) {
 	cm_brushRefBlock_t *brushRefBlock, *nextBrushRefBlock;
 	cm_nodeBlock_t *nodeBlock, *nextNodeBlock;
 
+	// all data of a model loaded from a binary file is in a single block
+	if ( model->binaryData ) {
+		Mem_Free( model->binaryData );
+		delete model;
+		return;
+	}
+
 	// free the tree structure
 	if ( model->node ) {
 		FreeTree_r( model, model->node, model->node );
@@ -408,6 +413,7 @@ void idCollisionModelManagerLocal::FreeMap( void ) {
 	int i;
 
 	if ( !loaded ) {
+		FreeThreadWorks();
 		Clear();
 		return;
 	}
@@ -419,7 +425,7 @@ void idCollisionModelManagerLocal::FreeMap( void ) {
 		FreeModel( models[i] );
 	}
 
-	FreeTrmModelStructure();
+	FreeThreadWorks();
 
 	Mem_Free( models );
 
@@ -433,22 +439,147 @@ void idCollisionModelManagerLocal::FreeMap( void ) {
 idCollisionModelManagerLocal::FreeTrmModelStructure
 ================
 */
-void idCollisionModelManagerLocal::FreeTrmModelStructure( void ) {
+void idCollisionModelManagerLocal::FreeTrmModelStructure( cm_threadWork_t *work ) {
 	int i;
 
-	assert( models );
-	if ( !models[MAX_SUBMODELS] ) {
+	if ( !work->trmModel ) {
 		return;
 	}
 
 	for ( i = 0; i < MAX_TRACEMODEL_POLYS; i++ ) {
-		FreePolygon( models[MAX_SUBMODELS], trmPolygons[i]->p );
+		FreePolygon( work->trmModel, work->trmPolygons[i]->p );
 	}
-	FreeBrush( models[MAX_SUBMODELS], trmBrushes[0]->b );
+	FreeBrush( work->trmModel, work->trmBrushes[0]->b );
+
+	work->trmModel->node->polygons = NULL;
+	work->trmModel->node->brushes = NULL;
+	FreeModel( work->trmModel );
+	work->trmModel = NULL;
+}
+
+/*
+================
+idCollisionModelManagerLocal::GetThreadWork
+
+  Returns the collision detection data of the calling thread.
+  The data is created the first time a thread uses the loaded map.
+================
+*/
+cm_threadWork_t *idCollisionModelManagerLocal::GetThreadWork( void ) {
+	cm_threadWork_t *work;
+
+	if ( cm_localThreadWork != NULL && cm_localThreadWorkSerial == cm_threadWorkSerial ) {
+		return cm_localThreadWork;
+	}
+
+	work = (cm_threadWork_t *) Mem_ClearedAlloc( sizeof( cm_threadWork_t ) );
+
+	SetupTrmModelStructure( work );
 
-	models[MAX_SUBMODELS]->node->polygons = NULL;
-	models[MAX_SUBMODELS]->node->brushes = NULL;
-	FreeModel( models[MAX_SUBMODELS] );
+	threadWorkLock.Lock();
+	work->next = threadWorks;
+	threadWorks = work;
+	threadWorkLock.Unlock();
+
+	cm_localThreadWork = work;
+	cm_localThreadWorkSerial = cm_threadWorkSerial;
+	return work;
+}
+
+/*
+================
+idCollisionModelManagerLocal::FreeThreadWorks
+
+  Should only be called when no other thread is using the collision models.
+================
+*/
+void idCollisionModelManagerLocal::FreeThreadWorks( void ) {
+	cm_threadWork_t *work, *next;
+
+	for ( work = threadWorks; work; work = next ) {
+		next = work->next;
+		FreeTrmModelStructure( work );
+		Mem_Free( work->polygonChecks );
+		Mem_Free( work->polygonPoints );
+		Mem_Free( work->brushChecks );
+		Mem_Free( work->vertexChecks );
+		Mem_Free( work->edgeChecks );
+		Mem_Free( work );
+	}
+	threadWorks = NULL;
+	cm_threadWorkSerial++;
+}
+
+/*
+================
+idCollisionModelManagerLocal::ThreadModel
+================
+*/
+cm_model_t *idCollisionModelManagerLocal::ThreadModel( cmHandle_t model, cm_threadWork_t *work ) const {
+	if ( model == TRACE_MODEL_HANDLE ) {
+		return work->trmModel;
+	}
+	return models[model];
+}
+
+/*
+================
+idCollisionModelManagerLocal::SetupThreadChecks
+
+  Makes sure the calling thread has enough check counts for the model
+  traced against and starts a new check.
+================
+*/
+void idCollisionModelManagerLocal::SetupThreadChecks( cm_threadWork_t *work, const cm_model_t *model ) {
+	if ( model->numPolygonChecks > work->maxPolygonChecks ) {
+		Mem_Free( work->polygonChecks );
+		Mem_Free( work->polygonPoints );
+		work->maxPolygonChecks = model->numPolygonChecks;
+		work->polygonChecks = (int *) Mem_ClearedAlloc( work->maxPolygonChecks * sizeof( work->polygonChecks[0] ) );
+		work->polygonPoints = (byte *) Mem_ClearedAlloc( work->maxPolygonChecks * sizeof( work->polygonPoints[0] ) );
+	}
+	if ( model->numBrushChecks > work->maxBrushChecks ) {
+		Mem_Free( work->brushChecks );
+		work->maxBrushChecks = model->numBrushChecks;
+		work->brushChecks = (int *) Mem_ClearedAlloc( work->maxBrushChecks * sizeof( work->brushChecks[0] ) );
+	}
+	if ( model->maxVertices > work->maxVertexChecks ) {
+		Mem_Free( work->vertexChecks );
+		work->maxVertexChecks = model->maxVertices;
+		work->vertexChecks = (cm_featureCheck_t *) Mem_ClearedAlloc( work->maxVertexChecks * sizeof( work->vertexChecks[0] ) );
+	}
+	if ( model->maxEdges > work->maxEdgeChecks ) {
+		Mem_Free( work->edgeChecks );
+		work->maxEdgeChecks = model->maxEdges;
+		work->edgeChecks = (cm_featureCheck_t *) Mem_ClearedAlloc( work->maxEdgeChecks * sizeof( work->edgeChecks[0] ) );
+	}
+
+	// the check counts are zero when the arrays are allocated
+	work->checkCount++;
+	if ( work->checkCount <= 0 ) {
+		memset( work->polygonChecks, 0, work->maxPolygonChecks * sizeof( work->polygonChecks[0] ) );
+		memset( work->brushChecks, 0, work->maxBrushChecks * sizeof( work->brushChecks[0] ) );
+		memset( work->vertexChecks, 0, work->maxVertexChecks * sizeof( work->vertexChecks[0] ) );
+		memset( work->edgeChecks, 0, work->maxEdgeChecks * sizeof( work->edgeChecks[0] ) );
+		work->checkCount = 1;
+	}
+}
+
+/*
+================
+idCollisionModelManagerLocal::SetupTraceWork
+
+  Points the trace work at the check counts of the calling thread.
+================
+*/
+void idCollisionModelManagerLocal::SetupTraceWork( cm_traceWork_t *tw, cm_threadWork_t *work ) {
+	SetupThreadChecks( work, tw->model );
+
+	tw->checkCount = work->checkCount;
+	tw->polygonChecks = work->polygonChecks;
+	tw->brushChecks = work->brushChecks;
+	tw->vertexChecks = work->vertexChecks;
+	tw->edgeChecks = work->edgeChecks;
 }
 
 
@@ -553,6 +684,9 @@ cm_model_t *idCollisionModelManagerLocal::AllocModel( void ) {
 	model->brushRefBlocks = NULL;
 	model->polygonBlock = NULL;
 	model->brushBlock = NULL;
+	model->binaryData = NULL;
+	model->numPolygonChecks = 0;
+	model->numBrushChecks = 0;
 	model->numPolygons = model->polygonMemory =
 	model->numBrushes = model->brushMemory =
 	model->numNodes = model->numBrushRefs =
@@ -670,6 +804,7 @@ cm_polygon_t *idCollisionModelManagerLocal::AllocPolygon( cm_model_t *model, int
 	} else {
 		poly = (cm_polygon_t *) Mem_Alloc( size );
 	}
+	poly->checkNum = model->numPolygonChecks++;
 	return poly;
 }
 
@@ -692,6 +827,7 @@ cm_brush_t *idCollisionModelManagerLocal::AllocBrush( cm_model_t *model, int num
 	} else {
 		brush = (cm_brush_t *) Mem_Alloc( size );
 	}
+	brush->checkNum = model->numBrushChecks++;
 	return brush;
 }
 
@@ -730,16 +866,19 @@ void idCollisionModelManagerLocal::AddBrushToNode( cm_model_t *model, cm_node_t
 idCollisionModelManagerLocal::SetupTrmModelStructure
 ================
 */
-void idCollisionModelManagerLocal::SetupTrmModelStructure( void ) {
+void idCollisionModelManagerLocal::SetupTrmModelStructure( cm_threadWork_t *work ) {
 	int i;
 	cm_node_t *node;
 	cm_model_t *model;
+	cm_polygonRef_t **trmPolygons;
+	cm_brushRef_t **trmBrushes;
 
 	// setup model
 	model = AllocModel();
 
-	assert( models );
-	models[MAX_SUBMODELS] = model;
+	work->trmModel = model;
+	trmPolygons = work->trmPolygons;
+	trmBrushes = work->trmBrushes;
 	// create node to hold the collision data
 	node = (cm_node_t *) AllocNode( model, 1 );
 	node->planeType = -1;
@@ -751,11 +890,6 @@ void idCollisionModelManagerLocal::SetupTrmModelStructure( void ) {
 	model->numEdges = 0;
 	model->maxEdges = MAX_TRACEMODEL_EDGES+1;
 	model->edges = (cm_edge_t *) Mem_ClearedAlloc( model->maxEdges * sizeof(cm_edge_t) );
-	// create a material for the trace model polygons
-	trmMaterial = declManager->FindMaterial( "_tracemodel", false );
-	if ( !trmMaterial ) {
-		common->FatalError( "_tracemodel material not found" );
-	}
 
 	// allocate polygons
 	for ( i = 0; i < MAX_TRACEMODEL_POLYS; i++ ) {
@@ -782,8 +916,8 @@ void idCollisionModelManagerLocal::SetupTrmModelStructure( void ) {
 ================
 idCollisionModelManagerLocal::SetupTrmModel
 
-Trace models (item boxes, etc) are converted to collision models on the fly, using the last model slot
-as a reusable temporary buffer
+Trace models (item boxes, etc) are converted to collision models on the fly, using a model
+of the calling thread as a reusable temporary buffer
 ================
 */
 cmHandle_t idCollisionModelManagerLocal::SetupTrmModel( const idTraceModel &trm, const idMaterial *material ) {
@@ -795,6 +929,9 @@ cmHandle_t idCollisionModelManagerLocal::SetupTrmModel( const idTraceModel &trm,
 	const traceModelVert_t *trmVert;
 	const traceModelEdge_t *trmEdge;
 	const traceModelPoly_t *trmPoly;
+	cm_threadWork_t *work;
+	cm_polygonRef_t **trmPolygons;
+	cm_brushRef_t **trmBrushes;
 
 	assert( models );
 
@@ -802,7 +939,11 @@ cmHandle_t idCollisionModelManagerLocal::SetupTrmModel( const idTraceModel &trm,
 		material = trmMaterial;
 	}
 
-	model = models[MAX_SUBMODELS];
+	work = GetThreadWork();
+	trmPolygons = work->trmPolygons;
+	trmBrushes = work->trmBrushes;
+
+	model = work->trmModel;
 	model->node->brushes = NULL;
 	model->node->polygons = NULL;
 	// if not a valid trace model
@@ -815,7 +956,6 @@ cmHandle_t idCollisionModelManagerLocal::SetupTrmModel( const idTraceModel &trm,
 	trmVert = trm.verts;
 	for ( i = 0; i < trm.numVerts; i++, vertex++, trmVert++ ) {
 		vertex->p = *trmVert;
-		vertex->sideSet = 0;
 	}
 	// edges
 	model->numEdges = trm.numEdges;
@@ -826,7 +966,6 @@ cmHandle_t idCollisionModelManagerLocal::SetupTrmModel( const idTraceModel &trm,
 		edge->vertexNum[1] = trmEdge->v[1];
 		edge->normal = trmEdge->normal;
 		edge->internal = false;
-		edge->sideSet = 0;
 	}
 	// polygons
 	model->numPolygons = trm.numPolys;
@@ -1299,7 +1438,7 @@ cm_polygon_t *idCollisionModelManagerLocal::TryMergePolygons( cm_model_t *model,
 	int i, j, nexti, prevj;
 	int p1BeforeShare, p1AfterShare, p2BeforeShare, p2AfterShare;
 	int newEdges[CM_MAX_POLYGON_EDGES], newNumEdges;
-	int edgeNum, edgeNum1, edgeNum2, newEdgeNum1, newEdgeNum2;
+	int edgeNum, edgeNum1, edgeNum2, newEdgeNum1, newEdgeNum2, checkNum;
 	cm_edge_t *edge;
 	cm_polygon_t *newp;
 	idVec3 delta, normal;
@@ -1450,7 +1589,9 @@ cm_polygon_t *idCollisionModelManagerLocal::TryMergePolygons( cm_model_t *model,
 	}
 
 	newp = AllocPolygon( model, newNumEdges );
+	checkNum = newp->checkNum;
 	memcpy( newp, p1, sizeof(cm_polygon_t) );
+	newp->checkNum = checkNum;
 	memcpy( newp->edges, newEdges, newNumEdges * sizeof(int) );
 	newp->numEdges = newNumEdges;
 	newp->checkcount = 0;
@@ -3319,6 +3460,7 @@ void idCollisionModelManagerLocal::BuildModels( const idMapFile *mapFile ) {
 
 		// write the collision models to a file
 		WriteCollisionModelsToFile( mapFile->GetName(), 0, numModels, mapFile->GetGeometryCRC() );
+		WriteBinaryCollisionModelsToFile( mapFile->GetName(), 0, numModels, mapFile->GetGeometryCRC() );
 	}
 
 	timer.Stop();
@@ -3367,8 +3509,11 @@ void idCollisionModelManagerLocal::LoadMap( const idMapFile *mapFile ) {
 	// setup hash to speed up finding shared vertices and edges
 	SetupHash();
 
-	// setup trace model structure
-	SetupTrmModelStructure();
+	// create a material for the trace model polygons
+	trmMaterial = declManager->FindMaterial( "_tracemodel", false );
+	if ( !trmMaterial ) {
+		common->FatalError( "_tracemodel material not found" );
+	}
 
 	// build collision models
 	BuildModels( mapFile );
@@ -80,17 +80,13 @@ Collision model
 
 typedef struct cm_vertex_s {
 	idVec3					p;					// vertex point
-	int						checkcount;			// for multi-check avoidance
-	unsigned long			side;				// each bit tells at which side this vertex passes one of the trace model edges
-	unsigned long			sideSet;			// each bit tells if sidedness for the trace model edge has been calculated yet
+	int						checkcount;			// for multi-check avoidance while building the model
 } cm_vertex_t;
 
 typedef struct cm_edge_s {
-	int						checkcount;			// for multi-check avoidance
+	int						checkcount;			// for multi-check avoidance while building the model
 	unsigned short			internal;			// a trace model can never collide with internal edges
 	unsigned short			numUsers;			// number of polygons using this edge
-	unsigned long			side;				// each bit tells at which side of this edge one of the trace model vertices passes
-	unsigned long			sideSet;			// each bit tells if sidedness for the trace model vertex has been calculated yet
 	int						vertexNum[2];		// start and end point of edge
 	idVec3					normal;				// edge normal
 } cm_edge_t;
@@ -102,7 +98,8 @@ typedef struct cm_polygonBlock_s {
 
 typedef struct cm_polygon_s {
 	idBounds				bounds;				// polygon bounds
-	int						checkcount;			// for multi-check avoidance
+	int						checkcount;			// for multi-check avoidance while building the model
+	int						checkNum;			// index into the per thread polygon check counts
 	int						contents;			// contents behind polygon
 	const idMaterial *		material;			// material
 	idPlane					plane;				// polygon plane
@@ -126,7 +123,8 @@ typedef struct cm_brushBlock_s {
 } cm_brushBlock_t;
 
 typedef struct cm_brush_s {
-	int						checkcount;			// for multi-check avoidance
+	int						checkcount;			// for multi-check avoidance while building the model
+	int						checkNum;			// index into the per thread brush check counts
 	idBounds				bounds;				// brush bounds
 	int						contents;			// contents of brush
 	const idMaterial *		material;			// material
@@ -178,6 +176,9 @@ typedef struct cm_model_s {
 	cm_brushRefBlock_t *	brushRefBlocks;		// list with blocks of brush references
 	cm_polygonBlock_t *		polygonBlock;		// memory block with all polygons
 	cm_brushBlock_t *		brushBlock;			// memory block with all brushes
+	byte *					binaryData;			// single block with all model data when loaded from a binary file
+	int						numPolygonChecks;	// number of polygon check numbers handed out
+	int						numBrushChecks;		// number of brush check numbers handed out
 	// statistics
 	int						numPolygons;
 	int						polygonMemory;
@@ -201,6 +202,33 @@ Data used during collision detection calculations
 ===============================================================================
 */
 
+typedef struct cm_featureCheck_s {
+	int checkcount;									// for multi-check avoidance
+	unsigned long side;								// each bit tells at which side of a model edge a trm vertex passes or at which side of a trm edge a model vertex passes
+	unsigned long sideSet;							// each bit tells if sidedness has been calculated yet
+} cm_featureCheck_t;
+
+typedef struct cm_threadWork_s {
+	int checkCount;									// for multi-check avoidance
+	int maxPolygonChecks;
+	int *polygonChecks;								// check counts indexed with cm_polygon_t::checkNum
+	byte *polygonPoints;							// points of a point packet that tested the polygon
+	int maxBrushChecks;
+	int *brushChecks;								// check counts indexed with cm_brush_t::checkNum
+	int maxVertexChecks;
+	cm_featureCheck_t *vertexChecks;				// check counts and sidedness of model vertices
+	int maxEdgeChecks;
+	cm_featureCheck_t *edgeChecks;					// check counts and sidedness of model edges
+	cm_model_t *trmModel;							// model set up with SetupTrmModel
+	cm_polygonRef_t *trmPolygons[MAX_TRACEMODEL_POLYS];
+	cm_brushRef_t *trmBrushes[1];
+	bool getContacts;								// for retrieving contact points
+	contactInfo_t *contacts;
+	int maxContacts;
+	int numContacts;
+	struct cm_threadWork_s *next;					// next in the list with the work of all threads
+} cm_threadWork_t;
+
 typedef struct cm_trmVertex_s {
 	int used;										// true if this vertex is used for collision detection
 	idVec3 p;										// vertex position
@@ -275,8 +303,34 @@ typedef struct cm_traceWork_s {
 	idPluecker polygonEdgePlueckerCache[CM_MAX_POLYGON_EDGES];
 	idPluecker polygonVertexPlueckerCache[CM_MAX_POLYGON_EDGES];
 	idVec3 polygonRotationOriginCache[CM_MAX_POLYGON_EDGES];
+
+	int checkCount;									// for multi-check avoidance
+	int *polygonChecks;								// check counts of the calling thread
+	int *brushChecks;
+	cm_featureCheck_t *vertexChecks;
+	cm_featureCheck_t *edgeChecks;
 } cm_traceWork_t;
 
+#define CM_POINT_PACKET_SIZE	8					// number of point traces descending the BSP tree together
+
+typedef struct cm_pointPacket_s {
+	int numPoints;
+	int contents;									// ignore polygons that do not have any of these contents flags
+	cm_model_t *model;								// model colliding with
+	int checkCount;									// for multi-check avoidance
+	int *polygonChecks;								// check counts of the calling thread
+	byte *polygonPoints;							// points that tested a polygon during this check
+	idVec3 start[CM_POINT_PACKET_SIZE];				// start of traces
+	idVec3 end[CM_POINT_PACKET_SIZE];				// end of traces
+	float dir[3][CM_POINT_PACKET_SIZE];				// trace directions stored per component
+	float mins[3][CM_POINT_PACKET_SIZE];			// bounds of traces stored per component
+	float maxs[3][CM_POINT_PACKET_SIZE];
+	idPlane heartPlane1[CM_POINT_PACKET_SIZE];		// polygons should be near enough the trace heart planes
+	idPlane heartPlane2[CM_POINT_PACKET_SIZE];
+	float pl[6][CM_POINT_PACKET_SIZE];				// pluecker coordinates of the traces stored per component
+	trace_t trace[CM_POINT_PACKET_SIZE];			// collision detection results
+} cm_pointPacket_t;
+
 /*
 ===============================================================================
 
@@ -321,6 +375,9 @@ public:
 	void			Translation( trace_t *results, const idVec3 &start, const idVec3 &end,
 								const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
 								cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis );
+	// translates points and reports the first collision of each point if any
+	void			TracePoints( trace_t *results, const idVec3 *starts, const idVec3 *ends, const int numPoints, int contentMask,
+								cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis );
 	// rotates a trm and reports the first collision if any
 	void			Rotation( trace_t *results, const idVec3 &start, const idRotation &rotation,
 								const idTraceModel *trm, const idMat3 &trmAxis, int contentMask,
@@ -354,6 +411,9 @@ private:			// CollisionMap_translate.cpp
 	bool			TranslateTrmThroughPolygon( cm_traceWork_t *tw, cm_polygon_t *p );
 	void			SetupTranslationHeartPlanes( cm_traceWork_t *tw );
 	void			SetupTrm( cm_traceWork_t *tw, const idTraceModel *trm );
+	int				TracePointPacketThroughPolygon( cm_pointPacket_t *pp, cm_polygon_t *p, int points );
+	void			TracePointPacketThroughAxialBSPTree_r( cm_pointPacket_t *pp, cm_node_t *node, int points,
+											const float *p1f, const float *p2f, const idVec3 *p1, const idVec3 *p2 );
 
 private:			// CollisionMap_rotate.cpp
 	int				CollisionBetweenEdgeBounds( cm_traceWork_t *tw, const idVec3 &va, const idVec3 &vb,
@@ -401,7 +461,13 @@ private:			// CollisionMap_trace.cpp
 
 private:			// CollisionMap_load.cpp
 	void			Clear( void );
-	void			FreeTrmModelStructure( void );
+	void			FreeTrmModelStructure( cm_threadWork_t *work );
+					// per thread collision detection data
+	cm_threadWork_t *GetThreadWork( void );
+	void			FreeThreadWorks( void );
+	cm_model_t *	ThreadModel( cmHandle_t model, cm_threadWork_t *work ) const;
+	void			SetupThreadChecks( cm_threadWork_t *work, const cm_model_t *model );
+	void			SetupTraceWork( cm_traceWork_t *tw, cm_threadWork_t *work );
 					// model deallocation
 	void			RemovePolygonReferences_r( cm_node_t *node, cm_polygon_t *p );
 	void			RemoveBrushReferences_r( cm_node_t *node, cm_brush_t *b );
@@ -441,7 +507,7 @@ private:			// CollisionMap_load.cpp
 	cm_brush_t *	AllocBrush( cm_model_t *model, int numPlanes );
 	void			AddPolygonToNode( cm_model_t *model, cm_node_t *node, cm_polygon_t *p );
 	void			AddBrushToNode( cm_model_t *model, cm_node_t *node, cm_brush_t *b );
-	void			SetupTrmModelStructure( void );
+	void			SetupTrmModelStructure( cm_threadWork_t *work );
 	void			R_FilterPolygonIntoTree( cm_model_t *model, cm_node_t *node, cm_polygonRef_t *pref, cm_polygon_t *p );
 	void			R_FilterBrushIntoTree( cm_model_t *model, cm_node_t *node, cm_brushRef_t *pref, cm_brush_t *b );
 	cm_node_t *		R_CreateAxialBSPTree( cm_model_t *model, cm_node_t *node, const idBounds &bounds );
@@ -481,6 +547,8 @@ private:			// CollisionMap_files.cpp
 	void			WriteBrushes( idFile *fp, cm_node_t *node );
 	void			WriteCollisionModel( idFile *fp, cm_model_t *model );
 	void			WriteCollisionModelsToFile( const char *filename, int firstModel, int lastModel, unsigned int mapFileCRC );
+	void			WriteBinaryCollisionModel( idFile *fp, cm_model_t *model );
+	void			WriteBinaryCollisionModelsToFile( const char *filename, int firstModel, int lastModel, unsigned int mapFileCRC );
 					// loading
 	cm_node_t *		ParseNodes( idLexer *src, cm_model_t *model, cm_node_t *parent );
 	void			ParseVertices( idLexer *src, cm_model_t *model );
@@ -489,6 +557,8 @@ private:			// CollisionMap_files.cpp
 	void			ParseBrushes( idLexer *src, cm_model_t *model );
 	bool			ParseCollisionModel( idLexer *src );
 	bool			LoadCollisionModelFile( const char *name, unsigned int mapFileCRC );
+	cm_model_t *	ReadBinaryCollisionModel( idFile *fp, const char *fileName );
+	bool			LoadBinaryCollisionModelFile( const char *name, unsigned int mapFileCRC );
 
 private:			// CollisionMap_debug
 	int				ContentsFromString( const char *string ) const;
@@ -503,24 +573,20 @@ private:			// collision map data
 	idStr			mapName;
 	ID_TIME_T			mapFileTime;
 	int				loaded;
-					// for multi-check avoidance
+					// for multi-check avoidance while building and drawing models
 	int				checkCount;
 					// models
 	int				maxModels;
 	int				numModels;
 	cm_model_t **	models;
-					// polygons and brush for trm model
-	cm_polygonRef_t*trmPolygons[MAX_TRACEMODEL_POLYS];
-	cm_brushRef_t *	trmBrushes[1];
+					// material for trm models
 	const idMaterial *trmMaterial;
 					// for data pruning
 	int				numProcNodes;
 	cm_procNode_t *	procNodes;
-					// for retrieving contact points
-	bool			getContacts;
-	contactInfo_t *	contacts;
-	int				maxContacts;
-	int				numContacts;
+					// collision detection data of all threads
+	idSysSpinLock	threadWorkLock;
+	cm_threadWork_t *threadWorks;
 };
 
 // for debugging
@@ -508,7 +508,7 @@ void idCollisionModelManagerLocal::RotateTrmEdgeThroughPolygon( cm_traceWork_t *
 		edge = tw->model->edges + abs(edgeNum);
 
 		// if this edge is already checked
-		if ( edge->checkcount == idCollisionModelManagerLocal::checkCount ) {
+		if ( tw->edgeChecks[abs(edgeNum)].checkcount == tw->checkCount ) {
 			continue;
 		}
 
@@ -1059,13 +1059,14 @@ bool idCollisionModelManagerLocal::RotateTrmThroughPolygon( cm_traceWork_t *tw,
 	cm_trmPolygon_t *bp;
 	cm_vertex_t *v;
 	cm_edge_t *e;
+	cm_featureCheck_t *vc, *ec;
 	idVec3 *rotationOrigin;
 
 	// if already checked this polygon
-	if ( p->checkcount == idCollisionModelManagerLocal::checkCount ) {
+	if ( tw->polygonChecks[p->checkNum] == tw->checkCount ) {
 		return false;
 	}
-	p->checkcount = idCollisionModelManagerLocal::checkCount;
+	tw->polygonChecks[p->checkNum] = tw->checkCount;
 
 	// if this polygon does not have the right contents behind it
 	if ( !(p->contents & tw->contents) ) {
@@ -1160,12 +1161,13 @@ bool idCollisionModelManagerLocal::RotateTrmThroughPolygon( cm_traceWork_t *tw,
 		for ( i = 0; i < p->numEdges; i++ ) {
 			edgeNum = p->edges[i];
 			e = tw->model->edges + abs(edgeNum);
+			ec = tw->edgeChecks + abs(edgeNum);
 
-			if ( e->checkcount == idCollisionModelManagerLocal::checkCount ) {
+			if ( ec->checkcount == tw->checkCount ) {
 				continue;
 			}
 			// set edge check count
-			e->checkcount = idCollisionModelManagerLocal::checkCount;
+			ec->checkcount = tw->checkCount;
 			// can never collide with internal edges
 			if ( e->internal ) {
 				continue;
@@ -1174,13 +1176,14 @@ bool idCollisionModelManagerLocal::RotateTrmThroughPolygon( cm_traceWork_t *tw,
 			for ( k = 0; k < 2; k++ ) {
 
 				v = tw->model->vertices + e->vertexNum[k ^ INTSIGNBITSET(edgeNum)];
+				vc = tw->vertexChecks + e->vertexNum[k ^ INTSIGNBITSET(edgeNum)];
 
 				// if this vertex is already checked
-				if ( v->checkcount == idCollisionModelManagerLocal::checkCount ) {
+				if ( vc->checkcount == tw->checkCount ) {
 					continue;
 				}
 				// set vertex check count
-				v->checkcount = idCollisionModelManagerLocal::checkCount;
+				vc->checkcount = tw->checkCount;
 
 				// if the vertex is outside the trm rotation bounds
 				if ( !tw->bounds.ContainsPoint( v->p ) ) {
@@ -1263,18 +1266,19 @@ void idCollisionModelManagerLocal::Rotation180( trace_t *results, const idVec3 &
 	cm_trmPolygon_t *poly;
 	cm_trmEdge_t *edge;
 	cm_trmVertex_t *vert;
-	ALIGN16( static cm_traceWork_t tw );
+	cm_threadWork_t *work;
+	ALIGN16( cm_traceWork_t tw );
 
 	if ( model < 0 || model > MAX_SUBMODELS || model > idCollisionModelManagerLocal::maxModels ) {
 		common->Printf("idCollisionModelManagerLocal::Rotation180: invalid model handle\n");
 		return;
 	}
-	if ( !idCollisionModelManagerLocal::models[model] ) {
+	if ( model != TRACE_MODEL_HANDLE && !idCollisionModelManagerLocal::models[model] ) {
 		common->Printf("idCollisionModelManagerLocal::Rotation180: invalid model\n");
 		return;
 	}
 
-	idCollisionModelManagerLocal::checkCount++;
+	work = idCollisionModelManagerLocal::GetThreadWork();
 
 	tw.trace.fraction = 1.0f;
 	tw.trace.c.contents = 0;
@@ -1288,7 +1292,8 @@ void idCollisionModelManagerLocal::Rotation180( trace_t *results, const idVec3 &
 	tw.angle = endAngle - startAngle;
 	assert( tw.angle > -180.0f && tw.angle < 180.0f );
 	tw.maxTan = initialTan = idMath::Fabs( tan( ( idMath::PI / 360.0f ) * tw.angle ) );
-	tw.model = idCollisionModelManagerLocal::models[model];
+	tw.model = idCollisionModelManagerLocal::ThreadModel( model, work );
+	idCollisionModelManagerLocal::SetupTraceWork( &tw, work );
 	tw.start = start - modelOrigin;
 	// rotation axis, axis is assumed to be normalized
 	tw.axis = axis;
@@ -1611,7 +1616,7 @@ idCollisionModelManagerLocal::Rotation
 ================
 */
 #ifdef _DEBUG
-static int entered = 0;
+static ID_THREAD_LOCAL int entered = 0;
 #endif
 
 void idCollisionModelManagerLocal::Rotation( trace_t *results, const idVec3 &start, const idRotation &rotation,
@@ -200,7 +200,7 @@ CM_SetVertexSidedness
   stores for the given model vertex at which side of one of the trm edges it passes
 ================
 */
-ID_INLINE void CM_SetVertexSidedness( cm_vertex_t *v, const idPluecker &vpl, const idPluecker &epl, const int bitNum ) {
+ID_INLINE void CM_SetVertexSidedness( cm_featureCheck_t *v, const idPluecker &vpl, const idPluecker &epl, const int bitNum ) {
 	if ( !(v->sideSet & (1<<bitNum)) ) {
 		float fl;
 		fl = vpl.PermutedInnerProduct( epl );
@@ -216,7 +216,7 @@ CM_SetEdgeSidedness
   stores for the given model edge at which side one of the trm vertices
 ================
 */
-ID_INLINE void CM_SetEdgeSidedness( cm_edge_t *edge, const idPluecker &vpl, const idPluecker &epl, const int bitNum ) {
+ID_INLINE void CM_SetEdgeSidedness( cm_featureCheck_t *edge, const idPluecker &vpl, const idPluecker &epl, const int bitNum ) {
 	if ( !(edge->sideSet & (1<<bitNum)) ) {
 		float fl;
 		fl = vpl.PermutedInnerProduct( epl );
@@ -235,15 +235,16 @@ void idCollisionModelManagerLocal::TranslateTrmEdgeThroughPolygon( cm_traceWork_
 	float f1, f2, dist, d1, d2;
 	idVec3 start, end, normal;
 	cm_edge_t *edge;
-	cm_vertex_t *v1, *v2;
+	cm_featureCheck_t *edgeCheck, *v1, *v2;
 	idPluecker *pl, epsPl;
 
 	// check edges for a collision
 	for ( i = 0; i < poly->numEdges; i++) {
 		edgeNum = poly->edges[i];
 		edge = tw->model->edges + abs(edgeNum);
+		edgeCheck = tw->edgeChecks + abs(edgeNum);
 		// if this edge is already checked
-		if ( edge->checkcount == idCollisionModelManagerLocal::checkCount ) {
+		if ( edgeCheck->checkcount == tw->checkCount ) {
 			continue;
 		}
 		// can never collide with internal edges
@@ -252,16 +253,16 @@ void idCollisionModelManagerLocal::TranslateTrmEdgeThroughPolygon( cm_traceWork_
 		}
 		pl = &tw->polygonEdgePlueckerCache[i];
 		// get the sides at which the trm edge vertices pass the polygon edge
-		CM_SetEdgeSidedness( edge, *pl, tw->vertices[trmEdge->vertexNum[0]].pl, trmEdge->vertexNum[0] );
-		CM_SetEdgeSidedness( edge, *pl, tw->vertices[trmEdge->vertexNum[1]].pl, trmEdge->vertexNum[1] );
+		CM_SetEdgeSidedness( edgeCheck, *pl, tw->vertices[trmEdge->vertexNum[0]].pl, trmEdge->vertexNum[0] );
+		CM_SetEdgeSidedness( edgeCheck, *pl, tw->vertices[trmEdge->vertexNum[1]].pl, trmEdge->vertexNum[1] );
 		// if the trm edge start and end vertex do not pass the polygon edge at different sides
-		if ( !(((edge->side >> trmEdge->vertexNum[0]) ^ (edge->side >> trmEdge->vertexNum[1])) & 1) ) {
+		if ( !(((edgeCheck->side >> trmEdge->vertexNum[0]) ^ (edgeCheck->side >> trmEdge->vertexNum[1])) & 1) ) {
 			continue;
 		}
 		// get the sides at which the polygon edge vertices pass the trm edge
-		v1 = tw->model->vertices + edge->vertexNum[INTSIGNBITSET(edgeNum)];
+		v1 = tw->vertexChecks + edge->vertexNum[INTSIGNBITSET(edgeNum)];
 		CM_SetVertexSidedness( v1, tw->polygonVertexPlueckerCache[i], trmEdge->pl, trmEdge->bitNum );
-		v2 = tw->model->vertices + edge->vertexNum[INTSIGNBITNOTSET(edgeNum)];
+		v2 = tw->vertexChecks + edge->vertexNum[INTSIGNBITNOTSET(edgeNum)];
 		CM_SetVertexSidedness( v2, tw->polygonVertexPlueckerCache[i+1], trmEdge->pl, trmEdge->bitNum );
 		// if the polygon edge start and end vertex do not pass the trm edge at different sides
 		if ( !((v1->side ^ v2->side) & (1<<trmEdge->bitNum)) ) {
@@ -396,14 +397,14 @@ idCollisionModelManagerLocal::TranslateTrmVertexThroughPolygon
 void idCollisionModelManagerLocal::TranslateTrmVertexThroughPolygon( cm_traceWork_t *tw, cm_polygon_t *poly, cm_trmVertex_t *v, int bitNum ) {
 	int i, edgeNum;
 	float f;
-	cm_edge_t *edge;
+	cm_featureCheck_t *edge;
 
 	f = CM_TranslationPlaneFraction( poly->plane, v->p, v->endp );
 	if ( f < tw->trace.fraction ) {
 
 		for ( i = 0; i < poly->numEdges; i++ ) {
 			edgeNum = poly->edges[i];
-			edge = tw->model->edges + abs(edgeNum);
+			edge = tw->edgeChecks + abs(edgeNum);
 			CM_SetEdgeSidedness( edge, tw->polygonEdgePlueckerCache[i], v->pl, bitNum );
 			if ( INTSIGNBITSET(edgeNum) ^ ((edge->side >> bitNum) & 1) ) {
 				return;
@@ -440,6 +441,7 @@ void idCollisionModelManagerLocal::TranslatePointThroughPolygon( cm_traceWork_t
 	int i, edgeNum;
 	float f;
 	cm_edge_t *edge;
+	cm_featureCheck_t *edgeCheck;
 	idPluecker pl;
 
 	f = CM_TranslationPlaneFraction( poly->plane, v->p, v->endp );
@@ -448,17 +450,18 @@ void idCollisionModelManagerLocal::TranslatePointThroughPolygon( cm_traceWork_t
 		for ( i = 0; i < poly->numEdges; i++ ) {
 			edgeNum = poly->edges[i];
 			edge = tw->model->edges + abs(edgeNum);
+			edgeCheck = tw->edgeChecks + abs(edgeNum);
 			// if we didn't yet calculate the sidedness for this edge
-			if ( edge->checkcount != idCollisionModelManagerLocal::checkCount ) {
+			if ( edgeCheck->checkcount != tw->checkCount ) {
 				float fl;
-				edge->checkcount = idCollisionModelManagerLocal::checkCount;
+				edgeCheck->checkcount = tw->checkCount;
 				pl.FromLine(tw->model->vertices[edge->vertexNum[0]].p, tw->model->vertices[edge->vertexNum[1]].p);
 				fl = v->pl.PermutedInnerProduct( pl );
-				edge->side = FLOATSIGNBITSET(fl);
+				edgeCheck->side = FLOATSIGNBITSET(fl);
 			}
 			// if the point passes the edge at the wrong side
-			//if ( (edgeNum > 0) == edge->side ) {
-			if ( INTSIGNBITSET(edgeNum) ^ edge->side ) {
+			//if ( (edgeNum > 0) == edgeCheck->side ) {
+			if ( INTSIGNBITSET(edgeNum) ^ edgeCheck->side ) {
 				return;
 			}
 		}
@@ -493,16 +496,18 @@ void idCollisionModelManagerLocal::TranslateVertexThroughTrmPolygon( cm_traceWor
 	int i, edgeNum;
 	float f;
 	cm_trmEdge_t *edge;
+	cm_featureCheck_t *vertexCheck;
 
 	f = CM_TranslationPlaneFraction( trmpoly->plane, v->p, endp );
 	if ( f < tw->trace.fraction ) {
 
+		vertexCheck = tw->vertexChecks + ( v - tw->model->vertices );
 		for ( i = 0; i < trmpoly->numEdges; i++ ) {
 			edgeNum = trmpoly->edges[i];
 			edge = tw->edges + abs(edgeNum);
 
-			CM_SetVertexSidedness( v, pl, edge->pl, edge->bitNum );
-			if ( INTSIGNBITSET(edgeNum) ^ ((v->side >> edge->bitNum) & 1) ) {
+			CM_SetVertexSidedness( vertexCheck, pl, edge->pl, edge->bitNum );
+			if ( INTSIGNBITSET(edgeNum) ^ ((vertexCheck->side >> edge->bitNum) & 1) ) {
 				return;
 			}
 		}
@@ -543,12 +548,13 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon( cm_traceWork_t *t
 	cm_trmPolygon_t *bp;
 	cm_vertex_t *v;
 	cm_edge_t *e;
+	cm_featureCheck_t *vc, *ec;
 
 	// if already checked this polygon
-	if ( p->checkcount == idCollisionModelManagerLocal::checkCount ) {
+	if ( tw->polygonChecks[p->checkNum] == tw->checkCount ) {
 		return false;
 	}
-	p->checkcount = idCollisionModelManagerLocal::checkCount;
+	tw->polygonChecks[p->checkNum] = tw->checkCount;
 
 	// if this polygon does not have the right contents behind it
 	if ( !(p->contents & tw->contents) ) {
@@ -601,18 +607,20 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon( cm_traceWork_t *t
 		for ( i = 0; i < p->numEdges; i++ ) {
 			edgeNum = p->edges[i];
 			e = tw->model->edges + abs(edgeNum);
+			ec = tw->edgeChecks + abs(edgeNum);
 			// reset sidedness cache if this is the first time we encounter this edge during this trace
-			if ( e->checkcount != idCollisionModelManagerLocal::checkCount ) {
-				e->sideSet = 0;
+			if ( ec->checkcount != tw->checkCount ) {
+				ec->sideSet = 0;
 			}
 			// pluecker coordinate for edge
 			tw->polygonEdgePlueckerCache[i].FromLine( tw->model->vertices[e->vertexNum[0]].p,
 														tw->model->vertices[e->vertexNum[1]].p );
 
 			v = &tw->model->vertices[e->vertexNum[INTSIGNBITSET(edgeNum)]];
+			vc = tw->vertexChecks + e->vertexNum[INTSIGNBITSET(edgeNum)];
 			// reset sidedness cache if this is the first time we encounter this vertex during this trace
-			if ( v->checkcount != idCollisionModelManagerLocal::checkCount ) {
-				v->sideSet = 0;
+			if ( vc->checkcount != tw->checkCount ) {
+				vc->sideSet = 0;
 			}
 			// pluecker coordinate for vertex movement vector
 			tw->polygonVertexPlueckerCache[i].FromRay( v->p, -tw->dir );
@@ -640,12 +648,13 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon( cm_traceWork_t *t
 		for ( i = 0; i < p->numEdges; i++ ) {
 			edgeNum = p->edges[i];
 			e = tw->model->edges + abs(edgeNum);
+			ec = tw->edgeChecks + abs(edgeNum);
 
-			if ( e->checkcount == idCollisionModelManagerLocal::checkCount ) {
+			if ( ec->checkcount == tw->checkCount ) {
 				continue;
 			}
 			// set edge check count
-			e->checkcount = idCollisionModelManagerLocal::checkCount;
+			ec->checkcount = tw->checkCount;
 			// can never collide with internal edges
 			if ( e->internal ) {
 				continue;
@@ -654,12 +663,13 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon( cm_traceWork_t *t
 			for ( k = 0; k < 2; k++ ) {
 
 				v = tw->model->vertices + e->vertexNum[k ^ INTSIGNBITSET(edgeNum)];
+				vc = tw->vertexChecks + e->vertexNum[k ^ INTSIGNBITSET(edgeNum)];
 				// if this vertex is already checked
-				if ( v->checkcount == idCollisionModelManagerLocal::checkCount ) {
+				if ( vc->checkcount == tw->checkCount ) {
 					continue;
 				}
 				// set vertex check count
-				v->checkcount = idCollisionModelManagerLocal::checkCount;
+				vc->checkcount = tw->checkCount;
 
 				// if the vertex is outside the trace bounds
 				if ( !tw->bounds.ContainsPoint( v->p ) ) {
@@ -760,7 +770,7 @@ idCollisionModelManagerLocal::Translation
 ================
 */
 #ifdef _DEBUG
-static int entered = 0;
+static ID_THREAD_LOCAL int entered = 0;
 #endif
 
 void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &start, const idVec3 &end,
@@ -775,7 +785,8 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 	cm_trmPolygon_t *poly;
 	cm_trmEdge_t *edge;
 	cm_trmVertex_t *vert;
-	ALIGN16( static cm_traceWork_t tw );
+	cm_threadWork_t *work;
+	ALIGN16( cm_traceWork_t tw );
 
 	assert( ((byte *)&start) < ((byte *)results) || ((byte *)&start) >= (((byte *)results) + sizeof( trace_t )) );
 	assert( ((byte *)&end) < ((byte *)results) || ((byte *)&end) >= (((byte *)results) + sizeof( trace_t )) );
@@ -787,7 +798,7 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 		common->Printf("idCollisionModelManagerLocal::Translation: invalid model handle\n");
 		return;
 	}
-	if ( !idCollisionModelManagerLocal::models[model] ) {
+	if ( model != TRACE_MODEL_HANDLE && !idCollisionModelManagerLocal::models[model] ) {
 		common->Printf("idCollisionModelManagerLocal::Translation: invalid model\n");
 		return;
 	}
@@ -802,7 +813,7 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 	bool startsolid = false;
 	// test whether or not stuck to begin with
 	if ( cm_debugCollision.GetBool() ) {
-		if ( !entered && !idCollisionModelManagerLocal::getContacts ) {
+		if ( !entered && !idCollisionModelManagerLocal::GetThreadWork()->getContacts ) {
 			entered = 1;
 			// if already messed up to begin with
 			if ( idCollisionModelManagerLocal::Contents( start, trm, trmAxis, -1, model, modelOrigin, modelAxis ) & contentMask ) {
@@ -813,7 +824,7 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 	}
 #endif
 
-	idCollisionModelManagerLocal::checkCount++;
+	work = idCollisionModelManagerLocal::GetThreadWork();
 
 	tw.trace.fraction = 1.0f;
 	tw.trace.c.contents = 0;
@@ -823,11 +834,12 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 	tw.rotation = false;
 	tw.positionTest = false;
 	tw.quickExit = false;
-	tw.getContacts = idCollisionModelManagerLocal::getContacts;
-	tw.contacts = idCollisionModelManagerLocal::contacts;
-	tw.maxContacts = idCollisionModelManagerLocal::maxContacts;
+	tw.getContacts = work->getContacts;
+	tw.contacts = work->contacts;
+	tw.maxContacts = work->maxContacts;
 	tw.numContacts = 0;
-	tw.model = idCollisionModelManagerLocal::models[model];
+	tw.model = idCollisionModelManagerLocal::ThreadModel( model, work );
+	idCollisionModelManagerLocal::SetupTraceWork( &tw, work );
 	tw.start = start - modelOrigin;
 	tw.end = end - modelOrigin;
 	tw.dir = end - start;
@@ -890,7 +902,7 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 			results->c.point += modelOrigin;
 			results->c.dist += modelOrigin * results->c.normal;
 		}
-		idCollisionModelManagerLocal::numContacts = tw.numContacts;
+		work->numContacts = tw.numContacts;
 		return;
 	}
 
@@ -1077,7 +1089,7 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 				tw.contacts[i].dist += modelOrigin * tw.contacts[i].normal;
 			}
 		}
-		idCollisionModelManagerLocal::numContacts = tw.numContacts;
+		work->numContacts = tw.numContacts;
 	} else {
 		// store results
 		*results = tw.trace;
@@ -1102,7 +1114,7 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 #ifdef _DEBUG
 	// test for missed collisions
 	if ( cm_debugCollision.GetBool() ) {
-		if ( !entered && !idCollisionModelManagerLocal::getContacts ) {
+		if ( !entered && !work->getContacts ) {
 			entered = 1;
 			// if the trm is stuck in the model
 			if ( idCollisionModelManagerLocal::Contents( results->endpos, trm, trmAxis, -1, model, modelOrigin, modelAxis ) & contentMask ) {
@@ -1118,3 +1130,407 @@ void idCollisionModelManagerLocal::Translation( trace_t *results, const idVec3 &
 	}
 #endif
 }
+
+/*
+===============================================================================
+
+Batched point traces
+
+===============================================================================
+*/
+
+/*
+================
+idCollisionModelManagerLocal::TracePointPacketThroughPolygon
+
+  Same as TranslatePointThroughPolygon but for all points in the packet that reached the polygon.
+  Returns the points that are stopped at the start of their trace by the polygon.
+================
+*/
+int idCollisionModelManagerLocal::TracePointPacketThroughPolygon( cm_pointPacket_t *pp, cm_polygon_t *p, int points ) {
+	int i, j, edgeNum, edgeSide, hit, stopped;
+	float f[CM_POINT_PACKET_SIZE], d[CM_POINT_PACKET_SIZE];
+	idVec3 dir, endp;
+	idPluecker pl;
+	cm_edge_t *edge;
+	trace_t *trace;
+
+	// skip the points that already tested this polygon
+	if ( pp->polygonChecks[p->checkNum] != pp->checkCount ) {
+		pp->polygonChecks[p->checkNum] = pp->checkCount;
+		pp->polygonPoints[p->checkNum] = 0;
+	}
+	points &= ~pp->polygonPoints[p->checkNum];
+	pp->polygonPoints[p->checkNum] |= points;
+	if ( !points ) {
+		return 0;
+	}
+
+	// if this polygon does not have the right contents behind it
+	if ( !(p->contents & pp->contents) ) {
+		return 0;
+	}
+
+	// bounds and facing tests for the whole packet at once
+	const idBounds &b = p->bounds;
+	const idVec3 &normal = p->plane.Normal();
+	hit = 0;
+	for ( i = 0; i < CM_POINT_PACKET_SIZE; i++ ) {
+		d[i] = normal[0] * pp->dir[0][i] + normal[1] * pp->dir[1][i] + normal[2] * pp->dir[2][i];
+		hit |= ( ( b[1][0] >= pp->mins[0][i] ) & ( b[1][1] >= pp->mins[1][i] ) & ( b[1][2] >= pp->mins[2][i] ) &
+					( b[0][0] <= pp->maxs[0][i] ) & ( b[0][1] <= pp->maxs[1][i] ) & ( b[0][2] <= pp->maxs[2][i] ) &
+						( d[i] <= 0.0f ) ) << i;
+	}
+	points &= hit;
+
+	hit = 0;
+	for ( i = 0; i < pp->numPoints; i++ ) {
+		if ( !( points & ( 1 << i ) ) ) {
+			continue;
+		}
+		// if the polygon is too far from the trace heart planes
+		if ( idMath::Fabs( b.PlaneDistance( pp->heartPlane1[i] ) ) > CM_BOX_EPSILON ) {
+			continue;
+		}
+		if ( idMath::Fabs( b.PlaneDistance( pp->heartPlane2[i] ) ) > CM_BOX_EPSILON ) {
+			continue;
+		}
+		dir.Set( pp->dir[0][i], pp->dir[1][i], pp->dir[2][i] );
+		endp = pp->start[i] + dir;
+		f[i] = CM_TranslationPlaneFraction( p->plane, pp->start[i], endp );
+		if ( f[i] < pp->trace[i].fraction ) {
+			hit |= 1 << i;
+		}
+	}
+	if ( !hit ) {
+		return 0;
+	}
+
+	// the pluecker coordinates of the polygon edges are shared by all points
+	for ( j = 0; j < p->numEdges; j++ ) {
+		edgeNum = p->edges[j];
+		edge = pp->model->edges + abs(edgeNum);
+		pl.FromLine( pp->model->vertices[edge->vertexNum[0]].p, pp->model->vertices[edge->vertexNum[1]].p );
+		// permuted inner products for the whole packet at once
+		for ( i = 0; i < CM_POINT_PACKET_SIZE; i++ ) {
+			d[i] = pp->pl[0][i] * pl[4] + pp->pl[1][i] * pl[5] + pp->pl[2][i] * pl[3] + pp->pl[4][i] * pl[0] + pp->pl[5][i] * pl[1] + pp->pl[3][i] * pl[2];
+		}
+		// remove the points that pass the edge at the wrong side
+		edgeSide = INTSIGNBITSET(edgeNum);
+		for ( i = 0; i < CM_POINT_PACKET_SIZE; i++ ) {
+			hit &= ~( ( edgeSide ^ FLOATSIGNBITSET(d[i]) ) << i );
+		}
+		if ( !hit ) {
+			return 0;
+		}
+	}
+
+	stopped = 0;
+	for ( i = 0; i < pp->numPoints; i++ ) {
+		if ( !( hit & ( 1 << i ) ) ) {
+			continue;
+		}
+		if ( f[i] <= 0.0f ) {
+			f[i] = 0.0f;
+			stopped |= 1 << i;
+		}
+		trace = &pp->trace[i];
+		trace->fraction = f[i];
+		// collision plane is the polygon plane
+		trace->c.normal = p->plane.Normal();
+		trace->c.dist = p->plane.Dist();
+		trace->c.contents = p->contents;
+		trace->c.material = p->material;
+		trace->c.type = CONTACT_TRMVERTEX;
+		trace->c.modelFeature = *reinterpret_cast<int *>(&p);
+		trace->c.trmFeature = 0;
+		dir.Set( pp->dir[0][i], pp->dir[1][i], pp->dir[2][i] );
+		endp = pp->start[i] + dir;
+		trace->c.point = pp->start[i] + trace->fraction * ( endp - pp->start[i] );
+		// decrease bounds
+		endp = pp->start[i] + trace->fraction * dir;
+		for ( j = 0; j < 3; j++ ) {
+			if ( pp->start[i][j] < endp[j] ) {
+				pp->mins[j][i] = pp->start[i][j] - CM_BOX_EPSILON;
+				pp->maxs[j][i] = endp[j] + CM_BOX_EPSILON;
+			}
+			else {
+				pp->mins[j][i] = endp[j] - CM_BOX_EPSILON;
+				pp->maxs[j][i] = pp->start[i][j] + CM_BOX_EPSILON;
+			}
+		}
+	}
+	return stopped;
+}
+
+/*
+================
+idCollisionModelManagerLocal::TracePointPacketThroughAxialBSPTree_r
+
+  Same as TraceThroughAxialBSPTree_r for a point trace but every point in the packet has its own segment.
+  The node is visited once for all points that reach it.
+================
+*/
+void idCollisionModelManagerLocal::TracePointPacketThroughAxialBSPTree_r( cm_pointPacket_t *pp, cm_node_t *node, int points,
+											const float *p1f, const float *p2f, const idVec3 *p1, const idVec3 *p2 ) {
+	int i, bits, side, first, nearSide, childPoints[2];
+	float t1, t2, frac, frac2, idist;
+	float childp1f[2][CM_POINT_PACKET_SIZE], childp2f[2][CM_POINT_PACKET_SIZE];
+	idVec3 childp1[2][CM_POINT_PACKET_SIZE], childp2[2][CM_POINT_PACKET_SIZE];
+	cm_polygonRef_t *pref;
+
+	if ( !node ) {
+		return;
+	}
+
+	// drop the points that already hit something nearer
+	for ( i = 0, bits = points; bits; i++, bits >>= 1 ) {
+		if ( ( bits & 1 ) && pp->trace[i].fraction <= p1f[i] ) {
+			points &= ~( 1 << i );
+		}
+	}
+	if ( !points ) {
+		return;
+	}
+
+	// trace through all polygons in this node, like a single trace a point
+	// stops at the first polygon that gives it a zero fraction
+	for ( pref = node->polygons; pref; pref = pref->next ) {
+		points &= ~idCollisionModelManagerLocal::TracePointPacketThroughPolygon( pp, pref->p, points );
+		if ( !points ) {
+			return;
+		}
+	}
+	// if this is a leaf node
+	if ( node->planeType == -1 ) {
+		return;
+	}
+
+	childPoints[0] = childPoints[1] = 0;
+	nearSide = 0;
+	for ( i = 0, bits = points; bits; i++, bits >>= 1 ) {
+		if ( !( bits & 1 ) ) {
+			continue;
+		}
+		// distance from plane for trace start and end
+		t1 = p1[i][node->planeType] - node->planeDist;
+		t2 = p2[i][node->planeType] - node->planeDist;
+		// see which sides we need to consider
+		if ( t1 >= CM_BOX_EPSILON && t2 >= CM_BOX_EPSILON ) {
+			side = 0;
+		}
+		else if ( t1 < -CM_BOX_EPSILON && t2 < -CM_BOX_EPSILON ) {
+			side = 1;
+		}
+		else {
+			side = -1;
+		}
+		if ( side >= 0 ) {
+			childPoints[side] |= 1 << i;
+			childp1f[side][i] = p1f[i];
+			childp2f[side][i] = p2f[i];
+			childp1[side][i] = p1[i];
+			childp2[side][i] = p2[i];
+			continue;
+		}
+
+		if ( t1 < t2 ) {
+			idist = 1.0f / (t1-t2);
+			side = 1;
+			frac2 = (t1 + CM_BOX_EPSILON) * idist;
+			frac = (t1 - CM_BOX_EPSILON) * idist;
+		} else if (t1 > t2) {
+			idist = 1.0f / (t1-t2);
+			side = 0;
+			frac2 = (t1 - CM_BOX_EPSILON) * idist;
+			frac = (t1 + CM_BOX_EPSILON) * idist;
+		} else {
+			side = 0;
+			frac = 1.0f;
+			frac2 = 0.0f;
+		}
+		nearSide += side ? 1 : -1;
+
+		// move up to the node
+		if ( frac < 0.0f ) {
+			frac = 0.0f;
+		}
+		else if ( frac > 1.0f ) {
+			frac = 1.0f;
+		}
+		childPoints[side] |= 1 << i;
+		childp1f[side][i] = p1f[i];
+		childp2f[side][i] = p1f[i] + (p2f[i] - p1f[i])*frac;
+		childp1[side][i] = p1[i];
+		childp2[side][i][0] = p1[i][0] + frac*(p2[i][0] - p1[i][0]);
+		childp2[side][i][1] = p1[i][1] + frac*(p2[i][1] - p1[i][1]);
+		childp2[side][i][2] = p1[i][2] + frac*(p2[i][2] - p1[i][2]);
+
+		// go past the node
+		if ( frac2 < 0.0f ) {
+			frac2 = 0.0f;
+		}
+		else if ( frac2 > 1.0f ) {
+			frac2 = 1.0f;
+		}
+		childPoints[side^1] |= 1 << i;
+		childp1f[side^1][i] = p1f[i] + (p2f[i] - p1f[i])*frac2;
+		childp2f[side^1][i] = p2f[i];
+		childp1[side^1][i][0] = p1[i][0] + frac2*(p2[i][0] - p1[i][0]);
+		childp1[side^1][i][1] = p1[i][1] + frac2*(p2[i][1] - p1[i][1]);
+		childp1[side^1][i][2] = p1[i][2] + frac2*(p2[i][2] - p1[i][2]);
+		childp2[side^1][i] = p2[i];
+	}
+
+	// first go to the child that is nearest for most of the crossing points
+	first = ( nearSide > 0 );
+	if ( childPoints[first] ) {
+		idCollisionModelManagerLocal::TracePointPacketThroughAxialBSPTree_r( pp, node->children[first], childPoints[first],
+										childp1f[first], childp2f[first], childp1[first], childp2[first] );
+	}
+	if ( childPoints[first^1] ) {
+		idCollisionModelManagerLocal::TracePointPacketThroughAxialBSPTree_r( pp, node->children[first^1], childPoints[first^1],
+										childp1f[first^1], childp2f[first^1], childp1[first^1], childp2[first^1] );
+	}
+}
+
+/*
+================
+idCollisionModelManagerLocal::TracePoints
+
+  Gives the same results as a point Translation for each trace. The points are traced in packets
+  that descend the BSP tree together so the nodes and polygon edges are shared by the points.
+  Only traces that are close together gain from this, like traces fanning out from a single point,
+  so callers should keep such traces next to each other.
+================
+*/
+void idCollisionModelManagerLocal::TracePoints( trace_t *results, const idVec3 *starts, const idVec3 *ends, const int numPoints, int contentMask,
+										cmHandle_t model, const idVec3 &modelOrigin, const idMat3 &modelAxis ) {
+	int i, j, k, n, points;
+	bool model_rotated;
+	idMat3 invModelAxis;
+	idVec3 dir, normal1, normal2;
+	idPluecker pl;
+	float p1f[CM_POINT_PACKET_SIZE], p2f[CM_POINT_PACKET_SIZE];
+	cm_threadWork_t *work;
+	cm_pointPacket_t pp;
+
+	memset( results, 0, numPoints * sizeof( results[0] ) );
+
+	if ( model < 0 || model > MAX_SUBMODELS || model > idCollisionModelManagerLocal::maxModels ) {
+		common->Printf("idCollisionModelManagerLocal::TracePoints: invalid model handle\n");
+		return;
+	}
+	if ( model != TRACE_MODEL_HANDLE && !idCollisionModelManagerLocal::models[model] ) {
+		common->Printf("idCollisionModelManagerLocal::TracePoints: invalid model\n");
+		return;
+	}
+
+	work = idCollisionModelManagerLocal::GetThreadWork();
+
+	model_rotated = modelAxis.IsRotated();
+	if ( model_rotated ) {
+		invModelAxis = modelAxis.Transpose();
+	}
+
+	pp.contents = contentMask;
+	pp.model = idCollisionModelManagerLocal::ThreadModel( model, work );
+
+	for ( i = 0; i < numPoints; i += n ) {
+		n = Min( numPoints - i, CM_POINT_PACKET_SIZE );
+
+		idCollisionModelManagerLocal::SetupThreadChecks( work, pp.model );
+		pp.checkCount = work->checkCount;
+		pp.polygonChecks = work->polygonChecks;
+		pp.polygonPoints = work->polygonPoints;
+		pp.numPoints = n;
+		memset( pp.dir, 0, sizeof( pp.dir ) );
+		memset( pp.mins, 0, sizeof( pp.mins ) );
+		memset( pp.maxs, 0, sizeof( pp.maxs ) );
+		memset( pp.pl, 0, sizeof( pp.pl ) );
+
+		points = 0;
+		for ( k = 0; k < n; k++ ) {
+			const idVec3 &start = starts[i+k];
+			const idVec3 &end = ends[i+k];
+
+			// if case special position test
+			if ( start[0] == end[0] && start[1] == end[1] && start[2] == end[2] ) {
+				idCollisionModelManagerLocal::ContentsTrm( &results[i+k], start, NULL, mat3_identity, contentMask, model, modelOrigin, modelAxis );
+				continue;
+			}
+			points |= 1 << k;
+
+			memset( &pp.trace[k], 0, sizeof( pp.trace[k] ) );
+			pp.trace[k].fraction = 1.0f;
+			pp.trace[k].c.type = CONTACT_NONE;
+			pp.start[k] = start - modelOrigin;
+			pp.end[k] = end - modelOrigin;
+			dir = end - start;
+			if ( model_rotated ) {
+				// rotate trace instead of model
+				pp.start[k] *= invModelAxis;
+				pp.end[k] *= invModelAxis;
+				dir *= invModelAxis;
+			}
+
+			// trace bounds
+			for ( j = 0; j < 3; j++ ) {
+				pp.dir[j][k] = dir[j];
+				if ( pp.start[k][j] < pp.end[k][j] ) {
+					pp.mins[j][k] = pp.start[k][j] - CM_BOX_EPSILON;
+					pp.maxs[j][k] = pp.end[k][j] + CM_BOX_EPSILON;
+				}
+				else {
+					pp.mins[j][k] = pp.end[k][j] - CM_BOX_EPSILON;
+					pp.maxs[j][k] = pp.start[k][j] + CM_BOX_EPSILON;
+				}
+			}
+
+			// pluecker coordinate for the point movement
+			pl.FromRay( pp.start[k], dir );
+			for ( j = 0; j < 6; j++ ) {
+				pp.pl[j][k] = pl[j];
+			}
+
+			// trace heart planes
+			dir.Normalize();
+			dir.NormalVectors( normal1, normal2 );
+			pp.heartPlane1[k].SetNormal( normal1 );
+			pp.heartPlane1[k].FitThroughPoint( pp.start[k] );
+			pp.heartPlane2[k].SetNormal( normal2 );
+			pp.heartPlane2[k].FitThroughPoint( pp.start[k] );
+
+			p1f[k] = 0.0f;
+			p2f[k] = 1.0f;
+		}
+
+		if ( !points ) {
+			continue;
+		}
+
+		// trace the packet through the model
+		idCollisionModelManagerLocal::TracePointPacketThroughAxialBSPTree_r( &pp, pp.model->node, points, p1f, p2f, pp.start, pp.end );
+
+		// store results
+		for ( k = 0; k < n; k++ ) {
+			if ( !( points & ( 1 << k ) ) ) {
+				continue;
+			}
+			trace_t &result = results[i+k];
+			result = pp.trace[k];
+			result.endpos = starts[i+k] + result.fraction * ( ends[i+k] - starts[i+k] );
+			result.endAxis = mat3_identity;
+
+			if ( result.fraction < 1.0f ) {
+				// rotate trace plane normal if there was a collision with a rotated model
+				if ( model_rotated ) {
+					result.c.normal *= modelAxis;
+					result.c.point *= modelAxis;
+				}
+				result.c.point += modelOrigin;
+				result.c.dist += modelOrigin * result.c.normal;
+			}
+		}
+	}
+}
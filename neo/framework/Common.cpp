@@ -2368,6 +2368,8 @@ void idCommonLocal::InitCommands( void ) {
 	// idLib commands
 	cmdSystem->AddCommand( "memoryDump", Mem_Dump_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "creates a memory dump" );
 	cmdSystem->AddCommand( "memoryDumpCompressed", Mem_DumpCompressed_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "creates a compressed memory dump" );
+	cmdSystem->AddCommand( "memoryTrace", Mem_Trace_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "records memory allocations to a file" );
+	cmdSystem->AddCommand( "testHeap", Mem_TestHeap_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "replays a memory trace against the heap and malloc" );
 	cmdSystem->AddCommand( "showStringMemory", idStr::ShowMemoryUsage_f, CMD_FL_SYSTEM, "shows memory used by strings" );
 	cmdSystem->AddCommand( "showDictMemory", idDict::ShowMemoryUsage_f, CMD_FL_SYSTEM, "shows memory used by dictionaries" );
 	cmdSystem->AddCommand( "listDictKeys", idDict::ListKeys_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "lists all keys used by dictionaries" );
@@ -2670,6 +2672,7 @@ void idCommonLocal::LoadGameDLL( void ) {
 	gameImport.declManager				= ::declManager;
 	gameImport.AASFileManager			= ::AASFileManager;
 	gameImport.collisionModelManager	= ::collisionModelManager;
+	gameImport.jobSystem				= ::jobSystem;
 
 	gameExport							= *GetGameAPI( &gameImport );
 
@@ -2826,6 +2829,9 @@ void idCommonLocal::Init( int argc, const char **argv, const char *cmdline ) {
 		// init commands
 		InitCommands();
 
+		// start the job worker threads
+		jobSystem->Init();
+
 #ifdef ID_WRITE_VERSION
 		config_compressor = idCompressor::AllocArithmetic();
 #endif
@@ -2881,6 +2887,9 @@ void idCommonLocal::Shutdown( void ) {
 	// game specific shut down
 	ShutdownGame( false );
 
+	// stop the job worker threads
+	jobSystem->Shutdown();
+
 	// shut down non-portable system services
 	Sys_Shutdown();
 
@@ -153,6 +153,37 @@ private:
 	idDeclLocal *				nextInFile;				// next decl in the decl file
 };
 
+// a declaration found by idDeclFile::Scan
+typedef struct {
+	declType_t					type;
+	idStr						name;
+	int							textOffset;				// offset in source file to decl text
+	int							textLength;				// length of decl text in source file
+	int							sourceLine;				// this is where the actual declaration token starts
+	int							checksum;				// checksum of the decl text
+	char *						textSource;				// decl text as stored by idDeclLocal::SetTextLocal
+	int							compressedLength;
+} declHeader_t;
+
+// the text of a decl file and the declarations in it, the scan doesn't touch
+// the decl manager so the files of a decl folder can be scanned in parallel
+class idDeclFileScan {
+public:
+								idDeclFileScan( void );
+								~idDeclFileScan( void );
+
+	void						FreeHeaders( void );
+	void						Free( void );
+
+	idDeclFile *				file;
+	char *						buffer;
+	int							length;
+	int							checksum;
+	int							numLines;
+	bool						clean;					// set if the lexer and the scan had nothing to warn about
+	idList<declHeader_t>		headers;
+};
+
 class idDeclFile {
 public:
 								idDeclFile();
@@ -161,6 +192,10 @@ public:
 	void						Reload( bool force );
 	int							LoadAndParse();
 
+	bool						Read( idDeclFileScan &scan );
+	void						Scan( idDeclFileScan &scan, bool printWarnings ) const;
+	int							Merge( idDeclFileScan &scan );
+
 public:
 	idStr						fileName;
 	declType_t					defaultType;
@@ -236,13 +271,17 @@ private:
 	bool						insideLevelLoad;
 
 	static idCVar				decl_show;
+	static idCVar				decl_parallelScan;
 
 private:
+	static void					ScanDeclFilesJob( void *data, int first, int last );
+
 	static void					ListDecls_f( const idCmdArgs &args );
 	static void					ReloadDecls_f( const idCmdArgs &args );
 	static void					TouchDecl_f( const idCmdArgs &args );
 };
 
+idCVar idDeclManagerLocal::decl_parallelScan( "decl_parallelScan", "1", CVAR_SYSTEM | CVAR_BOOL, "scan the files of a decl folder on the job workers" );
 idCVar idDeclManagerLocal::decl_show( "decl_show", "0", CVAR_SYSTEM, "set to 1 to print parses, 2 to also print references", 0, 2, idCmdSystem::ArgCompletion_Integer<0,2> );
 
 idDeclManagerLocal	declManagerLocal;
@@ -309,8 +348,8 @@ static int huffmanFrequencies[] = {
 
 static huffmanCode_t huffmanCodes[MAX_HUFFMAN_SYMBOLS];
 static huffmanNode_t *huffmanTree = NULL;
-static int totalUncompressedLength = 0;
-static int totalCompressedLength = 0;
+static volatile int totalUncompressedLength = 0;
+static volatile int totalCompressedLength = 0;
 static int maxHuffmanBits = 0;
 
 
@@ -465,7 +504,7 @@ int HuffmanCompressText( const char *text, int textLength, byte *compressed, int
 	int i, j;
 	idBitMsg msg;
 
-	totalUncompressedLength += textLength;
+	Sys_InterlockedAdd( totalUncompressedLength, textLength );
 
 	msg.Init( compressed, maxCompressedSize );
 	msg.BeginWriting();
@@ -479,7 +518,7 @@ int HuffmanCompressText( const char *text, int textLength, byte *compressed, int
 		}
 	}
 
-	totalCompressedLength += msg.GetSize();
+	Sys_InterlockedAdd( totalCompressedLength, msg.GetSize() );
 
 	return msg.GetSize();
 }
@@ -509,6 +548,62 @@ int HuffmanDecompressText( char *text, int textLength, const byte *compressed, i
 	return msg.GetReadCount();
 }
 
+/*
+================
+EncodeDeclText
+
+Returns the decl text the way idDeclLocal::textSource stores it, this can be called from the job workers.
+================
+*/
+static const int MAX_ALLOCA_DECL_TEXT = 0x10000;
+
+static char *EncodeDeclText( const char *text, const int length, int &compressedLength ) {
+	char *textSource;
+
+#ifdef GET_HUFFMAN_FREQUENCIES
+	for( int i = 0; i < length; i++ ) {
+		huffmanFrequencies[((const unsigned char *)text)[i]]++;
+	}
+#endif
+
+#ifdef USE_COMPRESSED_DECLS
+	int maxBytesPerCode = ( maxHuffmanBits + 7 ) >> 3;
+	int maxCompressedLength = length * maxBytesPerCode;
+	// the job workers don't have the stack space for the largest decls
+	bool largeText = ( maxCompressedLength > MAX_ALLOCA_DECL_TEXT );
+	byte *compressed = largeText ? (byte *)Mem_Alloc( maxCompressedLength ) : (byte *)_alloca( maxCompressedLength );
+	compressedLength = HuffmanCompressText( text, length, compressed, maxCompressedLength );
+	textSource = (char *)Mem_Alloc( compressedLength );
+	memcpy( textSource, compressed, compressedLength );
+	if ( largeText ) {
+		Mem_Free( compressed );
+	}
+#else
+	compressedLength = length;
+	textSource = (char *) Mem_Alloc( length + 1 );
+	memcpy( textSource, text, length );
+	textSource[length] = '\0';
+#endif
+
+	return textSource;
+}
+
+/*
+================
+FreeDeclText
+
+Frees decl text from EncodeDeclText that is thrown away instead of given to a decl.
+================
+*/
+static void FreeDeclText( char *textSource, const int length, const int compressedLength ) {
+#ifdef USE_COMPRESSED_DECLS
+	// the text isn't used so it doesn't count towards the compression stats
+	Sys_InterlockedAdd( totalUncompressedLength, -length );
+	Sys_InterlockedAdd( totalCompressedLength, -compressedLength );
+#endif
+	Mem_Free( textSource );
+}
+
 /*
 ================
 ListHuffmanFrequencies_f
@@ -538,6 +633,65 @@ void ListHuffmanFrequencies_f( const idCmdArgs &args ) {
 ====================================================================================
 */
 
+/*
+====================================================================================
+
+ idDeclFileScan
+
+====================================================================================
+*/
+
+/*
+================
+idDeclFileScan::idDeclFileScan
+================
+*/
+idDeclFileScan::idDeclFileScan( void ) {
+	file = NULL;
+	buffer = NULL;
+	length = 0;
+	checksum = 0;
+	numLines = 0;
+	clean = false;
+}
+
+/*
+================
+idDeclFileScan::~idDeclFileScan
+================
+*/
+idDeclFileScan::~idDeclFileScan( void ) {
+	Free();
+}
+
+/*
+================
+idDeclFileScan::FreeHeaders
+================
+*/
+void idDeclFileScan::FreeHeaders( void ) {
+	for ( int i = 0; i < headers.Num(); i++ ) {
+		if ( headers[i].textSource ) {
+			FreeDeclText( headers[i].textSource, headers[i].textLength, headers[i].compressedLength );
+		}
+	}
+	headers.Clear();
+}
+
+/*
+================
+idDeclFileScan::Free
+================
+*/
+void idDeclFileScan::Free( void ) {
+	FreeHeaders();
+	if ( buffer ) {
+		fileSystem->FreeFile( buffer );
+		buffer = NULL;
+	}
+	length = 0;
+}
+
 /*
 ================
 idDeclFile::idDeclFile
@@ -600,41 +754,69 @@ This is used during both the initial load, and any reloads
 int c_savedMemory = 0;
 
 int idDeclFile::LoadAndParse() {
+	idDeclFileScan scan;
+
+	if ( !Read( scan ) ) {
+		return 0;
+	}
+	Scan( scan, true );
+	return Merge( scan );
+}
+
+/*
+================
+idDeclFile::Read
+
+Loads the file text into the scan, the file system is only used from the main thread
+================
+*/
+bool idDeclFile::Read( idDeclFileScan &scan ) {
+	scan.Free();
+	scan.file = this;
+
+	common->DPrintf( "...loading '%s'\n", fileName.c_str() );
+	scan.length = fileSystem->ReadFile( fileName, (void **)&scan.buffer, &timestamp );
+	if ( scan.length == -1 ) {
+		scan.buffer = NULL;
+		scan.length = 0;
+		common->FatalError( "couldn't load %s", fileName.c_str() );
+		return false;
+	}
+	return true;
+}
+
+/*
+================
+idDeclFile::Scan
+
+Identifies each individual declaration in the file text and encodes its text.
+This only reads the decl types from the decl manager so it can run on the job
+workers with printWarnings false, the scan isn't clean if there was anything to
+warn about and it has to be scanned again on the main thread to print the warnings.
+================
+*/
+void idDeclFile::Scan( idDeclFileScan &scan, bool printWarnings ) const {
 	int			i, numTypes;
 	idLexer		src;
 	idToken		token;
 	int			startMarker;
-	char *		buffer;
-	int			length, size;
+	int			size;
 	int			sourceLine;
 	idStr		name;
-	idDeclLocal *newDecl;
-	bool		reparse;
-
-	// load the text
-	common->DPrintf( "...loading '%s'\n", fileName.c_str() );
-	length = fileSystem->ReadFile( fileName, (void **)&buffer, &timestamp );
-	if ( length == -1 ) {
-		common->FatalError( "couldn't load %s", fileName.c_str() );
-		return 0;
-	}
 
-	if ( !src.LoadMemory( buffer, length, fileName ) ) {
-		common->Error( "Couldn't parse %s", fileName.c_str() );
-		Mem_Free( buffer );
-		return 0;
-	}
+	scan.FreeHeaders();
+	scan.clean = false;
 
-	// mark all the defs that were from the last reload of this file
-	for ( idDeclLocal *decl = decls; decl; decl = decl->nextInFile ) {
-		decl->redefinedInReload = false;
+	if ( !src.LoadMemory( scan.buffer, scan.length, fileName ) ) {
+		if ( printWarnings ) {
+			common->Error( "Couldn't parse %s", fileName.c_str() );
+		}
+		return;
 	}
 
-	src.SetFlags( DECL_LEXER_FLAGS );
-
-	checksum = MD5_BlockChecksum( buffer, length );
+	src.SetFlags( printWarnings ? DECL_LEXER_FLAGS : ( DECL_LEXER_FLAGS | LEXFL_NOERRORS | LEXFL_NOWARNINGS ) );
 
-	fileSize = length;
+	scan.checksum = MD5_BlockChecksum( scan.buffer, scan.length );
 
 	// scan through, identifying each individual declaration
 	while( 1 ) {
@@ -716,14 +898,50 @@ int idDeclFile::LoadAndParse() {
 		src.SkipBracedSection();
 		size = src.GetFileOffset() - startMarker;
 
+		declHeader_t &header = scan.headers.Alloc();
+		header.type = identifiedType;
+		header.name = name;
+		header.textOffset = startMarker;
+		header.textLength = size;
+		header.sourceLine = sourceLine;
+		header.checksum = MD5_BlockChecksum( scan.buffer + startMarker, size );
+		header.textSource = EncodeDeclText( scan.buffer + startMarker, size, header.compressedLength );
+	}
+
+	scan.numLines = src.GetLineNum();
+	scan.clean = !src.HadError() && !src.HadWarning();
+}
+
+/*
+================
+idDeclFile::Merge
+
+Adds the scanned declarations to the decl lists in file order and frees the scan.
+================
+*/
+int idDeclFile::Merge( idDeclFileScan &scan ) {
+	idDeclLocal *newDecl;
+	bool		reparse;
+
+	// mark all the defs that were from the last reload of this file
+	for ( idDeclLocal *decl = decls; decl; decl = decl->nextInFile ) {
+		decl->redefinedInReload = false;
+	}
+
+	checksum = scan.checksum;
+	fileSize = scan.length;
+
+	for ( int i = 0; i < scan.headers.Num(); i++ ) {
+		declHeader_t &header = scan.headers[i];
+
 		// look it up, possibly getting a newly created default decl
 		reparse = false;
-		newDecl = declManagerLocal.FindTypeWithoutParsing( identifiedType, name, false );
+		newDecl = declManagerLocal.FindTypeWithoutParsing( header.type, header.name, false );
 		if ( newDecl ) {
 			// update the existing copy
 			if ( newDecl->sourceFile != this || newDecl->redefinedInReload ) {
-				src.Warning( "%s '%s' previously defined at %s:%i", declManagerLocal.GetDeclNameFromType( identifiedType ),
-								name.c_str(), newDecl->sourceFile->fileName.c_str(), newDecl->sourceLine );
+				common->Warning( "file %s, line %d: %s '%s' previously defined at %s:%i", fileName.c_str(), header.sourceLine,
+								declManagerLocal.GetDeclNameFromType( header.type ), header.name.c_str(), newDecl->sourceFile->fileName.c_str(), newDecl->sourceLine );
 				continue;
 			}
 			if ( newDecl->declState != DS_UNPARSED ) {
@@ -731,23 +949,25 @@ int idDeclFile::LoadAndParse() {
 			}
 		} else {
 			// allow it to be created as a default, then add it to the per-file list
-			newDecl = declManagerLocal.FindTypeWithoutParsing( identifiedType, name, true );
+			newDecl = declManagerLocal.FindTypeWithoutParsing( header.type, header.name, true );
 			newDecl->nextInFile = this->decls;
 			this->decls = newDecl;
 		}
 
 		newDecl->redefinedInReload = true;
 
-		if ( newDecl->textSource ) {
-			Mem_Free( newDecl->textSource );
-			newDecl->textSource = NULL;
-		}
+		// the scan already encoded the text like SetTextLocal
+		Mem_Free( newDecl->textSource );
+		newDecl->textSource = header.textSource;
+		newDecl->compressedLength = header.compressedLength;
+		newDecl->textLength = header.textLength;
+		newDecl->checksum = header.checksum;
+		header.textSource = NULL;
 
-		newDecl->SetTextLocal( buffer + startMarker, size );
 		newDecl->sourceFile = this;
-		newDecl->sourceTextOffset = startMarker;
-		newDecl->sourceTextLength = size;
-		newDecl->sourceLine = sourceLine;
+		newDecl->sourceTextOffset = header.textOffset;
+		newDecl->sourceTextLength = header.textLength;
+		newDecl->sourceLine = header.sourceLine;
 		newDecl->declState = DS_UNPARSED;
 
 		// if it is currently in use, reparse it immedaitely
@@ -756,9 +976,9 @@ int idDeclFile::LoadAndParse() {
 		}
 	}
 
-	numLines = src.GetLineNum();
+	numLines = scan.numLines;
 
-	Mem_Free( buffer );
+	scan.Free();
 
 	// any defs that weren't redefinedInReload should now be defaulted
 	for ( idDeclLocal *decl = decls ; decl ; decl = decl->nextInFile ) {
@@ -999,8 +1219,13 @@ void idDeclManagerLocal::RegisterDeclFolder( const char *folder, const char *ext
 	// scan for decl files
 	fileList = fileSystem->ListFiles( declFolder->folder, declFolder->extension, true );
 
-	// load and parse decl files
-	for ( i = 0; i < fileList->GetNumFiles(); i++ ) {
+	double startTicks = Sys_GetClockTicks();
+
+	int numFiles = fileList->GetNumFiles();
+	idDeclFileScan *scans = new idDeclFileScan[numFiles];
+
+	// load decl files
+	for ( i = 0; i < numFiles; i++ ) {
 		fileName = declFolder->folder + "/" + fileList->GetFile( i );
 
 		// check whether this file has already been loaded
@@ -1015,12 +1240,60 @@ void idDeclManagerLocal::RegisterDeclFolder( const char *folder, const char *ext
 			df = new idDeclFile( fileName, defaultType );
 			loadedFiles.Append( df );
 		}
-		df->LoadAndParse();
+		df->Read( scans[i] );
 	}
 
+	double readTicks = Sys_GetClockTicks();
+
+	// identify and encode the declarations of all files
+	bool parallel = decl_parallelScan.GetBool() && jobSystem->NumThreads() > 1 && numFiles > 1;
+#ifdef GET_HUFFMAN_FREQUENCIES
+	parallel = false;
+#endif
+	if ( parallel ) {
+		jobSystem->ParallelFor( ScanDeclFilesJob, scans, numFiles, 1 );
+	} else {
+		for ( i = 0; i < numFiles; i++ ) {
+			scans[i].file->Scan( scans[i], true );
+		}
+	}
+
+	double scanTicks = Sys_GetClockTicks();
+
+	// add them to the decl lists in file order so the decl indexes don't depend on the scan
+	int numDecls = 0;
+	for ( i = 0; i < numFiles; i++ ) {
+		if ( parallel && !scans[i].clean ) {
+			scans[i].file->Scan( scans[i], true );
+		}
+		numDecls += scans[i].headers.Num();
+		scans[i].file->Merge( scans[i] );
+	}
+
+	delete[] scans;
+
+	double mergeTicks = Sys_GetClockTicks();
+
+	common->DPrintf( "%5d decls in %4d %s/*%s files: read %.1f ms, scan %.1f ms, merge %.1f ms\n", numDecls, numFiles,
+					declFolder->folder.c_str(), declFolder->extension.c_str(), ( readTicks - startTicks ) * 1000.0 / Sys_ClockTicksPerSecond(),
+					( scanTicks - readTicks ) * 1000.0 / Sys_ClockTicksPerSecond(), ( mergeTicks - scanTicks ) * 1000.0 / Sys_ClockTicksPerSecond() );
+
 	fileSystem->FreeFileList( fileList );
 }
 
+/*
+===================
+idDeclManagerLocal::ScanDeclFilesJob
+===================
+*/
+void idDeclManagerLocal::ScanDeclFilesJob( void *data, int first, int last ) {
+	idDeclFileScan *scans = static_cast<idDeclFileScan *>( data );
+
+	for ( int i = first; i < last; i++ ) {
+		scans[i].file->Scan( scans[i], false );
+	}
+}
+
 /*
 ===================
 idDeclManagerLocal::GetChecksum
@@ -1912,25 +2185,7 @@ void idDeclLocal::SetTextLocal( const char *text, const int length ) {
 	Mem_Free( textSource );
 
 	checksum = MD5_BlockChecksum( text, length );
-
-#ifdef GET_HUFFMAN_FREQUENCIES
-	for( int i = 0; i < length; i++ ) {
-		huffmanFrequencies[((const unsigned char *)text)[i]]++;
-	}
-#endif
-
-#ifdef USE_COMPRESSED_DECLS
-	int maxBytesPerCode = ( maxHuffmanBits + 7 ) >> 3;
-	byte *compressed = (byte *)_alloca( length * maxBytesPerCode );
-	compressedLength = HuffmanCompressText( text, length, compressed, length * maxBytesPerCode );
-	textSource = (char *)Mem_Alloc( compressedLength );
-	memcpy( textSource, compressed, compressedLength );
-#else
-	compressedLength = length;
-	textSource = (char *) Mem_Alloc( length + 1 );
-	memcpy( textSource, text, length );
-	textSource[length] = '\0';
-#endif
+	textSource = EncodeDeclText( text, length, compressedLength );
 	textLength = length;
 }
 
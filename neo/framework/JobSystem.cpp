@@ -0,0 +1,778 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company. 
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).  
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#include "../idlib/precompiled.h"
+#pragma hdrstop
+
+const int MAX_JOB_THREADS		= 31;				// worker threads, the main thread also runs jobs
+const int JOB_QUEUE_SIZE		= 4096;				// must be a power of two
+const int JOB_SPIN_COUNT		= 2000;				// times a worker looks for jobs before going to sleep
+const int JOB_SLEEP_MSEC		= 100;
+const int JOB_RESERVED_THREADS	= 2;				// thread registry slots for the async and background download threads created later
+
+idCVar com_jobThreads( "com_jobThreads", "-1", CVAR_SYSTEM | CVAR_INTEGER | CVAR_INIT, "number of job worker threads, -1 = one less than the number of cores", -1, MAX_JOB_THREADS );
+
+typedef struct jobEntry_s {
+	jobRun_t				function;
+	jobRangeRun_t			rangeFunction;
+	void *					data;
+	int						first;
+	int						last;
+	idJobCounter *			counter;
+	struct jobEntry_s *		next;				// in the list of jobs depending on a counter
+} jobEntry_t;
+
+/*
+===============================================================================
+
+	idJobQueue
+
+	Work stealing deque (Chase and Lev). The owner thread pushes and pops
+	at the bottom, any other thread can steal from the top. top and bottom
+	only ever grow, the differences are computed with unsigned wrap around.
+
+===============================================================================
+*/
+
+class idJobQueue {
+public:
+							idJobQueue( void ) : top( 0 ), bottom( 0 ) {}
+
+	bool					Push( const jobEntry_t &job );		// owner only
+	bool					Pop( jobEntry_t &job );				// owner only
+	bool					Steal( jobEntry_t &job, const idJobCounter *counter = NULL );	// any thread, only jobs of the counter if given
+	bool					IsEmpty( void ) const { return Size( top, bottom ) <= 0; }
+
+private:
+	volatile int			top;
+	volatile int			bottom;
+	jobEntry_t				jobs[JOB_QUEUE_SIZE];
+
+	static int				Size( int t, int b ) { return (int)( (unsigned int)b - (unsigned int)t ); }
+};
+
+/*
+================
+idJobQueue::Push
+================
+*/
+bool idJobQueue::Push( const jobEntry_t &job ) {
+	int b = bottom;
+	int t = top;
+	if ( Size( t, b ) >= JOB_QUEUE_SIZE ) {
+		return false;
+	}
+	jobs[b & ( JOB_QUEUE_SIZE - 1 )] = job;
+	// publish the job before the new bottom
+	Sys_InterlockedExchange( bottom, (int)( (unsigned int)b + 1 ) );
+	return true;
+}
+
+/*
+================
+idJobQueue::Pop
+================
+*/
+bool idJobQueue::Pop( jobEntry_t &job ) {
+	int b = (int)( (unsigned int)bottom - 1 );
+	// the new bottom must be visible before top is read
+	Sys_InterlockedExchange( bottom, b );
+	int t = top;
+	int size = Size( t, b );
+	if ( size < 0 ) {
+		// empty
+		bottom = t;
+		return false;
+	}
+	job = jobs[b & ( JOB_QUEUE_SIZE - 1 )];
+	if ( size > 0 ) {
+		return true;
+	}
+	// the last job, race with thieves for it
+	bool won = ( Sys_InterlockedCompareExchange( top, t, (int)( (unsigned int)t + 1 ) ) == t );
+	bottom = (int)( (unsigned int)t + 1 );
+	return won;
+}
+
+/*
+================
+idJobQueue::Steal
+================
+*/
+bool idJobQueue::Steal( jobEntry_t &job, const idJobCounter *counter ) {
+	int t = top;
+	int b = bottom;
+	if ( Size( t, b ) <= 0 ) {
+		return false;
+	}
+	job = jobs[t & ( JOB_QUEUE_SIZE - 1 )];
+	if ( counter && job.counter != counter ) {
+		return false;
+	}
+	return ( Sys_InterlockedCompareExchange( top, t, (int)( (unsigned int)t + 1 ) ) == t );
+}
+
+/*
+===============================================================================
+
+	idJobSystemLocal
+
+===============================================================================
+*/
+
+typedef struct {
+	idJobQueue				queue;
+	signalHandle_t			signal;				// raised to wake the worker up
+	volatile int			sleeping;
+	volatile int			exited;
+	int						index;
+} jobWorker_t;
+
+class idJobSystemLocal : public idJobSystem {
+public:
+							idJobSystemLocal( void );
+
+	virtual void			Init( void );
+	virtual void			Shutdown( void );
+	virtual int				NumThreads( void ) const { return numWorkers + 1; }
+	virtual void			Submit( jobRun_t function, void *data, idJobCounter *counter, idJobCounter *dependency = NULL );
+	virtual void			SubmitRange( jobRangeRun_t function, void *data, int numItems, int granularity, idJobCounter *counter, idJobCounter *dependency = NULL );
+	virtual void			Wait( idJobCounter *counter );
+	virtual void			ParallelFor( jobRangeRun_t function, void *data, int numItems, int granularity = 0 );
+
+	int						NumWorkers( void ) const { return numWorkers; }
+	void					SetNumActiveWorkers( int num );
+	void					WorkerLoop( jobWorker_t *worker );
+
+	static void				TestJobs_f( const idCmdArgs &args );
+
+private:
+	bool					initialized;
+	int						numWorkers;
+	volatile int			numActiveWorkers;	// workers with a higher index don't run jobs
+	volatile int			numSleeping;
+	volatile bool			shutdown;
+
+	idJobQueue				mainQueue;
+	jobWorker_t *			workers[MAX_JOB_THREADS];
+	idJobQueue *			queues[MAX_JOB_THREADS + 1];	// main thread queue first
+	xthreadInfo				threads[MAX_JOB_THREADS];
+	char					threadNames[MAX_JOB_THREADS][16];
+
+	// jobs submitted from threads without a queue
+	idSysSpinLock			sharedLock;
+	jobEntry_t				sharedJobs[JOB_QUEUE_SIZE];
+	volatile int			sharedHead;
+	volatile int			sharedTail;
+
+	void					AddJob( const jobEntry_t &job, idJobCounter *dependency );
+	void					PushJob( const jobEntry_t &job );
+	bool					FindJob( idJobQueue *ownQueue, jobEntry_t &job, const idJobCounter *counter = NULL );
+	bool					HasJobs( void ) const;
+	void					Execute( jobEntry_t &job );
+	void					FinishJob( idJobCounter *counter );
+	void					WakeWorkers( int num );
+};
+
+idJobSystemLocal			localJobSystem;
+idJobSystem *				jobSystem = &localJobSystem;
+
+static ID_THREAD_LOCAL idJobQueue *	job_threadQueue;		// NULL for threads that don't own a queue
+static ID_THREAD_LOCAL unsigned int	job_stealIndex;
+
+/*
+================
+JobWorkerThread
+================
+*/
+static unsigned int JobWorkerThread( void *parm ) {
+	jobWorker_t *worker = (jobWorker_t *) parm;
+
+	job_threadQueue = &worker->queue;
+	job_stealIndex = worker->index;
+
+	localJobSystem.WorkerLoop( worker );
+
+	job_threadQueue = NULL;
+	worker->exited = 1;
+	return 0;
+}
+
+/*
+================
+idJobSystemLocal::idJobSystemLocal
+================
+*/
+idJobSystemLocal::idJobSystemLocal( void ) {
+	initialized = false;
+	numWorkers = 0;
+	numActiveWorkers = 0;
+	numSleeping = 0;
+	shutdown = false;
+	sharedHead = sharedTail = 0;
+	memset( workers, 0, sizeof( workers ) );
+	memset( queues, 0, sizeof( queues ) );
+	memset( threads, 0, sizeof( threads ) );
+}
+
+/*
+================
+idJobSystemLocal::Init
+================
+*/
+void idJobSystemLocal::Init( void ) {
+	int i, numCores, maxWorkers;
+
+	if ( initialized ) {
+		return;
+	}
+
+	numCores = Sys_NumCpuCores();
+	numWorkers = com_jobThreads.GetInteger();
+	if ( numWorkers < 0 ) {
+		numWorkers = numCores - 1;
+	}
+	// every worker needs a slot in the engine thread registry
+	maxWorkers = idMath::ClampInt( 0, MAX_JOB_THREADS, MAX_THREADS - g_thread_count - JOB_RESERVED_THREADS );
+	if ( numWorkers > maxWorkers ) {
+		common->Printf( "job system: clamped %d worker threads to %d\n", numWorkers, maxWorkers );
+	}
+	numWorkers = idMath::ClampInt( 0, maxWorkers, numWorkers );
+	numActiveWorkers = numWorkers;
+	numSleeping = 0;
+	shutdown = false;
+
+	job_threadQueue = &mainQueue;
+	job_stealIndex = 0;
+	queues[0] = &mainQueue;
+
+	for ( i = 0; i < numWorkers; i++ ) {
+		jobWorker_t *worker = new jobWorker_t;
+		worker->signal = Sys_SignalCreate( false );
+		worker->sleeping = 0;
+		worker->exited = 0;
+		worker->index = i;
+		workers[i] = worker;
+		queues[i + 1] = &worker->queue;
+	}
+
+	// workers steal from each other right away, so all queues have to exist first
+	for ( i = 0; i < numWorkers; i++ ) {
+		idStr::snPrintf( threadNames[i], sizeof( threadNames[i] ), "JobWorker%d", i );
+		Sys_CreateThread( (xthread_t)JobWorkerThread, workers[i], THREAD_NORMAL, threads[i], threadNames[i], g_threads, &g_thread_count );
+	}
+
+	cmdSystem->AddCommand( "testJobs", TestJobs_f, CMD_FL_SYSTEM, "measures job system overhead and scaling" );
+
+	common->Printf( "job system: %d worker threads on %d cores\n", numWorkers, numCores );
+
+	initialized = true;
+}
+
+/*
+================
+idJobSystemLocal::Shutdown
+================
+*/
+void idJobSystemLocal::Shutdown( void ) {
+	int i;
+
+	if ( !initialized ) {
+		return;
+	}
+
+	shutdown = true;
+	for ( i = 0; i < numWorkers; i++ ) {
+		Sys_SignalRaise( workers[i]->signal );
+	}
+	for ( i = 0; i < numWorkers; i++ ) {
+		// let the worker return so it isn't canceled in the middle of a wait
+		while ( !workers[i]->exited ) {
+			Sys_Yield();
+		}
+		Sys_DestroyThread( threads[i] );
+		Sys_SignalDestroy( workers[i]->signal );
+		delete workers[i];
+		workers[i] = NULL;
+		queues[i + 1] = NULL;
+	}
+	numWorkers = 0;
+	numActiveWorkers = 0;
+
+	cmdSystem->RemoveCommand( "testJobs" );
+
+	job_threadQueue = NULL;
+	initialized = false;
+}
+
+/*
+================
+idJobSystemLocal::SetNumActiveWorkers
+================
+*/
+void idJobSystemLocal::SetNumActiveWorkers( int num ) {
+	numActiveWorkers = idMath::ClampInt( 0, numWorkers, num );
+}
+
+/*
+================
+idJobSystemLocal::Execute
+================
+*/
+void idJobSystemLocal::Execute( jobEntry_t &job ) {
+	if ( job.rangeFunction ) {
+		job.rangeFunction( job.data, job.first, job.last );
+	} else {
+		job.function( job.data );
+	}
+	if ( job.counter ) {
+		FinishJob( job.counter );
+	}
+}
+
+/*
+================
+idJobSystemLocal::FinishJob
+
+  The transition to zero is made under the counter lock, so Wait can
+  sync with it before the counter goes out of scope. The counter isn't
+  touched again after the lock is released.
+================
+*/
+void idJobSystemLocal::FinishJob( idJobCounter *counter ) {
+	jobEntry_t *dependents = NULL;
+
+	while( 1 ) {
+		int count = counter->count;
+		assert( count > 0 );
+		if ( count == 1 ) {
+			counter->lock.Lock();
+			if ( Sys_InterlockedCompareExchange( counter->count, 1, 0 ) == 1 ) {
+				dependents = counter->dependents;
+				counter->dependents = NULL;
+				counter->lock.Unlock();
+				break;
+			}
+			counter->lock.Unlock();
+		} else if ( Sys_InterlockedCompareExchange( counter->count, count, count - 1 ) == count ) {
+			break;
+		}
+	}
+
+	// start the jobs that were waiting for the counter
+	while( dependents ) {
+		jobEntry_t *job = dependents;
+		dependents = job->next;
+		PushJob( *job );
+		Mem_Free( job );
+	}
+}
+
+/*
+================
+idJobSystemLocal::PushJob
+================
+*/
+void idJobSystemLocal::PushJob( const jobEntry_t &job ) {
+	if ( numWorkers == 0 ) {
+		jobEntry_t run = job;
+		Execute( run );
+		return;
+	}
+
+	idJobQueue *queue = job_threadQueue;
+	if ( !queue || !queue->Push( job ) ) {
+		sharedLock.Lock();
+		int next = ( sharedTail + 1 ) & ( JOB_QUEUE_SIZE - 1 );
+		if ( next == sharedHead ) {
+			sharedLock.Unlock();
+			// all queues are full, just run it
+			jobEntry_t run = job;
+			Execute( run );
+			return;
+		}
+		sharedJobs[sharedTail] = job;
+		sharedTail = next;
+		sharedLock.Unlock();
+	}
+
+	if ( numSleeping > 0 ) {
+		WakeWorkers( 1 );
+	}
+}
+
+/*
+================
+idJobSystemLocal::AddJob
+================
+*/
+void idJobSystemLocal::AddJob( const jobEntry_t &job, idJobCounter *dependency ) {
+	if ( dependency ) {
+		dependency->lock.Lock();
+		if ( dependency->count != 0 ) {
+			jobEntry_t *entry = (jobEntry_t *) Mem_Alloc( sizeof( jobEntry_t ) );
+			*entry = job;
+			entry->next = dependency->dependents;
+			dependency->dependents = entry;
+			dependency->lock.Unlock();
+			return;
+		}
+		dependency->lock.Unlock();
+	}
+	PushJob( job );
+}
+
+/*
+================
+idJobSystemLocal::Submit
+================
+*/
+void idJobSystemLocal::Submit( jobRun_t function, void *data, idJobCounter *counter, idJobCounter *dependency ) {
+	jobEntry_t job;
+
+	job.function = function;
+	job.rangeFunction = NULL;
+	job.data = data;
+	job.first = job.last = 0;
+	job.counter = counter;
+	job.next = NULL;
+
+	if ( counter ) {
+		Sys_InterlockedIncrement( counter->count );
+	}
+	AddJob( job, dependency );
+}
+
+/*
+================
+idJobSystemLocal::SubmitRange
+================
+*/
+void idJobSystemLocal::SubmitRange( jobRangeRun_t function, void *data, int numItems, int granularity, idJobCounter *counter, idJobCounter *dependency ) {
+	jobEntry_t job;
+	int numRanges;
+
+	if ( numItems <= 0 ) {
+		return;
+	}
+	if ( granularity <= 0 ) {
+		// a few ranges per thread to even out the load
+		granularity = Max( 1, numItems / ( NumThreads() * 4 ) );
+	}
+	numRanges = ( numItems + granularity - 1 ) / granularity;
+
+	job.function = NULL;
+	job.rangeFunction = function;
+	job.data = data;
+	job.counter = counter;
+	job.next = NULL;
+
+	if ( counter ) {
+		Sys_InterlockedAdd( counter->count, numRanges );
+	}
+	for ( int first = 0; first < numItems; first += granularity ) {
+		job.first = first;
+		job.last = Min( first + granularity, numItems );
+		AddJob( job, dependency );
+	}
+
+	if ( numRanges > 1 && numSleeping > 0 ) {
+		WakeWorkers( numRanges - 1 );
+	}
+}
+
+/*
+================
+idJobSystemLocal::HasJobs
+================
+*/
+bool idJobSystemLocal::HasJobs( void ) const {
+	if ( sharedHead != sharedTail ) {
+		return true;
+	}
+	for ( int i = 0; i <= numWorkers; i++ ) {
+		if ( !queues[i]->IsEmpty() ) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/*
+================
+idJobSystemLocal::FindJob
+
+  if a counter is given only jobs of that counter are taken from the shared
+  queue and the other threads, the own queue only holds jobs this thread pushed
+================
+*/
+bool idJobSystemLocal::FindJob( idJobQueue *ownQueue, jobEntry_t &job, const idJobCounter *counter ) {
+	int i, numQueues;
+
+	if ( ownQueue && ownQueue->Pop( job ) ) {
+		return true;
+	}
+
+	if ( sharedHead != sharedTail ) {
+		sharedLock.Lock();
+		if ( sharedHead != sharedTail && ( !counter || sharedJobs[sharedHead].counter == counter ) ) {
+			job = sharedJobs[sharedHead];
+			sharedHead = ( sharedHead + 1 ) & ( JOB_QUEUE_SIZE - 1 );
+			sharedLock.Unlock();
+			return true;
+		}
+		sharedLock.Unlock();
+	}
+
+	// steal, starting at a different queue every time
+	numQueues = numWorkers + 1;
+	for ( i = 0; i < numQueues; i++ ) {
+		idJobQueue *queue = queues[( job_stealIndex + i ) % numQueues];
+		if ( queue != ownQueue && queue->Steal( job, counter ) ) {
+			return true;
+		}
+	}
+	job_stealIndex++;
+
+	return false;
+}
+
+/*
+================
+idJobSystemLocal::WakeWorkers
+================
+*/
+void idJobSystemLocal::WakeWorkers( int num ) {
+	for ( int i = 0; i < numActiveWorkers && num > 0; i++ ) {
+		if ( workers[i]->sleeping ) {
+			Sys_SignalRaise( workers[i]->signal );
+			num--;
+		}
+	}
+}
+
+/*
+================
+idJobSystemLocal::WorkerLoop
+================
+*/
+void idJobSystemLocal::WorkerLoop( jobWorker_t *worker ) {
+	jobEntry_t job;
+	int idle = 0;
+
+	while( !shutdown ) {
+		if ( worker->index < numActiveWorkers ) {
+			if ( FindJob( &worker->queue, job ) ) {
+				Execute( job );
+				idle = 0;
+				continue;
+			}
+			if ( ++idle < JOB_SPIN_COUNT ) {
+				Sys_CpuPause();
+				continue;
+			}
+		}
+
+		// announce the sleep before the last check, a job pushed after the check sees it and raises the signal
+		Sys_InterlockedExchange( worker->sleeping, 1 );
+		Sys_InterlockedIncrement( numSleeping );
+		if ( shutdown || worker->index >= numActiveWorkers || !HasJobs() ) {
+			Sys_SignalWait( worker->signal, JOB_SLEEP_MSEC );
+		}
+		Sys_InterlockedDecrement( numSleeping );
+		Sys_InterlockedExchange( worker->sleeping, 0 );
+		idle = 0;
+	}
+}
+
+/*
+================
+idJobSystemLocal::Wait
+
+  Only runs the jobs of the own queue and the jobs of the counter, a long job
+  of another system picked up while waiting would delay the caller.
+  Threads without a queue, like the async sound thread, don't run any jobs.
+================
+*/
+void idJobSystemLocal::Wait( idJobCounter *counter ) {
+	jobEntry_t job;
+	int idle = 0;
+
+	while( counter->count > 0 ) {
+		if ( job_threadQueue && FindJob( job_threadQueue, job, counter ) ) {
+			Execute( job );
+			idle = 0;
+		} else if ( ++idle < JOB_SPIN_COUNT ) {
+			Sys_CpuPause();
+		} else {
+			Sys_Yield();
+		}
+	}
+
+	// the job that finished last may still be holding the lock
+	counter->lock.Lock();
+	counter->lock.Unlock();
+}
+
+/*
+================
+idJobSystemLocal::ParallelFor
+================
+*/
+void idJobSystemLocal::ParallelFor( jobRangeRun_t function, void *data, int numItems, int granularity ) {
+	idJobCounter counter;
+	int ownFirst;
+
+	if ( numItems <= 0 ) {
+		return;
+	}
+	if ( granularity <= 0 ) {
+		granularity = Max( 1, numItems / ( NumThreads() * 4 ) );
+	}
+	if ( numWorkers == 0 || numItems <= granularity ) {
+		function( data, 0, numItems );
+		return;
+	}
+	// the calling thread runs the last range itself instead of waiting for it to be stolen
+	ownFirst = ( ( numItems - 1 ) / granularity ) * granularity;
+	SubmitRange( function, data, ownFirst, granularity, &counter );
+	function( data, ownFirst, numItems );
+	Wait( &counter );
+}
+
+/*
+===============================================================================
+
+	testJobs
+
+===============================================================================
+*/
+
+typedef struct {
+	float *					results;
+	int						iterations;
+} jobTestWork_t;
+
+/*
+================
+JobTest_Empty
+================
+*/
+static void JobTest_Empty( void * /*data*/ ) {
+}
+
+/*
+================
+JobTest_Work
+================
+*/
+static void JobTest_Work( void *data, int first, int last ) {
+	jobTestWork_t *work = (jobTestWork_t *) data;
+	for ( int i = first; i < last; i++ ) {
+		float x = (float) i;
+		for ( int j = 0; j < work->iterations; j++ ) {
+			x = idMath::Sqrt( x * x + 1.0f );
+		}
+		work->results[i] = x;
+	}
+}
+
+/*
+================
+idJobSystemLocal::TestJobs_f
+================
+*/
+void idJobSystemLocal::TestJobs_f( const idCmdArgs &args ) {
+	const int NUM_EMPTY_JOBS = 1024;
+	const int NUM_EMPTY_BATCHES = 64;
+	const int NUM_WORK_ITEMS = 1024;
+	idJobSystemLocal &js = localJobSystem;
+	idJobCounter counter;
+	idTimer timer;
+	jobTestWork_t work;
+	float *reference;
+	double singleTime = 0.0;
+	int i, j;
+
+	if ( !js.initialized ) {
+		common->Printf( "job system not initialized\n" );
+		return;
+	}
+
+	work.iterations = ( args.Argc() > 1 ) ? Max( 1, atoi( args.Argv( 1 ) ) ) : 2000;
+	work.results = (float *) Mem_Alloc( NUM_WORK_ITEMS * sizeof( float ) );
+	reference = (float *) Mem_Alloc( NUM_WORK_ITEMS * sizeof( float ) );
+
+	common->Printf( "%d worker threads\n", js.numWorkers );
+
+	// scheduling overhead with jobs that do nothing
+	for ( int numActive = 0; ; numActive = Min( numActive ? numActive * 2 : 1, js.numWorkers ) ) {
+		js.SetNumActiveWorkers( numActive );
+		timer.Clear();
+		timer.Start();
+		for ( i = 0; i < NUM_EMPTY_BATCHES; i++ ) {
+			for ( j = 0; j < NUM_EMPTY_JOBS; j++ ) {
+				js.Submit( JobTest_Empty, NULL, &counter );
+			}
+			js.Wait( &counter );
+		}
+		timer.Stop();
+		common->Printf( "%2d threads: %6.3f usec per empty job\n", numActive + 1, timer.Milliseconds() * 1000.0 / ( NUM_EMPTY_JOBS * NUM_EMPTY_BATCHES ) );
+		if ( numActive == js.numWorkers ) {
+			break;
+		}
+	}
+
+	// scaling with jobs that do some work
+	JobTest_Work( &work, 0, NUM_WORK_ITEMS );
+	memcpy( reference, work.results, NUM_WORK_ITEMS * sizeof( float ) );
+
+	for ( int numActive = 0; ; numActive = Min( numActive ? numActive * 2 : 1, js.numWorkers ) ) {
+		js.SetNumActiveWorkers( numActive );
+		memset( work.results, 0, NUM_WORK_ITEMS * sizeof( float ) );
+		timer.Clear();
+		timer.Start();
+		js.SubmitRange( JobTest_Work, &work, NUM_WORK_ITEMS, 4, &counter );
+		js.Wait( &counter );
+		timer.Stop();
+		if ( numActive == 0 ) {
+			singleTime = timer.Milliseconds();
+		}
+		bool ok = ( memcmp( reference, work.results, NUM_WORK_ITEMS * sizeof( float ) ) == 0 );
+		common->Printf( "%2d threads: %8.2f msec  speedup %5.2f%s\n", numActive + 1, timer.Milliseconds(),
+						singleTime / Max( timer.Milliseconds(), 0.001 ), ok ? "" : "  RESULTS DIFFER" );
+		if ( numActive == js.numWorkers ) {
+			break;
+		}
+	}
+
+	js.SetNumActiveWorkers( js.numWorkers );
+
+	Mem_Free( work.results );
+	Mem_Free( reference );
+}
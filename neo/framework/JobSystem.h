@@ -0,0 +1,104 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company. 
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).  
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#ifndef __JOBSYSTEM_H__
+#define __JOBSYSTEM_H__
+
+/*
+===============================================================================
+
+	Job system
+
+	Jobs are small functions run in parallel on a pool of worker threads.
+	Every worker and the main thread own a deque of jobs, idle workers
+	steal from the other deques, so submitting and running jobs doesn't
+	go through a shared lock. Jobs submitted from any other thread go
+	through a locked queue.
+
+	Completion is tracked with an idJobCounter. Submitting a job increments
+	the counter and the job decrements it when it has run. A job can depend
+	on a counter, it isn't started before that counter reaches zero.
+
+	Wait() runs the jobs of its own queue and of the counter until the
+	counter reaches zero, so it can be called from inside a job without
+	picking up a long job of another system. Jobs must not block on
+	anything else. Threads without a queue, like the async sound mixer,
+	only wait.
+
+===============================================================================
+*/
+
+typedef void (*jobRun_t)( void *data );
+typedef void (*jobRangeRun_t)( void *data, int first, int last );	// runs items [first, last)
+
+class idJobCounter {
+public:
+					idJobCounter( void ) : count( 0 ), dependents( NULL ) {}
+					~idJobCounter( void ) { assert( count == 0 ); }
+
+	bool			IsDone( void ) const { return count == 0; }
+	int				Count( void ) const { return count; }
+
+private:
+	friend class idJobSystemLocal;
+
+	volatile int	count;
+	idSysSpinLock	lock;					// protects dependents and the transition to zero
+	struct jobEntry_s *	dependents;			// jobs waiting for the count to reach zero
+
+					idJobCounter( const idJobCounter & );
+	void			operator=( const idJobCounter & );
+};
+
+class idJobSystem {
+public:
+	virtual					~idJobSystem( void ) {}
+
+	virtual void			Init( void ) = 0;
+	virtual void			Shutdown( void ) = 0;
+
+	// number of threads that can run jobs, including the main thread
+	virtual int				NumThreads( void ) const = 0;
+
+	// if a dependency is given the job isn't started before it reaches zero
+	virtual void			Submit( jobRun_t function, void *data, idJobCounter *counter, idJobCounter *dependency = NULL ) = 0;
+
+	// splits the items in ranges of at most granularity items, 0 picks a granularity for the number of threads
+	virtual void			SubmitRange( jobRangeRun_t function, void *data, int numItems, int granularity, idJobCounter *counter, idJobCounter *dependency = NULL ) = 0;
+
+	// runs the own jobs and the jobs of the counter until it reaches zero
+	virtual void			Wait( idJobCounter *counter ) = 0;
+
+	// SubmitRange and Wait, the calling thread runs the last range itself
+	// runs in the calling thread if there are no workers or a single range
+	virtual void			ParallelFor( jobRangeRun_t function, void *data, int numItems, int granularity = 0 ) = 0;
+};
+
+extern idJobSystem *		jobSystem;
+
+#endif /* !__JOBSYSTEM_H__ */
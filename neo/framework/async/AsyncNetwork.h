@@ -174,6 +174,7 @@ public:
 	static idCVar			serverMaxClientRate;			// maximum outgoing rate to clients
 	static idCVar			clientMaxRate;					// maximum rate from server requested by client
 	static idCVar			serverMaxUsercmdRelay;			// maximum number of usercmds relayed to other clients
+	static idCVar			serverParallelSnapshots;		// write the snapshots of the clients with the job system
 	static idCVar			serverZombieTimeout;			// time out in seconds for zombie clients
 	static idCVar			serverClientTimeout;			// time out in seconds for connected clients
 	static idCVar			clientServerTimeout;			// time out in seconds for server
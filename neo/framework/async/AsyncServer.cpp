@@ -84,6 +84,7 @@ idAsyncServer::idAsyncServer( void ) {
 	for ( i = 0; i < MAX_ASYNC_CLIENTS; i++ ) {
 		ClearClient( i );
 	}
+	numSnapshots = 0;
 	serverReloadingEngine = false;
 	nextHeartbeatTime = 0;
 	nextAsyncStatsTime = 0;
@@ -1144,16 +1145,12 @@ void idAsyncServer::SendGameInitToClient( int clientNum ) {
 
 /*
 ==================
-idAsyncServer::SendSnapshotToClient
+idAsyncServer::BeginSnapshotToClient
+
+  Writes the snapshot header, the game snapshot is written by WriteSnapshots.
 ==================
 */
-bool idAsyncServer::SendSnapshotToClient( int clientNum ) {
-	int			i, j, index, numUsercmds;
-	idBitMsg	msg;
-	byte		msgBuf[MAX_MESSAGE_SIZE];
-	usercmd_t *	last;
-	byte		clientInPVS[MAX_ASYNC_CLIENTS >> 3];
-
+bool idAsyncServer::BeginSnapshotToClient( int clientNum ) {
 	serverClient_t &client = clients[clientNum];
 
 	if ( serverTime - client.lastSnapshotTime < idAsyncNetwork::serverSnapshotDelay.GetInteger() ) {
@@ -1167,8 +1164,12 @@ bool idAsyncServer::SendSnapshotToClient( int clientNum ) {
 	// how far is the client ahead of the server minus the packet delay
 	client.clientAheadTime = client.gameTime - ( gameTime + gameTimeResidual );
 
+	serverSnapshot_t &snapshot = snapshots[numSnapshots++];
+	snapshot.clientNum = clientNum;
+
 	// write the snapshot
-	msg.Init( msgBuf, sizeof( msgBuf ) );
+	idBitMsg &msg = snapshot.msg;
+	msg.Init( snapshot.msgBuf, sizeof( snapshot.msgBuf ) );
 	msg.WriteLong( gameInitId );
 	msg.WriteByte( SERVER_UNRELIABLE_MESSAGE_SNAPSHOT );
 	msg.WriteLong( client.snapshotSequence );
@@ -1177,8 +1178,65 @@ bool idAsyncServer::SendSnapshotToClient( int clientNum ) {
 	msg.WriteByte( idMath::ClampChar( client.numDuplicatedUsercmds ) );
 	msg.WriteShort( idMath::ClampShort( client.clientAheadTime ) );
 
-	// write the game snapshot
-	game->ServerWriteSnapshot( clientNum, client.snapshotSequence, msg, clientInPVS, MAX_ASYNC_CLIENTS );
+	return true;
+}
+
+/*
+==================
+idAsyncServer::WriteSnapshotsJob
+==================
+*/
+void idAsyncServer::WriteSnapshotsJob( void *data, int first, int last ) {
+	idAsyncServer *server = (idAsyncServer *)data;
+
+	for ( int i = first; i < last; i++ ) {
+		serverSnapshot_t &snapshot = server->snapshots[i];
+		game->ServerWriteSnapshot( snapshot.clientNum, server->clients[snapshot.clientNum].snapshotSequence, snapshot.msg, snapshot.clientInPVS, MAX_ASYNC_CLIENTS );
+	}
+}
+
+/*
+==================
+idAsyncServer::WriteSnapshots
+
+  Writes the game snapshots begun this frame and sends them to the clients.
+  The snapshots of different clients are written in parallel.
+==================
+*/
+void idAsyncServer::WriteSnapshots( void ) {
+	int i;
+
+	if ( !numSnapshots ) {
+		return;
+	}
+
+	game->ServerPrepareSnapshots();
+
+	if ( idAsyncNetwork::serverParallelSnapshots.GetBool() ) {
+		jobSystem->ParallelFor( WriteSnapshotsJob, this, numSnapshots, 1 );
+	} else {
+		WriteSnapshotsJob( this, 0, numSnapshots );
+	}
+
+	for ( i = 0; i < numSnapshots; i++ ) {
+		SendSnapshotToClient( snapshots[i] );
+	}
+	numSnapshots = 0;
+}
+
+/*
+==================
+idAsyncServer::SendSnapshotToClient
+==================
+*/
+void idAsyncServer::SendSnapshotToClient( serverSnapshot_t &snapshot ) {
+	int			i, j, index, numUsercmds;
+	usercmd_t *	last;
+	int			clientNum = snapshot.clientNum;
+	idBitMsg &	msg = snapshot.msg;
+	byte *		clientInPVS = snapshot.clientInPVS;
+
+	serverClient_t &client = clients[clientNum];
 
 	// write the latest user commands from the other clients in the PVS to the snapshot
 	for ( last = NULL, i = 0; i < MAX_ASYNC_CLIENTS; i++ ) {
@@ -1212,8 +1270,6 @@ bool idAsyncServer::SendSnapshotToClient( int clientNum ) {
 	client.lastSnapshotTime = serverTime;
 	client.snapshotSequence++;
 	client.numDuplicatedUsercmds = 0;
-
-	return true;
 }
 
 /*
@@ -2501,7 +2557,7 @@ void idAsyncServer::RunFrame( void ) {
 		}
 
 		if ( client.clientState == SCS_INGAME ) {
-			if ( !SendSnapshotToClient( i ) ) {
+			if ( !BeginSnapshotToClient( i ) ) {
 				SendPingToClient( i );
 			}
 		} else {
@@ -2509,6 +2565,9 @@ void idAsyncServer::RunFrame( void ) {
 		}
 	}
 
+	// write and send the snapshots begun above
+	WriteSnapshots();
+
 	if ( com_showAsyncStats.GetBool() ) {
 
 		UpdateAsyncStatsAvg();
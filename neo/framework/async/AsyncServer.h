@@ -127,6 +127,14 @@ typedef struct serverClient_s {
 
 } serverClient_t;
 
+// snapshot message of a client, the game writes the snapshots of all clients in parallel
+typedef struct serverSnapshot_s {
+	int					clientNum;
+	idBitMsg			msg;
+	byte				msgBuf[MAX_MESSAGE_SIZE];
+	byte				clientInPVS[MAX_ASYNC_CLIENTS >> 3];
+} serverSnapshot_t;
+
 
 class idAsyncServer {
 public:
@@ -190,6 +198,8 @@ private:
 	challenge_t			challenges[MAX_CHALLENGES];	// to prevent invalid IPs from connecting
 	serverClient_t		clients[MAX_ASYNC_CLIENTS];	// clients
 	usercmd_t			userCmds[MAX_USERCMD_BACKUP][MAX_ASYNC_CLIENTS];
+	serverSnapshot_t	snapshots[MAX_ASYNC_CLIENTS];	// snapshots written this frame
+	int					numSnapshots;
 
 	int					gameInitId;					// game initialization identification
 	int					gameFrame;					// local game frame
@@ -234,7 +244,10 @@ private:
 	bool				SendEmptyToClient( int clientNum, bool force = false );
 	bool				SendPingToClient( int clientNum );
 	void				SendGameInitToClient( int clientNum );
-	bool				SendSnapshotToClient( int clientNum );
+	bool				BeginSnapshotToClient( int clientNum );
+	void				WriteSnapshots( void );
+	void				SendSnapshotToClient( serverSnapshot_t &snapshot );
+	static void			WriteSnapshotsJob( void *data, int first, int last );
 	void				ProcessUnreliableClientMessage( int clientNum, const idBitMsg &msg );
 	void				ProcessReliableClientMessages( int clientNum );
 	void				ProcessChallengeMessage( const netadr_t from, const idBitMsg &msg );
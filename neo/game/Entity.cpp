@@ -940,10 +940,14 @@ void idEntity::BecomeActive( int flags ) {
 	thinkFlags |= flags;
 	if ( thinkFlags ) {
 		if ( !IsActive() ) {
-			activeNode.AddToEnd( gameLocal.activeEntities );
+			if ( !gameLocal.DeferThinkCommand( THINKCMD_ACTIVATE, this ) ) {
+				activeNode.AddToEnd( gameLocal.activeEntities );
+			}
 		} else if ( !oldFlags ) {
 			// we became inactive this frame, so we have to decrease the count of entities to deactivate
-			gameLocal.numEntitiesToDeactivate--;
+			if ( !gameLocal.DeferThinkCommand( THINKCMD_REACTIVATE, this ) ) {
+				gameLocal.numEntitiesToDeactivate--;
+			}
 		}
 	}
 }
@@ -969,7 +973,9 @@ void idEntity::BecomeInactive( int flags ) {
 	if ( thinkFlags ) {
 		thinkFlags &= ~flags;
 		if ( !thinkFlags && IsActive() ) {
-			gameLocal.numEntitiesToDeactivate++;
+			if ( !gameLocal.DeferThinkCommand( THINKCMD_DEACTIVATE, this ) ) {
+				gameLocal.numEntitiesToDeactivate++;
+			}
 		}
 	}
 
@@ -1386,6 +1392,11 @@ void idEntity::Present( void ) {
 		return;
 	}
 
+	// the render world is updated from the game thread
+	if ( gameLocal.DeferThinkCommand( THINKCMD_PRESENT, this ) ) {
+		return;
+	}
+
 	// don't present to the renderer if the entity hasn't changed
 	if ( !( thinkFlags & TH_UPDATEVISUALS ) ) {
 		return;
@@ -1655,6 +1666,10 @@ idEntity::UpdateSound
 ================
 */
 void idEntity::UpdateSound( void ) {
+	if ( gameLocal.DeferThinkCommand( THINKCMD_UPDATESOUND, this ) ) {
+		return;
+	}
+
 	if ( refSound.referenceSound ) {
 		idVec3 origin;
 		idMat3 axis;
@@ -2544,7 +2559,10 @@ bool idEntity::RunPhysics( void ) {
 	startTime = gameLocal.previousTime;
 	endTime = gameLocal.time;
 
-	gameLocal.push.InitSavingPushedEntityPositions();
+	// entities that think in parallel never push so they leave the shared push state alone
+	if ( !threadThinkIsland ) {
+		gameLocal.push.InitSavingPushedEntityPositions();
+	}
 	blockedPart = NULL;
 
 	// save the physics state of the whole team and disable the team for collision detection
@@ -2631,7 +2649,7 @@ bool idEntity::RunPhysics( void ) {
 	}
 
 	// set pushed
-	for ( i = 0; i < gameLocal.push.GetNumPushedEntities(); i++ ) {
+	for ( i = 0; !threadThinkIsland && i < gameLocal.push.GetNumPushedEntities(); i++ ) {
 		idEntity *ent = gameLocal.push.GetPushedEntity( i );
 		ent->physics->SetPushed( endTime - startTime );
 	}
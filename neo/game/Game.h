@@ -154,6 +154,10 @@ public:
 	// Writes initial reliable messages a client needs to recieve when first joining the game.
 	virtual void				ServerWriteInitialReliableMessages( int clientNum ) = 0;
 
+	// Prepares the game state for writing the snapshots of a server frame.
+	// The ServerWriteSnapshot calls that follow may run in parallel for different clients.
+	virtual void				ServerPrepareSnapshots( void ) = 0;
+
 	// Writes a snapshot of the server game state for the given client.
 	virtual void				ServerWriteSnapshot( int clientNum, int sequence, idBitMsg &msg, byte *clientInPVS, int numPVSClients ) = 0;
 
@@ -318,7 +322,7 @@ extern idGameEdit *				gameEdit;
 ===============================================================================
 */
 
-const int GAME_API_VERSION		= 8;
+const int GAME_API_VERSION		= 10;
 
 typedef struct {
 
@@ -336,6 +340,7 @@ typedef struct {
 	idDeclManager *				declManager;			// declaration manager
 	idAASFileManager *			AASFileManager;			// AAS file manager
 	idCollisionModelManager *	collisionModelManager;	// collision model manager
+	idJobSystem *				jobSystem;				// job worker threads
 
 } gameImport_t;
 
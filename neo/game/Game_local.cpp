@@ -46,6 +46,7 @@ idUserInterfaceManager *	uiManager = NULL;
 idDeclManager *				declManager = NULL;
 idAASFileManager *			AASFileManager = NULL;
 idCollisionModelManager *	collisionModelManager = NULL;
+idJobSystem *				jobSystem = NULL;
 idCVar *					idCVar::staticVars = NULL;
 
 idCVar com_forceGenericSIMD( "com_forceGenericSIMD", "0", CVAR_BOOL|CVAR_SYSTEM, "force generic platform independent SIMD" );
@@ -64,6 +65,8 @@ idAnimManager				animationLib;
 idGameLocal					gameLocal;
 idGame *					game = &gameLocal;	// statically pointed at an idGameLocal
 
+ID_THREAD_LOCAL thinkIsland_t *	threadThinkIsland = NULL;
+
 const char *idGameLocal::sufaceTypeNames[ MAX_SURFACE_TYPES ] = {
 	"none",	"metal", "stone", "flesh", "wood", "cardboard", "liquid", "glass", "plastic",
 	"ricochet", "surftype10", "surftype11", "surftype12", "surftype13", "surftype14", "surftype15"
@@ -101,6 +104,7 @@ extern "C" gameExport_t *GetGameAPI( gameImport_t *import ) {
 		declManager					= import->declManager;
 		AASFileManager				= import->AASFileManager;
 		collisionModelManager		= import->collisionModelManager;
+		jobSystem					= import->jobSystem;
 	}
 
 	// set interface pointers used by idLib
@@ -142,6 +146,7 @@ void TestGameAPI( void ) {
 	testImport.declManager				= ::declManager;
 	testImport.AASFileManager			= ::AASFileManager;
 	testImport.collisionModelManager	= ::collisionModelManager;
+	testImport.jobSystem				= ::jobSystem;
 
 	testExport = *GetGameAPI( &testImport );
 }
@@ -179,6 +184,18 @@ void idGameLocal::Clear( void ) {
 	numEntitiesToDeactivate = 0;
 	sortPushers = false;
 	sortTeamMasters = false;
+	thinkCandidates.Clear();
+	thinkCandidateBounds.Clear();
+	thinkIslands.DeleteContents( true );
+	numThinkIslands = 0;
+	thinkParallelMsec = 0.0f;
+	thinkCommandsMsec = 0.0f;
+	thinkSlowestIslandMsec = 0.0f;
+	thinkNumParallel = 0;
+	thinkNumSerial = 0;
+	numBodiesRested = 0;
+	numBodiesWoken = 0;
+	numBodiesIslandSlept = 0;
 	persistentLevelInfo.Clear();
 	memset( globalShaderParms, 0, sizeof( globalShaderParms ) );
 	random.SetSeed( 0 );
@@ -210,6 +227,8 @@ void idGameLocal::Clear( void ) {
 	aasNames.Clear();
 	lastAIAlertEntity = NULL;
 	lastAIAlertTime = 0;
+	aiPathFrame = -1;
+	numAIPaths = 0;
 	spawnArgs.Clear();
 	gravity.Set( 0, 0, -1 );
 	playerPVS.h = (unsigned int)-1;
@@ -743,6 +762,9 @@ const idDict* idGameLocal::SetUserInfo( int clientNum, const idDict &userInfo, b
 
 	this->isClient = isClient;
 
+	// the player entity state can depend on the user info
+	InvalidateSnapshotEncodes();
+
 	if ( clientNum >= 0 && clientNum < MAX_CLIENTS ) {
 		idGameLocal::userInfo[ clientNum ] = userInfo;
 
@@ -1450,6 +1472,9 @@ void idGameLocal::MapClear( bool clearClients ) {
 
 	delete[] locationEntities;
 	locationEntities = NULL;
+
+	aiPathFrame = -1;
+	numAIPaths = 0;
 }
 
 /*
@@ -1488,6 +1513,11 @@ void idGameLocal::MapShutdown( void ) {
 	clip.Shutdown();
 	idClipModel::ClearTraceModelCache();
 
+	thinkCandidates.Clear();
+	thinkCandidateBounds.Clear();
+	thinkIslands.DeleteContents( true );
+	numThinkIslands = 0;
+
 	ShutdownAsyncNetwork();
 
 	mapFileName.Clear();
@@ -2149,6 +2179,480 @@ void idGameLocal::SortActiveEntityList( void ) {
 	sortPushers = false;
 }
 
+#define THINKISLAND_CANDIDATE		BIT(0)		// the entity can think in parallel
+#define THINKISLAND_SERIAL			BIT(1)		// set on the root, the island touches entities that think on the game thread
+#define THINKISLAND_WALKED			BIT(2)		// the entity was on the active entity list when it was walked this frame
+#define THINKISLAND_MARGIN			16.0f		// extra space around the bounds an entity may move through this frame
+
+/*
+================
+ThinksInIsolation
+
+  entities of these classes only change their own state and the state of the
+  entities they touch when they think, derived classes are left out because
+  they may do anything
+================
+*/
+static bool ThinksInIsolation( idEntity *ent ) {
+	const idTypeInfo *type = ent->GetType();
+
+	// team masters think in list order so they still think before their slaves
+	if ( ent->GetTeamMaster() == ent && ent->GetNextTeamEntity() != NULL ) {
+		return false;
+	}
+
+	if ( type == &idMoveable::Type || type == &idItem::Type || type == &idLight::Type ) {
+		return true;
+	}
+	// emitters run guis when they have one
+	if ( type == &idFuncEmitter::Type ) {
+		return ( ent->GetRenderEntity()->gui[0] == NULL );
+	}
+	return false;
+}
+
+/*
+================
+idGameLocal::DeferThinkCommand
+================
+*/
+bool idGameLocal::DeferThinkCommand( thinkCommandType_t type, idEntity *ent ) {
+	thinkIsland_t *island = threadThinkIsland;
+
+	if ( !island ) {
+		return false;
+	}
+
+	thinkCommand_t &cmd = island->commands.Alloc();
+	cmd.type = type;
+	cmd.entity = ent;
+	cmd.call = NULL;
+	cmd.event = NULL;
+	cmd.eventObject = NULL;
+	cmd.eventType = NULL;
+	cmd.eventTime = 0;
+	cmd.collision = -1;
+	return true;
+}
+
+/*
+================
+idGameLocal::DeferThinkCall
+================
+*/
+bool idGameLocal::DeferThinkCall( idEntity *ent, thinkCall_t call ) {
+	if ( !DeferThinkCommand( THINKCMD_CALL, ent ) ) {
+		return false;
+	}
+	threadThinkIsland->commands[threadThinkIsland->commands.Num() - 1].call = call;
+	return true;
+}
+
+/*
+================
+idGameLocal::DeferThinkEvent
+================
+*/
+bool idGameLocal::DeferThinkEvent( idEvent *event, idClass *object, const idTypeInfo *type, int time ) {
+	if ( !DeferThinkCommand( THINKCMD_EVENT, NULL ) ) {
+		return false;
+	}
+	thinkCommand_t &cmd = threadThinkIsland->commands[threadThinkIsland->commands.Num() - 1];
+	cmd.event = event;
+	cmd.eventObject = object;
+	cmd.eventType = type;
+	cmd.eventTime = time;
+	return true;
+}
+
+/*
+================
+idGameLocal::DeferThinkCollide
+================
+*/
+bool idGameLocal::DeferThinkCollide( idEntity *ent, const trace_t &collision, const idVec3 &velocity ) {
+	thinkIsland_t *island = threadThinkIsland;
+
+	if ( !DeferThinkCommand( THINKCMD_COLLIDE, ent ) ) {
+		return false;
+	}
+	thinkCollision_t &c = island->collisions.Alloc();
+	c.collision = collision;
+	c.velocity = velocity;
+	island->commands[island->commands.Num() - 1].collision = island->collisions.Num() - 1;
+	return true;
+}
+
+/*
+================
+idGameLocal::ThinkIslandRoot
+================
+*/
+int idGameLocal::ThinkIslandRoot( int entityNum ) {
+	int root;
+
+	root = entityNum;
+	while( thinkIslandParent[root] != root ) {
+		root = thinkIslandParent[root];
+	}
+	// path compression
+	while( thinkIslandParent[entityNum] != root ) {
+		int next = thinkIslandParent[entityNum];
+		thinkIslandParent[entityNum] = root;
+		entityNum = next;
+	}
+	return root;
+}
+
+/*
+================
+idGameLocal::LinkThinkIsland
+
+  puts the entities in the same island, the island thinks on the game thread
+  when the other entity is a pusher or thinks but not in parallel
+================
+*/
+void idGameLocal::LinkThinkIsland( idEntity *ent, idEntity *other ) {
+	int root, otherRoot;
+	idPhysics *physics;
+
+	if ( other == ent || other->entityNumber == ENTITYNUM_WORLD ) {
+		return;
+	}
+
+	root = ThinkIslandRoot( ent->entityNumber );
+	physics = other->GetPhysics();
+
+	if ( physics->IsType( idPhysics_Parametric::Type ) || physics->IsType( idPhysics_Actor::Type ) ||
+			( other->IsActive() && !( thinkIslandFlags[other->entityNumber] & THINKISLAND_CANDIDATE ) ) ) {
+		thinkIslandFlags[root] |= THINKISLAND_SERIAL;
+		return;
+	}
+
+	// static entities can't be woken up so they never join two islands
+	if ( !other->IsActive() && ( physics->IsType( idPhysics_Static::Type ) || physics->IsType( idPhysics_StaticMulti::Type ) ) ) {
+		return;
+	}
+
+	otherRoot = ThinkIslandRoot( other->entityNumber );
+	if ( otherRoot != root ) {
+		thinkIslandParent[otherRoot] = root;
+		thinkIslandFlags[root] |= thinkIslandFlags[otherRoot] & THINKISLAND_SERIAL;
+		LinkSleepRing( ent, other );
+	}
+}
+
+/*
+================
+idGameLocal::LinkSleepRing
+
+  waking up a sleeping rigid body wakes up all the bodies that went to sleep with it,
+  so they all have to be in the island of the entity that may wake them up
+================
+*/
+void idGameLocal::LinkSleepRing( idEntity *ent, idEntity *sleeper ) {
+	idEntity *ring[MAX_GENTITIES];
+	int i, num, root, otherRoot;
+
+	if ( !sleeper->GetPhysics()->IsType( idPhysics_RigidBody::Type ) ) {
+		return;
+	}
+
+	num = static_cast<idPhysics_RigidBody *>( sleeper->GetPhysics() )->GetSleepRing( ring, MAX_GENTITIES );
+	for ( i = 0; i < num; i++ ) {
+		root = ThinkIslandRoot( ent->entityNumber );
+		otherRoot = ThinkIslandRoot( ring[i]->entityNumber );
+		if ( otherRoot != root ) {
+			thinkIslandParent[otherRoot] = root;
+			thinkIslandFlags[root] |= thinkIslandFlags[otherRoot] & THINKISLAND_SERIAL;
+		}
+	}
+}
+
+/*
+================
+idGameLocal::ThinkIslandsJob
+================
+*/
+void idGameLocal::ThinkIslandsJob( void *data, int first, int last ) {
+	idGameLocal *game = static_cast<idGameLocal *>( data );
+	idTimer timer;
+
+	for ( int i = first; i < last; i++ ) {
+		thinkIsland_t *island = game->thinkIslands[i];
+
+		timer.Clear();
+		timer.Start();
+		threadThinkIsland = island;
+		for ( int j = 0; j < island->entities.Num(); j++ ) {
+			island->entities[j]->Think();
+		}
+		threadThinkIsland = NULL;
+		timer.Stop();
+		island->msec = timer.Milliseconds();
+	}
+}
+
+/*
+================
+idGameLocal::RunThinkCommands
+
+  runs the side effects of an island in three passes so collisions and
+  presents see the active entity list and events as they were after the think
+================
+*/
+void idGameLocal::RunThinkCommands( thinkIsland_t *island ) {
+	int i;
+	idEntity *ent;
+
+	for ( i = 0; i < island->commands.Num(); i++ ) {
+		thinkCommand_t &cmd = island->commands[i];
+		switch( cmd.type ) {
+			case THINKCMD_ACTIVATE: {
+				ent = cmd.entity.GetEntity();
+				if ( ent && ent->thinkFlags && !ent->IsActive() ) {
+					ent->activeNode.AddToEnd( activeEntities );
+				}
+				break;
+			}
+			case THINKCMD_REACTIVATE: {
+				numEntitiesToDeactivate--;
+				break;
+			}
+			case THINKCMD_DEACTIVATE: {
+				numEntitiesToDeactivate++;
+				break;
+			}
+			case THINKCMD_EVENT: {
+				cmd.event->Schedule( cmd.eventObject, cmd.eventType, cmd.eventTime );
+				break;
+			}
+			default: {
+				break;
+			}
+		}
+	}
+
+	for ( i = 0; i < island->commands.Num(); i++ ) {
+		thinkCommand_t &cmd = island->commands[i];
+		if ( cmd.type == THINKCMD_COLLIDE ) {
+			ent = cmd.entity.GetEntity();
+			if ( ent ) {
+				const thinkCollision_t &c = island->collisions[cmd.collision];
+				ent->Collide( c.collision, c.velocity );
+			}
+		}
+	}
+
+	for ( i = 0; i < island->commands.Num(); i++ ) {
+		thinkCommand_t &cmd = island->commands[i];
+		ent = cmd.entity.GetEntity();
+		if ( !ent ) {
+			continue;
+		}
+		switch( cmd.type ) {
+			case THINKCMD_PRESENT: {
+				ent->Present();
+				break;
+			}
+			case THINKCMD_UPDATESOUND: {
+				ent->UpdateSound();
+				break;
+			}
+			case THINKCMD_CALL: {
+				cmd.call( ent );
+				break;
+			}
+			default: {
+				break;
+			}
+		}
+	}
+}
+
+/*
+================
+idGameLocal::ParallelThink
+
+  entities that can't think in parallel think in order of the active entity list,
+  the others are partitioned into islands of entities that may touch each other
+  this frame, islands touching other thinking entities or pushers think on the
+  game thread and the rest think in jobs, returns the number of entities thought
+
+  the islands are built after the other entities thought because their thinking
+  changes what the candidates touch and how fast they move, so the candidates of
+  islands that think on the game thread think after all the other entities instead
+  of in list order. The active list order only matters for pushers and team masters,
+  which are not candidates and still think before the candidates they touch.
+================
+*/
+int idGameLocal::ParallelThink( void ) {
+	int i, j, num, numTouch, root;
+	float move;
+	idEntity *ent, *part;
+	idPhysics *physics;
+	idBounds bounds;
+	idEntity *touch[MAX_GENTITIES];
+	thinkIsland_t *island;
+	idTimer timer;
+
+	for ( i = 0; i < num_entities; i++ ) {
+		thinkIslandParent[i] = i;
+		thinkIslandFlags[i] = 0;
+		thinkIslandNum[i] = -1;
+	}
+
+	// think the entities that can't think in parallel and collect the others
+	num = 0;
+	thinkCandidates.SetNum( 0, false );
+	for( ent = activeEntities.Next(); ent != NULL; ent = ent->activeNode.Next() ) {
+		thinkIslandFlags[ent->entityNumber] |= THINKISLAND_WALKED;
+		if ( ThinksInIsolation( ent ) ) {
+			thinkCandidates.Alloc() = ent;
+			thinkIslandFlags[ent->entityNumber] |= THINKISLAND_CANDIDATE;
+			continue;
+		}
+		ent->Think();
+		num++;
+	}
+
+	// link each candidate with the entities it may touch this frame
+	thinkCandidateBounds.SetNum( thinkCandidates.Num(), false );
+	for ( i = 0; i < thinkCandidates.Num(); i++ ) {
+		thinkCandidateBounds[i].Clear();
+		ent = thinkCandidates[i].GetEntity();
+		if ( !ent ) {
+			continue;
+		}
+
+		LinkSleepRing( ent, ent );
+
+		if ( ent->GetTeamMaster() ) {
+			for ( part = ent->GetTeamMaster(); part != NULL; part = part->GetNextTeamEntity() ) {
+				LinkThinkIsland( ent, part );
+			}
+		}
+
+		physics = ent->GetPhysics();
+		for ( j = 0; j < physics->GetNumContacts(); j++ ) {
+			part = entities[ physics->GetContact( j ).entityNum ];
+			if ( part ) {
+				LinkThinkIsland( ent, part );
+			}
+		}
+
+		bounds = physics->GetAbsBounds();
+		if ( bounds.IsCleared() ) {
+			continue;
+		}
+		move = physics->GetLinearVelocity().Length() * msec * 0.001f + THINKISLAND_MARGIN;
+		if ( physics->GetAngularVelocity() != vec3_origin ) {
+			move += ( bounds[1] - bounds[0] ).Length();
+		}
+		bounds.ExpandSelf( move );
+		thinkCandidateBounds[i] = bounds;
+
+		numTouch = clip.EntitiesTouchingBounds( bounds, -1, touch, MAX_GENTITIES );
+		for ( j = 0; j < numTouch; j++ ) {
+			LinkThinkIsland( ent, touch[j] );
+		}
+	}
+
+	// two candidates moving towards each other may meet this frame without either one
+	// touching the other now, so candidates whose swept bounds overlap are linked too
+	for ( i = 0; i < thinkCandidates.Num(); i++ ) {
+		ent = thinkCandidates[i].GetEntity();
+		if ( !ent || thinkCandidateBounds[i].IsCleared() ) {
+			continue;
+		}
+		for ( j = i + 1; j < thinkCandidates.Num(); j++ ) {
+			part = thinkCandidates[j].GetEntity();
+			if ( !part || !thinkCandidateBounds[i].IntersectsBounds( thinkCandidateBounds[j] ) ) {
+				continue;
+			}
+			if ( ThinkIslandRoot( ent->entityNumber ) != ThinkIslandRoot( part->entityNumber ) ) {
+				LinkThinkIsland( ent, part );
+			}
+		}
+	}
+
+	// islands touching other thinking entities think on the game thread in order
+	thinkNumSerial = 0;
+	for ( i = 0; i < thinkCandidates.Num(); i++ ) {
+		ent = thinkCandidates[i].GetEntity();
+		if ( !ent ) {
+			continue;
+		}
+		root = ThinkIslandRoot( ent->entityNumber );
+		if ( thinkIslandFlags[root] & THINKISLAND_SERIAL ) {
+			if ( thinkIslandNum[root] == -1 ) {
+				thinkIslandNum[root] = -2;
+				thinkNumSerial++;
+			}
+			ent->Think();
+			num++;
+		}
+	}
+
+	// gather the islands that think in parallel
+	numThinkIslands = 0;
+	for ( i = 0; i < thinkCandidates.Num(); i++ ) {
+		ent = thinkCandidates[i].GetEntity();
+		if ( !ent ) {
+			continue;
+		}
+		root = ThinkIslandRoot( ent->entityNumber );
+		if ( thinkIslandFlags[root] & THINKISLAND_SERIAL ) {
+			continue;
+		}
+		if ( thinkIslandNum[root] == -1 ) {
+			if ( numThinkIslands >= thinkIslands.Num() ) {
+				thinkIslands.Append( new thinkIsland_t );
+			}
+			island = thinkIslands[numThinkIslands];
+			island->entities.SetNum( 0, false );
+			island->commands.SetNum( 0, false );
+			island->collisions.SetNum( 0, false );
+			island->msec = 0.0;
+			thinkIslandNum[root] = numThinkIslands++;
+		}
+		thinkIslands[thinkIslandNum[root]]->entities.Append( ent );
+		num++;
+	}
+	thinkNumParallel = numThinkIslands;
+
+	timer.Clear();
+	timer.Start();
+	jobSystem->ParallelFor( ThinkIslandsJob, this, numThinkIslands, 1 );
+	timer.Stop();
+	thinkParallelMsec = timer.Milliseconds();
+
+	// run the side effects in island order
+	thinkSlowestIslandMsec = 0.0f;
+	timer.Clear();
+	timer.Start();
+	for ( i = 0; i < numThinkIslands; i++ ) {
+		island = thinkIslands[i];
+		RunThinkCommands( island );
+		thinkSlowestIslandMsec = Max( thinkSlowestIslandMsec, (float)island->msec );
+	}
+	timer.Stop();
+	thinkCommandsMsec = timer.Milliseconds();
+
+	// entities activated after the walk over the active entity list still think this frame,
+	// they are found by flag because the walked entities may have been removed in the meantime
+	for( ent = activeEntities.Next(); ent != NULL; ent = ent->activeNode.Next() ) {
+		if ( thinkIslandFlags[ent->entityNumber] & THINKISLAND_WALKED ) {
+			continue;
+		}
+		thinkIslandFlags[ent->entityNumber] |= THINKISLAND_WALKED;
+		ent->Think();
+		num++;
+	}
+
+	return num;
+}
+
 /*
 ================
 idGameLocal::RunFrame
@@ -2159,6 +2663,7 @@ gameReturn_t idGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 	int			num;
 	float		ms;
 	idTimer		timer_think, timer_events, timer_singlethink;
+	bool		parallelThink = false;
 	gameReturn_t ret;
 	idPlayer	*player;
 	const renderView_t *view;
@@ -2188,6 +2693,13 @@ gameReturn_t idGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 		time += msec;
 		realClientTime = time;
 
+		// entity states encoded for the previous snapshots are out of date
+		InvalidateSnapshotEncodes();
+
+		numBodiesRested = 0;
+		numBodiesWoken = 0;
+		numBodiesIslandSlept = 0;
+
 #ifdef GAME_DLL
 		// allow changing SIMD usage on the fly
 		if ( com_forceGenericSIMD.IsModified() ) {
@@ -2263,6 +2775,9 @@ gameReturn_t idGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 					ent->Think();
 					num++;
 				}
+			} else if ( g_parallelThink.GetBool() && jobSystem->NumThreads() > 1 ) {
+				num = ParallelThink();
+				parallelThink = true;
 			} else {
 				num = 0;
 				for( ent = activeEntities.Next(); ent != NULL; ent = ent->activeNode.Next() ) {
@@ -2306,9 +2821,17 @@ gameReturn_t idGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 
 		// display how long it took to calculate the current game frame
 		if ( g_frametime.GetBool() ) {
-			Printf( "game %d: all:%.1f th:%.1f ev:%.1f %d ents \n",
+			Printf( "game %d: all:%.1f th:%.1f ev:%.1f %d ents %d/%d events \n",
 				time, timer_think.Milliseconds() + timer_events.Milliseconds(),
-				timer_think.Milliseconds(), timer_events.Milliseconds(), num );
+				timer_think.Milliseconds(), timer_events.Milliseconds(), num,
+				idEvent::NumServicedEvents(), idEvent::NumQueuedEvents() );
+			if ( parallelThink ) {
+				Printf( "game %d: parallel think: %d islands (%d parallel) par:%.1f slowest:%.1f cmd:%.1f\n",
+					time, thinkNumParallel + thinkNumSerial, thinkNumParallel,
+					thinkParallelMsec, thinkSlowestIslandMsec, thinkCommandsMsec );
+			}
+			Printf( "game %d: rigid bodies: %d came to rest (%d in sleep islands) %d woke up\n",
+				time, numBodiesRested, numBodiesIslandSlept, numBodiesWoken );
 		}
 
 		// build the return value
@@ -2916,6 +3439,9 @@ idGameLocal::RegisterEntity
 void idGameLocal::RegisterEntity( idEntity *ent ) {
 	int spawn_entnum;
 
+	// entities are never spawned while thinking in parallel
+	assert( !threadThinkIsland );
+
 	if ( spawnCount >= ( 1 << ( 32 - GENTITYNUM_BITS ) ) ) {
 		Error( "idGameLocal::RegisterEntity: spawn count overflow" );
 	}
@@ -2933,6 +3459,8 @@ void idGameLocal::RegisterEntity( idEntity *ent ) {
 	entities[ spawn_entnum ] = ent;
 	spawnIds[ spawn_entnum ] = spawnCount++;
 	ent->entityNumber = spawn_entnum;
+	// the slot may be reused while the entities think in parallel
+	thinkIslandFlags[ spawn_entnum ] &= ~THINKISLAND_WALKED;
 	ent->spawnNode.AddToEnd( spawnedEntities );
 	ent->spawnArgs.TransferKeyValues( spawnArgs );
 
@@ -3535,6 +4063,32 @@ idActor *idGameLocal::GetAlertEntity( void ) {
 	return NULL;
 }
 
+/*
+============
+idGameLocal::NumAIPaths
+
+  AI only think on the game thread, so the count needs no lock
+============
+*/
+int idGameLocal::NumAIPaths( void ) {
+	assert( !threadThinkIsland );
+	if ( aiPathFrame != framenum ) {
+		aiPathFrame = framenum;
+		numAIPaths = 0;
+	}
+	return numAIPaths;
+}
+
+/*
+============
+idGameLocal::AddAIPath
+============
+*/
+void idGameLocal::AddAIPath( void ) {
+	NumAIPaths();
+	numAIPaths++;
+}
+
 /*
 ============
 idGameLocal::RadiusDamage
@@ -129,6 +129,15 @@ typedef struct snapshot_s {
 	struct snapshot_s *		next;
 } snapshot_t;
 
+typedef struct snapshotEncode_s {
+	int						generation;				// snapshotEncodeGeneration the state was encoded in
+	int						spawnId;				// spawn id of the entity the state was encoded for
+	int						firstField;				// first recorded field in snapshotEncodeFields
+	int						numFields;
+	volatile int			numUses;				// number of client snapshots the state was used for
+	entityState_t *			state;					// new base shared by all client snapshots
+} snapshotEncode_t;
+
 const int MAX_EVENT_PARAM_SIZE		= 128;
 
 typedef struct entityNetEvent_s {
@@ -239,6 +248,59 @@ private:
 
 //============================================================================
 
+/*
+===============================================================================
+
+	Parallel think
+
+	With g_parallelThink set, entities that only change their own state when they
+	think are partitioned into islands that can't touch each other this frame.
+	The islands think in jobs. Side effects on the rest of the game are recorded
+	in the command buffer of the island and run on the game thread afterwards.
+
+===============================================================================
+*/
+
+typedef enum {
+	THINKCMD_ACTIVATE,				// add the entity to the active entity list
+	THINKCMD_REACTIVATE,			// an entity that stopped thinking this frame thinks again
+	THINKCMD_DEACTIVATE,			// the entity stopped thinking
+	THINKCMD_EVENT,					// schedule a posted event
+	THINKCMD_COLLIDE,				// idEntity::Collide
+	THINKCMD_PRESENT,				// idEntity::Present
+	THINKCMD_UPDATESOUND,			// idEntity::UpdateSound
+	THINKCMD_CALL					// any other function that has to run on the game thread
+} thinkCommandType_t;
+
+typedef void (*thinkCall_t)( idEntity *ent );
+
+typedef struct thinkCommand_s {
+	thinkCommandType_t		type;
+	idEntityPtr<idEntity>	entity;
+	thinkCall_t				call;					// THINKCMD_CALL
+	idEvent *				event;					// THINKCMD_EVENT
+	idClass *				eventObject;
+	const idTypeInfo *		eventType;
+	int						eventTime;
+	int						collision;				// THINKCMD_COLLIDE index in the island collisions
+} thinkCommand_t;
+
+typedef struct thinkCollision_s {
+	trace_t					collision;
+	idVec3					velocity;
+} thinkCollision_t;
+
+typedef struct thinkIsland_s {
+	idList<idEntity *>		entities;				// in active entity list order
+	idList<thinkCommand_t>	commands;				// in the order the side effects happened
+	idList<thinkCollision_t> collisions;
+	double					msec;					// think time of the whole island
+} thinkIsland_t;
+
+extern ID_THREAD_LOCAL thinkIsland_t *	threadThinkIsland;	// island the thread is thinking, NULL outside the parallel think
+
+//============================================================================
+
 class idGameLocal : public idGame {
 public:
 	idDict					serverInfo;				// all the tunable parameters, like numclients, etc
@@ -313,6 +375,10 @@ public:
 	idEntityPtr<idEntity>	lastGUIEnt;				// last entity with a GUI, used by Cmd_NextGUI_f
 	int						lastGUI;				// last GUI on the lastGUIEnt
 
+	volatile int			numBodiesRested;		// rigid bodies that came to rest this frame, for g_frametime
+	volatile int			numBodiesWoken;			// rigid bodies woken up this frame
+	volatile int			numBodiesIslandSlept;	// rigid bodies put to rest by rb_sleepIslands this frame
+
 	// ---------------------- Public idGame Interface -------------------
 
 							idGameLocal();
@@ -344,6 +410,7 @@ public:
 	virtual void			ServerClientBegin( int clientNum );
 	virtual void			ServerClientDisconnect( int clientNum );
 	virtual void			ServerWriteInitialReliableMessages( int clientNum );
+	virtual void			ServerPrepareSnapshots( void );
 	virtual void			ServerWriteSnapshot( int clientNum, int sequence, idBitMsg &msg, byte *clientInPVS, int numPVSClients );
 	virtual bool			ServerApplySnapshot( int clientNum, int sequence );
 	virtual void			ServerProcessReliableMessage( int clientNum, const idBitMsg &msg );
@@ -373,6 +440,7 @@ public:
 	static void				MapRestart_f( const idCmdArgs &args );
 	bool					NextMap( void );	// returns wether serverinfo settings have been modified
 	static void				NextMap_f( const idCmdArgs &args );
+	static void				BenchSnapshots_f( const idCmdArgs &args );
 
 	idMapFile *				GetLevelMap( void );
 	const char *			GetMapName( void ) const;
@@ -402,6 +470,8 @@ public:
 
 	void					AlertAI( idEntity *ent );
 	idActor *				GetAlertEntity( void );
+	int						NumAIPaths( void );		// paths recalculated by AI this frame
+	void					AddAIPath( void );
 
 	bool					InPlayerPVS( idEntity *ent ) const;
 	bool					InPlayerConnectedArea( idEntity *ent ) const;
@@ -437,6 +507,12 @@ public:
 
 	const idVec3 &			GetGravity( void ) const;
 
+							// record a side effect of an entity thinking in parallel, returns false when not thinking in parallel
+	bool					DeferThinkCommand( thinkCommandType_t type, idEntity *ent );
+	bool					DeferThinkCall( idEntity *ent, thinkCall_t call );
+	bool					DeferThinkEvent( idEvent *event, idClass *object, const idTypeInfo *type, int time );
+	bool					DeferThinkCollide( idEntity *ent, const trace_t &collision, const idVec3 &velocity );
+
 	// added the following to assist licensees with merge issues
 	int						GetFrameNum() const { return framenum; };
 	int						GetTime() const { return time; };
@@ -487,6 +563,8 @@ private:
 
 	idEntityPtr<idActor>	lastAIAlertEntity;
 	int						lastAIAlertTime;
+	int						aiPathFrame;			// frame numAIPaths is counted for
+	int						numAIPaths;
 
 	idDict					spawnArgs;				// spawn args used during entity spawning  FIXME: shouldn't be necessary anymore
 
@@ -503,12 +581,34 @@ private:
 	entityState_t *			clientEntityStates[MAX_CLIENTS][MAX_GENTITIES];
 	int						clientPVS[MAX_CLIENTS][ENTITY_PVS_SIZE];
 	snapshot_t *			clientSnapshots[MAX_CLIENTS];
-	idBlockAlloc<entityState_t,256>entityStateAllocator;
-	idBlockAlloc<snapshot_t,64>snapshotAllocator;
+	idBlockAlloc<entityState_t,256>entityStateAllocator;	// shared snapshot encode states
+							// the snapshots of different clients are written in parallel, so every client has its own allocators
+	idBlockAlloc<entityState_t,256>clientEntityStateAllocators[MAX_CLIENTS];
+	idBlockAlloc<snapshot_t,64>clientSnapshotAllocators[MAX_CLIENTS];
+
+	snapshotEncode_t		snapshotEncodes[MAX_GENTITIES];	// entity states encoded once per frame for all client snapshots
+	idList<deltaField_t>	snapshotEncodeFields;
+	int						snapshotEncodeGeneration;
+	volatile int			snapshotEncodeHits;				// entity states reused from the encode cache
+	int						snapshotEncodeMisses;			// entity states encoded with WriteToSnapshot
+	volatile int			snapshotEncodeBytesSaved;		// state bytes that did not have to be encoded again
 
 	idEventQueue			eventQueue;
 	idEventQueue			savedEventQueue;
 
+	idList< idEntityPtr<idEntity> > thinkCandidates;	// active entities that can think in parallel
+	idList<idBounds>		thinkCandidateBounds;	// bounds each candidate may move through this frame
+	idList<thinkIsland_t *>	thinkIslands;			// islands that think in parallel, reused every frame
+	int						numThinkIslands;
+	int						thinkIslandParent[MAX_GENTITIES];	// union find on entity numbers
+	int						thinkIslandFlags[MAX_GENTITIES];
+	int						thinkIslandNum[MAX_GENTITIES];
+	float					thinkParallelMsec;		// stats of the last frame for g_frametime
+	float					thinkCommandsMsec;
+	float					thinkSlowestIslandMsec;
+	int						thinkNumParallel;
+	int						thinkNumSerial;
+
 	idStaticList<spawnSpot_t, MAX_GENTITIES> spawnSpots;
 	idStaticList<idEntity *, MAX_GENTITIES> initialSpots;
 	int						currentInitialSpot;
@@ -533,6 +633,12 @@ private:
 	void					FreePlayerPVS( void );
 	void					UpdateGravity( void );
 	void					SortActiveEntityList( void );
+	int						ParallelThink( void );
+	int						ThinkIslandRoot( int entityNum );
+	void					LinkThinkIsland( idEntity *ent, idEntity *other );
+	void					LinkSleepRing( idEntity *ent, idEntity *sleeper );
+	void					RunThinkCommands( thinkIsland_t *island );
+	static void				ThinkIslandsJob( void *data, int first, int last );
 	void					ShowTargets( void );
 	void					RunDebugInfo( void );
 
@@ -548,6 +654,9 @@ private:
 	void					ServerSendDeclRemapToClient( int clientNum, declType_t type, int index );
 	void					FreeSnapshotsOlderThanSequence( int clientNum, int sequence );
 	bool					ApplySnapshot( int clientNum, int sequence );
+	void					InvalidateSnapshotEncodes( void );
+	void					EncodeEntitySnapshot( idEntity *ent );
+	const snapshotEncode_t *UseEntitySnapshotEncode( const idEntity *ent );
 	void					WriteGameStateToSnapshot( idBitMsgDelta &msg ) const;
 	void					ReadGameStateFromSnapshot( const idBitMsgDelta &msg );
 	void					NetworkEventWarning( const entityNetEvent_t *event, const char *fmt, ... ) id_attribute((format(printf,3,4)));
@@ -53,6 +53,7 @@ idCVar net_clientSmoothing( "net_clientSmoothing", "0.8", CVAR_GAME | CVAR_FLOAT
 idCVar net_clientSelfSmoothing( "net_clientSelfSmoothing", "0.6", CVAR_GAME | CVAR_FLOAT, "smooth self position if network causes prediction error.", 0.0f, 0.95f );
 idCVar net_clientMaxPrediction( "net_clientMaxPrediction", "1000", CVAR_SYSTEM | CVAR_INTEGER | CVAR_NOCHEAT, "maximum number of milliseconds a client can predict ahead of server." );
 idCVar net_clientLagOMeter( "net_clientLagOMeter", "1", CVAR_GAME | CVAR_BOOL | CVAR_NOCHEAT | CVAR_ARCHIVE, "draw prediction graph" );
+idCVar net_serverSnapshotEncodeCache( "net_serverSnapshotEncodeCache", "1", CVAR_GAME | CVAR_BOOL | CVAR_NOCHEAT, "encode entity states once per frame and share them across the client snapshots" );
 
 /*
 ================
@@ -72,6 +73,14 @@ void idGameLocal::InitAsyncNetwork( void ) {
 	memset( clientPVS, 0, sizeof( clientPVS ) );
 	memset( clientSnapshots, 0, sizeof( clientSnapshots ) );
 
+	memset( snapshotEncodes, 0, sizeof( snapshotEncodes ) );
+	snapshotEncodeFields.SetGranularity( 1024 );
+	snapshotEncodeFields.Clear();
+	snapshotEncodeGeneration = 1;
+	snapshotEncodeHits = 0;
+	snapshotEncodeMisses = 0;
+	snapshotEncodeBytesSaved = 0;
+
 	eventQueue.Init();
 	savedEventQueue.Init();
 
@@ -88,13 +97,20 @@ idGameLocal::ShutdownAsyncNetwork
 ================
 */
 void idGameLocal::ShutdownAsyncNetwork( void ) {
+	int i;
+
 	entityStateAllocator.Shutdown();
-	snapshotAllocator.Shutdown();
+	for ( i = 0; i < MAX_CLIENTS; i++ ) {
+		clientEntityStateAllocators[i].Shutdown();
+		clientSnapshotAllocators[i].Shutdown();
+	}
 	eventQueue.Shutdown();
 	savedEventQueue.Shutdown();
 	memset( clientEntityStates, 0, sizeof( clientEntityStates ) );
 	memset( clientPVS, 0, sizeof( clientPVS ) );
 	memset( clientSnapshots, 0, sizeof( clientSnapshots ) );
+	memset( snapshotEncodes, 0, sizeof( snapshotEncodes ) );
+	snapshotEncodeFields.Clear();
 }
 
 /*
@@ -307,6 +323,9 @@ void idGameLocal::ServerClientBegin( int clientNum ) {
 	idBitMsg	outMsg;
 	byte		msgBuf[MAX_GAME_MESSAGE_SIZE];
 
+	// the player spawns outside the game frame
+	InvalidateSnapshotEncodes();
+
 	// initialize the decl remap
 	InitClientDeclRemap( clientNum );
 
@@ -353,7 +372,7 @@ void idGameLocal::ServerClientDisconnect( int clientNum ) {
 	// free entity states stored for this client
 	for ( i = 0; i < MAX_GENTITIES; i++ ) {
 		if ( clientEntityStates[ clientNum ][ i ] ) {
-			entityStateAllocator.Free( clientEntityStates[ clientNum ][ i ] );
+			clientEntityStateAllocators[ clientNum ].Free( clientEntityStates[ clientNum ][ i ] );
 			clientEntityStates[ clientNum ][ i ] = NULL;
 		}
 	}
@@ -364,6 +383,8 @@ void idGameLocal::ServerClientDisconnect( int clientNum ) {
 	// delete the player entity
 	delete entities[ clientNum ];
 
+	InvalidateSnapshotEncodes();
+
 	mpGame.DisconnectClient( clientNum );
 
 }
@@ -460,14 +481,14 @@ void idGameLocal::FreeSnapshotsOlderThanSequence( int clientNum, int sequence )
 		if ( snapshot->sequence < sequence ) {
 			for ( state = snapshot->firstEntityState; state; state = snapshot->firstEntityState ) {
 				snapshot->firstEntityState = snapshot->firstEntityState->next;
-				entityStateAllocator.Free( state );
+				clientEntityStateAllocators[clientNum].Free( state );
 			}
 			if ( lastSnapshot ) {
 				lastSnapshot->next = snapshot->next;
 			} else {
 				clientSnapshots[clientNum] = snapshot->next;
 			}
-			snapshotAllocator.Free( snapshot );
+			clientSnapshotAllocators[clientNum].Free( snapshot );
 		} else {
 			lastSnapshot = snapshot;
 		}
@@ -490,7 +511,7 @@ bool idGameLocal::ApplySnapshot( int clientNum, int sequence ) {
 		if ( snapshot->sequence == sequence ) {
 			for ( state = snapshot->firstEntityState; state; state = state->next ) {
 				if ( clientEntityStates[clientNum][state->entityNumber] ) {
-					entityStateAllocator.Free( clientEntityStates[clientNum][state->entityNumber] );
+					clientEntityStateAllocators[clientNum].Free( clientEntityStates[clientNum][state->entityNumber] );
 				}
 				clientEntityStates[clientNum][state->entityNumber] = state;
 			}
@@ -500,7 +521,7 @@ bool idGameLocal::ApplySnapshot( int clientNum, int sequence ) {
 			} else {
 				clientSnapshots[clientNum] = nextSnapshot;
 			}
-			snapshotAllocator.Free( snapshot );
+			clientSnapshotAllocators[clientNum].Free( snapshot );
 			return true;
 		} else {
 			lastSnapshot = snapshot;
@@ -555,6 +576,7 @@ void idGameLocal::ServerWriteSnapshot( int clientNum, int sequence, idBitMsg &ms
 	idBitMsgDelta deltaMsg;
 	snapshot_t *snapshot;
 	entityState_t *base, *newBase;
+	const snapshotEncode_t *encode;
 	int numSourceAreas, sourceAreas[ idEntity::MAX_PVS_AREAS ];
 
 	player = static_cast<idPlayer *>( entities[ clientNum ] );
@@ -571,7 +593,7 @@ void idGameLocal::ServerWriteSnapshot( int clientNum, int sequence, idBitMsg &ms
 	FreeSnapshotsOlderThanSequence( clientNum, sequence - 64 );
 
 	// allocate new snapshot
-	snapshot = snapshotAllocator.Alloc();
+	snapshot = clientSnapshotAllocators[clientNum].Alloc();
 	snapshot->sequence = sequence;
 	snapshot->firstEntityState = NULL;
 	snapshot->next = clientSnapshots[clientNum];
@@ -615,23 +637,36 @@ void idGameLocal::ServerWriteSnapshot( int clientNum, int sequence, idBitMsg &ms
 		if ( base ) {
 			base->state.BeginReading();
 		}
-		newBase = entityStateAllocator.Alloc();
+		newBase = clientEntityStateAllocators[clientNum].Alloc();
 		newBase->entityNumber = ent->entityNumber;
 		newBase->state.Init( newBase->stateBuf, sizeof( newBase->stateBuf ) );
 		newBase->state.BeginWriting();
 
-		deltaMsg.Init( base ? &base->state : NULL, &newBase->state, &msg );
+		encode = net_serverSnapshotEncodeCache.GetBool() ? UseEntitySnapshotEncode( ent ) : NULL;
+		if ( encode ) {
+			const idBitMsg &encodeState = encode->state->state;
 
-		deltaMsg.WriteBits( spawnIds[ ent->entityNumber ], 32 - GENTITYNUM_BITS );
-		deltaMsg.WriteBits( ent->GetType()->typeNum, idClass::GetTypeNumBits() );
-		deltaMsg.WriteBits( ServerRemapDecl( -1, DECL_ENTITYDEF, ent->entityDefNumber ), entityDefBits );
+			// the new base is the shared state, only the delta against the client base is written
+			memcpy( newBase->stateBuf, encode->state->stateBuf, encodeState.GetSize() );
+			newBase->state.SetSize( encodeState.GetSize() );
+			newBase->state.SetWriteBit( encodeState.GetWriteBit() );
 
-		// write the class specific data to the snapshot
-		ent->WriteToSnapshot( deltaMsg );
+			deltaMsg.Init( base ? &base->state : NULL, NULL, &msg );
+			deltaMsg.WriteFields( encodeState, snapshotEncodeFields.Ptr() + encode->firstField, encode->numFields );
+		} else {
+			deltaMsg.Init( base ? &base->state : NULL, &newBase->state, &msg );
+
+			deltaMsg.WriteBits( spawnIds[ ent->entityNumber ], 32 - GENTITYNUM_BITS );
+			deltaMsg.WriteBits( ent->GetType()->typeNum, idClass::GetTypeNumBits() );
+			deltaMsg.WriteBits( ServerRemapDecl( -1, DECL_ENTITYDEF, ent->entityDefNumber ), entityDefBits );
+
+			// write the class specific data to the snapshot
+			ent->WriteToSnapshot( deltaMsg );
+		}
 
 		if ( !deltaMsg.HasChanged() ) {
 			msg.RestoreWriteState( msgSize, msgWriteBit );
-			entityStateAllocator.Free( newBase );
+			clientEntityStateAllocators[clientNum].Free( newBase );
 		} else {
 			newBase->next = snapshot->firstEntityState;
 			snapshot->firstEntityState = newBase;
@@ -667,7 +702,7 @@ void idGameLocal::ServerWriteSnapshot( int clientNum, int sequence, idBitMsg &ms
 	if ( base ) {
 		base->state.BeginReading();
 	}
-	newBase = entityStateAllocator.Alloc();
+	newBase = clientEntityStateAllocators[clientNum].Alloc();
 	newBase->entityNumber = ENTITYNUM_NONE;
 	newBase->next = snapshot->firstEntityState;
 	snapshot->firstEntityState = newBase;
@@ -686,6 +721,302 @@ void idGameLocal::ServerWriteSnapshot( int clientNum, int sequence, idBitMsg &ms
 	LittleRevBytes( clientInPVS, sizeof( int ), sizeof( clientInPVS ) / sizeof ( int ) );
 }
 
+/*
+================
+idGameLocal::InvalidateSnapshotEncodes
+
+  Entity states encoded for the client snapshots are only valid until the game state changes.
+================
+*/
+void idGameLocal::InvalidateSnapshotEncodes( void ) {
+	snapshotEncodeGeneration++;
+	snapshotEncodeFields.SetNum( 0, false );
+}
+
+/*
+================
+idGameLocal::EncodeEntitySnapshot
+
+  Encodes the entity state once and records the delta fields written to it so the
+  state can be delta compressed against the base of every client with idBitMsgDelta::WriteFields.
+================
+*/
+void idGameLocal::EncodeEntitySnapshot( idEntity *ent ) {
+	idBitMsgDelta deltaMsg;
+	snapshotEncode_t *encode;
+
+	encode = &snapshotEncodes[ ent->entityNumber ];
+	if ( encode->generation == snapshotEncodeGeneration && encode->spawnId == spawnIds[ ent->entityNumber ] ) {
+		return;
+	}
+
+	if ( !encode->state ) {
+		encode->state = entityStateAllocator.Alloc();
+		encode->state->entityNumber = ent->entityNumber;
+		encode->state->next = NULL;
+	}
+	encode->state->state.Init( encode->state->stateBuf, sizeof( encode->state->stateBuf ) );
+	encode->state->state.BeginWriting();
+
+	encode->generation = snapshotEncodeGeneration;
+	encode->spawnId = spawnIds[ ent->entityNumber ];
+	encode->firstField = snapshotEncodeFields.Num();
+	encode->numUses = 0;
+
+	deltaMsg.InitRecording( &encode->state->state, &snapshotEncodeFields );
+
+	deltaMsg.WriteBits( spawnIds[ ent->entityNumber ], 32 - GENTITYNUM_BITS );
+	deltaMsg.WriteBits( ent->GetType()->typeNum, idClass::GetTypeNumBits() );
+	deltaMsg.WriteBits( ServerRemapDecl( -1, DECL_ENTITYDEF, ent->entityDefNumber ), entityDefBits );
+
+	// write the class specific data to the shared state
+	ent->WriteToSnapshot( deltaMsg );
+
+	encode->numFields = snapshotEncodeFields.Num() - encode->firstField;
+	snapshotEncodeMisses++;
+}
+
+/*
+================
+idGameLocal::UseEntitySnapshotEncode
+
+  Returns the state encoded by ServerPrepareSnapshots, or NULL when the entity
+  wasn't encoded this frame. Called from the parallel snapshot jobs.
+================
+*/
+const snapshotEncode_t *idGameLocal::UseEntitySnapshotEncode( const idEntity *ent ) {
+	snapshotEncode_t *encode;
+
+	encode = &snapshotEncodes[ ent->entityNumber ];
+	if ( encode->generation != snapshotEncodeGeneration || encode->spawnId != spawnIds[ ent->entityNumber ] ) {
+		return NULL;
+	}
+
+	// the first snapshot the state is used for doesn't save anything
+	if ( Sys_InterlockedIncrement( encode->numUses ) > 1 ) {
+		Sys_InterlockedIncrement( snapshotEncodeHits );
+		Sys_InterlockedAdd( snapshotEncodeBytesSaved, encode->state->state.GetSize() );
+	}
+	return encode;
+}
+
+/*
+================
+idGameLocal::ServerPrepareSnapshots
+
+  Everything the snapshots of all clients share is set up here, so
+  ServerWriteSnapshot can run in parallel for different clients.
+================
+*/
+void idGameLocal::ServerPrepareSnapshots( void ) {
+	idEntity *ent;
+
+	for( ent = spawnedEntities.Next(); ent != NULL; ent = ent->spawnNode.Next() ) {
+
+		// the PVS areas are otherwise updated on demand while testing the entity against the client PVS
+		ent->GetNumPVSAreas();
+
+		if ( ent->fl.networkSync && net_serverSnapshotEncodeCache.GetBool() ) {
+			EncodeEntitySnapshot( ent );
+		}
+	}
+}
+
+typedef struct benchSnapshot_s {
+	int						clientNum;
+	int						sequence;
+	idBitMsg				msg;
+	byte					msgBuf[MAX_GAME_MESSAGE_SIZE];
+	byte					clientInPVS[( MAX_CLIENTS + 7 ) >> 3];
+} benchSnapshot_t;
+
+/*
+================
+BenchWriteSnapshotsJob
+================
+*/
+static void BenchWriteSnapshotsJob( void *data, int first, int last ) {
+	benchSnapshot_t *snapshots = (benchSnapshot_t *)data;
+
+	for ( int i = first; i < last; i++ ) {
+		gameLocal.ServerWriteSnapshot( snapshots[i].clientNum, snapshots[i].sequence, snapshots[i].msg, snapshots[i].clientInPVS, MAX_CLIENTS );
+	}
+}
+
+/*
+================
+BenchWriteSnapshots
+
+  Writes the snapshots like idAsyncServer does at the end of a server frame.
+================
+*/
+static void BenchWriteSnapshots( benchSnapshot_t *snapshots, int numSnapshots, bool parallel, idTimer &timer ) {
+	int i;
+
+	for ( i = 0; i < numSnapshots; i++ ) {
+		snapshots[i].msg.Init( snapshots[i].msgBuf, sizeof( snapshots[i].msgBuf ) );
+		snapshots[i].msg.BeginWriting();
+	}
+
+	timer.Start();
+	gameLocal.ServerPrepareSnapshots();
+	if ( parallel ) {
+		jobSystem->ParallelFor( BenchWriteSnapshotsJob, snapshots, numSnapshots, 1 );
+	} else {
+		BenchWriteSnapshotsJob( snapshots, 0, numSnapshots );
+	}
+	timer.Stop();
+}
+
+/*
+================
+BenchCompareSnapshots
+================
+*/
+static int BenchCompareSnapshots( const benchSnapshot_t *snapshots, const benchSnapshot_t *reference, int numSnapshots ) {
+	int i, numDiffs;
+
+	for ( numDiffs = i = 0; i < numSnapshots; i++ ) {
+		if ( snapshots[i].msg.GetSize() != reference[i].msg.GetSize() ||
+				memcmp( snapshots[i].msgBuf, reference[i].msgBuf, reference[i].msg.GetSize() ) != 0 ) {
+			numDiffs++;
+		}
+	}
+	return numDiffs;
+}
+
+/*
+================
+idGameLocal::BenchSnapshots_f
+
+  Connects fake clients on the free client slots, runs the game with random user commands
+  and writes the snapshots for the fake clients without the snapshot encode cache, with the
+  cache, and with the cache in parallel. Meant to be run on a dedicated server without clients connected.
+================
+*/
+void idGameLocal::BenchSnapshots_f( const idCmdArgs &args ) {
+	int					i, j, frame, numClients, numFrames;
+	int					clientNums[MAX_CLIENTS];
+	int					encodeHits, encodeMisses, encodeBytesSaved, bytesWritten, mismatches;
+	benchSnapshot_t *	snapshots;
+	usercmd_t			cmds[MAX_CLIENTS];
+	idDict				info;
+	idRandom			random;
+	idTimer				uncachedTimer, cachedTimer, parallelTimer;
+	bool				encodeCache;
+
+	if ( !gameLocal.isMultiplayer || gameLocal.isClient || gameLocal.GameState() != GAMESTATE_ACTIVE ) {
+		common->Printf( "server is not running\n" );
+		return;
+	}
+
+	numClients = ( args.Argc() > 1 ) ? idMath::ClampInt( 1, MAX_CLIENTS, atoi( args.Argv( 1 ) ) ) : 16;
+	numFrames = ( args.Argc() > 2 ) ? Max( 1, atoi( args.Argv( 2 ) ) ) : 600;
+
+	// connect fake clients on the free client slots
+	for ( i = j = 0; i < MAX_CLIENTS && j < numClients; i++ ) {
+		if ( gameLocal.entities[ i ] ) {
+			continue;
+		}
+		info.Clear();
+		info.Set( "ui_name", va( "bench%d", j ) );
+		info.Set( "ui_spectate", "Play" );
+		info.Set( "ui_ready", "Ready" );
+		gameLocal.ServerClientConnect( i, "BENCH" );
+		gameLocal.SetUserInfo( i, info, false, false );
+		gameLocal.ServerClientBegin( i );
+		clientNums[ j++ ] = i;
+	}
+	numClients = j;
+	if ( !numClients ) {
+		common->Printf( "no free client slots\n" );
+		return;
+	}
+
+	// uncached, cached and parallel snapshots
+	snapshots = new benchSnapshot_t[ numClients * 3 ];
+	for ( i = 0; i < numClients * 3; i++ ) {
+		snapshots[i].clientNum = clientNums[ i % numClients ];
+	}
+
+	encodeCache = net_serverSnapshotEncodeCache.GetBool();
+	encodeHits = gameLocal.snapshotEncodeHits;
+	encodeMisses = gameLocal.snapshotEncodeMisses;
+	encodeBytesSaved = gameLocal.snapshotEncodeBytesSaved;
+	bytesWritten = 0;
+	mismatches = 0;
+
+	uncachedTimer.Clear();
+	cachedTimer.Clear();
+	parallelTimer.Clear();
+	random.SetSeed( 0 );
+	memcpy( cmds, gameLocal.usercmds, sizeof( cmds ) );
+
+	for ( frame = 1; frame <= numFrames; frame++ ) {
+
+		// drive the fake clients with random user commands
+		for ( i = 0; i < numClients; i++ ) {
+			usercmd_t &cmd = cmds[ clientNums[ i ] ];
+			cmd.gameFrame = gameLocal.framenum + 1;
+			cmd.gameTime = gameLocal.time + gameLocal.msec;
+			cmd.duplicateCount = 0;
+			cmd.buttons = ( random.RandomInt( 8 ) == 0 ) ? BUTTON_ATTACK : 0;
+			cmd.forwardmove = random.RandomInt( 255 ) - 127;
+			cmd.rightmove = random.RandomInt( 255 ) - 127;
+			cmd.upmove = ( random.RandomInt( 16 ) == 0 ) ? 127 : 0;
+			cmd.angles[0] = random.RandomInt( 0x2000 ) - 0x1000;
+			cmd.angles[1] += random.RandomInt( 0x800 ) - 0x400;
+			cmd.angles[2] = 0;
+			cmd.impulse = 0;
+			cmd.flags = 0;
+			cmd.sequence = frame;
+		}
+		gameLocal.RunFrame( cmds );
+
+		for ( i = 0; i < numClients * 3; i++ ) {
+			snapshots[i].sequence = frame;
+		}
+
+		// every pass allocates a snapshot with this sequence, only the last one is applied
+		net_serverSnapshotEncodeCache.SetBool( false );
+		BenchWriteSnapshots( snapshots, numClients, false, uncachedTimer );
+
+		// the cached passes both encode the entity states
+		net_serverSnapshotEncodeCache.SetBool( true );
+		gameLocal.InvalidateSnapshotEncodes();
+		BenchWriteSnapshots( snapshots + numClients, numClients, false, cachedTimer );
+		gameLocal.InvalidateSnapshotEncodes();
+		BenchWriteSnapshots( snapshots + numClients * 2, numClients, true, parallelTimer );
+
+		mismatches += BenchCompareSnapshots( snapshots + numClients, snapshots, numClients );
+		mismatches += BenchCompareSnapshots( snapshots + numClients * 2, snapshots, numClients );
+
+		for ( i = 0; i < numClients; i++ ) {
+			bytesWritten += snapshots[i].msg.GetSize();
+
+			// the client acknowledges the snapshot right away
+			gameLocal.ServerApplySnapshot( clientNums[ i ], frame );
+		}
+	}
+
+	net_serverSnapshotEncodeCache.SetBool( encodeCache );
+
+	for ( i = 0; i < numClients; i++ ) {
+		gameLocal.ServerClientDisconnect( clientNums[ i ] );
+	}
+	delete[] snapshots;
+
+	common->Printf( "%d clients, %d frames, %d snapshot bytes per frame\n", numClients, numFrames, bytesWritten / numFrames );
+	common->Printf( "uncached:         %6.1f usec per frame\n", uncachedTimer.Milliseconds() * 1000.0 / numFrames );
+	common->Printf( "cached:           %6.1f usec per frame\n", cachedTimer.Milliseconds() * 1000.0 / numFrames );
+	common->Printf( "cached, parallel: %6.1f usec per frame (%d threads)\n", parallelTimer.Milliseconds() * 1000.0 / numFrames, jobSystem->NumThreads() );
+	common->Printf( "encode hits %d, misses %d, %d bytes saved\n", gameLocal.snapshotEncodeHits - encodeHits,
+						gameLocal.snapshotEncodeMisses - encodeMisses, gameLocal.snapshotEncodeBytesSaved - encodeBytesSaved );
+	if ( mismatches ) {
+		common->Warning( "%d cached snapshots differ from the uncached snapshots", mismatches );
+	}
+}
+
 /*
 ================
 idGameLocal::ServerApplySnapshot
@@ -785,6 +1116,9 @@ idGameLocal::ServerProcessReliableMessage
 void idGameLocal::ServerProcessReliableMessage( int clientNum, const idBitMsg &msg ) {
 	int id;
 
+	// reliable messages can change entity state outside the game frame
+	InvalidateSnapshotEncodes();
+
 	id = msg.ReadByte();
 	switch( id ) {
 		case GAME_RELIABLE_MESSAGE_CHAT:
@@ -997,7 +1331,7 @@ void idGameLocal::ClientReadSnapshot( int clientNum, int sequence, const int gam
 	snapshotEntities.Clear();
 
 	// allocate new snapshot
-	snapshot = snapshotAllocator.Alloc();
+	snapshot = clientSnapshotAllocators[clientNum].Alloc();
 	snapshot->sequence = sequence;
 	snapshot->firstEntityState = NULL;
 	snapshot->next = clientSnapshots[clientNum];
@@ -1015,7 +1349,7 @@ void idGameLocal::ClientReadSnapshot( int clientNum, int sequence, const int gam
 		if ( base ) {
 			base->state.BeginReading();
 		}
-		newBase = entityStateAllocator.Alloc();
+		newBase = clientEntityStateAllocators[clientNum].Alloc();
 		newBase->entityNumber = i;
 		newBase->next = snapshot->firstEntityState;
 		snapshot->firstEntityState = newBase;
@@ -1207,7 +1541,7 @@ void idGameLocal::ClientReadSnapshot( int clientNum, int sequence, const int gam
 	if ( base ) {
 		base->state.BeginReading();
 	}
-	newBase = entityStateAllocator.Alloc();
+	newBase = clientEntityStateAllocators[clientNum].Alloc();
 	newBase->entityNumber = ENTITYNUM_NONE;
 	newBase->next = snapshot->firstEntityState;
 	snapshot->firstEntityState = newBase;
@@ -240,6 +240,10 @@ idItem::Present
 ================
 */
 void idItem::Present( void ) {
+	if ( gameLocal.DeferThinkCommand( THINKCMD_PRESENT, this ) ) {
+		return;
+	}
+
 	idEntity::Present();
 
 	if ( !fl.hidden && pulse ) {
@@ -695,6 +695,11 @@ idLight::PresentLightDefChange
 ================
 */
 void idLight::PresentLightDefChange( void ) {
+	// the render world is updated from the game thread
+	if ( gameLocal.DeferThinkCall( this, DeferredLightDefChange ) ) {
+		return;
+	}
+
 	// let the renderer apply it to the world
 	if ( ( lightDefHandle != -1 ) ) {
 		gameRenderWorld->UpdateLightDef( lightDefHandle, &renderLight );
@@ -714,6 +719,10 @@ void idLight::PresentModelDefChange( void ) {
 		return;
 	}
 
+	if ( gameLocal.DeferThinkCall( this, DeferredModelDefChange ) ) {
+		return;
+	}
+
 	// add to refresh list
 	if ( modelDefHandle == -1 ) {
 		modelDefHandle = gameRenderWorld->AddEntityDef( &renderEntity );
@@ -722,6 +731,24 @@ void idLight::PresentModelDefChange( void ) {
 	}
 }
 
+/*
+================
+idLight::DeferredLightDefChange
+================
+*/
+void idLight::DeferredLightDefChange( idEntity *ent ) {
+	static_cast<idLight *>( ent )->PresentLightDefChange();
+}
+
+/*
+================
+idLight::DeferredModelDefChange
+================
+*/
+void idLight::DeferredModelDefChange( idEntity *ent ) {
+	static_cast<idLight *>( ent )->PresentModelDefChange();
+}
+
 /*
 ================
 idLight::Present
@@ -733,6 +760,10 @@ void idLight::Present( void ) {
 		return;
 	}
 
+	if ( gameLocal.DeferThinkCommand( THINKCMD_PRESENT, this ) ) {
+		return;
+	}
+
 	// add the model
 	idEntity::Present();
 
@@ -115,6 +115,8 @@ private:
 private:
 	void			PresentLightDefChange( void );
 	void			PresentModelDefChange( void );
+	static void		DeferredLightDefChange( idEntity *ent );
+	static void		DeferredModelDefChange( idEntity *ent );
 
 	void			Event_SetShader( const char *shadername );
 	void			Event_GetLightParm( int parmnum );
@@ -75,8 +75,6 @@ idPVS::idPVS( void ) {
 	numAreas = 0;
 	numPortals = 0;
 
-	connectedAreas = NULL;
-	areaQueue = NULL;
 	areaPVS = NULL;
 
 	for ( i = 0; i < MAX_CURRENT_PVS; i++ ) {
@@ -803,9 +801,6 @@ void idPVS::Init( void ) {
 		return;
 	}
 
-	connectedAreas = new bool[numAreas];
-	areaQueue = new int[numAreas];
-
 	areaVisBytes = ( ((numAreas+31)&~31) >> 3);
 	areaVisLongs = areaVisBytes/sizeof(long);
 
@@ -859,14 +854,6 @@ idPVS::Shutdown
 ================
 */
 void idPVS::Shutdown( void ) {
-	if ( connectedAreas ) {
-		delete connectedAreas;
-		connectedAreas = NULL;
-	}
-	if ( areaQueue ) {
-		delete areaQueue;
-		areaQueue = NULL;
-	}
 	if ( areaPVS ) {
 		delete areaPVS;
 		areaPVS = NULL;
@@ -890,8 +877,12 @@ void idPVS::GetConnectedAreas( int srcArea, bool *areas ) const {
 	int curArea, nextArea;
 	int queueStart, queueEnd;
 	int i, n;
+	int *areaQueue;
 	exitPortal_t portal;
 
+	// the queue is on the stack so the current PVS can be set up from multiple threads
+	areaQueue = (int *) _alloca( numAreas * sizeof( *areaQueue ) );
+
 	queueStart = -1;
 	queueEnd = 0;
 	areas[srcArea] = true;
@@ -973,6 +964,7 @@ idPVS::SetupCurrentPVS
 */
 pvsHandle_t idPVS::SetupCurrentPVS( const int sourceArea, const pvsType_t type ) const {
 	int i;
+	bool *connectedAreas;
 	pvsHandle_t handle;
 
 	handle = AllocCurrentPVS( *reinterpret_cast<const unsigned int *>(&sourceArea) );
@@ -992,6 +984,7 @@ pvsHandle_t idPVS::SetupCurrentPVS( const int sourceArea, const pvsType_t type )
 		return handle;
 	}
 
+	connectedAreas = (bool *) _alloca( numAreas * sizeof( *connectedAreas ) );
 	memset( connectedAreas, 0, numAreas * sizeof( *connectedAreas ) );
 
 	GetConnectedAreas( sourceArea, connectedAreas );
@@ -1014,6 +1007,7 @@ pvsHandle_t idPVS::SetupCurrentPVS( const int *sourceAreas, const int numSourceA
 	int i, j;
 	unsigned int h;
 	long *vis, *pvs;
+	bool *connectedAreas;
 	pvsHandle_t handle;
 
 	h = 0;
@@ -1048,6 +1042,7 @@ pvsHandle_t idPVS::SetupCurrentPVS( const int *sourceAreas, const int numSourceA
 		return handle;
 	}
 
+	connectedAreas = (bool *) _alloca( numAreas * sizeof( *connectedAreas ) );
 	memset( connectedAreas, 0, numAreas * sizeof( *connectedAreas ) );
 
 	// get all areas connected to any of the source areas
@@ -1098,19 +1093,25 @@ pvsHandle_t idPVS::MergeCurrentPVS( pvsHandle_t pvs1, pvsHandle_t pvs2 ) const {
 /*
 ================
 idPVS::AllocCurrentPVS
+
+  Current PVS handles can be allocated and freed from multiple threads.
 ================
 */
 pvsHandle_t idPVS::AllocCurrentPVS( unsigned int h ) const {
 	int i;
 	pvsHandle_t handle;
 
+	currentPVSLock.Lock();
 	for ( i = 0; i < MAX_CURRENT_PVS; i++ ) {
 		if ( currentPVS[i].handle.i == -1 ) {
 			currentPVS[i].handle.i = i;
 			currentPVS[i].handle.h = h;
-			return currentPVS[i].handle;
+			handle = currentPVS[i].handle;
+			currentPVSLock.Unlock();
+			return handle;
 		}
 	}
+	currentPVSLock.Unlock();
 
 	gameLocal.Error( "idPVS::AllocCurrentPVS: no free PVS left" );
 
@@ -1128,7 +1129,9 @@ void idPVS::FreeCurrentPVS( pvsHandle_t handle ) const {
 	if ( handle.i < 0 || handle.i >= MAX_CURRENT_PVS || handle.h != currentPVS[handle.i].handle.h ) {
 		gameLocal.Error( "idPVS::FreeCurrentPVS: invalid handle" );
 	}
+	currentPVSLock.Lock();
 	currentPVS[handle.i].handle.i = -1;
+	currentPVSLock.Unlock();
 }
 
 /*
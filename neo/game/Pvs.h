@@ -51,7 +51,7 @@ typedef struct pvsCurrent_s {
 	byte *				pvs;		// current pvs bit string
 } pvsCurrent_t;
 
-#define MAX_CURRENT_PVS		8		// must be a power of 2
+#define MAX_CURRENT_PVS		64		// must be a power of 2, snapshots for different clients setup a current PVS in parallel
 
 typedef enum {
 	PVS_NORMAL				= 0,	// PVS through portals taking portal states into account
@@ -96,11 +96,10 @@ public:
 private:
 	int					numAreas;
 	int					numPortals;
-	bool *				connectedAreas;
-	int *				areaQueue;
 	byte *				areaPVS;
 						// current PVS for a specific source possibly taking portal states (open/closed) into account
 	mutable pvsCurrent_t currentPVS[MAX_CURRENT_PVS];
+	mutable idSysSpinLock currentPVSLock;
 						// used to create PVS
 	int					portalVisBytes;
 	int					portalVisLongs;
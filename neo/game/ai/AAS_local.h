@@ -44,6 +44,7 @@ public:
 
 private:
 	int							type;					// portal or area cache
+	int							updateState;			// ROUTINGCACHE_VALID or ROUTINGCACHE_QUEUED
 	int							size;					// size of cache
 	int							cluster;				// cluster of the cache
 	int							areaNum;				// area of the cache
@@ -55,6 +56,8 @@ private:
 	unsigned short				startTravelTime;		// travel time to start with
 	unsigned char *				reachabilities;			// reachabilities used for routing
 	unsigned short *			travelTimes;			// travel time for every area
+	unsigned char *				nextReachabilities;		// reachabilities written by a background update
+	unsigned short *			nextTravelTimes;		// travel times written by a background update
 };
 
 
@@ -73,6 +76,22 @@ private:
 };
 
 
+class idRoutingResult {
+	friend class idAASLocal;
+
+private:
+	int							areaNum;				// start area
+	int							goalAreaNum;			// goal area
+	int							travelFlags;			// travel flags used for routing
+	bool						found;					// false if there is no route
+	bool						startIsPortal;			// the start area is a cluster portal and only portalReach is used
+	idReachability *			clusterReach;			// reachability towards the goal within the cluster
+	unsigned short				clusterTravelTime;		// travel time without the time from the origin to clusterReach
+	idReachability *			portalReach;			// reachability towards the best portal
+	unsigned short				portalTravelTime;		// travel time through the best portal
+};
+
+
 class idRoutingObstacle {
 	friend class idAASLocal;
 								idRoutingObstacle( void ) { }
@@ -137,6 +156,25 @@ private:	// routing data
 	mutable idRoutingCache *	cacheListEnd;			// end of list with cache sorted from oldest to newest
 	mutable int					totalCacheMemory;		// total cache memory used
 	idList<idRoutingObstacle *>	obstacleList;			// list with obstacles
+	mutable idList<idRoutingCache *> cacheUpdates;		// area cache recalculated by background jobs
+	mutable int					queuedCacheMemory;		// memory of the buffers the background jobs write to
+	mutable idJobCounter		cacheUpdateCounter;		// background jobs still running
+	mutable idList<idRoutingResult> routeResults;		// routes found this frame, shared by all queries with the same areas and travel flags
+	mutable idHashIndex			routeResultHash;		// hash on start and goal area
+	mutable int					routeResultFrame;		// frame the route results are valid for
+
+private:	// routing stats
+	mutable int					numCacheHits;			// cache found with up to date travel times
+	mutable int					numCacheStaleHits;		// cache found while a background update is running
+	mutable int					numAreaCacheMisses;		// area cache calculated on the game thread
+	mutable int					numPortalCacheMisses;	// portal cache calculated on the game thread
+	mutable double				areaCacheMsec;			// time spent calculating area cache on the game thread
+	mutable double				portalCacheMsec;		// time spent calculating portal cache on the game thread, includes area cache
+	mutable int					numCacheUpdates;		// area cache recalculated by background jobs
+	mutable double				cacheUpdateMsec;		// time spent in background jobs
+	mutable idSysSpinLock		cacheUpdateLock;		// the jobs add their time under this lock
+	mutable int					numRouteQueries;		// RouteToGoalArea calls
+	mutable int					numRouteQueriesShared;	// RouteToGoalArea calls answered with a route found earlier in the frame
 
 private:	// routing
 	bool						SetupRouting( void );
@@ -146,7 +184,7 @@ private:	// routing
 	void						DeleteAreaTravelTimes( void );
 	void						SetupRoutingCache( void );
 	void						DeleteClusterCache( int clusterNum );
-	void						DeletePortalCache( void );
+	void						DeletePortalCache( void ) const;
 	void						ShutdownRoutingCache( void );
 	void						RoutingStats( void ) const;
 	void						LinkCache( idRoutingCache *cache ) const;
@@ -155,10 +193,18 @@ private:	// routing
 	idReachability *			GetAreaReachability( int areaNum, int reachabilityNum ) const;
 	int							ClusterAreaNum( int clusterNum, int areaNum ) const;
 	void						UpdateAreaRoutingCache( idRoutingCache *areaCache ) const;
+	void						UpdateAreaRoutingCache( const idRoutingCache *areaCache, idRoutingUpdate *update, unsigned short *travelTimes, byte *reachabilities ) const;
 	idRoutingCache *			GetAreaRoutingCache( int clusterNum, int areaNum, int travelFlags ) const;
 	void						UpdatePortalRoutingCache( idRoutingCache *portalCache ) const;
 	idRoutingCache *			GetPortalRoutingCache( int clusterNum, int areaNum, int travelFlags ) const;
+	void						FindRoute( idRoutingResult &route ) const;
+	const idRoutingResult &		GetRoute( int areaNum, int goalAreaNum, int travelFlags ) const;
+	void						ClearRouteResults( void ) const;
 	void						RemoveRoutingCacheUsingArea( int areaNum );
+	void						QueueClusterCacheUpdates( int clusterNum );
+	void						StartRoutingCacheUpdates( void );
+	void						FinishRoutingCacheUpdates( void ) const;
+	static void					RoutingCacheUpdateJob( void *data, int first, int last );
 	void						DisableArea( int areaNum );
 	void						EnableArea( int areaNum );
 	bool						SetAreaState_r( int nodeNum, const idBounds &bounds, const int areaContents, bool disabled );
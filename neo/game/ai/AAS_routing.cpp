@@ -35,6 +35,9 @@ If you have questions concerning this license or the applicable additional terms
 #define CACHETYPE_AREA				1
 #define CACHETYPE_PORTAL			2
 
+#define ROUTINGCACHE_VALID			0
+#define ROUTINGCACHE_QUEUED			1
+
 #define MAX_ROUTING_CACHE_MEMORY	(2*1024*1024)
 
 #define LEDGE_TRAVELTIME_PANALTY	250
@@ -52,11 +55,14 @@ idRoutingCache::idRoutingCache( int size ) {
 	travelFlags = 0;
 	startTravelTime = 0;
 	type = 0;
+	updateState = ROUTINGCACHE_VALID;
 	this->size = size;
 	reachabilities = new byte[size];
 	memset( reachabilities, 0, size * sizeof( reachabilities[0] ) );
 	travelTimes = new unsigned short[size];
 	memset( travelTimes, 0, size * sizeof( travelTimes[0] ) );
+	nextReachabilities = NULL;
+	nextTravelTimes = NULL;
 }
 
 /*
@@ -67,11 +73,15 @@ idRoutingCache::~idRoutingCache
 idRoutingCache::~idRoutingCache( void ) {
 	delete [] reachabilities;
 	delete [] travelTimes;
+	delete [] nextReachabilities;
+	delete [] nextTravelTimes;
 }
 
 /*
 ============
 idRoutingCache::Size
+
+  the buffers of a queued background update are not included
 ============
 */
 int idRoutingCache::Size( void ) const {
@@ -212,6 +222,20 @@ void idAASLocal::SetupRoutingCache( void ) {
 
 	cacheListStart = cacheListEnd = NULL;
 	totalCacheMemory = 0;
+	queuedCacheMemory = 0;
+
+	numCacheHits = 0;
+	numCacheStaleHits = 0;
+	numAreaCacheMisses = 0;
+	numPortalCacheMisses = 0;
+	areaCacheMsec = 0.0;
+	portalCacheMsec = 0.0;
+	numCacheUpdates = 0;
+	cacheUpdateMsec = 0.0;
+
+	routeResultFrame = -1;
+	numRouteQueries = 0;
+	numRouteQueriesShared = 0;
 }
 
 /*
@@ -237,7 +261,7 @@ void idAASLocal::DeleteClusterCache( int clusterNum ) {
 idAASLocal::DeletePortalCache
 ============
 */
-void idAASLocal::DeletePortalCache( void ) {
+void idAASLocal::DeletePortalCache( void ) const {
 	int i;
 	idRoutingCache *cache;
 
@@ -258,6 +282,8 @@ idAASLocal::ShutdownRoutingCache
 void idAASLocal::ShutdownRoutingCache( void ) {
 	int i;
 
+	FinishRoutingCacheUpdates();
+
 	for ( i = 0; i < file->GetNumClusters(); i++ ) {
 		DeleteClusterCache( i );
 	}
@@ -279,6 +305,10 @@ void idAASLocal::ShutdownRoutingCache( void ) {
 
 	cacheListStart = cacheListEnd = NULL;
 	totalCacheMemory = 0;
+	queuedCacheMemory = 0;
+
+	routeResults.Clear();
+	routeResultHash.Free();
 }
 
 /*
@@ -330,6 +360,13 @@ void idAASLocal::RoutingStats( void ) const {
 	gameLocal.Printf( "%6d area travel times (%d KB)\n", numAreaTravelTimes, ( numAreaTravelTimes * sizeof( unsigned short ) ) >> 10 );
 	gameLocal.Printf( "%6d area cache entries (%d KB)\n", areaCacheIndexSize, ( areaCacheIndexSize * sizeof( idRoutingCache * ) ) >> 10 );
 	gameLocal.Printf( "%6d portal cache entries (%d KB)\n", portalCacheIndexSize, ( portalCacheIndexSize * sizeof( idRoutingCache * ) ) >> 10 );
+	gameLocal.Printf( "%6d cache hits\n", numCacheHits );
+	gameLocal.Printf( "%6d cache hits waiting for an update\n", numCacheStaleHits );
+	gameLocal.Printf( "%6d area cache misses (%1.2f ms)\n", numAreaCacheMisses, areaCacheMsec );
+	gameLocal.Printf( "%6d portal cache misses (%1.2f ms including area cache)\n", numPortalCacheMisses, portalCacheMsec );
+	gameLocal.Printf( "%6d area cache updated in jobs (%1.2f ms)\n", numCacheUpdates, cacheUpdateMsec );
+	gameLocal.Printf( "%6d area cache waiting for an update (%d KB)\n", cacheUpdates.Num(), queuedCacheMemory >> 10 );
+	gameLocal.Printf( "%6d route queries (%d shared)\n", numRouteQueries, numRouteQueriesShared );
 }
 
 /*
@@ -340,6 +377,25 @@ idAASLocal::RemoveRoutingCacheUsingArea
 void idAASLocal::RemoveRoutingCacheUsingArea( int areaNum ) {
 	int clusterNum;
 
+	ClearRouteResults();
+
+	if ( aas_routingJobs.GetBool() && jobSystem->NumThreads() > 1 ) {
+		// keep using the current cache until the background jobs recalculated it
+		clusterNum = file->GetArea( areaNum ).cluster;
+		if ( clusterNum > 0 ) {
+			QueueClusterCacheUpdates( clusterNum );
+		}
+		else {
+			QueueClusterCacheUpdates( file->GetPortal( -clusterNum ).clusters[0] );
+			QueueClusterCacheUpdates( file->GetPortal( -clusterNum ).clusters[1] );
+		}
+		// the portal cache is removed when the updates are published
+		if ( !cacheUpdates.Num() ) {
+			DeletePortalCache();
+		}
+		return;
+	}
+
 	clusterNum = file->GetArea( areaNum ).cluster;
 	if ( clusterNum > 0 ) {
 		// remove all the cache in the cluster the area is in
@@ -353,6 +409,114 @@ void idAASLocal::RemoveRoutingCacheUsingArea( int areaNum ) {
 	DeletePortalCache();
 }
 
+/*
+============
+idAASLocal::QueueClusterCacheUpdates
+
+  Queues a background update for all the area cache in the cluster.
+  AI keep routing with the old travel times until the update is published.
+============
+*/
+void idAASLocal::QueueClusterCacheUpdates( int clusterNum ) {
+	int i;
+	idRoutingCache *cache;
+
+	for ( i = 0; i < file->GetCluster( clusterNum ).numReachableAreas; i++ ) {
+		for ( cache = areaCacheIndex[clusterNum][i]; cache; cache = cache->next ) {
+			if ( cache->updateState == ROUTINGCACHE_QUEUED ) {
+				continue;
+			}
+			// the second set of buffers only counts towards the published cache once it is swapped in
+			cache->nextReachabilities = new byte[cache->size];
+			cache->nextTravelTimes = new unsigned short[cache->size];
+			queuedCacheMemory += cache->size * ( sizeof( cache->reachabilities[0] ) + sizeof( cache->travelTimes[0] ) );
+			cache->updateState = ROUTINGCACHE_QUEUED;
+			cacheUpdates.Append( cache );
+		}
+	}
+}
+
+/*
+============
+idAASLocal::RoutingCacheUpdateJob
+============
+*/
+void idAASLocal::RoutingCacheUpdateJob( void *data, int first, int last ) {
+	const idAASLocal *aas = (const idAASLocal *) data;
+	idRoutingUpdate *update;
+	idRoutingCache *cache;
+	idTimer timer;
+	int i;
+
+	timer.Start();
+
+	for ( i = first; i < last; i++ ) {
+		cache = aas->cacheUpdates[i];
+		update = (idRoutingUpdate *) Mem_ClearedAlloc( cache->size * sizeof( idRoutingUpdate ) );
+		memset( cache->nextReachabilities, 0, cache->size * sizeof( cache->nextReachabilities[0] ) );
+		memset( cache->nextTravelTimes, 0, cache->size * sizeof( cache->nextTravelTimes[0] ) );
+		aas->UpdateAreaRoutingCache( cache, update, cache->nextTravelTimes, cache->nextReachabilities );
+		Mem_Free( update );
+	}
+
+	timer.Stop();
+
+	aas->cacheUpdateLock.Lock();
+	aas->cacheUpdateMsec += timer.Milliseconds();
+	aas->cacheUpdateLock.Unlock();
+}
+
+/*
+============
+idAASLocal::StartRoutingCacheUpdates
+
+  The jobs read the travel flags of the areas and reachabilities so they
+  are only started after all routing state changes have been made.
+============
+*/
+void idAASLocal::StartRoutingCacheUpdates( void ) {
+	if ( cacheUpdates.Num() ) {
+		jobSystem->SubmitRange( RoutingCacheUpdateJob, this, cacheUpdates.Num(), 0, &cacheUpdateCounter );
+	}
+}
+
+/*
+============
+idAASLocal::FinishRoutingCacheUpdates
+
+  Waits for the background jobs and publishes the new travel times.
+  The portal cache is built from the area cache so it is removed and
+  recalculated when needed.
+============
+*/
+void idAASLocal::FinishRoutingCacheUpdates( void ) const {
+	int i;
+	idRoutingCache *cache;
+
+	if ( !cacheUpdates.Num() ) {
+		return;
+	}
+
+	jobSystem->Wait( &cacheUpdateCounter );
+
+	for ( i = 0; i < cacheUpdates.Num(); i++ ) {
+		cache = cacheUpdates[i];
+		delete [] cache->reachabilities;
+		delete [] cache->travelTimes;
+		cache->reachabilities = cache->nextReachabilities;
+		cache->travelTimes = cache->nextTravelTimes;
+		cache->nextReachabilities = NULL;
+		cache->nextTravelTimes = NULL;
+		cache->updateState = ROUTINGCACHE_VALID;
+	}
+	numCacheUpdates += cacheUpdates.Num();
+	cacheUpdates.Clear();
+	queuedCacheMemory = 0;
+
+	DeletePortalCache();
+	ClearRouteResults();
+}
+
 /*
 ============
 idAASLocal::DisableArea
@@ -434,6 +598,7 @@ idAASLocal::SetAreaState
 */
 bool idAASLocal::SetAreaState( const idBounds &bounds, const int areaContents, bool disabled ) {
 	idBounds expBounds;
+	bool foundClusterPortal;
 
 	if ( !file ) {
 		return false;
@@ -442,8 +607,14 @@ bool idAASLocal::SetAreaState( const idBounds &bounds, const int areaContents, b
 	expBounds[0] = bounds[0] - file->GetSettings().boundingBoxes[0][1];
 	expBounds[1] = bounds[1] - file->GetSettings().boundingBoxes[0][0];
 
+	FinishRoutingCacheUpdates();
+
 	// find all areas within or touching the bounds with the given contents and disable/enable them for routing
-	return SetAreaState_r( 1, expBounds, areaContents, disabled );
+	foundClusterPortal = SetAreaState_r( 1, expBounds, areaContents, disabled );
+
+	StartRoutingCacheUpdates();
+
+	return foundClusterPortal;
 }
 
 /*
@@ -545,7 +716,9 @@ aasHandle_t idAASLocal::AddObstacle( const idBounds &bounds ) {
 	obstacle->bounds[0] = bounds[0] - file->GetSettings().boundingBoxes[0][1];
 	obstacle->bounds[1] = bounds[1] - file->GetSettings().boundingBoxes[0][0];
 	GetBoundsAreas_r( 1, obstacle->bounds, obstacle->areas );
+	FinishRoutingCacheUpdates();
 	SetObstacleState( obstacle, true );
+	StartRoutingCacheUpdates();
 
 	obstacleList.Append( obstacle );
 	return obstacleList.Num() - 1;
@@ -561,7 +734,9 @@ void idAASLocal::RemoveObstacle( const aasHandle_t handle ) {
 		return;
 	}
 	if ( ( handle >= 0 ) && ( handle < obstacleList.Num() ) ) {
+		FinishRoutingCacheUpdates();
 		SetObstacleState( obstacleList[handle], false );
+		StartRoutingCacheUpdates();
 
 		delete obstacleList[handle];
 		obstacleList.RemoveIndex( handle );
@@ -580,11 +755,13 @@ void idAASLocal::RemoveAllObstacles( void ) {
 		return;
 	}
 
+	FinishRoutingCacheUpdates();
 	for ( i = 0; i < obstacleList.Num(); i++ ) {
 		SetObstacleState( obstacleList[i], false );
 		delete obstacleList[i];
 	}
 	obstacleList.Clear();
+	StartRoutingCacheUpdates();
 }
 
 /*
@@ -648,6 +825,12 @@ void idAASLocal::DeleteOldestCache( void ) const {
 
 	assert( cacheListStart );
 
+	// the jobs write to the queued cache so publish the updates first
+	if ( cacheListStart->updateState == ROUTINGCACHE_QUEUED ) {
+		FinishRoutingCacheUpdates();
+		return;
+	}
+
 	// unlink the oldest cache
 	cache = cacheListStart;
 	UnlinkCache( cache );
@@ -709,6 +892,18 @@ idAASLocal::UpdateAreaRoutingCache
 ============
 */
 void idAASLocal::UpdateAreaRoutingCache( idRoutingCache *areaCache ) const {
+	UpdateAreaRoutingCache( areaCache, areaUpdate, areaCache->travelTimes, areaCache->reachabilities );
+}
+
+/*
+============
+idAASLocal::UpdateAreaRoutingCache
+
+  Calculates the travel times for the area cache into the given buffers.
+  Only reads the routing state so it can run in a background job with its own update memory.
+============
+*/
+void idAASLocal::UpdateAreaRoutingCache( const idRoutingCache *areaCache, idRoutingUpdate *update, unsigned short *travelTimes, byte *reachabilities ) const {
 	int i, nextAreaNum, cluster, badTravelFlags, clusterAreaNum, numReachableAreas;
 	unsigned short t, startAreaTravelTimes[MAX_REACH_PER_AREA];
 	idRoutingUpdate *updateListStart, *updateListEnd, *curUpdate, *nextUpdate;
@@ -724,12 +919,12 @@ void idAASLocal::UpdateAreaRoutingCache( idRoutingCache *areaCache ) const {
 		return;
 	}
 
-	areaCache->travelTimes[clusterAreaNum] = areaCache->startTravelTime;
+	travelTimes[clusterAreaNum] = areaCache->startTravelTime;
 	badTravelFlags = ~areaCache->travelFlags;
 	memset( startAreaTravelTimes, 0, sizeof( startAreaTravelTimes ) );
 
 	// initialize first update
-	curUpdate = &areaUpdate[clusterAreaNum];
+	curUpdate = &update[clusterAreaNum];
 	curUpdate->areaNum = areaCache->areaNum;
 	curUpdate->areaTravelTimes = startAreaTravelTimes;
 	curUpdate->tmpTravelTime = areaCache->startTravelTime;
@@ -787,11 +982,11 @@ void idAASLocal::UpdateAreaRoutingCache( idRoutingCache *areaCache ) const {
 			// plus the travel time of the reachability towards the next area
 			t = curUpdate->tmpTravelTime + curUpdate->areaTravelTimes[i] + reach->travelTime;
 
-			if ( !areaCache->travelTimes[clusterAreaNum] || t < areaCache->travelTimes[clusterAreaNum] ) {
+			if ( !travelTimes[clusterAreaNum] || t < travelTimes[clusterAreaNum] ) {
 
-				areaCache->travelTimes[clusterAreaNum] = t;
-				areaCache->reachabilities[clusterAreaNum] = reach->number; // reversed reachability used to get into this area
-				nextUpdate = &areaUpdate[clusterAreaNum];
+				travelTimes[clusterAreaNum] = t;
+				reachabilities[clusterAreaNum] = reach->number; // reversed reachability used to get into this area
+				nextUpdate = &update[clusterAreaNum];
 				nextUpdate->areaNum = nextAreaNum;
 				nextUpdate->tmpTravelTime = t;
 				nextUpdate->areaTravelTimes = reach->areaTravelTimes;
@@ -842,6 +1037,8 @@ idRoutingCache *idAASLocal::GetAreaRoutingCache( int clusterNum, int areaNum, in
 	}
 	// if no cache found
 	if ( !cache ) {
+		idTimer timer;
+		timer.Start();
 		cache = new idRoutingCache( file->GetCluster( clusterNum ).numReachableAreas );
 		cache->type = CACHETYPE_AREA;
 		cache->cluster = clusterNum;
@@ -855,6 +1052,13 @@ idRoutingCache *idAASLocal::GetAreaRoutingCache( int clusterNum, int areaNum, in
 		}
 		areaCacheIndex[clusterNum][clusterAreaNum] = cache;
 		UpdateAreaRoutingCache( cache );
+		timer.Stop();
+		areaCacheMsec += timer.Milliseconds();
+		numAreaCacheMisses++;
+	} else if ( cache->updateState == ROUTINGCACHE_QUEUED ) {
+		numCacheStaleHits++;
+	} else {
+		numCacheHits++;
 	}
 	LinkCache( cache );
 	return cache;
@@ -968,6 +1172,8 @@ idRoutingCache *idAASLocal::GetPortalRoutingCache( int clusterNum, int areaNum,
 	}
 	// if no cache found
 	if ( !cache ) {
+		idTimer timer;
+		timer.Start();
 		cache = new idRoutingCache( file->GetNumPortals() );
 		cache->type = CACHETYPE_PORTAL;
 		cache->cluster = clusterNum;
@@ -981,6 +1187,11 @@ idRoutingCache *idAASLocal::GetPortalRoutingCache( int clusterNum, int areaNum,
 		}
 		portalCacheIndex[areaNum] = cache;
 		UpdatePortalRoutingCache( cache );
+		timer.Stop();
+		portalCacheMsec += timer.Milliseconds();
+		numPortalCacheMisses++;
+	} else {
+		numCacheHits++;
 	}
 	LinkCache( cache );
 	return cache;
@@ -988,40 +1199,31 @@ idRoutingCache *idAASLocal::GetPortalRoutingCache( int clusterNum, int areaNum,
 
 /*
 ============
-idAASLocal::RouteToGoalArea
+idAASLocal::FindRoute
+
+  Finds the route from the start area towards the goal area. The travel time from the
+  origin in the start area isn't known here so both the best reachability within the
+  cluster and the best reachability through the cluster portals are stored.
 ============
 */
-bool idAASLocal::RouteToGoalArea( int areaNum, const idVec3 origin, int goalAreaNum, int travelFlags, int &travelTime, idReachability **reach ) const {
-	int clusterNum, goalClusterNum, portalNum, i, clusterAreaNum;
+void idAASLocal::FindRoute( idRoutingResult &route ) const {
+	int clusterNum, goalClusterNum, portalNum, i, clusterAreaNum, areaNum, goalAreaNum, travelFlags;
 	unsigned short int t, bestTime;
 	const aasPortal_t *portal;
 	const aasCluster_t *cluster;
 	idRoutingCache *areaCache, *portalCache, *clusterCache;
 	idReachability *bestReach, *r, *nextr;
 
-	travelTime = 0;
-	*reach = NULL;
-
-	if ( !file ) {
-		return false;
-	}
-
-	if ( areaNum == goalAreaNum ) {
-		return true;
-	}
-
-	if ( areaNum <= 0 || areaNum >= file->GetNumAreas() ) {
-		gameLocal.Printf( "RouteToGoalArea: areaNum %d out of range\n", areaNum );
-		return false;
-	}
-	if ( goalAreaNum <= 0 || goalAreaNum >= file->GetNumAreas() ) {
-		gameLocal.Printf( "RouteToGoalArea: goalAreaNum %d out of range\n", goalAreaNum );
-		return false;
-	}
+	areaNum = route.areaNum;
+	goalAreaNum = route.goalAreaNum;
+	travelFlags = route.travelFlags;
 
-	while( totalCacheMemory > MAX_ROUTING_CACHE_MEMORY ) {
-		DeleteOldestCache();
-	}
+	route.found = false;
+	route.startIsPortal = false;
+	route.clusterReach = NULL;
+	route.clusterTravelTime = 0;
+	route.portalReach = NULL;
+	route.portalTravelTime = 0;
 
 	clusterNum = file->GetArea( areaNum ).cluster;
 	goalClusterNum = file->GetArea( goalAreaNum ).cluster;
@@ -1036,14 +1238,13 @@ bool idAASLocal::RouteToGoalArea( int areaNum, const idVec3 origin, int goalArea
 		}
 		// get the portal routing cache
 		portalCache = GetPortalRoutingCache( goalClusterNum, goalAreaNum, travelFlags );
-		*reach = GetAreaReachability( areaNum, portalCache->reachabilities[-clusterNum] );
-		travelTime = portalCache->travelTimes[-clusterNum] + AreaTravelTime( areaNum, origin, (*reach)->start );
-		return true;
+		route.found = true;
+		route.startIsPortal = true;
+		route.portalReach = GetAreaReachability( areaNum, portalCache->reachabilities[-clusterNum] );
+		route.portalTravelTime = portalCache->travelTimes[-clusterNum];
+		return;
 	}
 
-	bestTime = 0;
-	bestReach = NULL;
-
 	// check if the goal area is a portal of the source area cluster
 	if ( goalClusterNum < 0 ) {
 		portal = &file->GetPortal( -goalClusterNum );
@@ -1057,8 +1258,8 @@ bool idAASLocal::RouteToGoalArea( int areaNum, const idVec3 origin, int goalArea
 		clusterCache = GetAreaRoutingCache( clusterNum, goalAreaNum, travelFlags );
 		clusterAreaNum = ClusterAreaNum( clusterNum, areaNum );
 		if ( clusterCache->travelTimes[clusterAreaNum] ) {
-			bestReach = GetAreaReachability( areaNum, clusterCache->reachabilities[clusterAreaNum] );
-			bestTime = clusterCache->travelTimes[clusterAreaNum] + AreaTravelTime( areaNum, origin, bestReach->start );
+			route.clusterReach = GetAreaReachability( areaNum, clusterCache->reachabilities[clusterAreaNum] );
+			route.clusterTravelTime = clusterCache->travelTimes[clusterAreaNum];
 		}
 		else {
 			clusterCache = NULL;
@@ -1086,9 +1287,12 @@ bool idAASLocal::RouteToGoalArea( int areaNum, const idVec3 origin, int goalArea
 	clusterAreaNum = ClusterAreaNum( clusterNum, areaNum );
 	// if the area is not a reachable area
 	if ( clusterAreaNum >= cluster->numReachableAreas) {
-		return false;
+		return;
 	}
 
+	bestTime = 0;
+	bestReach = NULL;
+
 	// find the portal of the source area cluster leading towards the goal area
 	for ( i = 0; i < cluster->numPortals; i++ ) {
 		portalNum = file->GetPortalIndex( cluster->firstPortal + i );
@@ -1132,6 +1336,123 @@ bool idAASLocal::RouteToGoalArea( int areaNum, const idVec3 origin, int goalArea
 		}
 	}
 
+	route.found = true;
+	route.portalReach = bestReach;
+	route.portalTravelTime = bestTime;
+}
+
+/*
+============
+idAASLocal::GetRoute
+
+  AI chasing the same target ask for the same routes many times per frame.
+  The routes are kept until the next frame or until the routing state changes.
+============
+*/
+const idRoutingResult &idAASLocal::GetRoute( int areaNum, int goalAreaNum, int travelFlags ) const {
+	int i, hashKey;
+
+	if ( routeResultFrame != gameLocal.framenum ) {
+		ClearRouteResults();
+		routeResultFrame = gameLocal.framenum;
+	}
+
+	numRouteQueries++;
+
+	hashKey = routeResultHash.GenerateKey( areaNum, goalAreaNum );
+	for ( i = routeResultHash.First( hashKey ); i >= 0; i = routeResultHash.Next( i ) ) {
+		const idRoutingResult &route = routeResults[i];
+		if ( route.areaNum == areaNum && route.goalAreaNum == goalAreaNum && route.travelFlags == travelFlags ) {
+			numRouteQueriesShared++;
+			return route;
+		}
+	}
+
+	i = routeResults.Append( idRoutingResult() );
+	routeResults[i].areaNum = areaNum;
+	routeResults[i].goalAreaNum = goalAreaNum;
+	routeResults[i].travelFlags = travelFlags;
+	FindRoute( routeResults[i] );
+	routeResultHash.Add( hashKey, i );
+
+	return routeResults[i];
+}
+
+/*
+============
+idAASLocal::ClearRouteResults
+============
+*/
+void idAASLocal::ClearRouteResults( void ) const {
+	routeResults.SetNum( 0, false );
+	routeResultHash.Clear();
+}
+
+/*
+============
+idAASLocal::RouteToGoalArea
+============
+*/
+bool idAASLocal::RouteToGoalArea( int areaNum, const idVec3 origin, int goalAreaNum, int travelFlags, int &travelTime, idReachability **reach ) const {
+	unsigned short int bestTime;
+	idReachability *bestReach;
+
+	travelTime = 0;
+	*reach = NULL;
+
+	if ( !file ) {
+		return false;
+	}
+
+	if ( areaNum == goalAreaNum ) {
+		return true;
+	}
+
+	if ( areaNum <= 0 || areaNum >= file->GetNumAreas() ) {
+		gameLocal.Printf( "RouteToGoalArea: areaNum %d out of range\n", areaNum );
+		return false;
+	}
+	if ( goalAreaNum <= 0 || goalAreaNum >= file->GetNumAreas() ) {
+		gameLocal.Printf( "RouteToGoalArea: goalAreaNum %d out of range\n", goalAreaNum );
+		return false;
+	}
+
+	// publish the background updates as soon as they are all done
+	if ( cacheUpdates.Num() && cacheUpdateCounter.IsDone() ) {
+		FinishRoutingCacheUpdates();
+	}
+
+	while( totalCacheMemory > MAX_ROUTING_CACHE_MEMORY ) {
+		DeleteOldestCache();
+	}
+
+	const idRoutingResult &route = GetRoute( areaNum, goalAreaNum, travelFlags );
+
+	if ( !route.found ) {
+		return false;
+	}
+
+	if ( route.startIsPortal ) {
+		*reach = route.portalReach;
+		travelTime = route.portalTravelTime + AreaTravelTime( areaNum, origin, (*reach)->start );
+		return true;
+	}
+
+	bestTime = 0;
+	bestReach = NULL;
+
+	// the route within the cluster includes the travel time from the origin towards the reachability
+	if ( route.clusterReach ) {
+		bestReach = route.clusterReach;
+		bestTime = route.clusterTravelTime + AreaTravelTime( areaNum, origin, bestReach->start );
+	}
+
+	// if the route through a portal is better
+	if ( route.portalReach && ( !bestTime || route.portalTravelTime < bestTime ) ) {
+		bestReach = route.portalReach;
+		bestTime = route.portalTravelTime;
+	}
+
 	if ( !bestReach ) {
 		return false;
 	}
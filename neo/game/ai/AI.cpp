@@ -72,6 +72,9 @@ idMoveState::idMoveState() {
 	lastMoveOrigin		= vec3_origin;
 	lastMoveTime		= 0;
 	anim				= 0;
+	pathGoal			= vec3_origin;
+	pathGoalAreaNum		= 0;
+	pathTime			= 0;
 }
 
 /*
@@ -126,6 +129,11 @@ void idMoveState::Restore( idRestoreGame *savefile ) {
 	savefile->ReadVec3( lastMoveOrigin );
 	savefile->ReadInt( lastMoveTime );
 	savefile->ReadInt( anim );
+
+	// the path is recalculated after loading
+	pathGoal			= vec3_origin;
+	pathGoalAreaNum		= 0;
+	pathTime			= 0;
 }
 
 /*
@@ -2188,6 +2196,27 @@ bool idAI::NewWanderDir( const idVec3 &dest ) {
 	return false;
 }
 
+/*
+=====================
+idAI::PathBudgetAvailable
+
+  Only ai_pathBudget AI recalculate their path each frame. The others keep
+  moving towards the goal of their last path as long as that path is recent,
+  leads to the same area and the goal hasn't been reached yet.
+=====================
+*/
+bool idAI::PathBudgetAvailable( const idVec3 &org ) {
+	if ( ai_pathBudget.GetInteger() > 0 && gameLocal.NumAIPaths() >= ai_pathBudget.GetInteger() ) {
+		if ( move.pathGoalAreaNum == move.toAreaNum && gameLocal.time - move.pathTime < AI_PATH_MAX_AGE &&
+				( move.pathGoal - org ).LengthSqr() > Square( AI_PATH_MIN_DIST ) ) {
+			return false;
+		}
+	}
+
+	gameLocal.AddAIPath();
+	return true;
+}
+
 /*
 =====================
 idAI::GetMovePos
@@ -2246,13 +2275,24 @@ bool idAI::GetMovePos( idVec3 &seekPos ) {
 		}
 
 		if ( aas && move.toAreaNum ) {
-			areaNum	= PointReachableAreaNum( org );
-			if ( PathToGoal( path, areaNum, org, move.toAreaNum, move.moveDest ) ) {
-				seekPos = path.moveGoal;
+			if ( !PathBudgetAvailable( org ) ) {
+				// keep moving towards the last path goal until there's budget left
+				seekPos = move.pathGoal;
 				result = true;
 				move.nextWanderTime = 0;
 			} else {
-				AI_DEST_UNREACHABLE = true;
+				areaNum	= PointReachableAreaNum( org );
+				if ( PathToGoal( path, areaNum, org, move.toAreaNum, move.moveDest ) ) {
+					seekPos = path.moveGoal;
+					result = true;
+					move.nextWanderTime = 0;
+					move.pathGoal = path.moveGoal;
+					move.pathGoalAreaNum = move.toAreaNum;
+					move.pathTime = gameLocal.time;
+				} else {
+					AI_DEST_UNREACHABLE = true;
+					move.pathGoalAreaNum = 0;
+				}
 			}
 		}
 	}
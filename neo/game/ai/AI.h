@@ -44,6 +44,8 @@ const float	AI_SEEK_PREDICTION			= 0.3f;
 const float	AI_FLY_DAMPENING			= 0.15f;
 const float	AI_HEARING_RANGE			= 2048.0f;
 const int	DEFAULT_FLY_OFFSET			= 68;
+const int	AI_PATH_MAX_AGE				= 300;		// msec a path goal is used when over the path budget
+const float	AI_PATH_MIN_DIST			= 32.0f;	// recalculate the path when this close to the path goal
 
 #define ATTACK_IGNORE			0
 #define ATTACK_ON_DAMAGE		1
@@ -193,6 +195,9 @@ public:
 	idVec3					lastMoveOrigin;
 	int						lastMoveTime;
 	int						anim;
+	idVec3					pathGoal;			// last path goal found by GetMovePos, not saved
+	int						pathGoalAreaNum;
+	int						pathTime;
 };
 
 class idAASFindCover : public idAASCallback {
@@ -459,6 +464,7 @@ protected:
 	float					TravelDistance( const idVec3 &start, const idVec3 &end ) const;
 	int						PointReachableAreaNum( const idVec3 &pos, const float boundsScale = 2.0f ) const;
 	bool					PathToGoal( aasPath_t &path, int areaNum, const idVec3 &origin, int goalAreaNum, const idVec3 &goalOrigin ) const;
+	bool					PathBudgetAvailable( const idVec3 &org );
 	void					DrawRoute( void ) const;
 	bool					GetMovePos( idVec3 &seekPos );
 	bool					MoveDone( void ) const;
@@ -50,6 +50,7 @@ instancing of objects.
 static idTypeInfo				*typelist = NULL;
 static idHierarchy<idTypeInfo>	classHierarchy;
 static int						eventCallbackMemory	= 0;
+static idSysSpinLock			eventAllocLock;		// entities that think in parallel post events at the same time
 
 /*
 ================
@@ -649,6 +650,18 @@ bool idClass::PostEventArgs( const idEventDef *ev, int time, int numargs, ... )
 		return true;
 	}
 
+	if ( threadThinkIsland ) {
+		eventAllocLock.Lock();
+		va_start( args, numargs );
+		event = idEvent::Alloc( ev, numargs, args );
+		va_end( args );
+		eventAllocLock.Unlock();
+
+		// the event queue is ordered, schedule the event when the island is done
+		gameLocal.DeferThinkEvent( event, this, c, time );
+		return true;
+	}
+
 	va_start( args, numargs );
 	event = idEvent::Alloc( ev, numargs, args );
 	va_end( args );
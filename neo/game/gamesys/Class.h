@@ -247,6 +247,10 @@ public:
 	static idTypeInfo *			GetType( int num );
 
 private:
+	friend class idEvent;
+
+	idLinkList<idEvent>			eventList;		// events scheduled on this object, so cancelling doesn't walk the whole queue
+
 	classSpawnFunc_t			CallSpawnFunc( idTypeInfo *cls );
 
 	bool						PostEventArgs( const idEventDef *ev, int time, int numargs, ... );
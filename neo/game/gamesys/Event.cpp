@@ -214,13 +214,31 @@ const idEventDef *idEventDef::FindEvent( const char *name ) {
 ***********************************************************************/
 
 static idLinkList<idEvent> FreeEvents;
-static idLinkList<idEvent> EventQueue;
+static idEvent *EventQueue[ MAX_EVENTS ];		// binary min-heap ordered by idEvent::IsBefore
+static int numQueuedEvents;
+static unsigned int eventSequence;
+static int numServicedEvents;
 static idEvent EventPool[ MAX_EVENTS ];
 
 bool idEvent::initialized = false;
 
 idDynamicBlockAlloc<byte, 16 * 1024, 256>	idEvent::eventDataAllocator;
 
+/*
+================
+idEvent::idEvent
+================
+*/
+idEvent::idEvent() {
+	eventdef	= NULL;
+	data		= NULL;
+	time		= 0;
+	object		= NULL;
+	typeinfo	= NULL;
+	sequence	= 0;
+	heapIndex	= -1;
+}
+
 /*
 ================
 idEvent::~idEvent()
@@ -365,6 +383,8 @@ void idEvent::Free( void ) {
 		data = NULL;
 	}
 
+	Unschedule();
+
 	eventdef	= NULL;
 	time		= 0;
 	object		= NULL;
@@ -376,35 +396,121 @@ void idEvent::Free( void ) {
 
 /*
 ================
-idEvent::Schedule
+idEvent::HeapMoveUp
 ================
 */
-void idEvent::Schedule( idClass *obj, const idTypeInfo *type, int time ) {
+void idEvent::HeapMoveUp( int index ) {
+	idEvent *event;
+	int parent;
+
+	event = EventQueue[ index ];
+	while( index > 0 ) {
+		parent = ( index - 1 ) >> 1;
+		if ( !event->IsBefore( EventQueue[ parent ] ) ) {
+			break;
+		}
+		EventQueue[ index ] = EventQueue[ parent ];
+		EventQueue[ index ]->heapIndex = index;
+		index = parent;
+	}
+	EventQueue[ index ] = event;
+	event->heapIndex = index;
+}
+
+/*
+================
+idEvent::HeapMoveDown
+================
+*/
+void idEvent::HeapMoveDown( int index ) {
 	idEvent *event;
+	int child;
+
+	event = EventQueue[ index ];
+	while( 1 ) {
+		child = ( index << 1 ) + 1;
+		if ( child >= numQueuedEvents ) {
+			break;
+		}
+		if ( child + 1 < numQueuedEvents && EventQueue[ child + 1 ]->IsBefore( EventQueue[ child ] ) ) {
+			child++;
+		}
+		if ( !EventQueue[ child ]->IsBefore( event ) ) {
+			break;
+		}
+		EventQueue[ index ] = EventQueue[ child ];
+		EventQueue[ index ]->heapIndex = index;
+		index = child;
+	}
+	EventQueue[ index ] = event;
+	event->heapIndex = index;
+}
+
+/*
+================
+idEvent::Unschedule
+
+Removes the event from the queue and from its object's event list.
+================
+*/
+void idEvent::Unschedule( void ) {
+	idEvent *last;
+	int index;
+
+	objectNode.Remove();
 
+	index = heapIndex;
+	if ( index < 0 ) {
+		return;
+	}
+	heapIndex = -1;
+
+	assert( EventQueue[ index ] == this );
+	numQueuedEvents--;
+	if ( index == numQueuedEvents ) {
+		return;
+	}
+
+	// move the last event into the hole and restore the heap order
+	last = EventQueue[ numQueuedEvents ];
+	EventQueue[ index ] = last;
+	last->heapIndex = index;
+	if ( index > 0 && last->IsBefore( EventQueue[ ( index - 1 ) >> 1 ] ) ) {
+		HeapMoveUp( index );
+	} else {
+		HeapMoveDown( index );
+	}
+}
+
+/*
+================
+idEvent::Schedule
+================
+*/
+void idEvent::Schedule( idClass *obj, const idTypeInfo *type, int time ) {
 	assert( initialized );
 	if ( !initialized ) {
 		return;
 	}
 
+	Unschedule();
+
 	object = obj;
 	typeinfo = type;
 
 	// wraps after 24 days...like I care. ;)
 	this->time = gameLocal.time + time;
+	sequence = eventSequence++;
 
 	eventNode.Remove();
 
-	event = EventQueue.Next();
-	while( ( event != NULL ) && ( this->time >= event->time ) ) {
-		event = event->eventNode.Next();
-	}
+	objectNode.SetOwner( this );
+	objectNode.AddToEnd( obj->eventList );
 
-	if ( event ) {
-		eventNode.InsertBefore( event->eventNode );
-	} else {
-		eventNode.AddToEnd( EventQueue );
-	}
+	assert( numQueuedEvents < MAX_EVENTS );
+	EventQueue[ numQueuedEvents ] = this;
+	numQueuedEvents++;
+	HeapMoveUp( numQueuedEvents - 1 );
 }
 
 /*
@@ -420,12 +526,11 @@ void idEvent::CancelEvents( const idClass *obj, const idEventDef *evdef ) {
 		return;
 	}
 
-	for( event = EventQueue.Next(); event != NULL; event = next ) {
-		next = event->eventNode.Next();
-		if ( event->object == obj ) {
-			if ( !evdef || ( evdef == event->eventdef ) ) {
-				event->Free();
-			}
+	for( event = obj->eventList.Next(); event != NULL; event = next ) {
+		next = event->objectNode.Next();
+		assert( event->object == obj );
+		if ( !evdef || ( evdef == event->eventdef ) ) {
+			event->Free();
 		}
 	}
 }
@@ -442,12 +547,15 @@ void idEvent::ClearEventList( void ) {
 	// initialize lists
 	//
 	FreeEvents.Clear();
-	EventQueue.Clear();
+	numQueuedEvents = 0;
+	eventSequence = 0;
+	numServicedEvents = 0;
    
 	// 
 	// add the events to the free list
 	//
 	for( i = 0; i < MAX_EVENTS; i++ ) {
+		EventPool[ i ].heapIndex = -1;
 		EventPool[ i ].Free();
 	}
 }
@@ -471,8 +579,8 @@ void idEvent::ServiceEvents( void ) {
 	const char  *materialName;
 
 	num = 0;
-	while( !EventQueue.IsListEmpty() ) {
-		event = EventQueue.Next();
+	while( numQueuedEvents > 0 ) {
+		event = EventQueue[ 0 ];
 		assert( event );
 
 		if ( event->time > gameLocal.time ) {
@@ -525,9 +633,9 @@ void idEvent::ServiceEvents( void ) {
 			}
 		}
 
-		// the event is removed from its list so that if then object
-		// is deleted, the event won't be freed twice
-		event->eventNode.Remove();
+		// the event is removed from the queue and its object's list so that
+		// if then object is deleted, the event won't be freed twice
+		event->Unschedule();
 		assert( event->object );
 		event->object->ProcessEventArgPtr( ev, args );
 
@@ -549,6 +657,28 @@ void idEvent::ServiceEvents( void ) {
 			gameLocal.Error( "Event overflow.  Possible infinite loop in script." );
 		}
 	}
+
+	numServicedEvents = num;
+}
+
+/*
+================
+idEvent::NumQueuedEvents
+================
+*/
+int idEvent::NumQueuedEvents( void ) {
+	return numQueuedEvents;
+}
+
+/*
+================
+idEvent::NumServicedEvents
+
+Number of events processed by the last ServiceEvents call.
+================
+*/
+int idEvent::NumServicedEvents( void ) {
+	return numServicedEvents;
 }
 
 /*
@@ -618,11 +748,20 @@ void idEvent::Save( idSaveGame *savefile ) {
 	byte *dataPtr;
 	bool validTrace;
 	const char	*format;
+	idList<idEvent *> sorted;
+	int j;
+
+	// write the events in the order they will be serviced
+	sorted.SetNum( numQueuedEvents );
+	for( j = 0; j < numQueuedEvents; j++ ) {
+		sorted[ j ] = EventQueue[ j ];
+	}
+	sorted.Sort( SortByTime );
 
-	savefile->WriteInt( EventQueue.Num() );
+	savefile->WriteInt( sorted.Num() );
 
-	event = EventQueue.Next();
-	while( event != NULL ) {
+	for( j = 0; j < sorted.Num(); j++ ) {
+		event = sorted[ j ];
 		savefile->WriteInt( event->time );
 		savefile->WriteString( event->eventdef->GetName() );
 		savefile->WriteString( event->typeinfo->classname );
@@ -666,7 +805,6 @@ void idEvent::Save( idSaveGame *savefile ) {
 			}
 		}
 		assert( size == event->eventdef->GetArgSize() );
-		event = event->eventNode.Next();
 	}
 }
 
@@ -692,7 +830,6 @@ void idEvent::Restore( idRestoreGame *savefile ) {
 
 		event = FreeEvents.Next();
 		event->eventNode.Remove();
-		event->eventNode.AddToEnd( EventQueue );
 
 		savefile->ReadInt( event->time );
 
@@ -712,6 +849,16 @@ void idEvent::Restore( idRestoreGame *savefile ) {
 
 		savefile->ReadObject( event->object );
 
+		// events are saved in service order, so the sequence keeps ties in the same order
+		event->sequence = eventSequence++;
+		if ( event->object ) {
+			event->objectNode.SetOwner( event );
+			event->objectNode.AddToEnd( event->object->eventList );
+		}
+		EventQueue[ numQueuedEvents ] = event;
+		numQueuedEvents++;
+		HeapMoveUp( numQueuedEvents - 1 );
+
 		// read the args
 		savefile->ReadInt( argsize );
 		if ( argsize != event->eventdef->GetArgSize() ) {
@@ -763,6 +910,21 @@ void idEvent::Restore( idRestoreGame *savefile ) {
 	}
 }
 
+/*
+================
+idEvent::SortByTime
+================
+*/
+int idEvent::SortByTime( idEvent * const *a, idEvent * const *b ) {
+	if ( ( *a )->IsBefore( *b ) ) {
+		return -1;
+	}
+	if ( ( *b )->IsBefore( *a ) ) {
+		return 1;
+	}
+	return 0;
+}
+
 /*
  ================
  idEvent::ReadTrace
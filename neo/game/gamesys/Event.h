@@ -95,15 +95,25 @@ private:
 	int							time;
 	idClass						*object;
 	const idTypeInfo			*typeinfo;
+	unsigned int				sequence;		// keeps events posted for the same time in FIFO order
+	int							heapIndex;		// index in the event queue heap, -1 when not scheduled
 
-	idLinkList<idEvent>			eventNode;
+	idLinkList<idEvent>			eventNode;		// free list
+	idLinkList<idEvent>			objectNode;		// events scheduled on the same object
 
 	static idDynamicBlockAlloc<byte, 16 * 1024, 256> eventDataAllocator;
 
+	bool						IsBefore( const idEvent *other ) const;
+	void						Unschedule( void );
+	static void					HeapMoveUp( int index );
+	static void					HeapMoveDown( int index );
+	static int					SortByTime( idEvent * const *a, idEvent * const *b );
+
 
 public:
 	static bool					initialized;
 
+								idEvent();
 								~idEvent();
 
 	static idEvent				*Alloc( const idEventDef *evdef, int numargs, va_list args );
@@ -116,6 +126,8 @@ public:
 	static void					CancelEvents( const idClass *obj, const idEventDef *evdef = NULL );
 	static void					ClearEventList( void );
 	static void					ServiceEvents( void );
+	static int					NumQueuedEvents( void );
+	static int					NumServicedEvents( void );
 	static void					Init( void );
 	static void					Shutdown( void );
 
@@ -136,6 +148,20 @@ ID_INLINE byte *idEvent::GetData( void ) {
 	return data;
 }
 
+/*
+================
+idEvent::IsBefore
+
+Events are ordered by time, events with the same time in the order they were scheduled.
+================
+*/
+ID_INLINE bool idEvent::IsBefore( const idEvent *other ) const {
+	if ( time != other->time ) {
+		return time < other->time;
+	}
+	return (int)( sequence - other->sequence ) < 0;
+}
+
 /*
 ================
 idEventDef::GetName
@@ -7,9 +7,9 @@
 
 	This file has been generated with the Type Info Generator v1.0 (c) 2004 id Software
 
-	1255 constants
-	123 enums
-	513 classes/structs/unions
+	1276 constants
+	125 enums
+	521 classes/structs/unions
 	37 templates
 	6 max inheritance level for 'idPlayer'
 
@@ -58,6 +58,8 @@ static constantInfo_t constantInfo[] = {
 	{ "int", "CPUID_SSE2", "128" },
 	{ "int", "CPUID_SSE3", "256" },
 	{ "int", "CPUID_ALTIVEC", "512" },
+	{ "int", "CPUID_AVX2", "1024" },
+	{ "int", "CPUID_FMA", "2048" },
 	{ "int", "CPUID_HTT", "4096" },
 	{ "int", "CPUID_CMOV", "8192" },
 	{ "int", "CPUID_FTZ", "16384" },
@@ -106,7 +108,7 @@ static constantInfo_t constantInfo[] = {
 	{ "int", "THREAD_NORMAL", "0" },
 	{ "int", "THREAD_ABOVE_NORMAL", "1" },
 	{ "int", "THREAD_HIGHEST", "2" },
-	{ "const int", "MAX_THREADS", "10" },
+	{ "const int", "MAX_THREADS", "32" },
 	{ "const int", "MAX_CRITICAL_SECTIONS", "4" },
 	{ "int", "CRITICAL_SECTION_ZERO", "0" },
 	{ "int", "CRITICAL_SECTION_ONE", "1" },
@@ -117,6 +119,7 @@ static constantInfo_t constantInfo[] = {
 	{ "int", "TRIGGER_EVENT_ONE", "1" },
 	{ "int", "TRIGGER_EVENT_TWO", "2" },
 	{ "int", "TRIGGER_EVENT_THREE", "3" },
+	{ "const int", "SIGNAL_WAIT_INFINITE", "-1" },
 	{ "const int", "MIXBUFFER_SAMPLES", "4096" },
 	{ "int", "SPEAKER_LEFT", "0" },
 	{ "int", "SPEAKER_RIGHT", "1" },
@@ -193,6 +196,14 @@ static constantInfo_t constantInfo[] = {
 	{ "const float", "DEFAULT_CURVE_MAX_ERROR_CD", "24.0" },
 	{ "const float", "DEFAULT_CURVE_MAX_LENGTH", "-1.0" },
 	{ "const float", "DEFAULT_CURVE_MAX_LENGTH_CD", "-1.0" },
+	{ "int", "DELTA_FIELD_BITS", "0" },
+	{ "int", "DELTA_FIELD_DELTA", "1" },
+	{ "int", "DELTA_FIELD_BYTE_COUNTER", "2" },
+	{ "int", "DELTA_FIELD_SHORT_COUNTER", "3" },
+	{ "int", "DELTA_FIELD_LONG_COUNTER", "4" },
+	{ "int", "DELTA_FIELD_STRING", "5" },
+	{ "int", "DELTA_FIELD_DATA", "6" },
+	{ "int", "DELTA_FIELD_DICT", "7" },
 	{ "int", "idMapPrimitive::TYPE_INVALID", "-1" },
 	{ "int", "idMapPrimitive::TYPE_BRUSH", "0" },
 	{ "int", "idMapPrimitive::TYPE_PATCH", "1" },
@@ -748,7 +759,7 @@ static constantInfo_t constantInfo[] = {
 	{ "int", "TEST_PARTICLE_MUZZLE", "2" },
 	{ "int", "TEST_PARTICLE_FLIGHT", "3" },
 	{ "int", "TEST_PARTICLE_SELECTED", "4" },
-	{ "const int", "GAME_API_VERSION", "8" },
+	{ "const int", "GAME_API_VERSION", "10" },
 	{ "const int", "INITIAL_RELEASE_BUILD_NUMBER", "1262" },
 	{ "int", "ev_error", "-1" },
 	{ "int", "ev_void", "0" },
@@ -938,6 +949,14 @@ static constantInfo_t constantInfo[] = {
 	{ "int", "idEventQueue::OUTOFORDER_IGNORE", "0" },
 	{ "int", "idEventQueue::OUTOFORDER_DROP", "1" },
 	{ "int", "idEventQueue::OUTOFORDER_SORT", "2" },
+	{ "int", "THINKCMD_ACTIVATE", "0" },
+	{ "int", "THINKCMD_REACTIVATE", "1" },
+	{ "int", "THINKCMD_DEACTIVATE", "2" },
+	{ "int", "THINKCMD_EVENT", "3" },
+	{ "int", "THINKCMD_COLLIDE", "4" },
+	{ "int", "THINKCMD_PRESENT", "5" },
+	{ "int", "THINKCMD_UPDATESOUND", "6" },
+	{ "int", "THINKCMD_CALL", "7" },
 	{ "static const int", "idGameLocal::msec", "16" },
 	{ "const static int", "idGameLocal::INITIAL_SPAWN_COUNT", "1" },
 	{ "int", "SND_CHANNEL_ANY", "0" },
@@ -1137,6 +1156,8 @@ static constantInfo_t constantInfo[] = {
 	{ "const float", "AI_FLY_DAMPENING", "0.15" },
 	{ "const float", "AI_HEARING_RANGE", "2048.0" },
 	{ "const int", "DEFAULT_FLY_OFFSET", "68" },
+	{ "const int", "AI_PATH_MAX_AGE", "300" },
+	{ "const float", "AI_PATH_MIN_DIST", "32.0" },
 	{ "int", "MOVETYPE_DEAD", "0" },
 	{ "int", "MOVETYPE_ANIM", "1" },
 	{ "int", "MOVETYPE_SLIDE", "2" },
@@ -1317,6 +1338,8 @@ static enumValueInfo_t cpuid_t_typeInfo[] = {
 	{ "CPUID_SSE2", 128 },
 	{ "CPUID_SSE3", 256 },
 	{ "CPUID_ALTIVEC", 512 },
+	{ "CPUID_AVX2", 1024 },
+	{ "CPUID_FMA", 2048 },
 	{ "CPUID_HTT", 4096 },
 	{ "CPUID_CMOV", 8192 },
 	{ "CPUID_FTZ", 16384 },
@@ -1493,14 +1516,26 @@ static enumValueInfo_t lexerFlags_t_typeInfo[] = {
 	{ NULL, 0 }
 };
 
-static enumValueInfo_t idMapPrimitive_enum_18_typeInfo[] = {
+static enumValueInfo_t deltaFieldType_t_typeInfo[] = {
+	{ "DELTA_FIELD_BITS", 0 },
+	{ "DELTA_FIELD_DELTA", 1 },
+	{ "DELTA_FIELD_BYTE_COUNTER", 2 },
+	{ "DELTA_FIELD_SHORT_COUNTER", 3 },
+	{ "DELTA_FIELD_LONG_COUNTER", 4 },
+	{ "DELTA_FIELD_STRING", 5 },
+	{ "DELTA_FIELD_DATA", 6 },
+	{ "DELTA_FIELD_DICT", 7 },
+	{ NULL, 0 }
+};
+
+static enumValueInfo_t idMapPrimitive_enum_19_typeInfo[] = {
 	{ "TYPE_INVALID", -1 },
 	{ "TYPE_BRUSH", 0 },
 	{ "TYPE_PATCH", 1 },
 	{ NULL, 0 }
 };
 
-static enumValueInfo_t idTimer_enum_19_typeInfo[] = {
+static enumValueInfo_t idTimer_enum_20_typeInfo[] = {
 	{ "TS_STARTED", 0 },
 	{ "TS_STOPPED", 1 },
 	{ NULL, 0 }
@@ -1648,7 +1683,7 @@ static enumValueInfo_t declState_t_typeInfo[] = {
 	{ NULL, 0 }
 };
 
-static enumValueInfo_t enum_34_typeInfo[] = {
+static enumValueInfo_t enum_35_typeInfo[] = {
 	{ "FX_LIGHT", 0 },
 	{ "FX_PARTICLE", 1 },
 	{ "FX_DECAL", 2 },
@@ -1711,7 +1746,7 @@ static enumValueInfo_t declAFJointMod_t_typeInfo[] = {
 	{ NULL, 0 }
 };
 
-static enumValueInfo_t idAFVector_enum_41_typeInfo[] = {
+static enumValueInfo_t idAFVector_enum_42_typeInfo[] = {
 	{ "VEC_COORDS", 0 },
 	{ "VEC_JOINT", 1 },
 	{ "VEC_BONECENTER", 2 },
@@ -1719,7 +1754,7 @@ static enumValueInfo_t idAFVector_enum_41_typeInfo[] = {
 	{ NULL, 0 }
 };
 
-static enumValueInfo_t idDeclAF_Constraint_enum_42_typeInfo[] = {
+static enumValueInfo_t idDeclAF_Constraint_enum_43_typeInfo[] = {
 	{ "LIMIT_NONE", -1 },
 	{ "LIMIT_CONE", 0 },
 	{ "LIMIT_PYRAMID", 1 },
@@ -2005,7 +2040,7 @@ static enumValueInfo_t escReply_t_typeInfo[] = {
 	{ NULL, 0 }
 };
 
-static enumValueInfo_t enum_67_typeInfo[] = {
+static enumValueInfo_t enum_68_typeInfo[] = {
 	{ "TEST_PARTICLE_MODEL", 0 },
 	{ "TEST_PARTICLE_IMPACT", 1 },
 	{ "TEST_PARTICLE_MUZZLE", 2 },
@@ -2103,7 +2138,7 @@ static enumValueInfo_t AFJointModType_t_typeInfo[] = {
 	{ NULL, 0 }
 };
 
-static enumValueInfo_t enum_73_typeInfo[] = {
+static enumValueInfo_t enum_74_typeInfo[] = {
 	{ "PATHTYPE_WALK", 0 },
 	{ "PATHTYPE_WALKOFFLEDGE", 1 },
 	{ "PATHTYPE_BARRIERJUMP", 2 },
@@ -2205,7 +2240,7 @@ static enumValueInfo_t idMultiplayerGame_vote_result_t_typeInfo[] = {
 	{ NULL, 0 }
 };
 
-static enumValueInfo_t enum_82_typeInfo[] = {
+static enumValueInfo_t enum_83_typeInfo[] = {
 	{ "GAME_RELIABLE_MESSAGE_INIT_DECL_REMAP", 0 },
 	{ "GAME_RELIABLE_MESSAGE_REMAP_DECL", 1 },
 	{ "GAME_RELIABLE_MESSAGE_SPAWN_PLAYER", 2 },
@@ -2250,6 +2285,18 @@ static enumValueInfo_t idEventQueue_outOfOrderBehaviour_t_typeInfo[] = {
 	{ NULL, 0 }
 };
 
+static enumValueInfo_t thinkCommandType_t_typeInfo[] = {
+	{ "THINKCMD_ACTIVATE", 0 },
+	{ "THINKCMD_REACTIVATE", 1 },
+	{ "THINKCMD_DEACTIVATE", 2 },
+	{ "THINKCMD_EVENT", 3 },
+	{ "THINKCMD_COLLIDE", 4 },
+	{ "THINKCMD_PRESENT", 5 },
+	{ "THINKCMD_UPDATESOUND", 6 },
+	{ "THINKCMD_CALL", 7 },
+	{ NULL, 0 }
+};
+
 static enumValueInfo_t gameSoundChannel_t_typeInfo[] = {
 	{ "SND_CHANNEL_ANY", 0 },
 	{ "SND_CHANNEL_VOICE", 1 },
@@ -2328,7 +2375,7 @@ static enumValueInfo_t constraintType_t_typeInfo[] = {
 	{ NULL, 0 }
 };
 
-static enumValueInfo_t enum_92_typeInfo[] = {
+static enumValueInfo_t enum_94_typeInfo[] = {
 	{ "TH_ALL", -1 },
 	{ "TH_THINK", 1 },
 	{ "TH_PHYSICS", 2 },
@@ -2353,26 +2400,26 @@ static enumValueInfo_t signalNum_t_typeInfo[] = {
 	{ NULL, 0 }
 };
 
-static enumValueInfo_t idEntity_enum_94_typeInfo[] = {
+static enumValueInfo_t idEntity_enum_96_typeInfo[] = {
 	{ "EVENT_STARTSOUNDSHADER", 0 },
 	{ "EVENT_STOPSOUNDSHADER", 1 },
 	{ "EVENT_MAXEVENTS", 2 },
 	{ NULL, 0 }
 };
 
-static enumValueInfo_t idAnimatedEntity_enum_95_typeInfo[] = {
+static enumValueInfo_t idAnimatedEntity_enum_97_typeInfo[] = {
 	{ "EVENT_ADD_DAMAGE_EFFECT", 2 },
 	{ "EVENT_MAXEVENTS", 3 },
 	{ NULL, 0 }
 };
 
-static enumValueInfo_t idPlayerStart_enum_96_typeInfo[] = {
+static enumValueInfo_t idPlayerStart_enum_98_typeInfo[] = {
 	{ "EVENT_TELEPORTPLAYER", 2 },
 	{ "EVENT_MAXEVENTS", 3 },
 	{ NULL, 0 }
 };
 
-static enumValueInfo_t idProjectile_enum_97_typeInfo[] = {
+static enumValueInfo_t idProjectile_enum_99_typeInfo[] = {
 	{ "EVENT_DAMAGE_EFFECT", 2 },
 	{ "EVENT_MAXEVENTS", 3 },
 	{ NULL, 0 }
@@ -2397,7 +2444,7 @@ static enumValueInfo_t weaponStatus_t_typeInfo[] = {
 	{ NULL, 0 }
 };
 
-static enumValueInfo_t idWeapon_enum_100_typeInfo[] = {
+static enumValueInfo_t idWeapon_enum_102_typeInfo[] = {
 	{ "EVENT_RELOAD", 2 },
 	{ "EVENT_ENDRELOAD", 3 },
 	{ "EVENT_CHANGESKIN", 4 },
@@ -2405,13 +2452,13 @@ static enumValueInfo_t idWeapon_enum_100_typeInfo[] = {
 	{ NULL, 0 }
 };
 
-static enumValueInfo_t idLight_enum_101_typeInfo[] = {
+static enumValueInfo_t idLight_enum_103_typeInfo[] = {
 	{ "EVENT_BECOMEBROKEN", 2 },
 	{ "EVENT_MAXEVENTS", 3 },
 	{ NULL, 0 }
 };
 
-static enumValueInfo_t idItem_enum_102_typeInfo[] = {
+static enumValueInfo_t idItem_enum_104_typeInfo[] = {
 	{ "EVENT_PICKUP", 2 },
 	{ "EVENT_RESPAWN", 3 },
 	{ "EVENT_RESPAWNFX", 4 },
@@ -2426,7 +2473,7 @@ static enumValueInfo_t playerIconType_t_typeInfo[] = {
 	{ NULL, 0 }
 };
 
-static enumValueInfo_t enum_104_typeInfo[] = {
+static enumValueInfo_t enum_106_typeInfo[] = {
 	{ "BERSERK", 0 },
 	{ "INVISIBILITY", 1 },
 	{ "MEGAHEALTH", 2 },
@@ -2435,7 +2482,7 @@ static enumValueInfo_t enum_104_typeInfo[] = {
 	{ NULL, 0 }
 };
 
-static enumValueInfo_t enum_105_typeInfo[] = {
+static enumValueInfo_t enum_107_typeInfo[] = {
 	{ "SPEED", 0 },
 	{ "PROJECTILE_DAMAGE", 1 },
 	{ "MELEE_DAMAGE", 2 },
@@ -2443,7 +2490,7 @@ static enumValueInfo_t enum_105_typeInfo[] = {
 	{ NULL, 0 }
 };
 
-static enumValueInfo_t enum_106_typeInfo[] = {
+static enumValueInfo_t enum_108_typeInfo[] = {
 	{ "INFLUENCE_NONE", 0 },
 	{ "INFLUENCE_LEVEL1", 1 },
 	{ "INFLUENCE_LEVEL2", 2 },
@@ -2451,7 +2498,7 @@ static enumValueInfo_t enum_106_typeInfo[] = {
 	{ NULL, 0 }
 };
 
-static enumValueInfo_t idPlayer_enum_107_typeInfo[] = {
+static enumValueInfo_t idPlayer_enum_109_typeInfo[] = {
 	{ "EVENT_IMPULSE", 2 },
 	{ "EVENT_EXIT_TELEPORTER", 3 },
 	{ "EVENT_ABORT_TELEPORTER", 4 },
@@ -2508,7 +2555,7 @@ static enumValueInfo_t moverState_t_typeInfo[] = {
 	{ NULL, 0 }
 };
 
-static enumValueInfo_t idExplodingBarrel_enum_113_typeInfo[] = {
+static enumValueInfo_t idExplodingBarrel_enum_115_typeInfo[] = {
 	{ "EVENT_EXPLODE", 2 },
 	{ "EVENT_MAXEVENTS", 3 },
 	{ NULL, 0 }
@@ -2522,7 +2569,7 @@ static enumValueInfo_t idExplodingBarrel_explode_state_t_typeInfo[] = {
 	{ NULL, 0 }
 };
 
-static enumValueInfo_t idSecurityCamera_enum_115_typeInfo[] = {
+static enumValueInfo_t idSecurityCamera_enum_117_typeInfo[] = {
 	{ "SCANNING", 0 },
 	{ "LOSINGINTEREST", 1 },
 	{ "ALERT", 2 },
@@ -2530,7 +2577,7 @@ static enumValueInfo_t idSecurityCamera_enum_115_typeInfo[] = {
 	{ NULL, 0 }
 };
 
-static enumValueInfo_t idBrittleFracture_enum_116_typeInfo[] = {
+static enumValueInfo_t idBrittleFracture_enum_118_typeInfo[] = {
 	{ "EVENT_PROJECT_DECAL", 2 },
 	{ "EVENT_SHATTER", 3 },
 	{ "EVENT_MAXEVENTS", 4 },
@@ -2597,7 +2644,7 @@ static enumValueInfo_t stopEvent_t_typeInfo[] = {
 	{ NULL, 0 }
 };
 
-static enumValueInfo_t enum_122_typeInfo[] = {
+static enumValueInfo_t enum_124_typeInfo[] = {
 	{ "OP_RETURN", 0 },
 	{ "OP_UINC_F", 1 },
 	{ "OP_UINCP_F", 2 },
@@ -2744,8 +2791,9 @@ static enumTypeInfo_t enumTypeInfo[] = {
 	{ "traceModel_t", traceModel_t_typeInfo },
 	{ "Measure_t", Measure_t_typeInfo },
 	{ "lexerFlags_t", lexerFlags_t_typeInfo },
-	{ "idMapPrimitive::enum_18", idMapPrimitive_enum_18_typeInfo },
-	{ "idTimer::enum_19", idTimer_enum_19_typeInfo },
+	{ "deltaFieldType_t", deltaFieldType_t_typeInfo },
+	{ "idMapPrimitive::enum_19", idMapPrimitive_enum_19_typeInfo },
+	{ "idTimer::enum_20", idTimer_enum_20_typeInfo },
 	{ "cmdFlags_t", cmdFlags_t_typeInfo },
 	{ "cmdExecution_t", cmdExecution_t_typeInfo },
 	{ "cvarFlags_t", cvarFlags_t_typeInfo },
@@ -2760,15 +2808,15 @@ static enumTypeInfo_t enumTypeInfo[] = {
 	{ "inhibit_t", inhibit_t_typeInfo },
 	{ "declType_t", declType_t_typeInfo },
 	{ "declState_t", declState_t_typeInfo },
-	{ "enum_34", enum_34_typeInfo },
+	{ "enum_35", enum_35_typeInfo },
 	{ "prtDistribution_t", prtDistribution_t_typeInfo },
 	{ "prtDirection_t", prtDirection_t_typeInfo },
 	{ "prtCustomPth_t", prtCustomPth_t_typeInfo },
 	{ "prtOrientation_t", prtOrientation_t_typeInfo },
 	{ "declAFConstraintType_t", declAFConstraintType_t_typeInfo },
 	{ "declAFJointMod_t", declAFJointMod_t_typeInfo },
-	{ "idAFVector::enum_41", idAFVector_enum_41_typeInfo },
-	{ "idDeclAF_Constraint::enum_42", idDeclAF_Constraint_enum_42_typeInfo },
+	{ "idAFVector::enum_42", idAFVector_enum_42_typeInfo },
+	{ "idDeclAF_Constraint::enum_43", idDeclAF_Constraint_enum_43_typeInfo },
 	{ "cinStatus_t", cinStatus_t_typeInfo },
 	{ "textureFilter_t", textureFilter_t_typeInfo },
 	{ "textureRepeat_t", textureRepeat_t_typeInfo },
@@ -2793,13 +2841,13 @@ static enumTypeInfo_t enumTypeInfo[] = {
 	{ "contactType_t", contactType_t_typeInfo },
 	{ "allowReply_t", allowReply_t_typeInfo },
 	{ "escReply_t", escReply_t_typeInfo },
-	{ "enum_67", enum_67_typeInfo },
+	{ "enum_68", enum_68_typeInfo },
 	{ "etype_t", etype_t_typeInfo },
 	{ "idVarDef::initialized_t", idVarDef_initialized_t_typeInfo },
 	{ "jointModTransform_t", jointModTransform_t_typeInfo },
 	{ "frameCommandType_t", frameCommandType_t_typeInfo },
 	{ "AFJointModType_t", AFJointModType_t_typeInfo },
-	{ "enum_73", enum_73_typeInfo },
+	{ "enum_74", enum_74_typeInfo },
 	{ "pvsType_t", pvsType_t_typeInfo },
 	{ "gameType_t", gameType_t_typeInfo },
 	{ "playerVote_t", playerVote_t_typeInfo },
@@ -2808,9 +2856,10 @@ static enumTypeInfo_t enumTypeInfo[] = {
 	{ "idMultiplayerGame::msg_evt_t", idMultiplayerGame_msg_evt_t_typeInfo },
 	{ "idMultiplayerGame::vote_flags_t", idMultiplayerGame_vote_flags_t_typeInfo },
 	{ "idMultiplayerGame::vote_result_t", idMultiplayerGame_vote_result_t_typeInfo },
-	{ "enum_82", enum_82_typeInfo },
+	{ "enum_83", enum_83_typeInfo },
 	{ "gameState_t", gameState_t_typeInfo },
 	{ "idEventQueue::outOfOrderBehaviour_t", idEventQueue_outOfOrderBehaviour_t_typeInfo },
+	{ "thinkCommandType_t", thinkCommandType_t_typeInfo },
 	{ "gameSoundChannel_t", gameSoundChannel_t_typeInfo },
 	{ "forceFieldType", forceFieldType_typeInfo },
 	{ "forceFieldApplyType", forceFieldApplyType_typeInfo },
@@ -2818,37 +2867,37 @@ static enumTypeInfo_t enumTypeInfo[] = {
 	{ "pmtype_t", pmtype_t_typeInfo },
 	{ "waterLevel_t", waterLevel_t_typeInfo },
 	{ "constraintType_t", constraintType_t_typeInfo },
-	{ "enum_92", enum_92_typeInfo },
+	{ "enum_94", enum_94_typeInfo },
 	{ "signalNum_t", signalNum_t_typeInfo },
-	{ "idEntity::enum_94", idEntity_enum_94_typeInfo },
-	{ "idAnimatedEntity::enum_95", idAnimatedEntity_enum_95_typeInfo },
-	{ "idPlayerStart::enum_96", idPlayerStart_enum_96_typeInfo },
-	{ "idProjectile::enum_97", idProjectile_enum_97_typeInfo },
+	{ "idEntity::enum_96", idEntity_enum_96_typeInfo },
+	{ "idAnimatedEntity::enum_97", idAnimatedEntity_enum_97_typeInfo },
+	{ "idPlayerStart::enum_98", idPlayerStart_enum_98_typeInfo },
+	{ "idProjectile::enum_99", idProjectile_enum_99_typeInfo },
 	{ "idProjectile::projectileState_t", idProjectile_projectileState_t_typeInfo },
 	{ "weaponStatus_t", weaponStatus_t_typeInfo },
-	{ "idWeapon::enum_100", idWeapon_enum_100_typeInfo },
-	{ "idLight::enum_101", idLight_enum_101_typeInfo },
-	{ "idItem::enum_102", idItem_enum_102_typeInfo },
+	{ "idWeapon::enum_102", idWeapon_enum_102_typeInfo },
+	{ "idLight::enum_103", idLight_enum_103_typeInfo },
+	{ "idItem::enum_104", idItem_enum_104_typeInfo },
 	{ "playerIconType_t", playerIconType_t_typeInfo },
-	{ "enum_104", enum_104_typeInfo },
-	{ "enum_105", enum_105_typeInfo },
 	{ "enum_106", enum_106_typeInfo },
-	{ "idPlayer::enum_107", idPlayer_enum_107_typeInfo },
+	{ "enum_107", enum_107_typeInfo },
+	{ "enum_108", enum_108_typeInfo },
+	{ "idPlayer::enum_109", idPlayer_enum_109_typeInfo },
 	{ "idMover::moveStage_t", idMover_moveStage_t_typeInfo },
 	{ "idMover::moverCommand_t", idMover_moverCommand_t_typeInfo },
 	{ "idMover::moverDir_t", idMover_moverDir_t_typeInfo },
 	{ "idElevator::elevatorState_t", idElevator_elevatorState_t_typeInfo },
 	{ "moverState_t", moverState_t_typeInfo },
-	{ "idExplodingBarrel::enum_113", idExplodingBarrel_enum_113_typeInfo },
+	{ "idExplodingBarrel::enum_115", idExplodingBarrel_enum_115_typeInfo },
 	{ "idExplodingBarrel::explode_state_t", idExplodingBarrel_explode_state_t_typeInfo },
-	{ "idSecurityCamera::enum_115", idSecurityCamera_enum_115_typeInfo },
-	{ "idBrittleFracture::enum_116", idBrittleFracture_enum_116_typeInfo },
+	{ "idSecurityCamera::enum_117", idSecurityCamera_enum_117_typeInfo },
+	{ "idBrittleFracture::enum_118", idBrittleFracture_enum_118_typeInfo },
 	{ "moveType_t", moveType_t_typeInfo },
 	{ "moveCommand_t", moveCommand_t_typeInfo },
 	{ "talkState_t", talkState_t_typeInfo },
 	{ "moveStatus_t", moveStatus_t_typeInfo },
 	{ "stopEvent_t", stopEvent_t_typeInfo },
-	{ "enum_122", enum_122_typeInfo },
+	{ "enum_124", enum_124_typeInfo },
 	{ NULL, NULL }
 };
 
@@ -2903,6 +2952,11 @@ static classVariableInfo_t xthreadInfo_typeInfo[] = {
 	{ NULL, 0 }
 };
 
+static classVariableInfo_t idSysSpinLock_typeInfo[] = {
+	{ "volatile int", "locked", (int)(&((idSysSpinLock *)0)->locked), sizeof( ((idSysSpinLock *)0)->locked ) },
+	{ NULL, 0 }
+};
+
 static classVariableInfo_t idSys_typeInfo[] = {
 	{ NULL, 0 }
 };
@@ -3492,6 +3546,7 @@ static classVariableInfo_t idLexer_typeInfo[] = {
 	{ "idToken", "token", (int)(&((idLexer *)0)->token), sizeof( ((idLexer *)0)->token ) },
 	{ "idLexer *", "next", (int)(&((idLexer *)0)->next), sizeof( ((idLexer *)0)->next ) },
 	{ "bool", "hadError", (int)(&((idLexer *)0)->hadError), sizeof( ((idLexer *)0)->hadError ) },
+	{ "bool", "hadWarning", (int)(&((idLexer *)0)->hadWarning), sizeof( ((idLexer *)0)->hadWarning ) },
 	{ NULL, 0 }
 };
 
@@ -3687,12 +3742,21 @@ static classVariableInfo_t idBitMsg_typeInfo[] = {
 	{ NULL, 0 }
 };
 
+static classVariableInfo_t deltaField_t_typeInfo[] = {
+	{ "short", "type", (int)(&((deltaField_t *)0)->type), sizeof( ((deltaField_t *)0)->type ) },
+	{ "short", "numBits", (int)(&((deltaField_t *)0)->numBits), sizeof( ((deltaField_t *)0)->numBits ) },
+	{ "int", "oldValue", (int)(&((deltaField_t *)0)->oldValue), sizeof( ((deltaField_t *)0)->oldValue ) },
+	{ "int", "newValue", (int)(&((deltaField_t *)0)->newValue), sizeof( ((deltaField_t *)0)->newValue ) },
+	{ NULL, 0 }
+};
+
 static classVariableInfo_t idBitMsgDelta_typeInfo[] = {
 	{ "const idBitMsg *", "base", (int)(&((idBitMsgDelta *)0)->base), sizeof( ((idBitMsgDelta *)0)->base ) },
 	{ "idBitMsg *", "newBase", (int)(&((idBitMsgDelta *)0)->newBase), sizeof( ((idBitMsgDelta *)0)->newBase ) },
 	{ "idBitMsg *", "writeDelta", (int)(&((idBitMsgDelta *)0)->writeDelta), sizeof( ((idBitMsgDelta *)0)->writeDelta ) },
 	{ "const idBitMsg *", "readDelta", (int)(&((idBitMsgDelta *)0)->readDelta), sizeof( ((idBitMsgDelta *)0)->readDelta ) },
 	{ "mutable bool", "changed", (int)(&((idBitMsgDelta *)0)->changed), sizeof( ((idBitMsgDelta *)0)->changed ) },
+	{ "idList < deltaField_t > *", "recordFields", (int)(&((idBitMsgDelta *)0)->recordFields), sizeof( ((idBitMsgDelta *)0)->recordFields ) },
 	{ NULL, 0 }
 };
 
@@ -3741,7 +3805,7 @@ static classVariableInfo_t idMapFile_typeInfo[] = {
 };
 
 static classVariableInfo_t idTimer_typeInfo[] = {
-	{ "idTimer::enum_19", "state", (int)(&((idTimer *)0)->state), sizeof( ((idTimer *)0)->state ) },
+	{ "idTimer::enum_20", "state", (int)(&((idTimer *)0)->state), sizeof( ((idTimer *)0)->state ) },
 	{ "double", "start", (int)(&((idTimer *)0)->start), sizeof( ((idTimer *)0)->start ) },
 	{ "double", "clockTicks", (int)(&((idTimer *)0)->clockTicks), sizeof( ((idTimer *)0)->clockTicks ) },
 	{ NULL, 0 }
@@ -3795,6 +3859,17 @@ static classVariableInfo_t idCommon_typeInfo[] = {
 	{ NULL, 0 }
 };
 
+static classVariableInfo_t idJobCounter_typeInfo[] = {
+	{ "volatile int", "count", (int)(&((idJobCounter *)0)->count), sizeof( ((idJobCounter *)0)->count ) },
+	{ "idSysSpinLock", "lock", (int)(&((idJobCounter *)0)->lock), sizeof( ((idJobCounter *)0)->lock ) },
+	{ "jobEntry_s *", "dependents", (int)(&((idJobCounter *)0)->dependents), sizeof( ((idJobCounter *)0)->dependents ) },
+	{ NULL, 0 }
+};
+
+static classVariableInfo_t idJobSystem_typeInfo[] = {
+	{ NULL, 0 }
+};
+
 static classVariableInfo_t idFile_typeInfo[] = {
 	{ NULL, 0 }
 };
@@ -4048,7 +4123,7 @@ static classVariableInfo_t idDeclParticle_typeInfo[] = {
 };
 
 static classVariableInfo_t idAFVector_typeInfo[] = {
-	{ "idAFVector::enum_41", "type", (int)(&((idAFVector *)0)->type), sizeof( ((idAFVector *)0)->type ) },
+	{ "idAFVector::enum_42", "type", (int)(&((idAFVector *)0)->type), sizeof( ((idAFVector *)0)->type ) },
 	{ "idStr", "joint1", (int)(&((idAFVector *)0)->joint1), sizeof( ((idAFVector *)0)->joint1 ) },
 	{ "idStr", "joint2", (int)(&((idAFVector *)0)->joint2), sizeof( ((idAFVector *)0)->joint2 ) },
 	{ "mutable idVec3", "vec", (int)(&((idAFVector *)0)->vec), sizeof( ((idAFVector *)0)->vec ) },
@@ -4097,7 +4172,7 @@ static classVariableInfo_t idDeclAF_Constraint_typeInfo[] = {
 	{ "idAFVector", "anchor2", (int)(&((idDeclAF_Constraint *)0)->anchor2), sizeof( ((idDeclAF_Constraint *)0)->anchor2 ) },
 	{ "idAFVector[2]", "shaft", (int)(&((idDeclAF_Constraint *)0)->shaft), sizeof( ((idDeclAF_Constraint *)0)->shaft ) },
 	{ "idAFVector", "axis", (int)(&((idDeclAF_Constraint *)0)->axis), sizeof( ((idDeclAF_Constraint *)0)->axis ) },
-	{ "idDeclAF_Constraint::enum_42", "limit", (int)(&((idDeclAF_Constraint *)0)->limit), sizeof( ((idDeclAF_Constraint *)0)->limit ) },
+	{ "idDeclAF_Constraint::enum_43", "limit", (int)(&((idDeclAF_Constraint *)0)->limit), sizeof( ((idDeclAF_Constraint *)0)->limit ) },
 	{ "idAFVector", "limitAxis", (int)(&((idDeclAF_Constraint *)0)->limitAxis), sizeof( ((idDeclAF_Constraint *)0)->limitAxis ) },
 	{ "float[3]", "limitAngles", (int)(&((idDeclAF_Constraint *)0)->limitAngles), sizeof( ((idDeclAF_Constraint *)0)->limitAngles ) },
 	{ NULL, 0 }
@@ -4885,6 +4960,7 @@ static classVariableInfo_t gameImport_t_typeInfo[] = {
 	{ "idDeclManager *", "declManager", (int)(&((gameImport_t *)0)->declManager), sizeof( ((gameImport_t *)0)->declManager ) },
 	{ "idAASFileManager *", "AASFileManager", (int)(&((gameImport_t *)0)->AASFileManager), sizeof( ((gameImport_t *)0)->AASFileManager ) },
 	{ "idCollisionModelManager *", "collisionModelManager", (int)(&((gameImport_t *)0)->collisionModelManager), sizeof( ((gameImport_t *)0)->collisionModelManager ) },
+	{ "idJobSystem *", "jobSystem", (int)(&((gameImport_t *)0)->jobSystem), sizeof( ((gameImport_t *)0)->jobSystem ) },
 	{ NULL, 0 }
 };
 
@@ -4914,7 +4990,10 @@ static classVariableInfo_t idEvent_typeInfo[] = {
 	{ "int", "time", (int)(&((idEvent *)0)->time), sizeof( ((idEvent *)0)->time ) },
 	{ "idClass *", "object", (int)(&((idEvent *)0)->object), sizeof( ((idEvent *)0)->object ) },
 	{ "const idTypeInfo *", "typeinfo", (int)(&((idEvent *)0)->typeinfo), sizeof( ((idEvent *)0)->typeinfo ) },
+	{ "unsigned int", "sequence", (int)(&((idEvent *)0)->sequence), sizeof( ((idEvent *)0)->sequence ) },
+	{ "int", "heapIndex", (int)(&((idEvent *)0)->heapIndex), sizeof( ((idEvent *)0)->heapIndex ) },
 	{ "idLinkList < idEvent >", "eventNode", (int)(&((idEvent *)0)->eventNode), sizeof( ((idEvent *)0)->eventNode ) },
+	{ "idLinkList < idEvent >", "objectNode", (int)(&((idEvent *)0)->objectNode), sizeof( ((idEvent *)0)->objectNode ) },
 	{ NULL, 0 }
 };
 
@@ -4929,6 +5008,7 @@ static classVariableInfo_t idAllocError_typeInfo[] = {
 };
 
 static classVariableInfo_t idClass_typeInfo[] = {
+	{ "idLinkList < idEvent >", "eventList", (int)(&((idClass *)0)->eventList), sizeof( ((idClass *)0)->eventList ) },
 	{ NULL, 0 }
 };
 
@@ -5291,18 +5371,21 @@ static classVariableInfo_t idClipModel_typeInfo[] = {
 	{ "cmHandle_t", "collisionModelHandle", (int)(&((idClipModel *)0)->collisionModelHandle), sizeof( ((idClipModel *)0)->collisionModelHandle ) },
 	{ "int", "traceModelIndex", (int)(&((idClipModel *)0)->traceModelIndex), sizeof( ((idClipModel *)0)->traceModelIndex ) },
 	{ "int", "renderModelHandle", (int)(&((idClipModel *)0)->renderModelHandle), sizeof( ((idClipModel *)0)->renderModelHandle ) },
-	{ "clipLink_s *", "clipLinks", (int)(&((idClipModel *)0)->clipLinks), sizeof( ((idClipModel *)0)->clipLinks ) },
-	{ "int", "touchCount", (int)(&((idClipModel *)0)->touchCount), sizeof( ((idClipModel *)0)->touchCount ) },
+	{ "idClip *", "clip", (int)(&((idClipModel *)0)->clip), sizeof( ((idClipModel *)0)->clip ) },
+	{ "int", "clipNode", (int)(&((idClipModel *)0)->clipNode), sizeof( ((idClipModel *)0)->clipNode ) },
+	{ "bool", "linked", (int)(&((idClipModel *)0)->linked), sizeof( ((idClipModel *)0)->linked ) },
 	{ NULL, 0 }
 };
 
 static classVariableInfo_t idClip_typeInfo[] = {
-	{ "int", "numClipSectors", (int)(&((idClip *)0)->numClipSectors), sizeof( ((idClip *)0)->numClipSectors ) },
-	{ "clipSector_s *", "clipSectors", (int)(&((idClip *)0)->clipSectors), sizeof( ((idClip *)0)->clipSectors ) },
+	{ "clipNode_s *", "clipNodes", (int)(&((idClip *)0)->clipNodes), sizeof( ((idClip *)0)->clipNodes ) },
+	{ "int", "maxClipNodes", (int)(&((idClip *)0)->maxClipNodes), sizeof( ((idClip *)0)->maxClipNodes ) },
+	{ "int", "numClipNodes", (int)(&((idClip *)0)->numClipNodes), sizeof( ((idClip *)0)->numClipNodes ) },
+	{ "int", "freeClipNode", (int)(&((idClip *)0)->freeClipNode), sizeof( ((idClip *)0)->freeClipNode ) },
+	{ "int", "clipRoot", (int)(&((idClip *)0)->clipRoot), sizeof( ((idClip *)0)->clipRoot ) },
 	{ "idBounds", "worldBounds", (int)(&((idClip *)0)->worldBounds), sizeof( ((idClip *)0)->worldBounds ) },
 	{ "idClipModel", "temporaryClipModel", (int)(&((idClip *)0)->temporaryClipModel), sizeof( ((idClip *)0)->temporaryClipModel ) },
 	{ "idClipModel", "defaultClipModel", (int)(&((idClip *)0)->defaultClipModel), sizeof( ((idClip *)0)->defaultClipModel ) },
-	{ "mutable int", "touchCount", (int)(&((idClip *)0)->touchCount), sizeof( ((idClip *)0)->touchCount ) },
 	{ "int", "numTranslations", (int)(&((idClip *)0)->numTranslations), sizeof( ((idClip *)0)->numTranslations ) },
 	{ "int", "numRotations", (int)(&((idClip *)0)->numRotations), sizeof( ((idClip *)0)->numRotations ) },
 	{ "int", "numMotions", (int)(&((idClip *)0)->numMotions), sizeof( ((idClip *)0)->numMotions ) },
@@ -5349,10 +5432,9 @@ static classVariableInfo_t pvsCurrent_t_typeInfo[] = {
 static classVariableInfo_t idPVS_typeInfo[] = {
 	{ "int", "numAreas", (int)(&((idPVS *)0)->numAreas), sizeof( ((idPVS *)0)->numAreas ) },
 	{ "int", "numPortals", (int)(&((idPVS *)0)->numPortals), sizeof( ((idPVS *)0)->numPortals ) },
-	{ "bool *", "connectedAreas", (int)(&((idPVS *)0)->connectedAreas), sizeof( ((idPVS *)0)->connectedAreas ) },
-	{ "int *", "areaQueue", (int)(&((idPVS *)0)->areaQueue), sizeof( ((idPVS *)0)->areaQueue ) },
 	{ "byte *", "areaPVS", (int)(&((idPVS *)0)->areaPVS), sizeof( ((idPVS *)0)->areaPVS ) },
-	{ "mutable pvsCurrent_t[8]", "currentPVS", (int)(&((idPVS *)0)->currentPVS), sizeof( ((idPVS *)0)->currentPVS ) },
+	{ "mutable pvsCurrent_t[64]", "currentPVS", (int)(&((idPVS *)0)->currentPVS), sizeof( ((idPVS *)0)->currentPVS ) },
+	{ "mutable idSysSpinLock", "currentPVSLock", (int)(&((idPVS *)0)->currentPVSLock), sizeof( ((idPVS *)0)->currentPVSLock ) },
 	{ "int", "portalVisBytes", (int)(&((idPVS *)0)->portalVisBytes), sizeof( ((idPVS *)0)->portalVisBytes ) },
 	{ "int", "portalVisLongs", (int)(&((idPVS *)0)->portalVisLongs), sizeof( ((idPVS *)0)->portalVisLongs ) },
 	{ "int", "areaVisBytes", (int)(&((idPVS *)0)->areaVisBytes), sizeof( ((idPVS *)0)->areaVisBytes ) },
@@ -5443,6 +5525,16 @@ static classVariableInfo_t snapshot_t_typeInfo[] = {
 	{ NULL, 0 }
 };
 
+static classVariableInfo_t snapshotEncode_t_typeInfo[] = {
+	{ "int", "generation", (int)(&((snapshotEncode_t *)0)->generation), sizeof( ((snapshotEncode_t *)0)->generation ) },
+	{ "int", "spawnId", (int)(&((snapshotEncode_t *)0)->spawnId), sizeof( ((snapshotEncode_t *)0)->spawnId ) },
+	{ "int", "firstField", (int)(&((snapshotEncode_t *)0)->firstField), sizeof( ((snapshotEncode_t *)0)->firstField ) },
+	{ "int", "numFields", (int)(&((snapshotEncode_t *)0)->numFields), sizeof( ((snapshotEncode_t *)0)->numFields ) },
+	{ "volatile int", "numUses", (int)(&((snapshotEncode_t *)0)->numUses), sizeof( ((snapshotEncode_t *)0)->numUses ) },
+	{ "entityState_t *", "state", (int)(&((snapshotEncode_t *)0)->state), sizeof( ((snapshotEncode_t *)0)->state ) },
+	{ NULL, 0 }
+};
+
 static classVariableInfo_t entityNetEvent_t_typeInfo[] = {
 	{ "int", "spawnId", (int)(&((entityNetEvent_t *)0)->spawnId), sizeof( ((entityNetEvent_t *)0)->spawnId ) },
 	{ "int", "event", (int)(&((entityNetEvent_t *)0)->event), sizeof( ((entityNetEvent_t *)0)->event ) },
@@ -5472,6 +5564,32 @@ static classVariableInfo_t idEntityPtr_class_type__typeInfo[] = {
 	{ NULL, 0 }
 };
 
+static classVariableInfo_t thinkCommand_t_typeInfo[] = {
+	{ "thinkCommandType_t", "type", (int)(&((thinkCommand_t *)0)->type), sizeof( ((thinkCommand_t *)0)->type ) },
+	{ "idEntityPtr < idEntity >", "entity", (int)(&((thinkCommand_t *)0)->entity), sizeof( ((thinkCommand_t *)0)->entity ) },
+	{ "thinkCall_t", "call", (int)(&((thinkCommand_t *)0)->call), sizeof( ((thinkCommand_t *)0)->call ) },
+	{ "idEvent *", "event", (int)(&((thinkCommand_t *)0)->event), sizeof( ((thinkCommand_t *)0)->event ) },
+	{ "idClass *", "eventObject", (int)(&((thinkCommand_t *)0)->eventObject), sizeof( ((thinkCommand_t *)0)->eventObject ) },
+	{ "const idTypeInfo *", "eventType", (int)(&((thinkCommand_t *)0)->eventType), sizeof( ((thinkCommand_t *)0)->eventType ) },
+	{ "int", "eventTime", (int)(&((thinkCommand_t *)0)->eventTime), sizeof( ((thinkCommand_t *)0)->eventTime ) },
+	{ "int", "collision", (int)(&((thinkCommand_t *)0)->collision), sizeof( ((thinkCommand_t *)0)->collision ) },
+	{ NULL, 0 }
+};
+
+static classVariableInfo_t thinkCollision_t_typeInfo[] = {
+	{ "trace_t", "collision", (int)(&((thinkCollision_t *)0)->collision), sizeof( ((thinkCollision_t *)0)->collision ) },
+	{ "idVec3", "velocity", (int)(&((thinkCollision_t *)0)->velocity), sizeof( ((thinkCollision_t *)0)->velocity ) },
+	{ NULL, 0 }
+};
+
+static classVariableInfo_t thinkIsland_t_typeInfo[] = {
+	{ "idList < idEntity * >", "entities", (int)(&((thinkIsland_t *)0)->entities), sizeof( ((thinkIsland_t *)0)->entities ) },
+	{ "idList < thinkCommand_t >", "commands", (int)(&((thinkIsland_t *)0)->commands), sizeof( ((thinkIsland_t *)0)->commands ) },
+	{ "idList < thinkCollision_t >", "collisions", (int)(&((thinkIsland_t *)0)->collisions), sizeof( ((thinkIsland_t *)0)->collisions ) },
+	{ "double", "msec", (int)(&((thinkIsland_t *)0)->msec), sizeof( ((thinkIsland_t *)0)->msec ) },
+	{ NULL, 0 }
+};
+
 static classVariableInfo_t idGameLocal_typeInfo[] = {
 	{ "idDict", "serverInfo", (int)(&((idGameLocal *)0)->serverInfo), sizeof( ((idGameLocal *)0)->serverInfo ) },
 	{ "int", "numClients", (int)(&((idGameLocal *)0)->numClients), sizeof( ((idGameLocal *)0)->numClients ) },
@@ -5524,6 +5642,9 @@ static classVariableInfo_t idGameLocal_typeInfo[] = {
 	{ "int", "entityDefBits", (int)(&((idGameLocal *)0)->entityDefBits), sizeof( ((idGameLocal *)0)->entityDefBits ) },
 	{ "idEntityPtr < idEntity >", "lastGUIEnt", (int)(&((idGameLocal *)0)->lastGUIEnt), sizeof( ((idGameLocal *)0)->lastGUIEnt ) },
 	{ "int", "lastGUI", (int)(&((idGameLocal *)0)->lastGUI), sizeof( ((idGameLocal *)0)->lastGUI ) },
+	{ "volatile int", "numBodiesRested", (int)(&((idGameLocal *)0)->numBodiesRested), sizeof( ((idGameLocal *)0)->numBodiesRested ) },
+	{ "volatile int", "numBodiesWoken", (int)(&((idGameLocal *)0)->numBodiesWoken), sizeof( ((idGameLocal *)0)->numBodiesWoken ) },
+	{ "volatile int", "numBodiesIslandSlept", (int)(&((idGameLocal *)0)->numBodiesIslandSlept), sizeof( ((idGameLocal *)0)->numBodiesIslandSlept ) },
 	{ "idStr", "mapFileName", (int)(&((idGameLocal *)0)->mapFileName), sizeof( ((idGameLocal *)0)->mapFileName ) },
 	{ "idMapFile *", "mapFile", (int)(&((idGameLocal *)0)->mapFile), sizeof( ((idGameLocal *)0)->mapFile ) },
 	{ "bool", "mapCycleLoaded", (int)(&((idGameLocal *)0)->mapCycleLoaded), sizeof( ((idGameLocal *)0)->mapCycleLoaded ) },
@@ -5536,6 +5657,8 @@ static classVariableInfo_t idGameLocal_typeInfo[] = {
 	{ "idStrList", "aasNames", (int)(&((idGameLocal *)0)->aasNames), sizeof( ((idGameLocal *)0)->aasNames ) },
 	{ "idEntityPtr < idActor >", "lastAIAlertEntity", (int)(&((idGameLocal *)0)->lastAIAlertEntity), sizeof( ((idGameLocal *)0)->lastAIAlertEntity ) },
 	{ "int", "lastAIAlertTime", (int)(&((idGameLocal *)0)->lastAIAlertTime), sizeof( ((idGameLocal *)0)->lastAIAlertTime ) },
+	{ "int", "aiPathFrame", (int)(&((idGameLocal *)0)->aiPathFrame), sizeof( ((idGameLocal *)0)->aiPathFrame ) },
+	{ "int", "numAIPaths", (int)(&((idGameLocal *)0)->numAIPaths), sizeof( ((idGameLocal *)0)->numAIPaths ) },
 	{ "idDict", "spawnArgs", (int)(&((idGameLocal *)0)->spawnArgs), sizeof( ((idGameLocal *)0)->spawnArgs ) },
 	{ "pvsHandle_t", "playerPVS", (int)(&((idGameLocal *)0)->playerPVS), sizeof( ((idGameLocal *)0)->playerPVS ) },
 	{ "pvsHandle_t", "playerConnectedAreas", (int)(&((idGameLocal *)0)->playerConnectedAreas), sizeof( ((idGameLocal *)0)->playerConnectedAreas ) },
@@ -5548,7 +5671,26 @@ static classVariableInfo_t idGameLocal_typeInfo[] = {
 	{ "int[4096]", "clientPVS", (int)(&((idGameLocal *)0)->clientPVS), sizeof( ((idGameLocal *)0)->clientPVS ) },
 	{ "snapshot_t *[32]", "clientSnapshots", (int)(&((idGameLocal *)0)->clientSnapshots), sizeof( ((idGameLocal *)0)->clientSnapshots ) },
 	{ "idBlockAlloc < entityState_t , 256 >", "entityStateAllocator", (int)(&((idGameLocal *)0)->entityStateAllocator), sizeof( ((idGameLocal *)0)->entityStateAllocator ) },
-	{ "idBlockAlloc < snapshot_t , 64 >", "snapshotAllocator", (int)(&((idGameLocal *)0)->snapshotAllocator), sizeof( ((idGameLocal *)0)->snapshotAllocator ) },
+	{ "idBlockAlloc < entityState_t , 256 >[32]", "clientEntityStateAllocators", (int)(&((idGameLocal *)0)->clientEntityStateAllocators), sizeof( ((idGameLocal *)0)->clientEntityStateAllocators ) },
+	{ "idBlockAlloc < snapshot_t , 64 >[32]", "clientSnapshotAllocators", (int)(&((idGameLocal *)0)->clientSnapshotAllocators), sizeof( ((idGameLocal *)0)->clientSnapshotAllocators ) },
+	{ "snapshotEncode_t[4096]", "snapshotEncodes", (int)(&((idGameLocal *)0)->snapshotEncodes), sizeof( ((idGameLocal *)0)->snapshotEncodes ) },
+	{ "idList < deltaField_t >", "snapshotEncodeFields", (int)(&((idGameLocal *)0)->snapshotEncodeFields), sizeof( ((idGameLocal *)0)->snapshotEncodeFields ) },
+	{ "int", "snapshotEncodeGeneration", (int)(&((idGameLocal *)0)->snapshotEncodeGeneration), sizeof( ((idGameLocal *)0)->snapshotEncodeGeneration ) },
+	{ "volatile int", "snapshotEncodeHits", (int)(&((idGameLocal *)0)->snapshotEncodeHits), sizeof( ((idGameLocal *)0)->snapshotEncodeHits ) },
+	{ "int", "snapshotEncodeMisses", (int)(&((idGameLocal *)0)->snapshotEncodeMisses), sizeof( ((idGameLocal *)0)->snapshotEncodeMisses ) },
+	{ "volatile int", "snapshotEncodeBytesSaved", (int)(&((idGameLocal *)0)->snapshotEncodeBytesSaved), sizeof( ((idGameLocal *)0)->snapshotEncodeBytesSaved ) },
+	{ "idList < idEntityPtr < idEntity > >", "thinkCandidates", (int)(&((idGameLocal *)0)->thinkCandidates), sizeof( ((idGameLocal *)0)->thinkCandidates ) },
+	{ "idList < idBounds >", "thinkCandidateBounds", (int)(&((idGameLocal *)0)->thinkCandidateBounds), sizeof( ((idGameLocal *)0)->thinkCandidateBounds ) },
+	{ "idList < thinkIsland_t * >", "thinkIslands", (int)(&((idGameLocal *)0)->thinkIslands), sizeof( ((idGameLocal *)0)->thinkIslands ) },
+	{ "int", "numThinkIslands", (int)(&((idGameLocal *)0)->numThinkIslands), sizeof( ((idGameLocal *)0)->numThinkIslands ) },
+	{ "int[4096]", "thinkIslandParent", (int)(&((idGameLocal *)0)->thinkIslandParent), sizeof( ((idGameLocal *)0)->thinkIslandParent ) },
+	{ "int[4096]", "thinkIslandFlags", (int)(&((idGameLocal *)0)->thinkIslandFlags), sizeof( ((idGameLocal *)0)->thinkIslandFlags ) },
+	{ "int[4096]", "thinkIslandNum", (int)(&((idGameLocal *)0)->thinkIslandNum), sizeof( ((idGameLocal *)0)->thinkIslandNum ) },
+	{ "float", "thinkParallelMsec", (int)(&((idGameLocal *)0)->thinkParallelMsec), sizeof( ((idGameLocal *)0)->thinkParallelMsec ) },
+	{ "float", "thinkCommandsMsec", (int)(&((idGameLocal *)0)->thinkCommandsMsec), sizeof( ((idGameLocal *)0)->thinkCommandsMsec ) },
+	{ "float", "thinkSlowestIslandMsec", (int)(&((idGameLocal *)0)->thinkSlowestIslandMsec), sizeof( ((idGameLocal *)0)->thinkSlowestIslandMsec ) },
+	{ "int", "thinkNumParallel", (int)(&((idGameLocal *)0)->thinkNumParallel), sizeof( ((idGameLocal *)0)->thinkNumParallel ) },
+	{ "int", "thinkNumSerial", (int)(&((idGameLocal *)0)->thinkNumSerial), sizeof( ((idGameLocal *)0)->thinkNumSerial ) },
 	{ "idEventQueue", "eventQueue", (int)(&((idGameLocal *)0)->eventQueue), sizeof( ((idGameLocal *)0)->eventQueue ) },
 	{ "idEventQueue", "savedEventQueue", (int)(&((idGameLocal *)0)->savedEventQueue), sizeof( ((idGameLocal *)0)->savedEventQueue ) },
 	{ "idStaticList < spawnSpot_t , ( 1 << 12 ) >", "spawnSpots", (int)(&((idGameLocal *)0)->spawnSpots), sizeof( ((idGameLocal *)0)->spawnSpots ) },
@@ -5805,6 +5947,9 @@ static classVariableInfo_t idPhysics_RigidBody_typeInfo[] = {
 	{ "bool", "noContact", (int)(&((idPhysics_RigidBody *)0)->noContact), sizeof( ((idPhysics_RigidBody *)0)->noContact ) },
 	{ "bool", "hasMaster", (int)(&((idPhysics_RigidBody *)0)->hasMaster), sizeof( ((idPhysics_RigidBody *)0)->hasMaster ) },
 	{ "bool", "isOrientated", (int)(&((idPhysics_RigidBody *)0)->isOrientated), sizeof( ((idPhysics_RigidBody *)0)->isOrientated ) },
+	{ "int", "slowTime", (int)(&((idPhysics_RigidBody *)0)->slowTime), sizeof( ((idPhysics_RigidBody *)0)->slowTime ) },
+	{ "int", "sleepCheckTime", (int)(&((idPhysics_RigidBody *)0)->sleepCheckTime), sizeof( ((idPhysics_RigidBody *)0)->sleepCheckTime ) },
+	{ "idPhysics_RigidBody *", "sleepNext", (int)(&((idPhysics_RigidBody *)0)->sleepNext), sizeof( ((idPhysics_RigidBody *)0)->sleepNext ) },
 	{ NULL, 0 }
 };
 
@@ -7817,6 +7962,9 @@ static classVariableInfo_t idMoveState_typeInfo[] = {
 	{ "idVec3", "lastMoveOrigin", (int)(&((idMoveState *)0)->lastMoveOrigin), sizeof( ((idMoveState *)0)->lastMoveOrigin ) },
 	{ "int", "lastMoveTime", (int)(&((idMoveState *)0)->lastMoveTime), sizeof( ((idMoveState *)0)->lastMoveTime ) },
 	{ "int", "anim", (int)(&((idMoveState *)0)->anim), sizeof( ((idMoveState *)0)->anim ) },
+	{ "idVec3", "pathGoal", (int)(&((idMoveState *)0)->pathGoal), sizeof( ((idMoveState *)0)->pathGoal ) },
+	{ "int", "pathGoalAreaNum", (int)(&((idMoveState *)0)->pathGoalAreaNum), sizeof( ((idMoveState *)0)->pathGoalAreaNum ) },
+	{ "int", "pathTime", (int)(&((idMoveState *)0)->pathTime), sizeof( ((idMoveState *)0)->pathTime ) },
 	{ NULL, 0 }
 };
 
@@ -8069,6 +8217,7 @@ static classTypeInfo_t classTypeInfo[] = {
 	{ "idPort", "", sizeof(idPort), idPort_typeInfo },
 	{ "idTCP", "", sizeof(idTCP), idTCP_typeInfo },
 	{ "xthreadInfo", "", sizeof(xthreadInfo), xthreadInfo_typeInfo },
+	{ "idSysSpinLock", "", sizeof(idSysSpinLock), idSysSpinLock_typeInfo },
 	{ "idSys", "", sizeof(idSys), idSys_typeInfo },
 	{ "idLib", "", sizeof(idLib), idLib_typeInfo },
 	{ "idException", "", sizeof(idException), idException_typeInfo },
@@ -8176,6 +8325,7 @@ static classTypeInfo_t classTypeInfo[] = {
 	{ "idLangKeyValue", "", sizeof(idLangKeyValue), idLangKeyValue_typeInfo },
 	{ "idLangDict", "", sizeof(idLangDict), idLangDict_typeInfo },
 	{ "idBitMsg", "", sizeof(idBitMsg), idBitMsg_typeInfo },
+	{ "deltaField_t", "", sizeof(deltaField_t), deltaField_t_typeInfo },
 	{ "idBitMsgDelta", "", sizeof(idBitMsgDelta), idBitMsgDelta_typeInfo },
 	{ "idMapPrimitive", "", sizeof(idMapPrimitive), idMapPrimitive_typeInfo },
 	{ "idMapBrushSide", "", sizeof(idMapBrushSide), idMapBrushSide_typeInfo },
@@ -8190,6 +8340,8 @@ static classTypeInfo_t classTypeInfo[] = {
 	{ "idCVarSystem", "", sizeof(idCVarSystem), idCVarSystem_typeInfo },
 	{ "MemInfo_t", "", sizeof(MemInfo_t), MemInfo_t_typeInfo },
 	{ "idCommon", "", sizeof(idCommon), idCommon_typeInfo },
+	{ "idJobCounter", "", sizeof(idJobCounter), idJobCounter_typeInfo },
+	{ "idJobSystem", "", sizeof(idJobSystem), idJobSystem_typeInfo },
 	{ "idFile", "", sizeof(idFile), idFile_typeInfo },
 	{ "idFile_Memory", "idFile", sizeof(idFile_Memory), idFile_Memory_typeInfo },
 	{ "idFile_BitMsg", "idFile", sizeof(idFile_BitMsg), idFile_BitMsg_typeInfo },
@@ -8350,10 +8502,14 @@ static classTypeInfo_t classTypeInfo[] = {
 	{ "idMultiplayerGame", "", sizeof(idMultiplayerGame), idMultiplayerGame_typeInfo },
 	{ "entityState_t", "", sizeof(entityState_t), entityState_t_typeInfo },
 	{ "snapshot_t", "", sizeof(snapshot_t), snapshot_t_typeInfo },
+	{ "snapshotEncode_t", "", sizeof(snapshotEncode_t), snapshotEncode_t_typeInfo },
 	{ "entityNetEvent_t", "", sizeof(entityNetEvent_t), entityNetEvent_t_typeInfo },
 	{ "spawnSpot_t", "", sizeof(spawnSpot_t), spawnSpot_t_typeInfo },
 	{ "idEventQueue", "", sizeof(idEventQueue), idEventQueue_typeInfo },
 //	{ "idEntityPtr< class type >", "", sizeof(idEntityPtr< class type >), idEntityPtr_class_type__typeInfo },
+	{ "thinkCommand_t", "", sizeof(thinkCommand_t), thinkCommand_t_typeInfo },
+	{ "thinkCollision_t", "", sizeof(thinkCollision_t), thinkCollision_t_typeInfo },
+	{ "thinkIsland_t", "", sizeof(thinkIsland_t), thinkIsland_t_typeInfo },
 	{ "idGameLocal", "idGame", sizeof(idGameLocal), idGameLocal_typeInfo },
 	{ "idGameError", "idException", sizeof(idGameError), idGameError_typeInfo },
 	{ "idForce", "idClass", sizeof(idForce), idForce_typeInfo },
@@ -1298,6 +1298,24 @@ static void Cmd_ListCollisionModels_f( const idCmdArgs &args ) {
 	collisionModelManager->ListModels();
 }
 
+/*
+==================
+Cmd_RecordClipQueries_f
+==================
+*/
+static void Cmd_RecordClipQueries_f( const idCmdArgs &args ) {
+	gameLocal.clip.RecordQueries( ( args.Argc() > 1 ) ? args.Argv( 1 ) : "clipQueries.dat" );
+}
+
+/*
+==================
+Cmd_BenchClipQueries_f
+==================
+*/
+static void Cmd_BenchClipQueries_f( const idCmdArgs &args ) {
+	gameLocal.clip.BenchQueries( ( args.Argc() > 1 ) ? args.Argv( 1 ) : "clipQueries.dat" );
+}
+
 /*
 ==================
 Cmd_CollisionModelInfo_f
@@ -2351,6 +2369,8 @@ void idGameLocal::InitConsoleCommands( void ) {
 	cmdSystem->AddCommand( "script",				Cmd_Script_f,				CMD_FL_GAME|CMD_FL_CHEAT,	"executes a line of script" );
 	cmdSystem->AddCommand( "listCollisionModels",	Cmd_ListCollisionModels_f,	CMD_FL_GAME,				"lists collision models" );
 	cmdSystem->AddCommand( "collisionModelInfo",	Cmd_CollisionModelInfo_f,	CMD_FL_GAME,				"shows collision model info" );
+	cmdSystem->AddCommand( "recordClipQueries",		Cmd_RecordClipQueries_f,	CMD_FL_GAME,				"starts or stops recording clip model queries to a file" );
+	cmdSystem->AddCommand( "benchClipQueries",		Cmd_BenchClipQueries_f,		CMD_FL_GAME,				"replays recorded clip model queries against the clip tree" );
 	cmdSystem->AddCommand( "reexportmodels",		Cmd_ReexportModels_f,		CMD_FL_GAME|CMD_FL_CHEAT,	"reexports models", ArgCompletion_DefFile );
 	cmdSystem->AddCommand( "reloadanims",			Cmd_ReloadAnims_f,			CMD_FL_GAME|CMD_FL_CHEAT,	"reloads animations" );
 	cmdSystem->AddCommand( "listAnims",				Cmd_ListAnims_f,			CMD_FL_GAME,				"lists all animations" );
@@ -2388,6 +2408,7 @@ void idGameLocal::InitConsoleCommands( void ) {
 	cmdSystem->AddCommand( "serverMapRestart",		idGameLocal::MapRestart_f,	CMD_FL_GAME,				"restart the current game" );
 	cmdSystem->AddCommand( "serverForceReady",	idMultiplayerGame::ForceReady_f,CMD_FL_GAME,				"force all players ready" );
 	cmdSystem->AddCommand( "serverNextMap",			idGameLocal::NextMap_f,		CMD_FL_GAME,				"change to the next map" );
+	cmdSystem->AddCommand( "benchSnapshots",		idGameLocal::BenchSnapshots_f,	CMD_FL_GAME,			"benchmark the snapshot encode cache with fake clients: benchSnapshots [numClients] [numFrames]" );
 #endif
 
 	// localization help commands
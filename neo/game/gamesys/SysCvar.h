@@ -83,6 +83,7 @@ extern idCVar	g_showEnemies;
 
 extern idCVar	g_frametime;
 extern idCVar	g_timeentities;
+extern idCVar	g_parallelThink;
 
 extern idCVar	ai_debugScript;
 extern idCVar	ai_debugMove;
@@ -91,6 +92,7 @@ extern idCVar	ai_testPredictPath;
 extern idCVar	ai_showCombatNodes;
 extern idCVar	ai_showPaths;
 extern idCVar	ai_showObstacleAvoidance;
+extern idCVar	ai_pathBudget;
 extern idCVar	ai_blockedFailSafe;
 
 extern idCVar	g_dvTime;
@@ -157,6 +159,8 @@ extern idCVar	rb_showMass;
 extern idCVar	rb_showInertia;
 extern idCVar	rb_showVelocity;
 extern idCVar	rb_showActive;
+extern idCVar	rb_sleepIslands;
+extern idCVar	rb_sleepTime;
 
 extern idCVar	pm_jumpheight;
 extern idCVar	pm_stepsize;
@@ -232,6 +236,7 @@ extern idCVar	aas_pullPlayer;
 extern idCVar	aas_randomPullPlayer;
 extern idCVar	aas_goalArea;
 extern idCVar	aas_showPushIntoArea;
+extern idCVar	aas_routingJobs;
 
 extern idCVar	net_clientPredictGUI;
 
@@ -31,23 +31,18 @@ If you have questions concerning this license or the applicable additional terms
 
 #include "../Game_local.h"
 
-#define	MAX_SECTOR_DEPTH				12
-#define MAX_SECTORS						((1<<(MAX_SECTOR_DEPTH+1))-1)
-
-typedef struct clipSector_s {
-	int						axis;		// -1 = leaf node
-	float					dist;
-	struct clipSector_s *	children[2];
-	struct clipLink_s *		clipLinks;
-} clipSector_t;
-
-typedef struct clipLink_s {
-	idClipModel *			clipModel;
-	struct clipSector_s *	sector;
-	struct clipLink_s *		prevInSector;
-	struct clipLink_s *		nextInSector;
-	struct clipLink_s *		nextLink;
-} clipLink_t;
+#define CLIP_NODE_MARGIN				8.0f		// leaf bounds in the clip tree are expanded so small moves do not change the tree
+#define MAX_CLIP_TREE_DEPTH				256			// size of the clip tree traversal stack
+#define CLIP_NODE_GRANULARITY			1024
+#define CLIP_BATCH_SIZE					32			// number of bounds tested at once by batch queries
+
+typedef struct clipNode_s {
+	idBounds				bounds;			// fat bounds for leaves, union of the children for inner nodes
+	int						parent;			// next free node if the node is not used
+	int						children[2];	// -1 for leaves
+	int						height;			// 0 for leaves, -1 for free nodes
+	idClipModel *			clipModel;		// clip model of a leaf
+} clipNode_t;
 
 typedef struct trmCache_s {
 	idTraceModel			trm;
@@ -59,7 +54,51 @@ typedef struct trmCache_s {
 
 idVec3 vec3_boxEpsilon( CM_BOX_EPSILON, CM_BOX_EPSILON, CM_BOX_EPSILON );
 
-idBlockAlloc<clipLink_t, 1024>	clipLinkAllocator;
+static idFile *					clipQueryFile = NULL;		// file with recorded clip model queries
+
+/*
+================
+ClipNodeCost
+
+  surface area heuristic used to pick the sibling of a new leaf
+================
+*/
+static ID_INLINE float ClipNodeCost( const idBounds &bounds ) {
+	idVec3 size = bounds[1] - bounds[0];
+	return size[0] * size[1] + size[1] * size[2] + size[2] * size[0];
+}
+
+/*
+================
+ClipBoundsContain
+================
+*/
+static ID_INLINE bool ClipBoundsContain( const idBounds &outer, const idBounds &inner ) {
+	return	inner[0][0] >= outer[0][0] && inner[0][1] >= outer[0][1] && inner[0][2] >= outer[0][2] &&
+			inner[1][0] <= outer[1][0] && inner[1][1] <= outer[1][1] && inner[1][2] <= outer[1][2];
+}
+
+/*
+================
+ClipBoundsOverlap
+================
+*/
+static ID_INLINE bool ClipBoundsOverlap( const idBounds &a, const idBounds &b ) {
+	return !(	a[0][0] > b[1][0] || a[1][0] < b[0][0] ||
+				a[0][1] > b[1][1] || a[1][1] < b[0][1] ||
+				a[0][2] > b[1][2] || a[1][2] < b[0][2] );
+}
+
+/*
+================
+RecordClipQuery
+================
+*/
+static void RecordClipQuery( const idBounds &bounds, int contentMask ) {
+	clipQueryFile->WriteVec3( bounds[0] );
+	clipQueryFile->WriteVec3( bounds[1] );
+	clipQueryFile->WriteInt( contentMask );
+}
 
 
 /*
@@ -283,8 +322,9 @@ void idClipModel::Init( void ) {
 	collisionModelHandle = 0;
 	renderModelHandle = -1;
 	traceModelIndex = -1;
-	clipLinks = NULL;
-	touchCount = -1;
+	clip = NULL;
+	clipNode = -1;
+	linked = false;
 }
 
 /*
@@ -349,8 +389,9 @@ idClipModel::idClipModel( const idClipModel *model ) {
 		LoadModel( *GetCachedTraceModel( model->traceModelIndex ) );
 	}
 	renderModelHandle = model->renderModelHandle;
-	clipLinks = NULL;
-	touchCount = -1;
+	clip = NULL;
+	clipNode = -1;
+	linked = false;
 }
 
 /*
@@ -359,8 +400,8 @@ idClipModel::~idClipModel
 ================
 */
 idClipModel::~idClipModel( void ) {
-	// make sure the clip model is no longer linked
-	Unlink();
+	// make sure the clip model is no longer in the clip tree
+	RemoveFromTree();
 	if ( traceModelIndex != -1 ) {
 		FreeTraceModel( traceModelIndex );
 	}
@@ -389,8 +430,8 @@ void idClipModel::Save( idSaveGame *savefile ) const {
 	}
 	savefile->WriteInt( traceModelIndex );
 	savefile->WriteInt( renderModelHandle );
-	savefile->WriteBool( clipLinks != NULL );
-	savefile->WriteInt( touchCount );
+	savefile->WriteBool( linked );
+	savefile->WriteInt( -1 );	// touch count of the old clip sectors
 }
 
 /*
@@ -400,7 +441,8 @@ idClipModel::Restore
 */
 void idClipModel::Restore( idRestoreGame *savefile ) {
 	idStr collisionModelName;
-	bool linked;
+	bool isLinked;
+	int touchCount;
 
 	savefile->ReadBool( enabled );
 	savefile->ReadObject( reinterpret_cast<idClass *&>( entity ) );
@@ -423,15 +465,14 @@ void idClipModel::Restore( idRestoreGame *savefile ) {
 		traceModelCache[traceModelIndex]->refCount++;
 	}
 	savefile->ReadInt( renderModelHandle );
-	savefile->ReadBool( linked );
+	savefile->ReadBool( isLinked );
 	savefile->ReadInt( touchCount );
 
 	// the render model will be set when the clip model is linked
 	renderModelHandle = -1;
-	clipLinks = NULL;
-	touchCount = -1;
+	RemoveFromTree();
 
-	if ( linked ) {
+	if ( isLinked ) {
 		Link( gameLocal.clip, entity, id, origin, axis, renderModelHandle );
 	}
 }
@@ -442,7 +483,7 @@ idClipModel::SetPosition
 ================
 */
 void idClipModel::SetPosition( const idVec3 &newOrigin, const idMat3 &newAxis ) {
-	if ( clipLinks ) {
+	if ( linked ) {
 		Unlink();	// unlink from old position
 	}
 	origin = newOrigin;
@@ -486,55 +527,29 @@ void idClipModel::GetMassProperties( const float density, float &mass, idVec3 &c
 /*
 ===============
 idClipModel::Unlink
+
+  the clip model stays in the clip tree so relinking at a nearby position is cheap
 ===============
 */
 void idClipModel::Unlink( void ) {
-	clipLink_t *link;
-
-	for ( link = clipLinks; link; link = clipLinks ) {
-		clipLinks = link->nextLink;
-		if ( link->prevInSector ) {
-			link->prevInSector->nextInSector = link->nextInSector;
-		} else {
-			link->sector->clipLinks = link->nextInSector;
-		}
-		if ( link->nextInSector ) {
-			link->nextInSector->prevInSector = link->prevInSector;
-		}
-		clipLinkAllocator.Free( link );
-	}
+	linked = false;
 }
 
 /*
 ===============
-idClipModel::Link_r
+idClipModel::RemoveFromTree
 ===============
 */
-void idClipModel::Link_r( struct clipSector_s *node ) {
-	clipLink_t *link;
-
-	while( node->axis != -1 ) {
-		if ( absBounds[0][node->axis] > node->dist ) {
-			node = node->children[0];
-		} else if ( absBounds[1][node->axis] < node->dist ) {
-			node = node->children[1];
-		} else {
-			Link_r( node->children[0] );
-			node = node->children[1];
-		}
-	}
-
-	link = clipLinkAllocator.Alloc();
-	link->clipModel = this;
-	link->sector = node;
-	link->nextInSector = node->clipLinks;
-	link->prevInSector = NULL;
-	if ( node->clipLinks ) {
-		node->clipLinks->prevInSector = link;
-	}
-	node->clipLinks = link;
-	link->nextLink = clipLinks;
-	clipLinks = link;
+void idClipModel::RemoveFromTree( void ) {
+	if ( clipNode != -1 ) {
+		clip->treeLock.Lock();
+		clip->RemoveLeaf( clipNode );
+		clip->FreeClipNode( clipNode );
+		clip->treeLock.Unlock();
+		clipNode = -1;
+	}
+	clip = NULL;
+	linked = false;
 }
 
 /*
@@ -543,36 +558,44 @@ idClipModel::Link
 ===============
 */
 void idClipModel::Link( idClip &clp ) {
+	idBounds newAbsBounds;
 
 	assert( idClipModel::entity );
 	if ( !idClipModel::entity ) {
 		return;
 	}
 
-	if ( clipLinks ) {
-		Unlink();	// unlink from old position
-	}
-
 	if ( bounds.IsCleared() ) {
+		if ( linked ) {
+			Unlink();	// unlink from old position
+		}
 		return;
 	}
 
 	// set the abs box
 	if ( axis.IsRotated() ) {
 		// expand for rotation
-		absBounds.FromTransformedBounds( bounds, origin, axis );
+		newAbsBounds.FromTransformedBounds( bounds, origin, axis );
 	} else {
 		// normal
-		absBounds[0] = bounds[0] + origin;
-		absBounds[1] = bounds[1] + origin;
+		newAbsBounds[0] = bounds[0] + origin;
+		newAbsBounds[1] = bounds[1] + origin;
 	}
 
 	// because movement is clipped an epsilon away from an actual edge,
 	// we must fully check even when bounding boxes don't quite touch
-	absBounds[0] -= vec3_boxEpsilon;
-	absBounds[1] += vec3_boxEpsilon;
+	newAbsBounds[0] -= vec3_boxEpsilon;
+	newAbsBounds[1] += vec3_boxEpsilon;
+
+	if ( clip != &clp ) {
+		RemoveFromTree();
+	}
 
-	Link_r( clp.clipSectors );
+	// the abs box is read by queries from other threads when entities think in parallel
+	clp.treeLock.Lock();
+	absBounds = newAbsBounds;
+	clp.LinkClipModel( this );
+	clp.treeLock.Unlock();
 }
 
 /*
@@ -620,60 +643,333 @@ idClip::idClip
 ===============
 */
 idClip::idClip( void ) {
-	numClipSectors = 0;
-	clipSectors = NULL;
+	clipNodes = NULL;
+	maxClipNodes = 0;
+	numClipNodes = 0;
+	freeClipNode = -1;
+	clipRoot = -1;
 	worldBounds.Zero();
 	numRotations = numTranslations = numMotions = numRenderModelTraces = numContents = numContacts = 0;
 }
 
 /*
 ===============
-idClip::CreateClipSectors_r
+idClip::AllocClipNode
+===============
+*/
+int idClip::AllocClipNode( void ) {
+	int i, nodeNum, newMaxClipNodes;
+	clipNode_t *node, *newClipNodes;
+
+	if ( freeClipNode == -1 ) {
+		newMaxClipNodes = maxClipNodes ? maxClipNodes * 2 : CLIP_NODE_GRANULARITY;
+		newClipNodes = new clipNode_t[newMaxClipNodes];
+		if ( clipNodes ) {
+			for ( i = 0; i < maxClipNodes; i++ ) {
+				newClipNodes[i] = clipNodes[i];
+			}
+			delete[] clipNodes;
+		}
+		for ( i = maxClipNodes; i < newMaxClipNodes; i++ ) {
+			newClipNodes[i].parent = i + 1;
+			newClipNodes[i].height = -1;
+			newClipNodes[i].clipModel = NULL;
+		}
+		newClipNodes[newMaxClipNodes - 1].parent = -1;
+		freeClipNode = maxClipNodes;
+		clipNodes = newClipNodes;
+		maxClipNodes = newMaxClipNodes;
+	}
+
+	nodeNum = freeClipNode;
+	node = &clipNodes[nodeNum];
+	freeClipNode = node->parent;
+	node->parent = -1;
+	node->children[0] = node->children[1] = -1;
+	node->height = 0;
+	node->clipModel = NULL;
+	numClipNodes++;
+
+	return nodeNum;
+}
+
+/*
+===============
+idClip::FreeClipNode
+===============
+*/
+void idClip::FreeClipNode( int nodeNum ) {
+	clipNode_t *node = &clipNodes[nodeNum];
+
+	assert( node->height >= 0 );
+	node->parent = freeClipNode;
+	node->height = -1;
+	node->clipModel = NULL;
+	freeClipNode = nodeNum;
+	numClipNodes--;
+}
+
+/*
+===============
+idClip::BalanceNode
 
-Builds a uniformly subdivided tree for the given world size
+  rotates the higher child up if the children of the node are unbalanced,
+  returns the node now at the position of the given node
 ===============
 */
-clipSector_t *idClip::CreateClipSectors_r( const int depth, const idBounds &bounds, idVec3 &maxSector ) {
-	int				i;
-	clipSector_t	*anode;
-	idVec3			size;
-	idBounds		front, back;
+int idClip::BalanceNode( int nodeNum ) {
+	int b, c, balance;
+	clipNode_t *a, *nodeB, *nodeC;
 
-	anode = &clipSectors[idClip::numClipSectors];
-	idClip::numClipSectors++;
+	a = &clipNodes[nodeNum];
+	if ( a->children[0] == -1 || a->height < 2 ) {
+		return nodeNum;
+	}
 
-	if ( depth == MAX_SECTOR_DEPTH ) {
-		anode->axis = -1;
-		anode->children[0] = anode->children[1] = NULL;
+	b = a->children[0];
+	c = a->children[1];
+	nodeB = &clipNodes[b];
+	nodeC = &clipNodes[c];
 
-		for ( i = 0; i < 3; i++ ) {
-			if ( bounds[1][i] - bounds[0][i] > maxSector[i] ) {
-				maxSector[i] = bounds[1][i] - bounds[0][i];
+	balance = nodeC->height - nodeB->height;
+
+	if ( balance > 1 ) {
+		// rotate C up
+		int f = nodeC->children[0];
+		int g = nodeC->children[1];
+		clipNode_t *nodeF = &clipNodes[f];
+		clipNode_t *nodeG = &clipNodes[g];
+
+		nodeC->children[0] = nodeNum;
+		nodeC->parent = a->parent;
+		a->parent = c;
+
+		if ( nodeC->parent != -1 ) {
+			clipNode_t *parent = &clipNodes[nodeC->parent];
+			parent->children[ parent->children[0] == nodeNum ? 0 : 1 ] = c;
+		} else {
+			clipRoot = c;
+		}
+
+		if ( nodeF->height > nodeG->height ) {
+			nodeC->children[1] = f;
+			a->children[1] = g;
+			nodeG->parent = nodeNum;
+			a->bounds = nodeB->bounds + nodeG->bounds;
+			nodeC->bounds = a->bounds + nodeF->bounds;
+			a->height = 1 + Max( nodeB->height, nodeG->height );
+			nodeC->height = 1 + Max( a->height, nodeF->height );
+		} else {
+			nodeC->children[1] = g;
+			a->children[1] = f;
+			nodeF->parent = nodeNum;
+			a->bounds = nodeB->bounds + nodeF->bounds;
+			nodeC->bounds = a->bounds + nodeG->bounds;
+			a->height = 1 + Max( nodeB->height, nodeF->height );
+			nodeC->height = 1 + Max( a->height, nodeG->height );
+		}
+		return c;
+	}
+
+	if ( balance < -1 ) {
+		// rotate B up
+		int d = nodeB->children[0];
+		int e = nodeB->children[1];
+		clipNode_t *nodeD = &clipNodes[d];
+		clipNode_t *nodeE = &clipNodes[e];
+
+		nodeB->children[0] = nodeNum;
+		nodeB->parent = a->parent;
+		a->parent = b;
+
+		if ( nodeB->parent != -1 ) {
+			clipNode_t *parent = &clipNodes[nodeB->parent];
+			parent->children[ parent->children[0] == nodeNum ? 0 : 1 ] = b;
+		} else {
+			clipRoot = b;
+		}
+
+		if ( nodeD->height > nodeE->height ) {
+			nodeB->children[1] = d;
+			a->children[0] = e;
+			nodeE->parent = nodeNum;
+			a->bounds = nodeC->bounds + nodeE->bounds;
+			nodeB->bounds = a->bounds + nodeD->bounds;
+			a->height = 1 + Max( nodeC->height, nodeE->height );
+			nodeB->height = 1 + Max( a->height, nodeD->height );
+		} else {
+			nodeB->children[1] = e;
+			a->children[0] = d;
+			nodeD->parent = nodeNum;
+			a->bounds = nodeC->bounds + nodeD->bounds;
+			nodeB->bounds = a->bounds + nodeE->bounds;
+			a->height = 1 + Max( nodeC->height, nodeD->height );
+			nodeB->height = 1 + Max( a->height, nodeE->height );
+		}
+		return b;
+	}
+
+	return nodeNum;
+}
+
+/*
+===============
+idClip::InsertLeaf
+
+  the leaf is paired with the sibling that least increases the surface area of the tree
+===============
+*/
+void idClip::InsertLeaf( int leaf ) {
+	int nodeNum, sibling, oldParent, newParent, i;
+	float area, combinedArea, cost, inheritanceCost, childCost[2];
+	idBounds leafBounds;
+	clipNode_t *node;
+
+	if ( clipRoot == -1 ) {
+		clipRoot = leaf;
+		clipNodes[leaf].parent = -1;
+		return;
+	}
+
+	// find the best sibling
+	leafBounds = clipNodes[leaf].bounds;
+	nodeNum = clipRoot;
+	while( clipNodes[nodeNum].children[0] != -1 ) {
+		node = &clipNodes[nodeNum];
+
+		area = ClipNodeCost( node->bounds );
+		combinedArea = ClipNodeCost( node->bounds + leafBounds );
+
+		// cost of creating a new parent for this node and the new leaf
+		cost = 2.0f * combinedArea;
+		// minimum cost of pushing the leaf further down the tree
+		inheritanceCost = 2.0f * ( combinedArea - area );
+
+		for ( i = 0; i < 2; i++ ) {
+			const clipNode_t *child = &clipNodes[node->children[i]];
+			if ( child->children[0] == -1 ) {
+				childCost[i] = ClipNodeCost( child->bounds + leafBounds ) + inheritanceCost;
+			} else {
+				childCost[i] = ClipNodeCost( child->bounds + leafBounds ) - ClipNodeCost( child->bounds ) + inheritanceCost;
 			}
 		}
-		return anode;
+
+		if ( cost < childCost[0] && cost < childCost[1] ) {
+			break;
+		}
+
+		nodeNum = node->children[ childCost[0] < childCost[1] ? 0 : 1 ];
 	}
+	sibling = nodeNum;
+
+	// create a new parent, this may reallocate the nodes
+	oldParent = clipNodes[sibling].parent;
+	newParent = AllocClipNode();
+	node = &clipNodes[newParent];
+	node->parent = oldParent;
+	node->bounds = leafBounds + clipNodes[sibling].bounds;
+	node->height = clipNodes[sibling].height + 1;
+	node->children[0] = sibling;
+	node->children[1] = leaf;
 
-	size = bounds[1] - bounds[0];
-	if ( size[0] >= size[1] && size[0] >= size[2] ) {
-		anode->axis = 0;
-	} else if ( size[1] >= size[0] && size[1] >= size[2] ) {
-		anode->axis = 1;
+	if ( oldParent != -1 ) {
+		clipNode_t *parent = &clipNodes[oldParent];
+		parent->children[ parent->children[0] == sibling ? 0 : 1 ] = newParent;
 	} else {
-		anode->axis = 2;
+		clipRoot = newParent;
 	}
+	clipNodes[sibling].parent = newParent;
+	clipNodes[leaf].parent = newParent;
 
-	anode->dist = 0.5f * ( bounds[1][anode->axis] + bounds[0][anode->axis] );
+	// walk back up the tree fixing heights and bounds
+	for ( nodeNum = clipNodes[leaf].parent; nodeNum != -1; nodeNum = clipNodes[nodeNum].parent ) {
+		nodeNum = BalanceNode( nodeNum );
+		node = &clipNodes[nodeNum];
+		node->height = 1 + Max( clipNodes[node->children[0]].height, clipNodes[node->children[1]].height );
+		node->bounds = clipNodes[node->children[0]].bounds + clipNodes[node->children[1]].bounds;
+	}
+}
 
-	front = bounds;
-	back = bounds;
-	
-	front[0][anode->axis] = back[1][anode->axis] = anode->dist;
-	
-	anode->children[0] = CreateClipSectors_r( depth+1, front, maxSector );
-	anode->children[1] = CreateClipSectors_r( depth+1, back, maxSector );
+/*
+===============
+idClip::RemoveLeaf
+===============
+*/
+void idClip::RemoveLeaf( int leaf ) {
+	int parent, grandParent, sibling, nodeNum;
+	clipNode_t *node;
+
+	if ( leaf == clipRoot ) {
+		clipRoot = -1;
+		return;
+	}
+
+	parent = clipNodes[leaf].parent;
+	grandParent = clipNodes[parent].parent;
+	sibling = clipNodes[parent].children[ clipNodes[parent].children[0] == leaf ? 1 : 0 ];
+
+	clipNodes[leaf].parent = -1;
+
+	if ( grandParent == -1 ) {
+		clipRoot = sibling;
+		clipNodes[sibling].parent = -1;
+		FreeClipNode( parent );
+		return;
+	}
 
-	return anode;
+	// replace the parent with the sibling
+	node = &clipNodes[grandParent];
+	node->children[ node->children[0] == parent ? 0 : 1 ] = sibling;
+	clipNodes[sibling].parent = grandParent;
+	FreeClipNode( parent );
+
+	for ( nodeNum = grandParent; nodeNum != -1; nodeNum = clipNodes[nodeNum].parent ) {
+		nodeNum = BalanceNode( nodeNum );
+		node = &clipNodes[nodeNum];
+		node->height = 1 + Max( clipNodes[node->children[0]].height, clipNodes[node->children[1]].height );
+		node->bounds = clipNodes[node->children[0]].bounds + clipNodes[node->children[1]].bounds;
+	}
+}
+
+/*
+===============
+idClip::LinkClipModel
+
+  refits the leaf of the clip model only when the clip model moved out of the fat leaf bounds,
+  the caller removes the clip model from any other tree and holds the tree lock
+===============
+*/
+void idClip::LinkClipModel( idClipModel *clipModel ) {
+	int leaf;
+
+	assert( clipModel->clip == this || clipModel->clipNode == -1 );
+
+	leaf = clipModel->clipNode;
+	if ( leaf != -1 ) {
+		if ( ClipBoundsContain( clipNodes[leaf].bounds, clipModel->absBounds ) ) {
+			clipModel->linked = true;
+			return;
+		}
+		RemoveLeaf( leaf );
+	} else {
+		leaf = AllocClipNode();
+		clipNodes[leaf].clipModel = clipModel;
+		clipModel->clip = this;
+		clipModel->clipNode = leaf;
+	}
+
+	clipNodes[leaf].bounds = clipModel->absBounds.Expand( CLIP_NODE_MARGIN );
+	InsertLeaf( leaf );
+	clipModel->linked = true;
+}
+
+/*
+===============
+idClip::ClipTreeHeight
+===============
+*/
+int idClip::ClipTreeHeight( void ) const {
+	return ( clipRoot != -1 ) ? clipNodes[clipRoot].height : 0;
 }
 
 /*
@@ -683,22 +979,20 @@ idClip::Init
 */
 void idClip::Init( void ) {
 	cmHandle_t h;
-	idVec3 size, maxSector = vec3_origin;
-
-	// clear clip sectors
-	clipSectors = new clipSector_t[MAX_SECTORS];
-	memset( clipSectors, 0, MAX_SECTORS * sizeof( clipSector_t ) );
-	numClipSectors = 0;
-	touchCount = -1;
+	idVec3 size;
+
+	// clear the clip tree
+	clipNodes = NULL;
+	maxClipNodes = 0;
+	numClipNodes = 0;
+	freeClipNode = -1;
+	clipRoot = -1;
 	// get world map bounds
 	h = collisionModelManager->LoadModel( "worldMap", false );
 	collisionModelManager->GetModelBounds( h, worldBounds );
-	// create world sectors
-	CreateClipSectors_r( 0, worldBounds, maxSector );
 
 	size = worldBounds[1] - worldBounds[0];
 	gameLocal.Printf( "map bounds are (%1.1f, %1.1f, %1.1f)\n", size[0], size[1], size[2] );
-	gameLocal.Printf( "max clip sector is (%1.1f, %1.1f, %1.1f)\n", maxSector[0], maxSector[1], maxSector[2] );
 
 	// initialize a default clip model
 	defaultClipModel.LoadModel( idTraceModel( idBounds( idVec3( 0, 0, 0 ) ).Expand( 8 ) ) );
@@ -713,8 +1007,22 @@ idClip::Shutdown
 ===============
 */
 void idClip::Shutdown( void ) {
-	delete[] clipSectors;
-	clipSectors = NULL;
+	int i;
+
+	// clip models that outlive the clip tree are no longer in it
+	for ( i = 0; i < maxClipNodes; i++ ) {
+		if ( clipNodes[i].height == 0 && clipNodes[i].clipModel ) {
+			clipNodes[i].clipModel->clip = NULL;
+			clipNodes[i].clipModel->clipNode = -1;
+			clipNodes[i].clipModel->linked = false;
+		}
+	}
+	delete[] clipNodes;
+	clipNodes = NULL;
+	maxClipNodes = 0;
+	numClipNodes = 0;
+	freeClipNode = -1;
+	clipRoot = -1;
 
 	// free the trace model used for the temporaryClipModel
 	if ( temporaryClipModel.traceModelIndex != -1 ) {
@@ -728,101 +1036,202 @@ void idClip::Shutdown( void ) {
 		defaultClipModel.traceModelIndex = -1;
 	}
 
-	clipLinkAllocator.Shutdown();
+	// recorded queries only make sense for this map
+	if ( clipQueryFile ) {
+		fileSystem->CloseFile( clipQueryFile );
+		clipQueryFile = NULL;
+	}
 }
 
 /*
-====================
-idClip::ClipModelsTouchingBounds_r
-====================
+================
+idClip::ClipModelsTouchingBounds
+================
 */
-typedef struct listParms_s {
-	idBounds		bounds;
-	int				contentMask;
-	idClipModel	**	list;
-	int				count;
-	int				maxCount;
-} listParms_t;
-
-void idClip::ClipModelsTouchingBounds_r( const struct clipSector_s *node, listParms_t &parms ) const {
-
-	while( node->axis != -1 ) {
-		if ( parms.bounds[0][node->axis] > node->dist ) {
-			node = node->children[0];
-		} else if ( parms.bounds[1][node->axis] < node->dist ) {
-			node = node->children[1];
-		} else {
-			ClipModelsTouchingBounds_r( node->children[0], parms );
-			node = node->children[1];
-		}
+int idClip::ClipModelsTouchingBounds( const idBounds &bounds, int contentMask, idClipModel **clipModelList, int maxCount ) const {
+	int stack[MAX_CLIP_TREE_DEPTH];
+	int sp, count;
+	idBounds queryBounds;
+
+	if (	bounds[0][0] > bounds[1][0] ||
+			bounds[0][1] > bounds[1][1] ||
+			bounds[0][2] > bounds[1][2] ) {
+		// we should not go through the tree for degenerate or backwards bounds
+		assert( false );
+		return 0;
+	}
+
+	queryBounds[0] = bounds[0] - vec3_boxEpsilon;
+	queryBounds[1] = bounds[1] + vec3_boxEpsilon;
+
+	treeLock.Lock();
+
+	// the lock also keeps the queries of parallel thinking entities from interleaving in the file
+	if ( clipQueryFile ) {
+		RecordClipQuery( bounds, contentMask );
 	}
 
-	for ( clipLink_t *link = node->clipLinks; link; link = link->nextInSector ) {
-		idClipModel	*check = link->clipModel;
+	if ( clipRoot == -1 ) {
+		treeLock.Unlock();
+		return 0;
+	}
+
+	count = 0;
+	stack[0] = clipRoot;
+	sp = 1;
+	while( sp > 0 ) {
+		const clipNode_t *node = &clipNodes[stack[--sp]];
+
+		if ( !ClipBoundsOverlap( node->bounds, queryBounds ) ) {
+			continue;
+		}
 
-		// if the clip model is enabled
-		if ( !check->enabled ) {
+		if ( node->children[0] != -1 ) {
+			assert( sp + 2 <= MAX_CLIP_TREE_DEPTH );
+			stack[sp++] = node->children[1];
+			stack[sp++] = node->children[0];
 			continue;
 		}
 
-		// avoid duplicates in the list
-		if ( check->touchCount == touchCount ) {
+		idClipModel	*check = node->clipModel;
+
+		// if the clip model is linked and enabled
+		if ( !check->linked || !check->enabled ) {
 			continue;
 		}
 
 		// if the clip model does not have any contents we are looking for
-		if ( !( check->contents & parms.contentMask ) ) {
+		if ( !( check->contents & contentMask ) ) {
 			continue;
 		}
 
 		// if the bounds really do overlap
-		if (	check->absBounds[0][0] > parms.bounds[1][0] ||
-				check->absBounds[1][0] < parms.bounds[0][0] ||
-				check->absBounds[0][1] > parms.bounds[1][1] ||
-				check->absBounds[1][1] < parms.bounds[0][1] ||
-				check->absBounds[0][2] > parms.bounds[1][2] ||
-				check->absBounds[1][2] < parms.bounds[0][2] ) {
+		if ( !ClipBoundsOverlap( check->absBounds, queryBounds ) ) {
 			continue;
 		}
 
-		if ( parms.count >= parms.maxCount ) {
-			gameLocal.Warning( "idClip::ClipModelsTouchingBounds_r: max count" );
-			return;
+		if ( count >= maxCount ) {
+			treeLock.Unlock();
+			gameLocal.Warning( "idClip::ClipModelsTouchingBounds: max count" );
+			return count;
 		}
 
-		check->touchCount = touchCount;
-		parms.list[parms.count] = check;
-		parms.count++;
+		clipModelList[count] = check;
+		count++;
 	}
+
+	treeLock.Unlock();
+
+	return count;
 }
 
 /*
 ================
 idClip::ClipModelsTouchingBounds
+
+  walks the clip tree once for up to CLIP_BATCH_SIZE bounds at a time,
+  every stack entry keeps a bit mask with the bounds that touch the node
 ================
 */
-int idClip::ClipModelsTouchingBounds( const idBounds &bounds, int contentMask, idClipModel **clipModelList, int maxCount ) const {
-	listParms_t parms;
+void idClip::ClipModelsTouchingBounds( const idBounds *bounds, int numBounds, int contentMask, idClipModel **clipModelLists, int maxCount, int *counts ) const {
+	int stack[MAX_CLIP_TREE_DEPTH];
+	unsigned int stackMask[MAX_CLIP_TREE_DEPTH];
+	int first, num, i, sp;
+	unsigned int mask, touchMask;
+	idBounds queryBounds[CLIP_BATCH_SIZE];
 
-	if (	bounds[0][0] > bounds[1][0] ||
-			bounds[0][1] > bounds[1][1] ||
-			bounds[0][2] > bounds[1][2] ) {
-		// we should not go through the tree for degenerate or backwards bounds
-		assert( false );
-		return 0;
-	}
+	for ( first = 0; first < numBounds; first += CLIP_BATCH_SIZE ) {
+		num = Min( numBounds - first, CLIP_BATCH_SIZE );
 
-	parms.bounds[0] = bounds[0] - vec3_boxEpsilon;
-	parms.bounds[1] = bounds[1] + vec3_boxEpsilon;
-	parms.contentMask = contentMask;
-	parms.list = clipModelList;
-	parms.count = 0;
-	parms.maxCount = maxCount;
+		mask = 0;
+		for ( i = 0; i < num; i++ ) {
+			const idBounds &b = bounds[first + i];
+
+			counts[first + i] = 0;
+
+			if ( b[0][0] > b[1][0] || b[0][1] > b[1][1] || b[0][2] > b[1][2] ) {
+				// we should not go through the tree for degenerate or backwards bounds
+				assert( false );
+				continue;
+			}
+
+			queryBounds[i][0] = b[0] - vec3_boxEpsilon;
+			queryBounds[i][1] = b[1] + vec3_boxEpsilon;
+			mask |= 1u << i;
+		}
+
+		if ( !mask ) {
+			continue;
+		}
 
-	touchCount++;
-	ClipModelsTouchingBounds_r( clipSectors, parms );
+		treeLock.Lock();
 
-	return parms.count;
+		if ( clipQueryFile ) {
+			for ( i = 0; i < num; i++ ) {
+				if ( mask & ( 1u << i ) ) {
+					RecordClipQuery( bounds[first + i], contentMask );
+				}
+			}
+		}
+
+		if ( clipRoot == -1 ) {
+			treeLock.Unlock();
+			continue;
+		}
+
+		stack[0] = clipRoot;
+		stackMask[0] = mask;
+		sp = 1;
+		while( sp > 0 ) {
+			sp--;
+			const clipNode_t *node = &clipNodes[stack[sp]];
+			mask = stackMask[sp];
+
+			touchMask = 0;
+			for ( i = 0; i < num; i++ ) {
+				if ( ( mask & ( 1u << i ) ) && ClipBoundsOverlap( node->bounds, queryBounds[i] ) ) {
+					touchMask |= 1u << i;
+				}
+			}
+			if ( !touchMask ) {
+				continue;
+			}
+
+			if ( node->children[0] != -1 ) {
+				assert( sp + 2 <= MAX_CLIP_TREE_DEPTH );
+				stack[sp] = node->children[1];
+				stackMask[sp++] = touchMask;
+				stack[sp] = node->children[0];
+				stackMask[sp++] = touchMask;
+				continue;
+			}
+
+			idClipModel *check = node->clipModel;
+
+			if ( !check->linked || !check->enabled ) {
+				continue;
+			}
+
+			if ( !( check->contents & contentMask ) ) {
+				continue;
+			}
+
+			for ( i = 0; i < num; i++ ) {
+				if ( !( touchMask & ( 1u << i ) ) || !ClipBoundsOverlap( check->absBounds, queryBounds[i] ) ) {
+					continue;
+				}
+				int &count = counts[first + i];
+				if ( count >= maxCount ) {
+					gameLocal.Warning( "idClip::ClipModelsTouchingBounds: max count" );
+					continue;
+				}
+				clipModelLists[( first + i ) * maxCount + count] = check;
+				count++;
+			}
+		}
+
+		treeLock.Unlock();
+	}
 }
 
 /*
@@ -858,7 +1267,7 @@ int idClip::EntitiesTouchingBounds( const idBounds &bounds, int contentMask, idE
 
 /*
 ====================
-idClip::GetTraceClipModels
+idClip::RemovePassClipModels
 
   an ent will be excluded from testing if:
   cm->entity == passEntity ( don't clip against the pass entity )
@@ -867,17 +1276,11 @@ idClip::GetTraceClipModels
   cm->owner == passOwner ( don't interact with other missiles from same owner )
 ====================
 */
-int idClip::GetTraceClipModels( const idBounds &bounds, int contentMask, const idEntity *passEntity, idClipModel **clipModelList ) const {
-	int i, num;
+void idClip::RemovePassClipModels( const idEntity *passEntity, idClipModel **clipModelList, int num ) const {
+	int i;
 	idClipModel	*cm;
 	idEntity *passOwner;
 
-	num = ClipModelsTouchingBounds( bounds, contentMask, clipModelList, MAX_GENTITIES );
-
-	if ( !passEntity ) {
-		return num;
-	}
-
 	if ( passEntity->GetPhysics()->GetNumClipModels() > 0 ) {
 		passOwner = passEntity->GetPhysics()->GetClipModel()->GetOwner();
 	} else {
@@ -901,6 +1304,21 @@ int idClip::GetTraceClipModels( const idBounds &bounds, int contentMask, const i
 			}
 		}
 	}
+}
+
+/*
+====================
+idClip::GetTraceClipModels
+====================
+*/
+int idClip::GetTraceClipModels( const idBounds &bounds, int contentMask, const idEntity *passEntity, idClipModel **clipModelList ) const {
+	int num;
+
+	num = ClipModelsTouchingBounds( bounds, contentMask, clipModelList, MAX_GENTITIES );
+
+	if ( passEntity ) {
+		RemovePassClipModels( passEntity, clipModelList, num );
+	}
 
 	return num;
 }
@@ -1604,6 +2022,183 @@ void idClip::PrintStatistics( void ) {
 	numRotations = numTranslations = numMotions = numRenderModelTraces = numContents = numContacts = 0;
 }
 
+/*
+============
+idClip::RecordQueries
+
+  starts or stops recording the bounds of all clip model queries to a file
+============
+*/
+void idClip::RecordQueries( const char *fileName ) {
+	if ( clipQueryFile ) {
+		gameLocal.Printf( "stopped recording clip queries to %s\n", clipQueryFile->GetName() );
+		fileSystem->CloseFile( clipQueryFile );
+		clipQueryFile = NULL;
+		return;
+	}
+
+	if ( gameLocal.GameState() != GAMESTATE_ACTIVE ) {
+		gameLocal.Printf( "no map loaded\n" );
+		return;
+	}
+
+	clipQueryFile = fileSystem->OpenFileWrite( fileName );
+	if ( !clipQueryFile ) {
+		gameLocal.Warning( "couldn't open %s", fileName );
+		return;
+	}
+	gameLocal.Printf( "recording clip queries to %s\n", fileName );
+}
+
+/*
+============
+SortClipModelsByPointer
+============
+*/
+static int SortClipModelsByPointer( const void *a, const void *b ) {
+	const idClipModel *ca = *(const idClipModel **)a;
+	const idClipModel *cb = *(const idClipModel **)b;
+	return ( ca < cb ) ? -1 : ( ca > cb );
+}
+
+/*
+============
+idClip::BenchQueries
+
+  replays recorded clip model queries against the clip tree, the clip tree with batch queries
+  and a brute force test of all clip models, and verifies all three find the same clip models
+============
+*/
+void idClip::BenchQueries( const char *fileName ) {
+	int i, j, k, n, num, total, brute, mismatches;
+	int counts[CLIP_BATCH_SIZE];
+	idList<idBounds> queryBounds;
+	idList<int> queryMasks;
+	idClipModel **batchLists, *treeList[MAX_GENTITIES], *bruteList[MAX_GENTITIES];
+	idTimer treeTimer, batchTimer, bruteTimer;
+	idFile *recordFile, *file;
+	idBounds bounds;
+
+	if ( gameLocal.GameState() != GAMESTATE_ACTIVE || clipRoot == -1 ) {
+		gameLocal.Printf( "no map loaded\n" );
+		return;
+	}
+
+	file = fileSystem->OpenFileRead( fileName );
+	if ( !file ) {
+		gameLocal.Warning( "couldn't open %s", fileName );
+		return;
+	}
+	while( file->Tell() < file->Length() ) {
+		int contentMask;
+		file->ReadVec3( bounds[0] );
+		file->ReadVec3( bounds[1] );
+		file->ReadInt( contentMask );
+		queryBounds.Append( bounds );
+		queryMasks.Append( contentMask );
+	}
+	fileSystem->CloseFile( file );
+
+	num = queryBounds.Num();
+	if ( !num ) {
+		gameLocal.Printf( "no clip queries in %s\n", fileName );
+		return;
+	}
+
+	// don't record the replayed queries
+	recordFile = clipQueryFile;
+	clipQueryFile = NULL;
+
+	batchLists = new idClipModel *[CLIP_BATCH_SIZE * MAX_GENTITIES];
+
+	// single queries through the clip tree
+	total = 0;
+	treeTimer.Clear();
+	treeTimer.Start();
+	for ( i = 0; i < num; i++ ) {
+		total += ClipModelsTouchingBounds( queryBounds[i], queryMasks[i], treeList, MAX_GENTITIES );
+	}
+	treeTimer.Stop();
+
+	// batches of consecutive queries with the same content mask
+	batchTimer.Clear();
+	for ( i = 0; i < num; i += n ) {
+		for ( n = 1; n < CLIP_BATCH_SIZE && i + n < num && queryMasks[i + n] == queryMasks[i]; n++ ) {
+		}
+		batchTimer.Start();
+		ClipModelsTouchingBounds( &queryBounds[i], n, queryMasks[i], batchLists, MAX_GENTITIES, counts );
+		batchTimer.Stop();
+	}
+
+	// brute force test of all clip models in the tree
+	brute = 0;
+	bruteTimer.Clear();
+	bruteTimer.Start();
+	for ( i = 0; i < num; i++ ) {
+		bounds[0] = queryBounds[i][0] - vec3_boxEpsilon;
+		bounds[1] = queryBounds[i][1] + vec3_boxEpsilon;
+		for ( j = 0; j < maxClipNodes; j++ ) {
+			const clipNode_t *node = &clipNodes[j];
+			if ( node->height == 0 && node->clipModel->linked && node->clipModel->enabled &&
+					( node->clipModel->contents & queryMasks[i] ) && ClipBoundsOverlap( node->clipModel->absBounds, bounds ) ) {
+				brute++;
+			}
+		}
+	}
+	bruteTimer.Stop();
+
+	// verify the results
+	mismatches = 0;
+	for ( i = 0; i < num; i += n ) {
+		for ( n = 1; n < CLIP_BATCH_SIZE && i + n < num && queryMasks[i + n] == queryMasks[i]; n++ ) {
+		}
+		ClipModelsTouchingBounds( &queryBounds[i], n, queryMasks[i], batchLists, MAX_GENTITIES, counts );
+
+		for ( j = 0; j < n; j++ ) {
+			int treeCount, bruteCount;
+			idClipModel **batchList = batchLists + j * MAX_GENTITIES;
+
+			treeCount = ClipModelsTouchingBounds( queryBounds[i + j], queryMasks[i + j], treeList, MAX_GENTITIES );
+
+			bounds[0] = queryBounds[i + j][0] - vec3_boxEpsilon;
+			bounds[1] = queryBounds[i + j][1] + vec3_boxEpsilon;
+			bruteCount = 0;
+			for ( k = 0; k < maxClipNodes && bruteCount < MAX_GENTITIES; k++ ) {
+				const clipNode_t *node = &clipNodes[k];
+				if ( node->height == 0 && node->clipModel->linked && node->clipModel->enabled &&
+						( node->clipModel->contents & queryMasks[i + j] ) && ClipBoundsOverlap( node->clipModel->absBounds, bounds ) ) {
+					bruteList[bruteCount++] = node->clipModel;
+				}
+			}
+
+			if ( treeCount != bruteCount || counts[j] != treeCount ) {
+				mismatches++;
+				continue;
+			}
+			qsort( treeList, treeCount, sizeof( treeList[0] ), SortClipModelsByPointer );
+			qsort( bruteList, bruteCount, sizeof( bruteList[0] ), SortClipModelsByPointer );
+			qsort( batchList, treeCount, sizeof( batchList[0] ), SortClipModelsByPointer );
+			if ( memcmp( treeList, bruteList, treeCount * sizeof( treeList[0] ) ) != 0 ||
+					memcmp( treeList, batchList, treeCount * sizeof( treeList[0] ) ) != 0 ) {
+				mismatches++;
+			}
+		}
+	}
+
+	delete[] batchLists;
+
+	clipQueryFile = recordFile;
+
+	gameLocal.Printf( "%d clip queries, %d clip models, %d clip tree nodes, clip tree height %d\n", num, ( numClipNodes + 1 ) / 2, numClipNodes, ClipTreeHeight() );
+	gameLocal.Printf( "clip tree:   %6.3f usec per query, %1.1f clip models per query\n", treeTimer.Milliseconds() * 1000.0 / num, (float)total / num );
+	gameLocal.Printf( "batched:     %6.3f usec per query\n", batchTimer.Milliseconds() * 1000.0 / num );
+	gameLocal.Printf( "brute force: %6.3f usec per query, %1.1f clip models per query\n", bruteTimer.Milliseconds() * 1000.0 / num, (float)brute / num );
+	if ( mismatches ) {
+		gameLocal.Warning( "%d clip queries with different results", mismatches );
+	}
+}
+
+
 /*
 ============
 idClip::DrawClipModels
@@ -72,7 +72,7 @@ public:
 
 	void					Link( idClip &clp );				// must have been linked with an entity and id before
 	void					Link( idClip &clp, idEntity *ent, int newId, const idVec3 &newOrigin, const idMat3 &newAxis, int renderModelHandle = -1 );
-	void					Unlink( void );						// unlink from sectors
+	void					Unlink( void );						// unlink from the clip tree
 	void					SetPosition( const idVec3 &newOrigin, const idMat3 &newAxis );	// unlinks the clip model
 	void					Translate( const idVec3 &translation );							// unlinks the clip model
 	void					Rotate( const idRotation &rotation );							// unlinks the clip model
@@ -123,11 +123,12 @@ private:
 	int						traceModelIndex;		// trace model used for collision detection
 	int						renderModelHandle;		// render model def handle
 
-	struct clipLink_s *		clipLinks;				// links into sectors
-	int						touchCount;
+	idClip *				clip;					// clip world with the tree node of this clip model
+	int						clipNode;				// leaf in the clip tree, stays in the tree while unlinked until the clip model moves out of the leaf bounds
+	bool					linked;					// true if linked for clipping
 
 	void					Init( void );			// initialize
-	void					Link_r( struct clipSector_s *node );
+	void					RemoveFromTree( void );	// remove the leaf from the clip tree
 
 	static int				AllocTraceModel( const idTraceModel &trm );
 	static void				FreeTraceModel( int traceModelIndex );
@@ -220,7 +221,7 @@ ID_INLINE bool idClipModel::IsTraceModel( void ) const {
 }
 
 ID_INLINE bool idClipModel::IsLinked( void ) const {
-	return ( clipLinks != NULL );
+	return linked;
 }
 
 ID_INLINE bool idClipModel::IsEnabled( void ) const {
@@ -298,6 +299,10 @@ public:
 	int						EntitiesTouchingBounds( const idBounds &bounds, int contentMask, idEntity **entityList, int maxCount ) const;
 	int						ClipModelsTouchingBounds( const idBounds &bounds, int contentMask, idClipModel **clipModelList, int maxCount ) const;
 
+	// batch query walks the clip tree once for all bounds, the results for bounds[i] are stored
+	// at clipModelLists + i * maxCount and the number of results in counts[i]
+	void					ClipModelsTouchingBounds( const idBounds *bounds, int numBounds, int contentMask, idClipModel **clipModelLists, int maxCount, int *counts ) const;
+
 	const idBounds &		GetWorldBounds( void ) const;
 	idClipModel *			DefaultClipModel( void );
 
@@ -306,13 +311,20 @@ public:
 	void					DrawClipModels( const idVec3 &eye, const float radius, const idEntity *passEntity );
 	bool					DrawModelContactFeature( const contactInfo_t &contact, const idClipModel *clipModel, int lifetime ) const;
 
+							// record the bounds of clip model queries and replay them to benchmark the clip tree
+	void					RecordQueries( const char *fileName );
+	void					BenchQueries( const char *fileName );
+
 private:
-	int						numClipSectors;
-	struct clipSector_s *	clipSectors;
+	struct clipNode_s *		clipNodes;				// dynamic bounding volume tree with the clip models in the leaves
+	int						maxClipNodes;
+	int						numClipNodes;			// nodes in use
+	int						freeClipNode;			// first node in the free list
+	int						clipRoot;
+	mutable idSysSpinLock	treeLock;				// entities that think in parallel link and query the tree at the same time
 	idBounds				worldBounds;
 	idClipModel				temporaryClipModel;
 	idClipModel				defaultClipModel;
-	mutable int				touchCount;
 							// statistics
 	int						numTranslations;
 	int						numRotations;
@@ -322,10 +334,16 @@ private:
 	int						numContacts;
 
 private:
-	struct clipSector_s *	CreateClipSectors_r( const int depth, const idBounds &bounds, idVec3 &maxSector );
-	void					ClipModelsTouchingBounds_r( const struct clipSector_s *node, struct listParms_s &parms ) const;
+	int						AllocClipNode( void );
+	void					FreeClipNode( int nodeNum );
+	void					InsertLeaf( int leaf );
+	void					RemoveLeaf( int leaf );
+	int						BalanceNode( int nodeNum );
+	int						ClipTreeHeight( void ) const;
+	void					LinkClipModel( idClipModel *clipModel );
 	const idTraceModel *	TraceModelForClipModel( const idClipModel *mdl ) const;
 	int						GetTraceClipModels( const idBounds &bounds, int contentMask, const idEntity *passEntity, idClipModel **clipModelList ) const;
+	void					RemovePassClipModels( const idEntity *passEntity, idClipModel **clipModelList, int num ) const;
 	void					TraceRenderModel( trace_t &trace, const idVec3 &start, const idVec3 &end, const float radius, const idMat3 &axis, idClipModel *touch ) const;
 };
 
@@ -35,6 +35,8 @@ CLASS_DECLARATION( idPhysics_Base, idPhysics_RigidBody )
 END_CLASS
 
 const float STOP_SPEED		= 10.0f;
+const int MAX_SLEEP_ISLAND	= 64;
+const float SLEEP_SPEED_SCALE	= 0.1f;		// islands only go to sleep when moving a lot slower than a body coming to rest
 
 
 #undef RB_TIMINGS
@@ -157,7 +159,11 @@ bool idPhysics_RigidBody::CollisionImpulse( const trace_t &collision, idVec3 &im
 		current.i.angularMomentum *= 0.5f;
 	}
 
-	// callback to self to let the entity know about the collision
+	// callback to self to let the entity know about the collision,
+	// entities that think in parallel get the callback on the game thread
+	if ( gameLocal.DeferThinkCollide( self, collision, velocity ) ) {
+		return false;
+	}
 	return self->Collide( collision, velocity );
 }
 
@@ -273,9 +279,7 @@ idPhysics_RigidBody::TestIfAtRest
 */
 bool idPhysics_RigidBody::TestIfAtRest( void ) const {
 	int i;
-	float gv;
-	idVec3 v, av, normal, point;
-	idMat3 inverseWorldInertiaTensor;
+	idVec3 normal, point;
 	idFixedWinding contactWinding;
 
 	if ( current.atRest >= 0 ) {
@@ -322,6 +326,22 @@ bool idPhysics_RigidBody::TestIfAtRest( void ) const {
 		return false;
 	}
 
+	return TestIfSlow();
+}
+
+/*
+================
+idPhysics_RigidBody::TestIfSlow
+
+  Returns true if the body moves slow enough to be put to rest.
+  The speed limits are scaled with speedScale.
+================
+*/
+bool idPhysics_RigidBody::TestIfSlow( const float speedScale ) const {
+	float gv;
+	idVec3 v, av;
+	idMat3 inverseWorldInertiaTensor;
+
 	// linear velocity of body
 	v = inverseMass * current.i.linearMomentum;
 	// linear velocity in gravity direction
@@ -330,11 +350,11 @@ bool idPhysics_RigidBody::TestIfAtRest( void ) const {
 	v -= gv * gravityNormal;
 
 	// if too much velocity orthogonal to gravity direction
-	if ( v.Length() > STOP_SPEED ) {
+	if ( v.Length() > STOP_SPEED * speedScale ) {
 		return false;
 	}
 	// if too much velocity in gravity direction
-	if ( gv > 2.0f * STOP_SPEED || gv < -2.0f * STOP_SPEED ) {
+	if ( gv > 2.0f * STOP_SPEED * speedScale || gv < -2.0f * STOP_SPEED * speedScale ) {
 		return false;
 	}
 
@@ -343,13 +363,155 @@ bool idPhysics_RigidBody::TestIfAtRest( void ) const {
 	av = inverseWorldInertiaTensor * current.i.angularMomentum;
 
 	// if too much rotational velocity
-	if ( av.LengthSqr() > STOP_SPEED ) {
+	if ( av.LengthSqr() > STOP_SPEED * speedScale * speedScale ) {
+		return false;
+	}
+
+	return true;
+}
+
+/*
+================
+idPhysics_RigidBody::SleepIsland
+
+  Puts the body to rest together with all bodies it touches directly or through other bodies.
+  Bodies in a pile often can't come to rest on their own because they don't rest on at least
+  three contact points or keep waking each other, so the whole island goes to sleep when all
+  its bodies moved slowly for rb_sleepTime milliseconds. A body that doesn't touch any other
+  moving rigid body has to pass the support test of TestIfAtRest instead.
+  Returns false if any body in the island moved too fast, the island is too large or the body is alone.
+================
+*/
+bool idPhysics_RigidBody::SleepIsland( void ) {
+	idPhysics_RigidBody *island[MAX_SLEEP_ISLAND];
+	idPhysics_RigidBody *body, *other;
+	idEntity *ent;
+	int i, j, k, num, numTouch;
+	bool failed;
+
+	// brittle fracture shards think through their owner and rest on their own
+	if ( sleepCheckTime == gameLocal.time || self->GetPhysics() != this ) {
+		return false;
+	}
+
+	// flood the contact graph, bodies at rest and other physics types end the island
+	island[0] = this;
+	num = 1;
+	failed = false;
+	for ( i = 0; i < num && !failed; i++ ) {
+		body = island[i];
+		numTouch = body->contacts.Num() + body->contactEntities.Num();
+		for ( j = 0; j < numTouch; j++ ) {
+			if ( j < body->contacts.Num() ) {
+				ent = gameLocal.entities[body->contacts[j].entityNum];
+			} else {
+				ent = body->contactEntities[j - body->contacts.Num()].GetEntity();
+			}
+			if ( !ent || ent == self || !ent->GetPhysics()->IsType( idPhysics_RigidBody::Type ) ) {
+				continue;
+			}
+			other = static_cast<idPhysics_RigidBody *>( ent->GetPhysics() );
+			if ( other->current.atRest >= 0 || other->hasMaster ) {
+				continue;
+			}
+			for ( k = 0; k < num; k++ ) {
+				if ( island[k] == other ) {
+					break;
+				}
+			}
+			if ( k < num ) {
+				continue;
+			}
+			if ( num >= MAX_SLEEP_ISLAND || other->slowTime < 0 || other->sleepCheckTime == gameLocal.time ||
+					gameLocal.time - other->slowTime < rb_sleepTime.GetInteger() ) {
+				failed = true;
+				break;
+			}
+			island[num++] = other;
+		}
+	}
+
+	if ( failed || num < 2 ) {
+		// don't try again this frame from any body in the island
+		for ( i = 0; i < num; i++ ) {
+			island[i]->sleepCheckTime = gameLocal.time;
+		}
 		return false;
 	}
 
+	// link the bodies so touching any of them wakes up the whole island
+	for ( i = 0; i < num; i++ ) {
+		island[i]->UnlinkSleepRing();
+	}
+	for ( i = 0; i < num; i++ ) {
+		island[i]->Rest();
+		island[i]->slowTime = -1;
+		if ( num > 1 ) {
+			island[i]->sleepNext = island[( i + 1 ) % num];
+		}
+	}
+	Sys_InterlockedAdd( gameLocal.numBodiesIslandSlept, num );
 	return true;
 }
 
+/*
+================
+idPhysics_RigidBody::WakeIsland
+
+  Wakes up the bodies that went to sleep together with this body.
+================
+*/
+void idPhysics_RigidBody::WakeIsland( void ) {
+	idPhysics_RigidBody *body, *next;
+
+	body = sleepNext;
+	sleepNext = NULL;
+	while( body != NULL && body != this ) {
+		next = body->sleepNext;
+		body->sleepNext = NULL;
+		if ( body->current.atRest >= 0 ) {
+			Sys_InterlockedIncrement( gameLocal.numBodiesWoken );
+			body->current.atRest = -1;
+			body->slowTime = -1;
+			body->self->BecomeActive( TH_PHYSICS );
+		}
+		body = next;
+	}
+}
+
+/*
+================
+idPhysics_RigidBody::GetSleepRing
+================
+*/
+int idPhysics_RigidBody::GetSleepRing( idEntity **entities, int maxEntities ) const {
+	const idPhysics_RigidBody *body;
+	int num;
+
+	num = 0;
+	for ( body = sleepNext; body != NULL && body != this && num < maxEntities; body = body->sleepNext ) {
+		entities[num++] = body->self;
+	}
+	return num;
+}
+
+/*
+================
+idPhysics_RigidBody::UnlinkSleepRing
+================
+*/
+void idPhysics_RigidBody::UnlinkSleepRing( void ) {
+	idPhysics_RigidBody *prev;
+
+	if ( !sleepNext ) {
+		return;
+	}
+	for ( prev = sleepNext; prev->sleepNext != this; prev = prev->sleepNext ) {
+	}
+	prev->sleepNext = ( sleepNext != prev ) ? sleepNext : NULL;
+	sleepNext = NULL;
+}
+
 /*
 ================
 idPhysics_RigidBody::DropToFloorAndRest
@@ -469,6 +631,10 @@ idPhysics_RigidBody::idPhysics_RigidBody( void ) {
 	hasMaster = false;
 	isOrientated = false;
 
+	slowTime = -1;
+	sleepCheckTime = -1;
+	sleepNext = NULL;
+
 #ifdef RB_TIMINGS
 	lastTimerReset = 0;
 #endif
@@ -480,6 +646,7 @@ idPhysics_RigidBody::~idPhysics_RigidBody
 ================
 */
 idPhysics_RigidBody::~idPhysics_RigidBody( void ) {
+	UnlinkSleepRing();
 	if ( clipModel ) {
 		delete clipModel;
 		clipModel = NULL;
@@ -587,6 +754,11 @@ void idPhysics_RigidBody::Restore( idRestoreGame *savefile ) {
 
 	savefile->ReadBool( hasMaster );
 	savefile->ReadBool( isOrientated );
+
+	// sleeping islands are not saved, the bodies wake up on their own
+	slowTime = -1;
+	sleepCheckTime = -1;
+	sleepNext = NULL;
 }
 
 /*
@@ -720,6 +892,9 @@ idPhysics_RigidBody::Rest
 ================
 */
 void idPhysics_RigidBody::Rest( void ) {
+	if ( current.atRest < 0 ) {
+		Sys_InterlockedIncrement( gameLocal.numBodiesRested );
+	}
 	current.atRest = gameLocal.time;
 	current.i.linearMomentum.Zero();
 	current.i.angularMomentum.Zero();
@@ -751,8 +926,13 @@ idPhysics_RigidBody::Activate
 ================
 */
 void idPhysics_RigidBody::Activate( void ) {
+	if ( current.atRest >= 0 ) {
+		Sys_InterlockedIncrement( gameLocal.numBodiesWoken );
+	}
 	current.atRest = -1;
+	slowTime = -1;
 	self->BecomeActive( TH_PHYSICS );
+	WakeIsland();
 }
 
 /*
@@ -938,6 +1118,17 @@ bool idPhysics_RigidBody::Evaluate( int timeStepMSec, int endTimeMSec ) {
 		}  else {
 			// apply contact friction
 			ContactFriction( timeStep );
+
+			// put the island to sleep when all its bodies have been moving slowly for a while
+			if ( rb_sleepIslands.GetBool() && contacts.Num() && TestIfSlow( SLEEP_SPEED_SCALE ) ) {
+				if ( slowTime < 0 ) {
+					slowTime = gameLocal.time;
+				} else if ( gameLocal.time - slowTime >= rb_sleepTime.GetInteger() && SleepIsland() ) {
+					cameToRest = true;
+				}
+			} else {
+				slowTime = -1;
+			}
 		}
 	}
 
@@ -85,6 +85,8 @@ public:
 							// enable/disable activation by impact
 	void					EnableImpact( void );
 	void					DisableImpact( void );
+							// get the other entities that went to sleep together with this body, they wake up together
+	int						GetSleepRing( idEntity **entities, int maxEntities ) const;
 
 public:	// common physics interface
 	void					SetClipModel( idClipModel *model, float density, int id = 0, bool freeOld = true );
@@ -181,6 +183,11 @@ private:
 	bool					hasMaster;
 	bool					isOrientated;
 
+	// sleeping islands
+	int						slowTime;					// time the body started moving slow enough to sleep, -1 if moving faster
+	int						sleepCheckTime;				// time of the last failed attempt to put the island of this body to sleep
+	idPhysics_RigidBody *	sleepNext;					// next body in the ring of bodies that went to sleep together
+
 private:
 	friend void				RigidBodyDerivatives( const float t, const void *clientData, const float *state, float *derivatives );
 	void					Integrate( const float deltaTime, rigidBodyPState_t &next );
@@ -189,6 +196,10 @@ private:
 	void					ContactFriction( float deltaTime );
 	void					DropToFloorAndRest( void );
 	bool					TestIfAtRest( void ) const;
+	bool					TestIfSlow( const float speedScale = 1.0f ) const;
+	bool					SleepIsland( void );
+	void					WakeIsland( void );
+	void					UnlinkSleepRing( void );
 	void					Rest( void );
 	void					DebugDraw( void );
 };
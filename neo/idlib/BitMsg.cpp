@@ -646,6 +646,12 @@ idBitMsgDelta::WriteBits
 ================
 */
 void idBitMsgDelta::WriteBits( int value, int numBits ) {
+	if ( recordFields ) {
+		RecordField( DELTA_FIELD_BITS, numBits, 0, value );
+		newBase->WriteBits( value, numBits );
+		return;
+	}
+
 	if ( newBase ) {
 		newBase->WriteBits( value, numBits );
 	}
@@ -671,6 +677,12 @@ idBitMsgDelta::WriteDelta
 ================
 */
 void idBitMsgDelta::WriteDelta( int oldValue, int newValue, int numBits ) {
+	if ( recordFields ) {
+		RecordField( DELTA_FIELD_DELTA, numBits, oldValue, newValue );
+		newBase->WriteBits( newValue, numBits );
+		return;
+	}
+
 	if ( newBase ) {
 		newBase->WriteBits( newValue, numBits );
 	}
@@ -768,6 +780,12 @@ idBitMsgDelta::WriteString
 ================
 */
 void idBitMsgDelta::WriteString( const char *s, int maxLength ) {
+	if ( recordFields ) {
+		RecordField( DELTA_FIELD_STRING, maxLength, newBase->GetWriteBit(), newBase->GetSize() );
+		newBase->WriteString( s, maxLength );
+		return;
+	}
+
 	if ( newBase ) {
 		newBase->WriteString( s, maxLength );
 	}
@@ -794,6 +812,12 @@ idBitMsgDelta::WriteData
 ================
 */
 void idBitMsgDelta::WriteData( const void *data, int length ) {
+	if ( recordFields ) {
+		RecordField( DELTA_FIELD_DATA, length, newBase->GetWriteBit(), newBase->GetSize() );
+		newBase->WriteData( data, length );
+		return;
+	}
+
 	if ( newBase ) {
 		newBase->WriteData( data, length );
 	}
@@ -821,6 +845,12 @@ idBitMsgDelta::WriteDict
 ================
 */
 void idBitMsgDelta::WriteDict( const idDict &dict ) {
+	if ( recordFields ) {
+		RecordField( DELTA_FIELD_DICT, 0, newBase->GetWriteBit(), newBase->GetSize() );
+		newBase->WriteDeltaDict( dict, NULL );
+		return;
+	}
+
 	if ( newBase ) {
 		newBase->WriteDeltaDict( dict, NULL );
 	}
@@ -841,6 +871,12 @@ idBitMsgDelta::WriteDeltaByteCounter
 ================
 */
 void idBitMsgDelta::WriteDeltaByteCounter( int oldValue, int newValue ) {
+	if ( recordFields ) {
+		RecordField( DELTA_FIELD_BYTE_COUNTER, 8, oldValue, newValue );
+		newBase->WriteBits( newValue, 8 );
+		return;
+	}
+
 	if ( newBase ) {
 		newBase->WriteBits( newValue, 8 );
 	}
@@ -866,6 +902,12 @@ idBitMsgDelta::WriteDeltaShortCounter
 ================
 */
 void idBitMsgDelta::WriteDeltaShortCounter( int oldValue, int newValue ) {
+	if ( recordFields ) {
+		RecordField( DELTA_FIELD_SHORT_COUNTER, 16, oldValue, newValue );
+		newBase->WriteBits( newValue, 16 );
+		return;
+	}
+
 	if ( newBase ) {
 		newBase->WriteBits( newValue, 16 );
 	}
@@ -891,6 +933,12 @@ idBitMsgDelta::WriteDeltaLongCounter
 ================
 */
 void idBitMsgDelta::WriteDeltaLongCounter( int oldValue, int newValue ) {
+	if ( recordFields ) {
+		RecordField( DELTA_FIELD_LONG_COUNTER, 32, oldValue, newValue );
+		newBase->WriteBits( newValue, 32 );
+		return;
+	}
+
 	if ( newBase ) {
 		newBase->WriteBits( newValue, 32 );
 	}
@@ -910,6 +958,64 @@ void idBitMsgDelta::WriteDeltaLongCounter( int oldValue, int newValue ) {
 	}
 }
 
+/*
+================
+idBitMsgDelta::WriteFields
+
+  Writes the fields recorded with InitRecording. The values are taken from the field list,
+  strings, data and dictionaries are read back from the recorded new base.
+================
+*/
+void idBitMsgDelta::WriteFields( const idBitMsg &recordedBase, const deltaField_t *fields, int numFields ) {
+	idBitMsg	reader;
+	char		string[MAX_DATA_BUFFER];
+	byte		data[MAX_DATA_BUFFER];
+	idDict		dict;
+
+	assert( recordFields == NULL );
+
+	reader.Init( recordedBase.GetData(), recordedBase.GetMaxSize() );
+	reader.SetSize( recordedBase.GetSize() );
+
+	for ( int i = 0; i < numFields; i++ ) {
+		const deltaField_t &field = fields[i];
+
+		switch( field.type ) {
+			case DELTA_FIELD_BITS:
+				WriteBits( field.newValue, field.numBits );
+				break;
+			case DELTA_FIELD_DELTA:
+				WriteDelta( field.oldValue, field.newValue, field.numBits );
+				break;
+			case DELTA_FIELD_BYTE_COUNTER:
+				WriteDeltaByteCounter( field.oldValue, field.newValue );
+				break;
+			case DELTA_FIELD_SHORT_COUNTER:
+				WriteDeltaShortCounter( field.oldValue, field.newValue );
+				break;
+			case DELTA_FIELD_LONG_COUNTER:
+				WriteDeltaLongCounter( field.oldValue, field.newValue );
+				break;
+			case DELTA_FIELD_STRING:
+				reader.RestoreReadState( field.newValue, field.oldValue );
+				reader.ReadString( string, sizeof( string ) );
+				WriteString( string, field.numBits );
+				break;
+			case DELTA_FIELD_DATA:
+				assert( field.numBits <= sizeof( data ) );
+				reader.RestoreReadState( field.newValue, field.oldValue );
+				reader.ReadData( data, field.numBits );
+				WriteData( data, field.numBits );
+				break;
+			case DELTA_FIELD_DICT:
+				reader.RestoreReadState( field.newValue, field.oldValue );
+				reader.ReadDeltaDict( dict, NULL );
+				WriteDict( dict );
+				break;
+		}
+	}
+}
+
 /*
 ================
 idBitMsgDelta::ReadString
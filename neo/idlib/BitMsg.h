@@ -433,9 +433,31 @@ ID_INLINE float idBitMsg::ReadDeltaFloat( float oldValue, int exponentBits, int
 
   idBitMsgDelta
 
+  When recording, only the new base is written and every field written is
+  appended to a field list. WriteFields later delta compresses the recorded
+  new base against any base with the same result as writing the fields again.
+
 ===============================================================================
 */
 
+typedef enum {
+	DELTA_FIELD_BITS,
+	DELTA_FIELD_DELTA,
+	DELTA_FIELD_BYTE_COUNTER,
+	DELTA_FIELD_SHORT_COUNTER,
+	DELTA_FIELD_LONG_COUNTER,
+	DELTA_FIELD_STRING,
+	DELTA_FIELD_DATA,
+	DELTA_FIELD_DICT
+} deltaFieldType_t;
+
+typedef struct deltaField_s {
+	short			type;				// deltaFieldType_t
+	short			numBits;			// number of bits, maximum string length or data length
+	int				oldValue;			// or the write bit of a string, data or dict in the new base
+	int				newValue;			// or the write size of a string, data or dict in the new base
+} deltaField_t;
+
 class idBitMsgDelta {
 public:
 					idBitMsgDelta();
@@ -443,8 +465,11 @@ public:
 
 	void			Init( const idBitMsg *base, idBitMsg *newBase, idBitMsg *delta );
 	void			Init( const idBitMsg *base, idBitMsg *newBase, const idBitMsg *delta );
+	void			InitRecording( idBitMsg *newBase, idList<deltaField_t> *fields );
 	bool			HasChanged( void ) const;
 
+	void			WriteFields( const idBitMsg &recordedBase, const deltaField_t *fields, int numFields );
+
 	void			WriteBits( int value, int numBits );
 	void			WriteChar( int c );
 	void			WriteByte( int c );
@@ -501,8 +526,10 @@ private:
 	idBitMsg *		writeDelta;		// delta from base to new base for writing
 	const idBitMsg *readDelta;		// delta from base to new base for reading
 	mutable bool	changed;		// true if the new base is different from the base
+	idList<deltaField_t> *recordFields;	// fields written to the new base while recording
 
 private:
+	void			RecordField( deltaFieldType_t type, int numBits, int oldValue, int newValue );
 	void			WriteDelta( int oldValue, int newValue, int numBits );
 	int				ReadDelta( int oldValue, int numBits ) const;
 };
@@ -513,6 +540,7 @@ ID_INLINE idBitMsgDelta::idBitMsgDelta() {
 	writeDelta = NULL;
 	readDelta = NULL;
 	changed = false;
+	recordFields = NULL;
 }
 
 ID_INLINE void idBitMsgDelta::Init( const idBitMsg *base, idBitMsg *newBase, idBitMsg *delta ) {
@@ -521,6 +549,7 @@ ID_INLINE void idBitMsgDelta::Init( const idBitMsg *base, idBitMsg *newBase, idB
 	this->writeDelta = delta;
 	this->readDelta = delta;
 	this->changed = false;
+	this->recordFields = NULL;
 }
 
 ID_INLINE void idBitMsgDelta::Init( const idBitMsg *base, idBitMsg *newBase, const idBitMsg *delta ) {
@@ -529,6 +558,24 @@ ID_INLINE void idBitMsgDelta::Init( const idBitMsg *base, idBitMsg *newBase, con
 	this->writeDelta = NULL;
 	this->readDelta = delta;
 	this->changed = false;
+	this->recordFields = NULL;
+}
+
+ID_INLINE void idBitMsgDelta::InitRecording( idBitMsg *newBase, idList<deltaField_t> *fields ) {
+	this->base = NULL;
+	this->newBase = newBase;
+	this->writeDelta = NULL;
+	this->readDelta = NULL;
+	this->changed = true;
+	this->recordFields = fields;
+}
+
+ID_INLINE void idBitMsgDelta::RecordField( deltaFieldType_t type, int numBits, int oldValue, int newValue ) {
+	deltaField_t &field = recordFields->Alloc();
+	field.type = type;
+	field.numBits = numBits;
+	field.oldValue = oldValue;
+	field.newValue = newValue;
 }
 
 ID_INLINE bool idBitMsgDelta::HasChanged( void ) const {
@@ -29,6 +29,10 @@ If you have questions concerning this license or the applicable additional terms
 #include "../idlib/precompiled.h"
 #pragma hdrstop
 
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
 #ifndef USE_LIBC_MALLOC
 	#define USE_LIBC_MALLOC		0
 #endif
@@ -41,15 +45,68 @@ If you have questions concerning this license or the applicable additional terms
 //
 //	idHeap
 //
+//	Allocations up to 32k are rounded up to one of the size classes
+//	and served from 64k spans. Every thread has its own cache of spans
+//	for each size class, so allocating and freeing memory on the same
+//	thread never takes a lock. A block freed by another thread is pushed
+//	on a lock-free list in its span, and is reclaimed by the owning
+//	thread when that runs out of free blocks. Larger allocations go
+//	straight to the OS.
+//
+//	Spans and large allocations are aligned to SPAN_SIZE with the
+//	header at the start, so the header of any block is found by
+//	masking the pointer.
+//
 //===============================================================
 
-#define SMALL_HEADER_SIZE		( (int) ( sizeof( byte ) + sizeof( byte ) ) )
-#define MEDIUM_HEADER_SIZE		( (int) ( sizeof( mediumHeapEntry_s ) + sizeof( byte ) ) )
-#define LARGE_HEADER_SIZE		( (int) ( sizeof( dword * ) + sizeof( byte ) ) )
-
 #define ALIGN_SIZE( bytes )		( ( (bytes) + ALIGN - 1 ) & ~(ALIGN - 1) )
-#define SMALL_ALIGN( bytes )	( ALIGN_SIZE( (bytes) + SMALL_HEADER_SIZE ) - SMALL_HEADER_SIZE )
-#define MEDIUM_SMALLEST_SIZE	( ALIGN_SIZE( 256 ) + ALIGN_SIZE( MEDIUM_HEADER_SIZE ) )
+#define SPAN_HEADER_SIZE		( (int) ALIGN_SIZE( sizeof( heapSpan_t ) ) )
+#define SPAN_OF( ptr )			( (heapSpan_t *) ( ( (intptr_t) (ptr) ) & ~( (intptr_t) SPAN_SIZE - 1 ) ) )
+
+const int ALIGN					= 16;					// memory alignment in bytes, all blocks can be used as 16 byte aligned memory
+const int SPAN_SIZE				= 64 * 1024;			// size and alignment of a span
+const int SPAN_MAGIC			= 0x4e415053;			// 'SPAN'
+const int LARGE_SIZE_CLASS		= -1;
+const int MAX_SMALL_SIZE		= 32767;				// larger allocations go to the OS
+const int MAX_SIZE_CLASSES		= 48;
+const int MAX_CACHED_SPANS		= 64;					// empty spans kept around before returning them to the OS
+const int MAX_FULL_SPAN_SCAN	= 4;					// full spans checked for remote frees before allocating a new span
+const int OS_PAGE_SIZE			= 4096;
+
+struct heapThreadCache_s;
+
+typedef struct heapSpan_s {
+	int							magic;
+	int							sizeClass;			// LARGE_SIZE_CLASS for large allocations
+	dword						blockSize;			// size of a block, or the requested size of a large allocation
+	dword						osSize;				// number of bytes allocated from the OS
+	struct heapThreadCache_s *	owner;				// only the owner allocates from the span and touches freeList
+	void *						freeList;			// blocks freed by the owner
+	void * volatile				remoteFreeList;		// blocks freed by other threads
+	int							numBlocks;			// number of blocks that fit in the span
+	int							numCarved;			// blocks are carved out of the span on demand
+	int							numUsed;			// blocks handed out and not yet returned to freeList
+	bool						full;				// span is in the owner's full list
+	struct heapSpan_s *			prev;				// owner free or full list
+	struct heapSpan_s *			next;
+	struct heapSpan_s *			heapPrev;			// list of all spans or large allocations in the heap
+	struct heapSpan_s *			heapNext;
+} heapSpan_t;
+
+typedef struct heapThreadCache_s {
+	int							heapSerial;			// heap the cache belongs to
+	heapSpan_t *				spans[MAX_SIZE_CLASSES];		// spans with free blocks
+	heapSpan_t *				fullSpans[MAX_SIZE_CLASSES];	// spans without free blocks, may have remote frees
+	int							statsFrame;			// frame stats are reset when this doesn't match the heap
+	memoryStats_t				frameAllocs;
+	memoryStats_t				frameFrees;
+	memoryStats_t				totalAllocs;
+	struct heapThreadCache_s *	next;
+} heapThreadCache_t;
+
+static ID_THREAD_LOCAL heapThreadCache_t *	heap_threadCache;
+static ID_THREAD_LOCAL int					heap_threadCacheSerial;
+static int									heap_serial;
 
 
 class idHeap {
@@ -67,81 +124,102 @@ public:
 
 	void 			AllocDefragBlock( void );		// hack for huge renderbumps
 
+	heapThreadCache_t *	GetThreadCache( void );		// creates the cache for the calling thread on first use
+	heapThreadCache_t *	GetThreadStats( void );		// thread cache with the frame stats reset if the frame changed
+	void			ClearFrameStats( void );
+	void			GetStats( memoryStats_t &frameAllocs, memoryStats_t &frameFrees, memoryStats_t &totalAllocs );
+
 private:
+	int				serial;							// identifies the thread caches of this heap
+	idSysSpinLock	lock;							// protects everything below, never taken for cached allocations
 
-	enum {
-		ALIGN = 8									// memory alignment in bytes
-	};
-
-	enum {
-		INVALID_ALLOC	= 0xdd,
-		SMALL_ALLOC		= 0xaa,						// small allocation
-		MEDIUM_ALLOC	= 0xbb,						// medium allocaction
-		LARGE_ALLOC		= 0xcc						// large allocaction
-	};
-
-	struct page_s {									// allocation page
-		void *				data;					// data pointer to allocated memory
-		dword				dataSize;				// number of bytes of memory 'data' points to
-		page_s *			next;					// next free page in same page manager
-		page_s *			prev;					// used only when allocated
-		dword				largestFree;			// this data used by the medium-size heap manager
-		void *				firstFree;				// pointer to first free entry
-	};
-
-	struct mediumHeapEntry_s {
-		page_s *			page;					// pointer to page
-		dword				size;					// size of block
-		mediumHeapEntry_s *	prev;					// previous block
-		mediumHeapEntry_s *	next;					// next block
-		mediumHeapEntry_s *	prevFree;				// previous free block
-		mediumHeapEntry_s *	nextFree;				// next free block
-		dword				freeBlock;				// non-zero if free block
-	};
-
-	// variables
-	void *			smallFirstFree[256/ALIGN+1];	// small heap allocator lists (for allocs of 1-255 bytes)
-	page_s *		smallCurPage;					// current page for small allocations
-	dword			smallCurPageOffset;				// byte offset in current page
-	page_s *		smallFirstUsedPage;				// first used page of the small heap manager
-
-	page_s *		mediumFirstFreePage;			// first partially free page
-	page_s *		mediumLastFreePage;				// last partially free page
-	page_s *		mediumFirstUsedPage;			// completely used page
-
-	page_s *		largeFirstUsedPage;				// first page used by the large heap manager
-
-	page_s *		swapPage;
-
-	dword			pagesAllocated;					// number of pages currently allocated
-	dword			pageSize;						// size of one alloc page in bytes
-
-	dword			pageRequests;					// page requests
-	dword			OSAllocs;						// number of allocs made to the OS
+	int				numSizeClasses;
+	dword			sizeClassBytes[MAX_SIZE_CLASSES];
+	byte			sizeClassForBytes[MAX_SMALL_SIZE / ALIGN + 2];	// indexed by ( bytes + ALIGN - 1 ) / ALIGN
+
+	heapThreadCache_t *	threadCaches;				// all thread caches
+	heapSpan_t *	usedSpans;						// spans owned by thread caches
+	heapSpan_t *	cachedSpans;					// empty spans ready for reuse
+	int				numCachedSpans;
+	heapSpan_t *	largeSpans;						// large allocations
+
+	volatile int	statsFrame;
 
-	int				c_heapAllocRunningCount;
+	dword			pagesAllocated;					// number of spans and large blocks currently allocated
+	dword			OSAllocs;						// number of allocs made to the OS
 
 	void			*defragBlock;					// a single huge block that can be allocated
 													// at startup, then freed when needed
 
 	// methods
-	page_s *		AllocatePage( dword bytes );	// allocate page from the OS
-	void			FreePage( idHeap::page_s *p );	// free an OS allocated page
+	void *			AllocateOS( size_t bytes );		// allocate SPAN_SIZE aligned memory from the OS
+	void			FreeOS( void *ptr, size_t bytes );
 
-	void *			SmallAllocate( dword bytes );	// allocate memory (1-255 bytes) from small heap manager
-	void			SmallFree( void *ptr );			// free memory allocated by small heap manager
+	heapThreadCache_t *	CreateThreadCache( void );
+	heapSpan_t *	AllocateSpan( heapThreadCache_t *cache, int sizeClass );
+	void			ReleaseSpan( heapSpan_t *span );
+	bool			CollectRemoteFrees( heapSpan_t *span );
+	heapSpan_t *	RefillSizeClass( heapThreadCache_t *cache, int sizeClass );
 
-	void *			MediumAllocateFromPage( idHeap::page_s *p, dword sizeNeeded );
-	void *			MediumAllocate( dword bytes );	// allocate memory (256-32768 bytes) from medium heap manager
-	void			MediumFree( void *ptr );		// free memory allocated by medium heap manager
+	void *			SmallAllocate( dword bytes );	// allocate memory (1-32767 bytes) from the calling thread's cache
+	void			SmallFree( heapSpan_t *span, void *ptr );
 
 	void *			LargeAllocate( dword bytes );	// allocate large block from OS directly
-	void			LargeFree( void *ptr );			// free memory allocated by large heap manager
-
-	void			ReleaseSwappedPages( void );
-	void			FreePageReal( idHeap::page_s *p );
+	void			LargeFree( heapSpan_t *span );	// free memory allocated by large heap manager
 };
 
+/*
+================
+SpanUnlink / SpanLinkFront
+
+  owner list helpers
+================
+*/
+static ID_INLINE void SpanUnlink( heapSpan_t *&head, heapSpan_t *span ) {
+	if ( span->prev ) {
+		span->prev->next = span->next;
+	} else {
+		head = span->next;
+	}
+	if ( span->next ) {
+		span->next->prev = span->prev;
+	}
+	span->prev = span->next = NULL;
+}
+
+static ID_INLINE void SpanLinkFront( heapSpan_t *&head, heapSpan_t *span ) {
+	span->prev = NULL;
+	span->next = head;
+	if ( head ) {
+		head->prev = span;
+	}
+	head = span;
+}
+
+static ID_INLINE void SpanHeapUnlink( heapSpan_t *&head, heapSpan_t *span ) {
+	if ( span->heapPrev ) {
+		span->heapPrev->heapNext = span->heapNext;
+	} else {
+		head = span->heapNext;
+	}
+	if ( span->heapNext ) {
+		span->heapNext->heapPrev = span->heapPrev;
+	}
+	span->heapPrev = span->heapNext = NULL;
+}
+
+static ID_INLINE void SpanHeapLinkFront( heapSpan_t *&head, heapSpan_t *span ) {
+	span->heapPrev = NULL;
+	span->heapNext = head;
+	if ( head ) {
+		head->heapPrev = span;
+	}
+	head = span;
+}
+
+static ID_INLINE bool SpanHasFreeBlocks( const heapSpan_t *span ) {
+	return ( span->freeList != NULL ) || ( span->numCarved < span->numBlocks );
+}
 
 /*
 ================
@@ -149,27 +227,41 @@ idHeap::Init
 ================
 */
 void idHeap::Init () {
-	OSAllocs			= 0;
-	pageRequests		= 0;
-	pageSize			= 65536 - sizeof( idHeap::page_s );
-	pagesAllocated		= 0;								// reset page allocation counter
+	int i, sizeClass;
+	dword bytes, step;
 
-	largeFirstUsedPage	= NULL;								// init large heap manager
-	swapPage			= NULL;
+	serial				= ++heap_serial;
 
-	memset( smallFirstFree, 0, sizeof(smallFirstFree) );	// init small heap manager
-	smallFirstUsedPage	= NULL;
-	smallCurPage		= AllocatePage( pageSize );
-	assert( smallCurPage );
-	smallCurPageOffset	= SMALL_ALIGN( 0 );
-
-	defragBlock = NULL;
-
-	mediumFirstFreePage	= NULL;								// init medium heap manager
-	mediumLastFreePage	= NULL;
-	mediumFirstUsedPage	= NULL;
+	OSAllocs			= 0;
+	pagesAllocated		= 0;
+	threadCaches		= NULL;
+	usedSpans			= NULL;
+	cachedSpans			= NULL;
+	numCachedSpans		= 0;
+	largeSpans			= NULL;
+	statsFrame			= 0;
+	defragBlock			= NULL;
+
+	// size classes step by ALIGN up to 128 bytes, then four steps per power of two
+	numSizeClasses = 0;
+	for ( bytes = ALIGN; bytes <= 128; bytes += ALIGN ) {
+		sizeClassBytes[numSizeClasses++] = bytes;
+	}
+	for ( step = 32; bytes <= MAX_SMALL_SIZE + 1; step <<= 1 ) {
+		for ( i = 0; i < 4; i++, bytes += step ) {
+			sizeClassBytes[numSizeClasses++] = bytes;
+		}
+	}
+	assert( numSizeClasses <= MAX_SIZE_CLASSES );
+	assert( sizeClassBytes[numSizeClasses-1] > MAX_SMALL_SIZE );
 
-	c_heapAllocRunningCount = 0;
+	sizeClass = 0;
+	for ( i = 0; i < (int)( sizeof( sizeClassForBytes ) / sizeof( sizeClassForBytes[0] ) ); i++ ) {
+		while ( sizeClassBytes[sizeClass] < (dword)( i * ALIGN ) ) {
+			sizeClass++;
+		}
+		sizeClassForBytes[i] = sizeClass;
+	}
 }
 
 /*
@@ -189,41 +281,40 @@ idHeap::~idHeap
 ================
 */
 idHeap::~idHeap( void ) {
+	heapSpan_t *span;
+	heapThreadCache_t *cache;
 
-	idHeap::page_s	*p;
-
-	if ( smallCurPage ) {
-		FreePage( smallCurPage );			// free small-heap current allocation page
-	}
-	p = smallFirstUsedPage;					// free small-heap allocated pages 
-	while( p ) {
-		idHeap::page_s *next = p->next;
-		FreePage( p );
-		p= next;
+	while( usedSpans ) {
+		span = usedSpans;
+		usedSpans = span->heapNext;
+		FreeOS( span, span->osSize );
+		pagesAllocated--;
 	}
 
-	p = largeFirstUsedPage;					// free large-heap allocated pages
-	while( p ) {
-		idHeap::page_s *next = p->next;
-		FreePage( p );
-		p = next;
+	while( cachedSpans ) {
+		span = cachedSpans;
+		cachedSpans = span->heapNext;
+		FreeOS( span, span->osSize );
+		pagesAllocated--;
 	}
 
-	p = mediumFirstFreePage;				// free medium-heap allocated pages
-	while( p ) {
-		idHeap::page_s *next = p->next;
-		FreePage( p );
-		p = next;
+	while( largeSpans ) {
+		span = largeSpans;
+		largeSpans = span->heapNext;
+		FreeOS( span, span->osSize );
+		pagesAllocated--;
 	}
 
-	p = mediumFirstUsedPage;				// free medium-heap allocated completely used pages
-	while( p ) {
-		idHeap::page_s *next = p->next;
-		FreePage( p );
-		p = next;
+	// the thread local pointers of other threads are invalidated by the serial
+	while( threadCaches ) {
+		cache = threadCaches;
+		threadCaches = cache->next;
+		::free( cache );
+	}
+	if ( heap_threadCacheSerial == serial ) {
+		heap_threadCache = NULL;
+		heap_threadCacheSerial = 0;
 	}
-
-	ReleaseSwappedPages();			
 
 	if ( defragBlock ) {
 		free( defragBlock );
@@ -262,17 +353,13 @@ void *idHeap::Allocate( const dword bytes ) {
 	if ( !bytes ) {
 		return NULL;
 	}
-	c_heapAllocRunningCount++;
 
 #if USE_LIBC_MALLOC
 	return malloc( bytes );
 #else
-	if ( !(bytes & ~255) ) {
+	if ( bytes <= MAX_SMALL_SIZE ) {
 		return SmallAllocate( bytes );
 	}
-	if ( !(bytes & ~32767) ) {
-		return MediumAllocate( bytes );
-	}
 	return LargeAllocate( bytes );
 #endif
 }
@@ -283,31 +370,23 @@ idHeap::Free
 ================
 */
 void idHeap::Free( void *p ) {
+	heapSpan_t *span;
+
 	if ( !p ) {
 		return;
 	}
-	c_heapAllocRunningCount--;
 
 #if USE_LIBC_MALLOC
 	free( p );
 #else
-	switch( ((byte *)(p))[-1] ) {
-		case SMALL_ALLOC: {
-			SmallFree( p );
-			break;
-		}
-		case MEDIUM_ALLOC: {
-			MediumFree( p );
-			break;
-		}
-		case LARGE_ALLOC: {
-			LargeFree( p );
-			break;
-		}
-		default: {
-			idLib::common->FatalError( "idHeap::Free: invalid memory block (%s)", idLib::sys->GetCallStackCurStr( 4 ) );
-			break;
-		}
+	span = SPAN_OF( p );
+	if ( span->magic != SPAN_MAGIC || (byte *)p < (byte *)span + SPAN_HEADER_SIZE ) {
+		idLib::common->FatalError( "idHeap::Free: invalid memory block (%s)", idLib::sys->GetCallStackCurStr( 4 ) );
+	}
+	if ( span->sizeClass == LARGE_SIZE_CLASS ) {
+		LargeFree( span );
+	} else {
+		SmallFree( span, p );
 	}
 #endif
 }
@@ -318,6 +397,7 @@ idHeap::Allocate16
 ================
 */
 void *idHeap::Allocate16( const dword bytes ) {
+#if USE_LIBC_MALLOC
 	byte *ptr, *alignedPtr;
 
 	ptr = (byte *) malloc( bytes + 16 + sizeof(intptr_t) );
@@ -326,7 +406,7 @@ void *idHeap::Allocate16( const dword bytes ) {
 			idLib::common->Printf( "Freeing defragBlock on alloc of %i.\n", bytes );
 			free( defragBlock );
 			defragBlock = NULL;
-			ptr = (byte *) malloc( bytes + 16 + sizeof(intptr_t) );			
+			ptr = (byte *) malloc( bytes + 16 + sizeof(intptr_t) );
 			AllocDefragBlock();
 		}
 		if ( !ptr ) {
@@ -339,6 +419,10 @@ void *idHeap::Allocate16( const dword bytes ) {
 	}
 	*((intptr_t*)(alignedPtr - sizeof(intptr_t))) = (intptr_t) ptr;
 	return (void *) alignedPtr;
+#else
+	// every block is 16 byte aligned
+	return Allocate( bytes );
+#endif
 }
 
 /*
@@ -347,7 +431,11 @@ idHeap::Free16
 ================
 */
 void idHeap::Free16( void *p ) {
+#if USE_LIBC_MALLOC
 	free( (void *) *((intptr_t*) (( (byte *) p ) - sizeof(intptr_t))) );
+#else
+	Free( p );
+#endif
 }
 
 /*
@@ -361,6 +449,7 @@ idHeap::Msize
 ================
 */
 dword idHeap::Msize( void *p ) {
+	heapSpan_t *span;
 
 	if ( !p ) {
 		return 0;
@@ -373,21 +462,15 @@ dword idHeap::Msize( void *p ) {
 		return 0;
 	#endif
 #else
-	switch( ((byte *)(p))[-1] ) {
-		case SMALL_ALLOC: {
-			return SMALL_ALIGN( ((byte *)(p))[-SMALL_HEADER_SIZE] * ALIGN );
-		}
-		case MEDIUM_ALLOC: {
-			return ((mediumHeapEntry_s *)(((byte *)(p)) - ALIGN_SIZE( MEDIUM_HEADER_SIZE )))->size - ALIGN_SIZE( MEDIUM_HEADER_SIZE );
-		}
-		case LARGE_ALLOC: {
-			return ((idHeap::page_s*)(*((intptr_t*)(((byte *)p) - ALIGN_SIZE( LARGE_HEADER_SIZE )))))->dataSize - ALIGN_SIZE( LARGE_HEADER_SIZE );
-		}
-		default: {
-			idLib::common->FatalError( "idHeap::Msize: invalid memory block (%s)", idLib::sys->GetCallStackCurStr( 4 ) );
-			return 0;
-		}
+	span = SPAN_OF( p );
+	if ( span->magic != SPAN_MAGIC ) {
+		idLib::common->FatalError( "idHeap::Msize: invalid memory block (%s)", idLib::sys->GetCallStackCurStr( 4 ) );
+		return 0;
 	}
+	if ( span->sizeClass == LARGE_SIZE_CLASS ) {
+		return span->osSize - SPAN_HEADER_SIZE;
+	}
+	return span->blockSize;
 #endif
 }
 
@@ -399,509 +482,387 @@ idHeap::Dump
 ================
 */
 void idHeap::Dump( void ) {
-	idHeap::page_s	*pg;
-
-	for ( pg = smallFirstUsedPage; pg; pg = pg->next ) {
-		idLib::common->Printf( "%p  bytes %-8d  (in use by small heap)\n", pg->data, pg->dataSize);
+	heapThreadCache_t *cache;
+	heapSpan_t *span;
+	int i, numSpans, numBlocks, numUsed;
+
+	lock.Lock();
+
+	for ( cache = threadCaches; cache; cache = cache->next ) {
+		idLib::common->Printf( "thread cache %p\n", cache );
+		for ( i = 0; i < numSizeClasses; i++ ) {
+			numSpans = numBlocks = numUsed = 0;
+			for ( span = cache->spans[i]; span; span = span->next ) {
+				numSpans++;
+				numBlocks += span->numBlocks;
+				numUsed += span->numUsed;
+			}
+			for ( span = cache->fullSpans[i]; span; span = span->next ) {
+				numSpans++;
+				numBlocks += span->numBlocks;
+				numUsed += span->numUsed;
+			}
+			if ( numSpans ) {
+				idLib::common->Printf( "  bytes %-6d  %4d spans  %7d / %7d blocks used\n", sizeClassBytes[i], numSpans, numUsed, numBlocks );
+			}
+		}
 	}
 
-	if ( smallCurPage ) {
-		pg = smallCurPage;
-		idLib::common->Printf( "%p  bytes %-8d  (small heap active page)\n", pg->data, pg->dataSize );
+	for ( span = largeSpans; span; span = span->heapNext ) {
+		idLib::common->Printf( "%p  bytes %-8d  (large allocation)\n", span, span->osSize );
 	}
 
-	for ( pg = mediumFirstUsedPage; pg; pg = pg->next ) {
-		idLib::common->Printf( "%p  bytes %-8d  (completely used by medium heap)\n", pg->data, pg->dataSize );
+	idLib::common->Printf( "cached spans : %d\n", numCachedSpans );
+	idLib::common->Printf( "pages allocated : %d\n", pagesAllocated );
+	idLib::common->Printf( "OS allocs : %d\n", OSAllocs );
+
+	lock.Unlock();
+}
+
+/*
+================
+idHeap::AllocateOS
+
+  allocates SPAN_SIZE aligned memory from the OS
+================
+*/
+void *idHeap::AllocateOS( size_t bytes ) {
+	void *p;
+
+#ifdef _WIN32
+	// the allocation granularity of VirtualAlloc is 64k
+	p = VirtualAlloc( NULL, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE );
+	if ( !p && defragBlock ) {
+		idLib::common->Printf( "Freeing defragBlock on alloc of %i.\n", (int)bytes );
+		free( defragBlock );
+		defragBlock = NULL;
+		p = VirtualAlloc( NULL, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE );
+		AllocDefragBlock();
 	}
+#else
+	byte *ptr, *alignedPtr;
+	size_t size;
 
-	for ( pg = mediumFirstFreePage; pg; pg = pg->next ) {
-		idLib::common->Printf( "%p  bytes %-8d  (partially used by medium heap)\n", pg->data, pg->dataSize );
+	// over allocate and unmap the unaligned start and end
+	size = bytes + SPAN_SIZE;
+	ptr = (byte *) mmap( NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0 );
+	if ( ptr == (byte *) MAP_FAILED && defragBlock ) {
+		idLib::common->Printf( "Freeing defragBlock on alloc of %i.\n", (int)bytes );
+		free( defragBlock );
+		defragBlock = NULL;
+		ptr = (byte *) mmap( NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0 );
+		AllocDefragBlock();
+	}
+	p = NULL;
+	if ( ptr != (byte *) MAP_FAILED ) {
+		alignedPtr = (byte *) ( ( (intptr_t) ptr + SPAN_SIZE - 1 ) & ~( (intptr_t) SPAN_SIZE - 1 ) );
+		if ( alignedPtr > ptr ) {
+			munmap( ptr, alignedPtr - ptr );
+		}
+		if ( ptr + size > alignedPtr + bytes ) {
+			munmap( alignedPtr + bytes, ( ptr + size ) - ( alignedPtr + bytes ) );
+		}
+		p = alignedPtr;
 	}
-	
-	for ( pg = largeFirstUsedPage; pg; pg = pg->next ) {
-		idLib::common->Printf( "%p  bytes %-8d  (fully used by large heap)\n", pg->data, pg->dataSize );
+#endif
+
+	if ( !p ) {
+		common->FatalError( "idHeap: OS allocation failure for %i", (int)bytes );
 	}
+	assert( ( (intptr_t) p & ( SPAN_SIZE - 1 ) ) == 0 );
 
-	idLib::common->Printf( "pages allocated : %d\n", pagesAllocated );
+	OSAllocs++;
+	return p;
 }
 
 /*
 ================
-idHeap::FreePageReal
-
-  frees page to be used by the OS
-  p	= page to free
+idHeap::FreeOS
 ================
 */
-void idHeap::FreePageReal( idHeap::page_s *p ) {
-	assert( p );
-	::free( p );
+void idHeap::FreeOS( void *ptr, size_t bytes ) {
+#ifdef _WIN32
+	VirtualFree( ptr, 0, MEM_RELEASE );
+#else
+	munmap( ptr, bytes );
+#endif
 }
 
 /*
 ================
-idHeap::ReleaseSwappedPages
-
-  releases the swap page to OS
+idHeap::GetThreadCache
 ================
 */
-void idHeap::ReleaseSwappedPages () {
-	if ( swapPage ) {
-		FreePageReal( swapPage );
+heapThreadCache_t *idHeap::GetThreadCache( void ) {
+	if ( heap_threadCacheSerial == serial ) {
+		return heap_threadCache;
 	}
-	swapPage = NULL;
+	return CreateThreadCache();
 }
 
 /*
 ================
-idHeap::AllocatePage
+idHeap::CreateThreadCache
 
-  allocates memory from the OS
-  bytes	= page size in bytes
-  returns pointer to page
+  thread caches are never freed before the heap, spans owned by a thread
+  that exits are not reused but blocks in them can still be freed
 ================
 */
-idHeap::page_s* idHeap::AllocatePage( dword bytes ) {
-	idHeap::page_s*	p;
-
-	pageRequests++;
-
-	if ( swapPage && swapPage->dataSize == bytes ) {			// if we've got a swap page somewhere
-		p			= swapPage;
-		swapPage	= NULL;
-	}
-	else {
-		dword size;
-
-		size = bytes + sizeof(idHeap::page_s);
-
-		p = (idHeap::page_s *) ::malloc( size + ALIGN - 1 );
-		if ( !p ) {
-			if ( defragBlock ) {
-				idLib::common->Printf( "Freeing defragBlock on alloc of %i.\n", size + ALIGN - 1 );
-				free( defragBlock );
-				defragBlock = NULL;
-				p = (idHeap::page_s *) ::malloc( size + ALIGN - 1 );			
-				AllocDefragBlock();
-			}
-			if ( !p ) {
-				common->FatalError( "malloc failure for %i", bytes );
-			}
-		}
-
-		p->data		= (void *) ALIGN_SIZE( (intptr_t)((byte *)(p)) + sizeof( idHeap::page_s ) );
-		p->dataSize	= size - sizeof(idHeap::page_s);
-		p->firstFree = NULL;
-		p->largestFree = 0;
-		OSAllocs++;
-	}
-
-	p->prev = NULL;
-	p->next = NULL;
-
-	pagesAllocated++;
-	
-	return p;
+heapThreadCache_t *idHeap::CreateThreadCache( void ) {
+	heapThreadCache_t *cache;
+
+	cache = (heapThreadCache_t *) ::malloc( sizeof( heapThreadCache_t ) );
+	if ( !cache ) {
+		common->FatalError( "idHeap: malloc failure for thread cache" );
+	}
+	memset( cache, 0, sizeof( heapThreadCache_t ) );
+	cache->heapSerial = serial;
+
+	lock.Lock();
+	cache->statsFrame = statsFrame;
+	cache->frameAllocs.minSize = cache->frameFrees.minSize = cache->totalAllocs.minSize = 0x0fffffff;
+	cache->frameAllocs.maxSize = cache->frameFrees.maxSize = cache->totalAllocs.maxSize = -1;
+	cache->next = threadCaches;
+	threadCaches = cache;
+	lock.Unlock();
+
+	heap_threadCache = cache;
+	heap_threadCacheSerial = serial;
+	return cache;
 }
 
 /*
 ================
-idHeap::FreePage
+idHeap::AllocateSpan
 
-  frees a page back to the operating system
-  p	= pointer to page
+  gets an empty span for the given size class, from the span cache if possible
 ================
 */
-void idHeap::FreePage( idHeap::page_s *p ) {
-	assert( p );
-
-	if ( p->dataSize == pageSize && !swapPage ) {			// add to swap list?
-		swapPage = p;
-	}
-	else {
-		FreePageReal( p );
-	}
-
-	pagesAllocated--;
+heapSpan_t *idHeap::AllocateSpan( heapThreadCache_t *cache, int sizeClass ) {
+	heapSpan_t *span;
+
+	lock.Lock();
+	span = cachedSpans;
+	if ( span ) {
+		SpanHeapUnlink( cachedSpans, span );
+		numCachedSpans--;
+	}
+	lock.Unlock();
+
+	if ( !span ) {
+		span = (heapSpan_t *) AllocateOS( SPAN_SIZE );
+		span->magic = SPAN_MAGIC;
+		span->osSize = SPAN_SIZE;
+		lock.Lock();
+		pagesAllocated++;
+		lock.Unlock();
+	}
+
+	span->sizeClass = sizeClass;
+	span->blockSize = sizeClassBytes[sizeClass];
+	span->owner = cache;
+	span->freeList = NULL;
+	span->remoteFreeList = NULL;
+	span->numBlocks = ( SPAN_SIZE - SPAN_HEADER_SIZE ) / span->blockSize;
+	span->numCarved = 0;
+	span->numUsed = 0;
+	span->full = false;
+	span->prev = span->next = NULL;
+
+	lock.Lock();
+	SpanHeapLinkFront( usedSpans, span );
+	lock.Unlock();
+
+	return span;
 }
 
-//===============================================================
-//
-//	small heap code
-//
-//===============================================================
-
 /*
 ================
-idHeap::SmallAllocate
+idHeap::ReleaseSpan
 
-  allocate memory (1-255 bytes) from the small heap manager
-  bytes = number of bytes to allocate
-  returns pointer to allocated memory
+  the span must be empty and unlinked from the owner lists
 ================
 */
-void *idHeap::SmallAllocate( dword bytes ) {
-	// we need the at least sizeof( dword ) bytes for the free list
-	if ( bytes < sizeof(intptr_t) ) {
-		bytes = sizeof(intptr_t);
-	}
+void idHeap::ReleaseSpan( heapSpan_t *span ) {
+	assert( span->numUsed == 0 && span->remoteFreeList == NULL );
 
-	// increase the number of bytes if necessary to make sure the next small allocation is aligned
-	bytes = SMALL_ALIGN( bytes );
+	span->owner = NULL;
 
-	byte *smallBlock = (byte *)(smallFirstFree[bytes / ALIGN]);
-	if ( smallBlock ) {
-		intptr_t*link = (intptr_t*)(smallBlock + SMALL_HEADER_SIZE);
-		smallBlock[1] = SMALL_ALLOC;					// allocation identifier
-		smallFirstFree[bytes / ALIGN] = (void *)(*link);
-		return (void *)(link);
+	lock.Lock();
+	SpanHeapUnlink( usedSpans, span );
+	if ( numCachedSpans < MAX_CACHED_SPANS ) {
+		SpanHeapLinkFront( cachedSpans, span );
+		numCachedSpans++;
+		span = NULL;
+	} else {
+		pagesAllocated--;
 	}
+	lock.Unlock();
 
-	dword bytesLeft = (size_t)(pageSize) - smallCurPageOffset;
-	// if we need to allocate a new page
-	if ( bytes >= bytesLeft ) {
-
-		smallCurPage->next	= smallFirstUsedPage;
-		smallFirstUsedPage	= smallCurPage;
-		smallCurPage		= AllocatePage( pageSize );
-		if ( !smallCurPage ) {
-			return NULL;
-		}
-		// make sure the first allocation is aligned
-		smallCurPageOffset	= SMALL_ALIGN( 0 );
+	if ( span ) {
+		FreeOS( span, span->osSize );
 	}
-
-	smallBlock			= ((byte *)smallCurPage->data) + smallCurPageOffset;
-	smallBlock[0]		= (byte)(bytes / ALIGN);		// write # of bytes/ALIGN
-	smallBlock[1]		= SMALL_ALLOC;					// allocation identifier
-	smallCurPageOffset  += bytes + SMALL_HEADER_SIZE;	// increase the offset on the current page
-	return ( smallBlock + SMALL_HEADER_SIZE );			// skip the first two bytes
 }
 
 /*
 ================
-idHeap::SmallFree
+idHeap::CollectRemoteFrees
 
-  frees a block of memory allocated by SmallAllocate() call
-  data = pointer to block of memory
+  moves the blocks other threads freed to the owner free list
 ================
 */
-void idHeap::SmallFree( void *ptr ) {
-	((byte *)(ptr))[-1] = INVALID_ALLOC;
+bool idHeap::CollectRemoteFrees( heapSpan_t *span ) {
+	void *list, *last;
+	int num;
 
-	byte *d = ( (byte *)ptr ) - SMALL_HEADER_SIZE;
-	intptr_t *dt = (intptr_t *)ptr;
-	// index into the table with free small memory blocks
-	dword ix = *d;
+	if ( span->remoteFreeList == NULL ) {
+		return false;
+	}
 
-	// check if the index is correct
-	if ( ix > (256 / ALIGN) ) {
-		idLib::common->FatalError( "SmallFree: invalid memory block" );
+	list = Sys_InterlockedExchangePointer( span->remoteFreeList, NULL );
+	if ( !list ) {
+		return false;
 	}
 
-	*dt = (intptr_t)smallFirstFree[ix];	// write next index
-	smallFirstFree[ix] = (void *)d;		// link
+	for ( num = 1, last = list; *(void **)last; last = *(void **)last ) {
+		num++;
+	}
+	*(void **)last = span->freeList;
+	span->freeList = list;
+	span->numUsed -= num;
+	assert( span->numUsed >= 0 );
+	return true;
 }
 
-//===============================================================
-//
-//	medium heap code
-//
-//	Medium-heap allocated pages not returned to OS until heap destructor
-//	called (re-used instead on subsequent medium-size malloc requests).
-//
-//===============================================================
-
 /*
 ================
-idHeap::MediumAllocateFromPage
+idHeap::RefillSizeClass
 
-  performs allocation using the medium heap manager from a given page
-  p				= page
-  sizeNeeded	= # of bytes needed
-  returns pointer to allocated memory
+  returns a span with free blocks for the size class at the head of the cache list
 ================
 */
-void *idHeap::MediumAllocateFromPage( idHeap::page_s *p, dword sizeNeeded ) {
-
-	mediumHeapEntry_s	*best,*nw = NULL;
-	byte				*ret;
-
-	best = (mediumHeapEntry_s *)(p->firstFree);			// first block is largest
-
-	assert( best );
-	assert( best->size == p->largestFree );
-	assert( best->size >= sizeNeeded );
-
-	// if we can allocate another block from this page after allocating sizeNeeded bytes
-	if ( best->size >= (dword)( sizeNeeded + MEDIUM_SMALLEST_SIZE ) ) {
-		nw = (mediumHeapEntry_s *)((byte *)best + best->size - sizeNeeded);
-		nw->page		= p;
-		nw->prev		= best;
-		nw->next		= best->next;
-		nw->prevFree	= NULL;
-		nw->nextFree	= NULL;
-		nw->size		= sizeNeeded;
-		nw->freeBlock	= 0;			// used block
-		if ( best->next ) {
-			best->next->prev = nw;
+heapSpan_t *idHeap::RefillSizeClass( heapThreadCache_t *cache, int sizeClass ) {
+	heapSpan_t *span;
+	int i;
+
+	// move spans that ran out of blocks to the full list
+	while( ( span = cache->spans[sizeClass] ) != NULL ) {
+		if ( SpanHasFreeBlocks( span ) || CollectRemoteFrees( span ) ) {
+			return span;
 		}
-		best->next	= nw;
-		best->size	-= sizeNeeded;
-		
-		p->largestFree = best->size;
-	}
-	else {
-		if ( best->prevFree ) {
-			best->prevFree->nextFree = best->nextFree;
-		}
-		else {
-			p->firstFree = (void *)best->nextFree;
+		SpanUnlink( cache->spans[sizeClass], span );
+		SpanLinkFront( cache->fullSpans[sizeClass], span );
+		span->full = true;
+	}
+
+	// check a few full spans for blocks freed by other threads
+	for ( i = 0; i < MAX_FULL_SPAN_SCAN && cache->fullSpans[sizeClass]; i++ ) {
+		span = cache->fullSpans[sizeClass];
+		SpanUnlink( cache->fullSpans[sizeClass], span );
+		if ( CollectRemoteFrees( span ) ) {
+			span->full = false;
+			SpanLinkFront( cache->spans[sizeClass], span );
+			return span;
 		}
-		if ( best->nextFree ) {
-			best->nextFree->prevFree = best->prevFree;
+		// rotate so the next refill checks other spans
+		span->prev = NULL;
+		span->next = NULL;
+		if ( cache->fullSpans[sizeClass] ) {
+			heapSpan_t *last;
+			for ( last = cache->fullSpans[sizeClass]; last->next; last = last->next ) {
+			}
+			last->next = span;
+			span->prev = last;
+		} else {
+			cache->fullSpans[sizeClass] = span;
 		}
-
-		best->prevFree  = NULL;
-		best->nextFree  = NULL;
-		best->freeBlock = 0;			// used block
-		nw = best;
-
-		p->largestFree = 0;
 	}
 
-	ret		= (byte *)(nw) + ALIGN_SIZE( MEDIUM_HEADER_SIZE );
-	ret[-1] = MEDIUM_ALLOC;		// allocation identifier
-
-	return (void *)(ret);
+	span = AllocateSpan( cache, sizeClass );
+	SpanLinkFront( cache->spans[sizeClass], span );
+	return span;
 }
 
+//===============================================================
+//
+//	small heap code
+//
+//===============================================================
+
 /*
 ================
-idHeap::MediumAllocate
+idHeap::SmallAllocate
 
-  allocate memory (256-32768 bytes) from medium heap manager
-  bytes	= number of bytes to allocate
+  allocate memory (1-32767 bytes) from the calling thread's cache
+  bytes = number of bytes to allocate
   returns pointer to allocated memory
 ================
 */
-void *idHeap::MediumAllocate( dword bytes ) {
-	idHeap::page_s		*p;
-	void				*data;
+void *idHeap::SmallAllocate( dword bytes ) {
+	heapThreadCache_t *cache;
+	heapSpan_t *span;
+	int sizeClass;
+	void *p;
 
-	dword sizeNeeded = ALIGN_SIZE( bytes ) + ALIGN_SIZE( MEDIUM_HEADER_SIZE );
+	cache = GetThreadCache();
+	sizeClass = sizeClassForBytes[ ( bytes + ALIGN - 1 ) / ALIGN ];
 
-	// find first page with enough space
-	for ( p = mediumFirstFreePage; p; p = p->next ) {
-		if ( p->largestFree >= sizeNeeded ) {
-			break;
-		}
+	span = cache->spans[sizeClass];
+	if ( !span || !SpanHasFreeBlocks( span ) ) {
+		span = RefillSizeClass( cache, sizeClass );
 	}
 
-	if ( !p ) {								// need to allocate new page?
-		p = AllocatePage( pageSize );
-		if ( !p ) {
-			return NULL;					// malloc failure!
-		}
-		p->prev		= NULL;
-		p->next		= mediumFirstFreePage;
-		if (p->next) {
-			p->next->prev = p;
-		}
-		else {
-			mediumLastFreePage	= p;
-		}
-
-		mediumFirstFreePage		= p;
-		
-		p->largestFree	= pageSize;
-		p->firstFree	= (void *)p->data;
-
-		mediumHeapEntry_s *e;
-		e				= (mediumHeapEntry_s *)(p->firstFree);
-		e->page			= p;
-		// make sure ((byte *)e + e->size) is aligned
-		e->size			= pageSize & ~(ALIGN - 1);
-		e->prev			= NULL;
-		e->next			= NULL;
-		e->prevFree		= NULL;
-		e->nextFree		= NULL;
-		e->freeBlock	= 1;
-	}
-
-	data = MediumAllocateFromPage( p, sizeNeeded );		// allocate data from page
-
-    // if the page can no longer serve memory, move it away from free list
-	// (so that it won't slow down the later alloc queries)
-	// this modification speeds up the pageWalk from O(N) to O(sqrt(N))
-	// a call to free may swap this page back to the free list
-
-	if ( p->largestFree < MEDIUM_SMALLEST_SIZE ) {
-		if ( p == mediumLastFreePage ) {
-			mediumLastFreePage = p->prev;
-		}
-
-		if ( p == mediumFirstFreePage ) {
-			mediumFirstFreePage = p->next;
-		}
-
-		if ( p->prev ) {
-			p->prev->next = p->next;
-		}
-		if ( p->next ) {
-			p->next->prev = p->prev;
-		}
-
-		// link to "completely used" list
-		p->prev = NULL;
-		p->next = mediumFirstUsedPage;
-		if ( p->next ) {
-			p->next->prev = p;
-		}
-		mediumFirstUsedPage = p;
-		return data;
-	} 
-
-	// re-order linked list (so that next malloc query starts from current
-	// matching block) -- this speeds up both the page walks and block walks
-
-	if ( p != mediumFirstFreePage ) {
-		assert( mediumLastFreePage );
-		assert( mediumFirstFreePage );
-		assert( p->prev);
-
-		mediumLastFreePage->next	= mediumFirstFreePage;
-		mediumFirstFreePage->prev	= mediumLastFreePage;
-		mediumLastFreePage			= p->prev;
-		p->prev->next				= NULL;
-		p->prev						= NULL;
-		mediumFirstFreePage			= p;
+	p = span->freeList;
+	if ( p ) {
+		span->freeList = *(void **)p;
+	} else {
+		p = (byte *)span + SPAN_HEADER_SIZE + span->numCarved * span->blockSize;
+		span->numCarved++;
 	}
+	span->numUsed++;
 
-	return data;
+	return p;
 }
 
 /*
 ================
-idHeap::MediumFree
+idHeap::SmallFree
 
-  frees a block allocated by the medium heap manager
-  ptr	= pointer to data block
+  frees a block allocated by SmallAllocate, possibly from another thread
 ================
 */
-void idHeap::MediumFree( void *ptr ) {
-	((byte *)(ptr))[-1] = INVALID_ALLOC;
-
-	mediumHeapEntry_s	*e = (mediumHeapEntry_s *)((byte *)ptr - ALIGN_SIZE( MEDIUM_HEADER_SIZE ));
-	idHeap::page_s		*p = e->page;
-	bool				isInFreeList;
-
-	isInFreeList = p->largestFree >= MEDIUM_SMALLEST_SIZE;
-
-	assert( e->size );
-	assert( e->freeBlock == 0 );
-
-	mediumHeapEntry_s *prev = e->prev;
-
-	// if the previous block is free we can merge
-	if ( prev && prev->freeBlock ) {
-		prev->size += e->size;
-		prev->next = e->next;
-		if ( e->next ) {
-			e->next->prev = prev;
-		}
-		e = prev;
+void idHeap::SmallFree( heapSpan_t *span, void *ptr ) {
+	heapThreadCache_t *cache;
+	void *head;
+	int sizeClass;
+
+	cache = ( heap_threadCacheSerial == serial ) ? heap_threadCache : NULL;
+
+	if ( span->owner != cache ) {
+		// lock-free push, only the owner ever pops so there is no ABA problem
+		do {
+			head = span->remoteFreeList;
+			*(void **)ptr = head;
+		} while( Sys_InterlockedCompareExchangePointer( span->remoteFreeList, head, ptr ) != head );
+		return;
 	}
-	else {
-		e->prevFree		= NULL;				// link to beginning of free list
-		e->nextFree		= (mediumHeapEntry_s *)p->firstFree;
-		if ( e->nextFree ) {
-			assert( !(e->nextFree->prevFree) );
-			e->nextFree->prevFree = e;
-		}
 
-		p->firstFree	= e;
-		p->largestFree	= e->size;
-		e->freeBlock	= 1;				// mark block as free
-	}
-			
-	mediumHeapEntry_s *next = e->next;
+	*(void **)ptr = span->freeList;
+	span->freeList = ptr;
+	span->numUsed--;
 
-	// if the next block is free we can merge
-	if ( next && next->freeBlock ) {
-		e->size += next->size;
-		e->next = next->next;
-		
-		if ( next->next ) {
-			next->next->prev = e;
-		}
-		
-		if ( next->prevFree ) {
-			next->prevFree->nextFree = next->nextFree;
-		}
-		else {
-			assert( next == p->firstFree );
-			p->firstFree = next->nextFree;
-		}
-
-		if ( next->nextFree ) {
-			next->nextFree->prevFree = next->prevFree;
-		}
+	sizeClass = span->sizeClass;
+	if ( span->full ) {
+		SpanUnlink( cache->fullSpans[sizeClass], span );
+		SpanLinkFront( cache->spans[sizeClass], span );
+		span->full = false;
 	}
 
-	if ( p->firstFree ) {
-		p->largestFree = ((mediumHeapEntry_s *)(p->firstFree))->size;
+	// give completely unused spans back, but keep one around for the size class
+	if ( span->numUsed == 0 && ( span->prev || span->next ) && span->remoteFreeList == NULL ) {
+		SpanUnlink( cache->spans[sizeClass], span );
+		ReleaseSpan( span );
 	}
-	else {
-		p->largestFree = 0;
-	}
-
-	// did e become the largest block of the page ?
-
-	if ( e->size > p->largestFree ) {
-		assert( e != p->firstFree );
-		p->largestFree = e->size;
-
-		if ( e->prevFree ) {
-			e->prevFree->nextFree = e->nextFree;
-		}
-		if ( e->nextFree ) {
-			e->nextFree->prevFree = e->prevFree;
-		}
-		
-		e->nextFree = (mediumHeapEntry_s *)p->firstFree;
-		e->prevFree = NULL;
-		if ( e->nextFree ) {
-			e->nextFree->prevFree = e;
-		}
-		p->firstFree = e;
-	}
-
-	// if page wasn't in free list (because it was near-full), move it back there
-	if ( !isInFreeList ) {
-
-		// remove from "completely used" list
-		if ( p->prev ) {
-			p->prev->next = p->next;
-		}
-		if ( p->next ) {
-			p->next->prev = p->prev;
-		}
-		if ( p == mediumFirstUsedPage ) {
-			mediumFirstUsedPage = p->next;
-		}
-
-		p->next = NULL;
-		p->prev = mediumLastFreePage;
-
-		if ( mediumLastFreePage ) {
-			mediumLastFreePage->next = p;
-		}
-		mediumLastFreePage = p;
-		if ( !mediumFirstFreePage ) {
-			mediumFirstFreePage = p;
-		}
-	} 
 }
 
 //===============================================================
@@ -920,28 +881,24 @@ idHeap::LargeAllocate
 ================
 */
 void *idHeap::LargeAllocate( dword bytes ) {
-	idHeap::page_s *p = AllocatePage( bytes + ALIGN_SIZE( LARGE_HEADER_SIZE ) );
-
-	assert( p );
+	heapSpan_t *span;
+	size_t size;
 
-	if ( !p ) {
-		return NULL;
-	}
+	size = ( SPAN_HEADER_SIZE + bytes + OS_PAGE_SIZE - 1 ) & ~( OS_PAGE_SIZE - 1 );
+	span = (heapSpan_t *) AllocateOS( size );
 
-	byte *	d	= (byte*)(p->data) + ALIGN_SIZE( LARGE_HEADER_SIZE );
-	intptr_t *	dw	= (intptr_t*)(d - ALIGN_SIZE( LARGE_HEADER_SIZE ));
-	dw[0]		= (intptr_t)p;				// write pointer back to page table
-	d[-1]		= LARGE_ALLOC;			// allocation identifier
+	memset( span, 0, sizeof( heapSpan_t ) );
+	span->magic = SPAN_MAGIC;
+	span->sizeClass = LARGE_SIZE_CLASS;
+	span->blockSize = bytes;
+	span->osSize = (dword) size;
 
-	// link to 'large used page list'
-	p->prev = NULL;
-	p->next = largeFirstUsedPage;
-	if ( p->next ) {
-		p->next->prev = p;
-	}
-	largeFirstUsedPage = p;
+	lock.Lock();
+	SpanHeapLinkFront( largeSpans, span );
+	pagesAllocated++;
+	lock.Unlock();
 
-	return (void *)(d);
+	return (byte *)span + SPAN_HEADER_SIZE;
 }
 
 /*
@@ -949,30 +906,83 @@ void *idHeap::LargeAllocate( dword bytes ) {
 idHeap::LargeFree
 
   frees a block of memory allocated by the 'large memory allocator'
-  p	= pointer to allocated memory
 ================
 */
-void idHeap::LargeFree( void *ptr) {
-	idHeap::page_s*	pg;
+void idHeap::LargeFree( heapSpan_t *span ) {
+	lock.Lock();
+	SpanHeapUnlink( largeSpans, span );
+	pagesAllocated--;
+	lock.Unlock();
 
-	((byte *)(ptr))[-1] = INVALID_ALLOC;
+	span->magic = 0;
+	FreeOS( span, span->osSize );
+}
 
-	// get page pointer
-	pg = (idHeap::page_s *)(*((intptr_t*)(((byte *)ptr) - ALIGN_SIZE( LARGE_HEADER_SIZE ))));
+/*
+================
+idHeap::GetThreadStats
 
-	// unlink from doubly linked list
-	if ( pg->prev ) {
-		pg->prev->next = pg->next;
-	}
-	if ( pg->next ) {
-		pg->next->prev = pg->prev;
-	}
-	if ( pg == largeFirstUsedPage ) {
-		largeFirstUsedPage = pg->next;
-	}
-	pg->next = pg->prev = NULL;
+  stats are kept per thread so updating them doesn't need a lock
+================
+*/
+heapThreadCache_t *idHeap::GetThreadStats( void ) {
+	heapThreadCache_t *cache = GetThreadCache();
+	if ( cache->statsFrame != statsFrame ) {
+		cache->statsFrame = statsFrame;
+		cache->frameAllocs.num = cache->frameFrees.num = 0;
+		cache->frameAllocs.minSize = cache->frameFrees.minSize = 0x0fffffff;
+		cache->frameAllocs.maxSize = cache->frameFrees.maxSize = -1;
+		cache->frameAllocs.totalSize = cache->frameFrees.totalSize = 0;
+	}
+	return cache;
+}
 
-	FreePage(pg);
+/*
+================
+idHeap::ClearFrameStats
+
+  thread caches reset their frame stats lazily when they see the new frame
+================
+*/
+void idHeap::ClearFrameStats( void ) {
+	lock.Lock();
+	statsFrame++;
+	lock.Unlock();
+}
+
+/*
+================
+idHeap::GetStats
+
+  sums the stats of all thread caches, the values are not exact while other threads allocate
+================
+*/
+void idHeap::GetStats( memoryStats_t &frameAllocs, memoryStats_t &frameFrees, memoryStats_t &totalAllocs ) {
+	heapThreadCache_t *cache;
+
+	frameAllocs.num = frameFrees.num = totalAllocs.num = 0;
+	frameAllocs.minSize = frameFrees.minSize = totalAllocs.minSize = 0x0fffffff;
+	frameAllocs.maxSize = frameFrees.maxSize = totalAllocs.maxSize = -1;
+	frameAllocs.totalSize = frameFrees.totalSize = totalAllocs.totalSize = 0;
+
+	lock.Lock();
+	for ( cache = threadCaches; cache; cache = cache->next ) {
+		if ( cache->statsFrame == statsFrame ) {
+			frameAllocs.num += cache->frameAllocs.num;
+			frameAllocs.minSize = Min( frameAllocs.minSize, cache->frameAllocs.minSize );
+			frameAllocs.maxSize = Max( frameAllocs.maxSize, cache->frameAllocs.maxSize );
+			frameAllocs.totalSize += cache->frameAllocs.totalSize;
+			frameFrees.num += cache->frameFrees.num;
+			frameFrees.minSize = Min( frameFrees.minSize, cache->frameFrees.minSize );
+			frameFrees.maxSize = Max( frameFrees.maxSize, cache->frameFrees.maxSize );
+			frameFrees.totalSize += cache->frameFrees.totalSize;
+		}
+		totalAllocs.num += cache->totalAllocs.num;
+		totalAllocs.minSize = Min( totalAllocs.minSize, cache->totalAllocs.minSize );
+		totalAllocs.maxSize = Max( totalAllocs.maxSize, cache->totalAllocs.maxSize );
+		totalAllocs.totalSize += cache->totalAllocs.totalSize;
+	}
+	lock.Unlock();
 }
 
 //===============================================================
@@ -984,9 +994,6 @@ void idHeap::LargeFree( void *ptr) {
 #undef new
 
 static idHeap *			mem_heap = NULL;
-static memoryStats_t	mem_total_allocs = { 0, 0x0fffffff, -1, 0 };
-static memoryStats_t	mem_frame_allocs;
-static memoryStats_t	mem_frame_frees;
 
 /*
 ==================
@@ -994,10 +1001,9 @@ Mem_ClearFrameStats
 ==================
 */
 void Mem_ClearFrameStats( void ) {
-	mem_frame_allocs.num = mem_frame_frees.num = 0;
-	mem_frame_allocs.minSize = mem_frame_frees.minSize = 0x0fffffff;
-	mem_frame_allocs.maxSize = mem_frame_frees.maxSize = -1;
-	mem_frame_allocs.totalSize = mem_frame_frees.totalSize = 0;
+	if ( mem_heap ) {
+		mem_heap->ClearFrameStats();
+	}
 }
 
 /*
@@ -1006,8 +1012,14 @@ Mem_GetFrameStats
 ==================
 */
 void Mem_GetFrameStats( memoryStats_t &allocs, memoryStats_t &frees ) {
-	allocs = mem_frame_allocs;
-	frees = mem_frame_frees;
+	memoryStats_t total;
+
+	if ( !mem_heap ) {
+		memset( &allocs, 0, sizeof( allocs ) );
+		memset( &frees, 0, sizeof( frees ) );
+		return;
+	}
+	mem_heap->GetStats( allocs, frees, total );
 }
 
 /*
@@ -1016,7 +1028,13 @@ Mem_GetStats
 ==================
 */
 void Mem_GetStats( memoryStats_t &stats ) {
-	stats = mem_total_allocs;
+	memoryStats_t allocs, frees;
+
+	if ( !mem_heap ) {
+		memset( &stats, 0, sizeof( stats ) );
+		return;
+	}
+	mem_heap->GetStats( allocs, frees, stats );
 }
 
 /*
@@ -1041,8 +1059,9 @@ Mem_UpdateAllocStats
 ==================
 */
 void Mem_UpdateAllocStats( int size ) {
-	Mem_UpdateStats( mem_frame_allocs, size );
-	Mem_UpdateStats( mem_total_allocs, size );
+	heapThreadCache_t *cache = mem_heap->GetThreadStats();
+	Mem_UpdateStats( cache->frameAllocs, size );
+	Mem_UpdateStats( cache->totalAllocs, size );
 }
 
 /*
@@ -1051,9 +1070,289 @@ Mem_UpdateFreeStats
 ==================
 */
 void Mem_UpdateFreeStats( int size ) {
-	Mem_UpdateStats( mem_frame_frees, size );
-	mem_total_allocs.num--;
-	mem_total_allocs.totalSize -= size;
+	heapThreadCache_t *cache = mem_heap->GetThreadStats();
+	Mem_UpdateStats( cache->frameFrees, size );
+	cache->totalAllocs.num--;
+	cache->totalAllocs.totalSize -= size;
+}
+
+/*
+===============================================================================
+
+	Allocation traces
+
+	memoryTrace records the Mem_Alloc and Mem_Free calls of all threads,
+	testHeap replays a recorded trace against idHeap and the C library heap.
+
+===============================================================================
+*/
+
+const int MEMTRACE_MAGIC		= ( 'M' << 24 ) | ( 'T' << 16 ) | ( 'R' << 8 ) | 'C';
+const int MEMTRACE_VERSION		= 1;
+
+typedef struct {
+	void *					ptr;
+	int						size;				// 0 for a free
+} memTraceEvent_t;
+
+typedef struct {
+	int						slot;				// allocations are numbered by slots that are reused after a free
+	int						size;				// 0 for a free
+} memTraceRecord_t;
+
+static volatile bool		mem_tracing = false;
+static idSysSpinLock		mem_traceLock;
+static memTraceEvent_t *	mem_traceEvents = NULL;
+static int					mem_numTraceEvents = 0;
+static int					mem_maxTraceEvents = 0;
+
+/*
+==================
+Mem_TraceEvent
+==================
+*/
+static void Mem_TraceEvent( void *ptr, int size ) {
+	mem_traceLock.Lock();
+	if ( mem_tracing ) {
+		if ( mem_numTraceEvents >= mem_maxTraceEvents ) {
+			// the trace buffer comes from the C library so it doesn't show up in the trace
+			int newMax = mem_maxTraceEvents ? mem_maxTraceEvents * 2 : 1024 * 1024;
+			memTraceEvent_t *newEvents = (memTraceEvent_t *) realloc( mem_traceEvents, newMax * sizeof( memTraceEvent_t ) );
+			if ( !newEvents ) {
+				mem_tracing = false;
+				mem_traceLock.Unlock();
+				return;
+			}
+			mem_traceEvents = newEvents;
+			mem_maxTraceEvents = newMax;
+		}
+		mem_traceEvents[mem_numTraceEvents].ptr = ptr;
+		mem_traceEvents[mem_numTraceEvents].size = size;
+		mem_numTraceEvents++;
+	}
+	mem_traceLock.Unlock();
+}
+
+#define MEM_TRACE( ptr, size )	if ( mem_tracing && (ptr) ) { Mem_TraceEvent( (ptr), (size) ); }
+
+/*
+==================
+Mem_WriteTrace
+
+  converts the recorded pointers to slots and writes the trace
+==================
+*/
+static void Mem_WriteTrace( const char *fileName ) {
+	idHashIndex			hash;
+	idList<void *>		slotPtrs;
+	idList<int>			freeSlots;
+	memTraceRecord_t	record;
+	idFile *			f;
+	int					i, key, slot, numRecords;
+
+	f = idLib::fileSystem->OpenFileWrite( fileName );
+	if ( !f ) {
+		idLib::common->Warning( "could not open %s", fileName );
+		return;
+	}
+
+	f->WriteInt( MEMTRACE_MAGIC );
+	f->WriteInt( MEMTRACE_VERSION );
+	f->WriteInt( 0 );		// number of records, written at the end
+	f->WriteInt( 0 );		// number of slots
+
+	slotPtrs.SetGranularity( 1024 );
+	hash.Clear( 65536, 65536 );
+	numRecords = 0;
+
+	for ( i = 0; i < mem_numTraceEvents; i++ ) {
+		const memTraceEvent_t &event = mem_traceEvents[i];
+		key = hash.GenerateKey( (int)( (intptr_t) event.ptr >> 4 ), (int)( (uint64_t) event.ptr >> 32 ) );
+
+		for ( slot = hash.First( key ); slot != -1; slot = hash.Next( slot ) ) {
+			if ( slotPtrs[slot] == event.ptr ) {
+				break;
+			}
+		}
+
+		if ( event.size ) {
+			if ( slot != -1 ) {
+				// freed before the trace started and allocated again
+				hash.Remove( key, slot );
+				freeSlots.Append( slot );
+			}
+			if ( freeSlots.Num() ) {
+				slot = freeSlots[freeSlots.Num() - 1];
+				freeSlots.RemoveIndex( freeSlots.Num() - 1 );
+				slotPtrs[slot] = event.ptr;
+			} else {
+				slot = slotPtrs.Append( event.ptr );
+			}
+			hash.Add( key, slot );
+		} else {
+			if ( slot == -1 ) {
+				// allocated before the trace started
+				continue;
+			}
+			hash.Remove( key, slot );
+			freeSlots.Append( slot );
+		}
+
+		record.slot = slot;
+		record.size = event.size;
+		f->WriteInt( record.slot );
+		f->WriteInt( record.size );
+		numRecords++;
+	}
+
+	f->Seek( 2 * sizeof( int ), FS_SEEK_SET );
+	f->WriteInt( numRecords );
+	f->WriteInt( slotPtrs.Num() );
+
+	idLib::common->Printf( "wrote %d allocation events using %d slots to %s\n", numRecords, slotPtrs.Num(), fileName );
+
+	idLib::fileSystem->CloseFile( f );
+}
+
+/*
+==================
+Mem_Trace_f
+==================
+*/
+void Mem_Trace_f( const idCmdArgs &args ) {
+	const char *cmd = args.Argv( 1 );
+
+	if ( !idStr::Icmp( cmd, "start" ) ) {
+		mem_traceLock.Lock();
+		mem_numTraceEvents = 0;
+		mem_tracing = true;
+		mem_traceLock.Unlock();
+		idLib::common->Printf( "recording memory allocations\n" );
+	} else if ( !idStr::Icmp( cmd, "stop" ) && args.Argc() >= 3 ) {
+		mem_traceLock.Lock();
+		mem_tracing = false;
+		mem_traceLock.Unlock();
+
+		idStr fileName = args.Argv( 2 );
+		fileName.DefaultFileExtension( ".mtrace" );
+		Mem_WriteTrace( fileName );
+
+		free( mem_traceEvents );
+		mem_traceEvents = NULL;
+		mem_numTraceEvents = mem_maxTraceEvents = 0;
+	} else {
+		idLib::common->Printf( "usage: memoryTrace start | stop <file>\n" );
+	}
+}
+
+/*
+==================
+Mem_TestHeap_f
+
+  replays a trace recorded with memoryTrace
+==================
+*/
+void Mem_TestHeap_f( const idCmdArgs &args ) {
+	memTraceRecord_t *	records;
+	void **				slots;
+	idFile *			f;
+	idTimer				heapTimer, mallocTimer;
+	int					i, magic, version, numRecords, numSlots, numAllocs, totalSize;
+
+	if ( args.Argc() < 2 ) {
+		idLib::common->Printf( "usage: testHeap <file>\n" );
+		return;
+	}
+	if ( !mem_heap ) {
+		return;
+	}
+
+	idStr fileName = args.Argv( 1 );
+	fileName.DefaultFileExtension( ".mtrace" );
+	f = idLib::fileSystem->OpenFileRead( fileName );
+	if ( !f ) {
+		idLib::common->Warning( "could not open %s", fileName.c_str() );
+		return;
+	}
+
+	f->ReadInt( magic );
+	f->ReadInt( version );
+	f->ReadInt( numRecords );
+	f->ReadInt( numSlots );
+	if ( magic != MEMTRACE_MAGIC || version != MEMTRACE_VERSION || numRecords < 0 || numSlots < 0 ||
+			numRecords > ( f->Length() - f->Tell() ) / (int)( 2 * sizeof( int ) ) ) {
+		idLib::common->Warning( "%s is not a memory trace", fileName.c_str() );
+		idLib::fileSystem->CloseFile( f );
+		return;
+	}
+
+	records = (memTraceRecord_t *) malloc( numRecords * sizeof( memTraceRecord_t ) + 1 );
+	slots = (void **) calloc( numSlots + 1, sizeof( void * ) );
+	numAllocs = totalSize = 0;
+	for ( i = 0; i < numRecords; i++ ) {
+		f->ReadInt( records[i].slot );
+		f->ReadInt( records[i].size );
+		// the slots index the replay table so a bad record can't be replayed
+		if ( records[i].slot < 0 || records[i].slot >= numSlots || records[i].size < 0 ) {
+			break;
+		}
+		if ( records[i].size ) {
+			numAllocs++;
+			totalSize += records[i].size;
+		}
+	}
+	idLib::fileSystem->CloseFile( f );
+
+	if ( i < numRecords ) {
+		idLib::common->Warning( "%s has an invalid record %d (slot %d, size %d)", fileName.c_str(), i, records[i].slot, records[i].size );
+		free( records );
+		free( slots );
+		return;
+	}
+
+	// idHeap, called directly so the stats and the debug memory headers don't skew the result
+	heapTimer.Start();
+	for ( i = 0; i < numRecords; i++ ) {
+		const memTraceRecord_t &r = records[i];
+		if ( r.size ) {
+			slots[r.slot] = mem_heap->Allocate( r.size );
+		} else {
+			mem_heap->Free( slots[r.slot] );
+			slots[r.slot] = NULL;
+		}
+	}
+	for ( i = 0; i < numSlots; i++ ) {
+		mem_heap->Free( slots[i] );
+		slots[i] = NULL;
+	}
+	heapTimer.Stop();
+
+	// C library heap
+	mallocTimer.Start();
+	for ( i = 0; i < numRecords; i++ ) {
+		const memTraceRecord_t &r = records[i];
+		if ( r.size ) {
+			slots[r.slot] = malloc( r.size );
+		} else {
+			free( slots[r.slot] );
+			slots[r.slot] = NULL;
+		}
+	}
+	for ( i = 0; i < numSlots; i++ ) {
+		free( slots[i] );
+		slots[i] = NULL;
+	}
+	mallocTimer.Stop();
+
+	idLib::common->Printf( "%d allocs (%d kB), %d frees, %d slots\n", numAllocs, totalSize >> 10, numRecords - numAllocs, numSlots );
+	idLib::common->Printf( "idHeap:   %6.2f ms\n", heapTimer.Milliseconds() );
+	idLib::common->Printf( "malloc:   %6.2f ms\n", mallocTimer.Milliseconds() );
+	if ( heapTimer.Milliseconds() > 0.0 ) {
+		idLib::common->Printf( "speedup:  %6.2fx\n", mallocTimer.Milliseconds() / heapTimer.Milliseconds() );
+	}
+
+	free( records );
+	free( slots );
 }
 
 
@@ -1076,6 +1375,7 @@ void *Mem_Alloc( const size_t size ) {
 	}
 	void *mem = mem_heap->Allocate( size );
 	Mem_UpdateAllocStats( mem_heap->Msize( mem ) );
+	MEM_TRACE( mem, size );
 	return mem;
 }
 
@@ -1096,6 +1396,7 @@ void Mem_Free( void *ptr ) {
 		return;
 	}
 	Mem_UpdateFreeStats( mem_heap->Msize( ptr ) );
+	MEM_TRACE( ptr, 0 );
  	mem_heap->Free( ptr );
 }
 
@@ -1117,6 +1418,7 @@ void *Mem_Alloc16( const size_t size ) {
 	void *mem = mem_heap->Allocate16( size );
 	// make sure the memory is 16 byte aligned
 	assert( ( ((intptr_t)mem) & 15) == 0 );
+	MEM_TRACE( mem, size );
 	return mem;
 }
 
@@ -1138,6 +1440,7 @@ void Mem_Free16( void *ptr ) {
 	}
 	// make sure the memory is 16 byte aligned
 	assert( ( ((intptr_t)ptr) & 15) == 0 );
+	MEM_TRACE( ptr, 0 );
  	mem_heap->Free16( ptr );
 }
 
@@ -1244,6 +1547,7 @@ typedef struct debugMemory_s {
 } debugMemory_t;
 
 static debugMemory_t *	mem_debugMemory = NULL;
+static idSysSpinLock	mem_debugMemoryLock;		// the heap is thread safe, the list of debug blocks isn't
 static char				mem_leakName[256] = "";
 
 /*
@@ -1590,14 +1894,18 @@ void *Mem_AllocDebugMemory( const int size, const char *fileName, const int line
 	m->lineNumber = lineNumber;
 	m->frameNumber = idLib::frameNumber;
 	m->size = size;
+	mem_debugMemoryLock.Lock();
 	m->next = mem_debugMemory;
 	m->prev = NULL;
 	if ( mem_debugMemory ) {
 		mem_debugMemory->prev = m;
 	}
 	mem_debugMemory = m;
+	mem_debugMemoryLock.Unlock();
 	idLib::sys->GetCallStack( m->callStack, MAX_CALLSTACK_DEPTH );
 
+	MEM_TRACE( m, size );
+
 	return ( ( (byte *) p ) + sizeof( debugMemory_t ) );
 }
 
@@ -1629,7 +1937,9 @@ void Mem_FreeDebugMemory( void *p, const char *fileName, const int lineNumber, c
 	}
 
 	Mem_UpdateFreeStats( m->size );
+	MEM_TRACE( m, 0 );
 
+	mem_debugMemoryLock.Lock();
 	if ( m->next ) {
 		m->next->prev = m->prev;
 	}
@@ -1639,6 +1949,7 @@ void Mem_FreeDebugMemory( void *p, const char *fileName, const int lineNumber, c
 	else {
 		mem_debugMemory = m->next;
 	}
+	mem_debugMemoryLock.Unlock();
 
 	m->fileName = fileName;
 	m->lineNumber = lineNumber;
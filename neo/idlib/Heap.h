@@ -35,8 +35,9 @@ If you have questions concerning this license or the applicable additional terms
 	Memory Management
 
 	This is a replacement for the compiler heap code (i.e. "C" malloc() and
-	free() calls). On average 2.5-3.0 times faster than MSVC malloc()/free().
-	Worst case performance is 1.65 times faster and best case > 70 times.
+	free() calls). Small allocations are served from per-thread caches of
+	size class spans, so allocating from multiple threads doesn't contend
+	on a lock. Use memoryTrace and testHeap to compare against malloc().
  
 ===============================================================================
 */
@@ -58,6 +59,8 @@ void		Mem_GetFrameStats( memoryStats_t &allocs, memoryStats_t &frees );
 void		Mem_GetStats( memoryStats_t &stats );
 void		Mem_Dump_f( const class idCmdArgs &args );
 void		Mem_DumpCompressed_f( const class idCmdArgs &args );
+void		Mem_Trace_f( const class idCmdArgs &args );
+void		Mem_TestHeap_f( const class idCmdArgs &args );
 void		Mem_AllocDefragBlock( void );
 
 
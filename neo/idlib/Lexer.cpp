@@ -242,6 +242,8 @@ void idLexer::Warning( const char *str, ... ) {
 	char text[MAX_STRING_CHARS];
 	va_list ap;
 
+	hadWarning = true;
+
 	if ( idLexer::flags & LEXFL_NOWARNINGS ) {
 		return;
 	}
@@ -1713,6 +1715,7 @@ idLexer::idLexer( void ) {
 	idLexer::token = "";
 	idLexer::next = NULL;
 	idLexer::hadError = false;
+	idLexer::hadWarning = false;
 }
 
 /*
@@ -1734,6 +1737,7 @@ idLexer::idLexer( int flags ) {
 	idLexer::token = "";
 	idLexer::next = NULL;
 	idLexer::hadError = false;
+	idLexer::hadWarning = false;
 }
 
 /*
@@ -1749,6 +1753,7 @@ idLexer::idLexer( const char *filename, int flags, bool OSPath ) {
 	idLexer::token = "";
 	idLexer::next = NULL;
 	idLexer::hadError = false;
+	idLexer::hadWarning = false;
 	idLexer::LoadFile( filename, OSPath );
 }
 
@@ -1765,6 +1770,7 @@ idLexer::idLexer( const char *ptr, int length, const char *name, int flags ) {
 	idLexer::token = "";
 	idLexer::next = NULL;
 	idLexer::hadError = false;
+	idLexer::hadWarning = false;
 	idLexer::LoadMemory( ptr, length, name );
 }
 
@@ -1795,3 +1801,12 @@ bool idLexer::HadError( void ) const {
 	return hadError;
 }
 
+/*
+================
+idLexer::HadWarning
+================
+*/
+bool idLexer::HadWarning( void ) const {
+	return hadWarning;
+}
+
@@ -237,6 +237,8 @@ public:
 	void			Warning( const char *str, ... ) id_attribute((format(printf,2,3)));
 					// returns true if Error() was called with LEXFL_NOFATALERRORS or LEXFL_NOERRORS set
 	bool			HadError( void ) const;
+					// returns true if Warning() was called, even if LEXFL_NOWARNINGS is set
+	bool			HadWarning( void ) const;
 
 					// set the base folder to load files from
 	static void		SetBaseFolder( const char *path );
@@ -263,6 +265,7 @@ private:
 	idToken			token;					// available token
 	idLexer *		next;					// next script in a chain
 	bool			hadError;				// set by idLexer::Error, even if the error is supressed
+	bool			hadWarning;				// set by idLexer::Warning, even if the warning is supressed
 
 	static char		baseFolder[ 256 ];		// base folder to load files from
 
@@ -35,6 +35,7 @@ If you have questions concerning this license or the applicable additional terms
 
 #ifdef USE_STRING_DATA_ALLOCATOR
 static idDynamicBlockAlloc<char, 1<<18, 128>	stringDataAllocator;
+static idSysSpinLock							stringDataLock;		// strings are also built on the job workers
 #endif
 
 idVec4	g_color_table[16] =
@@ -95,7 +96,9 @@ void idStr::ReAllocate( int amount, bool keepold ) {
 	alloced = newsize;
 
 #ifdef USE_STRING_DATA_ALLOCATOR
+	stringDataLock.Lock();
 	newbuffer = stringDataAllocator.Alloc( alloced );
+	stringDataLock.Unlock();
 #else
 	newbuffer = new char[ alloced ];
 #endif
@@ -106,7 +109,9 @@ void idStr::ReAllocate( int amount, bool keepold ) {
 
 	if ( data && data != baseBuffer ) {
 #ifdef USE_STRING_DATA_ALLOCATOR
+		stringDataLock.Lock();
 		stringDataAllocator.Free( data );
+		stringDataLock.Unlock();
 #else
 		delete [] data;
 #endif
@@ -123,7 +128,9 @@ idStr::FreeData
 void idStr::FreeData( void ) {
 	if ( data && data != baseBuffer ) {
 #ifdef USE_STRING_DATA_ALLOCATOR
+		stringDataLock.Lock();
 		stringDataAllocator.Free( data );
+		stringDataLock.Unlock();
 #else
 		delete[] data;
 #endif
@@ -1642,7 +1649,9 @@ idStr::PurgeMemory
 */
 void idStr::PurgeMemory( void ) {
 #ifdef USE_STRING_DATA_ALLOCATOR
+	stringDataLock.Lock();
 	stringDataAllocator.FreeEmptyBaseBlocks();
+	stringDataLock.Unlock();
 #endif
 }
 
@@ -35,6 +35,7 @@ If you have questions concerning this license or the applicable additional terms
 #include "Simd_SSE.h"
 #include "Simd_SSE2.h"
 #include "Simd_SSE3.h"
+#include "Simd_AVX2.h"
 #include "Simd_AltiVec.h"
 
 
@@ -75,6 +76,8 @@ void idSIMD::InitProcessor( const char *module, bool forceGeneric ) {
 		if ( !processor ) {
 			if ( ( cpuid & CPUID_ALTIVEC ) ) {
 				processor = new idSIMD_AltiVec;
+			} else if ( ( cpuid & CPUID_MMX ) && ( cpuid & CPUID_SSE ) && ( cpuid & CPUID_SSE2 ) && ( cpuid & CPUID_SSE3 ) && ( cpuid & CPUID_AVX2 ) && ( cpuid & CPUID_FMA ) ) {
+				processor = new idSIMD_AVX2;
 			} else if ( ( cpuid & CPUID_MMX ) && ( cpuid & CPUID_SSE ) && ( cpuid & CPUID_SSE2 ) && ( cpuid & CPUID_SSE3 ) ) {
 				processor = new idSIMD_SSE3;
 			} else if ( ( cpuid & CPUID_MMX ) && ( cpuid & CPUID_SSE ) && ( cpuid & CPUID_SSE2 ) ) {
@@ -289,6 +292,27 @@ TIME_TYPE time_in_millisec( void ) {
 #define StopRecordTime( end )				\
 	end = mach_absolute_time();
 #endif
+#elif defined(_M_X64) || ( defined(__GNUC__) && ( defined(__i386__) || defined(__x86_64__) ) )
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+#define TIME_TYPE int
+
+// no inline assembly on x64, the intrinsics serialize the same way the cpuid above does
+#define StartRecordTime( start )			\
+	_mm_lfence();							\
+	start = (int)__rdtsc();					\
+	_mm_lfence();
+
+#define StopRecordTime( end )				\
+	_mm_lfence();							\
+	end = (int)__rdtsc();					\
+	_mm_lfence();
+
 #else
 
 #define TIME_TYPE int
@@ -323,7 +347,11 @@ void PrintClocks( char *string, int dataCount, int clocks, int otherClocks = 0 )
 	if ( otherClocks && clocks ) {
 		otherClocks -= baseClocks;
 		int p = (int) ( (float) ( otherClocks - clocks ) * 100.0f / (float) otherClocks );
-		idLib::common->Printf( "c = %4d, clcks = %5d, %d%%\n", dataCount, clocks, p );
+		if ( clocks > 0 ) {
+			idLib::common->Printf( "c = %4d, clcks = %5d, %d%%, %.2fx\n", dataCount, clocks, p, (float) otherClocks / (float) clocks );
+		} else {
+			idLib::common->Printf( "c = %4d, clcks = %5d, %d%%\n", dataCount, clocks, p );
+		}
 	} else {
 		idLib::common->Printf( "c = %4d, clcks = %5d\n", dataCount, clocks );
 	}
@@ -3454,6 +3482,8 @@ void TestSoundMixing( void ) {
 	ALIGN16( short outSamples2[MIXBUFFER_SAMPLES*6] );
 	float lastV[6];
 	float currentV[6];
+	float batchLastV[6*6];
+	float batchCurrentV[6*6];
 	const char *result;
 
 	idRandom srnd( RANDOM_SEED );
@@ -3597,6 +3627,43 @@ void TestSoundMixing( void ) {
 	result = ( i >= MIXBUFFER_SAMPLES*6 ) ? "ok" : S_COLOR_RED "X";
 	PrintClocks( va( "   simd->MixSoundSixSpeakerStereo() %s", result ), MIXBUFFER_SAMPLES, bestClocksSIMD, bestClocksGeneric );
 
+	for ( i = 0; i < 6*6; i++ ) {
+		batchLastV[i] = srnd.CRandomFloat();
+		batchCurrentV[i] = srnd.CRandomFloat();
+	}
+
+	bestClocksGeneric = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		for ( j = 0; j < MIXBUFFER_SAMPLES*6; j++ ) {
+			mixBuffer1[j] = origMixBuffer[j];
+		}
+		StartRecordTime( start );
+		p_generic->MixSoundBatch( mixBuffer1, samples, MIXBUFFER_SAMPLES, 6, batchLastV, batchCurrentV, 6, 6 );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksGeneric );
+	}
+	PrintClocks( "generic->MixSoundBatch()", MIXBUFFER_SAMPLES, bestClocksGeneric );
+
+
+	bestClocksSIMD = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		for ( j = 0; j < MIXBUFFER_SAMPLES*6; j++ ) {
+			mixBuffer2[j] = origMixBuffer[j];
+		}
+		StartRecordTime( start );
+		p_simd->MixSoundBatch( mixBuffer2, samples, MIXBUFFER_SAMPLES, 6, batchLastV, batchCurrentV, 6, 6 );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksSIMD );
+	}
+
+	for ( i = 0; i < MIXBUFFER_SAMPLES*6; i++ ) {
+		if ( idMath::Fabs( mixBuffer1[i] - mixBuffer2[i] ) > SOUND_MIX_EPSILON ) {
+			break;
+		}
+	}
+	result = ( i >= MIXBUFFER_SAMPLES*6 ) ? "ok" : S_COLOR_RED "X";
+	PrintClocks( va( "   simd->MixSoundBatch() %s", result ), MIXBUFFER_SAMPLES, bestClocksSIMD, bestClocksGeneric );
+
 
 	for ( i = 0; i < MIXBUFFER_SAMPLES*6; i++ ) {
 		origMixBuffer[i] = srnd.RandomInt( (1<<17) ) - (1<<16);
@@ -4144,6 +4211,12 @@ void idSIMD::Test_f( const idCmdArgs &args ) {
 				return;
 			}
 			p_simd = new idSIMD_SSE3();
+		} else if ( idStr::Icmp( argString, "AVX2" ) == 0 ) {
+			if ( !( cpuid & CPUID_MMX ) || !( cpuid & CPUID_SSE ) || !( cpuid & CPUID_SSE2 ) || !( cpuid & CPUID_SSE3 ) || !( cpuid & CPUID_AVX2 ) || !( cpuid & CPUID_FMA ) ) {
+				common->Printf( "CPU does not support MMX & SSE & SSE2 & SSE3 & AVX2 & FMA\n" );
+				return;
+			}
+			p_simd = new idSIMD_AVX2();
 		} else if ( idStr::Icmp( argString, "AltiVec" ) == 0 ) {
 			if ( !( cpuid & CPUID_ALTIVEC ) ) {
 				common->Printf( "CPU does not support AltiVec\n" );
@@ -4151,7 +4224,7 @@ void idSIMD::Test_f( const idCmdArgs &args ) {
 			}
 			p_simd = new idSIMD_AltiVec();
 		} else {
-			common->Printf( "invalid argument, use: MMX, 3DNow, SSE, SSE2, SSE3, AltiVec\n" );
+			common->Printf( "invalid argument, use: MMX, 3DNow, SSE, SSE2, SSE3, AVX2, AltiVec\n" );
 			return;
 		}
 	}
@@ -0,0 +1,906 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company. 
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).  
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#include "../precompiled.h"
+#pragma hdrstop
+
+#include "Simd_Generic.h"
+#include "Simd_MMX.h"
+#include "Simd_SSE.h"
+#include "Simd_SSE2.h"
+#include "Simd_SSE3.h"
+#include "Simd_AVX2.h"
+
+
+//===============================================================
+//
+//	AVX2 & FMA implementation of idSIMDProcessor
+//
+//===============================================================
+
+#ifdef ID_SIMD_AVX2
+
+#include <immintrin.h>
+
+// the rest of the engine is not compiled for AVX, so with gcc each kernel
+// enables the instruction sets it uses. Kernels that have to give the same
+// results as the generic code are kept out of the FMA target, so the compiler
+// can't contract their multiplies and adds.
+#if defined(__GNUC__)
+#define AVX2_TARGET					__attribute__(( target( "avx2" ) ))
+#define AVX2_FMA_TARGET				__attribute__(( target( "avx2,fma" ) ))
+#else
+#define AVX2_TARGET
+#define AVX2_FMA_TARGET
+#endif
+
+// float strides for the gathers
+#define DRAWVERT_FLOATS				( (int)( sizeof( idDrawVert ) / sizeof( float ) ) )
+#define DRAWVERT_ST_FLOAT			3
+#define JOINTQUAT_FLOATS			( (int)( sizeof( idJointQuat ) / sizeof( float ) ) )
+#define JOINTQUAT_COMPONENTS		7		// quaternion followed by the translation
+
+/*
+============
+idSIMD_AVX2::GetName
+============
+*/
+const char * idSIMD_AVX2::GetName( void ) const {
+	return "MMX & SSE & SSE2 & SSE3 & AVX2 & FMA";
+}
+
+/*
+============
+AVX2_StrideIndexes
+
+  eight consecutive elements of an array with the given float stride
+============
+*/
+AVX2_TARGET static ID_INLINE __m256i AVX2_StrideIndexes( const int stride ) {
+	return _mm256_mullo_epi32( _mm256_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7 ), _mm256_set1_epi32( stride ) );
+}
+
+/*
+============
+AVX2_Dot3
+
+  dst[i] = c0 * src[i][0] + c1 * src[i][1] + c2 * src[i][2] for an array with the given float stride,
+  the products are summed in the same order as the generic code
+============
+*/
+AVX2_TARGET static void AVX2_Dot3( float *dst, const float c0, const float c1, const float c2, const float *src, const int stride, const int count ) {
+	const __m256i offsets = AVX2_StrideIndexes( stride );
+	const __m256 x = _mm256_set1_ps( c0 );
+	const __m256 y = _mm256_set1_ps( c1 );
+	const __m256 z = _mm256_set1_ps( c2 );
+	int i;
+
+	for ( i = 0; i + 8 <= count; i += 8 ) {
+		const float *s = src + i * stride;
+		__m256 d = _mm256_add_ps( _mm256_mul_ps( x, _mm256_i32gather_ps( s + 0, offsets, 4 ) ),
+									_mm256_mul_ps( y, _mm256_i32gather_ps( s + 1, offsets, 4 ) ) );
+		d = _mm256_add_ps( d, _mm256_mul_ps( z, _mm256_i32gather_ps( s + 2, offsets, 4 ) ) );
+		_mm256_storeu_ps( dst + i, d );
+	}
+	for ( ; i < count; i++ ) {
+		const float *s = src + i * stride;
+		dst[i] = c0 * s[0] + c1 * s[1] + c2 * s[2];
+	}
+	_mm256_zeroupper();
+}
+
+/*
+============
+AVX2_Dot3Add
+
+  dst[i] = c0 * src[i][0] + c1 * src[i][1] + c2 * src[i][2] + c3 * src[i][3], or + c3 when addConstant is set
+============
+*/
+AVX2_TARGET static void AVX2_Dot3Add( float *dst, const float c0, const float c1, const float c2, const float c3, const bool addConstant, const float *src, const int stride, const int count ) {
+	const __m256i offsets = AVX2_StrideIndexes( stride );
+	const __m256 x = _mm256_set1_ps( c0 );
+	const __m256 y = _mm256_set1_ps( c1 );
+	const __m256 z = _mm256_set1_ps( c2 );
+	const __m256 w = _mm256_set1_ps( c3 );
+	int i;
+
+	for ( i = 0; i + 8 <= count; i += 8 ) {
+		const float *s = src + i * stride;
+		__m256 d = _mm256_add_ps( _mm256_mul_ps( x, _mm256_i32gather_ps( s + 0, offsets, 4 ) ),
+									_mm256_mul_ps( y, _mm256_i32gather_ps( s + 1, offsets, 4 ) ) );
+		d = _mm256_add_ps( d, _mm256_mul_ps( z, _mm256_i32gather_ps( s + 2, offsets, 4 ) ) );
+		if ( addConstant ) {
+			d = _mm256_add_ps( d, w );
+		} else {
+			d = _mm256_add_ps( d, _mm256_mul_ps( w, _mm256_i32gather_ps( s + 3, offsets, 4 ) ) );
+		}
+		_mm256_storeu_ps( dst + i, d );
+	}
+	for ( ; i < count; i++ ) {
+		const float *s = src + i * stride;
+		if ( addConstant ) {
+			dst[i] = c0 * s[0] + c1 * s[1] + c2 * s[2] + c3;
+		} else {
+			dst[i] = c0 * s[0] + c1 * s[1] + c2 * s[2] + c3 * s[3];
+		}
+	}
+	_mm256_zeroupper();
+}
+
+/*
+============
+idSIMD_AVX2::Dot
+
+  dst[i] = constant * src[i];
+============
+*/
+AVX2_TARGET void VPCALL idSIMD_AVX2::Dot( float *dst, const idVec3 &constant, const idVec3 *src, const int count ) {
+	AVX2_Dot3( dst, constant[0], constant[1], constant[2], src->ToFloatPtr(), 3, count );
+}
+
+/*
+============
+idSIMD_AVX2::Dot
+
+  dst[i] = constant * src[i].Normal() + src[i][3];
+============
+*/
+AVX2_TARGET void VPCALL idSIMD_AVX2::Dot( float *dst, const idVec3 &constant, const idPlane *src, const int count ) {
+	const __m256i offsets = AVX2_StrideIndexes( 4 );
+	const __m256 x = _mm256_set1_ps( constant[0] );
+	const __m256 y = _mm256_set1_ps( constant[1] );
+	const __m256 z = _mm256_set1_ps( constant[2] );
+	const float *s = src->ToFloatPtr();
+	int i;
+
+	for ( i = 0; i + 8 <= count; i += 8 ) {
+		const float *p = s + i * 4;
+		__m256 d = _mm256_add_ps( _mm256_mul_ps( x, _mm256_i32gather_ps( p + 0, offsets, 4 ) ),
+									_mm256_mul_ps( y, _mm256_i32gather_ps( p + 1, offsets, 4 ) ) );
+		d = _mm256_add_ps( d, _mm256_mul_ps( z, _mm256_i32gather_ps( p + 2, offsets, 4 ) ) );
+		d = _mm256_add_ps( d, _mm256_i32gather_ps( p + 3, offsets, 4 ) );
+		_mm256_storeu_ps( dst + i, d );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] = constant * src[i].Normal() + src[i][3];
+	}
+	_mm256_zeroupper();
+}
+
+/*
+============
+idSIMD_AVX2::Dot
+
+  dst[i] = constant * src[i].xyz;
+============
+*/
+AVX2_TARGET void VPCALL idSIMD_AVX2::Dot( float *dst, const idVec3 &constant, const idDrawVert *src, const int count ) {
+	AVX2_Dot3( dst, constant[0], constant[1], constant[2], src->xyz.ToFloatPtr(), DRAWVERT_FLOATS, count );
+}
+
+/*
+============
+idSIMD_AVX2::Dot
+
+  dst[i] = constant.Normal() * src[i] + constant[3];
+============
+*/
+AVX2_TARGET void VPCALL idSIMD_AVX2::Dot( float *dst, const idPlane &constant, const idVec3 *src, const int count ) {
+	AVX2_Dot3Add( dst, constant[0], constant[1], constant[2], constant[3], true, src->ToFloatPtr(), 3, count );
+}
+
+/*
+============
+idSIMD_AVX2::Dot
+
+  dst[i] = constant.Normal() * src[i].Normal() + constant[3] * src[i][3];
+============
+*/
+AVX2_TARGET void VPCALL idSIMD_AVX2::Dot( float *dst, const idPlane &constant, const idPlane *src, const int count ) {
+	AVX2_Dot3Add( dst, constant[0], constant[1], constant[2], constant[3], false, src->ToFloatPtr(), 4, count );
+}
+
+/*
+============
+idSIMD_AVX2::Dot
+
+  dst[i] = constant.Normal() * src[i].xyz + constant[3];
+============
+*/
+AVX2_TARGET void VPCALL idSIMD_AVX2::Dot( float *dst, const idPlane &constant, const idDrawVert *src, const int count ) {
+	AVX2_Dot3Add( dst, constant[0], constant[1], constant[2], constant[3], true, src->xyz.ToFloatPtr(), DRAWVERT_FLOATS, count );
+}
+
+/*
+============
+idSIMD_AVX2::Dot
+
+  dst[i] = src0[i] * src1[i];
+============
+*/
+AVX2_TARGET void VPCALL idSIMD_AVX2::Dot( float *dst, const idVec3 *src0, const idVec3 *src1, const int count ) {
+	const __m256i offsets = AVX2_StrideIndexes( 3 );
+	const float *s0 = src0->ToFloatPtr();
+	const float *s1 = src1->ToFloatPtr();
+	int i;
+
+	for ( i = 0; i + 8 <= count; i += 8 ) {
+		const float *a = s0 + i * 3;
+		const float *b = s1 + i * 3;
+		__m256 d = _mm256_add_ps( _mm256_mul_ps( _mm256_i32gather_ps( a + 0, offsets, 4 ), _mm256_i32gather_ps( b + 0, offsets, 4 ) ),
+									_mm256_mul_ps( _mm256_i32gather_ps( a + 1, offsets, 4 ), _mm256_i32gather_ps( b + 1, offsets, 4 ) ) );
+		d = _mm256_add_ps( d, _mm256_mul_ps( _mm256_i32gather_ps( a + 2, offsets, 4 ), _mm256_i32gather_ps( b + 2, offsets, 4 ) ) );
+		_mm256_storeu_ps( dst + i, d );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] = src0[i] * src1[i];
+	}
+	_mm256_zeroupper();
+}
+
+/*
+============
+idSIMD_AVX2::Dot
+
+  dot = src1[0] * src2[0] + src1[1] * src2[1] + src1[2] * src2[2] + ...
+
+  Like the generic code the products are rounded to float and summed in double precision.
+============
+*/
+AVX2_TARGET void VPCALL idSIMD_AVX2::Dot( float &dot, const float *src1, const float *src2, const int count ) {
+	__m256d s0 = _mm256_setzero_pd();
+	__m256d s1 = _mm256_setzero_pd();
+	int i;
+
+	for ( i = 0; i + 8 <= count; i += 8 ) {
+		__m256 p = _mm256_mul_ps( _mm256_loadu_ps( src1 + i ), _mm256_loadu_ps( src2 + i ) );
+		s0 = _mm256_add_pd( s0, _mm256_cvtps_pd( _mm256_castps256_ps128( p ) ) );
+		s1 = _mm256_add_pd( s1, _mm256_cvtps_pd( _mm256_extractf128_ps( p, 1 ) ) );
+	}
+	s0 = _mm256_add_pd( s0, s1 );
+	__m128d s = _mm_add_pd( _mm256_castpd256_pd128( s0 ), _mm256_extractf128_pd( s0, 1 ) );
+	s = _mm_add_sd( s, _mm_unpackhi_pd( s, s ) );
+	double sum = _mm_cvtsd_f64( s );
+	for ( ; i < count; i++ ) {
+		float p = src1[i] * src2[i];
+		sum += p;
+	}
+	dot = (float) sum;
+	_mm256_zeroupper();
+}
+
+/*
+============
+idSIMD_AVX2::MinMax
+
+  new values are always the first operand of min/max so NaNs are skipped like in the generic code
+============
+*/
+AVX2_TARGET void VPCALL idSIMD_AVX2::MinMax( float &min, float &max, const float *src, const int count ) {
+	__m256 vmin = _mm256_set1_ps( idMath::INFINITY );
+	__m256 vmax = _mm256_set1_ps( -idMath::INFINITY );
+	int i;
+
+	for ( i = 0; i + 8 <= count; i += 8 ) {
+		__m256 v = _mm256_loadu_ps( src + i );
+		vmin = _mm256_min_ps( v, vmin );
+		vmax = _mm256_max_ps( v, vmax );
+	}
+	__m128 mn = _mm_min_ps( _mm256_castps256_ps128( vmin ), _mm256_extractf128_ps( vmin, 1 ) );
+	__m128 mx = _mm_max_ps( _mm256_castps256_ps128( vmax ), _mm256_extractf128_ps( vmax, 1 ) );
+	mn = _mm_min_ps( mn, _mm_movehl_ps( mn, mn ) );
+	mx = _mm_max_ps( mx, _mm_movehl_ps( mx, mx ) );
+	mn = _mm_min_ss( mn, _mm_shuffle_ps( mn, mn, _MM_SHUFFLE( 1, 1, 1, 1 ) ) );
+	mx = _mm_max_ss( mx, _mm_shuffle_ps( mx, mx, _MM_SHUFFLE( 1, 1, 1, 1 ) ) );
+	min = _mm_cvtss_f32( mn );
+	max = _mm_cvtss_f32( mx );
+	for ( ; i < count; i++ ) {
+		if ( src[i] < min ) {
+			min = src[i];
+		}
+		if ( src[i] > max ) {
+			max = src[i];
+		}
+	}
+	_mm256_zeroupper();
+}
+
+/*
+============
+idSIMD_AVX2::MinMax
+============
+*/
+AVX2_TARGET void VPCALL idSIMD_AVX2::MinMax( idVec2 &min, idVec2 &max, const idVec2 *src, const int count ) {
+	const float *s = src->ToFloatPtr();
+	__m256 vmin = _mm256_set1_ps( idMath::INFINITY );
+	__m256 vmax = _mm256_set1_ps( -idMath::INFINITY );
+	int i;
+
+	// four vectors at a time, the even lanes hold x and the odd lanes y
+	for ( i = 0; i + 4 <= count; i += 4 ) {
+		__m256 v = _mm256_loadu_ps( s + i * 2 );
+		vmin = _mm256_min_ps( v, vmin );
+		vmax = _mm256_max_ps( v, vmax );
+	}
+	__m128 mn = _mm_min_ps( _mm256_castps256_ps128( vmin ), _mm256_extractf128_ps( vmin, 1 ) );
+	__m128 mx = _mm_max_ps( _mm256_castps256_ps128( vmax ), _mm256_extractf128_ps( vmax, 1 ) );
+	mn = _mm_min_ps( mn, _mm_movehl_ps( mn, mn ) );
+	mx = _mm_max_ps( mx, _mm_movehl_ps( mx, mx ) );
+	min[0] = _mm_cvtss_f32( mn );
+	max[0] = _mm_cvtss_f32( mx );
+	min[1] = _mm_cvtss_f32( _mm_shuffle_ps( mn, mn, _MM_SHUFFLE( 1, 1, 1, 1 ) ) );
+	max[1] = _mm_cvtss_f32( _mm_shuffle_ps( mx, mx, _MM_SHUFFLE( 1, 1, 1, 1 ) ) );
+	for ( ; i < count; i++ ) {
+		const idVec2 &v = src[i];
+		if ( v[0] < min[0] ) {
+			min[0] = v[0];
+		}
+		if ( v[0] > max[0] ) {
+			max[0] = v[0];
+		}
+		if ( v[1] < min[1] ) {
+			min[1] = v[1];
+		}
+		if ( v[1] > max[1] ) {
+			max[1] = v[1];
+		}
+	}
+	_mm256_zeroupper();
+}
+
+/*
+============
+AVX2_StoreMinMax
+============
+*/
+AVX2_TARGET static ID_INLINE void AVX2_StoreMinMax( idVec3 &min, idVec3 &max, const __m128 mn, const __m128 mx ) {
+	ALIGN16( float fmin[4] );
+	ALIGN16( float fmax[4] );
+
+	_mm_store_ps( fmin, mn );
+	_mm_store_ps( fmax, mx );
+	min.Set( fmin[0], fmin[1], fmin[2] );
+	max.Set( fmax[0], fmax[1], fmax[2] );
+}
+
+/*
+============
+idSIMD_AVX2::MinMax
+============
+*/
+AVX2_TARGET void VPCALL idSIMD_AVX2::MinMax( idVec3 &min, idVec3 &max, const idVec3 *src, const int count ) {
+	__m128 mn = _mm_set1_ps( idMath::INFINITY );
+	__m128 mx = _mm_set1_ps( -idMath::INFINITY );
+	int i;
+
+	// the four float loads read one float past each vector, so the last one is loaded separately
+	for ( i = 0; i < count - 1; i++ ) {
+		__m128 v = _mm_loadu_ps( src[i].ToFloatPtr() );
+		mn = _mm_min_ps( v, mn );
+		mx = _mm_max_ps( v, mx );
+	}
+	if ( i < count ) {
+		__m128 v = _mm_setr_ps( src[i][0], src[i][1], src[i][2], 0.0f );
+		mn = _mm_min_ps( v, mn );
+		mx = _mm_max_ps( v, mx );
+	}
+	AVX2_StoreMinMax( min, max, mn, mx );
+}
+
+/*
+============
+idSIMD_AVX2::MinMax
+============
+*/
+AVX2_TARGET void VPCALL idSIMD_AVX2::MinMax( idVec3 &min, idVec3 &max, const idDrawVert *src, const int count ) {
+	__m128 mn = _mm_set1_ps( idMath::INFINITY );
+	__m128 mx = _mm_set1_ps( -idMath::INFINITY );
+
+	// the fourth float is st[0] which is ignored
+	for ( int i = 0; i < count; i++ ) {
+		__m128 v = _mm_loadu_ps( src[i].xyz.ToFloatPtr() );
+		mn = _mm_min_ps( v, mn );
+		mx = _mm_max_ps( v, mx );
+	}
+	AVX2_StoreMinMax( min, max, mn, mx );
+}
+
+/*
+============
+idSIMD_AVX2::MinMax
+============
+*/
+AVX2_TARGET void VPCALL idSIMD_AVX2::MinMax( idVec3 &min, idVec3 &max, const idDrawVert *src, const int *indexes, const int count ) {
+	__m128 mn = _mm_set1_ps( idMath::INFINITY );
+	__m128 mx = _mm_set1_ps( -idMath::INFINITY );
+
+	for ( int i = 0; i < count; i++ ) {
+		__m128 v = _mm_loadu_ps( src[indexes[i]].xyz.ToFloatPtr() );
+		mn = _mm_min_ps( v, mn );
+		mx = _mm_max_ps( v, mx );
+	}
+	AVX2_StoreMinMax( min, max, mn, mx );
+}
+
+/*
+============
+AVX2_Sin16
+
+  idMath::Sin16 for angles in the range [0, PI/2]
+============
+*/
+AVX2_FMA_TARGET static ID_INLINE __m256 AVX2_Sin16( const __m256 a ) {
+	const __m256 s = _mm256_mul_ps( a, a );
+	__m256 r = _mm256_fmadd_ps( _mm256_set1_ps( -2.39e-08f ), s, _mm256_set1_ps( 2.7526e-06f ) );
+	r = _mm256_fmadd_ps( r, s, _mm256_set1_ps( -1.98409e-04f ) );
+	r = _mm256_fmadd_ps( r, s, _mm256_set1_ps( 8.3333315e-03f ) );
+	r = _mm256_fmadd_ps( r, s, _mm256_set1_ps( -1.666666664e-01f ) );
+	r = _mm256_fmadd_ps( r, s, _mm256_set1_ps( 1.0f ) );
+	return _mm256_mul_ps( a, r );
+}
+
+/*
+============
+AVX2_ATan16
+
+  idMath::ATan16 for y >= 0 and x >= 0
+============
+*/
+AVX2_FMA_TARGET static ID_INLINE __m256 AVX2_ATan16( const __m256 y, const __m256 x ) {
+	const __m256 swap = _mm256_cmp_ps( y, x, _CMP_GT_OQ );
+	const __m256 a = _mm256_div_ps( _mm256_min_ps( x, y ), _mm256_max_ps( x, y ) );
+	const __m256 s = _mm256_mul_ps( a, a );
+	__m256 r = _mm256_fmadd_ps( _mm256_set1_ps( 0.0028662257f ), s, _mm256_set1_ps( -0.0161657367f ) );
+	r = _mm256_fmadd_ps( r, s, _mm256_set1_ps( 0.0429096138f ) );
+	r = _mm256_fmadd_ps( r, s, _mm256_set1_ps( -0.0752896400f ) );
+	r = _mm256_fmadd_ps( r, s, _mm256_set1_ps( 0.1065626393f ) );
+	r = _mm256_fmadd_ps( r, s, _mm256_set1_ps( -0.1420889944f ) );
+	r = _mm256_fmadd_ps( r, s, _mm256_set1_ps( 0.1999355085f ) );
+	r = _mm256_fmadd_ps( r, s, _mm256_set1_ps( -0.3333314528f ) );
+	r = _mm256_fmadd_ps( r, s, _mm256_set1_ps( 1.0f ) );
+	r = _mm256_mul_ps( r, a );
+	return _mm256_blendv_ps( r, _mm256_sub_ps( _mm256_set1_ps( idMath::HALF_PI ), r ), swap );
+}
+
+/*
+============
+AVX2_RSqrt
+
+  reciprocal square root with one Newton-Raphson step, zero maps to a huge number instead of infinity
+============
+*/
+AVX2_FMA_TARGET static ID_INLINE __m256 AVX2_RSqrt( const __m256 x ) {
+	const __m256 c = _mm256_max_ps( x, _mm256_set1_ps( 1e-30f ) );
+	const __m256 r = _mm256_rsqrt_ps( c );
+	const __m256 h = _mm256_mul_ps( _mm256_mul_ps( c, _mm256_set1_ps( 0.5f ) ), r );
+	return _mm256_mul_ps( r, _mm256_fnmadd_ps( h, r, _mm256_set1_ps( 1.5f ) ) );
+}
+
+/*
+============
+idSIMD_AVX2::BlendJoints
+
+  slerps eight joints at a time with the same approximations idQuat::Slerp uses
+============
+*/
+AVX2_FMA_TARGET void VPCALL idSIMD_AVX2::BlendJoints( idJointQuat *joints, const idJointQuat *blendJoints, const float lerp, const int *index, const int numJoints ) {
+	int i, j, k;
+
+	if ( lerp <= 0.0f ) {
+		return;
+	} else if ( lerp >= 1.0f ) {
+		for ( i = 0; i < numJoints; i++ ) {
+			j = index[i];
+			joints[j] = blendJoints[j];
+		}
+		return;
+	}
+
+	const float *from = (const float *)joints;
+	const float *to = (const float *)blendJoints;
+	const __m256 t = _mm256_set1_ps( lerp );
+	const __m256 invT = _mm256_set1_ps( 1.0f - lerp );
+	const __m256 one = _mm256_set1_ps( 1.0f );
+	const __m256 signBit = _mm256_set1_ps( -0.0f );
+	const __m256 epsilon = _mm256_set1_ps( 1e-6f );
+	ALIGN16( int jointOffsets[8] );
+	ALIGN16( float result[JOINTQUAT_COMPONENTS][8] );
+
+	for ( i = 0; i < numJoints; i += 8 ) {
+		const int numLanes = Min( 8, numJoints - i );
+
+		// repeat the last joint in the unused lanes
+		for ( k = 0; k < 8; k++ ) {
+			jointOffsets[k] = index[i + Min( k, numLanes - 1 )] * JOINTQUAT_FLOATS;
+		}
+		const __m256i offsets = _mm256_loadu_si256( (const __m256i *)jointOffsets );
+
+		__m256 fx = _mm256_i32gather_ps( from + 0, offsets, 4 );
+		__m256 fy = _mm256_i32gather_ps( from + 1, offsets, 4 );
+		__m256 fz = _mm256_i32gather_ps( from + 2, offsets, 4 );
+		__m256 fw = _mm256_i32gather_ps( from + 3, offsets, 4 );
+		__m256 tx = _mm256_i32gather_ps( to + 0, offsets, 4 );
+		__m256 ty = _mm256_i32gather_ps( to + 1, offsets, 4 );
+		__m256 tz = _mm256_i32gather_ps( to + 2, offsets, 4 );
+		__m256 tw = _mm256_i32gather_ps( to + 3, offsets, 4 );
+
+		__m256 cosom = _mm256_fmadd_ps( fx, tx, _mm256_fmadd_ps( fy, ty, _mm256_fmadd_ps( fz, tz, _mm256_mul_ps( fw, tw ) ) ) );
+
+		// take the shortest path
+		const __m256 sign = _mm256_and_ps( cosom, signBit );
+		tx = _mm256_xor_ps( tx, sign );
+		ty = _mm256_xor_ps( ty, sign );
+		tz = _mm256_xor_ps( tz, sign );
+		tw = _mm256_xor_ps( tw, sign );
+		cosom = _mm256_xor_ps( cosom, sign );
+
+		__m256 scale0 = _mm256_fnmadd_ps( cosom, cosom, one );
+		const __m256 sinom = AVX2_RSqrt( scale0 );
+		const __m256 omega = AVX2_ATan16( _mm256_mul_ps( scale0, sinom ), cosom );
+		scale0 = _mm256_mul_ps( AVX2_Sin16( _mm256_mul_ps( invT, omega ) ), sinom );
+		__m256 scale1 = _mm256_mul_ps( AVX2_Sin16( _mm256_mul_ps( t, omega ) ), sinom );
+
+		// linear interpolation when the quaternions are very close
+		const __m256 slerp = _mm256_cmp_ps( _mm256_sub_ps( one, cosom ), epsilon, _CMP_GT_OQ );
+		scale0 = _mm256_blendv_ps( invT, scale0, slerp );
+		scale1 = _mm256_blendv_ps( t, scale1, slerp );
+
+		_mm256_storeu_ps( result[0], _mm256_fmadd_ps( scale0, fx, _mm256_mul_ps( scale1, tx ) ) );
+		_mm256_storeu_ps( result[1], _mm256_fmadd_ps( scale0, fy, _mm256_mul_ps( scale1, ty ) ) );
+		_mm256_storeu_ps( result[2], _mm256_fmadd_ps( scale0, fz, _mm256_mul_ps( scale1, tz ) ) );
+		_mm256_storeu_ps( result[3], _mm256_fmadd_ps( scale0, fw, _mm256_mul_ps( scale1, tw ) ) );
+
+		for ( k = 4; k < JOINTQUAT_COMPONENTS; k++ ) {
+			const __m256 f = _mm256_i32gather_ps( from + k, offsets, 4 );
+			const __m256 d = _mm256_sub_ps( _mm256_i32gather_ps( to + k, offsets, 4 ), f );
+			_mm256_storeu_ps( result[k], _mm256_fmadd_ps( t, d, f ) );
+		}
+
+		for ( k = 0; k < numLanes; k++ ) {
+			float *dst = (float *)&joints[index[i + k]];
+			for ( j = 0; j < JOINTQUAT_COMPONENTS; j++ ) {
+				dst[j] = result[j][k];
+			}
+		}
+	}
+	_mm256_zeroupper();
+}
+
+/*
+============
+idSIMD_AVX2::TransformJoints
+
+  the rows are multiplied and added in the same order as idJointMat::operator*=
+============
+*/
+AVX2_TARGET void VPCALL idSIMD_AVX2::TransformJoints( idJointMat *jointMats, const int *parents, const int firstJoint, const int lastJoint ) {
+	const __m128 translationMask = _mm_castsi128_ps( _mm_setr_epi32( 0, 0, 0, -1 ) );
+
+	for ( int i = firstJoint; i <= lastJoint; i++ ) {
+		assert( parents[i] < i );
+		float *m = jointMats[i].ToFloatPtr();
+		const float *a = jointMats[parents[i]].ToFloatPtr();
+
+		const __m128 m0 = _mm_loadu_ps( m + 0 );
+		const __m128 m1 = _mm_loadu_ps( m + 4 );
+		const __m128 m2 = _mm_loadu_ps( m + 8 );
+
+		for ( int r = 0; r < 3; r++ ) {
+			const float *ar = a + r * 4;
+			__m128 d = _mm_add_ps( _mm_mul_ps( m0, _mm_set1_ps( ar[0] ) ), _mm_mul_ps( m1, _mm_set1_ps( ar[1] ) ) );
+			d = _mm_add_ps( d, _mm_mul_ps( m2, _mm_set1_ps( ar[2] ) ) );
+			d = _mm_add_ps( d, _mm_and_ps( _mm_loadu_ps( ar ), translationMask ) );
+			_mm_storeu_ps( m + r * 4, d );
+		}
+	}
+}
+
+/*
+============
+idSIMD_AVX2::UntransformJoints
+
+  the rows are multiplied and added in the same order as idJointMat::operator/=
+============
+*/
+AVX2_TARGET void VPCALL idSIMD_AVX2::UntransformJoints( idJointMat *jointMats, const int *parents, const int firstJoint, const int lastJoint ) {
+	const __m128 translationMask = _mm_castsi128_ps( _mm_setr_epi32( 0, 0, 0, -1 ) );
+
+	for ( int i = lastJoint; i >= firstJoint; i-- ) {
+		assert( parents[i] < i );
+		float *m = jointMats[i].ToFloatPtr();
+		const float *a = jointMats[parents[i]].ToFloatPtr();
+
+		const __m128 a0 = _mm_loadu_ps( a + 0 );
+		const __m128 a1 = _mm_loadu_ps( a + 4 );
+		const __m128 a2 = _mm_loadu_ps( a + 8 );
+		const __m128 m0 = _mm_sub_ps( _mm_loadu_ps( m + 0 ), _mm_and_ps( a0, translationMask ) );
+		const __m128 m1 = _mm_sub_ps( _mm_loadu_ps( m + 4 ), _mm_and_ps( a1, translationMask ) );
+		const __m128 m2 = _mm_sub_ps( _mm_loadu_ps( m + 8 ), _mm_and_ps( a2, translationMask ) );
+
+		for ( int r = 0; r < 3; r++ ) {
+			__m128 d = _mm_add_ps( _mm_mul_ps( m0, _mm_set1_ps( a[0 * 4 + r] ) ), _mm_mul_ps( m1, _mm_set1_ps( a[1 * 4 + r] ) ) );
+			d = _mm_add_ps( d, _mm_mul_ps( m2, _mm_set1_ps( a[2 * 4 + r] ) ) );
+			_mm_storeu_ps( m + r * 4, d );
+		}
+	}
+}
+
+/*
+============
+idSIMD_AVX2::TransformVerts
+
+  the first two rows of a joint matrix are weighted in one 256 bit register, the third in a 128 bit one
+============
+*/
+AVX2_FMA_TARGET void VPCALL idSIMD_AVX2::TransformVerts( idDrawVert *verts, const int numVerts, const idJointMat *joints, const idVec4 *weights, const int *index, const int /*numWeights*/ ) {
+	const byte *jointsPtr = (const byte *)joints;
+	int i, j;
+
+	for ( j = i = 0; i < numVerts; i++ ) {
+		__m256 acc01 = _mm256_setzero_ps();
+		__m128 acc2 = _mm_setzero_ps();
+
+		do {
+			const float *m = ( (const idJointMat *)( jointsPtr + index[j*2+0] ) )->ToFloatPtr();
+			const __m128 w = _mm_loadu_ps( weights[j].ToFloatPtr() );
+			acc01 = _mm256_fmadd_ps( _mm256_loadu_ps( m ), _mm256_broadcast_ps( (const __m128 *)weights[j].ToFloatPtr() ), acc01 );
+			acc2 = _mm_fmadd_ps( _mm_loadu_ps( m + 8 ), w, acc2 );
+		} while( index[j++*2+1] == 0 );
+
+		__m128 xy = _mm_hadd_ps( _mm256_castps256_ps128( acc01 ), _mm256_extractf128_ps( acc01, 1 ) );
+		__m128 xyz = _mm_hadd_ps( xy, _mm_hadd_ps( acc2, acc2 ) );
+
+		float *dst = verts[i].xyz.ToFloatPtr();
+		_mm_storel_pi( (__m64 *)dst, xyz );
+		_mm_store_ss( dst + 2, _mm_movehl_ps( xyz, xyz ) );
+	}
+	_mm256_zeroupper();
+}
+
+/*
+============
+idSIMD_AVX2::DeriveTangents
+
+	Derives the normal and orthogonal tangent vectors for the triangle vertices.
+	The plane, normal and tangents of eight triangles are calculated at a time,
+	after which they are accumulated on the vertices in triangle order.
+============
+*/
+AVX2_FMA_TARGET void VPCALL idSIMD_AVX2::DeriveTangents( idPlane *planes, idDrawVert *verts, const int numVerts, const int *indexes, const int numIndexes ) {
+	int i, k;
+
+	bool *used = (bool *)_alloca16( numVerts * sizeof( used[0] ) );
+	memset( used, 0, numVerts * sizeof( used[0] ) );
+
+	const float *base = verts->xyz.ToFloatPtr();
+	const __m256 signBit = _mm256_set1_ps( -0.0f );
+	const int numTris = numIndexes / 3;
+	ALIGN16( int vertOffsets[3][8] );
+	ALIGN16( float result[10][8] );
+
+	for ( i = 0; i < numTris; i += 8 ) {
+		const int numLanes = Min( 8, numTris - i );
+
+		// repeat the last triangle in the unused lanes
+		for ( k = 0; k < 8; k++ ) {
+			const int *tri = indexes + ( i + Min( k, numLanes - 1 ) ) * 3;
+			vertOffsets[0][k] = tri[0] * DRAWVERT_FLOATS;
+			vertOffsets[1][k] = tri[1] * DRAWVERT_FLOATS;
+			vertOffsets[2][k] = tri[2] * DRAWVERT_FLOATS;
+		}
+		const __m256i oa = _mm256_loadu_si256( (const __m256i *)vertOffsets[0] );
+		const __m256i ob = _mm256_loadu_si256( (const __m256i *)vertOffsets[1] );
+		const __m256i oc = _mm256_loadu_si256( (const __m256i *)vertOffsets[2] );
+
+		const __m256 ax = _mm256_i32gather_ps( base + 0, oa, 4 );
+		const __m256 ay = _mm256_i32gather_ps( base + 1, oa, 4 );
+		const __m256 az = _mm256_i32gather_ps( base + 2, oa, 4 );
+		const __m256 as = _mm256_i32gather_ps( base + DRAWVERT_ST_FLOAT + 0, oa, 4 );
+		const __m256 at = _mm256_i32gather_ps( base + DRAWVERT_ST_FLOAT + 1, oa, 4 );
+
+		const __m256 d0x = _mm256_sub_ps( _mm256_i32gather_ps( base + 0, ob, 4 ), ax );
+		const __m256 d0y = _mm256_sub_ps( _mm256_i32gather_ps( base + 1, ob, 4 ), ay );
+		const __m256 d0z = _mm256_sub_ps( _mm256_i32gather_ps( base + 2, ob, 4 ), az );
+		const __m256 d0s = _mm256_sub_ps( _mm256_i32gather_ps( base + DRAWVERT_ST_FLOAT + 0, ob, 4 ), as );
+		const __m256 d0t = _mm256_sub_ps( _mm256_i32gather_ps( base + DRAWVERT_ST_FLOAT + 1, ob, 4 ), at );
+
+		const __m256 d1x = _mm256_sub_ps( _mm256_i32gather_ps( base + 0, oc, 4 ), ax );
+		const __m256 d1y = _mm256_sub_ps( _mm256_i32gather_ps( base + 1, oc, 4 ), ay );
+		const __m256 d1z = _mm256_sub_ps( _mm256_i32gather_ps( base + 2, oc, 4 ), az );
+		const __m256 d1s = _mm256_sub_ps( _mm256_i32gather_ps( base + DRAWVERT_ST_FLOAT + 0, oc, 4 ), as );
+		const __m256 d1t = _mm256_sub_ps( _mm256_i32gather_ps( base + DRAWVERT_ST_FLOAT + 1, oc, 4 ), at );
+
+		// normal
+		__m256 nx = _mm256_fmsub_ps( d1y, d0z, _mm256_mul_ps( d1z, d0y ) );
+		__m256 ny = _mm256_fmsub_ps( d1z, d0x, _mm256_mul_ps( d1x, d0z ) );
+		__m256 nz = _mm256_fmsub_ps( d1x, d0y, _mm256_mul_ps( d1y, d0x ) );
+
+		__m256 f = AVX2_RSqrt( _mm256_fmadd_ps( nx, nx, _mm256_fmadd_ps( ny, ny, _mm256_mul_ps( nz, nz ) ) ) );
+		nx = _mm256_mul_ps( nx, f );
+		ny = _mm256_mul_ps( ny, f );
+		nz = _mm256_mul_ps( nz, f );
+
+		_mm256_storeu_ps( result[0], nx );
+		_mm256_storeu_ps( result[1], ny );
+		_mm256_storeu_ps( result[2], nz );
+		_mm256_storeu_ps( result[3], _mm256_xor_ps( _mm256_fmadd_ps( nx, ax, _mm256_fmadd_ps( ny, ay, _mm256_mul_ps( nz, az ) ) ), signBit ) );
+
+		// area sign bit
+		const __m256 areaSign = _mm256_and_ps( _mm256_fmsub_ps( d0s, d1t, _mm256_mul_ps( d0t, d1s ) ), signBit );
+
+		// first tangent
+		__m256 tx = _mm256_fmsub_ps( d0x, d1t, _mm256_mul_ps( d0t, d1x ) );
+		__m256 ty = _mm256_fmsub_ps( d0y, d1t, _mm256_mul_ps( d0t, d1y ) );
+		__m256 tz = _mm256_fmsub_ps( d0z, d1t, _mm256_mul_ps( d0t, d1z ) );
+
+		f = _mm256_xor_ps( AVX2_RSqrt( _mm256_fmadd_ps( tx, tx, _mm256_fmadd_ps( ty, ty, _mm256_mul_ps( tz, tz ) ) ) ), areaSign );
+		_mm256_storeu_ps( result[4], _mm256_mul_ps( tx, f ) );
+		_mm256_storeu_ps( result[5], _mm256_mul_ps( ty, f ) );
+		_mm256_storeu_ps( result[6], _mm256_mul_ps( tz, f ) );
+
+		// second tangent
+		tx = _mm256_fmsub_ps( d0s, d1x, _mm256_mul_ps( d0x, d1s ) );
+		ty = _mm256_fmsub_ps( d0s, d1y, _mm256_mul_ps( d0y, d1s ) );
+		tz = _mm256_fmsub_ps( d0s, d1z, _mm256_mul_ps( d0z, d1s ) );
+
+		f = _mm256_xor_ps( AVX2_RSqrt( _mm256_fmadd_ps( tx, tx, _mm256_fmadd_ps( ty, ty, _mm256_mul_ps( tz, tz ) ) ) ), areaSign );
+		_mm256_storeu_ps( result[7], _mm256_mul_ps( tx, f ) );
+		_mm256_storeu_ps( result[8], _mm256_mul_ps( ty, f ) );
+		_mm256_storeu_ps( result[9], _mm256_mul_ps( tz, f ) );
+
+		for ( k = 0; k < numLanes; k++ ) {
+			const idVec3 n( result[0][k], result[1][k], result[2][k] );
+			const idVec3 t0( result[4][k], result[5][k], result[6][k] );
+			const idVec3 t1( result[7][k], result[8][k], result[9][k] );
+			const int *tri = indexes + ( i + k ) * 3;
+
+			planes[i + k].SetNormal( n );
+			planes[i + k][3] = result[3][k];
+
+			for ( int v = 0; v < 3; v++ ) {
+				idDrawVert *dv = verts + tri[v];
+				if ( used[tri[v]] ) {
+					dv->normal += n;
+					dv->tangents[0] += t0;
+					dv->tangents[1] += t1;
+				} else {
+					dv->normal = n;
+					dv->tangents[0] = t0;
+					dv->tangents[1] = t1;
+					used[tri[v]] = true;
+				}
+			}
+		}
+	}
+	_mm256_zeroupper();
+}
+
+/*
+============
+idSIMD_AVX2::CreateShadowCache
+============
+*/
+AVX2_TARGET int VPCALL idSIMD_AVX2::CreateShadowCache( idVec4 *vertexCache, int *vertRemap, const idVec3 &lightOrigin, const idDrawVert *verts, const int numVerts ) {
+	const __m128 light = _mm_setr_ps( lightOrigin[0], lightOrigin[1], lightOrigin[2], 0.0f );
+	const __m128 wOne = _mm_setr_ps( 0.0f, 0.0f, 0.0f, 1.0f );
+	int outVerts = 0;
+
+	for ( int i = 0; i < numVerts; i++ ) {
+		if ( vertRemap[i] ) {
+			continue;
+		}
+		// the fourth float is st[0] which is replaced
+		const __m128 v = _mm_loadu_ps( verts[i].xyz.ToFloatPtr() );
+		const __m128 v0 = _mm_blend_ps( v, wOne, 0x8 );
+		const __m128 v1 = _mm_blend_ps( _mm_sub_ps( v, light ), _mm_setzero_ps(), 0x8 );
+		_mm256_storeu_ps( vertexCache[outVerts].ToFloatPtr(), _mm256_insertf128_ps( _mm256_castps128_ps256( v0 ), v1, 1 ) );
+		vertRemap[i] = outVerts;
+		outVerts += 2;
+	}
+	_mm256_zeroupper();
+	return outVerts;
+}
+
+/*
+============
+idSIMD_AVX2::CreateVertexProgramShadowCache
+============
+*/
+AVX2_TARGET int VPCALL idSIMD_AVX2::CreateVertexProgramShadowCache( idVec4 *vertexCache, const idDrawVert *verts, const int numVerts ) {
+	const __m128 wOne = _mm_setr_ps( 0.0f, 0.0f, 0.0f, 1.0f );
+
+	for ( int i = 0; i < numVerts; i++ ) {
+		const __m128 v = _mm_loadu_ps( verts[i].xyz.ToFloatPtr() );
+		const __m128 v0 = _mm_blend_ps( v, wOne, 0x8 );
+		const __m128 v1 = _mm_blend_ps( v, _mm_setzero_ps(), 0x8 );
+		_mm256_storeu_ps( vertexCache[i*2].ToFloatPtr(), _mm256_insertf128_ps( _mm256_castps128_ps256( v0 ), v1, 1 ) );
+	}
+	_mm256_zeroupper();
+	return numVerts * 2;
+}
+
+/*
+============
+AVX2_MixSoundBatch
+
+  accumulates all speakers of an 8 sample block in registers while walking the sources
+============
+*/
+template< int numSpeakers >
+AVX2_FMA_TARGET static void AVX2_MixSoundBatch( float *mixBuffer, const float *samples, const int sampleStride, const int numSources, const float *lastV, const float *incV, const int volumeStride ) {
+	const __m256 ramp = _mm256_setr_ps( 0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f );
+	__m256 acc[numSpeakers];
+
+	for ( int i = 0; i < MIXBUFFER_SAMPLES; i += 8 ) {
+		const __m256 t = _mm256_add_ps( _mm256_set1_ps( (float) i ), ramp );
+
+		for ( int s = 0; s < numSpeakers; s++ ) {
+			acc[s] = _mm256_loadu_ps( mixBuffer + s * MIXBUFFER_SAMPLES + i );
+		}
+		const float *src = samples + i;
+		for ( int k = 0; k < numSources; k++, src += sampleStride ) {
+			const __m256 x = _mm256_loadu_ps( src );
+			for ( int s = 0; s < numSpeakers; s++ ) {
+				const __m256 v = _mm256_fmadd_ps( _mm256_broadcast_ss( incV + s * numSources + k ), t, _mm256_broadcast_ss( lastV + s * volumeStride + k ) );
+				acc[s] = _mm256_fmadd_ps( x, v, acc[s] );
+			}
+		}
+		for ( int s = 0; s < numSpeakers; s++ ) {
+			_mm256_storeu_ps( mixBuffer + s * MIXBUFFER_SAMPLES + i, acc[s] );
+		}
+	}
+}
+
+/*
+============
+idSIMD_AVX2::MixSoundBatch
+============
+*/
+AVX2_FMA_TARGET void VPCALL idSIMD_AVX2::MixSoundBatch( float *mixBuffer, const float *samples, const int sampleStride, const int numSources, const float *lastV, const float *currentV, const int volumeStride, const int numSpeakers ) {
+	if ( numSpeakers != 2 && numSpeakers != 6 ) {
+		idSIMD_Generic::MixSoundBatch( mixBuffer, samples, sampleStride, numSources, lastV, currentV, volumeStride, numSpeakers );
+		return;
+	}
+
+	// the per sample volume increments are computed once for the whole block
+	float *incV = (float *) _alloca16( numSpeakers * numSources * sizeof( float ) );
+	for ( int s = 0; s < numSpeakers; s++ ) {
+		for ( int k = 0; k < numSources; k++ ) {
+			incV[s*numSources+k] = ( currentV[s*volumeStride+k] - lastV[s*volumeStride+k] ) / MIXBUFFER_SAMPLES;
+		}
+	}
+
+	if ( numSpeakers == 2 ) {
+		AVX2_MixSoundBatch<2>( mixBuffer, samples, sampleStride, numSources, lastV, incV, volumeStride );
+	} else {
+		AVX2_MixSoundBatch<6>( mixBuffer, samples, sampleStride, numSources, lastV, incV, volumeStride );
+	}
+	_mm256_zeroupper();
+}
+
+#endif /* ID_SIMD_AVX2 */
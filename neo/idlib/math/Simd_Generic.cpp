@@ -2499,7 +2499,7 @@ void VPCALL idSIMD_Generic::DeriveTangents( idPlane *planes, idDrawVert *verts,
 	idPlane *planesPtr = planes;
 	for ( i = 0; i < numIndexes; i += 3 ) {
 		idDrawVert *a, *b, *c;
-		unsigned long signBit;
+		dword signBit;
 		float d0[5], d1[5], f, area;
 		idVec3 n, t0, t1;
 
@@ -2540,7 +2540,7 @@ void VPCALL idSIMD_Generic::DeriveTangents( idPlane *planes, idDrawVert *verts,
 
 		// area sign bit
 		area = d0[3] * d1[4] - d0[4] * d1[3];
-		signBit = ( *(unsigned long *)&area ) & ( 1 << 31 );
+		signBit = ( *(dword *)&area ) & ( 1 << 31 );
 
 		// first tangent
 		t0[0] = d0[0] * d1[4] - d0[4] * d1[0];
@@ -2548,7 +2548,7 @@ void VPCALL idSIMD_Generic::DeriveTangents( idPlane *planes, idDrawVert *verts,
 		t0[2] = d0[2] * d1[4] - d0[4] * d1[2];
 
 		f = idMath::RSqrt( t0.x * t0.x + t0.y * t0.y + t0.z * t0.z );
-		*(unsigned long *)&f ^= signBit;
+		*(dword *)&f ^= signBit;
 
 		t0.x *= f;
 		t0.y *= f;
@@ -2560,7 +2560,7 @@ void VPCALL idSIMD_Generic::DeriveTangents( idPlane *planes, idDrawVert *verts,
 		t1[2] = d0[3] * d1[2] - d0[2] * d1[3];
 
 		f = idMath::RSqrt( t1.x * t1.x + t1.y * t1.y + t1.z * t1.z );
-		*(unsigned long *)&f ^= signBit;
+		*(dword *)&f ^= signBit;
 
 		t1.x *= f;
 		t1.y *= f;
@@ -3041,6 +3041,31 @@ void VPCALL idSIMD_Generic::MixSoundSixSpeakerStereo( float *mixBuffer, const fl
 	}
 }
 
+/*
+============
+idSIMD_Generic::MixSoundBatch
+
+  mixes numSources mono sample blocks into a planar mix buffer with numSpeakers rows of MIXBUFFER_SAMPLES,
+  source k starts at samples + k * sampleStride and ramps from lastV[s*volumeStride+k] to currentV[s*volumeStride+k] on speaker s
+============
+*/
+void VPCALL idSIMD_Generic::MixSoundBatch( float *mixBuffer, const float *samples, const int sampleStride, const int numSources, const float *lastV, const float *currentV, const int volumeStride, const int numSpeakers ) {
+	for ( int s = 0; s < numSpeakers; s++ ) {
+		float *mix = mixBuffer + s * MIXBUFFER_SAMPLES;
+		for ( int k = 0; k < numSources; k++ ) {
+			const float sV = lastV[s*volumeStride+k];
+			const float incV = ( currentV[s*volumeStride+k] - sV ) / MIXBUFFER_SAMPLES;
+			if ( sV == 0.0f && incV == 0.0f ) {
+				continue;
+			}
+			const float *src = samples + k * sampleStride;
+			for ( int j = 0; j < MIXBUFFER_SAMPLES; j++ ) {
+				mix[j] += src[j] * ( sV + incV * j );
+			}
+		}
+	}
+}
+
 /*
 ============
 idSIMD_Generic::MixedSoundToSamples
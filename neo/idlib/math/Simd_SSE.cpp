@@ -18084,4 +18084,2698 @@ void VPCALL idSIMD_SSE::MixedSoundToSamples( short *samples, const float *mixBuf
 #endif
 }
 
+#elif defined(_M_X64) || defined(__x86_64__)
+
+/*
+	x86-64 builds can't use the inline assembly above, the kernels below are
+	written with intrinsics instead. SSE2 is part of the x86-64 base instruction
+	set so it is used freely. Memcpy and Memset are left to the C runtime.
+*/
+
+#include <xmmintrin.h>
+#include <emmintrin.h>
+
+#define SHUFFLEPS( x, y, z, w )		(( (x) & 3 ) << 6 | ( (y) & 3 ) << 4 | ( (z) & 3 ) << 2 | ( (w) & 3 ))
+#define R_SHUFFLEPS( x, y, z, w )	(( (w) & 3 ) << 6 | ( (z) & 3 ) << 4 | ( (y) & 3 ) << 2 | ( (x) & 3 ))
+
+/*
+============
+idSIMD_SSE::GetName
+============
+*/
+const char * idSIMD_SSE::GetName( void ) const {
+	return "MMX & SSE";
+}
+
+/*
+============
+idSIMD_SSE::Add
+
+  dst[i] = constant + src[i];
+============
+*/
+void VPCALL idSIMD_SSE::Add( float *dst, const float constant, const float *src, const int count ) {
+	const __m128 c = _mm_set1_ps( constant );
+	int i;
+
+	for ( i = 0; i + 4 <= count; i += 4 ) {
+		_mm_storeu_ps( dst + i, _mm_add_ps( _mm_loadu_ps( src + i ), c ) );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] = src[i] + constant;
+	}
+}
+
+/*
+============
+idSIMD_SSE::Add
+
+  dst[i] = src0[i] + src1[i];
+============
+*/
+void VPCALL idSIMD_SSE::Add( float *dst, const float *src0, const float *src1, const int count ) {
+	int i;
+
+	for ( i = 0; i + 4 <= count; i += 4 ) {
+		_mm_storeu_ps( dst + i, _mm_add_ps( _mm_loadu_ps( src0 + i ), _mm_loadu_ps( src1 + i ) ) );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] = src0[i] + src1[i];
+	}
+}
+
+/*
+============
+idSIMD_SSE::Sub
+
+  dst[i] = constant - src[i];
+============
+*/
+void VPCALL idSIMD_SSE::Sub( float *dst, const float constant, const float *src, const int count ) {
+	const __m128 c = _mm_set1_ps( constant );
+	int i;
+
+	for ( i = 0; i + 4 <= count; i += 4 ) {
+		_mm_storeu_ps( dst + i, _mm_sub_ps( c, _mm_loadu_ps( src + i ) ) );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] = constant - src[i];
+	}
+}
+
+/*
+============
+idSIMD_SSE::Sub
+
+  dst[i] = src0[i] - src1[i];
+============
+*/
+void VPCALL idSIMD_SSE::Sub( float *dst, const float *src0, const float *src1, const int count ) {
+	int i;
+
+	for ( i = 0; i + 4 <= count; i += 4 ) {
+		_mm_storeu_ps( dst + i, _mm_sub_ps( _mm_loadu_ps( src0 + i ), _mm_loadu_ps( src1 + i ) ) );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] = src0[i] - src1[i];
+	}
+}
+
+/*
+============
+idSIMD_SSE::Mul
+
+  dst[i] = constant * src[i];
+============
+*/
+void VPCALL idSIMD_SSE::Mul( float *dst, const float constant, const float *src, const int count ) {
+	const __m128 c = _mm_set1_ps( constant );
+	int i;
+
+	for ( i = 0; i + 4 <= count; i += 4 ) {
+		_mm_storeu_ps( dst + i, _mm_mul_ps( c, _mm_loadu_ps( src + i ) ) );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] = constant * src[i];
+	}
+}
+
+/*
+============
+idSIMD_SSE::Mul
+
+  dst[i] = src0[i] * src1[i];
+============
+*/
+void VPCALL idSIMD_SSE::Mul( float *dst, const float *src0, const float *src1, const int count ) {
+	int i;
+
+	for ( i = 0; i + 4 <= count; i += 4 ) {
+		_mm_storeu_ps( dst + i, _mm_mul_ps( _mm_loadu_ps( src0 + i ), _mm_loadu_ps( src1 + i ) ) );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] = src0[i] * src1[i];
+	}
+}
+
+/*
+============
+idSIMD_SSE::Div
+
+  dst[i] = constant / divisor[i];
+============
+*/
+void VPCALL idSIMD_SSE::Div( float *dst, const float constant, const float *divisor, const int count ) {
+	const __m128 c = _mm_set1_ps( constant );
+	int i;
+
+	for ( i = 0; i + 4 <= count; i += 4 ) {
+		_mm_storeu_ps( dst + i, _mm_div_ps( c, _mm_loadu_ps( divisor + i ) ) );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] = constant / divisor[i];
+	}
+}
+
+/*
+============
+idSIMD_SSE::Div
+
+  dst[i] = src0[i] / src1[i];
+============
+*/
+void VPCALL idSIMD_SSE::Div( float *dst, const float *src0, const float *src1, const int count ) {
+	int i;
+
+	for ( i = 0; i + 4 <= count; i += 4 ) {
+		_mm_storeu_ps( dst + i, _mm_div_ps( _mm_loadu_ps( src0 + i ), _mm_loadu_ps( src1 + i ) ) );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] = src0[i] / src1[i];
+	}
+}
+
+/*
+============
+idSIMD_SSE::MulAdd
+
+  dst[i] += constant * src[i];
+============
+*/
+void VPCALL idSIMD_SSE::MulAdd( float *dst, const float constant, const float *src, const int count ) {
+	const __m128 c = _mm_set1_ps( constant );
+	int i;
+
+	for ( i = 0; i + 4 <= count; i += 4 ) {
+		_mm_storeu_ps( dst + i, _mm_add_ps( _mm_loadu_ps( dst + i ), _mm_mul_ps( c, _mm_loadu_ps( src + i ) ) ) );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] += constant * src[i];
+	}
+}
+
+/*
+============
+idSIMD_SSE::MulAdd
+
+  dst[i] += src0[i] * src1[i];
+============
+*/
+void VPCALL idSIMD_SSE::MulAdd( float *dst, const float *src0, const float *src1, const int count ) {
+	int i;
+
+	for ( i = 0; i + 4 <= count; i += 4 ) {
+		_mm_storeu_ps( dst + i, _mm_add_ps( _mm_loadu_ps( dst + i ), _mm_mul_ps( _mm_loadu_ps( src0 + i ), _mm_loadu_ps( src1 + i ) ) ) );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] += src0[i] * src1[i];
+	}
+}
+
+/*
+============
+idSIMD_SSE::MulSub
+
+  dst[i] -= constant * src[i];
+============
+*/
+void VPCALL idSIMD_SSE::MulSub( float *dst, const float constant, const float *src, const int count ) {
+	const __m128 c = _mm_set1_ps( constant );
+	int i;
+
+	for ( i = 0; i + 4 <= count; i += 4 ) {
+		_mm_storeu_ps( dst + i, _mm_sub_ps( _mm_loadu_ps( dst + i ), _mm_mul_ps( c, _mm_loadu_ps( src + i ) ) ) );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] -= constant * src[i];
+	}
+}
+
+/*
+============
+idSIMD_SSE::MulSub
+
+  dst[i] -= src0[i] * src1[i];
+============
+*/
+void VPCALL idSIMD_SSE::MulSub( float *dst, const float *src0, const float *src1, const int count ) {
+	int i;
+
+	for ( i = 0; i + 4 <= count; i += 4 ) {
+		_mm_storeu_ps( dst + i, _mm_sub_ps( _mm_loadu_ps( dst + i ), _mm_mul_ps( _mm_loadu_ps( src0 + i ), _mm_loadu_ps( src1 + i ) ) ) );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] -= src0[i] * src1[i];
+	}
+}
+
+/*
+============
+SSE_LoadVec3x4
+
+  loads four packed 3D vectors and transposes them to x, y and z registers
+============
+*/
+static ID_INLINE void SSE_LoadVec3x4( const float *src, __m128 &x, __m128 &y, __m128 &z ) {
+	const __m128 a = _mm_loadu_ps( src + 0 );		// x0 y0 z0 x1
+	const __m128 b = _mm_loadu_ps( src + 4 );		// y1 z1 x2 y2
+	const __m128 c = _mm_loadu_ps( src + 8 );		// z2 x3 y3 z3
+
+	x = _mm_shuffle_ps( a, _mm_shuffle_ps( b, c, R_SHUFFLEPS( 2, 2, 1, 1 ) ), R_SHUFFLEPS( 0, 3, 0, 2 ) );
+	y = _mm_shuffle_ps( _mm_shuffle_ps( a, b, R_SHUFFLEPS( 1, 1, 0, 0 ) ), _mm_shuffle_ps( b, c, R_SHUFFLEPS( 3, 3, 2, 2 ) ), R_SHUFFLEPS( 0, 2, 0, 2 ) );
+	z = _mm_shuffle_ps( _mm_shuffle_ps( a, b, R_SHUFFLEPS( 2, 2, 1, 1 ) ), _mm_shuffle_ps( c, c, R_SHUFFLEPS( 0, 0, 3, 3 ) ), R_SHUFFLEPS( 0, 2, 0, 2 ) );
+}
+
+/*
+============
+SSE_LoadVec4x4
+
+  loads four vectors with the given float stride and transposes them to x, y, z and w registers
+============
+*/
+static ID_INLINE void SSE_LoadVec4x4( const float *src, const int stride, __m128 &x, __m128 &y, __m128 &z, __m128 &w ) {
+	x = _mm_loadu_ps( src + 0 * stride );
+	y = _mm_loadu_ps( src + 1 * stride );
+	z = _mm_loadu_ps( src + 2 * stride );
+	w = _mm_loadu_ps( src + 3 * stride );
+	_MM_TRANSPOSE4_PS( x, y, z, w );
+}
+
+/*
+============
+idSIMD_SSE::Dot
+
+  dst[i] = constant * src[i];
+============
+*/
+void VPCALL idSIMD_SSE::Dot( float *dst, const idVec3 &constant, const idVec3 *src, const int count ) {
+	if ( count < 4 ) {
+		idSIMD_Generic::Dot( dst, constant, src, count );
+		return;
+	}
+
+	const __m128 cx = _mm_set1_ps( constant[0] );
+	const __m128 cy = _mm_set1_ps( constant[1] );
+	const __m128 cz = _mm_set1_ps( constant[2] );
+	int i;
+
+	for ( i = 0; i + 4 <= count; i += 4 ) {
+		__m128 x, y, z;
+		SSE_LoadVec3x4( src[i].ToFloatPtr(), x, y, z );
+		__m128 d = _mm_add_ps( _mm_mul_ps( cx, x ), _mm_mul_ps( cy, y ) );
+		_mm_storeu_ps( dst + i, _mm_add_ps( d, _mm_mul_ps( cz, z ) ) );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] = constant * src[i];
+	}
+}
+
+/*
+============
+idSIMD_SSE::Dot
+
+  dst[i] = constant * src[i].Normal() + src[i][3];
+============
+*/
+void VPCALL idSIMD_SSE::Dot( float *dst, const idVec3 &constant, const idPlane *src, const int count ) {
+	if ( count < 4 ) {
+		idSIMD_Generic::Dot( dst, constant, src, count );
+		return;
+	}
+
+	const __m128 cx = _mm_set1_ps( constant[0] );
+	const __m128 cy = _mm_set1_ps( constant[1] );
+	const __m128 cz = _mm_set1_ps( constant[2] );
+	int i;
+
+	for ( i = 0; i + 4 <= count; i += 4 ) {
+		__m128 x, y, z, w;
+		SSE_LoadVec4x4( src[i].ToFloatPtr(), 4, x, y, z, w );
+		__m128 d = _mm_add_ps( _mm_mul_ps( cx, x ), _mm_mul_ps( cy, y ) );
+		d = _mm_add_ps( d, _mm_mul_ps( cz, z ) );
+		_mm_storeu_ps( dst + i, _mm_add_ps( d, w ) );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] = constant * src[i].Normal() + src[i][3];
+	}
+}
+
+/*
+============
+idSIMD_SSE::Dot
+
+  dst[i] = constant * src[i].xyz;
+============
+*/
+void VPCALL idSIMD_SSE::Dot( float *dst, const idVec3 &constant, const idDrawVert *src, const int count ) {
+	if ( count < 4 ) {
+		idSIMD_Generic::Dot( dst, constant, src, count );
+		return;
+	}
+
+	const int stride = sizeof( idDrawVert ) / sizeof( float );
+	const __m128 cx = _mm_set1_ps( constant[0] );
+	const __m128 cy = _mm_set1_ps( constant[1] );
+	const __m128 cz = _mm_set1_ps( constant[2] );
+	int i;
+
+	// the fourth float is st[0] which is ignored
+	for ( i = 0; i + 4 <= count; i += 4 ) {
+		__m128 x, y, z, w;
+		SSE_LoadVec4x4( src[i].xyz.ToFloatPtr(), stride, x, y, z, w );
+		__m128 d = _mm_add_ps( _mm_mul_ps( cx, x ), _mm_mul_ps( cy, y ) );
+		_mm_storeu_ps( dst + i, _mm_add_ps( d, _mm_mul_ps( cz, z ) ) );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] = constant * src[i].xyz;
+	}
+}
+
+/*
+============
+idSIMD_SSE::Dot
+
+  dst[i] = constant.Normal() * src[i] + constant[3];
+============
+*/
+void VPCALL idSIMD_SSE::Dot( float *dst, const idPlane &constant, const idVec3 *src, const int count ) {
+	if ( count < 4 ) {
+		idSIMD_Generic::Dot( dst, constant, src, count );
+		return;
+	}
+
+	const __m128 cx = _mm_set1_ps( constant[0] );
+	const __m128 cy = _mm_set1_ps( constant[1] );
+	const __m128 cz = _mm_set1_ps( constant[2] );
+	const __m128 cw = _mm_set1_ps( constant[3] );
+	int i;
+
+	for ( i = 0; i + 4 <= count; i += 4 ) {
+		__m128 x, y, z;
+		SSE_LoadVec3x4( src[i].ToFloatPtr(), x, y, z );
+		__m128 d = _mm_add_ps( _mm_mul_ps( cx, x ), _mm_mul_ps( cy, y ) );
+		d = _mm_add_ps( d, _mm_mul_ps( cz, z ) );
+		_mm_storeu_ps( dst + i, _mm_add_ps( d, cw ) );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] = constant.Normal() * src[i] + constant[3];
+	}
+}
+
+/*
+============
+idSIMD_SSE::Dot
+
+  dst[i] = constant.Normal() * src[i].Normal() + constant[3] * src[i][3];
+============
+*/
+void VPCALL idSIMD_SSE::Dot( float *dst, const idPlane &constant, const idPlane *src, const int count ) {
+	if ( count < 4 ) {
+		idSIMD_Generic::Dot( dst, constant, src, count );
+		return;
+	}
+
+	const __m128 cx = _mm_set1_ps( constant[0] );
+	const __m128 cy = _mm_set1_ps( constant[1] );
+	const __m128 cz = _mm_set1_ps( constant[2] );
+	const __m128 cw = _mm_set1_ps( constant[3] );
+	int i;
+
+	for ( i = 0; i + 4 <= count; i += 4 ) {
+		__m128 x, y, z, w;
+		SSE_LoadVec4x4( src[i].ToFloatPtr(), 4, x, y, z, w );
+		__m128 d = _mm_add_ps( _mm_mul_ps( cx, x ), _mm_mul_ps( cy, y ) );
+		d = _mm_add_ps( d, _mm_mul_ps( cz, z ) );
+		_mm_storeu_ps( dst + i, _mm_add_ps( d, _mm_mul_ps( cw, w ) ) );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] = constant.Normal() * src[i].Normal() + constant[3] * src[i][3];
+	}
+}
+
+/*
+============
+idSIMD_SSE::Dot
+
+  dst[i] = constant.Normal() * src[i].xyz + constant[3];
+============
+*/
+void VPCALL idSIMD_SSE::Dot( float *dst, const idPlane &constant, const idDrawVert *src, const int count ) {
+	if ( count < 4 ) {
+		idSIMD_Generic::Dot( dst, constant, src, count );
+		return;
+	}
+
+	const int stride = sizeof( idDrawVert ) / sizeof( float );
+	const __m128 cx = _mm_set1_ps( constant[0] );
+	const __m128 cy = _mm_set1_ps( constant[1] );
+	const __m128 cz = _mm_set1_ps( constant[2] );
+	const __m128 cw = _mm_set1_ps( constant[3] );
+	int i;
+
+	for ( i = 0; i + 4 <= count; i += 4 ) {
+		__m128 x, y, z, w;
+		SSE_LoadVec4x4( src[i].xyz.ToFloatPtr(), stride, x, y, z, w );
+		__m128 d = _mm_add_ps( _mm_mul_ps( cx, x ), _mm_mul_ps( cy, y ) );
+		d = _mm_add_ps( d, _mm_mul_ps( cz, z ) );
+		_mm_storeu_ps( dst + i, _mm_add_ps( d, cw ) );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] = constant.Normal() * src[i].xyz + constant[3];
+	}
+}
+
+/*
+============
+idSIMD_SSE::Dot
+
+  dst[i] = src0[i] * src1[i];
+============
+*/
+void VPCALL idSIMD_SSE::Dot( float *dst, const idVec3 *src0, const idVec3 *src1, const int count ) {
+	if ( count < 4 ) {
+		idSIMD_Generic::Dot( dst, src0, src1, count );
+		return;
+	}
+
+	int i;
+
+	for ( i = 0; i + 4 <= count; i += 4 ) {
+		__m128 x0, y0, z0, x1, y1, z1;
+		SSE_LoadVec3x4( src0[i].ToFloatPtr(), x0, y0, z0 );
+		SSE_LoadVec3x4( src1[i].ToFloatPtr(), x1, y1, z1 );
+		__m128 d = _mm_add_ps( _mm_mul_ps( x0, x1 ), _mm_mul_ps( y0, y1 ) );
+		_mm_storeu_ps( dst + i, _mm_add_ps( d, _mm_mul_ps( z0, z1 ) ) );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] = src0[i] * src1[i];
+	}
+}
+
+/*
+============
+idSIMD_SSE::Dot
+
+  dot = src1[0] * src2[0] + src1[1] * src2[1] + src1[2] * src2[2] + ...
+
+  the products are accumulated in double precision like the generic code
+============
+*/
+void VPCALL idSIMD_SSE::Dot( float &dot, const float *src1, const float *src2, const int count ) {
+	if ( count < 4 ) {
+		idSIMD_Generic::Dot( dot, src1, src2, count );
+		return;
+	}
+
+	__m128d s0 = _mm_setzero_pd();
+	__m128d s1 = _mm_setzero_pd();
+	int i;
+
+	for ( i = 0; i + 4 <= count; i += 4 ) {
+		const __m128 p = _mm_mul_ps( _mm_loadu_ps( src1 + i ), _mm_loadu_ps( src2 + i ) );
+		s0 = _mm_add_pd( s0, _mm_cvtps_pd( p ) );
+		s1 = _mm_add_pd( s1, _mm_cvtps_pd( _mm_movehl_ps( p, p ) ) );
+	}
+	s0 = _mm_add_pd( s0, s1 );
+	s0 = _mm_add_sd( s0, _mm_unpackhi_pd( s0, s0 ) );
+	double sum = _mm_cvtsd_f64( s0 );
+	for ( ; i < count; i++ ) {
+		float p = src1[i] * src2[i];
+		sum += p;
+	}
+	dot = (float) sum;
+}
+
+/*
+============
+SSE_PackCompare
+
+  packs the masks of sixteen float compares to sixteen bytes
+============
+*/
+static ID_INLINE __m128i SSE_PackCompare( const __m128 m0, const __m128 m1, const __m128 m2, const __m128 m3 ) {
+	const __m128i m01 = _mm_packs_epi32( _mm_castps_si128( m0 ), _mm_castps_si128( m1 ) );
+	const __m128i m23 = _mm_packs_epi32( _mm_castps_si128( m2 ), _mm_castps_si128( m3 ) );
+	return _mm_packs_epi16( m01, m23 );
+}
+
+#define COMPARECONSTANT( DST, SRC0, CONSTANT, COUNT, CMPPS, OPER )													\
+	const __m128 c = _mm_set1_ps( CONSTANT );																		\
+	const __m128i one = _mm_set1_epi8( 1 );																			\
+	int i;																											\
+	for ( i = 0; i + 16 <= COUNT; i += 16 ) {																		\
+		__m128i m = SSE_PackCompare( CMPPS( _mm_loadu_ps( SRC0 + i + 0 ), c ), CMPPS( _mm_loadu_ps( SRC0 + i + 4 ), c ),	\
+									CMPPS( _mm_loadu_ps( SRC0 + i + 8 ), c ), CMPPS( _mm_loadu_ps( SRC0 + i + 12 ), c ) );	\
+		_mm_storeu_si128( (__m128i *)( DST + i ), _mm_and_si128( m, one ) );										\
+	}																												\
+	for ( ; i < COUNT; i++ ) {																						\
+		DST[i] = SRC0[i] OPER CONSTANT;																				\
+	}
+
+#define COMPAREBITCONSTANT( DST, BITNUM, SRC0, CONSTANT, COUNT, CMPPS, OPER )										\
+	const __m128 c = _mm_set1_ps( CONSTANT );																		\
+	const __m128i bit = _mm_set1_epi8( (char) ( 1 << BITNUM ) );													\
+	int i;																											\
+	for ( i = 0; i + 16 <= COUNT; i += 16 ) {																		\
+		__m128i m = SSE_PackCompare( CMPPS( _mm_loadu_ps( SRC0 + i + 0 ), c ), CMPPS( _mm_loadu_ps( SRC0 + i + 4 ), c ),	\
+									CMPPS( _mm_loadu_ps( SRC0 + i + 8 ), c ), CMPPS( _mm_loadu_ps( SRC0 + i + 12 ), c ) );	\
+		__m128i d = _mm_loadu_si128( (const __m128i *)( DST + i ) );												\
+		_mm_storeu_si128( (__m128i *)( DST + i ), _mm_or_si128( d, _mm_and_si128( m, bit ) ) );					\
+	}																												\
+	for ( ; i < COUNT; i++ ) {																						\
+		DST[i] |= ( SRC0[i] OPER CONSTANT ) << BITNUM;																\
+	}
+
+/*
+============
+idSIMD_SSE::CmpGT
+
+  dst[i] = src0[i] > constant;
+============
+*/
+void VPCALL idSIMD_SSE::CmpGT( byte *dst, const float *src0, const float constant, const int count ) {
+	COMPARECONSTANT( dst, src0, constant, count, _mm_cmpgt_ps, > )
+}
+
+/*
+============
+idSIMD_SSE::CmpGT
+
+  dst[i] |= ( src0[i] > constant ) << bitNum;
+============
+*/
+void VPCALL idSIMD_SSE::CmpGT( byte *dst, const byte bitNum, const float *src0, const float constant, const int count ) {
+	COMPAREBITCONSTANT( dst, bitNum, src0, constant, count, _mm_cmpgt_ps, > )
+}
+
+/*
+============
+idSIMD_SSE::CmpGE
+
+  dst[i] = src0[i] >= constant;
+============
+*/
+void VPCALL idSIMD_SSE::CmpGE( byte *dst, const float *src0, const float constant, const int count ) {
+	COMPARECONSTANT( dst, src0, constant, count, _mm_cmpge_ps, >= )
+}
+
+/*
+============
+idSIMD_SSE::CmpGE
+
+  dst[i] |= ( src0[i] >= constant ) << bitNum;
+============
+*/
+void VPCALL idSIMD_SSE::CmpGE( byte *dst, const byte bitNum, const float *src0, const float constant, const int count ) {
+	COMPAREBITCONSTANT( dst, bitNum, src0, constant, count, _mm_cmpge_ps, >= )
+}
+
+/*
+============
+idSIMD_SSE::CmpLT
+
+  dst[i] = src0[i] < constant;
+============
+*/
+void VPCALL idSIMD_SSE::CmpLT( byte *dst, const float *src0, const float constant, const int count ) {
+	COMPARECONSTANT( dst, src0, constant, count, _mm_cmplt_ps, < )
+}
+
+/*
+============
+idSIMD_SSE::CmpLT
+
+  dst[i] |= ( src0[i] < constant ) << bitNum;
+============
+*/
+void VPCALL idSIMD_SSE::CmpLT( byte *dst, const byte bitNum, const float *src0, const float constant, const int count ) {
+	COMPAREBITCONSTANT( dst, bitNum, src0, constant, count, _mm_cmplt_ps, < )
+}
+
+/*
+============
+idSIMD_SSE::CmpLE
+
+  dst[i] = src0[i] <= constant;
+============
+*/
+void VPCALL idSIMD_SSE::CmpLE( byte *dst, const float *src0, const float constant, const int count ) {
+	COMPARECONSTANT( dst, src0, constant, count, _mm_cmple_ps, <= )
+}
+
+/*
+============
+idSIMD_SSE::CmpLE
+
+  dst[i] |= ( src0[i] <= constant ) << bitNum;
+============
+*/
+void VPCALL idSIMD_SSE::CmpLE( byte *dst, const byte bitNum, const float *src0, const float constant, const int count ) {
+	COMPAREBITCONSTANT( dst, bitNum, src0, constant, count, _mm_cmple_ps, <= )
+}
+
+/*
+============
+SSE_StoreMinMax
+============
+*/
+static ID_INLINE void SSE_StoreMinMax( idVec3 &min, idVec3 &max, const __m128 mn, const __m128 mx ) {
+	ALIGN16( float fmin[4] );
+	ALIGN16( float fmax[4] );
+
+	_mm_store_ps( fmin, mn );
+	_mm_store_ps( fmax, mx );
+	min.Set( fmin[0], fmin[1], fmin[2] );
+	max.Set( fmax[0], fmax[1], fmax[2] );
+}
+
+/*
+============
+idSIMD_SSE::MinMax
+
+  new values are always the first operand of min/max so NaNs are skipped like in the generic code
+============
+*/
+void VPCALL idSIMD_SSE::MinMax( float &min, float &max, const float *src, const int count ) {
+	__m128 mn = _mm_set1_ps( idMath::INFINITY );
+	__m128 mx = _mm_set1_ps( -idMath::INFINITY );
+	int i;
+
+	for ( i = 0; i + 4 <= count; i += 4 ) {
+		__m128 v = _mm_loadu_ps( src + i );
+		mn = _mm_min_ps( v, mn );
+		mx = _mm_max_ps( v, mx );
+	}
+	mn = _mm_min_ps( mn, _mm_movehl_ps( mn, mn ) );
+	mx = _mm_max_ps( mx, _mm_movehl_ps( mx, mx ) );
+	mn = _mm_min_ss( mn, _mm_shuffle_ps( mn, mn, R_SHUFFLEPS( 1, 1, 1, 1 ) ) );
+	mx = _mm_max_ss( mx, _mm_shuffle_ps( mx, mx, R_SHUFFLEPS( 1, 1, 1, 1 ) ) );
+	min = _mm_cvtss_f32( mn );
+	max = _mm_cvtss_f32( mx );
+	for ( ; i < count; i++ ) {
+		if ( src[i] < min ) {
+			min = src[i];
+		}
+		if ( src[i] > max ) {
+			max = src[i];
+		}
+	}
+}
+
+/*
+============
+idSIMD_SSE::MinMax
+============
+*/
+void VPCALL idSIMD_SSE::MinMax( idVec2 &min, idVec2 &max, const idVec2 *src, const int count ) {
+	const float *s = src->ToFloatPtr();
+	__m128 mn = _mm_set1_ps( idMath::INFINITY );
+	__m128 mx = _mm_set1_ps( -idMath::INFINITY );
+	int i;
+
+	// two vectors at a time, the even lanes hold x and the odd lanes y
+	for ( i = 0; i + 2 <= count; i += 2 ) {
+		__m128 v = _mm_loadu_ps( s + i * 2 );
+		mn = _mm_min_ps( v, mn );
+		mx = _mm_max_ps( v, mx );
+	}
+	mn = _mm_min_ps( mn, _mm_movehl_ps( mn, mn ) );
+	mx = _mm_max_ps( mx, _mm_movehl_ps( mx, mx ) );
+	min[0] = _mm_cvtss_f32( mn );
+	max[0] = _mm_cvtss_f32( mx );
+	min[1] = _mm_cvtss_f32( _mm_shuffle_ps( mn, mn, R_SHUFFLEPS( 1, 1, 1, 1 ) ) );
+	max[1] = _mm_cvtss_f32( _mm_shuffle_ps( mx, mx, R_SHUFFLEPS( 1, 1, 1, 1 ) ) );
+	if ( i < count ) {
+		const idVec2 &v = src[i];
+		if ( v[0] < min[0] ) {
+			min[0] = v[0];
+		}
+		if ( v[0] > max[0] ) {
+			max[0] = v[0];
+		}
+		if ( v[1] < min[1] ) {
+			min[1] = v[1];
+		}
+		if ( v[1] > max[1] ) {
+			max[1] = v[1];
+		}
+	}
+}
+
+/*
+============
+idSIMD_SSE::MinMax
+============
+*/
+void VPCALL idSIMD_SSE::MinMax( idVec3 &min, idVec3 &max, const idVec3 *src, const int count ) {
+	__m128 mn = _mm_set1_ps( idMath::INFINITY );
+	__m128 mx = _mm_set1_ps( -idMath::INFINITY );
+	int i;
+
+	// the four float loads read one float past each vector, so the last one is loaded separately
+	for ( i = 0; i < count - 1; i++ ) {
+		__m128 v = _mm_loadu_ps( src[i].ToFloatPtr() );
+		mn = _mm_min_ps( v, mn );
+		mx = _mm_max_ps( v, mx );
+	}
+	if ( i < count ) {
+		__m128 v = _mm_setr_ps( src[i][0], src[i][1], src[i][2], 0.0f );
+		mn = _mm_min_ps( v, mn );
+		mx = _mm_max_ps( v, mx );
+	}
+	SSE_StoreMinMax( min, max, mn, mx );
+}
+
+/*
+============
+idSIMD_SSE::MinMax
+============
+*/
+void VPCALL idSIMD_SSE::MinMax( idVec3 &min, idVec3 &max, const idDrawVert *src, const int count ) {
+	__m128 mn = _mm_set1_ps( idMath::INFINITY );
+	__m128 mx = _mm_set1_ps( -idMath::INFINITY );
+
+	// the fourth float is st[0] which is ignored
+	for ( int i = 0; i < count; i++ ) {
+		__m128 v = _mm_loadu_ps( src[i].xyz.ToFloatPtr() );
+		mn = _mm_min_ps( v, mn );
+		mx = _mm_max_ps( v, mx );
+	}
+	SSE_StoreMinMax( min, max, mn, mx );
+}
+
+/*
+============
+idSIMD_SSE::MinMax
+============
+*/
+void VPCALL idSIMD_SSE::MinMax( idVec3 &min, idVec3 &max, const idDrawVert *src, const int *indexes, const int count ) {
+	__m128 mn = _mm_set1_ps( idMath::INFINITY );
+	__m128 mx = _mm_set1_ps( -idMath::INFINITY );
+
+	for ( int i = 0; i < count; i++ ) {
+		__m128 v = _mm_loadu_ps( src[indexes[i]].xyz.ToFloatPtr() );
+		mn = _mm_min_ps( v, mn );
+		mx = _mm_max_ps( v, mx );
+	}
+	SSE_StoreMinMax( min, max, mn, mx );
+}
+
+/*
+============
+idSIMD_SSE::Clamp
+
+  the operand order of min/max gives the same results as the generic compares
+============
+*/
+void VPCALL idSIMD_SSE::Clamp( float *dst, const float *src, const float min, const float max, const int count ) {
+	const __m128 vmin = _mm_set1_ps( min );
+	const __m128 vmax = _mm_set1_ps( max );
+	int i;
+
+	for ( i = 0; i + 4 <= count; i += 4 ) {
+		_mm_storeu_ps( dst + i, _mm_min_ps( vmax, _mm_max_ps( vmin, _mm_loadu_ps( src + i ) ) ) );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] = src[i] < min ? min : src[i] > max ? max : src[i];
+	}
+}
+
+/*
+============
+idSIMD_SSE::ClampMin
+============
+*/
+void VPCALL idSIMD_SSE::ClampMin( float *dst, const float *src, const float min, const int count ) {
+	const __m128 vmin = _mm_set1_ps( min );
+	int i;
+
+	for ( i = 0; i + 4 <= count; i += 4 ) {
+		_mm_storeu_ps( dst + i, _mm_max_ps( vmin, _mm_loadu_ps( src + i ) ) );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] = src[i] < min ? min : src[i];
+	}
+}
+
+/*
+============
+idSIMD_SSE::ClampMax
+============
+*/
+void VPCALL idSIMD_SSE::ClampMax( float *dst, const float *src, const float max, const int count ) {
+	const __m128 vmax = _mm_set1_ps( max );
+	int i;
+
+	for ( i = 0; i + 4 <= count; i += 4 ) {
+		_mm_storeu_ps( dst + i, _mm_min_ps( vmax, _mm_loadu_ps( src + i ) ) );
+	}
+	for ( ; i < count; i++ ) {
+		dst[i] = src[i] > max ? max : src[i];
+	}
+}
+
+/*
+============
+idSIMD_SSE::Zero16
+
+  the *16 functions expect 16 byte aligned arrays padded to a multiple of four floats
+============
+*/
+void VPCALL idSIMD_SSE::Zero16( float *dst, const int count ) {
+	const __m128 zero = _mm_setzero_ps();
+
+	for ( int i = 0; i < count; i += 4 ) {
+		_mm_store_ps( dst + i, zero );
+	}
+}
+
+/*
+============
+idSIMD_SSE::Negate16
+============
+*/
+void VPCALL idSIMD_SSE::Negate16( float *dst, const int count ) {
+	const __m128 signBit = _mm_set1_ps( -0.0f );
+
+	for ( int i = 0; i < count; i += 4 ) {
+		_mm_store_ps( dst + i, _mm_xor_ps( _mm_load_ps( dst + i ), signBit ) );
+	}
+}
+
+/*
+============
+idSIMD_SSE::Copy16
+============
+*/
+void VPCALL idSIMD_SSE::Copy16( float *dst, const float *src, const int count ) {
+	for ( int i = 0; i < count; i += 4 ) {
+		_mm_store_ps( dst + i, _mm_load_ps( src + i ) );
+	}
+}
+
+/*
+============
+idSIMD_SSE::Add16
+============
+*/
+void VPCALL idSIMD_SSE::Add16( float *dst, const float *src1, const float *src2, const int count ) {
+	for ( int i = 0; i < count; i += 4 ) {
+		_mm_store_ps( dst + i, _mm_add_ps( _mm_load_ps( src1 + i ), _mm_load_ps( src2 + i ) ) );
+	}
+}
+
+/*
+============
+idSIMD_SSE::Sub16
+============
+*/
+void VPCALL idSIMD_SSE::Sub16( float *dst, const float *src1, const float *src2, const int count ) {
+	for ( int i = 0; i < count; i += 4 ) {
+		_mm_store_ps( dst + i, _mm_sub_ps( _mm_load_ps( src1 + i ), _mm_load_ps( src2 + i ) ) );
+	}
+}
+
+/*
+============
+idSIMD_SSE::Mul16
+============
+*/
+void VPCALL idSIMD_SSE::Mul16( float *dst, const float *src1, const float constant, const int count ) {
+	const __m128 c = _mm_set1_ps( constant );
+
+	for ( int i = 0; i < count; i += 4 ) {
+		_mm_store_ps( dst + i, _mm_mul_ps( _mm_load_ps( src1 + i ), c ) );
+	}
+}
+
+/*
+============
+idSIMD_SSE::AddAssign16
+============
+*/
+void VPCALL idSIMD_SSE::AddAssign16( float *dst, const float *src, const int count ) {
+	for ( int i = 0; i < count; i += 4 ) {
+		_mm_store_ps( dst + i, _mm_add_ps( _mm_load_ps( dst + i ), _mm_load_ps( src + i ) ) );
+	}
+}
+
+/*
+============
+idSIMD_SSE::SubAssign16
+============
+*/
+void VPCALL idSIMD_SSE::SubAssign16( float *dst, const float *src, const int count ) {
+	for ( int i = 0; i < count; i += 4 ) {
+		_mm_store_ps( dst + i, _mm_sub_ps( _mm_load_ps( dst + i ), _mm_load_ps( src + i ) ) );
+	}
+}
+
+/*
+============
+idSIMD_SSE::MulAssign16
+============
+*/
+void VPCALL idSIMD_SSE::MulAssign16( float *dst, const float constant, const int count ) {
+	const __m128 c = _mm_set1_ps( constant );
+
+	for ( int i = 0; i < count; i += 4 ) {
+		_mm_store_ps( dst + i, _mm_mul_ps( _mm_load_ps( dst + i ), c ) );
+	}
+}
+
+/*
+============
+SSE_HorizontalAdd
+
+  returns the sums of the four registers in the four lanes of the result
+============
+*/
+static ID_INLINE __m128 SSE_HorizontalAdd( __m128 s0, __m128 s1, __m128 s2, __m128 s3 ) {
+	_MM_TRANSPOSE4_PS( s0, s1, s2, s3 );
+	return _mm_add_ps( _mm_add_ps( s0, s1 ), _mm_add_ps( s2, s3 ) );
+}
+
+/*
+  the generic code unrolls the small systems solved by idLCP and is faster than
+  the dot products below until the matrices get larger than these sizes
+*/
+#define SSE_MATX_SOLVE_MIN_SIZE			12
+#define SSE_MATX_FACTOR_MIN_SIZE		16
+
+/*
+============
+SSE_DotProduct
+
+  dot product of two float arrays with single precision accumulation
+============
+*/
+static ID_INLINE float SSE_DotProduct( const float *src1, const float *src2, const int count ) {
+	__m128 s0 = _mm_setzero_ps();
+	__m128 s1 = _mm_setzero_ps();
+	int i;
+
+	for ( i = 0; i + 8 <= count; i += 8 ) {
+		s0 = _mm_add_ps( s0, _mm_mul_ps( _mm_loadu_ps( src1 + i + 0 ), _mm_loadu_ps( src2 + i + 0 ) ) );
+		s1 = _mm_add_ps( s1, _mm_mul_ps( _mm_loadu_ps( src1 + i + 4 ), _mm_loadu_ps( src2 + i + 4 ) ) );
+	}
+	if ( i + 4 <= count ) {
+		s0 = _mm_add_ps( s0, _mm_mul_ps( _mm_loadu_ps( src1 + i ), _mm_loadu_ps( src2 + i ) ) );
+		i += 4;
+	}
+	s0 = _mm_add_ps( s0, s1 );
+	s0 = _mm_add_ps( s0, _mm_movehl_ps( s0, s0 ) );
+	s0 = _mm_add_ss( s0, _mm_shuffle_ps( s0, s0, R_SHUFFLEPS( 1, 1, 1, 1 ) ) );
+	float sum = _mm_cvtss_f32( s0 );
+	for ( ; i < count; i++ ) {
+		sum += src1[i] * src2[i];
+	}
+	return sum;
+}
+
+#define MATX_ASSIGN		0
+#define MATX_ADD		1
+#define MATX_SUB		2
+
+/*
+============
+SSE_MatX_MultiplyVecX
+
+  four rows are multiplied with the vector at a time
+============
+*/
+static void SSE_MatX_MultiplyVecX( float *dstPtr, const idMatX &mat, const float *vPtr, const int op ) {
+	const int numRows = mat.GetNumRows();
+	const int numColumns = mat.GetNumColumns();
+	const int numColumns4 = numColumns & ~3;
+	int i, j;
+
+	for ( i = 0; i + 4 <= numRows; i += 4 ) {
+		const float *m0 = mat[i + 0];
+		const float *m1 = mat[i + 1];
+		const float *m2 = mat[i + 2];
+		const float *m3 = mat[i + 3];
+		__m128 s0 = _mm_setzero_ps();
+		__m128 s1 = _mm_setzero_ps();
+		__m128 s2 = _mm_setzero_ps();
+		__m128 s3 = _mm_setzero_ps();
+
+		for ( j = 0; j < numColumns4; j += 4 ) {
+			const __m128 v = _mm_loadu_ps( vPtr + j );
+			s0 = _mm_add_ps( s0, _mm_mul_ps( _mm_loadu_ps( m0 + j ), v ) );
+			s1 = _mm_add_ps( s1, _mm_mul_ps( _mm_loadu_ps( m1 + j ), v ) );
+			s2 = _mm_add_ps( s2, _mm_mul_ps( _mm_loadu_ps( m2 + j ), v ) );
+			s3 = _mm_add_ps( s3, _mm_mul_ps( _mm_loadu_ps( m3 + j ), v ) );
+		}
+		__m128 sum = SSE_HorizontalAdd( s0, s1, s2, s3 );
+		for ( ; j < numColumns; j++ ) {
+			sum = _mm_add_ps( sum, _mm_mul_ps( _mm_setr_ps( m0[j], m1[j], m2[j], m3[j] ), _mm_set1_ps( vPtr[j] ) ) );
+		}
+
+		switch( op ) {
+			case MATX_ASSIGN:	_mm_storeu_ps( dstPtr + i, sum ); break;
+			case MATX_ADD:		_mm_storeu_ps( dstPtr + i, _mm_add_ps( _mm_loadu_ps( dstPtr + i ), sum ) ); break;
+			case MATX_SUB:		_mm_storeu_ps( dstPtr + i, _mm_sub_ps( _mm_loadu_ps( dstPtr + i ), sum ) ); break;
+		}
+	}
+	for ( ; i < numRows; i++ ) {
+		const float sum = SSE_DotProduct( mat[i], vPtr, numColumns );
+
+		switch( op ) {
+			case MATX_ASSIGN:	dstPtr[i] = sum; break;
+			case MATX_ADD:		dstPtr[i] += sum; break;
+			case MATX_SUB:		dstPtr[i] -= sum; break;
+		}
+	}
+}
+
+/*
+============
+SSE_MatX_TransposeMultiplyVecX
+
+  the rows scaled by the vector elements are added up for four columns at a time
+============
+*/
+static void SSE_MatX_TransposeMultiplyVecX( float *dstPtr, const idMatX &mat, const float *vPtr, const int op ) {
+	const int numRows = mat.GetNumRows();
+	const int numColumns = mat.GetNumColumns();
+	const float *mPtr = mat.ToFloatPtr();
+	int i, j;
+
+	for ( i = 0; i + 4 <= numColumns; i += 4 ) {
+		__m128 sum = _mm_setzero_ps();
+
+		for ( j = 0; j < numRows; j++ ) {
+			sum = _mm_add_ps( sum, _mm_mul_ps( _mm_loadu_ps( mPtr + j * numColumns + i ), _mm_set1_ps( vPtr[j] ) ) );
+		}
+
+		switch( op ) {
+			case MATX_ASSIGN:	_mm_storeu_ps( dstPtr + i, sum ); break;
+			case MATX_ADD:		_mm_storeu_ps( dstPtr + i, _mm_add_ps( _mm_loadu_ps( dstPtr + i ), sum ) ); break;
+			case MATX_SUB:		_mm_storeu_ps( dstPtr + i, _mm_sub_ps( _mm_loadu_ps( dstPtr + i ), sum ) ); break;
+		}
+	}
+	for ( ; i < numColumns; i++ ) {
+		float sum = 0.0f;
+
+		for ( j = 0; j < numRows; j++ ) {
+			sum += mPtr[j * numColumns + i] * vPtr[j];
+		}
+
+		switch( op ) {
+			case MATX_ASSIGN:	dstPtr[i] = sum; break;
+			case MATX_ADD:		dstPtr[i] += sum; break;
+			case MATX_SUB:		dstPtr[i] -= sum; break;
+		}
+	}
+}
+
+/*
+============
+idSIMD_SSE::MatX_MultiplyVecX
+
+	dst = mat * vec
+============
+*/
+void VPCALL idSIMD_SSE::MatX_MultiplyVecX( idVecX &dst, const idMatX &mat, const idVecX &vec ) {
+	assert( vec.GetSize() >= mat.GetNumColumns() );
+	assert( dst.GetSize() >= mat.GetNumRows() );
+
+	if ( mat.GetNumColumns() < 4 ) {
+		idSIMD_Generic::MatX_MultiplyVecX( dst, mat, vec );
+		return;
+	}
+	SSE_MatX_MultiplyVecX( dst.ToFloatPtr(), mat, vec.ToFloatPtr(), MATX_ASSIGN );
+}
+
+/*
+============
+idSIMD_SSE::MatX_MultiplyAddVecX
+
+	dst += mat * vec
+============
+*/
+void VPCALL idSIMD_SSE::MatX_MultiplyAddVecX( idVecX &dst, const idMatX &mat, const idVecX &vec ) {
+	assert( vec.GetSize() >= mat.GetNumColumns() );
+	assert( dst.GetSize() >= mat.GetNumRows() );
+
+	if ( mat.GetNumColumns() < 4 ) {
+		idSIMD_Generic::MatX_MultiplyAddVecX( dst, mat, vec );
+		return;
+	}
+	SSE_MatX_MultiplyVecX( dst.ToFloatPtr(), mat, vec.ToFloatPtr(), MATX_ADD );
+}
+
+/*
+============
+idSIMD_SSE::MatX_MultiplySubVecX
+
+	dst -= mat * vec
+============
+*/
+void VPCALL idSIMD_SSE::MatX_MultiplySubVecX( idVecX &dst, const idMatX &mat, const idVecX &vec ) {
+	assert( vec.GetSize() >= mat.GetNumColumns() );
+	assert( dst.GetSize() >= mat.GetNumRows() );
+
+	if ( mat.GetNumColumns() < 4 ) {
+		idSIMD_Generic::MatX_MultiplySubVecX( dst, mat, vec );
+		return;
+	}
+	SSE_MatX_MultiplyVecX( dst.ToFloatPtr(), mat, vec.ToFloatPtr(), MATX_SUB );
+}
+
+/*
+============
+idSIMD_SSE::MatX_TransposeMultiplyVecX
+
+	dst = mat.Transpose() * vec
+============
+*/
+void VPCALL idSIMD_SSE::MatX_TransposeMultiplyVecX( idVecX &dst, const idMatX &mat, const idVecX &vec ) {
+	assert( vec.GetSize() >= mat.GetNumRows() );
+	assert( dst.GetSize() >= mat.GetNumColumns() );
+
+	if ( mat.GetNumColumns() < 4 ) {
+		idSIMD_Generic::MatX_TransposeMultiplyVecX( dst, mat, vec );
+		return;
+	}
+	SSE_MatX_TransposeMultiplyVecX( dst.ToFloatPtr(), mat, vec.ToFloatPtr(), MATX_ASSIGN );
+}
+
+/*
+============
+idSIMD_SSE::MatX_TransposeMultiplyAddVecX
+
+	dst += mat.Transpose() * vec
+============
+*/
+void VPCALL idSIMD_SSE::MatX_TransposeMultiplyAddVecX( idVecX &dst, const idMatX &mat, const idVecX &vec ) {
+	assert( vec.GetSize() >= mat.GetNumRows() );
+	assert( dst.GetSize() >= mat.GetNumColumns() );
+
+	if ( mat.GetNumColumns() < 4 ) {
+		idSIMD_Generic::MatX_TransposeMultiplyAddVecX( dst, mat, vec );
+		return;
+	}
+	SSE_MatX_TransposeMultiplyVecX( dst.ToFloatPtr(), mat, vec.ToFloatPtr(), MATX_ADD );
+}
+
+/*
+============
+idSIMD_SSE::MatX_TransposeMultiplySubVecX
+
+	dst -= mat.Transpose() * vec
+============
+*/
+void VPCALL idSIMD_SSE::MatX_TransposeMultiplySubVecX( idVecX &dst, const idMatX &mat, const idVecX &vec ) {
+	assert( vec.GetSize() >= mat.GetNumRows() );
+	assert( dst.GetSize() >= mat.GetNumColumns() );
+
+	if ( mat.GetNumColumns() < 4 ) {
+		idSIMD_Generic::MatX_TransposeMultiplySubVecX( dst, mat, vec );
+		return;
+	}
+	SSE_MatX_TransposeMultiplyVecX( dst.ToFloatPtr(), mat, vec.ToFloatPtr(), MATX_SUB );
+}
+
+/*
+============
+idSIMD_SSE::MatX_MultiplyMatX
+
+	dst = m1 * m2
+
+	the rows of m2 scaled by the elements of a row of m1 are added up for four columns at a time
+============
+*/
+void VPCALL idSIMD_SSE::MatX_MultiplyMatX( idMatX &dst, const idMatX &m1, const idMatX &m2 ) {
+	int i, j, n;
+
+	assert( m1.GetNumColumns() == m2.GetNumRows() );
+
+	const int k = m1.GetNumRows();
+	const int l = m2.GetNumColumns();
+	const int numInner = m1.GetNumColumns();
+
+	if ( l < 4 ) {
+		idSIMD_Generic::MatX_MultiplyMatX( dst, m1, m2 );
+		return;
+	}
+
+	float *dstPtr = dst.ToFloatPtr();
+	const float *m1Ptr = m1.ToFloatPtr();
+	const float *m2Ptr = m2.ToFloatPtr();
+
+	for ( i = 0; i < k; i++ ) {
+		for ( j = 0; j + 4 <= l; j += 4 ) {
+			__m128 sum = _mm_mul_ps( _mm_set1_ps( m1Ptr[0] ), _mm_loadu_ps( m2Ptr + j ) );
+			for ( n = 1; n < numInner; n++ ) {
+				sum = _mm_add_ps( sum, _mm_mul_ps( _mm_set1_ps( m1Ptr[n] ), _mm_loadu_ps( m2Ptr + n * l + j ) ) );
+			}
+			_mm_storeu_ps( dstPtr + j, sum );
+		}
+		for ( ; j < l; j++ ) {
+			float sum = m1Ptr[0] * m2Ptr[j];
+			for ( n = 1; n < numInner; n++ ) {
+				sum += m1Ptr[n] * m2Ptr[n * l + j];
+			}
+			dstPtr[j] = sum;
+		}
+		dstPtr += l;
+		m1Ptr += numInner;
+	}
+}
+
+/*
+============
+idSIMD_SSE::MatX_TransposeMultiplyMatX
+
+	dst = m1.Transpose() * m2
+============
+*/
+void VPCALL idSIMD_SSE::MatX_TransposeMultiplyMatX( idMatX &dst, const idMatX &m1, const idMatX &m2 ) {
+	int i, j, n;
+
+	assert( m1.GetNumRows() == m2.GetNumRows() );
+
+	const int k = m1.GetNumColumns();
+	const int l = m2.GetNumColumns();
+	const int numInner = m1.GetNumRows();
+
+	if ( l < 4 ) {
+		idSIMD_Generic::MatX_TransposeMultiplyMatX( dst, m1, m2 );
+		return;
+	}
+
+	float *dstPtr = dst.ToFloatPtr();
+	const float *m1Ptr = m1.ToFloatPtr();
+	const float *m2Ptr = m2.ToFloatPtr();
+
+	for ( i = 0; i < k; i++ ) {
+		for ( j = 0; j + 4 <= l; j += 4 ) {
+			__m128 sum = _mm_mul_ps( _mm_set1_ps( m1Ptr[i] ), _mm_loadu_ps( m2Ptr + j ) );
+			for ( n = 1; n < numInner; n++ ) {
+				sum = _mm_add_ps( sum, _mm_mul_ps( _mm_set1_ps( m1Ptr[n * k + i] ), _mm_loadu_ps( m2Ptr + n * l + j ) ) );
+			}
+			_mm_storeu_ps( dstPtr + j, sum );
+		}
+		for ( ; j < l; j++ ) {
+			float sum = m1Ptr[i] * m2Ptr[j];
+			for ( n = 1; n < numInner; n++ ) {
+				sum += m1Ptr[n * k + i] * m2Ptr[n * l + j];
+			}
+			dstPtr[j] = sum;
+		}
+		dstPtr += l;
+	}
+}
+
+/*
+============
+idSIMD_SSE::MatX_LowerTriangularSolve
+
+  solves x in Lx = b for the n * n sub-matrix of L
+  if skip > 0 the first skip elements of x are assumed to be valid already
+  L has to be a lower triangular matrix with (implicit) ones on the diagonal
+  x == b is allowed
+============
+*/
+void VPCALL idSIMD_SSE::MatX_LowerTriangularSolve( const idMatX &L, float *x, const float *b, const int n, int skip ) {
+	if ( n < SSE_MATX_SOLVE_MIN_SIZE ) {
+		idSIMD_Generic::MatX_LowerTriangularSolve( L, x, b, n, skip );
+		return;
+	}
+
+	for ( int i = skip; i < n; i++ ) {
+		x[i] = b[i] - SSE_DotProduct( L[i], x, i );
+	}
+}
+
+/*
+============
+idSIMD_SSE::MatX_LowerTriangularSolveTranspose
+
+  solves x in L'x = b for the n * n sub-matrix of L
+  L has to be a lower triangular matrix with (implicit) ones on the diagonal
+  x == b is allowed
+
+  each solved element is subtracted from the remaining ones with a row of L
+  so the matrix is never walked down a column
+============
+*/
+void VPCALL idSIMD_SSE::MatX_LowerTriangularSolveTranspose( const idMatX &L, float *x, const float *b, const int n ) {
+	int i, j;
+
+	if ( n < SSE_MATX_SOLVE_MIN_SIZE ) {
+		idSIMD_Generic::MatX_LowerTriangularSolveTranspose( L, x, b, n );
+		return;
+	}
+
+	if ( x != b ) {
+		memcpy( x, b, n * sizeof( float ) );
+	}
+
+	for ( j = n - 1; j > 0; j-- ) {
+		const float *lptr = L[j];
+		const __m128 xj = _mm_set1_ps( x[j] );
+
+		for ( i = 0; i + 4 <= j; i += 4 ) {
+			_mm_storeu_ps( x + i, _mm_sub_ps( _mm_loadu_ps( x + i ), _mm_mul_ps( _mm_loadu_ps( lptr + i ), xj ) ) );
+		}
+		for ( ; i < j; i++ ) {
+			x[i] -= lptr[i] * x[j];
+		}
+	}
+}
+
+/*
+============
+idSIMD_SSE::MatX_LDLTFactor
+
+  in-place factorization LDL' of the n * n sub-matrix of mat
+  the reciprocal of the diagonal elements are stored in invDiag
+============
+*/
+bool VPCALL idSIMD_SSE::MatX_LDLTFactor( idMatX &mat, idVecX &invDiag, const int n ) {
+	int i, j, k;
+	float *v, *diag, *ptr;
+	float sum, d;
+
+	if ( n < SSE_MATX_FACTOR_MIN_SIZE ) {
+		return idSIMD_Generic::MatX_LDLTFactor( mat, invDiag, n );
+	}
+
+	v = (float *) _alloca16( n * sizeof( float ) );
+	diag = (float *) _alloca16( n * sizeof( float ) );
+
+	for ( i = 0; i < n; i++ ) {
+
+		ptr = mat[i];
+		for ( k = 0; k + 4 <= i; k += 4 ) {
+			_mm_store_ps( v + k, _mm_mul_ps( _mm_load_ps( diag + k ), _mm_loadu_ps( ptr + k ) ) );
+		}
+		for ( ; k < i; k++ ) {
+			v[k] = diag[k] * ptr[k];
+		}
+		sum = ptr[i] - SSE_DotProduct( v, ptr, i );
+
+		if ( sum == 0.0f ) {
+			return false;
+		}
+
+		ptr[i] = sum;
+		diag[i] = sum;
+		invDiag[i] = d = 1.0f / sum;
+
+		for ( j = i + 1; j < n; j++ ) {
+			ptr = mat[j];
+			ptr[i] = ( ptr[i] - SSE_DotProduct( ptr, v, i ) ) * d;
+		}
+	}
+
+	return true;
+}
+
+/*
+============
+SSE_Sin16
+
+  idMath::Sin16 for angles in the range [0, PI/2]
+============
+*/
+static ID_INLINE __m128 SSE_Sin16( const __m128 a ) {
+	const __m128 s = _mm_mul_ps( a, a );
+	__m128 r = _mm_add_ps( _mm_mul_ps( _mm_set1_ps( -2.39e-08f ), s ), _mm_set1_ps( 2.7526e-06f ) );
+	r = _mm_add_ps( _mm_mul_ps( r, s ), _mm_set1_ps( -1.98409e-04f ) );
+	r = _mm_add_ps( _mm_mul_ps( r, s ), _mm_set1_ps( 8.3333315e-03f ) );
+	r = _mm_add_ps( _mm_mul_ps( r, s ), _mm_set1_ps( -1.666666664e-01f ) );
+	r = _mm_add_ps( _mm_mul_ps( r, s ), _mm_set1_ps( 1.0f ) );
+	return _mm_mul_ps( a, r );
+}
+
+/*
+============
+SSE_ATan16
+
+  idMath::ATan16 for y >= 0 and x >= 0
+============
+*/
+static ID_INLINE __m128 SSE_ATan16( const __m128 y, const __m128 x ) {
+	const __m128 swap = _mm_cmpgt_ps( y, x );
+	const __m128 a = _mm_div_ps( _mm_min_ps( x, y ), _mm_max_ps( x, y ) );
+	const __m128 s = _mm_mul_ps( a, a );
+	__m128 r = _mm_add_ps( _mm_mul_ps( _mm_set1_ps( 0.0028662257f ), s ), _mm_set1_ps( -0.0161657367f ) );
+	r = _mm_add_ps( _mm_mul_ps( r, s ), _mm_set1_ps( 0.0429096138f ) );
+	r = _mm_add_ps( _mm_mul_ps( r, s ), _mm_set1_ps( -0.0752896400f ) );
+	r = _mm_add_ps( _mm_mul_ps( r, s ), _mm_set1_ps( 0.1065626393f ) );
+	r = _mm_add_ps( _mm_mul_ps( r, s ), _mm_set1_ps( -0.1420889944f ) );
+	r = _mm_add_ps( _mm_mul_ps( r, s ), _mm_set1_ps( 0.1999355085f ) );
+	r = _mm_add_ps( _mm_mul_ps( r, s ), _mm_set1_ps( -0.3333314528f ) );
+	r = _mm_add_ps( _mm_mul_ps( r, s ), _mm_set1_ps( 1.0f ) );
+	r = _mm_mul_ps( r, a );
+	return _mm_or_ps( _mm_and_ps( swap, _mm_sub_ps( _mm_set1_ps( idMath::HALF_PI ), r ) ), _mm_andnot_ps( swap, r ) );
+}
+
+/*
+============
+SSE_RSqrt
+
+  reciprocal square root with one Newton-Raphson step, zero maps to a huge number instead of infinity
+============
+*/
+static ID_INLINE __m128 SSE_RSqrt( const __m128 x ) {
+	const __m128 c = _mm_max_ps( x, _mm_set1_ps( 1e-30f ) );
+	const __m128 r = _mm_rsqrt_ps( c );
+	const __m128 h = _mm_mul_ps( _mm_mul_ps( c, _mm_set1_ps( 0.5f ) ), r );
+	return _mm_mul_ps( r, _mm_sub_ps( _mm_set1_ps( 1.5f ), _mm_mul_ps( h, r ) ) );
+}
+
+/*
+============
+idSIMD_SSE::BlendJoints
+
+  slerps four joints at a time with the same approximations idQuat::Slerp uses
+============
+*/
+void VPCALL idSIMD_SSE::BlendJoints( idJointQuat *joints, const idJointQuat *blendJoints, const float lerp, const int *index, const int numJoints ) {
+	int i, j, k;
+
+	if ( lerp <= 0.0f ) {
+		return;
+	} else if ( lerp >= 1.0f ) {
+		for ( i = 0; i < numJoints; i++ ) {
+			j = index[i];
+			joints[j] = blendJoints[j];
+		}
+		return;
+	}
+
+	const __m128 t = _mm_set1_ps( lerp );
+	const __m128 invT = _mm_set1_ps( 1.0f - lerp );
+	const __m128 one = _mm_set1_ps( 1.0f );
+	const __m128 signBit = _mm_set1_ps( -0.0f );
+	const __m128 epsilon = _mm_set1_ps( 1e-6f );
+	int jointIndex[4];
+
+	for ( i = 0; i < numJoints; i += 4 ) {
+		const int numLanes = Min( 4, numJoints - i );
+
+		// repeat the last joint in the unused lanes
+		for ( k = 0; k < 4; k++ ) {
+			jointIndex[k] = index[i + Min( k, numLanes - 1 )];
+		}
+
+		__m128 fx, fy, fz, fw, tx, ty, tz, tw;
+		fx = _mm_loadu_ps( joints[jointIndex[0]].q.ToFloatPtr() );
+		fy = _mm_loadu_ps( joints[jointIndex[1]].q.ToFloatPtr() );
+		fz = _mm_loadu_ps( joints[jointIndex[2]].q.ToFloatPtr() );
+		fw = _mm_loadu_ps( joints[jointIndex[3]].q.ToFloatPtr() );
+		_MM_TRANSPOSE4_PS( fx, fy, fz, fw );
+		tx = _mm_loadu_ps( blendJoints[jointIndex[0]].q.ToFloatPtr() );
+		ty = _mm_loadu_ps( blendJoints[jointIndex[1]].q.ToFloatPtr() );
+		tz = _mm_loadu_ps( blendJoints[jointIndex[2]].q.ToFloatPtr() );
+		tw = _mm_loadu_ps( blendJoints[jointIndex[3]].q.ToFloatPtr() );
+		_MM_TRANSPOSE4_PS( tx, ty, tz, tw );
+
+		__m128 cosom = _mm_add_ps( _mm_add_ps( _mm_mul_ps( fx, tx ), _mm_mul_ps( fy, ty ) ), _mm_add_ps( _mm_mul_ps( fz, tz ), _mm_mul_ps( fw, tw ) ) );
+
+		// take the shortest path
+		const __m128 sign = _mm_and_ps( cosom, signBit );
+		tx = _mm_xor_ps( tx, sign );
+		ty = _mm_xor_ps( ty, sign );
+		tz = _mm_xor_ps( tz, sign );
+		tw = _mm_xor_ps( tw, sign );
+		cosom = _mm_xor_ps( cosom, sign );
+
+		__m128 scale0 = _mm_sub_ps( one, _mm_mul_ps( cosom, cosom ) );
+		const __m128 sinom = SSE_RSqrt( scale0 );
+		const __m128 omega = SSE_ATan16( _mm_mul_ps( scale0, sinom ), cosom );
+		scale0 = _mm_mul_ps( SSE_Sin16( _mm_mul_ps( invT, omega ) ), sinom );
+		__m128 scale1 = _mm_mul_ps( SSE_Sin16( _mm_mul_ps( t, omega ) ), sinom );
+
+		// linear interpolation when the quaternions are very close
+		const __m128 slerp = _mm_cmpgt_ps( _mm_sub_ps( one, cosom ), epsilon );
+		scale0 = _mm_or_ps( _mm_and_ps( slerp, scale0 ), _mm_andnot_ps( slerp, invT ) );
+		scale1 = _mm_or_ps( _mm_and_ps( slerp, scale1 ), _mm_andnot_ps( slerp, t ) );
+
+		__m128 qx = _mm_add_ps( _mm_mul_ps( scale0, fx ), _mm_mul_ps( scale1, tx ) );
+		__m128 qy = _mm_add_ps( _mm_mul_ps( scale0, fy ), _mm_mul_ps( scale1, ty ) );
+		__m128 qz = _mm_add_ps( _mm_mul_ps( scale0, fz ), _mm_mul_ps( scale1, tz ) );
+		__m128 qw = _mm_add_ps( _mm_mul_ps( scale0, fw ), _mm_mul_ps( scale1, tw ) );
+		_MM_TRANSPOSE4_PS( qx, qy, qz, qw );
+
+		switch( numLanes ) {
+			case 4: _mm_storeu_ps( joints[jointIndex[3]].q.ToFloatPtr(), qw );
+			case 3: _mm_storeu_ps( joints[jointIndex[2]].q.ToFloatPtr(), qz );
+			case 2: _mm_storeu_ps( joints[jointIndex[1]].q.ToFloatPtr(), qy );
+			case 1: _mm_storeu_ps( joints[jointIndex[0]].q.ToFloatPtr(), qx );
+		}
+
+		for ( k = 0; k < numLanes; k++ ) {
+			idVec3 &from = joints[jointIndex[k]].t;
+			const idVec3 &to = blendJoints[jointIndex[k]].t;
+			from[0] += lerp * ( to[0] - from[0] );
+			from[1] += lerp * ( to[1] - from[1] );
+			from[2] += lerp * ( to[2] - from[2] );
+		}
+	}
+}
+
+/*
+============
+idSIMD_SSE::ConvertJointQuatsToJointMats
+
+  four joints at a time with the same operations as idQuat::ToMat3
+============
+*/
+void VPCALL idSIMD_SSE::ConvertJointQuatsToJointMats( idJointMat *jointMats, const idJointQuat *jointQuats, const int numJoints ) {
+	const __m128 one = _mm_set1_ps( 1.0f );
+	int i;
+
+	for ( i = 0; i + 4 <= numJoints; i += 4 ) {
+		const idJointQuat *jq = jointQuats + i;
+		__m128 x, y, z, w;
+
+		x = _mm_loadu_ps( jq[0].q.ToFloatPtr() );
+		y = _mm_loadu_ps( jq[1].q.ToFloatPtr() );
+		z = _mm_loadu_ps( jq[2].q.ToFloatPtr() );
+		w = _mm_loadu_ps( jq[3].q.ToFloatPtr() );
+		_MM_TRANSPOSE4_PS( x, y, z, w );
+
+		const __m128 x2 = _mm_add_ps( x, x );
+		const __m128 y2 = _mm_add_ps( y, y );
+		const __m128 z2 = _mm_add_ps( z, z );
+
+		const __m128 xx = _mm_mul_ps( x, x2 );
+		const __m128 xy = _mm_mul_ps( x, y2 );
+		const __m128 xz = _mm_mul_ps( x, z2 );
+		const __m128 yy = _mm_mul_ps( y, y2 );
+		const __m128 yz = _mm_mul_ps( y, z2 );
+		const __m128 zz = _mm_mul_ps( z, z2 );
+		const __m128 wx = _mm_mul_ps( w, x2 );
+		const __m128 wy = _mm_mul_ps( w, y2 );
+		const __m128 wz = _mm_mul_ps( w, z2 );
+
+		// idJointMat stores the transpose of idMat3
+		__m128 r0c0 = _mm_sub_ps( one, _mm_add_ps( yy, zz ) );
+		__m128 r0c1 = _mm_add_ps( xy, wz );
+		__m128 r0c2 = _mm_sub_ps( xz, wy );
+		__m128 r0c3 = _mm_setr_ps( jq[0].t[0], jq[1].t[0], jq[2].t[0], jq[3].t[0] );
+
+		__m128 r1c0 = _mm_sub_ps( xy, wz );
+		__m128 r1c1 = _mm_sub_ps( one, _mm_add_ps( xx, zz ) );
+		__m128 r1c2 = _mm_add_ps( yz, wx );
+		__m128 r1c3 = _mm_setr_ps( jq[0].t[1], jq[1].t[1], jq[2].t[1], jq[3].t[1] );
+
+		__m128 r2c0 = _mm_add_ps( xz, wy );
+		__m128 r2c1 = _mm_sub_ps( yz, wx );
+		__m128 r2c2 = _mm_sub_ps( one, _mm_add_ps( xx, yy ) );
+		__m128 r2c3 = _mm_setr_ps( jq[0].t[2], jq[1].t[2], jq[2].t[2], jq[3].t[2] );
+
+		_MM_TRANSPOSE4_PS( r0c0, r0c1, r0c2, r0c3 );
+		_MM_TRANSPOSE4_PS( r1c0, r1c1, r1c2, r1c3 );
+		_MM_TRANSPOSE4_PS( r2c0, r2c1, r2c2, r2c3 );
+
+		float *m = jointMats[i].ToFloatPtr();
+		_mm_storeu_ps( m + 0 * 12 + 0, r0c0 );
+		_mm_storeu_ps( m + 0 * 12 + 4, r1c0 );
+		_mm_storeu_ps( m + 0 * 12 + 8, r2c0 );
+		_mm_storeu_ps( m + 1 * 12 + 0, r0c1 );
+		_mm_storeu_ps( m + 1 * 12 + 4, r1c1 );
+		_mm_storeu_ps( m + 1 * 12 + 8, r2c1 );
+		_mm_storeu_ps( m + 2 * 12 + 0, r0c2 );
+		_mm_storeu_ps( m + 2 * 12 + 4, r1c2 );
+		_mm_storeu_ps( m + 2 * 12 + 8, r2c2 );
+		_mm_storeu_ps( m + 3 * 12 + 0, r0c3 );
+		_mm_storeu_ps( m + 3 * 12 + 4, r1c3 );
+		_mm_storeu_ps( m + 3 * 12 + 8, r2c3 );
+	}
+	for ( ; i < numJoints; i++ ) {
+		jointMats[i].SetRotation( jointQuats[i].q.ToMat3() );
+		jointMats[i].SetTranslation( jointQuats[i].t );
+	}
+}
+
+/*
+============
+idSIMD_SSE::ConvertJointMatsToJointQuats
+
+  four joints at a time, all cases of idJointMat::ToJointQuat are calculated and
+  the lanes select the one the generic code would have branched to
+============
+*/
+void VPCALL idSIMD_SSE::ConvertJointMatsToJointQuats( idJointQuat *jointQuats, const idJointMat *jointMats, const int numJoints ) {
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps( 1.0f );
+	const __m128 half = _mm_set1_ps( 0.5f );
+	int i;
+
+	for ( i = 0; i + 4 <= numJoints; i += 4 ) {
+		const float *m = jointMats[i].ToFloatPtr();
+		__m128 m00, m01, m02, m03, m10, m11, m12, m13, m20, m21, m22, m23;
+
+		m00 = _mm_loadu_ps( m + 0 * 12 + 0 );
+		m01 = _mm_loadu_ps( m + 1 * 12 + 0 );
+		m02 = _mm_loadu_ps( m + 2 * 12 + 0 );
+		m03 = _mm_loadu_ps( m + 3 * 12 + 0 );
+		_MM_TRANSPOSE4_PS( m00, m01, m02, m03 );
+		m10 = _mm_loadu_ps( m + 0 * 12 + 4 );
+		m11 = _mm_loadu_ps( m + 1 * 12 + 4 );
+		m12 = _mm_loadu_ps( m + 2 * 12 + 4 );
+		m13 = _mm_loadu_ps( m + 3 * 12 + 4 );
+		_MM_TRANSPOSE4_PS( m10, m11, m12, m13 );
+		m20 = _mm_loadu_ps( m + 0 * 12 + 8 );
+		m21 = _mm_loadu_ps( m + 1 * 12 + 8 );
+		m22 = _mm_loadu_ps( m + 2 * 12 + 8 );
+		m23 = _mm_loadu_ps( m + 3 * 12 + 8 );
+		_MM_TRANSPOSE4_PS( m20, m21, m22, m23 );
+
+		// select the case
+		const __m128 selTrace = _mm_cmpgt_ps( _mm_add_ps( _mm_add_ps( m00, m11 ), m22 ), zero );
+		const __m128 sel1 = _mm_cmpgt_ps( m11, m00 );
+		const __m128 sel2 = _mm_andnot_ps( selTrace, _mm_cmpgt_ps( m22, _mm_max_ps( m00, m11 ) ) );
+		const __m128 sel0 = _mm_andnot_ps( _mm_or_ps( selTrace, _mm_or_ps( sel1, sel2 ) ), _mm_cmpeq_ps( zero, zero ) );
+		const __m128 sel1Only = _mm_andnot_ps( _mm_or_ps( selTrace, sel2 ), sel1 );
+
+		const __m128 tTrace = _mm_add_ps( _mm_add_ps( _mm_add_ps( m00, m11 ), m22 ), one );
+		const __m128 t0 = _mm_add_ps( _mm_sub_ps( m00, _mm_add_ps( m11, m22 ) ), one );
+		const __m128 t1 = _mm_add_ps( _mm_sub_ps( m11, _mm_add_ps( m22, m00 ) ), one );
+		const __m128 t2 = _mm_add_ps( _mm_sub_ps( m22, _mm_add_ps( m00, m11 ) ), one );
+		const __m128 t = _mm_or_ps( _mm_or_ps( _mm_and_ps( selTrace, tTrace ), _mm_and_ps( sel0, t0 ) ),
+									_mm_or_ps( _mm_and_ps( sel1Only, t1 ), _mm_and_ps( sel2, t2 ) ) );
+		const __m128 s = _mm_mul_ps( SSE_RSqrt( t ), half );
+		const __m128 st = _mm_mul_ps( s, t );
+
+		const __m128 d0 = _mm_mul_ps( _mm_sub_ps( m12, m21 ), s );
+		const __m128 d1 = _mm_mul_ps( _mm_sub_ps( m20, m02 ), s );
+		const __m128 d2 = _mm_mul_ps( _mm_sub_ps( m01, m10 ), s );
+		const __m128 a01 = _mm_mul_ps( _mm_add_ps( m01, m10 ), s );
+		const __m128 a02 = _mm_mul_ps( _mm_add_ps( m02, m20 ), s );
+		const __m128 a12 = _mm_mul_ps( _mm_add_ps( m12, m21 ), s );
+
+		__m128 qx = _mm_or_ps( _mm_or_ps( _mm_and_ps( selTrace, d0 ), _mm_and_ps( sel0, st ) ),
+								_mm_or_ps( _mm_and_ps( sel1Only, a01 ), _mm_and_ps( sel2, a02 ) ) );
+		__m128 qy = _mm_or_ps( _mm_or_ps( _mm_and_ps( selTrace, d1 ), _mm_and_ps( sel0, a01 ) ),
+								_mm_or_ps( _mm_and_ps( sel1Only, st ), _mm_and_ps( sel2, a12 ) ) );
+		__m128 qz = _mm_or_ps( _mm_or_ps( _mm_and_ps( selTrace, d2 ), _mm_and_ps( sel0, a02 ) ),
+								_mm_or_ps( _mm_and_ps( sel1Only, a12 ), _mm_and_ps( sel2, st ) ) );
+		__m128 qw = _mm_or_ps( _mm_or_ps( _mm_and_ps( selTrace, st ), _mm_and_ps( sel0, d0 ) ),
+								_mm_or_ps( _mm_and_ps( sel1Only, d1 ), _mm_and_ps( sel2, d2 ) ) );
+		_MM_TRANSPOSE4_PS( qx, qy, qz, qw );
+
+		idJointQuat *jq = jointQuats + i;
+		_mm_storeu_ps( jq[0].q.ToFloatPtr(), qx );
+		_mm_storeu_ps( jq[1].q.ToFloatPtr(), qy );
+		_mm_storeu_ps( jq[2].q.ToFloatPtr(), qz );
+		_mm_storeu_ps( jq[3].q.ToFloatPtr(), qw );
+
+		for ( int k = 0; k < 4; k++ ) {
+			jq[k].t[0] = m[k * 12 + 0 * 4 + 3];
+			jq[k].t[1] = m[k * 12 + 1 * 4 + 3];
+			jq[k].t[2] = m[k * 12 + 2 * 4 + 3];
+		}
+	}
+	for ( ; i < numJoints; i++ ) {
+		jointQuats[i] = jointMats[i].ToJointQuat();
+	}
+}
+
+/*
+============
+idSIMD_SSE::TransformJoints
+
+  the rows are multiplied and added in the same order as idJointMat::operator*=
+============
+*/
+void VPCALL idSIMD_SSE::TransformJoints( idJointMat *jointMats, const int *parents, const int firstJoint, const int lastJoint ) {
+	const __m128 translationMask = _mm_castsi128_ps( _mm_setr_epi32( 0, 0, 0, -1 ) );
+
+	for ( int i = firstJoint; i <= lastJoint; i++ ) {
+		assert( parents[i] < i );
+		float *m = jointMats[i].ToFloatPtr();
+		const float *a = jointMats[parents[i]].ToFloatPtr();
+
+		const __m128 m0 = _mm_loadu_ps( m + 0 );
+		const __m128 m1 = _mm_loadu_ps( m + 4 );
+		const __m128 m2 = _mm_loadu_ps( m + 8 );
+
+		for ( int r = 0; r < 3; r++ ) {
+			const float *ar = a + r * 4;
+			__m128 d = _mm_add_ps( _mm_mul_ps( m0, _mm_set1_ps( ar[0] ) ), _mm_mul_ps( m1, _mm_set1_ps( ar[1] ) ) );
+			d = _mm_add_ps( d, _mm_mul_ps( m2, _mm_set1_ps( ar[2] ) ) );
+			d = _mm_add_ps( d, _mm_and_ps( _mm_loadu_ps( ar ), translationMask ) );
+			_mm_storeu_ps( m + r * 4, d );
+		}
+	}
+}
+
+/*
+============
+idSIMD_SSE::UntransformJoints
+
+  the rows are multiplied and added in the same order as idJointMat::operator/=
+============
+*/
+void VPCALL idSIMD_SSE::UntransformJoints( idJointMat *jointMats, const int *parents, const int firstJoint, const int lastJoint ) {
+	const __m128 translationMask = _mm_castsi128_ps( _mm_setr_epi32( 0, 0, 0, -1 ) );
+
+	for ( int i = lastJoint; i >= firstJoint; i-- ) {
+		assert( parents[i] < i );
+		float *m = jointMats[i].ToFloatPtr();
+		const float *a = jointMats[parents[i]].ToFloatPtr();
+
+		const __m128 a0 = _mm_loadu_ps( a + 0 );
+		const __m128 a1 = _mm_loadu_ps( a + 4 );
+		const __m128 a2 = _mm_loadu_ps( a + 8 );
+		const __m128 m0 = _mm_sub_ps( _mm_loadu_ps( m + 0 ), _mm_and_ps( a0, translationMask ) );
+		const __m128 m1 = _mm_sub_ps( _mm_loadu_ps( m + 4 ), _mm_and_ps( a1, translationMask ) );
+		const __m128 m2 = _mm_sub_ps( _mm_loadu_ps( m + 8 ), _mm_and_ps( a2, translationMask ) );
+
+		for ( int r = 0; r < 3; r++ ) {
+			__m128 d = _mm_add_ps( _mm_mul_ps( m0, _mm_set1_ps( a[0 * 4 + r] ) ), _mm_mul_ps( m1, _mm_set1_ps( a[1 * 4 + r] ) ) );
+			d = _mm_add_ps( d, _mm_mul_ps( m2, _mm_set1_ps( a[2 * 4 + r] ) ) );
+			_mm_storeu_ps( m + r * 4, d );
+		}
+	}
+}
+
+/*
+============
+idSIMD_SSE::TransformVerts
+============
+*/
+void VPCALL idSIMD_SSE::TransformVerts( idDrawVert *verts, const int numVerts, const idJointMat *joints, const idVec4 *weights, const int *index, const int /*numWeights*/ ) {
+	const byte *jointsPtr = (const byte *)joints;
+	int i, j;
+
+	for ( j = i = 0; i < numVerts; i++ ) {
+		__m128 acc0 = _mm_setzero_ps();
+		__m128 acc1 = _mm_setzero_ps();
+		__m128 acc2 = _mm_setzero_ps();
+
+		do {
+			const float *m = ( (const idJointMat *)( jointsPtr + index[j*2+0] ) )->ToFloatPtr();
+			const __m128 w = _mm_loadu_ps( weights[j].ToFloatPtr() );
+			acc0 = _mm_add_ps( acc0, _mm_mul_ps( _mm_loadu_ps( m + 0 ), w ) );
+			acc1 = _mm_add_ps( acc1, _mm_mul_ps( _mm_loadu_ps( m + 4 ), w ) );
+			acc2 = _mm_add_ps( acc2, _mm_mul_ps( _mm_loadu_ps( m + 8 ), w ) );
+		} while( index[j++*2+1] == 0 );
+
+		const __m128 xyz = SSE_HorizontalAdd( acc0, acc1, acc2, _mm_setzero_ps() );
+
+		float *dst = verts[i].xyz.ToFloatPtr();
+		_mm_storel_pi( (__m64 *)dst, xyz );
+		_mm_store_ss( dst + 2, _mm_movehl_ps( xyz, xyz ) );
+	}
+}
+
+/*
+============
+SSE_SignBits
+
+  returns the float sign bits as integers shifted to the given bit
+============
+*/
+static ID_INLINE __m128i SSE_SignBits( const __m128 v, const int bit ) {
+	return _mm_slli_epi32( _mm_srli_epi32( _mm_castps_si128( v ), 31 ), bit );
+}
+
+/*
+============
+SSE_StoreBytes
+
+  stores the low bytes of the four integers
+============
+*/
+static ID_INLINE void SSE_StoreBytes( byte *dst, const __m128i bits ) {
+	const __m128i b = _mm_packus_epi16( _mm_packs_epi32( bits, bits ), _mm_setzero_si128() );
+	*(int *)dst = _mm_cvtsi128_si32( b );
+}
+
+/*
+============
+SSE_PlaneDistance
+
+  distance of four vertices to a plane in the same order as idPlane::Distance
+============
+*/
+static ID_INLINE __m128 SSE_PlaneDistance( const idPlane &plane, const __m128 x, const __m128 y, const __m128 z ) {
+	__m128 d = _mm_add_ps( _mm_mul_ps( _mm_set1_ps( plane[0] ), x ), _mm_mul_ps( _mm_set1_ps( plane[1] ), y ) );
+	d = _mm_add_ps( d, _mm_mul_ps( _mm_set1_ps( plane[2] ), z ) );
+	return _mm_add_ps( d, _mm_set1_ps( plane[3] ) );
+}
+
+#define DRAWVERT_FLOATS		( (int)( sizeof( idDrawVert ) / sizeof( float ) ) )
+
+/*
+============
+idSIMD_SSE::TracePointCull
+============
+*/
+void VPCALL idSIMD_SSE::TracePointCull( byte *cullBits, byte &totalOr, const float radius, const idPlane *planes, const idDrawVert *verts, const int numVerts ) {
+	const __m128 r = _mm_set1_ps( radius );
+	__m128i vOr = _mm_setzero_si128();
+	int i;
+
+	for ( i = 0; i + 4 <= numVerts; i += 4 ) {
+		__m128 x, y, z, w;
+		SSE_LoadVec4x4( verts[i].xyz.ToFloatPtr(), DRAWVERT_FLOATS, x, y, z, w );
+
+		__m128i bits = _mm_set1_epi32( 0x0F );		// flip lower four bits
+		for ( int p = 0; p < 4; p++ ) {
+			const __m128 d = SSE_PlaneDistance( planes[p], x, y, z );
+			bits = _mm_xor_si128( bits, SSE_SignBits( _mm_add_ps( d, r ), p ) );
+			bits = _mm_xor_si128( bits, SSE_SignBits( _mm_sub_ps( d, r ), p + 4 ) );
+		}
+
+		vOr = _mm_or_si128( vOr, bits );
+		SSE_StoreBytes( cullBits + i, bits );
+	}
+	vOr = _mm_or_si128( vOr, _mm_shuffle_epi32( vOr, R_SHUFFLEPS( 2, 3, 0, 1 ) ) );
+	vOr = _mm_or_si128( vOr, _mm_shuffle_epi32( vOr, R_SHUFFLEPS( 1, 0, 3, 2 ) ) );
+	byte tOr = (byte) _mm_cvtsi128_si32( vOr );
+
+	if ( i < numVerts ) {
+		byte tailOr;
+		idSIMD_Generic::TracePointCull( cullBits + i, tailOr, radius, planes, verts + i, numVerts - i );
+		tOr |= tailOr;
+	}
+
+	totalOr = tOr;
+}
+
+/*
+============
+idSIMD_SSE::DecalPointCull
+============
+*/
+void VPCALL idSIMD_SSE::DecalPointCull( byte *cullBits, const idPlane *planes, const idDrawVert *verts, const int numVerts ) {
+	int i;
+
+	for ( i = 0; i + 4 <= numVerts; i += 4 ) {
+		__m128 x, y, z, w;
+		SSE_LoadVec4x4( verts[i].xyz.ToFloatPtr(), DRAWVERT_FLOATS, x, y, z, w );
+
+		__m128i bits = _mm_set1_epi32( 0x3F );		// flip lower 6 bits
+		for ( int p = 0; p < 6; p++ ) {
+			bits = _mm_xor_si128( bits, SSE_SignBits( SSE_PlaneDistance( planes[p], x, y, z ), p ) );
+		}
+
+		SSE_StoreBytes( cullBits + i, bits );
+	}
+	if ( i < numVerts ) {
+		idSIMD_Generic::DecalPointCull( cullBits + i, planes, verts + i, numVerts - i );
+	}
+}
+
+/*
+============
+idSIMD_SSE::OverlayPointCull
+============
+*/
+void VPCALL idSIMD_SSE::OverlayPointCull( byte *cullBits, idVec2 *texCoords, const idPlane *planes, const idDrawVert *verts, const int numVerts ) {
+	const __m128 one = _mm_set1_ps( 1.0f );
+	int i;
+
+	for ( i = 0; i + 4 <= numVerts; i += 4 ) {
+		__m128 x, y, z, w;
+		SSE_LoadVec4x4( verts[i].xyz.ToFloatPtr(), DRAWVERT_FLOATS, x, y, z, w );
+
+		const __m128 d0 = SSE_PlaneDistance( planes[0], x, y, z );
+		const __m128 d1 = SSE_PlaneDistance( planes[1], x, y, z );
+
+		_mm_storeu_ps( texCoords[i+0].ToFloatPtr(), _mm_unpacklo_ps( d0, d1 ) );
+		_mm_storeu_ps( texCoords[i+2].ToFloatPtr(), _mm_unpackhi_ps( d0, d1 ) );
+
+		__m128i bits = SSE_SignBits( d0, 0 );
+		bits = _mm_or_si128( bits, SSE_SignBits( d1, 1 ) );
+		bits = _mm_or_si128( bits, SSE_SignBits( _mm_sub_ps( one, d0 ), 2 ) );
+		bits = _mm_or_si128( bits, SSE_SignBits( _mm_sub_ps( one, d1 ), 3 ) );
+
+		SSE_StoreBytes( cullBits + i, bits );
+	}
+	if ( i < numVerts ) {
+		idSIMD_Generic::OverlayPointCull( cullBits + i, texCoords + i, planes, verts + i, numVerts - i );
+	}
+}
+
+/*
+============
+SSE_LoadTriangleXYZ
+
+  loads the positions of one corner of four triangles
+============
+*/
+static ID_INLINE void SSE_LoadTriangleXYZ( const idDrawVert *verts, const int *indexes, const int corner, __m128 &x, __m128 &y, __m128 &z, __m128 &s ) {
+	x = _mm_loadu_ps( verts[indexes[0 * 3 + corner]].xyz.ToFloatPtr() );
+	y = _mm_loadu_ps( verts[indexes[1 * 3 + corner]].xyz.ToFloatPtr() );
+	z = _mm_loadu_ps( verts[indexes[2 * 3 + corner]].xyz.ToFloatPtr() );
+	s = _mm_loadu_ps( verts[indexes[3 * 3 + corner]].xyz.ToFloatPtr() );
+	_MM_TRANSPOSE4_PS( x, y, z, s );
+}
+
+/*
+============
+idSIMD_SSE::DeriveTriPlanes
+
+	Derives a plane equation for each triangle, four triangles at a time.
+============
+*/
+void VPCALL idSIMD_SSE::DeriveTriPlanes( idPlane *planes, const idDrawVert *verts, const int numVerts, const int *indexes, const int numIndexes ) {
+	const int numTris = numIndexes / 3;
+	int i;
+
+	for ( i = 0; i + 4 <= numTris; i += 4 ) {
+		__m128 ax, ay, az, as, bx, by, bz, bs, cx, cy, cz, cs;
+
+		// the fourth register holds st[0] which is ignored
+		SSE_LoadTriangleXYZ( verts, indexes + i * 3, 0, ax, ay, az, as );
+		SSE_LoadTriangleXYZ( verts, indexes + i * 3, 1, bx, by, bz, bs );
+		SSE_LoadTriangleXYZ( verts, indexes + i * 3, 2, cx, cy, cz, cs );
+
+		const __m128 d0x = _mm_sub_ps( bx, ax );
+		const __m128 d0y = _mm_sub_ps( by, ay );
+		const __m128 d0z = _mm_sub_ps( bz, az );
+		const __m128 d1x = _mm_sub_ps( cx, ax );
+		const __m128 d1y = _mm_sub_ps( cy, ay );
+		const __m128 d1z = _mm_sub_ps( cz, az );
+
+		__m128 nx = _mm_sub_ps( _mm_mul_ps( d1y, d0z ), _mm_mul_ps( d1z, d0y ) );
+		__m128 ny = _mm_sub_ps( _mm_mul_ps( d1z, d0x ), _mm_mul_ps( d1x, d0z ) );
+		__m128 nz = _mm_sub_ps( _mm_mul_ps( d1x, d0y ), _mm_mul_ps( d1y, d0x ) );
+
+		const __m128 f = SSE_RSqrt( _mm_add_ps( _mm_add_ps( _mm_mul_ps( nx, nx ), _mm_mul_ps( ny, ny ) ), _mm_mul_ps( nz, nz ) ) );
+		nx = _mm_mul_ps( nx, f );
+		ny = _mm_mul_ps( ny, f );
+		nz = _mm_mul_ps( nz, f );
+
+		__m128 d = _mm_add_ps( _mm_add_ps( _mm_mul_ps( nx, ax ), _mm_mul_ps( ny, ay ) ), _mm_mul_ps( nz, az ) );
+		d = _mm_xor_ps( d, _mm_set1_ps( -0.0f ) );
+
+		_MM_TRANSPOSE4_PS( nx, ny, nz, d );
+		_mm_storeu_ps( planes[i+0].ToFloatPtr(), nx );
+		_mm_storeu_ps( planes[i+1].ToFloatPtr(), ny );
+		_mm_storeu_ps( planes[i+2].ToFloatPtr(), nz );
+		_mm_storeu_ps( planes[i+3].ToFloatPtr(), d );
+	}
+	if ( i < numTris ) {
+		idSIMD_Generic::DeriveTriPlanes( planes + i, verts, numVerts, indexes + i * 3, ( numTris - i ) * 3 );
+	}
+}
+
+/*
+============
+idSIMD_SSE::DeriveTangents
+
+	Derives the normal and orthogonal tangent vectors for the triangle vertices.
+	The plane, normal and tangents of four triangles are calculated at a time,
+	after which they are accumulated on the vertices in triangle order.
+============
+*/
+void VPCALL idSIMD_SSE::DeriveTangents( idPlane *planes, idDrawVert *verts, const int numVerts, const int *indexes, const int numIndexes ) {
+	int i, k;
+
+	bool *used = (bool *)_alloca16( numVerts * sizeof( used[0] ) );
+	memset( used, 0, numVerts * sizeof( used[0] ) );
+
+	const __m128 signBit = _mm_set1_ps( -0.0f );
+	const int numTris = numIndexes / 3;
+	ALIGN16( float result[9][4] );
+	int tri[4][3];
+
+	for ( i = 0; i < numTris; i += 4 ) {
+		const int numLanes = Min( 4, numTris - i );
+
+		// repeat the last triangle in the unused lanes
+		for ( k = 0; k < 4; k++ ) {
+			const int *t = indexes + ( i + Min( k, numLanes - 1 ) ) * 3;
+			tri[k][0] = t[0];
+			tri[k][1] = t[1];
+			tri[k][2] = t[2];
+		}
+
+		__m128 ax, ay, az, as, bx, by, bz, bs, cx, cy, cz, cs;
+		SSE_LoadTriangleXYZ( verts, tri[0], 0, ax, ay, az, as );
+		SSE_LoadTriangleXYZ( verts, tri[0], 1, bx, by, bz, bs );
+		SSE_LoadTriangleXYZ( verts, tri[0], 2, cx, cy, cz, cs );
+		const __m128 at = _mm_setr_ps( verts[tri[0][0]].st[1], verts[tri[1][0]].st[1], verts[tri[2][0]].st[1], verts[tri[3][0]].st[1] );
+		const __m128 bt = _mm_setr_ps( verts[tri[0][1]].st[1], verts[tri[1][1]].st[1], verts[tri[2][1]].st[1], verts[tri[3][1]].st[1] );
+		const __m128 ct = _mm_setr_ps( verts[tri[0][2]].st[1], verts[tri[1][2]].st[1], verts[tri[2][2]].st[1], verts[tri[3][2]].st[1] );
+
+		const __m128 d0x = _mm_sub_ps( bx, ax );
+		const __m128 d0y = _mm_sub_ps( by, ay );
+		const __m128 d0z = _mm_sub_ps( bz, az );
+		const __m128 d0s = _mm_sub_ps( bs, as );
+		const __m128 d0t = _mm_sub_ps( bt, at );
+
+		const __m128 d1x = _mm_sub_ps( cx, ax );
+		const __m128 d1y = _mm_sub_ps( cy, ay );
+		const __m128 d1z = _mm_sub_ps( cz, az );
+		const __m128 d1s = _mm_sub_ps( cs, as );
+		const __m128 d1t = _mm_sub_ps( ct, at );
+
+		// normal
+		__m128 nx = _mm_sub_ps( _mm_mul_ps( d1y, d0z ), _mm_mul_ps( d1z, d0y ) );
+		__m128 ny = _mm_sub_ps( _mm_mul_ps( d1z, d0x ), _mm_mul_ps( d1x, d0z ) );
+		__m128 nz = _mm_sub_ps( _mm_mul_ps( d1x, d0y ), _mm_mul_ps( d1y, d0x ) );
+
+		__m128 f = SSE_RSqrt( _mm_add_ps( _mm_add_ps( _mm_mul_ps( nx, nx ), _mm_mul_ps( ny, ny ) ), _mm_mul_ps( nz, nz ) ) );
+		nx = _mm_mul_ps( nx, f );
+		ny = _mm_mul_ps( ny, f );
+		nz = _mm_mul_ps( nz, f );
+
+		_mm_store_ps( result[0], nx );
+		_mm_store_ps( result[1], ny );
+		_mm_store_ps( result[2], nz );
+
+		// plane
+		__m128 pd = _mm_xor_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( nx, ax ), _mm_mul_ps( ny, ay ) ), _mm_mul_ps( nz, az ) ), signBit );
+		_MM_TRANSPOSE4_PS( nx, ny, nz, pd );
+		switch( numLanes ) {
+			case 4: _mm_storeu_ps( planes[i+3].ToFloatPtr(), pd );
+			case 3: _mm_storeu_ps( planes[i+2].ToFloatPtr(), nz );
+			case 2: _mm_storeu_ps( planes[i+1].ToFloatPtr(), ny );
+			case 1: _mm_storeu_ps( planes[i+0].ToFloatPtr(), nx );
+		}
+
+		// area sign bit
+		const __m128 areaSign = _mm_and_ps( _mm_sub_ps( _mm_mul_ps( d0s, d1t ), _mm_mul_ps( d0t, d1s ) ), signBit );
+
+		// first tangent
+		__m128 tx = _mm_sub_ps( _mm_mul_ps( d0x, d1t ), _mm_mul_ps( d0t, d1x ) );
+		__m128 ty = _mm_sub_ps( _mm_mul_ps( d0y, d1t ), _mm_mul_ps( d0t, d1y ) );
+		__m128 tz = _mm_sub_ps( _mm_mul_ps( d0z, d1t ), _mm_mul_ps( d0t, d1z ) );
+
+		f = _mm_xor_ps( SSE_RSqrt( _mm_add_ps( _mm_add_ps( _mm_mul_ps( tx, tx ), _mm_mul_ps( ty, ty ) ), _mm_mul_ps( tz, tz ) ) ), areaSign );
+		_mm_store_ps( result[3], _mm_mul_ps( tx, f ) );
+		_mm_store_ps( result[4], _mm_mul_ps( ty, f ) );
+		_mm_store_ps( result[5], _mm_mul_ps( tz, f ) );
+
+		// second tangent
+		tx = _mm_sub_ps( _mm_mul_ps( d0s, d1x ), _mm_mul_ps( d0x, d1s ) );
+		ty = _mm_sub_ps( _mm_mul_ps( d0s, d1y ), _mm_mul_ps( d0y, d1s ) );
+		tz = _mm_sub_ps( _mm_mul_ps( d0s, d1z ), _mm_mul_ps( d0z, d1s ) );
+
+		f = _mm_xor_ps( SSE_RSqrt( _mm_add_ps( _mm_add_ps( _mm_mul_ps( tx, tx ), _mm_mul_ps( ty, ty ) ), _mm_mul_ps( tz, tz ) ) ), areaSign );
+		_mm_store_ps( result[6], _mm_mul_ps( tx, f ) );
+		_mm_store_ps( result[7], _mm_mul_ps( ty, f ) );
+		_mm_store_ps( result[8], _mm_mul_ps( tz, f ) );
+
+		for ( k = 0; k < numLanes; k++ ) {
+			const idVec3 n( result[0][k], result[1][k], result[2][k] );
+			const idVec3 t0( result[3][k], result[4][k], result[5][k] );
+			const idVec3 t1( result[6][k], result[7][k], result[8][k] );
+
+			for ( int v = 0; v < 3; v++ ) {
+				const int vi = tri[k][v];
+				idDrawVert *dv = verts + vi;
+				if ( used[vi] ) {
+					dv->normal += n;
+					dv->tangents[0] += t0;
+					dv->tangents[1] += t1;
+				} else {
+					dv->normal = n;
+					dv->tangents[0] = t0;
+					dv->tangents[1] = t1;
+					used[vi] = true;
+				}
+			}
+		}
+	}
+}
+
+/*
+============
+idSIMD_SSE::DeriveUnsmoothedTangents
+
+	Derives the normal and orthogonal tangent vectors for the triangle vertices.
+	For each vertex the normal and tangent vectors are derived from a single dominant triangle.
+	Gathering the dominant triangle vertices into registers costs more than the
+	arithmetic saves so the generic code is used.
+============
+*/
+void VPCALL idSIMD_SSE::DeriveUnsmoothedTangents( idDrawVert *verts, const dominantTri_s *dominantTris, const int numVerts ) {
+	idSIMD_Generic::DeriveUnsmoothedTangents( verts, dominantTris, numVerts );
+}
+
+/*
+============
+SSE_LoadNormalTangents
+
+  loads the normal and tangents of four vertices, the registers also hold st[1]
+  and the color which are written back unchanged by SSE_StoreNormalTangents
+============
+*/
+static ID_INLINE void SSE_LoadNormalTangents( const idDrawVert *verts, __m128 r[12] ) {
+	for ( int k = 0; k < 4; k++ ) {
+		const float *v = verts[k].xyz.ToFloatPtr();
+		r[0 + k] = _mm_loadu_ps( v + 4 );		// st[1], normal
+		r[4 + k] = _mm_loadu_ps( v + 8 );		// tangents[0], tangents[1][0]
+		r[8 + k] = _mm_loadu_ps( v + 12 );		// tangents[1][1], tangents[1][2], color, padding
+	}
+	_MM_TRANSPOSE4_PS( r[0], r[1], r[2], r[3] );
+	_MM_TRANSPOSE4_PS( r[4], r[5], r[6], r[7] );
+	_MM_TRANSPOSE4_PS( r[8], r[9], r[10], r[11] );
+}
+
+/*
+============
+SSE_StoreNormalTangents
+============
+*/
+static ID_INLINE void SSE_StoreNormalTangents( idDrawVert *verts, __m128 r[12] ) {
+	_MM_TRANSPOSE4_PS( r[0], r[1], r[2], r[3] );
+	_MM_TRANSPOSE4_PS( r[4], r[5], r[6], r[7] );
+	_MM_TRANSPOSE4_PS( r[8], r[9], r[10], r[11] );
+	for ( int k = 0; k < 4; k++ ) {
+		float *v = verts[k].xyz.ToFloatPtr();
+		_mm_storeu_ps( v + 4, r[0 + k] );
+		_mm_storeu_ps( v + 8, r[4 + k] );
+		_mm_storeu_ps( v + 12, r[8 + k] );
+	}
+}
+
+/*
+============
+idSIMD_SSE::NormalizeTangents
+
+	Normalizes each vertex normal and projects and normalizes the
+	tangent vectors onto the plane orthogonal to the vertex normal.
+============
+*/
+void VPCALL idSIMD_SSE::NormalizeTangents( idDrawVert *verts, const int numVerts ) {
+	int i;
+
+	for ( i = 0; i + 4 <= numVerts; i += 4 ) {
+		__m128 r[12];
+		SSE_LoadNormalTangents( verts + i, r );
+
+		__m128 nx = r[1], ny = r[2], nz = r[3];
+		__m128 f = SSE_RSqrt( _mm_add_ps( _mm_add_ps( _mm_mul_ps( nx, nx ), _mm_mul_ps( ny, ny ) ), _mm_mul_ps( nz, nz ) ) );
+		nx = _mm_mul_ps( nx, f );
+		ny = _mm_mul_ps( ny, f );
+		nz = _mm_mul_ps( nz, f );
+		r[1] = nx;
+		r[2] = ny;
+		r[3] = nz;
+
+		// tangents[0] is in r[4..6] and tangents[1] in r[7..9]
+		for ( int j = 4; j <= 7; j += 3 ) {
+			__m128 tx = r[j+0], ty = r[j+1], tz = r[j+2];
+			const __m128 d = _mm_add_ps( _mm_add_ps( _mm_mul_ps( tx, nx ), _mm_mul_ps( ty, ny ) ), _mm_mul_ps( tz, nz ) );
+			tx = _mm_sub_ps( tx, _mm_mul_ps( d, nx ) );
+			ty = _mm_sub_ps( ty, _mm_mul_ps( d, ny ) );
+			tz = _mm_sub_ps( tz, _mm_mul_ps( d, nz ) );
+			f = SSE_RSqrt( _mm_add_ps( _mm_add_ps( _mm_mul_ps( tx, tx ), _mm_mul_ps( ty, ty ) ), _mm_mul_ps( tz, tz ) ) );
+			r[j+0] = _mm_mul_ps( tx, f );
+			r[j+1] = _mm_mul_ps( ty, f );
+			r[j+2] = _mm_mul_ps( tz, f );
+		}
+
+		SSE_StoreNormalTangents( verts + i, r );
+	}
+	if ( i < numVerts ) {
+		idSIMD_Generic::NormalizeTangents( verts + i, numVerts - i );
+	}
+}
+
+/*
+============
+idSIMD_SSE::CreateTextureSpaceLightVectors
+
+	Calculates light vectors in texture space for the given triangle vertices.
+	For each vertex the direction towards the light origin is projected onto texture space.
+	The light vectors are only calculated for the vertices referenced by the indexes.
+============
+*/
+void VPCALL idSIMD_SSE::CreateTextureSpaceLightVectors( idVec3 *lightVectors, const idVec3 &lightOrigin, const idDrawVert *verts, const int numVerts, const int *indexes, const int numIndexes ) {
+	// transposing the normal and tangents of four vertices costs more than the scalar dot products
+	idSIMD_Generic::CreateTextureSpaceLightVectors( lightVectors, lightOrigin, verts, numVerts, indexes, numIndexes );
+}
+
+/*
+============
+idSIMD_SSE::CreateSpecularTextureCoords
+
+	Calculates specular texture coordinates for the given triangle vertices.
+	For each vertex the normalized direction towards the light origin is added to the
+	normalized direction towards the view origin and the result is projected onto texture space.
+	The texture coordinates are only calculated for the vertices referenced by the indexes.
+============
+*/
+void VPCALL idSIMD_SSE::CreateSpecularTextureCoords( idVec4 *texCoords, const idVec3 &lightOrigin, const idVec3 &viewOrigin, const idDrawVert *verts, const int numVerts, const int *indexes, const int numIndexes ) {
+	int i;
+
+	bool *used = (bool *)_alloca16( numVerts * sizeof( used[0] ) );
+	memset( used, 0, numVerts * sizeof( used[0] ) );
+
+	for ( i = numIndexes - 1; i >= 0; i-- ) {
+		used[indexes[i]] = true;
+	}
+
+	const __m128 lx = _mm_set1_ps( lightOrigin[0] );
+	const __m128 ly = _mm_set1_ps( lightOrigin[1] );
+	const __m128 lz = _mm_set1_ps( lightOrigin[2] );
+	const __m128 vx = _mm_set1_ps( viewOrigin[0] );
+	const __m128 vy = _mm_set1_ps( viewOrigin[1] );
+	const __m128 vz = _mm_set1_ps( viewOrigin[2] );
+
+	for ( i = 0; i + 4 <= numVerts; i += 4 ) {
+		if ( !( used[i+0] | used[i+1] | used[i+2] | used[i+3] ) ) {
+			continue;
+		}
+
+		__m128 x, y, z, s, r[12];
+		SSE_LoadVec4x4( verts[i].xyz.ToFloatPtr(), DRAWVERT_FLOATS, x, y, z, s );
+		SSE_LoadNormalTangents( verts + i, r );
+
+		__m128 ldx = _mm_sub_ps( lx, x );
+		__m128 ldy = _mm_sub_ps( ly, y );
+		__m128 ldz = _mm_sub_ps( lz, z );
+		__m128 f = SSE_RSqrt( _mm_add_ps( _mm_add_ps( _mm_mul_ps( ldx, ldx ), _mm_mul_ps( ldy, ldy ) ), _mm_mul_ps( ldz, ldz ) ) );
+		ldx = _mm_mul_ps( ldx, f );
+		ldy = _mm_mul_ps( ldy, f );
+		ldz = _mm_mul_ps( ldz, f );
+
+		__m128 vdx = _mm_sub_ps( vx, x );
+		__m128 vdy = _mm_sub_ps( vy, y );
+		__m128 vdz = _mm_sub_ps( vz, z );
+		f = SSE_RSqrt( _mm_add_ps( _mm_add_ps( _mm_mul_ps( vdx, vdx ), _mm_mul_ps( vdy, vdy ) ), _mm_mul_ps( vdz, vdz ) ) );
+
+		const __m128 dx = _mm_add_ps( ldx, _mm_mul_ps( vdx, f ) );
+		const __m128 dy = _mm_add_ps( ldy, _mm_mul_ps( vdy, f ) );
+		const __m128 dz = _mm_add_ps( ldz, _mm_mul_ps( vdz, f ) );
+
+		__m128 t0 = _mm_add_ps( _mm_add_ps( _mm_mul_ps( dx, r[4] ), _mm_mul_ps( dy, r[5] ) ), _mm_mul_ps( dz, r[6] ) );
+		__m128 t1 = _mm_add_ps( _mm_add_ps( _mm_mul_ps( dx, r[7] ), _mm_mul_ps( dy, r[8] ) ), _mm_mul_ps( dz, r[9] ) );
+		__m128 t2 = _mm_add_ps( _mm_add_ps( _mm_mul_ps( dx, r[1] ), _mm_mul_ps( dy, r[2] ) ), _mm_mul_ps( dz, r[3] ) );
+		__m128 t3 = _mm_set1_ps( 1.0f );
+		_MM_TRANSPOSE4_PS( t0, t1, t2, t3 );
+
+		if ( used[i+0] ) {
+			_mm_storeu_ps( texCoords[i+0].ToFloatPtr(), t0 );
+		}
+		if ( used[i+1] ) {
+			_mm_storeu_ps( texCoords[i+1].ToFloatPtr(), t1 );
+		}
+		if ( used[i+2] ) {
+			_mm_storeu_ps( texCoords[i+2].ToFloatPtr(), t2 );
+		}
+		if ( used[i+3] ) {
+			_mm_storeu_ps( texCoords[i+3].ToFloatPtr(), t3 );
+		}
+	}
+	for ( ; i < numVerts; i++ ) {
+		if ( !used[i] ) {
+			continue;
+		}
+
+		const idDrawVert *v = &verts[i];
+
+		idVec3 lightDir = lightOrigin - v->xyz;
+		idVec3 viewDir = viewOrigin - v->xyz;
+
+		lightDir *= idMath::RSqrt( lightDir * lightDir );
+		viewDir *= idMath::RSqrt( viewDir * viewDir );
+
+		lightDir += viewDir;
+
+		texCoords[i][0] = lightDir * v->tangents[0];
+		texCoords[i][1] = lightDir * v->tangents[1];
+		texCoords[i][2] = lightDir * v->normal;
+		texCoords[i][3] = 1.0f;
+	}
+}
+
+/*
+============
+idSIMD_SSE::CreateShadowCache
+============
+*/
+int VPCALL idSIMD_SSE::CreateShadowCache( idVec4 *vertexCache, int *vertRemap, const idVec3 &lightOrigin, const idDrawVert *verts, const int numVerts ) {
+	const __m128 xyzMask = _mm_castsi128_ps( _mm_setr_epi32( -1, -1, -1, 0 ) );
+	const __m128 light = _mm_setr_ps( lightOrigin[0], lightOrigin[1], lightOrigin[2], 0.0f );
+	const __m128 wOne = _mm_setr_ps( 0.0f, 0.0f, 0.0f, 1.0f );
+	int outVerts = 0;
+
+	for ( int i = 0; i < numVerts; i++ ) {
+		if ( vertRemap[i] ) {
+			continue;
+		}
+		// the fourth float is st[0] which is replaced
+		const __m128 v = _mm_loadu_ps( verts[i].xyz.ToFloatPtr() );
+		_mm_storeu_ps( vertexCache[outVerts+0].ToFloatPtr(), _mm_or_ps( _mm_and_ps( v, xyzMask ), wOne ) );
+		_mm_storeu_ps( vertexCache[outVerts+1].ToFloatPtr(), _mm_and_ps( _mm_sub_ps( v, light ), xyzMask ) );
+		vertRemap[i] = outVerts;
+		outVerts += 2;
+	}
+	return outVerts;
+}
+
+/*
+============
+idSIMD_SSE::CreateVertexProgramShadowCache
+============
+*/
+int VPCALL idSIMD_SSE::CreateVertexProgramShadowCache( idVec4 *vertexCache, const idDrawVert *verts, const int numVerts ) {
+	const __m128 xyzMask = _mm_castsi128_ps( _mm_setr_epi32( -1, -1, -1, 0 ) );
+	const __m128 wOne = _mm_setr_ps( 0.0f, 0.0f, 0.0f, 1.0f );
+
+	for ( int i = 0; i < numVerts; i++ ) {
+		const __m128 v = _mm_and_ps( _mm_loadu_ps( verts[i].xyz.ToFloatPtr() ), xyzMask );
+		_mm_storeu_ps( vertexCache[i*2+0].ToFloatPtr(), _mm_or_ps( v, wOne ) );
+		_mm_storeu_ps( vertexCache[i*2+1].ToFloatPtr(), v );
+	}
+	return numVerts * 2;
+}
+
+/*
+============
+SSE_UpSample4
+
+  writes four mono samples or two stereo sample pairs duplicated for 44kHz output
+============
+*/
+static ID_INLINE float *SSE_UpSample4( float *dest, const __m128 v, const int kHz, const int numChannels ) {
+	if ( kHz == 44100 ) {
+		_mm_storeu_ps( dest, v );
+		return dest + 4;
+	}
+	if ( numChannels == 1 ) {
+		if ( kHz == 22050 ) {
+			_mm_storeu_ps( dest + 0, _mm_unpacklo_ps( v, v ) );
+			_mm_storeu_ps( dest + 4, _mm_unpackhi_ps( v, v ) );
+			return dest + 8;
+		}
+		_mm_storeu_ps( dest + 0, _mm_shuffle_ps( v, v, R_SHUFFLEPS( 0, 0, 0, 0 ) ) );
+		_mm_storeu_ps( dest + 4, _mm_shuffle_ps( v, v, R_SHUFFLEPS( 1, 1, 1, 1 ) ) );
+		_mm_storeu_ps( dest + 8, _mm_shuffle_ps( v, v, R_SHUFFLEPS( 2, 2, 2, 2 ) ) );
+		_mm_storeu_ps( dest + 12, _mm_shuffle_ps( v, v, R_SHUFFLEPS( 3, 3, 3, 3 ) ) );
+		return dest + 16;
+	}
+	const __m128 lo = _mm_movelh_ps( v, v );
+	const __m128 hi = _mm_movehl_ps( v, v );
+	if ( kHz == 22050 ) {
+		_mm_storeu_ps( dest + 0, lo );
+		_mm_storeu_ps( dest + 4, hi );
+		return dest + 8;
+	}
+	_mm_storeu_ps( dest + 0, lo );
+	_mm_storeu_ps( dest + 4, lo );
+	_mm_storeu_ps( dest + 8, hi );
+	_mm_storeu_ps( dest + 12, hi );
+	return dest + 16;
+}
+
+/*
+============
+idSIMD_SSE::UpSamplePCMTo44kHz
+
+  Duplicate samples for 44kHz output.
+============
+*/
+void VPCALL idSIMD_SSE::UpSamplePCMTo44kHz( float *dest, const short *src, const int numSamples, const int kHz, const int numChannels ) {
+	int i;
+
+	if ( kHz != 11025 && kHz != 22050 && kHz != 44100 ) {
+		assert( 0 );
+		return;
+	}
+
+	float *d = dest;
+	for ( i = 0; i + 8 <= numSamples; i += 8 ) {
+		const __m128i s = _mm_loadu_si128( (const __m128i *)( src + i ) );
+		const __m128 lo = _mm_cvtepi32_ps( _mm_srai_epi32( _mm_unpacklo_epi16( s, s ), 16 ) );
+		const __m128 hi = _mm_cvtepi32_ps( _mm_srai_epi32( _mm_unpackhi_epi16( s, s ), 16 ) );
+		d = SSE_UpSample4( d, lo, kHz, numChannels );
+		d = SSE_UpSample4( d, hi, kHz, numChannels );
+	}
+	if ( i < numSamples ) {
+		idSIMD_Generic::UpSamplePCMTo44kHz( d, src + i, numSamples - i, kHz, numChannels );
+	}
+}
+
+/*
+============
+idSIMD_SSE::UpSampleOGGTo44kHz
+
+  Duplicate samples for 44kHz output.
+============
+*/
+void VPCALL idSIMD_SSE::UpSampleOGGTo44kHz( float *dest, const float * const *ogg, const int numSamples, const int kHz, const int numChannels ) {
+	const __m128 scale = _mm_set1_ps( 32768.0f );
+	int i;
+
+	if ( kHz != 11025 && kHz != 22050 && kHz != 44100 ) {
+		assert( 0 );
+		return;
+	}
+
+	float *d = dest;
+	if ( numChannels == 1 ) {
+		for ( i = 0; i + 4 <= numSamples; i += 4 ) {
+			d = SSE_UpSample4( d, _mm_mul_ps( _mm_loadu_ps( ogg[0] + i ), scale ), kHz, numChannels );
+		}
+		if ( i < numSamples ) {
+			const float *tail[1] = { ogg[0] + i };
+			idSIMD_Generic::UpSampleOGGTo44kHz( d, tail, numSamples - i, kHz, numChannels );
+		}
+	} else {
+		const int numPairs = numSamples >> 1;
+		for ( i = 0; i + 4 <= numPairs; i += 4 ) {
+			const __m128 l = _mm_mul_ps( _mm_loadu_ps( ogg[0] + i ), scale );
+			const __m128 r = _mm_mul_ps( _mm_loadu_ps( ogg[1] + i ), scale );
+			d = SSE_UpSample4( d, _mm_unpacklo_ps( l, r ), kHz, numChannels );
+			d = SSE_UpSample4( d, _mm_unpackhi_ps( l, r ), kHz, numChannels );
+		}
+		if ( i < numPairs ) {
+			const float *tail[2] = { ogg[0] + i, ogg[1] + i };
+			idSIMD_Generic::UpSampleOGGTo44kHz( d, tail, ( numPairs - i ) * 2, kHz, numChannels );
+		}
+	}
+}
+
+/*
+============
+idSIMD_SSE::MixSoundTwoSpeakerMono
+
+  the volume ramp is stepped for four samples at a time
+============
+*/
+void VPCALL idSIMD_SSE::MixSoundTwoSpeakerMono( float *mixBuffer, const float *samples, const int numSamples, const float lastV[2], const float currentV[2] ) {
+	const float incL = ( currentV[0] - lastV[0] ) / MIXBUFFER_SAMPLES;
+	const float incR = ( currentV[1] - lastV[1] ) / MIXBUFFER_SAMPLES;
+
+	assert( numSamples == MIXBUFFER_SAMPLES );
+
+	const __m128 inc = _mm_setr_ps( incL, incR, incL, incR );
+	const __m128 inc4 = _mm_mul_ps( inc, _mm_set1_ps( 4.0f ) );
+	__m128 v0 = _mm_add_ps( _mm_setr_ps( lastV[0], lastV[1], lastV[0], lastV[1] ), _mm_mul_ps( inc, _mm_setr_ps( 0.0f, 0.0f, 1.0f, 1.0f ) ) );
+	__m128 v1 = _mm_add_ps( v0, _mm_add_ps( inc, inc ) );
+
+	for ( int j = 0; j < MIXBUFFER_SAMPLES; j += 4 ) {
+		const __m128 s = _mm_loadu_ps( samples + j );
+		_mm_storeu_ps( mixBuffer + j*2+0, _mm_add_ps( _mm_loadu_ps( mixBuffer + j*2+0 ), _mm_mul_ps( _mm_unpacklo_ps( s, s ), v0 ) ) );
+		_mm_storeu_ps( mixBuffer + j*2+4, _mm_add_ps( _mm_loadu_ps( mixBuffer + j*2+4 ), _mm_mul_ps( _mm_unpackhi_ps( s, s ), v1 ) ) );
+		v0 = _mm_add_ps( v0, inc4 );
+		v1 = _mm_add_ps( v1, inc4 );
+	}
+}
+
+/*
+============
+idSIMD_SSE::MixSoundTwoSpeakerStereo
+============
+*/
+void VPCALL idSIMD_SSE::MixSoundTwoSpeakerStereo( float *mixBuffer, const float *samples, const int numSamples, const float lastV[2], const float currentV[2] ) {
+	const float incL = ( currentV[0] - lastV[0] ) / MIXBUFFER_SAMPLES;
+	const float incR = ( currentV[1] - lastV[1] ) / MIXBUFFER_SAMPLES;
+
+	assert( numSamples == MIXBUFFER_SAMPLES );
+
+	const __m128 inc = _mm_setr_ps( incL, incR, incL, incR );
+	const __m128 inc4 = _mm_mul_ps( inc, _mm_set1_ps( 4.0f ) );
+	__m128 v0 = _mm_add_ps( _mm_setr_ps( lastV[0], lastV[1], lastV[0], lastV[1] ), _mm_mul_ps( inc, _mm_setr_ps( 0.0f, 0.0f, 1.0f, 1.0f ) ) );
+	__m128 v1 = _mm_add_ps( v0, _mm_add_ps( inc, inc ) );
+
+	for ( int j = 0; j < MIXBUFFER_SAMPLES; j += 4 ) {
+		_mm_storeu_ps( mixBuffer + j*2+0, _mm_add_ps( _mm_loadu_ps( mixBuffer + j*2+0 ), _mm_mul_ps( _mm_loadu_ps( samples + j*2+0 ), v0 ) ) );
+		_mm_storeu_ps( mixBuffer + j*2+4, _mm_add_ps( _mm_loadu_ps( mixBuffer + j*2+4 ), _mm_mul_ps( _mm_loadu_ps( samples + j*2+4 ), v1 ) ) );
+		v0 = _mm_add_ps( v0, inc4 );
+		v1 = _mm_add_ps( v1, inc4 );
+	}
+}
+
+/*
+============
+idSIMD_SSE::MixSoundSixSpeakerMono
+
+  two samples fill three registers of the six channel mix buffer
+============
+*/
+void VPCALL idSIMD_SSE::MixSoundSixSpeakerMono( float *mixBuffer, const float *samples, const int numSamples, const float lastV[6], const float currentV[6] ) {
+	ALIGN16( float inc[8] );
+
+	assert( numSamples == MIXBUFFER_SAMPLES );
+
+	for ( int k = 0; k < 6; k++ ) {
+		inc[k] = ( currentV[k] - lastV[k] ) / MIXBUFFER_SAMPLES;
+	}
+
+	const __m128 inc0 = _mm_setr_ps( inc[0], inc[1], inc[2], inc[3] );
+	const __m128 inc1 = _mm_setr_ps( inc[4], inc[5], inc[0], inc[1] );
+	const __m128 inc2 = _mm_setr_ps( inc[2], inc[3], inc[4], inc[5] );
+	const __m128 two = _mm_set1_ps( 2.0f );
+	const __m128 step0 = _mm_mul_ps( inc0, two );
+	const __m128 step1 = _mm_mul_ps( inc1, two );
+	const __m128 step2 = _mm_mul_ps( inc2, two );
+
+	__m128 v0 = _mm_setr_ps( lastV[0], lastV[1], lastV[2], lastV[3] );
+	__m128 v1 = _mm_add_ps( _mm_setr_ps( lastV[4], lastV[5], lastV[0], lastV[1] ), _mm_and_ps( inc1, _mm_castsi128_ps( _mm_setr_epi32( 0, 0, -1, -1 ) ) ) );
+	__m128 v2 = _mm_add_ps( _mm_setr_ps( lastV[2], lastV[3], lastV[4], lastV[5] ), inc2 );
+
+	for ( int i = 0; i < MIXBUFFER_SAMPLES; i += 2 ) {
+		const __m128 s = _mm_setr_ps( samples[i+0], samples[i+0], samples[i+1], samples[i+1] );
+		float *mix = mixBuffer + i * 6;
+		_mm_storeu_ps( mix + 0, _mm_add_ps( _mm_loadu_ps( mix + 0 ), _mm_mul_ps( _mm_shuffle_ps( s, s, R_SHUFFLEPS( 0, 0, 0, 0 ) ), v0 ) ) );
+		_mm_storeu_ps( mix + 4, _mm_add_ps( _mm_loadu_ps( mix + 4 ), _mm_mul_ps( s, v1 ) ) );
+		_mm_storeu_ps( mix + 8, _mm_add_ps( _mm_loadu_ps( mix + 8 ), _mm_mul_ps( _mm_shuffle_ps( s, s, R_SHUFFLEPS( 2, 2, 2, 2 ) ), v2 ) ) );
+		v0 = _mm_add_ps( v0, step0 );
+		v1 = _mm_add_ps( v1, step1 );
+		v2 = _mm_add_ps( v2, step2 );
+	}
+}
+
+/*
+============
+idSIMD_SSE::MixSoundSixSpeakerStereo
+
+  the left channel goes to speakers 0, 2, 3 and 4 and the right channel to speakers 1 and 5
+============
+*/
+void VPCALL idSIMD_SSE::MixSoundSixSpeakerStereo( float *mixBuffer, const float *samples, const int numSamples, const float lastV[6], const float currentV[6] ) {
+	ALIGN16( float inc[8] );
+
+	assert( numSamples == MIXBUFFER_SAMPLES );
+
+	for ( int k = 0; k < 6; k++ ) {
+		inc[k] = ( currentV[k] - lastV[k] ) / MIXBUFFER_SAMPLES;
+	}
+
+	const __m128 inc0 = _mm_setr_ps( inc[0], inc[1], inc[2], inc[3] );
+	const __m128 inc1 = _mm_setr_ps( inc[4], inc[5], inc[0], inc[1] );
+	const __m128 inc2 = _mm_setr_ps( inc[2], inc[3], inc[4], inc[5] );
+	const __m128 two = _mm_set1_ps( 2.0f );
+	const __m128 step0 = _mm_mul_ps( inc0, two );
+	const __m128 step1 = _mm_mul_ps( inc1, two );
+	const __m128 step2 = _mm_mul_ps( inc2, two );
+
+	__m128 v0 = _mm_setr_ps( lastV[0], lastV[1], lastV[2], lastV[3] );
+	__m128 v1 = _mm_add_ps( _mm_setr_ps( lastV[4], lastV[5], lastV[0], lastV[1] ), _mm_and_ps( inc1, _mm_castsi128_ps( _mm_setr_epi32( 0, 0, -1, -1 ) ) ) );
+	__m128 v2 = _mm_add_ps( _mm_setr_ps( lastV[2], lastV[3], lastV[4], lastV[5] ), inc2 );
+
+	for ( int i = 0; i < MIXBUFFER_SAMPLES; i += 2 ) {
+		const __m128 s = _mm_loadu_ps( samples + i * 2 );		// l0 r0 l1 r1
+		float *mix = mixBuffer + i * 6;
+		_mm_storeu_ps( mix + 0, _mm_add_ps( _mm_loadu_ps( mix + 0 ), _mm_mul_ps( _mm_shuffle_ps( s, s, R_SHUFFLEPS( 0, 1, 0, 0 ) ), v0 ) ) );
+		_mm_storeu_ps( mix + 4, _mm_add_ps( _mm_loadu_ps( mix + 4 ), _mm_mul_ps( _mm_shuffle_ps( s, s, R_SHUFFLEPS( 0, 1, 2, 3 ) ), v1 ) ) );
+		_mm_storeu_ps( mix + 8, _mm_add_ps( _mm_loadu_ps( mix + 8 ), _mm_mul_ps( _mm_shuffle_ps( s, s, R_SHUFFLEPS( 2, 2, 2, 3 ) ), v2 ) ) );
+		v0 = _mm_add_ps( v0, step0 );
+		v1 = _mm_add_ps( v1, step1 );
+		v2 = _mm_add_ps( v2, step2 );
+	}
+}
+
+/*
+============
+idSIMD_SSE::MixedSoundToSamples
+
+  the samples are clamped before the truncating conversion so the results match the generic code
+============
+*/
+void VPCALL idSIMD_SSE::MixedSoundToSamples( short *samples, const float *mixBuffer, const int numSamples ) {
+	const __m128 minSample = _mm_set1_ps( -32768.0f );
+	const __m128 maxSample = _mm_set1_ps( 32767.0f );
+	int i;
+
+	for ( i = 0; i + 8 <= numSamples; i += 8 ) {
+		const __m128 s0 = _mm_min_ps( _mm_max_ps( _mm_loadu_ps( mixBuffer + i + 0 ), minSample ), maxSample );
+		const __m128 s1 = _mm_min_ps( _mm_max_ps( _mm_loadu_ps( mixBuffer + i + 4 ), minSample ), maxSample );
+		_mm_storeu_si128( (__m128i *)( samples + i ), _mm_packs_epi32( _mm_cvttps_epi32( s0 ), _mm_cvttps_epi32( s1 ) ) );
+	}
+	for ( ; i < numSamples; i++ ) {
+		if ( mixBuffer[i] <= -32768.0f ) {
+			samples[i] = -32768;
+		} else if ( mixBuffer[i] >= 32767.0f ) {
+			samples[i] = 32767;
+		} else {
+			samples[i] = (short) mixBuffer[i];
+		}
+	}
+}
+
 #endif /* _WIN32 */
+
+#if ( defined(_MSC_VER) && defined(_M_IX86) ) || defined(_M_X64) || defined(__x86_64__)
+
+#include <xmmintrin.h>
+
+/*
+============
+SSE_MixSoundBatch
+
+  accumulates all speakers of a 4 sample block in registers while walking the sources,
+  the volume ramp is evaluated with the same multiply and add as the generic code
+============
+*/
+template< int numSpeakers >
+static void SSE_MixSoundBatch( float *mixBuffer, const float *samples, const int sampleStride, const int numSources, const float *lastV, const float *incV, const int volumeStride ) {
+	const __m128 ramp = _mm_setr_ps( 0.0f, 1.0f, 2.0f, 3.0f );
+	__m128 acc[numSpeakers];
+
+	for ( int i = 0; i < MIXBUFFER_SAMPLES; i += 4 ) {
+		const __m128 t = _mm_add_ps( _mm_set1_ps( (float) i ), ramp );
+
+		for ( int s = 0; s < numSpeakers; s++ ) {
+			acc[s] = _mm_loadu_ps( mixBuffer + s * MIXBUFFER_SAMPLES + i );
+		}
+		const float *src = samples + i;
+		for ( int k = 0; k < numSources; k++, src += sampleStride ) {
+			const __m128 x = _mm_loadu_ps( src );
+			for ( int s = 0; s < numSpeakers; s++ ) {
+				const __m128 v = _mm_add_ps( _mm_load1_ps( lastV + s * volumeStride + k ), _mm_mul_ps( _mm_load1_ps( incV + s * numSources + k ), t ) );
+				acc[s] = _mm_add_ps( acc[s], _mm_mul_ps( x, v ) );
+			}
+		}
+		for ( int s = 0; s < numSpeakers; s++ ) {
+			_mm_storeu_ps( mixBuffer + s * MIXBUFFER_SAMPLES + i, acc[s] );
+		}
+	}
+}
+
+/*
+============
+idSIMD_SSE::MixSoundBatch
+============
+*/
+void VPCALL idSIMD_SSE::MixSoundBatch( float *mixBuffer, const float *samples, const int sampleStride, const int numSources, const float *lastV, const float *currentV, const int volumeStride, const int numSpeakers ) {
+	if ( numSpeakers != 2 && numSpeakers != 6 ) {
+		idSIMD_Generic::MixSoundBatch( mixBuffer, samples, sampleStride, numSources, lastV, currentV, volumeStride, numSpeakers );
+		return;
+	}
+
+	// the per sample volume increments are computed once for the whole block
+	float *incV = (float *) _alloca16( numSpeakers * numSources * sizeof( float ) );
+	for ( int s = 0; s < numSpeakers; s++ ) {
+		for ( int k = 0; k < numSources; k++ ) {
+			incV[s*numSources+k] = ( currentV[s*volumeStride+k] - lastV[s*volumeStride+k] ) / MIXBUFFER_SAMPLES;
+		}
+	}
+
+	if ( numSpeakers == 2 ) {
+		SSE_MixSoundBatch<2>( mixBuffer, samples, sampleStride, numSources, lastV, incV, volumeStride );
+	} else {
+		SSE_MixSoundBatch<6>( mixBuffer, samples, sampleStride, numSources, lastV, incV, volumeStride );
+	}
+}
+
+#endif
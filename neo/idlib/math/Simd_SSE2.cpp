@@ -874,4 +874,17 @@ void VPCALL idSIMD_SSE2::MixedSoundToSamples( short *samples, const float *mixBu
 	}
 }
 
+#elif defined(_M_X64) || defined(__x86_64__)
+
+/*
+============
+idSIMD_SSE2::GetName
+
+  the SSE intrinsics already use SSE2 where it helps, x86-64 always has it
+============
+*/
+const char * idSIMD_SSE2::GetName( void ) const {
+	return "MMX & SSE & SSE2";
+}
+
 #endif /* _WIN32 */
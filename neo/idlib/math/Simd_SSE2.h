@@ -51,6 +51,9 @@ public:
 
 	virtual void VPCALL MixedSoundToSamples( short *samples, const float *mixBuffer, const int numSamples );
 
+#elif defined(_M_X64) || defined(__x86_64__)
+	virtual const char * VPCALL GetName( void ) const;
+
 #endif
 };
 
@@ -364,4 +364,15 @@ void VPCALL idSIMD_SSE3::TransformVerts( idDrawVert *verts, const int numVerts,
 #endif
 }
 
+#elif defined(_M_X64) || defined(__x86_64__)
+
+/*
+============
+idSIMD_SSE3::GetName
+============
+*/
+const char * idSIMD_SSE3::GetName( void ) const {
+	return "MMX & SSE & SSE2 & SSE3";
+}
+
 #endif /* _WIN32 */
@@ -47,6 +47,9 @@ public:
 
 	virtual void VPCALL TransformVerts( idDrawVert *verts, const int numVerts, const idJointMat *joints, const idVec4 *weights, const int *index, const int numWeights );
 
+#elif defined(_M_X64) || defined(__x86_64__)
+	virtual const char * VPCALL GetName( void ) const;
+
 #endif
 };
 
@@ -41,6 +41,8 @@ idInteraction implementation
 
 // FIXME: use private allocator for srfCullInfo_t
 
+static idSysSpinLock	facePlanesLock;
+
 /*
 ================
 R_CalcInteractionFacing
@@ -63,9 +65,13 @@ void R_CalcInteractionFacing( const idRenderEntityLocal *ent, const srfTriangles
 
 	int numFaces = tri->numIndexes / 3;
 
+	// the face planes are shared by all interactions with the surface,
+	// which may be created from several job threads at the same time
+	facePlanesLock.Lock();
 	if ( !tri->facePlanes || !tri->facePlanesCalculated ) {
 		R_DeriveFacePlanes( const_cast<srfTriangles_t *>(tri) );
 	}
+	facePlanesLock.Unlock();
 
 	cullInfo.facing = (byte *) R_StaticAlloc( ( numFaces + 1 ) * sizeof( cullInfo.facing[0] ) );
 
@@ -290,7 +296,7 @@ static srfTriangles_t *R_CreateLightTris( const idRenderEntityLocal *ent,
 	bool		includeBackFaces;
 	int			faceNum;
 
-	tr.pc.c_createLightTris++;
+	Sys_InterlockedIncrement( tr.pc.c_createLightTris );
 	c_backfaced = 0;
 	c_distance = 0;
 
@@ -818,22 +824,24 @@ References tr.viewCount so lighting surfaces will only be created if the ambient
 otherwise it will be marked as deferred.
 
 The results of this are cached and valid until the light or entity change.
+
+This may be called from a job thread, so instead of calling MakeEmpty, which
+relinks the interaction, it returns false and leaves that to the caller.
 ====================
 */
-void idInteraction::CreateInteraction( const idRenderModel *model ) {
+bool idInteraction::CreateInteraction( const idRenderModel *model ) {
 	const idMaterial *	lightShader = lightDef->lightShader;
 	const idMaterial*	shader;
 	bool				interactionGenerated;
 	idBounds			bounds;
 
-	tr.pc.c_createInteractions++;
+	Sys_InterlockedIncrement( tr.pc.c_createInteractions );
 
 	bounds = model->Bounds( &entityDef->parms );
 
 	// if it doesn't contact the light frustum, none of the surfaces will
 	if ( R_CullLocalBox( bounds, entityDef->modelMatrix, 6, lightDef->frustum ) ) {
-		MakeEmpty();
-		return;
+		return false;
 	}
 
 	// use the turbo shadow path
@@ -932,9 +940,7 @@ void idInteraction::CreateInteraction( const idRenderModel *model ) {
 	}
 
 	// if none of the surfaces generated anything, don't even bother checking?
-	if ( !interactionGenerated ) {
-		MakeEmpty();
-	}
+	return interactionGenerated;
 }
 
 /*
@@ -1022,12 +1028,27 @@ instantiate the dynamic model to find out
 ==================
 */
 void idInteraction::AddActiveInteraction( void ) {
+	activeInteraction_t active;
+
+	if ( !BeginActiveInteraction( active ) ) {
+		return;
+	}
+	CreateActiveSurfaces( active );
+	LinkActiveInteraction( active );
+}
+
+/*
+==================
+idInteraction::BeginActiveInteraction
+
+Culls the interaction and instantiates the dynamic model, which
+both have to be done in the main thread.
+==================
+*/
+bool idInteraction::BeginActiveInteraction( activeInteraction_t &active ) {
 	viewLight_t *	vLight;
 	viewEntity_t *	vEntity;
 	idScreenRect	shadowScissor;
-	idScreenRect	lightScissor;
-	idVec3			localLightOrigin;
-	idVec3			localViewOrigin;
 
 	vLight = lightDef->viewLight;
 	vEntity = entityDef->viewEntity;
@@ -1050,7 +1071,7 @@ void idInteraction::AddActiveInteraction( void ) {
 		// this will also cull the case where the light origin is inside the
 		// view frustum and the entity bounds are outside the view frustum
 		if ( CullInteractionByViewFrustum( tr.viewDef->viewFrustum ) ) {
-			return;
+			return false;
 		}
 
 		// calculate the shadow scissor rectangle
@@ -1059,7 +1080,7 @@ void idInteraction::AddActiveInteraction( void ) {
 
 	// get out before making the dynamic model if the shadow scissor rectangle is empty
 	if ( shadowScissor.IsEmpty() ) {
-		return;
+		return false;
 	}
 
 	// We will need the dynamic surface created to make interactions, even if the
@@ -1067,7 +1088,7 @@ void idInteraction::AddActiveInteraction( void ) {
 	// has been generated once in the view.
 	idRenderModel *model = R_EntityDefDynamicModel( entityDef );
 	if ( model == NULL || model->NumSurfaces() <= 0 ) {
-		return;
+		return false;
 	}
 
 	// the dynamic model may have changed since we built the surface list
@@ -1076,19 +1097,81 @@ void idInteraction::AddActiveInteraction( void ) {
 	}
 	dynamicModelFrameCount = entityDef->dynamicModelFrameCount;
 
+	active.inter = this;
+	active.model = model;
+	active.shadowScissor = shadowScissor;
+
+	// calculate the scissor as the intersection of the light and model rects
+	// this is used for light triangles, but not for shadow triangles
+	active.lightScissor = vLight->scissorRect;
+	active.lightScissor.Intersect( vEntity->scissorRect );
+
 	// actually create the interaction if needed, building light and shadow surfaces as needed
-	if ( IsDeferred() ) {
-		CreateInteraction( model );
+	active.create = IsDeferred();
+	active.makeEmpty = false;
+
+	return true;
+}
+
+/*
+==================
+idInteraction::CreateActiveSurfaces
+
+Builds the light and shadow surfaces.  Each interaction only writes to
+its own surfaces, so different interactions can be created in parallel.
+==================
+*/
+void idInteraction::CreateActiveSurfaces( activeInteraction_t &active ) {
+	if ( active.create ) {
+		if ( !CreateInteraction( active.model ) ) {
+			active.makeEmpty = true;
+			return;
+		}
+	}
+
+	if ( active.lightScissor.IsEmpty() ) {
+		return;
 	}
 
+	for ( int i = 0; i < numSurfaces; i++ ) {
+		surfaceInteraction_t *sint = &surfaces[i];
+
+		// make sure we have created this interaction, which may have been deferred
+		// on a previous use that only needed the shadow
+		if ( sint->lightTris == LIGHT_TRIS_DEFERRED && sint->ambientTris && sint->ambientTris->ambientViewCount == tr.viewCount ) {
+			sint->lightTris = R_CreateLightTris( entityDef, sint->ambientTris, lightDef, sint->shader, sint->cullInfo );
+			R_FreeInteractionCullInfo( sint->cullInfo );
+		}
+	}
+}
+
+/*
+==================
+idInteraction::LinkActiveInteraction
+
+Adds the surfaces to the view light lists and the vertex cache.
+==================
+*/
+void idInteraction::LinkActiveInteraction( const activeInteraction_t &active ) {
+	viewLight_t *	vLight;
+	viewEntity_t *	vEntity;
+	idVec3			localLightOrigin;
+	idVec3			localViewOrigin;
+
+	if ( active.makeEmpty ) {
+		MakeEmpty();
+		return;
+	}
+
+	vLight = lightDef->viewLight;
+	vEntity = entityDef->viewEntity;
+
+	const idScreenRect &shadowScissor = active.shadowScissor;
+	const idScreenRect &lightScissor = active.lightScissor;
+
 	R_GlobalPointToLocal( vEntity->modelMatrix, lightDef->globalLightOrigin, localLightOrigin );
 	R_GlobalPointToLocal( vEntity->modelMatrix, tr.viewDef->renderView.vieworg, localViewOrigin );
 
-	// calculate the scissor as the intersection of the light and model rects
-	// this is used for light triangles, but not for shadow triangles
-	lightScissor = vLight->scissorRect;
-	lightScissor.Intersect( vEntity->scissorRect );
-
 	bool lightScissorsEmpty = lightScissor.IsEmpty();
 
 	// for each surface of this entity / light interaction
@@ -1098,13 +1181,7 @@ void idInteraction::AddActiveInteraction( void ) {
 		// see if the base surface is visible, we may still need to add shadows even if empty
 		if ( !lightScissorsEmpty && sint->ambientTris && sint->ambientTris->ambientViewCount == tr.viewCount ) {
 
-			// make sure we have created this interaction, which may have been deferred
-			// on a previous use that only needed the shadow
-			if ( sint->lightTris == LIGHT_TRIS_DEFERRED ) {
-				sint->lightTris = R_CreateLightTris( vEntity->entityDef, sint->ambientTris, vLight->lightDef, sint->shader, sint->cullInfo );
-				R_FreeInteractionCullInfo( sint->cullInfo );
-			}
-
+			// deferred light tris have been created by CreateActiveSurfaces
 			srfTriangles_t *lightTris = sint->lightTris;
 
 			if ( lightTris ) {
@@ -89,6 +89,18 @@ typedef struct areaNumRef_s {
 
 class idRenderEntityLocal;
 class idRenderLightLocal;
+class idInteraction;
+
+// state carried between the steps of an active interaction, so the expensive
+// surface creation can be run on job threads between two serial passes
+typedef struct {
+	idInteraction *			inter;
+	idRenderModel *			model;
+	idScreenRect			shadowScissor;
+	idScreenRect			lightScissor;
+	bool					create;				// CreateInteraction needs to be called
+	bool					makeEmpty;			// nothing was generated, MakeEmpty is deferred to the link
+} activeInteraction_t;
 
 class idInteraction {
 public:
@@ -146,6 +158,14 @@ public:
 	// calls R_LinkLightSurf() for each one
 	void					AddActiveInteraction( void );
 
+	// AddActiveInteraction split in three steps, returns false if the interaction is culled
+	bool					BeginActiveInteraction( activeInteraction_t &active );
+	// creates the light and shadow surfaces, does not touch any shared render state
+	// so it can be called from a job thread
+	void					CreateActiveSurfaces( activeInteraction_t &active );
+	// must be called in the same order the interactions were begun
+	void					LinkActiveInteraction( const activeInteraction_t &active );
+
 private:
 	enum {
 		FRUSTUM_UNINITIALIZED,
@@ -159,8 +179,8 @@ private:
 	int						dynamicModelFrameCount;	// so we can tell if a callback model animated
 
 private:
-	// actually create the interaction
-	void					CreateInteraction( const idRenderModel *model );
+	// actually create the interaction, returns false if the interaction should be made empty
+	bool					CreateInteraction( const idRenderModel *model );
 
 	// unlink from entity and light lists
 	void					Unlink( void );
@@ -272,8 +272,8 @@ void idMD5Mesh::TransformScaledVerts( idDrawVert *verts, const idJointMat *entJo
 idMD5Mesh::UpdateSurface
 ====================
 */
-void idMD5Mesh::UpdateSurface( const struct renderEntity_s *ent, const idJointMat *entJoints, modelSurface_t *surf ) {
-	int i, base;
+void idMD5Mesh::UpdateSurface( const struct renderEntity_s *ent, modelSurface_t *surf ) {
+	int i;
 	srfTriangles_t *tri;
 
 	tr.pc.c_deformedSurfaces++;
@@ -322,10 +322,48 @@ void idMD5Mesh::UpdateSurface( const struct renderEntity_s *ent, const idJointMa
 		}
 	}
 
+	// If a surface is going to be have a lighting interaction generated, it will also have to call
+	// R_DeriveTangents() to get normals, tangents, and face planes.  If it only
+	// needs shadows generated, it will only have to generate face planes.  If it only
+	// has ambient drawing, or is culled, no additional work will be necessary
+	bool deriveTangents = !r_useDeferredTangents.GetBool();
+
+	if ( tr.deferSkinning ) {
+		// the entity is visible, so a lit surface will need its tangents anyway
+		// and they may as well be derived on the job thread
+		const idMaterial *skinnedShader = R_RemapShaderBySkin( shader, ent->customSkin, ent->customShader );
+		if ( skinnedShader && skinnedShader->ReceivesLighting() ) {
+			deriveTangents = true;
+		}
+
+		deferredSkin_t &skin = tr.deferredSkins.Alloc();
+		skin.mesh = this;
+		skin.ent = ent;
+		skin.tri = tri;
+		skin.model = NULL;
+		skin.def = NULL;
+		skin.deriveTangents = deriveTangents;
+		return;
+	}
+
+	SkinSurface( ent, tri, deriveTangents );
+}
+
+/*
+====================
+idMD5Mesh::SkinSurface
+
+Transforms the vertexes of a surface set up by UpdateSurface.  Only writes
+to the surface, so different surfaces can be skinned in parallel.
+====================
+*/
+void idMD5Mesh::SkinSurface( const struct renderEntity_s *ent, srfTriangles_t *tri, bool deriveTangents ) {
+	int i, base;
+
 	if ( ent->shaderParms[ SHADERPARM_MD5_SKINSCALE ] != 0.0f ) {
-		TransformScaledVerts( tri->verts, entJoints, ent->shaderParms[ SHADERPARM_MD5_SKINSCALE ] );
+		TransformScaledVerts( tri->verts, ent->joints, ent->shaderParms[ SHADERPARM_MD5_SKINSCALE ] );
 	} else {
-		TransformVerts( tri->verts, entJoints );
+		TransformVerts( tri->verts, ent->joints );
 	}
 
 	// replicate the mirror seam vertexes
@@ -336,11 +374,7 @@ void idMD5Mesh::UpdateSurface( const struct renderEntity_s *ent, const idJointMa
 
 	R_BoundTriSurf( tri );
 
-	// If a surface is going to be have a lighting interaction generated, it will also have to call
-	// R_DeriveTangents() to get normals, tangents, and face planes.  If it only
-	// needs shadows generated, it will only have to generate face planes.  If it only
-	// has ambient drawing, or is culled, no additional work will be necessary
-	if ( !r_useDeferredTangents.GetBool() ) {
+	if ( deriveTangents ) {
 		// set face planes, vertex normals, tangents
 		R_DeriveTangents( tri );
 	}
@@ -770,6 +804,8 @@ idRenderModel *idRenderModelMD5::InstantiateDynamicModel( const struct renderEnt
 		}
 	}
 
+	int firstSkin = tr.deferredSkins.Num();
+
 	// create all the surfaces
 	for( mesh = meshes.Ptr(), i = 0; i < meshes.Num(); i++, mesh++ ) {
 		// avoid deforming the surface if it will be a nodraw due to a skin remapping
@@ -801,15 +837,58 @@ idRenderModel *idRenderModelMD5::InstantiateDynamicModel( const struct renderEnt
 			surf->id = i;
 		}
 
-		mesh->UpdateSurface( ent, ent->joints, surf );
+		mesh->UpdateSurface( ent, surf );
+
+		if ( tr.deferSkinning ) {
+			// R_SkinDeferredMD5Surfaces adds the bounds after skinning
+			continue;
+		}
 
 		staticModel->bounds.AddPoint( surf->geometry->bounds[0] );
 		staticModel->bounds.AddPoint( surf->geometry->bounds[1] );
 	}
 
+	for ( i = firstSkin; i < tr.deferredSkins.Num(); i++ ) {
+		tr.deferredSkins[i].model = staticModel;
+	}
+
 	return staticModel;
 }
 
+/*
+====================
+R_SkinDeferredMD5SurfacesJob
+====================
+*/
+static void R_SkinDeferredMD5SurfacesJob( void *data, int first, int last ) {
+	deferredSkin_t *skins = (deferredSkin_t *)data;
+
+	for ( int i = first; i < last; i++ ) {
+		skins[i].mesh->SkinSurface( skins[i].ent, skins[i].tri, skins[i].deriveTangents );
+	}
+}
+
+/*
+====================
+R_SkinDeferredMD5Surfaces
+====================
+*/
+void R_SkinDeferredMD5Surfaces( void ) {
+	idList<deferredSkin_t> &skins = tr.deferredSkins;
+
+	// surfaces differ a lot in size, so hand them out one at a time
+	jobSystem->ParallelFor( R_SkinDeferredMD5SurfacesJob, skins.Ptr(), skins.Num(), 1 );
+
+	// the surfaces of a snapshot are queued next to each other
+	for ( int i = 0; i < skins.Num(); i++ ) {
+		idRenderModelStatic *staticModel = static_cast<idRenderModelStatic *>( skins[i].model );
+		const srfTriangles_t *tri = skins[i].tri;
+
+		staticModel->bounds.AddPoint( tri->bounds[0] );
+		staticModel->bounds.AddPoint( tri->bounds[1] );
+	}
+}
+
 /*
 ====================
 idRenderModelMD5::IsDynamicModel
@@ -72,13 +72,15 @@ static void R_PerformanceCounters( void ) {
 	}
 
 	if ( r_showDynamic.GetBool() ) {
-		common->Printf( "callback:%i md5:%i dfrmVerts:%i dfrmTris:%i tangTris:%i guis:%i\n",
+		common->Printf( "callback:%i md5:%i dfrmVerts:%i dfrmTris:%i tangTris:%i guis:%i skins:%i skinUsec:%i\n",
 			tr.pc.c_entityDefCallbacks,
 			tr.pc.c_generateMd5,
 			tr.pc.c_deformedVerts,
 			tr.pc.c_deformedIndexes/3,
 			tr.pc.c_tangentIndexes/3,
-			tr.pc.c_guiSurfs
+			tr.pc.c_guiSurfs,
+			tr.pc.c_deferredSkins,
+			tr.pc.skinUsec
 			); 
 	}
 
@@ -107,7 +109,9 @@ static void R_PerformanceCounters( void ) {
 	}
 	if ( r_showMemory.GetBool() ) {
 		int	m1 = frameData ? frameData->memoryHighwater : 0;
-		common->Printf( "frameData: %i (%i)\n", R_CountFrameData(), m1 );
+		int	m2 = frameData ? frameData->memoryLastFrame : 0;
+		int	m3 = frameData ? frameData->numBlocksLastFrame : 0;
+		common->Printf( "frameData: %i (%i) lastFrame: %i in %i blocks\n", R_CountFrameData(), m1, m2, m3 );
 	}
 	if ( r_showLightScale.GetBool() ) {
 		common->Printf( "lightScale: %f\n", backEnd.pc.maxLightValue );
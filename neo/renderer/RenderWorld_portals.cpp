@@ -580,6 +580,46 @@ bool idRenderWorldLocal::CullEntityByPortals( const idRenderEntityLocal *entity,
 	return false;
 }
 
+/*
+===================
+R_AddBatchCulledEntityRefs
+
+Culls the reference bounds of a batch of entities against the current
+portal chain at once, and adds the visible ones.
+===================
+*/
+static const int MAX_BATCH_CULL_ENTITIES = 64;
+
+static void R_AddBatchCulledEntityRefs( idRenderEntityLocal **entities, int numEntities, const portalStack_t *ps ) {
+	const idBounds *	bounds[MAX_BATCH_CULL_ENTITIES];
+	const float *		modelMatrices[MAX_BATCH_CULL_ENTITIES];
+	unsigned int		visibleBits[MAX_BATCH_CULL_ENTITIES / 32];
+	viewEntity_t *		vEnt;
+	int					i;
+
+	for ( i = 0; i < numEntities; i++ ) {
+		bounds[i] = &entities[i]->referenceBounds;
+		modelMatrices[i] = entities[i]->modelMatrix;
+	}
+
+	if ( !R_CullLocalBoxes( numEntities, bounds, modelMatrices, ps->numPortalPlanes, ps->portalPlanes, visibleBits ) ) {
+		return;
+	}
+
+	for ( i = 0; i < numEntities; i++ ) {
+		if ( !( visibleBits[i >> 5] & ( 1 << ( i & 31 ) ) ) ) {
+			// we are culled out through this portal chain, but it might
+			// still be visible through others
+			continue;
+		}
+
+		vEnt = R_SetEntityDefViewEntity( entities[i] );
+
+		// possibly expand the scissor rect
+		vEnt->scissorRect.Union( ps->rect );
+	}
+}
+
 /*
 ===================
 AddAreaEntityRefs
@@ -594,9 +634,15 @@ void idRenderWorldLocal::AddAreaEntityRefs( int areaNum, const portalStack_t *ps
 	portalArea_t		*area;
 	viewEntity_t		*vEnt;
 	idBounds			b;
+	idRenderEntityLocal	*batchEntities[MAX_BATCH_CULL_ENTITIES];
+	int					numBatchEntities;
+	bool				batchCull;
 
 	area = &portalAreas[ areaNum ];
 
+	batchCull = r_useEntityCulling.GetBool() && r_useBatchCulling.GetBool();
+	numBatchEntities = 0;
+
 	for ( ref = area->entityRefs.areaNext ; ref != &area->entityRefs ; ref = ref->areaNext ) {
 		entity = ref->entity;
 
@@ -620,6 +666,16 @@ void idRenderWorldLocal::AddAreaEntityRefs( int areaNum, const portalStack_t *ps
 			}
 		}
 
+		// cull the reference bounds together with the other entities of the area
+		if ( batchCull ) {
+			batchEntities[numBatchEntities++] = entity;
+			if ( numBatchEntities == MAX_BATCH_CULL_ENTITIES ) {
+				R_AddBatchCulledEntityRefs( batchEntities, numBatchEntities, ps );
+				numBatchEntities = 0;
+			}
+			continue;
+		}
+
 		// cull reference bounds
 		if ( CullEntityByPortals( entity, ps ) ) {
 			// we are culled out through this portal chain, but it might
@@ -632,6 +688,10 @@ void idRenderWorldLocal::AddAreaEntityRefs( int areaNum, const portalStack_t *ps
 		// possibly expand the scissor rect
 		vEnt->scissorRect.Union( ps->rect );
 	}
+
+	if ( numBatchEntities ) {
+		R_AddBatchCulledEntityRefs( batchEntities, numBatchEntities, ps );
+	}
 }
 
 /*
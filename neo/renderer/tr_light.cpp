@@ -1018,6 +1018,34 @@ bool R_IssueEntityDefCallback( idRenderEntityLocal *def ) {
 	return update;
 }
 
+/*
+===================
+R_FinishEntityDefDynamicModel
+
+Adds the overlays to a newly instantiated snapshot.
+===================
+*/
+static void R_FinishEntityDefDynamicModel( idRenderEntityLocal *def ) {
+	// add any overlays to the snapshot of the dynamic model
+	if ( def->overlay && !r_skipOverlays.GetBool() ) {
+		def->overlay->AddOverlaySurfacesToModel( def->cachedDynamicModel );
+	} else {
+		idRenderModelOverlay::RemoveOverlaySurfacesFromModel( def->cachedDynamicModel );
+	}
+
+	if ( r_checkBounds.GetBool() ) {
+		idBounds b = def->cachedDynamicModel->Bounds();
+		if (	b[0][0] < def->referenceBounds[0][0] - CHECK_BOUNDS_EPSILON ||
+				b[0][1] < def->referenceBounds[0][1] - CHECK_BOUNDS_EPSILON ||
+				b[0][2] < def->referenceBounds[0][2] - CHECK_BOUNDS_EPSILON ||
+				b[1][0] > def->referenceBounds[1][0] + CHECK_BOUNDS_EPSILON ||
+				b[1][1] > def->referenceBounds[1][1] + CHECK_BOUNDS_EPSILON ||
+				b[1][2] > def->referenceBounds[1][2] + CHECK_BOUNDS_EPSILON ) {
+			common->Printf( "entity %i dynamic model exceeded reference bounds\n", def->index );
+		}
+	}
+}
+
 /*
 ===================
 R_EntityDefDynamicModel
@@ -1057,30 +1085,17 @@ idRenderModel *R_EntityDefDynamicModel( idRenderEntityLocal *def ) {
 
 	// if we don't have a snapshot of the dynamic model, generate it now
 	if ( !def->dynamicModel ) {
+		int firstSkin = tr.deferredSkins.Num();
 
 		// instantiate the snapshot of the dynamic model, possibly reusing memory from the cached snapshot
 		def->cachedDynamicModel = model->InstantiateDynamicModel( &def->parms, tr.viewDef, def->cachedDynamicModel );
 
-		if ( def->cachedDynamicModel ) {
-
-			// add any overlays to the snapshot of the dynamic model
-			if ( def->overlay && !r_skipOverlays.GetBool() ) {
-				def->overlay->AddOverlaySurfacesToModel( def->cachedDynamicModel );
-			} else {
-				idRenderModelOverlay::RemoveOverlaySurfacesFromModel( def->cachedDynamicModel );
-			}
-
-			if ( r_checkBounds.GetBool() ) {
-				idBounds b = def->cachedDynamicModel->Bounds();
-				if (	b[0][0] < def->referenceBounds[0][0] - CHECK_BOUNDS_EPSILON ||
-						b[0][1] < def->referenceBounds[0][1] - CHECK_BOUNDS_EPSILON ||
-						b[0][2] < def->referenceBounds[0][2] - CHECK_BOUNDS_EPSILON ||
-						b[1][0] > def->referenceBounds[1][0] + CHECK_BOUNDS_EPSILON ||
-						b[1][1] > def->referenceBounds[1][1] + CHECK_BOUNDS_EPSILON ||
-						b[1][2] > def->referenceBounds[1][2] + CHECK_BOUNDS_EPSILON ) {
-					common->Printf( "entity %i dynamic model exceeded reference bounds\n", def->index );
-				}
-			}
+		if ( tr.deferredSkins.Num() > firstSkin ) {
+			// the overlays need the skinned vertexes, R_InstantiateDynamicModels
+			// finishes the snapshot after running the skinning
+			tr.deferredSkins[firstSkin].def = def;
+		} else if ( def->cachedDynamicModel ) {
+			R_FinishEntityDefDynamicModel( def );
 		}
 
 		def->dynamicModel = def->cachedDynamicModel;
@@ -1102,6 +1117,40 @@ idRenderModel *R_EntityDefDynamicModel( idRenderEntityLocal *def ) {
 	return def->dynamicModel;
 }
 
+/*
+=================
+R_DrawSurfSortKey
+
+The material sort order goes in the top 32 bits, with the float bits flipped
+so the keys compare the same way as the floats.  Opaque surfaces are grouped
+by material, entity and depth in the low bits to cut down on backend state
+changes, all other surfaces keep the order they were added in.
+=================
+*/
+static uint64_t R_DrawSurfSortKey( const srfTriangles_t *tri, const viewEntity_t *space, const idMaterial *shader, int sequence ) {
+	float sort = shader->GetSort();
+	unsigned int sortBits = *reinterpret_cast<unsigned int *>( &sort );
+	unsigned int low;
+
+	sortBits = ( sortBits & 0x80000000 ) ? ~sortBits : ( sortBits | 0x80000000 );
+
+	if ( sort == SS_OPAQUE ) {
+		int entityNum = space->entityDef ? space->entityDef->index : 0;
+
+		// distance along the view axis of the surface center, the eye space z axis points backwards
+		idVec3 center = tri->bounds.GetCenter();
+		const float *m = space->modelViewMatrix;
+		float depth = -( center[0] * m[2] + center[1] * m[6] + center[2] * m[10] + m[14] );
+		int depthBucket = idMath::ClampInt( 0, DRAWSURF_SORT_DEPTH_BUCKETS - 1, idMath::FtoiFast( depth * ( 1.0f / DRAWSURF_SORT_DEPTH_BUCKET_SIZE ) ) );
+
+		low = ( ( shader->Index() & 0xffff ) << 16 ) | ( ( entityNum & 0x3ff ) << 6 ) | depthBucket;
+	} else {
+		low = sequence;
+	}
+
+	return ( (uint64_t)sortBits << 32 ) | low;
+}
+
 /*
 =================
 R_AddDrawSurf
@@ -1119,13 +1168,9 @@ void R_AddDrawSurf( const srfTriangles_t *tri, const viewEntity_t *space, const
 	drawSurf->space = space;
 	drawSurf->material = shader;
 	drawSurf->scissorRect = scissor;
-	drawSurf->sort = shader->GetSort() + tr.sortOffset;
+	drawSurf->sortKey = R_DrawSurfSortKey( tri, space, shader, tr.viewDef->numDrawSurfs );
 	drawSurf->dsFlags = 0;
 
-	// bumping this offset each time causes surfaces with equal sort orders to still
-	// deterministically draw in the order they are added
-	tr.sortOffset += 0.000001f;
-
 	// if it doesn't fit, resize the list
 	if ( tr.viewDef->numDrawSurfs == tr.viewDef->maxDrawSurfs ) {
 		drawSurf_t	**old = tr.viewDef->drawSurfs;
@@ -1374,6 +1419,137 @@ idScreenRect R_CalcEntityScissorRectangle( viewEntity_t *vEntity ) {
 	return R_ScreenRectFromViewFrustumBounds( bounds );
 }
 
+/*
+===================
+R_InstantiateDynamicModels
+
+Instantiates the dynamic models of all visible entities before any surfaces
+are added.  The md5 skinning is queued while doing so and run with the job
+system afterwards, which also derives the tangents of the lit surfaces.
+===================
+*/
+static void R_InstantiateDynamicModels( void ) {
+	viewEntity_t	*vEntity;
+	idTimer			skinTimer;
+
+	tr.deferredSkins.SetNum( 0, false );
+	tr.deferSkinning = true;
+
+	for ( vEntity = tr.viewDef->viewEntitys; vEntity; vEntity = vEntity->next ) {
+		idRenderEntityLocal *def = vEntity->entityDef;
+
+		// shadow only entities are instantiated when an interaction needs them
+		if ( vEntity->scissorRect.IsEmpty() ) {
+			continue;
+		}
+		if ( tr.viewDef->isXraySubview && def->parms.xrayIndex == 1 ) {
+			continue;
+		} else if ( !tr.viewDef->isXraySubview && def->parms.xrayIndex == 2 ) {
+			continue;
+		}
+		if ( !def->parms.callback && def->parms.hModel->IsDynamicModel() == DM_STATIC ) {
+			continue;
+		}
+
+		float oldFloatTime;
+		int oldTime;
+
+		game->SelectTimeGroup( def->parms.timeGroup );
+
+		if ( def->parms.timeGroup ) {
+			oldFloatTime = tr.viewDef->floatTime;
+			oldTime = tr.viewDef->renderView.time;
+
+			tr.viewDef->floatTime = game->GetTimeGroupTime( def->parms.timeGroup ) * 0.001;
+			tr.viewDef->renderView.time = game->GetTimeGroupTime( def->parms.timeGroup );
+		}
+
+		R_EntityDefDynamicModel( def );
+
+		if ( def->parms.timeGroup ) {
+			tr.viewDef->floatTime = oldFloatTime;
+			tr.viewDef->renderView.time = oldTime;
+		}
+	}
+
+	tr.deferSkinning = false;
+
+	if ( tr.deferredSkins.Num() == 0 ) {
+		return;
+	}
+
+	skinTimer.Start();
+	R_SkinDeferredMD5Surfaces();
+	skinTimer.Stop();
+
+	tr.pc.c_deferredSkins += tr.deferredSkins.Num();
+	tr.pc.skinUsec += idMath::FtoiFast( skinTimer.Milliseconds() * 1000.0 );
+
+	for ( int i = 0; i < tr.deferredSkins.Num(); i++ ) {
+		if ( tr.deferredSkins[i].def != NULL ) {
+			R_FinishEntityDefDynamicModel( tr.deferredSkins[i].def );
+		}
+	}
+
+	tr.deferredSkins.SetNum( 0, false );
+}
+
+/*
+===================
+R_CreateActiveInteractionsJob
+===================
+*/
+static void R_CreateActiveInteractionsJob( void *data, int first, int last ) {
+	activeInteraction_t *active = (activeInteraction_t *)data;
+
+	for ( int i = first; i < last; i++ ) {
+		active[i].inter->CreateActiveSurfaces( active[i] );
+	}
+}
+
+/*
+===================
+R_AddActiveInteractions
+
+Creates the light and shadow surfaces for all interactions begun by
+R_AddModelSurfaces with the job system, then links them in the order they
+were begun, so the light surface lists are the same as with the serial path.
+===================
+*/
+static void R_AddActiveInteractions( void ) {
+	idList<activeInteraction_t> &active = tr.activeInteractions;
+
+	if ( active.Num() == 0 ) {
+		return;
+	}
+
+	// the cost of an interaction varies a lot, so keep the ranges small
+	jobSystem->ParallelFor( R_CreateActiveInteractionsJob, active.Ptr(), active.Num(), 4 );
+
+	float oldFloatTime = tr.viewDef->floatTime;
+	int oldTime = tr.viewDef->renderView.time;
+
+	for ( int i = 0; i < active.Num(); i++ ) {
+		const renderEntity_t &parms = active[i].inter->entityDef->parms;
+
+		// shader registers are evaluated when linking, so use the time of the entity
+		if ( parms.timeGroup ) {
+			tr.viewDef->floatTime = game->GetTimeGroupTime( parms.timeGroup ) * 0.001;
+			tr.viewDef->renderView.time = game->GetTimeGroupTime( parms.timeGroup );
+		} else {
+			tr.viewDef->floatTime = oldFloatTime;
+			tr.viewDef->renderView.time = oldTime;
+		}
+
+		active[i].inter->LinkActiveInteraction( active[i] );
+	}
+
+	tr.viewDef->floatTime = oldFloatTime;
+	tr.viewDef->renderView.time = oldTime;
+
+	active.SetNum( 0, false );
+}
+
 /*
 ===================
 R_AddModelSurfaces
@@ -1383,22 +1559,28 @@ interactions get created.  This is all done on a sort-by-model basis
 to keep source data in cache (most likely L2) as any interactions and
 shadows are generated, since dynamic models will typically be lit by
 two or more lights.
+
+With r_useParallelInteractions the interactions are only culled here,
+the light and shadow surfaces are created with the job system afterwards.
 ===================
 */
 void R_AddModelSurfaces( void ) {
 	viewEntity_t		*vEntity;
 	idInteraction		*inter, *next;
 	idRenderModel		*model;
+	activeInteraction_t	active;
+	bool				parallel;
+
+	parallel = r_useParallelInteractions.GetBool();
+	tr.activeInteractions.SetNum( 0, false );
 
 	// clear the ambient surface list
 	tr.viewDef->numDrawSurfs = 0;
 	tr.viewDef->maxDrawSurfs = 0;	// will be set to INITIAL_DRAWSURFS on R_AddDrawSurf
 
-	// go through each entity that is either visible to the view, or to
-	// any light that intersects the view (for shadows)
-	for ( vEntity = tr.viewDef->viewEntitys; vEntity; vEntity = vEntity->next ) {
-
-		if ( r_useEntityScissors.GetBool() ) {
+	// the entity scissors decide which dynamic models are instantiated up front
+	if ( r_useEntityScissors.GetBool() ) {
+		for ( vEntity = tr.viewDef->viewEntitys; vEntity; vEntity = vEntity->next ) {
 			// calculate the screen area covered by the entity
 			idScreenRect scissorRect = R_CalcEntityScissorRectangle( vEntity );
 			// intersect with the portal crossing scissor rectangle
@@ -1408,6 +1590,15 @@ void R_AddModelSurfaces( void ) {
 				R_ShowColoredScreenRect( vEntity->scissorRect, vEntity->entityDef->index );
 			}
 		}
+	}
+
+	if ( r_useParallelSkinning.GetBool() ) {
+		R_InstantiateDynamicModels();
+	}
+
+	// go through each entity that is either visible to the view, or to
+	// any light that intersects the view (for shadows)
+	for ( vEntity = tr.viewDef->viewEntitys; vEntity; vEntity = vEntity->next ) {
 
 		float oldFloatTime;
 		int oldTime;
@@ -1463,7 +1654,11 @@ void R_AddModelSurfaces( void ) {
 					if ( inter->lightDef->viewCount != tr.viewCount ) {
 						continue;
 					}
-					inter->AddActiveInteraction();
+					if ( !parallel ) {
+						inter->AddActiveInteraction();
+					} else if ( inter->BeginActiveInteraction( active ) ) {
+						tr.activeInteractions.Append( active );
+					}
 				}
 			}
 		} else {
@@ -1478,7 +1673,11 @@ void R_AddModelSurfaces( void ) {
 				if ( inter->lightDef->viewCount != tr.viewCount ) {
 					continue;
 				}
-				inter->AddActiveInteraction();
+				if ( !parallel ) {
+					inter->AddActiveInteraction();
+				} else if ( inter->BeginActiveInteraction( active ) ) {
+					tr.activeInteractions.Append( active );
+				}
 			}
 		}
 
@@ -1488,6 +1687,8 @@ void R_AddModelSurfaces( void ) {
 		}
 
 	}
+
+	R_AddActiveInteractions();
 }
 
 /*
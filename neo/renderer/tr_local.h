@@ -115,7 +115,7 @@ typedef struct drawSurf_s {
 	const srfTriangles_t	*geo;
 	const struct viewEntity_s *space;
 	const idMaterial		*material;	// may be NULL for shadow volumes
-	float					sort;		// material->sort, modified by gui / entity sort offsets
+	uint64_t				sortKey;	// material sort order and grouping, see R_DrawSurfSortKey
 	const float				*shaderRegisters;	// evaluated and adjusted for referenceShaders
 	const struct drawSurf_s	*nextOnLight;	// viewLight chains
 	idScreenRect			scissorRect;	// for scissor clipping, local inside renderView viewport
@@ -468,6 +468,10 @@ typedef struct drawInteraction_s {
 // in a given view, but it will automatically grow if needed
 const int	INITIAL_DRAWSURFS =			0x4000;
 
+// opaque surfaces of the same material and entity are sorted front to back in these buckets
+const int	DRAWSURF_SORT_DEPTH_BUCKETS =		64;
+const float	DRAWSURF_SORT_DEPTH_BUCKET_SIZE =	128.0f;
+
 // a request for frame memory will never fail
 // (until malloc fails), but it may force the
 // allocation of a new memory block that will
@@ -475,7 +479,7 @@ const int	INITIAL_DRAWSURFS =			0x4000;
 typedef struct frameMemoryBlock_s {
 	struct frameMemoryBlock_s *next;
 	int		size;
-	int		used;
+	volatile int used;		// bumped atomically, can overshoot size when the block runs out
 	int		poop;			// so that base is 16 byte aligned
 	byte	base[4];	// dynamically allocated as [size]
 } frameMemoryBlock_t;
@@ -489,13 +493,21 @@ typedef struct {
 	// temporary allocations
 	frameMemoryBlock_t	*memory;
 
-	// alloc will point somewhere into the memory chain
-	frameMemoryBlock_t	*alloc;
+	// alloc will point somewhere into the memory chain,
+	// it only moves forward under allocLock
+	frameMemoryBlock_t	* volatile alloc;
+	idSysSpinLock		allocLock;
+
+	// threads carve their small allocations out of sub-blocks,
+	// which are invalidated when this changes
+	volatile int		allocGeneration;
 
 	srfTriangles_t *	firstDeferredFreeTriSurf;
 	srfTriangles_t *	lastDeferredFreeTriSurf;
 
 	int					memoryHighwater;	// max used on any frame
+	int					memoryLastFrame;	// used by the previous frame
+	int					numBlocksLastFrame;	// memory blocks touched by the previous frame
 
 	// the currently building command list 
 	// commands can be inserted at the front if needed, as for required
@@ -550,6 +562,8 @@ typedef struct {
 	int		c_tangentIndexes;	// R_DeriveTangents()
 	int		c_entityUpdates, c_lightUpdates, c_entityReferences, c_lightReferences;
 	int		c_guiSurfs;
+	int		c_deferredSkins;	// md5 surfaces skinned by R_InstantiateDynamicModels
+	int		skinUsec;			// time spent running the deferred skinning
 	int		frontEndMsec;		// sum of time in all RE_RenderScene's in a frame
 } performanceCounters_t;
 
@@ -656,6 +670,22 @@ typedef struct {
 } renderCrop_t;
 static const int	MAX_RENDER_CROPS = 8;
 
+class idMD5Mesh;
+
+// md5 surface skinning queued by idMD5Mesh::UpdateSurface while R_InstantiateDynamicModels
+// instantiates the visible entities, so all of it can be run with the job system
+typedef struct {
+	idMD5Mesh *				mesh;
+	const renderEntity_t *	ent;
+	srfTriangles_t *		tri;
+	idRenderModel *			model;			// snapshot that gets the bounds of the skinned surface
+	idRenderEntityLocal *	def;			// set on the first surface of an entity that still needs its overlays added
+	bool					deriveTangents;
+} deferredSkin_t;
+
+// runs the queued skinning and sets the bounds of the snapshot models
+void R_SkinDeferredMD5Surfaces( void );
+
 /*
 ** Most renderer globals are defined here.
 ** backend functions should never modify any of these fields,
@@ -740,10 +770,13 @@ public:
 
 	idVec4					ambientLightVector;	// used for "ambient bump mapping"
 
-	float					sortOffset;				// for determinist sorting of equal sort materials
-
 	idList<idRenderWorldLocal*>worlds;
 
+	idList<activeInteraction_t>	activeInteractions;	// interactions being created in parallel by R_AddModelSurfaces
+
+	bool					deferSkinning;		// idMD5Mesh::UpdateSurface queues on deferredSkins instead of skinning
+	idList<deferredSkin_t>	deferredSkins;
+
 	idRenderWorldLocal *	primaryWorld;
 	renderView_t			primaryRenderView;
 	viewDef_t *				primaryView;
@@ -837,12 +870,14 @@ extern idCVar r_useLightCulling;		// 0 = none, 1 = box, 2 = exact clip of polyhe
 extern idCVar r_useLightScissors;		// 1 = use custom scissor rectangle for each light
 extern idCVar r_useClippedLightScissors;// 0 = full screen when near clipped, 1 = exact when near clipped, 2 = exact always
 extern idCVar r_useEntityCulling;		// 0 = none, 1 = box
+extern idCVar r_useBatchCulling;		// 1 = cull the entities of an area in batches
 extern idCVar r_useEntityScissors;		// 1 = use custom scissor rectangle for each entity
 extern idCVar r_useInteractionCulling;	// 1 = cull interactions
 extern idCVar r_useInteractionScissors;	// 1 = use a custom scissor rectangle for each interaction
 extern idCVar r_useFrustumFarDistance;	// if != 0 force the view frustum far distance to this distance
 extern idCVar r_useShadowCulling;		// try to cull shadows from partially visible lights
 extern idCVar r_usePreciseTriangleInteractions;	// 1 = do winding clipping to determine if each ambiguous tri should be lit
+extern idCVar r_useParallelInteractions;	// 1 = create interaction light and shadow surfaces with the job system
 extern idCVar r_useTurboShadow;			// 1 = use the infinite projection with W technique for dynamic shadows
 extern idCVar r_useExternalShadows;		// 1 = skip drawing caps when outside the light volume
 extern idCVar r_useOptimizedShadows;	// 1 = use the dmap generated static shadow volumes
@@ -850,6 +885,7 @@ extern idCVar r_useShadowVertexProgram;	// 1 = do the shadow projection in the v
 extern idCVar r_useShadowProjectedCull;	// 1 = discard triangles outside light volume before shadowing
 extern idCVar r_useDeferredTangents;	// 1 = don't always calc tangents after deform
 extern idCVar r_useCachedDynamicModels;	// 1 = cache snapshots of dynamic models
+extern idCVar r_useParallelSkinning;	// 1 = skin the md5 models of visible entities with the job system
 extern idCVar r_useTwoSidedStencil;		// 1 = do stencil shadows in one pass with different ops on each side
 extern idCVar r_useInfiniteFarZ;		// 1 = use the no-far-clip-plane trick
 extern idCVar r_useScissor;				// 1 = scissor clip as portals and lights are processed
@@ -1069,10 +1105,15 @@ MAIN
 
 void R_RenderView( viewDef_t *parms );
 
+void R_TestDrawSurfSort_f( const idCmdArgs &args );
+void R_TestBatchCull_f( const idCmdArgs &args );
+
 // performs radius cull first, then corner cull
 bool R_CullLocalBox( const idBounds &bounds, const float modelMatrix[16], int numPlanes, const idPlane *planes );
 bool R_RadiusCullLocalBox( const idBounds &bounds, const float modelMatrix[16], int numPlanes, const idPlane *planes );
 bool R_CornerCullLocalBox( const idBounds &bounds, const float modelMatrix[16], int numPlanes, const idPlane *planes );
+int R_CullLocalBoxes( int numBoxes, const idBounds * const *bounds, const float * const *modelMatrices,
+						int numPlanes, const idPlane *planes, unsigned int *visibleBits );
 
 void R_AxisToModelMatrix( const idMat3 &axis, const idVec3 &origin, float modelMatrix[16] );
 
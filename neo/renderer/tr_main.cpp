@@ -37,6 +37,26 @@ If you have questions concerning this license or the applicable additional terms
 #include <xmmintrin.h>
 #endif
 
+// the batched box culling only uses SSE where the scalar float math is
+// also done in SSE registers, otherwise x87 rounding could make the
+// results differ from R_CullLocalBox
+#if defined(_M_X64) || defined(__x86_64__)
+#include <xmmintrin.h>
+#define R_SSE_BOX_CULL
+#endif
+
+//====================================================================
+
+// part of the current frame memory block reserved by a thread
+typedef struct {
+	int				generation;		// frameData->allocGeneration the sub-block was taken in
+	byte *			ptr;
+	byte *			end;
+} frameSubBlock_t;
+
+static ID_THREAD_LOCAL frameSubBlock_t	r_frameSubBlock;
+static volatile int						r_frameAllocGeneration;
+
 //====================================================================
 
 /*
@@ -179,6 +199,8 @@ void R_ShowColoredScreenRect( const idScreenRect &rect, int colorIndex ) {
 /*
 ====================
 R_ToggleSmpFrame
+
+Must not be called while other threads can be in R_FrameAlloc.
 ====================
 */
 void R_ToggleSmpFrame( void ) {
@@ -192,9 +214,15 @@ void R_ToggleSmpFrame( void ) {
 	frameMemoryBlock_t	*block;
 
 	// update the highwater mark
-	R_CountFrameData();
-
 	frame = frameData;
+	frame->memoryLastFrame = R_CountFrameData();
+	frame->numBlocksLastFrame = 0;
+	for ( block = frame->memory ; block ; block = block->next ) {
+		frame->numBlocksLastFrame++;
+		if ( block == frame->alloc ) {
+			break;
+		}
+	}
 
 	// reset the memory allocation to the first block
 	frame->alloc = frame->memory;
@@ -204,6 +232,9 @@ void R_ToggleSmpFrame( void ) {
 		block->used = 0;
 	}
 
+	// drop the sub-blocks all threads are allocating from
+	frame->allocGeneration = Sys_InterlockedIncrement( r_frameAllocGeneration );
+
 	R_ClearCommandChain();
 }
 
@@ -211,6 +242,10 @@ void R_ToggleSmpFrame( void ) {
 //=====================================================
 
 #define	MEMORY_BLOCK_SIZE	0x100000
+#define	MEMORY_SUB_BLOCK_SIZE	0x4000		// reserved at once by a thread for its small allocations
+
+static void *	r_drawSurfSortScratch;		// grows with the largest drawSurf list, too large for the frame memory blocks
+static int		r_drawSurfSortScratchSize;
 
 /*
 =====================
@@ -236,6 +271,10 @@ void R_ShutdownFrameData( void ) {
 	}
 	Mem_Free( frame );
 	frameData = NULL;
+
+	Mem_Free16( r_drawSurfSortScratch );
+	r_drawSurfSortScratch = NULL;
+	r_drawSurfSortScratchSize = 0;
 }
 
 /*
@@ -261,6 +300,7 @@ void R_InitFrameData( void ) {
 	block->used = 0;
 	block->next = NULL;
 	frame->memory = block;
+	frame->alloc = block;
 	frame->memoryHighwater = 0;
 
 	R_ToggleSmpFrame();
@@ -269,6 +309,8 @@ void R_InitFrameData( void ) {
 /*
 ================
 R_CountFrameData
+
+Includes the unused parts of the sub-blocks threads have reserved.
 ================
 */
 int R_CountFrameData( void ) {
@@ -279,7 +321,7 @@ int R_CountFrameData( void ) {
 	count = 0;
 	frame = frameData;
 	for ( block = frame->memory ; block ; block=block->next ) {
-		count += block->used;
+		count += Min( block->used, block->size );
 		if ( block == frame->alloc ) {
 			break;
 		}
@@ -301,9 +343,9 @@ R_StaticAlloc
 void *R_StaticAlloc( int bytes ) {
 	void	*buf;
 
-	tr.pc.c_alloc++;
+	Sys_InterlockedIncrement( tr.pc.c_alloc );
 
-	tr.staticAllocCount += bytes;
+	Sys_InterlockedAdd( tr.staticAllocCount, bytes );
 
     buf = Mem_Alloc( bytes );
 
@@ -333,10 +375,65 @@ R_StaticFree
 =================
 */
 void R_StaticFree( void *data ) {
-	tr.pc.c_free++;
+	Sys_InterlockedIncrement( tr.pc.c_free );
     Mem_Free( data );
 }
 
+/*
+================
+R_FrameBlockAlloc
+
+Atomically bumps the current memory block, moving on to the next
+block when it is exhausted.
+================
+*/
+static byte *R_FrameBlockAlloc( frameData_t *frame, int bytes ) {
+	frameMemoryBlock_t	*block;
+	int				end;
+
+	while( 1 ) {
+		block = frame->alloc;
+
+		// see if it can be satisfied in the current block
+		end = Sys_InterlockedAdd( block->used, bytes );
+		if ( end <= block->size ) {
+			return block->base + end - bytes;
+		}
+
+		// the first thread to get here advances to the next block
+		frame->allocLock.Lock();
+		if ( frame->alloc == block ) {
+			frameMemoryBlock_t *next = block->next;
+
+			// create a new block if we are at the end of
+			// the chain
+			if ( !next ) {
+				int		size;
+
+				size = MEMORY_BLOCK_SIZE;
+				next = (frameMemoryBlock_t *)Mem_Alloc( size + sizeof( *next ) );
+				if ( !next ) {
+					common->FatalError( "R_FrameAlloc: Mem_Alloc() failed" );
+				}
+				next->size = size;
+				next->used = 0;
+				next->next = NULL;
+				block->next = next;
+			}
+
+			// we could fix this if we needed to...
+			if ( bytes > next->size ) {
+				frame->allocLock.Unlock();
+				common->FatalError( "R_FrameAlloc of %i exceeded MEMORY_BLOCK_SIZE",
+					bytes );
+			}
+
+			frame->alloc = next;
+		}
+		frame->allocLock.Unlock();
+	}
+}
+
 /*
 ================
 R_FrameAlloc
@@ -354,59 +451,46 @@ different frameData than the front end is using.
 All temporary data, like dynamic tesselations
 and local spaces are allocated here.
 
+This is safe to call from any thread between two
+R_ToggleSmpFrame calls. Each thread reserves a
+sub-block of the current memory block and bumps
+a private pointer for small allocations, so the
+common case needs no atomic operation at all.
+
 The memory will not move, but it may not be
 contiguous with previous allocations even
 from this frame.
 
 The memory is NOT zero filled.
-Should part of this be inlined in a macro?
 ================
 */
 void *R_FrameAlloc( int bytes ) {
 	frameData_t		*frame;
-	frameMemoryBlock_t	*block;
-	void			*buf;
+	frameSubBlock_t	*sub;
+	byte			*buf;
     
 	bytes = (bytes+16)&~15;
-	// see if it can be satisfied in the current block
 	frame = frameData;
-	block = frame->alloc;
+	sub = &r_frameSubBlock;
 
-	if ( block->size - block->used >= bytes ) {
-		buf = block->base + block->used;
-		block->used += bytes;
+	// see if it can be satisfied in this thread's sub-block
+	if ( sub->generation == frame->allocGeneration && sub->end - sub->ptr >= bytes ) {
+		buf = sub->ptr;
+		sub->ptr += bytes;
 		return buf;
 	}
 
-	// advance to the next memory block if available
-	block = block->next;
-	// create a new block if we are at the end of
-	// the chain
-	if ( !block ) {
-		int		size;
-
-		size = MEMORY_BLOCK_SIZE;
-		block = (frameMemoryBlock_t *)Mem_Alloc( size + sizeof( *block ) );
-		if ( !block ) {
-			common->FatalError( "R_FrameAlloc: Mem_Alloc() failed" );
-		}
-		block->size = size;
-		block->used = 0;
-		block->next = NULL;
-		frame->alloc->next = block;
+	// large allocations would waste too much of a sub-block
+	if ( bytes > MEMORY_SUB_BLOCK_SIZE / 4 ) {
+		return R_FrameBlockAlloc( frame, bytes );
 	}
 
-	// we could fix this if we needed to...
-	if ( bytes > block->size ) {
-		common->FatalError( "R_FrameAlloc of %i exceeded MEMORY_BLOCK_SIZE",
-			bytes );
-	}
-
-	frame->alloc = block;
-
-	block->used = bytes;
+	buf = R_FrameBlockAlloc( frame, MEMORY_SUB_BLOCK_SIZE );
+	sub->generation = frame->allocGeneration;
+	sub->ptr = buf + bytes;
+	sub->end = buf + MEMORY_SUB_BLOCK_SIZE;
 
-	return block->base;
+	return buf;
 }
 
 /*
@@ -679,6 +763,314 @@ bool R_CullLocalBox( const idBounds &bounds, const float modelMatrix[16], int nu
 	return R_CornerCullLocalBox( bounds, modelMatrix, numPlanes, planes );
 }
 
+// boxes culled by R_CullLocalBoxes while testBatchCull captures a frame
+typedef struct {
+	int				numBoxes;
+	int				numPlanes;
+	int				firstBox;
+	int				firstPlane;
+	int				firstBits;
+} boxCullBatch_t;
+
+typedef struct {
+	idList<boxCullBatch_t>	batches;
+	idList<idBounds>		bounds;
+	idList<float>			matrices;
+	idList<idPlane>			planes;
+	idList<unsigned int>	visibleBits;
+} boxCullCapture_t;
+
+static boxCullCapture_t *	r_boxCullCapture;
+
+/*
+=================
+R_CaptureCullLocalBoxes
+=================
+*/
+static void R_CaptureCullLocalBoxes( int numBoxes, const idBounds * const *bounds, const float * const *modelMatrices,
+										int numPlanes, const idPlane *planes, const unsigned int *visibleBits ) {
+	boxCullBatch_t	batch;
+	int				i;
+
+	batch.numBoxes = numBoxes;
+	batch.numPlanes = numPlanes;
+	batch.firstBox = r_boxCullCapture->bounds.Num();
+	batch.firstPlane = r_boxCullCapture->planes.Num();
+	batch.firstBits = r_boxCullCapture->visibleBits.Num();
+	r_boxCullCapture->batches.Append( batch );
+
+	for ( i = 0; i < numBoxes; i++ ) {
+		r_boxCullCapture->bounds.Append( *bounds[i] );
+		for ( int j = 0; j < 16; j++ ) {
+			r_boxCullCapture->matrices.Append( modelMatrices[i][j] );
+		}
+	}
+	for ( i = 0; i < numPlanes; i++ ) {
+		r_boxCullCapture->planes.Append( planes[i] );
+	}
+	for ( i = 0; i < ( numBoxes + 31 ) >> 5; i++ ) {
+		r_boxCullCapture->visibleBits.Append( visibleBits[i] );
+	}
+}
+
+/*
+=================
+R_CullLocalBoxes
+
+Culls a batch of boxes against the same planes, four boxes at a time.
+Sets bit i in visibleBits for every box that R_CullLocalBox would not cull.
+The float operations are done in the same order as the scalar path, so the
+results and the box cull counters are identical.
+Returns the number of visible boxes.
+=================
+*/
+int R_CullLocalBoxes( int numBoxes, const idBounds * const *bounds, const float * const *modelMatrices,
+						int numPlanes, const idPlane *planes, unsigned int *visibleBits ) {
+	int		i, numVisible;
+
+	memset( visibleBits, 0, ( ( numBoxes + 31 ) >> 5 ) * sizeof( visibleBits[0] ) );
+	numVisible = 0;
+
+#ifdef R_SSE_BOX_CULL
+	const int useCulling = r_useCulling.GetInteger();
+
+	for ( int base = 0; base < numBoxes; base += 4 ) {
+		const int numLanes = Min( 4, numBoxes - base );
+		const int laneMask = ( 1 << numLanes ) - 1;
+		ALIGN16( float originX[4] );
+		ALIGN16( float originY[4] );
+		ALIGN16( float originZ[4] );
+		ALIGN16( float radius[4] );
+		int culled = 0;
+
+		if ( useCulling >= 1 ) {
+			// the center and radius are computed exactly like R_RadiusCullLocalBox
+			for ( i = 0; i < 4; i++ ) {
+				const idBounds &b = *bounds[base + Min( i, numLanes - 1 )];
+				idVec3 localOrigin = ( b[0] + b[1] ) * 0.5;
+				idVec3 worldOrigin;
+				R_LocalPointToGlobal( modelMatrices[base + Min( i, numLanes - 1 )], localOrigin, worldOrigin );
+				originX[i] = worldOrigin.x;
+				originY[i] = worldOrigin.y;
+				originZ[i] = worldOrigin.z;
+				radius[i] = ( b[0] - localOrigin ).Length();
+			}
+
+			const __m128 ox = _mm_load_ps( originX );
+			const __m128 oy = _mm_load_ps( originY );
+			const __m128 oz = _mm_load_ps( originZ );
+			const __m128 r = _mm_load_ps( radius );
+			__m128 out = _mm_setzero_ps();
+
+			for ( i = 0; i < numPlanes; i++ ) {
+				const idPlane &p = planes[i];
+				__m128 d = _mm_add_ps( _mm_mul_ps( _mm_set1_ps( p[0] ), ox ), _mm_mul_ps( _mm_set1_ps( p[1] ), oy ) );
+				d = _mm_add_ps( d, _mm_mul_ps( _mm_set1_ps( p[2] ), oz ) );
+				d = _mm_add_ps( d, _mm_set1_ps( p[3] ) );
+				out = _mm_or_ps( out, _mm_cmpgt_ps( d, r ) );
+			}
+			culled = _mm_movemask_ps( out ) & laneMask;
+		}
+
+		if ( useCulling >= 2 && culled != laneMask ) {
+			ALIGN16( float boundsX[2][4] );
+			ALIGN16( float boundsY[2][4] );
+			ALIGN16( float boundsZ[2][4] );
+			ALIGN16( float matrix[12][4] );
+			static const int matrixIndex[12] = { 0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14 };
+
+			for ( i = 0; i < 4; i++ ) {
+				const idBounds &b = *bounds[base + Min( i, numLanes - 1 )];
+				const float *m = modelMatrices[base + Min( i, numLanes - 1 )];
+				boundsX[0][i] = b[0][0];
+				boundsX[1][i] = b[1][0];
+				boundsY[0][i] = b[0][1];
+				boundsY[1][i] = b[1][1];
+				boundsZ[0][i] = b[0][2];
+				boundsZ[1][i] = b[1][2];
+				for ( int j = 0; j < 12; j++ ) {
+					matrix[j][i] = m[matrixIndex[j]];
+				}
+			}
+
+			__m128 m[12];
+			for ( i = 0; i < 12; i++ ) {
+				m[i] = _mm_load_ps( matrix[i] );
+			}
+
+			// transform the corners into world space like R_LocalPointToGlobal
+			__m128 cornerX[8], cornerY[8], cornerZ[8];
+			for ( i = 0; i < 8; i++ ) {
+				const __m128 vx = _mm_load_ps( boundsX[i&1] );
+				const __m128 vy = _mm_load_ps( boundsY[(i>>1)&1] );
+				const __m128 vz = _mm_load_ps( boundsZ[(i>>2)&1] );
+				cornerX[i] = _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( vx, m[0] ), _mm_mul_ps( vy, m[3] ) ), _mm_mul_ps( vz, m[6] ) ), m[9] );
+				cornerY[i] = _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( vx, m[1] ), _mm_mul_ps( vy, m[4] ) ), _mm_mul_ps( vz, m[7] ) ), m[10] );
+				cornerZ[i] = _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( vx, m[2] ), _mm_mul_ps( vy, m[5] ) ), _mm_mul_ps( vz, m[8] ) ), m[11] );
+			}
+
+			// a box is culled when all corners are behind one of the planes,
+			// the not-less-than compare treats NaN distances like the scalar test
+			const __m128 zero = _mm_setzero_ps();
+			__m128 out = _mm_setzero_ps();
+			for ( i = 0; i < numPlanes; i++ ) {
+				const idPlane &p = planes[i];
+				const __m128 pa = _mm_set1_ps( p[0] );
+				const __m128 pb = _mm_set1_ps( p[1] );
+				const __m128 pc = _mm_set1_ps( p[2] );
+				const __m128 pd = _mm_set1_ps( p[3] );
+				__m128 allBehind = _mm_cmpeq_ps( zero, zero );
+				for ( int j = 0; j < 8; j++ ) {
+					__m128 d = _mm_add_ps( _mm_mul_ps( pa, cornerX[j] ), _mm_mul_ps( pb, cornerY[j] ) );
+					d = _mm_add_ps( d, _mm_mul_ps( pc, cornerZ[j] ) );
+					d = _mm_add_ps( d, pd );
+					allBehind = _mm_and_ps( allBehind, _mm_cmpnlt_ps( d, zero ) );
+				}
+				out = _mm_or_ps( out, allBehind );
+				if ( ( ( _mm_movemask_ps( out ) | culled ) & laneMask ) == laneMask ) {
+					break;
+				}
+			}
+
+			const int tested = ~culled & laneMask;
+			const int cornerCulled = _mm_movemask_ps( out ) & tested;
+			for ( i = 0; i < numLanes; i++ ) {
+				if ( cornerCulled & ( 1 << i ) ) {
+					tr.pc.c_box_cull_out++;
+				} else if ( tested & ( 1 << i ) ) {
+					tr.pc.c_box_cull_in++;
+				}
+			}
+			culled |= cornerCulled;
+		}
+
+		for ( i = 0; i < numLanes; i++ ) {
+			if ( !( culled & ( 1 << i ) ) ) {
+				visibleBits[( base + i ) >> 5] |= 1 << ( ( base + i ) & 31 );
+				numVisible++;
+			}
+		}
+	}
+#else
+	for ( i = 0; i < numBoxes; i++ ) {
+		if ( !R_CullLocalBox( *bounds[i], modelMatrices[i], numPlanes, planes ) ) {
+			visibleBits[i >> 5] |= 1 << ( i & 31 );
+			numVisible++;
+		}
+	}
+#endif
+
+	if ( r_boxCullCapture ) {
+		R_CaptureCullLocalBoxes( numBoxes, bounds, modelMatrices, numPlanes, planes, visibleBits );
+	}
+
+	return numVisible;
+}
+
+/*
+=================
+R_TestBatchCull_f
+
+Captures the boxes culled through the portal stacks of the next frame, then
+replays them through R_CullLocalBox and R_CullLocalBoxes, checking that both
+give the same visibility and counters, and timing them.
+=================
+*/
+void R_TestBatchCull_f( const idCmdArgs &args ) {
+	boxCullCapture_t	capture;
+	idTimer				scalarTimer, batchTimer;
+	int					iterations;
+	int					i, j, k;
+	int					numBoxes, numMismatched;
+	int					scalarIn, scalarOut, batchIn, batchOut;
+
+	iterations = 100;
+	if ( args.Argc() > 1 ) {
+		iterations = Max( 1, atoi( args.Argv( 1 ) ) );
+	}
+
+	r_boxCullCapture = &capture;
+	session->UpdateScreen();
+	r_boxCullCapture = NULL;
+
+	if ( capture.batches.Num() == 0 ) {
+		common->Printf( "no boxes were batch culled, a map must be running with r_useBatchCulling 1\n" );
+		return;
+	}
+
+	numBoxes = capture.bounds.Num();
+	const idBounds **bounds = (const idBounds **)Mem_Alloc( numBoxes * sizeof( bounds[0] ) );
+	const float **matrices = (const float **)Mem_Alloc( numBoxes * sizeof( matrices[0] ) );
+	unsigned int *scalarBits = (unsigned int *)Mem_Alloc( capture.visibleBits.Num() * sizeof( scalarBits[0] ) );
+	unsigned int *batchBits = (unsigned int *)Mem_Alloc( capture.visibleBits.Num() * sizeof( batchBits[0] ) );
+
+	for ( i = 0; i < numBoxes; i++ ) {
+		bounds[i] = &capture.bounds[i];
+		matrices[i] = &capture.matrices[i * 16];
+	}
+
+	const int savedIn = tr.pc.c_box_cull_in;
+	const int savedOut = tr.pc.c_box_cull_out;
+
+	tr.pc.c_box_cull_in = tr.pc.c_box_cull_out = 0;
+	memset( scalarBits, 0, capture.visibleBits.Num() * sizeof( scalarBits[0] ) );
+	scalarTimer.Start();
+	for ( k = 0; k < iterations; k++ ) {
+		for ( i = 0; i < capture.batches.Num(); i++ ) {
+			const boxCullBatch_t &batch = capture.batches[i];
+			for ( j = 0; j < batch.numBoxes; j++ ) {
+				if ( !R_CullLocalBox( capture.bounds[batch.firstBox + j], matrices[batch.firstBox + j], batch.numPlanes, &capture.planes[batch.firstPlane] ) ) {
+					scalarBits[batch.firstBits + ( j >> 5 )] |= 1 << ( j & 31 );
+				}
+			}
+		}
+	}
+	scalarTimer.Stop();
+	scalarIn = tr.pc.c_box_cull_in;
+	scalarOut = tr.pc.c_box_cull_out;
+
+	tr.pc.c_box_cull_in = tr.pc.c_box_cull_out = 0;
+	batchTimer.Start();
+	for ( k = 0; k < iterations; k++ ) {
+		for ( i = 0; i < capture.batches.Num(); i++ ) {
+			const boxCullBatch_t &batch = capture.batches[i];
+			R_CullLocalBoxes( batch.numBoxes, bounds + batch.firstBox, matrices + batch.firstBox,
+								batch.numPlanes, &capture.planes[batch.firstPlane], batchBits + batch.firstBits );
+		}
+	}
+	batchTimer.Stop();
+	batchIn = tr.pc.c_box_cull_in;
+	batchOut = tr.pc.c_box_cull_out;
+
+	tr.pc.c_box_cull_in = savedIn;
+	tr.pc.c_box_cull_out = savedOut;
+
+	numMismatched = 0;
+	for ( i = 0; i < capture.visibleBits.Num(); i++ ) {
+		if ( scalarBits[i] != batchBits[i] || batchBits[i] != capture.visibleBits[i] ) {
+			numMismatched++;
+		}
+	}
+
+	common->Printf( "%i batches, %i boxes, %i iterations\n", capture.batches.Num(), numBoxes, iterations );
+	common->Printf( "scalar: %6.3f msec\n", scalarTimer.Milliseconds() / iterations );
+	common->Printf( "batch:  %6.3f msec\n", batchTimer.Milliseconds() / iterations );
+	if ( batchTimer.Milliseconds() > 0.0 ) {
+		common->Printf( "speedup: %4.2fx\n", scalarTimer.Milliseconds() / batchTimer.Milliseconds() );
+	}
+	if ( numMismatched ) {
+		common->Printf( "^1%i visibility words differ from the scalar cull\n", numMismatched );
+	}
+	if ( scalarIn != batchIn || scalarOut != batchOut ) {
+		common->Printf( "^1box cull counters differ: scalar in:%i out:%i, batch in:%i out:%i\n", scalarIn, scalarOut, batchIn, batchOut );
+	}
+
+	Mem_Free( bounds );
+	Mem_Free( matrices );
+	Mem_Free( scalarBits );
+	Mem_Free( batchBits );
+}
+
 /*
 ==========================
 R_TransformModelToClip
@@ -1040,10 +1432,24 @@ DRAWSURF SORTING
 */
 
 
+typedef struct {
+	uint64_t		key;
+	drawSurf_t *	surf;
+} drawSurfSort_t;
+
+// the key lists sorted while testDrawSurfSort captures a frame
+typedef struct {
+	idList<uint64_t>	keys;
+	idList<int>			numKeys;		// per view
+} drawSurfCapture_t;
+
+static drawSurfCapture_t *	r_drawSurfCapture;
+
 /*
 =======================
 R_QsortSurfaces
 
+Only used to compare against the radix sort.
 =======================
 */
 static int R_QsortSurfaces( const void *a, const void *b ) {
@@ -1052,15 +1458,72 @@ static int R_QsortSurfaces( const void *a, const void *b ) {
 	ea = *(drawSurf_t **)a;
 	eb = *(drawSurf_t **)b;
 
-	if ( ea->sort < eb->sort ) {
+	if ( ea->sortKey < eb->sortKey ) {
 		return -1;
 	}
-	if ( ea->sort > eb->sort ) {
+	if ( ea->sortKey > eb->sortKey ) {
 		return 1;
 	}
 	return 0;
 }
 
+/*
+=======================
+R_RadixSortDrawSurfs
+
+Stable LSD radix sort on the sort keys, eight bits per pass.  The keys are
+copied next to the pointers once, so no pass touches the drawSurfs, and
+passes where all keys have the same digit, which is most of the sort order
+bits, are skipped.  The scratch buffers must hold numDrawSurfs entries.
+=======================
+*/
+static void R_RadixSortDrawSurfs( drawSurf_t **drawSurfs, int numDrawSurfs, drawSurfSort_t *in, drawSurfSort_t *out ) {
+	int		counts[8][256];
+	int		i, pass;
+
+	if ( numDrawSurfs < 2 ) {
+		return;
+	}
+
+	memset( counts, 0, sizeof( counts ) );
+
+	for ( i = 0; i < numDrawSurfs; i++ ) {
+		uint64_t key = drawSurfs[i]->sortKey;
+		in[i].key = key;
+		in[i].surf = drawSurfs[i];
+		for ( pass = 0; pass < 8; pass++ ) {
+			counts[pass][( key >> ( pass * 8 ) ) & 255]++;
+		}
+	}
+
+	for ( pass = 0; pass < 8; pass++ ) {
+		int *count = counts[pass];
+		int shift = pass * 8;
+
+		if ( count[( in[0].key >> shift ) & 255] == numDrawSurfs ) {
+			continue;
+		}
+
+		int offset = 0;
+		for ( i = 0; i < 256; i++ ) {
+			int c = count[i];
+			count[i] = offset;
+			offset += c;
+		}
+
+		for ( i = 0; i < numDrawSurfs; i++ ) {
+			out[count[( in[i].key >> shift ) & 255]++] = in[i];
+		}
+
+		drawSurfSort_t *swap = in;
+		in = out;
+		out = swap;
+	}
+
+	for ( i = 0; i < numDrawSurfs; i++ ) {
+		drawSurfs[i] = in[i].surf;
+	}
+}
 
 /*
 =================
@@ -1068,9 +1531,104 @@ R_SortDrawSurfs
 =================
 */
 static void R_SortDrawSurfs( void ) {
-	// sort the drawsurfs by sort type, then orientation, then shader
-	qsort( tr.viewDef->drawSurfs, tr.viewDef->numDrawSurfs, sizeof( tr.viewDef->drawSurfs[0] ),
-		R_QsortSurfaces );
+	int numDrawSurfs = tr.viewDef->numDrawSurfs;
+
+	if ( r_drawSurfCapture ) {
+		for ( int i = 0; i < numDrawSurfs; i++ ) {
+			r_drawSurfCapture->keys.Append( tr.viewDef->drawSurfs[i]->sortKey );
+		}
+		r_drawSurfCapture->numKeys.Append( numDrawSurfs );
+	}
+
+	// sort the drawsurfs by sort type, then material, entity and depth
+	int scratchSize = numDrawSurfs * 2 * sizeof( drawSurfSort_t );
+	if ( scratchSize > r_drawSurfSortScratchSize ) {
+		Mem_Free16( r_drawSurfSortScratch );
+		r_drawSurfSortScratchSize = Max( scratchSize, r_drawSurfSortScratchSize * 2 );
+		r_drawSurfSortScratch = Mem_Alloc16( r_drawSurfSortScratchSize );
+	}
+	drawSurfSort_t *scratch = (drawSurfSort_t *)r_drawSurfSortScratch;
+	R_RadixSortDrawSurfs( tr.viewDef->drawSurfs, numDrawSurfs, scratch, scratch + numDrawSurfs );
+}
+
+/*
+=================
+R_TestDrawSurfSort_f
+
+Captures the drawSurf lists of all views of the next frame, and times
+sorting them with the radix sort against qsort on the same lists.
+=================
+*/
+void R_TestDrawSurfSort_f( const idCmdArgs &args ) {
+	drawSurfCapture_t	capture;
+	idTimer				qsortTimer, radixTimer;
+	int					iterations;
+	int					i, j, view;
+
+	iterations = 100;
+	if ( args.Argc() > 1 ) {
+		iterations = Max( 1, atoi( args.Argv( 1 ) ) );
+	}
+
+	r_drawSurfCapture = &capture;
+	session->UpdateScreen();
+	r_drawSurfCapture = NULL;
+
+	if ( capture.keys.Num() == 0 ) {
+		common->Printf( "no drawSurfs were sorted, a map must be running\n" );
+		return;
+	}
+
+	int numKeys = capture.keys.Num();
+	drawSurf_t *surfs = (drawSurf_t *)Mem_ClearedAlloc( numKeys * sizeof( surfs[0] ) );
+	drawSurf_t **unsorted = (drawSurf_t **)Mem_Alloc( numKeys * sizeof( unsorted[0] ) );
+	drawSurf_t **sorted = (drawSurf_t **)Mem_Alloc( numKeys * sizeof( sorted[0] ) );
+	drawSurf_t **check = (drawSurf_t **)Mem_Alloc( numKeys * sizeof( check[0] ) );
+	drawSurfSort_t *scratch = (drawSurfSort_t *)Mem_Alloc( numKeys * 2 * sizeof( scratch[0] ) );
+
+	for ( i = 0; i < numKeys; i++ ) {
+		surfs[i].sortKey = capture.keys[i];
+		unsorted[i] = &surfs[i];
+	}
+
+	for ( j = 0; j < iterations; j++ ) {
+		memcpy( check, unsorted, numKeys * sizeof( check[0] ) );
+		qsortTimer.Start();
+		for ( view = 0, i = 0; view < capture.numKeys.Num(); i += capture.numKeys[view++] ) {
+			qsort( check + i, capture.numKeys[view], sizeof( check[0] ), R_QsortSurfaces );
+		}
+		qsortTimer.Stop();
+
+		memcpy( sorted, unsorted, numKeys * sizeof( sorted[0] ) );
+		radixTimer.Start();
+		for ( view = 0, i = 0; view < capture.numKeys.Num(); i += capture.numKeys[view++] ) {
+			R_RadixSortDrawSurfs( sorted + i, capture.numKeys[view], scratch, scratch + numKeys );
+		}
+		radixTimer.Stop();
+	}
+
+	// qsort isn't stable, so only the keys have to come out the same
+	for ( i = 0; i < numKeys; i++ ) {
+		if ( sorted[i]->sortKey != check[i]->sortKey ) {
+			break;
+		}
+	}
+
+	common->Printf( "%i views, %i drawSurfs, %i iterations\n", capture.numKeys.Num(), numKeys, iterations );
+	common->Printf( "qsort: %6.3f msec\n", qsortTimer.Milliseconds() / iterations );
+	common->Printf( "radix: %6.3f msec\n", radixTimer.Milliseconds() / iterations );
+	if ( radixTimer.Milliseconds() > 0.0 ) {
+		common->Printf( "speedup: %4.2fx\n", qsortTimer.Milliseconds() / radixTimer.Milliseconds() );
+	}
+	if ( i != numKeys ) {
+		common->Printf( "^1sort order mismatch at drawSurf %i\n", i );
+	}
+
+	Mem_Free( surfs );
+	Mem_Free( unsorted );
+	Mem_Free( sorted );
+	Mem_Free( check );
+	Mem_Free( scratch );
 }
 
 
@@ -1106,8 +1664,6 @@ void R_RenderView( viewDef_t *parms ) {
 
 	tr.viewDef = parms;
 
-	tr.sortOffset = 0;
-
 	// set the matrix for world space to eye space
 	R_SetViewMatrix( tr.viewDef );
 
@@ -126,27 +126,29 @@ If a high order bit is clear, the point is outside the plane (definately negativ
 //#define	LIGHT_CLIP_EPSILON	0.001f
 #define	LIGHT_CLIP_EPSILON		0.1f
 
+// all of the shadow generation scratch state is thread local so interactions
+// can be created from job threads, the large buffers are allocated on first use
 #define	MAX_CLIP_SIL_EDGES		2048
-static int	numClipSilEdges;
-static int	clipSilEdges[MAX_CLIP_SIL_EDGES][2];
+static ID_THREAD_LOCAL int	numClipSilEdges;
+static ID_THREAD_LOCAL int	(*clipSilEdges)[2];
 
 // facing will be 0 if forward facing, 1 if backwards facing
 // grabbed with alloca
-static byte	*globalFacing;
+static ID_THREAD_LOCAL byte	*globalFacing;
 
 // faceCastsShadow will be 1 if the face is in the projection
 // and facing the apropriate direction
-static byte	*faceCastsShadow;
+static ID_THREAD_LOCAL byte	*faceCastsShadow;
 
-static int	*remap;
+static ID_THREAD_LOCAL int	*remap;
 
 #define	MAX_SHADOW_INDEXES		0x18000
 #define	MAX_SHADOW_VERTS		0x18000
-static int	numShadowIndexes;
-static glIndex_t	shadowIndexes[MAX_SHADOW_INDEXES];
-static int	numShadowVerts;
-static idVec4	shadowVerts[MAX_SHADOW_VERTS];
-static bool overflowed;
+static ID_THREAD_LOCAL int	numShadowIndexes;
+static ID_THREAD_LOCAL glIndex_t	*shadowIndexes;
+static ID_THREAD_LOCAL int	numShadowVerts;
+static ID_THREAD_LOCAL idVec4	*shadowVerts;
+static ID_THREAD_LOCAL bool overflowed;
 
 idPlane	pointLightFrustums[6][6] = {
 	{
@@ -201,9 +203,10 @@ idPlane	pointLightFrustums[6][6] = {
 	},
 };
 
-int	c_caps, c_sils;
+// shadow volumes are created from job threads
+volatile int	c_caps, c_sils;
 
-static bool	callOptimizer;			// call the preprocessor optimizer after clipping occluders
+static ID_THREAD_LOCAL bool	callOptimizer;			// call the preprocessor optimizer after clipping occluders
 
 typedef struct {
 	int		frontCapStart;
@@ -211,8 +214,26 @@ typedef struct {
 	int		silStart;
 	int		end;
 } indexRef_t;
-static indexRef_t	indexRef[6];
-static int indexFrustumNumber;		// which shadow generating side of a light the indexRef is for
+static ID_THREAD_LOCAL indexRef_t	indexRef[6];
+static ID_THREAD_LOCAL int indexFrustumNumber;		// which shadow generating side of a light the indexRef is for
+
+/*
+===============
+R_AllocShadowScratch
+
+The scratch buffers are too large for thread local storage, so each thread
+that generates shadow volumes gets its own copy the first time it needs one.
+They live as long as the thread, which for the job workers is the whole run.
+===============
+*/
+static void R_AllocShadowScratch( void ) {
+	if ( shadowVerts != NULL ) {
+		return;
+	}
+	clipSilEdges = (int (*)[2])Mem_Alloc16( MAX_CLIP_SIL_EDGES * sizeof( clipSilEdges[0] ) );
+	shadowIndexes = (glIndex_t *)Mem_Alloc16( MAX_SHADOW_INDEXES * sizeof( shadowIndexes[0] ) );
+	shadowVerts = (idVec4 *)Mem_Alloc16( MAX_SHADOW_VERTS * sizeof( shadowVerts[0] ) );
+}
 
 /*
 ===============
@@ -994,7 +1015,7 @@ static void R_CreateShadowVolumeInFrustum( const idRenderEntityLocal *ent,
 	}
 	numShadowIndexes += numCapIndexes;
 
-c_caps += numCapIndexes * 2;
+Sys_InterlockedAdd( c_caps, numCapIndexes * 2 );
 
 int preSilIndexes = numShadowIndexes;
 
@@ -1008,7 +1029,7 @@ int preSilIndexes = numShadowIndexes;
 	// non-shadowing triangle will cast a silhouette edge
 	R_AddSilEdges( tri, pointCull, frustum );
 
-c_sils += numShadowIndexes - preSilIndexes;
+Sys_InterlockedAdd( c_sils, numShadowIndexes - preSilIndexes );
 
 	// project all of the vertexes to the shadow plane, generating
 	// an equal number of back vertexes
@@ -1238,7 +1259,7 @@ srfTriangles_t *R_CreateShadowVolume( const idRenderEntityLocal *ent,
 		common->Error( "R_CreateShadowVolume: tri->numVerts = %i", tri->numVerts );
 	}
 
-	tr.pc.c_createShadowVolumes++;
+	Sys_InterlockedIncrement( tr.pc.c_createShadowVolumes );
 
 	// use the fast infinite projection in dynamic situations, which
 	// trades somewhat more overdraw and no cap optimizations for
@@ -1263,6 +1284,8 @@ srfTriangles_t *R_CreateShadowVolume( const idRenderEntityLocal *ent,
 		return NULL;
 	}
 
+	R_AllocShadowScratch();
+
 	// clear the shadow volume
 	numShadowIndexes = 0;
 	numShadowVerts = 0;
@@ -126,6 +126,10 @@ static int			numPlanes;
 
 static idBlockAlloc<srfTriangles_t, 1<<8>				srfTrianglesAllocator;
 
+// interactions and shadow volumes are created from job threads, so every
+// allocator access below goes through this lock
+static idSysSpinLock								triSurfAllocLock;
+
 #ifdef USE_TRI_DATA_ALLOCATOR
 static idDynamicBlockAlloc<idDrawVert, 1<<20, 1<<10>	triVertexAllocator;
 static idDynamicBlockAlloc<glIndex_t, 1<<18, 1<<10>		triIndexAllocator;
@@ -210,6 +214,7 @@ void R_PurgeTriSurfData( frameData_t *frame ) {
 	R_FreeDeferredTriSurfs( frame );
 
 	// free empty base blocks
+	triSurfAllocLock.Lock();
 	triVertexAllocator.FreeEmptyBaseBlocks();
 	triIndexAllocator.FreeEmptyBaseBlocks();
 	triShadowVertexAllocator.FreeEmptyBaseBlocks();
@@ -219,6 +224,7 @@ void R_PurgeTriSurfData( frameData_t *frame ) {
 	triDominantTrisAllocator.FreeEmptyBaseBlocks();
 	triMirroredVertAllocator.FreeEmptyBaseBlocks();
 	triDupVertAllocator.FreeEmptyBaseBlocks();
+	triSurfAllocLock.Unlock();
 }
 
 /*
@@ -361,6 +367,8 @@ void R_ReallyFreeStaticTriSurf( srfTriangles_t *tri ) {
 
 	R_FreeStaticTriSurfVertexCaches( tri );
 
+	triSurfAllocLock.Lock();
+
 	if ( tri->verts != NULL ) {
 		// R_CreateLightTris points tri->verts at the verts of the ambient surface
 		if ( tri->ambientSurface == NULL || tri->verts != tri->ambientSurface->verts ) {
@@ -405,6 +413,8 @@ void R_ReallyFreeStaticTriSurf( srfTriangles_t *tri ) {
 #endif
 
 	srfTrianglesAllocator.Free( tri );
+
+	triSurfAllocLock.Unlock();
 }
 
 /*
@@ -504,7 +514,9 @@ R_AllocStaticTriSurf
 ==============
 */
 srfTriangles_t *R_AllocStaticTriSurf( void ) {
+	triSurfAllocLock.Lock();
 	srfTriangles_t *tris = srfTrianglesAllocator.Alloc();
+	triSurfAllocLock.Unlock();
 	memset( tris, 0, sizeof( srfTriangles_t ) );
 	return tris;
 }
@@ -537,7 +549,9 @@ R_AllocStaticTriSurfVerts
 */
 void R_AllocStaticTriSurfVerts( srfTriangles_t *tri, int numVerts ) {
 	assert( tri->verts == NULL );
+	triSurfAllocLock.Lock();
 	tri->verts = triVertexAllocator.Alloc( numVerts );
+	triSurfAllocLock.Unlock();
 }
 
 /*
@@ -547,7 +561,9 @@ R_AllocStaticTriSurfIndexes
 */
 void R_AllocStaticTriSurfIndexes( srfTriangles_t *tri, int numIndexes ) {
 	assert( tri->indexes == NULL );
+	triSurfAllocLock.Lock();
 	tri->indexes = triIndexAllocator.Alloc( numIndexes );
+	triSurfAllocLock.Unlock();
 }
 
 /*
@@ -557,7 +573,9 @@ R_AllocStaticTriSurfShadowVerts
 */
 void R_AllocStaticTriSurfShadowVerts( srfTriangles_t *tri, int numVerts ) {
 	assert( tri->shadowVertexes == NULL );
+	triSurfAllocLock.Lock();
 	tri->shadowVertexes = triShadowVertexAllocator.Alloc( numVerts );
+	triSurfAllocLock.Unlock();
 }
 
 /*
@@ -566,10 +584,12 @@ R_AllocStaticTriSurfPlanes
 =================
 */
 void R_AllocStaticTriSurfPlanes( srfTriangles_t *tri, int numIndexes ) {
+	triSurfAllocLock.Lock();
 	if ( tri->facePlanes ) {
 		triPlaneAllocator.Free( tri->facePlanes );
 	}
 	tri->facePlanes = triPlaneAllocator.Alloc( numIndexes / 3 );
+	triSurfAllocLock.Unlock();
 }
 
 /*
@@ -579,7 +599,9 @@ R_ResizeStaticTriSurfVerts
 */
 void R_ResizeStaticTriSurfVerts( srfTriangles_t *tri, int numVerts ) {
 #ifdef USE_TRI_DATA_ALLOCATOR
+	triSurfAllocLock.Lock();
 	tri->verts = triVertexAllocator.Resize( tri->verts, numVerts );
+	triSurfAllocLock.Unlock();
 #else
 	assert( false );
 #endif
@@ -592,7 +614,9 @@ R_ResizeStaticTriSurfIndexes
 */
 void R_ResizeStaticTriSurfIndexes( srfTriangles_t *tri, int numIndexes ) {
 #ifdef USE_TRI_DATA_ALLOCATOR
+	triSurfAllocLock.Lock();
 	tri->indexes = triIndexAllocator.Resize( tri->indexes, numIndexes );
+	triSurfAllocLock.Unlock();
 #else
 	assert( false );
 #endif
@@ -605,7 +629,9 @@ R_ResizeStaticTriSurfShadowVerts
 */
 void R_ResizeStaticTriSurfShadowVerts( srfTriangles_t *tri, int numVerts ) {
 #ifdef USE_TRI_DATA_ALLOCATOR
+	triSurfAllocLock.Lock();
 	tri->shadowVertexes = triShadowVertexAllocator.Resize( tri->shadowVertexes, numVerts );
+	triSurfAllocLock.Unlock();
 #else
 	assert( false );
 #endif
@@ -635,7 +661,9 @@ R_FreeStaticTriSurfSilIndexes
 =================
 */
 void R_FreeStaticTriSurfSilIndexes( srfTriangles_t *tri ) {
+	triSurfAllocLock.Lock();
 	triSilIndexAllocator.Free( tri->silIndexes );
+	triSurfAllocLock.Unlock();
 	tri->silIndexes = NULL;
 }
 
@@ -750,14 +778,18 @@ void R_CreateSilIndexes( srfTriangles_t *tri ) {
 	int		*remap;
 
 	if ( tri->silIndexes ) {
+		triSurfAllocLock.Lock();
 		triSilIndexAllocator.Free( tri->silIndexes );
+		triSurfAllocLock.Unlock();
 		tri->silIndexes = NULL;
 	}
 
 	remap = R_CreateSilRemap( tri );
 
 	// remap indexes to the first one
+	triSurfAllocLock.Lock();
 	tri->silIndexes = triSilIndexAllocator.Alloc( tri->numIndexes );
+	triSurfAllocLock.Unlock();
 	for ( i = 0; i < tri->numIndexes; i++ ) {
 		tri->silIndexes[i] = remap[tri->indexes[i]];
 	}
@@ -796,7 +828,9 @@ void R_CreateDupVerts( srfTriangles_t *tri ) {
 		}
 	}
 
+	triSurfAllocLock.Lock();
 	tri->dupVerts = triDupVertAllocator.Alloc( tri->numDupVerts * 2 );
+	triSurfAllocLock.Unlock();
 	memcpy( tri->dupVerts, tempDupVerts, tri->numDupVerts * 2 * sizeof( tri->dupVerts[0] ) );
 }
 
@@ -1095,7 +1129,9 @@ void R_IdentifySilEdges( srfTriangles_t *tri, bool omitCoplanarEdges ) {
 	}
 
 	tri->numSilEdges = numSilEdges;
+	triSurfAllocLock.Lock();
 	tri->silEdges = triSilEdgeAllocator.Alloc( numSilEdges );
+	triSurfAllocLock.Unlock();
 	memcpy( tri->silEdges, silEdges, numSilEdges * sizeof( tri->silEdges[0] ) );
 }
 
@@ -1287,15 +1323,20 @@ static void	R_DuplicateMirroredVertexes( srfTriangles_t *tri ) {
 		return;
 	}
 
+	triSurfAllocLock.Lock();
 	tri->mirroredVerts = triMirroredVertAllocator.Alloc( tri->numMirroredVerts );
-
 #ifdef USE_TRI_DATA_ALLOCATOR
 	tri->verts = triVertexAllocator.Resize( tri->verts, totalVerts );
-#else
+#endif
+	triSurfAllocLock.Unlock();
+
+#ifndef USE_TRI_DATA_ALLOCATOR
 	idDrawVert *oldVerts = tri->verts;
 	R_AllocStaticTriSurfVerts( tri, totalVerts );
 	memcpy( tri->verts, oldVerts, tri->numVerts * sizeof( tri->verts[0] ) );
+	triSurfAllocLock.Lock();
 	triVertexAllocator.Free( oldVerts );
+	triSurfAllocLock.Unlock();
 #endif
 
 	// create the duplicates
@@ -1461,7 +1502,9 @@ void R_BuildDominantTris( srfTriangles_t *tri ) {
 	}
 	qsort( ind, tri->numIndexes, sizeof( *ind ), IndexSort );
 
+	triSurfAllocLock.Lock();
 	tri->dominantTris = dt = triDominantTrisAllocator.Alloc( tri->numVerts );
+	triSurfAllocLock.Unlock();
 	memset( dt, 0, tri->numVerts * sizeof( dt[0] ) );
 
 	for ( i = 0; i < tri->numIndexes; i += j ) {
@@ -1640,7 +1683,7 @@ void R_DeriveTangents( srfTriangles_t *tri, bool allocFacePlanes ) {
 		return;
 	}
 
-	tr.pc.c_tangentIndexes += tri->numIndexes;
+	Sys_InterlockedAdd( tr.pc.c_tangentIndexes, tri->numIndexes );
 
 	if ( !tri->facePlanes && allocFacePlanes ) {
 		R_AllocStaticTriSurfPlanes( tri, tri->numIndexes );
@@ -2186,6 +2229,7 @@ deformInfo_t *R_BuildDeformInfo( int numVerts, const idDrawVert *verts, int numI
 	deform->numDupVerts = tri.numDupVerts;
 	deform->dupVerts = tri.dupVerts;
 
+	triSurfAllocLock.Lock();
 	if ( tri.verts ) {
 		triVertexAllocator.Free( tri.verts );
 	}
@@ -2193,6 +2237,7 @@ deformInfo_t *R_BuildDeformInfo( int numVerts, const idDrawVert *verts, int numI
 	if ( tri.facePlanes ) {
 		triPlaneAllocator.Free( tri.facePlanes );
 	}
+	triSurfAllocLock.Unlock();
 
 	return deform;
 }
@@ -2203,6 +2248,7 @@ R_FreeDeformInfo
 ===================
 */
 void R_FreeDeformInfo( deformInfo_t *deformInfo ) {
+	triSurfAllocLock.Lock();
 	if ( deformInfo->indexes != NULL ) {
 		triIndexAllocator.Free( deformInfo->indexes );
 	}
@@ -2221,6 +2267,7 @@ void R_FreeDeformInfo( deformInfo_t *deformInfo ) {
 	if ( deformInfo->dupVerts != NULL ) {
 		triDupVertAllocator.Free( deformInfo->dupVerts );
 	}
+	triSurfAllocLock.Unlock();
 	R_StaticFree( deformInfo );
 }
 
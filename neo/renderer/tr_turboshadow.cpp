@@ -31,8 +31,8 @@ If you have questions concerning this license or the applicable additional terms
 
 #include "tr_local.h"
 
-int	c_turboUsedVerts;
-int c_turboUnusedVerts;
+volatile int	c_turboUsedVerts;
+volatile int	c_turboUnusedVerts;
 
 
 /*
@@ -265,8 +265,8 @@ srfTriangles_t *R_CreateTurboShadowVolume( const idRenderEntityLocal *ent,
 
 	newTri->numVerts = SIMDProcessor->CreateShadowCache( &shadowVerts->xyz, vertRemap, localLightOrigin, tri->verts, tri->numVerts );
 
-	c_turboUsedVerts += newTri->numVerts;
-	c_turboUnusedVerts += tri->numVerts * 2 - newTri->numVerts;
+	Sys_InterlockedAdd( c_turboUsedVerts, newTri->numVerts );
+	Sys_InterlockedAdd( c_turboUnusedVerts, tri->numVerts * 2 - newTri->numVerts );
 
 #ifdef USE_TRI_DATA_ALLOCATOR
 	R_ResizeStaticTriSurfShadowVerts( newTri, newTri->numVerts );
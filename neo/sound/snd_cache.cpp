@@ -38,6 +38,17 @@ static idDynamicBlockAlloc<byte, 1<<20, 1<<10>	soundCacheAllocator;
 static idDynamicAlloc<byte, 1<<20, 1<<10>		soundCacheAllocator;
 #endif
 
+static idJobCounter		soundPrefetchCounter;
+
+/*
+===================
+SoundPrefetchJob
+===================
+*/
+static void SoundPrefetchJob( void *data ) {
+	static_cast<idSoundSample *>( data )->Prefetch();
+}
+
 
 /*
 ===================
@@ -182,7 +193,7 @@ Free all samples marked as unused
 ====================
 */
 void idSoundCache::EndLevelLoad() {
-	int	useCount, purgeCount;
+	int	useCount, purgeCount, prefetchCount;
 	common->Printf( "----- idSoundCache::EndLevelLoad -----\n" );
 
 	insideLevelLoad = false;
@@ -190,6 +201,7 @@ void idSoundCache::EndLevelLoad() {
 	// purge the ones we don't need
 	useCount = 0;
 	purgeCount = 0;
+	prefetchCount = 0;
 	for ( int i = 0 ; i < listCache.Num() ; i++ ) {
 		idSoundSample	*sample = listCache[ i ];
 		if ( !sample ) {
@@ -204,13 +216,23 @@ void idSoundCache::EndLevelLoad() {
 			sample->PurgeSoundSample();
 		} else {
 			useCount += sample->objectMemSize;
+
+			// decode the start of streamed OGG samples on the job workers so they don't stall the mixer when they start playing
+			if ( sample->objectInfo.wFormatTag == WAVE_FORMAT_TAG_OGG && sample->nonCacheData != NULL && !sample->hardwareBuffer && !sample->defaultSound
+					&& sample->prefetchData == NULL && idSoundSystemLocal::s_decodePrefetchMsec.GetInteger() > 0 ) {
+				jobSystem->Submit( SoundPrefetchJob, sample, &soundPrefetchCounter );
+				prefetchCount++;
+			}
 		}
 	}
 
 	soundCacheAllocator.FreeEmptyBaseBlocks();
 
+	idSampleDecoder::ClearCacheStats();
+
 	common->Printf( "%5ik referenced\n", useCount / 1024 );
 	common->Printf( "%5ik purged\n", purgeCount / 1024 );
+	common->Printf( "%5i sounds prefetching\n", prefetchCount );
 	common->Printf( "----------------------------------------\n" );
 }
 
@@ -291,6 +313,8 @@ idSoundSample::idSoundSample() {
 	objectSize = 0;
 	objectMemSize = 0;
 	nonCacheData = NULL;
+	prefetchData = NULL;
+	prefetchSize = 0;
 	amplitudeData = NULL;
 	openalBuffer = NULL;
 	hardwareBuffer = false;
@@ -644,12 +668,57 @@ void idSoundSample::PurgeSoundSample() {
 		amplitudeData = NULL;
 	}
 
+	if ( prefetchData || !soundPrefetchCounter.IsDone() ) {
+		// the prefetch jobs read nonCacheData
+		jobSystem->Wait( &soundPrefetchCounter );
+		Mem_Free( prefetchData );
+		prefetchData = NULL;
+		prefetchSize = 0;
+	}
+
 	if ( nonCacheData ) {
 		soundCacheAllocator.Free( nonCacheData );
 		nonCacheData = NULL;
 	}
 }
 
+/*
+===================
+idSoundSample::Prefetch
+
+Decodes the start of an OGG sample, called from the job workers. The samples
+are stored unclamped and unscaled like the OGG decoder outputs them, one plane
+per channel, so the decoders upsample them exactly like the samples they decode
+from the OGG stream.
+===================
+*/
+void idSoundSample::Prefetch( void ) {
+	int shift = 22050 / objectInfo.nSamplesPerSec;
+	int count = objectInfo.nSamplesPerSec * idSoundSystemLocal::s_decodePrefetchMsec.GetInteger() / 1000 * objectInfo.nChannels;
+
+	count = Min( count, objectSize );
+	count -= count % objectInfo.nChannels;
+	if ( count <= 0 ) {
+		return;
+	}
+
+	float *samples = (float *) Mem_Alloc16( ( count << shift ) * sizeof( float ) );
+	if ( idSampleDecoder::DecodeSample( this, count << shift, samples ) == ( count << shift ) ) {
+		const int numFrames = count / objectInfo.nChannels;
+		float *data = (float *) Mem_Alloc( count * sizeof( float ) );
+		// the decoded samples are upsampled to 44kHz, keep every ( 1 << shift ) frame
+		for ( int i = 0; i < numFrames; i++ ) {
+			const float *src = samples + ( ( i * objectInfo.nChannels ) << shift );
+			for ( int j = 0; j < objectInfo.nChannels; j++ ) {
+				data[j * numFrames + i] = src[j] * ( 1.0f / 32768.0f );
+			}
+		}
+		prefetchData = data;
+		Sys_InterlockedExchange( prefetchSize, count );
+	}
+	Mem_Free16( samples );
+}
+
 /*
 ===================
 idSoundSample::Reload
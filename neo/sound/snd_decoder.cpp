@@ -40,11 +40,13 @@ If you have questions concerning this license or the applicable additional terms
   Thread safe decoder memory allocator.
 
   Each OggVorbis decoder consumes about 150kB of memory.
+  Decoders run in parallel on the job workers, so the allocator has its own lock.
 
 ===================================================================================
 */
 
 idDynamicBlockAlloc<byte, 1<<20, 128>		decoderMemoryAllocator;
+static idSysSpinLock						decoderMemoryLock;
 
 const int MIN_OGGVORBIS_MEMORY				= 768 * 1024;
 
@@ -56,26 +58,34 @@ extern "C" {
 }
 
 void *_decoder_malloc( size_t size ) {
+	decoderMemoryLock.Lock();
 	void *ptr = decoderMemoryAllocator.Alloc( size );
+	decoderMemoryLock.Unlock();
 	assert( size == 0 || ptr != NULL );
 	return ptr;
 }
 
 void *_decoder_calloc( size_t num, size_t size ) {
+	decoderMemoryLock.Lock();
 	void *ptr = decoderMemoryAllocator.Alloc( num * size );
+	decoderMemoryLock.Unlock();
 	assert( ( num * size ) == 0 || ptr != NULL );
 	memset( ptr, 0, num * size );
 	return ptr;
 }
 
 void *_decoder_realloc( void *memblock, size_t size ) {
+	decoderMemoryLock.Lock();
 	void *ptr = decoderMemoryAllocator.Resize( (byte *)memblock, size );
+	decoderMemoryLock.Unlock();
 	assert( size == 0 || ptr != NULL );
 	return ptr;
 }
 
 void _decoder_free( void *memblock ) {
+	decoderMemoryLock.Lock();
 	decoderMemoryAllocator.Free( (byte *)memblock );
+	decoderMemoryLock.Unlock();
 }
 
 
@@ -281,6 +291,9 @@ int idWaveFile::CloseOGG( void ) {
 
 class idSampleDecoderLocal : public idSampleDecoder {
 public:
+							idSampleDecoderLocal( void );
+							~idSampleDecoderLocal( void );
+
 	virtual void			Decode( idSoundSample *sample, int sampleOffset44k, int sampleCount44k, float *dest );
 	virtual void			ClearDecoder( void );
 	virtual idSoundSample *	GetSample( void ) const;
@@ -290,6 +303,8 @@ public:
 	int						DecodePCM( idSoundSample *sample, int sampleOffset44k, int sampleCount44k, float *dest );
 	int						DecodeOGG( idSoundSample *sample, int sampleOffset44k, int sampleCount44k, float *dest );
 
+	idJobCounter			aheadCounter;		// decode ahead job in flight
+
 private:
 	bool					failed;				// set if decoding failed
 	int						lastFormat;			// last format being decoded
@@ -299,8 +314,41 @@ private:
 	idFile_Memory			file;				// encoded file in memory
 
 	OggVorbis_File			ogg;				// OggVorbis file
+	bool					oggOpen;			// ogg is opened on lastSample
+
+	idSysSpinLock			decodeLock;			// the sound thread, the mixing jobs and shakes on the main thread can decode
+
+	// ring of 44kHz samples decoded ahead of the play cursor on the job workers
+	float *					aheadSamples;
+	int						aheadAlloced;		// allocated size of aheadSamples
+	int						aheadSize;			// ring size in use, a multiple of the block size of lastSample
+	int						aheadFirst;			// ring index of aheadOffset44k
+	int						aheadOffset44k;		// sample offset of the first decoded sample
+	int						aheadCount44k;		// number of decoded samples in the ring
+	int						playCursor44k;		// end of the last decoded request
+
+	bool					DecodeCached( idSoundSample *sample, int sampleOffset44k, int sampleCount44k, float *dest );
+	void					AdvancePlayCursor( idSoundSample *sample, int sampleEnd44k );
+	bool					WantsDecodeAhead( void ) const;
+	void					DecodeAhead( void );
+	static void				DecodeAheadJob( void *data );
 };
 
+/*
+===================================================================================
+
+  Decode cache statistics, updated from any thread.
+
+===================================================================================
+*/
+
+static volatile int		decodePrefetchHits;
+static volatile int		decodeAheadHits;
+static volatile int		decodeMisses;
+static volatile int		decodeMissUsec;
+static volatile int		decodeMissMaxUsec;
+static volatile int		decodeAheadBlocks;
+
 idBlockAlloc<idSampleDecoderLocal, 64>		sampleDecoderAllocator;
 
 /*
@@ -342,6 +390,9 @@ idSampleDecoder::Free
 */
 void idSampleDecoder::Free( idSampleDecoder *decoder ) {
 	idSampleDecoderLocal *localDecoder = static_cast<idSampleDecoderLocal *>( decoder );
+	if ( !localDecoder->aheadCounter.IsDone() ) {
+		jobSystem->Wait( &localDecoder->aheadCounter );
+	}
 	localDecoder->ClearDecoder();
 	sampleDecoderAllocator.Free( localDecoder );
 }
@@ -364,6 +415,81 @@ int idSampleDecoder::GetUsedBlockMemory( void ) {
 	return decoderMemoryAllocator.GetUsedBlockMemory();
 }
 
+/*
+====================
+idSampleDecoder::DecodeSample
+
+Decodes the start of a sample with a temporary decoder, this doesn't touch any of
+the decoders owned by sound channels so it can run on the job workers.
+Returns the number of 44kHz samples that were decoded.
+====================
+*/
+int idSampleDecoder::DecodeSample( idSoundSample *sample, int sampleCount44k, float *dest ) {
+	idSampleDecoderLocal decoder;
+	int readSamples44k;
+
+	decoder.Clear();
+	if ( sample->objectInfo.wFormatTag == WAVE_FORMAT_TAG_OGG ) {
+		readSamples44k = decoder.DecodeOGG( sample, 0, sampleCount44k, dest );
+	} else {
+		readSamples44k = decoder.DecodePCM( sample, 0, sampleCount44k, dest );
+	}
+	decoder.ClearDecoder();
+
+	return readSamples44k;
+}
+
+/*
+====================
+idSampleDecoder::ClearCacheStats
+====================
+*/
+void idSampleDecoder::ClearCacheStats( void ) {
+	decodePrefetchHits = 0;
+	decodeAheadHits = 0;
+	decodeMisses = 0;
+	decodeMissUsec = 0;
+	decodeMissMaxUsec = 0;
+	decodeAheadBlocks = 0;
+}
+
+/*
+====================
+idSampleDecoder::PrintCacheStats
+====================
+*/
+void idSampleDecoder::PrintCacheStats( void ) {
+	int total = decodePrefetchHits + decodeAheadHits + decodeMisses;
+
+	common->Printf( "OGG decode cache: %d prefetch hits, %d decode ahead hits, %d misses (%d%% hits)\n",
+					decodePrefetchHits, decodeAheadHits, decodeMisses, total ? ( total - decodeMisses ) * 100 / total : 0 );
+	common->Printf( "%d blocks decoded ahead, miss latency %d usec average, %d usec worst\n",
+					decodeAheadBlocks, decodeMisses ? decodeMissUsec / decodeMisses : 0, decodeMissMaxUsec );
+}
+
+/*
+====================
+idSampleDecoderLocal::idSampleDecoderLocal
+====================
+*/
+idSampleDecoderLocal::idSampleDecoderLocal( void ) {
+	memset( &ogg, 0, sizeof( ogg ) );
+	oggOpen = false;
+	aheadSamples = NULL;
+	aheadAlloced = 0;
+	Clear();
+}
+
+/*
+====================
+idSampleDecoderLocal::~idSampleDecoderLocal
+====================
+*/
+idSampleDecoderLocal::~idSampleDecoderLocal( void ) {
+	assert( !oggOpen );
+	Mem_Free16( aheadSamples );
+}
+
 /*
 ====================
 idSampleDecoderLocal::Clear
@@ -375,6 +501,11 @@ void idSampleDecoderLocal::Clear( void ) {
 	lastSample = NULL;
 	lastSampleOffset = 0;
 	lastDecodeTime = 0;
+	aheadSize = 0;
+	aheadFirst = 0;
+	aheadOffset44k = 0;
+	aheadCount44k = 0;
+	playCursor44k = 0;
 }
 
 /*
@@ -383,22 +514,25 @@ idSampleDecoderLocal::ClearDecoder
 ====================
 */
 void idSampleDecoderLocal::ClearDecoder( void ) {
-	Sys_EnterCriticalSection( CRITICAL_SECTION_ONE );
+	decodeLock.Lock();
 
 	switch( lastFormat ) {
 		case WAVE_FORMAT_TAG_PCM: {
 			break;
 		}
 		case WAVE_FORMAT_TAG_OGG: {
-			ov_clear( &ogg );
-			memset( &ogg, 0, sizeof( ogg ) );
+			if ( oggOpen ) {
+				ov_clear( &ogg );
+				memset( &ogg, 0, sizeof( ogg ) );
+				oggOpen = false;
+			}
 			break;
 		}
 	}
 
 	Clear();
 
-	Sys_LeaveCriticalSection( CRITICAL_SECTION_ONE );
+	decodeLock.Unlock();
 }
 
 /*
@@ -438,8 +572,9 @@ void idSampleDecoderLocal::Decode( idSoundSample *sample, int sampleOffset44k, i
 		return;
 	}
 
-	// samples can be decoded both from the sound thread and the main thread for shakes
-	Sys_EnterCriticalSection( CRITICAL_SECTION_ONE );
+	// samples can be decoded both from the sound thread and the main thread for shakes,
+	// different decoders don't share any state so they only lock themselves
+	decodeLock.Lock();
 
 	switch( sample->objectInfo.wFormatTag ) {
 		case WAVE_FORMAT_TAG_PCM: {
@@ -447,7 +582,22 @@ void idSampleDecoderLocal::Decode( idSoundSample *sample, int sampleOffset44k, i
 			break;
 		}
 		case WAVE_FORMAT_TAG_OGG: {
-			readSamples44k = DecodeOGG( sample, sampleOffset44k, sampleCount44k, dest );
+			if ( DecodeCached( sample, sampleOffset44k, sampleCount44k, dest ) ) {
+				readSamples44k = sampleCount44k;
+			} else {
+				double startTicks = Sys_GetClockTicks();
+				readSamples44k = DecodeOGG( sample, sampleOffset44k, sampleCount44k, dest );
+				int usec = idMath::FtoiFast( ( Sys_GetClockTicks() - startTicks ) * 1000000.0 / Sys_ClockTicksPerSecond() );
+
+				Sys_InterlockedIncrement( decodeMisses );
+				Sys_InterlockedAdd( decodeMissUsec, usec );
+				for ( int maxUsec = decodeMissMaxUsec; usec > maxUsec; maxUsec = decodeMissMaxUsec ) {
+					if ( Sys_InterlockedCompareExchange( decodeMissMaxUsec, maxUsec, usec ) == maxUsec ) {
+						break;
+					}
+				}
+			}
+			AdvancePlayCursor( sample, sampleOffset44k + sampleCount44k );
 			break;
 		}
 		default: {
@@ -456,13 +606,165 @@ void idSampleDecoderLocal::Decode( idSoundSample *sample, int sampleOffset44k, i
 		}
 	}
 
-	Sys_LeaveCriticalSection( CRITICAL_SECTION_ONE );
+	bool decodeAhead = WantsDecodeAhead();
+
+	decodeLock.Unlock();
+
+	// only one decode ahead job per decoder is in flight
+	if ( decodeAhead && aheadCounter.IsDone() ) {
+		jobSystem->Submit( DecodeAheadJob, this, &aheadCounter );
+	}
 
 	if ( readSamples44k < sampleCount44k ) {
 		memset( dest + readSamples44k, 0, ( sampleCount44k - readSamples44k ) * sizeof( dest[0] ) );
 	}
 }
 
+/*
+====================
+idSampleDecoderLocal::DecodeCached
+
+Copies the samples from the level load prefetch or the decode ahead ring,
+returns false if the whole range isn't available.
+====================
+*/
+bool idSampleDecoderLocal::DecodeCached( idSoundSample *sample, int sampleOffset44k, int sampleCount44k, float *dest ) {
+	int shift = 22050 / sample->objectInfo.nSamplesPerSec;
+
+	// start of the sample decoded at level load
+	if ( sampleOffset44k + sampleCount44k <= ( sample->prefetchSize << shift ) ) {
+		const int numFrames = sample->prefetchSize / sample->objectInfo.nChannels;
+		const int frame = ( sampleOffset44k >> shift ) / sample->objectInfo.nChannels;
+		const float *planes[2] = { sample->prefetchData + frame, sample->prefetchData + numFrames + frame };
+		SIMDProcessor->UpSampleOGGTo44kHz( dest, planes, sampleCount44k >> shift, sample->objectInfo.nSamplesPerSec, sample->objectInfo.nChannels );
+		lastFormat = WAVE_FORMAT_TAG_OGG;
+		lastSample = sample;
+		Sys_InterlockedIncrement( decodePrefetchHits );
+		return true;
+	}
+
+	// decoded ahead of the play cursor
+	if ( lastSample == sample && aheadCount44k > 0 && sampleOffset44k >= aheadOffset44k && sampleOffset44k + sampleCount44k <= aheadOffset44k + aheadCount44k ) {
+		int index = ( aheadFirst + sampleOffset44k - aheadOffset44k ) % aheadSize;
+		int count = Min( sampleCount44k, aheadSize - index );
+		memcpy( dest, aheadSamples + index, count * sizeof( float ) );
+		memcpy( dest + count, aheadSamples, ( sampleCount44k - count ) * sizeof( float ) );
+		Sys_InterlockedIncrement( decodeAheadHits );
+		return true;
+	}
+
+	return false;
+}
+
+/*
+====================
+idSampleDecoderLocal::AdvancePlayCursor
+
+drops the decoded ahead samples before the new play cursor, or all of them if the cursor jumped
+====================
+*/
+void idSampleDecoderLocal::AdvancePlayCursor( idSoundSample *sample, int sampleEnd44k ) {
+	playCursor44k = sampleEnd44k;
+
+	if ( aheadCount44k > 0 ) {
+		if ( sampleEnd44k > aheadOffset44k + aheadCount44k || sampleEnd44k + aheadSize < aheadOffset44k ) {
+			aheadCount44k = 0;
+		} else if ( sampleEnd44k > aheadOffset44k ) {
+			int skip = sampleEnd44k - aheadOffset44k;
+			aheadFirst = ( aheadFirst + skip ) % aheadSize;
+			aheadOffset44k = sampleEnd44k;
+			aheadCount44k -= skip;
+		}
+	}
+
+	// the ring size can only change while it is empty
+	if ( aheadCount44k == 0 ) {
+		int size = idSoundSystemLocal::s_decodeAheadBlocks.GetInteger() * MIXBUFFER_SAMPLES * sample->objectInfo.nChannels;
+		if ( size > aheadAlloced ) {
+			Mem_Free16( aheadSamples );
+			aheadSamples = (float *) Mem_Alloc16( size * sizeof( float ) );
+			aheadAlloced = size;
+		}
+		aheadSize = size;
+		aheadFirst = 0;
+	}
+}
+
+/*
+====================
+idSampleDecoderLocal::WantsDecodeAhead
+====================
+*/
+bool idSampleDecoderLocal::WantsDecodeAhead( void ) const {
+	if ( failed || lastSample == NULL || lastFormat != WAVE_FORMAT_TAG_OGG || aheadSize == 0 ) {
+		return false;
+	}
+	int blockSize = MIXBUFFER_SAMPLES * lastSample->objectInfo.nChannels;
+	int aheadEnd44k = ( aheadCount44k > 0 ) ? aheadOffset44k + aheadCount44k : playCursor44k;
+	return ( aheadCount44k + blockSize <= aheadSize && aheadEnd44k < lastSample->LengthIn44kHzSamples() );
+}
+
+/*
+====================
+idSampleDecoderLocal::DecodeAhead
+
+fills the ring with whole blocks following the play cursor, or following the
+prefetched start of the sample while the cursor is still inside it
+====================
+*/
+void idSampleDecoderLocal::DecodeAhead( void ) {
+	if ( !WantsDecodeAhead() ) {
+		return;
+	}
+
+	idSoundSample *sample = lastSample;
+	int shift = 22050 / sample->objectInfo.nSamplesPerSec;
+	int length44k = sample->LengthIn44kHzSamples();
+	int blockSize = MIXBUFFER_SAMPLES * sample->objectInfo.nChannels;
+
+	if ( aheadCount44k == 0 ) {
+		// the mixer requests whole blocks, so a ring starting inside the last prefetched block would never be hit
+		int prefetchEnd44k = sample->prefetchSize << shift;
+		aheadOffset44k = Max( playCursor44k, prefetchEnd44k - prefetchEnd44k % blockSize );
+		aheadFirst = 0;
+	}
+
+	while( aheadCount44k + blockSize <= aheadSize ) {
+		int offset44k = aheadOffset44k + aheadCount44k;
+		int count44k = Min( blockSize, length44k - offset44k );
+		if ( count44k <= 0 ) {
+			break;
+		}
+		int index = ( aheadFirst + aheadCount44k ) % aheadSize;
+		int count = Min( count44k, aheadSize - index );
+		int readSamples44k = DecodeOGG( sample, offset44k, count, aheadSamples + index );
+		if ( readSamples44k == count && count < count44k ) {
+			readSamples44k += DecodeOGG( sample, offset44k + count, count44k - count, aheadSamples );
+		}
+		aheadCount44k += readSamples44k;
+		if ( readSamples44k < count44k ) {
+			break;
+		}
+		Sys_InterlockedIncrement( decodeAheadBlocks );
+	}
+}
+
+/*
+====================
+idSampleDecoderLocal::DecodeAheadJob
+====================
+*/
+void idSampleDecoderLocal::DecodeAheadJob( void *data ) {
+	idSampleDecoderLocal *decoder = static_cast<idSampleDecoderLocal *>( data );
+
+	// if the decoder is busy the mixer is decoding it right now
+	if ( !decoder->decodeLock.TryLock() ) {
+		return;
+	}
+	decoder->DecodeAhead();
+	decoder->decodeLock.Unlock();
+}
+
 /*
 ====================
 idSampleDecoderLocal::DecodePCM
@@ -515,9 +817,12 @@ int idSampleDecoderLocal::DecodeOGG( idSoundSample *sample, int sampleOffset44k,
 	int sampleCount = sampleCount44k >> shift;
 
 	// open OGG file if not yet opened
-	if ( lastSample == NULL ) {
+	if ( !oggOpen ) {
 		// make sure there is enough space for another decoder
-		if ( decoderMemoryAllocator.GetFreeBlockMemory() < MIN_OGGVORBIS_MEMORY ) {
+		decoderMemoryLock.Lock();
+		int freeMemory = decoderMemoryAllocator.GetFreeBlockMemory();
+		decoderMemoryLock.Unlock();
+		if ( freeMemory < MIN_OGGVORBIS_MEMORY ) {
 			return 0;
 		}
 		if ( sample->nonCacheData == NULL ) {
@@ -530,8 +835,10 @@ int idSampleDecoderLocal::DecodeOGG( idSoundSample *sample, int sampleOffset44k,
 			failed = true;
 			return 0;
 		}
+		oggOpen = true;
 		lastFormat = WAVE_FORMAT_TAG_OGG;
 		lastSample = sample;
+		lastSampleOffset = 0;
 	}
 
 	// seek to the right offset if necessary
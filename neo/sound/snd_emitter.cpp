@@ -568,7 +568,12 @@ void idSoundEmitterLocal::Spatialize( idVec3 listenerPos, int listenerArea, idRe
 			return;
 		}
 
-		soundWorld->ResolveOrigin( 0, NULL, soundInArea, 0.0f, origin, this );
+		if ( soundWorld->ResolveOriginCached( soundInArea, origin, this ) ) {
+			soundWorld->spatializeCached++;
+		} else {
+			soundWorld->ResolveOrigin( 0, NULL, soundInArea, 0.0f, origin, this );
+			soundWorld->spatializeTraced++;
+		}
 		distance /= METERS_TO_DOOM;
 	} else {
 		// no portals available
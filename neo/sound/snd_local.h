@@ -513,6 +513,55 @@ public:
 };
 
 
+/*
+===================================================================================
+
+idSoundMixBatch
+
+Gathers the software mixed channels of one block as planar mono sources so they
+can all be mixed by a single SIMD kernel. Stereo channels become two sources.
+
+Sources are always summed in the order they were added, so several batches that
+are mixed one after the other give exactly the same result as a single batch.
+
+===================================================================================
+*/
+
+const int MIX_BATCH_SOURCES			= 64;						// sources per kernel call and allocation step
+const int MIX_BATCH_SAMPLE_STRIDE	= MIXBUFFER_SAMPLES + 16;	// padded so the source rows don't share cache sets
+const int MAX_MIX_JOBS				= 16;
+
+class idSoundMixBatch {
+public:
+							idSoundMixBatch( void );
+							~idSoundMixBatch( void );
+
+	void					Begin( int numSpeakers );
+	void					AddChannel( const float *samples, int numChannels, const float lastV[6], const float currentV[6] );
+	void					MixSources( const idSoundMixBatch &batch );
+	void					End( float *finalMixBuffer );
+	int						NumSources( void ) const { return numMixedSources; }
+
+private:
+	float *					sourceSamples;		// maxSources rows of MIX_BATCH_SAMPLE_STRIDE samples
+	float *					sourceLastV;		// 6 rows of maxSources volumes
+	float *					sourceCurrentV;		// 6 rows of maxSources volumes
+	float *					planarMix;			// 6 rows of MIXBUFFER_SAMPLES
+	int						numSpeakers;
+	int						numSources;
+	int						maxSources;
+	int						numMixedSources;
+	bool					mixed;				// planarMix holds the sum of this block
+
+	float *					AllocSource( const float lastV[6], const float currentV[6], int speakerMask );
+	void					Grow( void );
+};
+
+typedef struct mixChannel_s {
+	idSoundEmitterLocal *	sound;
+	idSoundChannel *		chan;
+} mixChannel_t;
+
 /*
 ===================================================================================
 
@@ -544,6 +593,20 @@ typedef struct soundPortalTrace_s {
 	const struct soundPortalTrace_s	*prevStack;
 } soundPortalTrace_t;
 
+// an exit portal of an area with the shortest chain of portals from it to the listener area
+typedef struct soundPortalRoute_s {
+	int						area;			// area the portal leaves
+	int						portalNum;		// index of the portal in the area for idRenderWorld::GetPortal
+	int						intoArea;		// area on the other side of the portal
+	qhandle_t				portalHandle;
+	int						reverseRoute;	// the same portal seen from intoArea
+	idVec3					center;			// center of the portal winding
+	float					distance;		// from center through the portal centers to the portal entering the listener area, -1 if there is no route
+	int						depth;			// number of portals in the chain
+	int						lastRoute;		// portal entering the listener area
+	int						prevRoute;		// portal before lastRoute, -1 if the chain is a single portal
+} soundPortalRoute_t;
+
 class idSoundWorldLocal : public idSoundWorld {
 public:
 	virtual					~idSoundWorldLocal( void );
@@ -616,10 +679,15 @@ public:
 	idSoundEmitterLocal *	AllocLocalSoundEmitter();
 	void					CalcEars( int numSpeakers, idVec3 realOrigin, idVec3 listenerPos, idMat3 listenerAxis, float ears[6], float spatialize );
 	void					AddChannelContribution( idSoundEmitterLocal *sound, idSoundChannel *chan,
-												int current44kHz, int numSpeakers, float *finalMixBuffer );
+												int current44kHz, int numSpeakers, float *finalMixBuffer, idSoundMixBatch *mixBatch );
 	void					MixLoop( int current44kHz, int numSpeakers, float *finalMixBuffer );
+	void					ParallelMix( int current44kHz, int numSpeakers );
+	static void				MixChannelsJob( void *data, int first, int last );
 	void					AVIUpdate( void );
 	void					ResolveOrigin( const int stackDepth, const soundPortalTrace_t *prevStack, const int soundArea, const float dist, const idVec3& soundOrigin, idSoundEmitterLocal *def );
+	bool					ResolveOriginCached( const int soundArea, const idVec3& soundOrigin, idSoundEmitterLocal *def );
+	void					UpdatePortalRoutes( void );
+	void					ClearPortalRoutes( void );
 	float					FindAmplitude( idSoundEmitterLocal *sound, const int localTime, const idVec3 *listenerPosition, const s_channelType channel, bool shakesOnly );
 
 	//============================================
@@ -644,6 +712,24 @@ public:
 
 	idSoundFade				soundClassFade[SOUND_MAX_CLASSES];	// for global sound fading
 
+	idSoundMixBatch			mixBatch;			// software mixed channels of the current block
+	idSoundMixBatch			mixJobBatches[MAX_MIX_JOBS];	// channels gathered by each parallel mixing job
+	idList<mixChannel_t>	mixChannels;		// triggered channels in mixing order
+	int						numMixJobs;
+	int						mixJob44kHz;
+	int						mixJobSpeakers;
+
+	// portal routes to the listener area, rebuilt when the listener changes area or a portal opens or closes
+	idList<soundPortalRoute_t>	portalRoutes;	// exit portals of all areas, grouped by area
+	idList<int>				areaPortalRoutes;	// first portalRoutes index of each area, NumAreas() + 1 entries
+	idList<int>				portalStates;		// blocking bits of each inter area portal the routes were built with
+	int						portalRoutesArea;	// listener area of the routes, -1 if they need to be rebuilt
+
+	int						spatializeEmitters;	// spatialization stats of the last ForegroundUpdate
+	int						spatializeCached;
+	int						spatializeTraced;
+	double					spatializeTicks;
+
 	// avi stuff
 	idFile *				fpa[6];
 	idStr					aviDemoPath;
@@ -802,6 +888,12 @@ public:
 	static idCVar			s_numberOfSpeakers;
 	static idCVar			s_force22kHz;
 	static idCVar			s_clipVolumes;
+	static idCVar			s_mixBatch;
+	static idCVar			s_parallelMix;
+	static idCVar			s_portalRoutes;
+	static idCVar			s_showSpatialize;
+	static idCVar			s_decodePrefetchMsec;
+	static idCVar			s_decodeAheadBlocks;
 	static idCVar			s_realTimeDecoding;
 	static idCVar			s_libOpenAL;
 	static idCVar			s_useOpenAL;
@@ -854,6 +946,8 @@ public:
 	bool					onDemand;
 	bool					purged;
 	bool					levelLoadReferenced;		// so we can tell which samples aren't needed any more
+	float *					prefetchData;				// start of an OGG sample decoded in the background at level load, one plane per channel
+	volatile int			prefetchSize;				// size of prefetchData in samples, only set once the decode has finished
 
 	int						LengthIn44kHzSamples() const;
 	ID_TIME_T		 			GetNewTimeStamp( void ) const;
@@ -862,6 +956,7 @@ public:
 	void					Reload( bool force );		// reloads if timestamp has changed, or always if force
 	void					PurgeSoundSample();			// frees all data
 	void					CheckForDownSample();		// down sample if required
+	void					Prefetch();					// decodes the start of an OGG sample, called from the job workers
 	bool					FetchFromCache( int offset, const byte **output, int *position, int *size, const bool allowIO );
 };
 
@@ -882,6 +977,9 @@ public:
 	static void				Free( idSampleDecoder *decoder );
 	static int				GetNumUsedBlocks( void );
 	static int				GetUsedBlockMemory( void );
+	static int				DecodeSample( idSoundSample *sample, int sampleCount44k, float *dest );
+	static void				ClearCacheStats( void );
+	static void				PrintCacheStats( void );
 
 	virtual					~idSampleDecoder( void ) {}
 	virtual void			Decode( idSoundSample *sample, int sampleOffset44k, int sampleCount44k, float *dest ) = 0;
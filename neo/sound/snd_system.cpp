@@ -59,6 +59,12 @@ idCVar idSoundSystemLocal::s_singleEmitter( "s_singleEmitter", "0", CVAR_SOUND |
 idCVar idSoundSystemLocal::s_numberOfSpeakers( "s_numberOfSpeakers", "2", CVAR_SOUND | CVAR_ARCHIVE, "number of speakers" );
 idCVar idSoundSystemLocal::s_force22kHz( "s_force22kHz", "0", CVAR_SOUND | CVAR_BOOL, ""  );
 idCVar idSoundSystemLocal::s_clipVolumes( "s_clipVolumes", "1", CVAR_SOUND | CVAR_BOOL, ""  );
+idCVar idSoundSystemLocal::s_mixBatch( "s_mixBatch", "1", CVAR_SOUND | CVAR_BOOL, "mix all software channels of a block with one batched SIMD kernel" );
+idCVar idSoundSystemLocal::s_parallelMix( "s_parallelMix", "0", CVAR_SOUND | CVAR_BOOL, "decode and gather the batched software channels on the job workers" );
+idCVar idSoundSystemLocal::s_portalRoutes( "s_portalRoutes", "1", CVAR_SOUND | CVAR_BOOL, "spatialize through portal routes cached per listener area instead of tracing portal chains for every emitter" );
+idCVar idSoundSystemLocal::s_showSpatialize( "s_showSpatialize", "0", CVAR_SOUND | CVAR_BOOL, "print the time spent spatializing emitters each frame" );
+idCVar idSoundSystemLocal::s_decodePrefetchMsec( "s_decodePrefetchMsec", "500", CVAR_SOUND | CVAR_INTEGER, "milliseconds at the start of every OGG sound decoded in the background at level load", 0, 5000 );
+idCVar idSoundSystemLocal::s_decodeAheadBlocks( "s_decodeAheadBlocks", "2", CVAR_SOUND | CVAR_INTEGER, "mix blocks of streaming OGG sounds decoded ahead of the play cursor on the job workers", 0, 8 );
 idCVar idSoundSystemLocal::s_realTimeDecoding( "s_realTimeDecoding", "1", CVAR_SOUND | CVAR_BOOL | CVAR_INIT, "" );
 
 idCVar idSoundSystemLocal::s_slowAttenuate( "s_slowAttenuate", "1", CVAR_SOUND | CVAR_BOOL, "slowmo sounds attenuate over shorted distance" );
@@ -253,6 +259,7 @@ void ListSoundDecoders_f( const idCmdArgs &args ) {
 	common->Printf( "%d waiting decoders\n", numWaitingDecoders );
 	common->Printf( "%d active decoders\n", numActiveDecoders );
 	common->Printf( "%d kB decoder memory in %d blocks\n", idSampleDecoder::GetUsedBlockMemory() >> 10, idSampleDecoder::GetNumUsedBlocks() );
+	idSampleDecoder::PrintCacheStats();
 }
 
 /*
@@ -272,6 +279,240 @@ void TestSound_f( const idCmdArgs &args ) {
 	}
 }
 
+/*
+===============
+SaveChannelStates / RestoreChannelStates
+
+  the mixer ramps from the volumes of the previous block and the slow motion
+  channels keep their own play position and filter, so every benchmark pass
+  has to start from the same channel state
+===============
+*/
+typedef struct {
+	float					lastV[6];
+	float					lastVolume;
+	idSlowChannel			slow;
+} benchChannelState_t;
+
+static void SaveChannelStates( idSoundWorldLocal *sw, idList<benchChannelState_t> &states ) {
+	states.SetNum( 0, false );
+	for ( int i = 1; i < sw->emitters.Num(); i++ ) {
+		idSoundEmitterLocal *sound = sw->emitters[i];
+		if ( !sound ) {
+			continue;
+		}
+		for ( int j = 0; j < SOUND_MAX_CHANNELS; j++ ) {
+			const idSoundChannel *chan = &sound->channels[j];
+			benchChannelState_t &state = states.Alloc();
+			for ( int k = 0; k < 6; k++ ) {
+				state.lastV[k] = chan->lastV[k];
+			}
+			state.lastVolume = chan->lastVolume;
+			state.slow = sound->GetSlowChannel( chan );
+		}
+	}
+}
+
+static void RestoreChannelStates( idSoundWorldLocal *sw, const idList<benchChannelState_t> &states ) {
+	int n = 0;
+	for ( int i = 1; i < sw->emitters.Num(); i++ ) {
+		idSoundEmitterLocal *sound = sw->emitters[i];
+		if ( !sound ) {
+			continue;
+		}
+		for ( int j = 0; j < SOUND_MAX_CHANNELS; j++ ) {
+			idSoundChannel *chan = &sound->channels[j];
+			const benchChannelState_t &state = states[n++];
+			for ( int k = 0; k < 6; k++ ) {
+				chan->lastV[k] = state.lastV[k];
+			}
+			chan->lastVolume = state.lastVolume;
+			sound->SetSlowChannel( chan, state.slow );
+		}
+	}
+}
+
+/*
+===============
+ClearChannelDecoders
+
+  the decoders have been moved ahead of the play position, clearing them
+  makes the next mix reopen the samples at the right offset
+===============
+*/
+static void ClearChannelDecoders( idSoundWorldLocal *sw ) {
+	for ( int i = 1; i < sw->emitters.Num(); i++ ) {
+		idSoundEmitterLocal *sound = sw->emitters[i];
+		if ( !sound ) {
+			continue;
+		}
+		for ( int j = 0; j < SOUND_MAX_CHANNELS; j++ ) {
+			idSoundChannel *chan = &sound->channels[j];
+			if ( chan->decoder ) {
+				chan->decoder->ClearDecoder();
+			}
+		}
+	}
+}
+
+/*
+===============
+BenchSoundMix_f
+
+  mixes the blocks following the currently playing one with the per channel,
+  the batched and the parallel batched software mixer, reports the mixing time
+  per block and writes the batched blocks to a wave file
+
+  this is called from the main thread
+===============
+*/
+void BenchSoundMix_f( const idCmdArgs &args ) {
+	idSoundWorldLocal *sw = soundSystemLocal.currentSoundWorld;
+	int i, k;
+
+	if ( args.Argc() > 3 ) {
+		common->Printf( "Usage: benchSoundMix [blocks] [file]\n" );
+		return;
+	}
+	if ( !soundSystemLocal.isInitialized || !sw ) {
+		common->Printf( "no sound world to mix\n" );
+		return;
+	}
+	if ( idSoundSystemLocal::useOpenAL ) {
+		common->Printf( "benchSoundMix only measures the software mixer\n" );
+		return;
+	}
+
+	int numBlocks = 64;
+	if ( args.Argc() > 1 ) {
+		numBlocks = idMath::ClampInt( 1, 256, atoi( args.Argv( 1 ) ) );
+	}
+	idStr fileName = ( args.Argc() > 2 ) ? args.Argv( 2 ) : "benchSoundMix";
+	fileName.DefaultFileExtension( ".wav" );
+
+	const int numSpeakers = soundSystemLocal.snd_audio_hw ? soundSystemLocal.snd_audio_hw->GetNumberOfSpeakers() : 2;
+	const int blockFloats = MIXBUFFER_SAMPLES * numSpeakers;
+	float *mixBuffers[3];
+	idTimer timers[3];
+	idList<benchChannelState_t> startStates;
+	idList<benchChannelState_t> blockStates;
+	int numSources = 0;
+
+	for ( k = 0; k < 3; k++ ) {
+		mixBuffers[k] = (float *) Mem_Alloc16( numBlocks * blockFloats * sizeof( float ) );
+	}
+
+	const bool mixBatch = idSoundSystemLocal::s_mixBatch.GetBool();
+	const bool parallelMix = idSoundSystemLocal::s_parallelMix.GetBool();
+
+	// keep the async mixer out of the sound world while the blocks following the
+	// current one are mixed the way AVIUpdate steps through them
+	const bool muted = soundSystemLocal.muted;
+	soundSystemLocal.SetMute( true );
+	Sys_EnterCriticalSection();
+
+	const int start44kHz = soundSystemLocal.GetCurrent44kHzTime() - soundSystemLocal.GetCurrent44kHzTime() % MIXBUFFER_SAMPLES;
+
+	SaveChannelStates( sw, startStates );
+
+	for ( i = 0; i < numBlocks; i++ ) {
+		const int current44kHz = start44kHz + i * MIXBUFFER_SAMPLES;
+
+		SaveChannelStates( sw, blockStates );
+
+		// the parallel mixer runs last and leaves the channels ready for the next block
+		for ( k = 0; k < 3; k++ ) {
+			idSoundSystemLocal::s_mixBatch.SetBool( k >= 1 );
+			idSoundSystemLocal::s_parallelMix.SetBool( k == 2 );
+			RestoreChannelStates( sw, blockStates );
+
+			float *mix = mixBuffers[k] + i * blockFloats;
+			SIMDProcessor->Memset( mix, 0, blockFloats * sizeof( float ) );
+			timers[k].Start();
+			sw->MixLoop( current44kHz, numSpeakers, mix );
+			timers[k].Stop();
+			if ( k == 1 ) {
+				numSources += sw->mixBatch.NumSources();
+			}
+		}
+	}
+
+	idSoundSystemLocal::s_mixBatch.SetBool( mixBatch );
+	idSoundSystemLocal::s_parallelMix.SetBool( parallelMix );
+	RestoreChannelStates( sw, startStates );
+	ClearChannelDecoders( sw );
+
+	Sys_LeaveCriticalSection();
+	soundSystemLocal.SetMute( muted );
+
+	// the parallel mix has to match the serial batched mix exactly
+	float maxDiff = 0.0f;
+	int numMismatched = 0;
+	for ( i = 0; i < numBlocks * blockFloats; i++ ) {
+		maxDiff = Max( maxDiff, idMath::Fabs( mixBuffers[0][i] - mixBuffers[1][i] ) );
+		if ( mixBuffers[1][i] != mixBuffers[2][i] ) {
+			numMismatched++;
+		}
+	}
+
+	const double channelUsec = timers[0].Milliseconds() * 1000.0 / numBlocks;
+	const double batchUsec = timers[1].Milliseconds() * 1000.0 / numBlocks;
+	const double parallelUsec = timers[2].Milliseconds() * 1000.0 / numBlocks;
+
+	common->Printf( "%d blocks of %d samples, %d speakers, %.1f sources per block\n", numBlocks, MIXBUFFER_SAMPLES, numSpeakers, (float) numSources / numBlocks );
+	common->Printf( "per channel mixer: %8.1f usec per block\n", channelUsec );
+	common->Printf( "batched mixer:     %8.1f usec per block (%.2fx), max difference %.3f\n", batchUsec, ( batchUsec > 0.0 ) ? channelUsec / batchUsec : 0.0, maxDiff );
+	common->Printf( "parallel mixer:    %8.1f usec per block (%.2fx) on %d threads, %d samples differ from the batched mix\n", parallelUsec, ( parallelUsec > 0.0 ) ? channelUsec / parallelUsec : 0.0, jobSystem->NumThreads(), numMismatched );
+
+	// write the batched mix as an interleaved 16 bit wave file
+	const int numSamples = numBlocks * blockFloats;
+	short *samples = (short *) Mem_Alloc16( numSamples * sizeof( short ) );
+	SIMDProcessor->MixedSoundToSamples( samples, mixBuffers[1], numSamples );
+
+	idFile *wO = fileSystem->OpenFileWrite( fileName );
+	if ( wO ) {
+		mminfo_t info;
+		pcmwaveformat_t format;
+
+		info.ckid = fourcc_riff;
+		info.fccType = mmioFOURCC( 'W', 'A', 'V', 'E' );
+		info.cksize = 4 + 8 + 16 + 8 + numSamples * sizeof( short );
+		info.dwDataOffset = 12;
+
+		wO->Write( &info, 12 );
+
+		info.ckid = mmioFOURCC( 'f', 'm', 't', ' ' );
+		info.cksize = 16;
+
+		wO->Write( &info, 8 );
+
+		format.wBitsPerSample = 16;
+		format.wf.nAvgBytesPerSec = 44100 * numSpeakers * 2;	// sample rate * block align
+		format.wf.nChannels = numSpeakers;
+		format.wf.nSamplesPerSec = 44100;
+		format.wf.wFormatTag = WAVE_FORMAT_TAG_PCM;
+		format.wf.nBlockAlign = numSpeakers * 2;				// channels * bits/sample / 8
+
+		wO->Write( &format, 16 );
+
+		info.ckid = mmioFOURCC( 'd', 'a', 't', 'a' );
+		info.cksize = numSamples * sizeof( short );
+
+		wO->Write( &info, 8 );
+		wO->Write( samples, numSamples * sizeof( short ) );
+
+		common->Printf( "wrote %s\n", wO->GetFullPath() );
+		fileSystem->CloseFile( wO );
+	} else {
+		common->Warning( "Couldn't write %s", fileName.c_str() );
+	}
+
+	Mem_Free16( samples );
+	for ( k = 0; k < 3; k++ ) {
+		Mem_Free16( mixBuffers[k] );
+	}
+}
+
 /*
 ===============
 SoundSystemRestart_f
@@ -423,6 +664,7 @@ void idSoundSystemLocal::Init() {
 	cmdSystem->AddCommand( "reloadSounds", SoundReloadSounds_f, CMD_FL_SOUND|CMD_FL_CHEAT, "reloads all sounds" );
 	cmdSystem->AddCommand( "testSound", TestSound_f, CMD_FL_SOUND | CMD_FL_CHEAT, "tests a sound", idCmdSystem::ArgCompletion_SoundName );
 	cmdSystem->AddCommand( "s_restart", SoundSystemRestart_f, CMD_FL_SOUND, "restarts the sound system" );
+	cmdSystem->AddCommand( "benchSoundMix", BenchSoundMix_f, CMD_FL_SOUND|CMD_FL_CHEAT, "mixes the current sound scene with the software mixers and writes a wave file" );
 
 	common->Printf( "sound system initialized.\n" );
 	common->Printf( "--------------------------------------\n" );
@@ -71,6 +71,17 @@ void idSoundWorldLocal::Init( idRenderWorld *renderWorld ) {
 	slowmoActive		= false;
 	slowmoSpeed			= 0;
 	enviroSuitActive	= false;
+
+	numMixJobs			= 0;
+	mixJob44kHz			= 0;
+	mixJobSpeakers		= 0;
+
+	ClearPortalRoutes();
+
+	spatializeEmitters	= 0;
+	spatializeCached	= 0;
+	spatializeTraced	= 0;
+	spatializeTicks		= 0.0;
 }
 
 /*
@@ -133,6 +144,9 @@ void idSoundWorldLocal::ClearAllSoundEmitters() {
 	}
 	localSound = NULL;
 
+	// the render world may have loaded a new map
+	ClearPortalRoutes();
+
 	Sys_LeaveCriticalSection();
 }
 
@@ -405,6 +419,247 @@ float idSoundWorldLocal::CurrentShakeAmplitudeForPosition( const int time, const
 	return amp;
 }
 
+/*
+===================
+idSoundMixBatch::idSoundMixBatch
+===================
+*/
+idSoundMixBatch::idSoundMixBatch( void ) {
+	sourceSamples = NULL;
+	sourceLastV = NULL;
+	sourceCurrentV = NULL;
+	planarMix = NULL;
+	numSpeakers = 0;
+	numSources = 0;
+	maxSources = 0;
+	numMixedSources = 0;
+	mixed = false;
+}
+
+/*
+===================
+idSoundMixBatch::~idSoundMixBatch
+===================
+*/
+idSoundMixBatch::~idSoundMixBatch( void ) {
+	Mem_Free16( sourceSamples );
+	Mem_Free16( sourceLastV );
+	Mem_Free16( sourceCurrentV );
+	Mem_Free16( planarMix );
+}
+
+/*
+===================
+idSoundMixBatch::Begin
+===================
+*/
+void idSoundMixBatch::Begin( int numSpeakers ) {
+	this->numSpeakers = numSpeakers;
+	numSources = 0;
+	numMixedSources = 0;
+	mixed = false;
+}
+
+/*
+===================
+idSoundMixBatch::Grow
+
+the buffers are only allocated for sound worlds that are actually mixed in software
+===================
+*/
+void idSoundMixBatch::Grow( void ) {
+	int newMaxSources = maxSources + MIX_BATCH_SOURCES;
+
+	float *newSamples = (float *) Mem_Alloc16( newMaxSources * MIX_BATCH_SAMPLE_STRIDE * sizeof( float ) );
+	float *newLastV = (float *) Mem_Alloc16( 6 * newMaxSources * sizeof( float ) );
+	float *newCurrentV = (float *) Mem_Alloc16( 6 * newMaxSources * sizeof( float ) );
+
+	if ( numSources ) {
+		SIMDProcessor->Memcpy( newSamples, sourceSamples, numSources * MIX_BATCH_SAMPLE_STRIDE * sizeof( float ) );
+		for ( int i = 0; i < 6; i++ ) {
+			memcpy( newLastV + i * newMaxSources, sourceLastV + i * maxSources, numSources * sizeof( float ) );
+			memcpy( newCurrentV + i * newMaxSources, sourceCurrentV + i * maxSources, numSources * sizeof( float ) );
+		}
+	}
+
+	Mem_Free16( sourceSamples );
+	Mem_Free16( sourceLastV );
+	Mem_Free16( sourceCurrentV );
+
+	sourceSamples = newSamples;
+	sourceLastV = newLastV;
+	sourceCurrentV = newCurrentV;
+	maxSources = newMaxSources;
+}
+
+/*
+===================
+idSoundMixBatch::AllocSource
+
+returns the sample row for a new source, speakers not in the mask get no volume
+===================
+*/
+float *idSoundMixBatch::AllocSource( const float lastV[6], const float currentV[6], int speakerMask ) {
+	assert( numSources < maxSources );
+
+	for ( int i = 0; i < numSpeakers; i++ ) {
+		if ( speakerMask & ( 1 << i ) ) {
+			sourceLastV[i*maxSources+numSources] = lastV[i];
+			sourceCurrentV[i*maxSources+numSources] = currentV[i];
+		} else {
+			sourceLastV[i*maxSources+numSources] = 0.0f;
+			sourceCurrentV[i*maxSources+numSources] = 0.0f;
+		}
+	}
+	return sourceSamples + ( numSources++ ) * MIX_BATCH_SAMPLE_STRIDE;
+}
+
+/*
+===================
+idSoundMixBatch::AddChannel
+
+queues MIXBUFFER_SAMPLES mono or interleaved stereo samples, stereo uses the
+same speaker mapping as MixSoundTwoSpeakerStereo and MixSoundSixSpeakerStereo
+===================
+*/
+void idSoundMixBatch::AddChannel( const float *samples, int numChannels, const float lastV[6], const float currentV[6] ) {
+	if ( numSources + numChannels > maxSources ) {
+		Grow();
+	}
+
+	if ( numChannels == 1 ) {
+		float *dest = AllocSource( lastV, currentV, 63 );
+		SIMDProcessor->Memcpy( dest, samples, MIXBUFFER_SAMPLES * sizeof( float ) );
+	} else {
+		float *left = AllocSource( lastV, currentV, ( numSpeakers == 6 ) ? ( BIT(0) | BIT(2) | BIT(3) | BIT(4) ) : BIT(0) );
+		float *right = AllocSource( lastV, currentV, ( numSpeakers == 6 ) ? ( BIT(1) | BIT(5) ) : BIT(1) );
+		for ( int j = 0; j < MIXBUFFER_SAMPLES; j++ ) {
+			left[j] = samples[j*2+0];
+			right[j] = samples[j*2+1];
+		}
+	}
+}
+
+/*
+===================
+idSoundMixBatch::MixSources
+
+adds the sources queued in batch to the planar mix of this batch
+===================
+*/
+void idSoundMixBatch::MixSources( const idSoundMixBatch &batch ) {
+	if ( !batch.numSources ) {
+		return;
+	}
+	assert( batch.numSpeakers == numSpeakers );
+
+	if ( !mixed ) {
+		if ( !planarMix ) {
+			planarMix = (float *) Mem_Alloc16( 6 * MIXBUFFER_SAMPLES * sizeof( float ) );
+		}
+		SIMDProcessor->Memset( planarMix, 0, numSpeakers * MIXBUFFER_SAMPLES * sizeof( float ) );
+		mixed = true;
+	}
+
+	for ( int first = 0; first < batch.numSources; first += MIX_BATCH_SOURCES ) {
+		int count = Min( MIX_BATCH_SOURCES, batch.numSources - first );
+		SIMDProcessor->MixSoundBatch( planarMix, batch.sourceSamples + first * MIX_BATCH_SAMPLE_STRIDE, MIX_BATCH_SAMPLE_STRIDE, count,
+										batch.sourceLastV + first, batch.sourceCurrentV + first, batch.maxSources, numSpeakers );
+	}
+	numMixedSources += batch.numSources;
+}
+
+/*
+===================
+idSoundMixBatch::End
+
+mixes the queued sources and adds the planar result to the interleaved finalMixBuffer
+===================
+*/
+void idSoundMixBatch::End( float *finalMixBuffer ) {
+	MixSources( *this );
+	numSources = 0;
+
+	if ( !mixed ) {
+		return;
+	}
+	for ( int i = 0; i < numSpeakers; i++ ) {
+		const float *src = planarMix + i * MIXBUFFER_SAMPLES;
+		for ( int j = 0; j < MIXBUFFER_SAMPLES; j++ ) {
+			finalMixBuffer[j*numSpeakers+i] += src[j];
+		}
+	}
+}
+
+/*
+===================
+idSoundWorldLocal::MixChannelsJob
+
+gathers a contiguous range of the triggered channels into the batch of the job
+===================
+*/
+void idSoundWorldLocal::MixChannelsJob( void *data, int first, int last ) {
+	idSoundWorldLocal *sw = static_cast<idSoundWorldLocal *>( data );
+
+	for ( int i = first; i < last; i++ ) {
+		idSoundMixBatch *batch = &sw->mixJobBatches[i];
+		int firstChannel = sw->mixChannels.Num() * i / sw->numMixJobs;
+		int lastChannel = sw->mixChannels.Num() * ( i + 1 ) / sw->numMixJobs;
+
+		batch->Begin( sw->mixJobSpeakers );
+		for ( int j = firstChannel; j < lastChannel; j++ ) {
+			sw->AddChannelContribution( sw->mixChannels[j].sound, sw->mixChannels[j].chan, sw->mixJob44kHz, sw->mixJobSpeakers, NULL, batch );
+		}
+	}
+}
+
+/*
+===================
+idSoundWorldLocal::ParallelMix
+
+Decodes and gathers the channels on the job workers. Every job takes a contiguous
+range of the channels in the serial mixing order and the job batches are summed
+in that order afterwards, so the result is identical to the serial batched mix.
+===================
+*/
+void idSoundWorldLocal::ParallelMix( int current44kHz, int numSpeakers ) {
+	int i, j;
+
+	mixChannels.SetNum( 0, false );
+	for ( i = 1; i < emitters.Num(); i++ ) {
+		idSoundEmitterLocal *sound = emitters[i];
+
+		if ( !sound || !sound->playing ) {
+			continue;
+		}
+		for ( j = 0; j < SOUND_MAX_CHANNELS; j++ ) {
+			idSoundChannel *chan = &sound->channels[j];
+
+			if ( !chan->triggerState ) {
+				chan->ALStop();
+				continue;
+			}
+			mixChannel_t &mc = mixChannels.Alloc();
+			mc.sound = sound;
+			mc.chan = chan;
+		}
+	}
+
+	if ( mixChannels.Num() == 0 ) {
+		return;
+	}
+
+	numMixJobs = Min( Min( MAX_MIX_JOBS, jobSystem->NumThreads() * 2 ), mixChannels.Num() );
+	mixJob44kHz = current44kHz;
+	mixJobSpeakers = numSpeakers;
+
+	jobSystem->ParallelFor( MixChannelsJob, this, numMixJobs, 1 );
+
+	for ( i = 0; i < numMixJobs; i++ ) {
+		mixBatch.MixSources( mixJobBatches[i] );
+	}
+}
+
 /*
 ===================
 idSoundWorldLocal::MixLoop
@@ -485,6 +740,13 @@ void idSoundWorldLocal::MixLoop( int current44kHz, int numSpeakers, float *final
 #endif
 	}
 
+	// software mixed channels are gathered and mixed together at the end
+	idSoundMixBatch *batch = NULL;
+	if ( !idSoundSystemLocal::useOpenAL && idSoundSystemLocal::s_mixBatch.GetBool() ) {
+		batch = &mixBatch;
+		batch->Begin( numSpeakers );
+	}
+
 	// debugging option to mute all but a single soundEmitter
 	if ( idSoundSystemLocal::s_singleEmitter.GetInteger() > 0 && idSoundSystemLocal::s_singleEmitter.GetInteger() < emitters.Num() ) {
 		sound = emitters[idSoundSystemLocal::s_singleEmitter.GetInteger()];
@@ -500,36 +762,47 @@ void idSoundWorldLocal::MixLoop( int current44kHz, int numSpeakers, float *final
 					continue;
 				}
 
-				AddChannelContribution( sound, chan, current44kHz, numSpeakers, finalMixBuffer );
+				AddChannelContribution( sound, chan, current44kHz, numSpeakers, finalMixBuffer, batch );
 			}
 		}
+		if ( batch ) {
+			batch->End( finalMixBuffer );
+		}
 		return;
 	}
 
-	for ( i = 1; i < emitters.Num(); i++ ) {
-		sound = emitters[i];
-
-		if ( !sound ) {
-			continue;
-		}
-		// if no channels are active, do nothing
-		if ( !sound->playing ) {
-			continue;
-		}
-		// run through all the channels
-		for ( j = 0; j < SOUND_MAX_CHANNELS ; j++ ) {
-			idSoundChannel	*chan = &sound->channels[j];
+	if ( batch && idSoundSystemLocal::s_parallelMix.GetBool() && jobSystem->NumThreads() > 1 ) {
+		ParallelMix( current44kHz, numSpeakers );
+	} else {
+		for ( i = 1; i < emitters.Num(); i++ ) {
+			sound = emitters[i];
 
-			// see if we have a sound triggered on this channel
-			if ( !chan->triggerState ) {
-				chan->ALStop();
+			if ( !sound ) {
 				continue;
 			}
+			// if no channels are active, do nothing
+			if ( !sound->playing ) {
+				continue;
+			}
+			// run through all the channels
+			for ( j = 0; j < SOUND_MAX_CHANNELS ; j++ ) {
+				idSoundChannel	*chan = &sound->channels[j];
+
+				// see if we have a sound triggered on this channel
+				if ( !chan->triggerState ) {
+					chan->ALStop();
+					continue;
+				}
 
-			AddChannelContribution( sound, chan, current44kHz, numSpeakers, finalMixBuffer );
+				AddChannelContribution( sound, chan, current44kHz, numSpeakers, finalMixBuffer, batch );
+			}
 		}
 	}
 
+	if ( batch ) {
+		batch->End( finalMixBuffer );
+	}
+
 	if ( !idSoundSystemLocal::useOpenAL && enviroSuitActive ) {
 		soundSystemLocal.DoEnviroSuit( finalMixBuffer, MIXBUFFER_SAMPLES, numSpeakers );
 	}
@@ -731,6 +1004,50 @@ set at maxDistance
 */
 static const int MAX_PORTAL_TRACE_DEPTH = 10;
 
+/*
+===================
+PortalSoundOrigin
+
+the point where the line from the sound to the listener crosses the portal, slid inside the portal edges
+===================
+*/
+static idVec3 PortalSoundOrigin( const idWinding *w, const idVec3 &soundOrigin, const idVec3 &listenerOrigin ) {
+	idVec3	source;
+
+	idPlane	pl;
+	w->GetPlane( pl );
+
+	float	scale;
+	idVec3	dir = listenerOrigin - soundOrigin;
+	if ( !pl.RayIntersection( soundOrigin, dir, scale ) ) {
+		source = w->GetCenter();
+	} else {
+		source = soundOrigin + scale * dir;
+
+		// if this point isn't inside the portal edges, slide it in
+		for ( int i = 0 ; i < w->GetNumPoints() ; i++ ) {
+			int j = ( i + 1 ) % w->GetNumPoints();
+			idVec3	edgeDir = (*w)[j].ToVec3() - (*w)[i].ToVec3();
+			idVec3	edgeNormal;
+
+			edgeNormal.Cross( pl.Normal(), edgeDir );
+
+			idVec3	fromVert = source - (*w)[j].ToVec3();
+
+			float	d = edgeNormal * fromVert;
+			if ( d > 0 ) {
+				// move it in
+				float div = edgeNormal.Normalize();
+				d /= div;
+
+				source -= d * edgeNormal;
+			}
+		}
+	}
+
+	return source;
+}
+
 void idSoundWorldLocal::ResolveOrigin( const int stackDepth, const soundPortalTrace_t *prevStack, const int soundArea, const float dist, const idVec3& soundOrigin, idSoundEmitterLocal *def ) {
 
 	if ( dist >= def->distance ) {
@@ -788,38 +1105,7 @@ void idSoundWorldLocal::ResolveOrigin( const int stackDepth, const soundPortalTr
 
 		// pick a point on the portal to serve as our virtual sound origin
 #if 1
-		idVec3	source;
-
-		idPlane	pl;
-		re.w->GetPlane( pl );
-
-		float	scale;
-		idVec3	dir = listenerQU - soundOrigin;
-		if ( !pl.RayIntersection( soundOrigin, dir, scale ) ) {
-			source = re.w->GetCenter();
-		} else {
-			source = soundOrigin + scale * dir;
-
-			// if this point isn't inside the portal edges, slide it in
-			for ( int i = 0 ; i < re.w->GetNumPoints() ; i++ ) {
-				int j = ( i + 1 ) % re.w->GetNumPoints();
-				idVec3	edgeDir = (*(re.w))[j].ToVec3() - (*(re.w))[i].ToVec3();
-				idVec3	edgeNormal;
-
-				edgeNormal.Cross( pl.Normal(), edgeDir );
-
-				idVec3	fromVert = source - (*(re.w))[j].ToVec3();
-
-				float	d = edgeNormal * fromVert;
-				if ( d > 0 ) {
-					// move it in
-					float div = edgeNormal.Normalize();
-					d /= div;
-
-					source -= d * edgeNormal;
-				}
-			}
-		}
+		idVec3	source = PortalSoundOrigin( re.w, soundOrigin, listenerQU );
 #else
 		// clip the ray from the listener to the center of the portal by
 		// all the portal edge planes, then project that point (or the original if not clipped)
@@ -881,6 +1167,222 @@ void idSoundWorldLocal::ResolveOrigin( const int stackDepth, const soundPortalTr
 }
 
 
+/*
+===================
+idSoundWorldLocal::ClearPortalRoutes
+===================
+*/
+void idSoundWorldLocal::ClearPortalRoutes( void ) {
+	portalRoutes.Clear();
+	areaPortalRoutes.Clear();
+	portalStates.Clear();
+	portalRoutesArea = -1;
+}
+
+/*
+===================
+idSoundWorldLocal::UpdatePortalRoutes
+
+Finds the shortest chain of portal centers from every exit portal to the listener area.
+The routes only depend on the listener area and the portal states, so emitters can
+look them up instead of tracing the portal chains with ResolveOrigin every frame.
+  this is called by the main thread
+===================
+*/
+void idSoundWorldLocal::UpdatePortalRoutes( void ) {
+	int i, j;
+
+	if ( !rw || listenerArea < 0 ) {
+		portalRoutesArea = -1;
+		return;
+	}
+
+	int numAreas = rw->NumAreas();
+	int numPortals = rw->NumPortals();
+
+	// the exit portals only change with a new map
+	if ( areaPortalRoutes.Num() != numAreas + 1 || portalStates.Num() != numPortals ) {
+		ClearPortalRoutes();
+
+		areaPortalRoutes.SetNum( numAreas + 1 );
+		for ( i = 0; i < numAreas; i++ ) {
+			areaPortalRoutes[i] = portalRoutes.Num();
+
+			int numAreaPortals = rw->NumPortalsInArea( i );
+			for ( j = 0; j < numAreaPortals; j++ ) {
+				exitPortal_t re = rw->GetPortal( i, j );
+				soundPortalRoute_t &route = portalRoutes.Alloc();
+				route.area = i;
+				route.portalNum = j;
+				route.intoArea = ( re.areas[0] == i ) ? re.areas[1] : re.areas[0];
+				route.portalHandle = re.portalHandle;
+				route.reverseRoute = -1;
+				route.center = re.w->GetCenter();
+			}
+		}
+		areaPortalRoutes[numAreas] = portalRoutes.Num();
+
+		for ( i = 0; i < portalRoutes.Num(); i++ ) {
+			soundPortalRoute_t &route = portalRoutes[i];
+			for ( j = areaPortalRoutes[route.intoArea]; j < areaPortalRoutes[route.intoArea + 1]; j++ ) {
+				if ( portalRoutes[j].portalHandle == route.portalHandle ) {
+					route.reverseRoute = j;
+					break;
+				}
+			}
+		}
+
+		portalStates.SetNum( numPortals );
+		for ( i = 0; i < numPortals; i++ ) {
+			portalStates[i] = rw->GetPortalState( i + 1 );
+		}
+	}
+
+	// a door that opened or closed changes the distances of the routes through it
+	for ( i = 0; i < numPortals; i++ ) {
+		int state = rw->GetPortalState( i + 1 );
+		if ( state != portalStates[i] ) {
+			portalStates[i] = state;
+			portalRoutesArea = -1;
+		}
+	}
+
+	if ( idSoundSystemLocal::s_doorDistanceAdd.IsModified() ) {
+		idSoundSystemLocal::s_doorDistanceAdd.ClearModified();
+		portalRoutesArea = -1;
+	}
+
+	if ( portalRoutesArea == listenerArea ) {
+		return;
+	}
+
+	for ( i = 0; i < portalRoutes.Num(); i++ ) {
+		soundPortalRoute_t &route = portalRoutes[i];
+		route.distance = -1.0f;
+		route.depth = 0;
+		route.lastRoute = -1;
+		route.prevRoute = -1;
+	}
+
+	// air blocking windows and closed doors add distance like in ResolveOrigin
+	const float doorDistance = idSoundSystemLocal::s_doorDistanceAdd.GetFloat();
+
+	idList<int> queue;
+	idList<bool> queued;
+	queue.SetGranularity( 256 );
+	queued.AssureSize( portalRoutes.Num(), false );
+
+	// start with the portals entering the listener area
+	for ( i = areaPortalRoutes[listenerArea]; i < areaPortalRoutes[listenerArea + 1]; i++ ) {
+		int r = portalRoutes[i].reverseRoute;
+		if ( r < 0 || portalRoutes[r].area == listenerArea ) {
+			continue;
+		}
+		soundPortalRoute_t &route = portalRoutes[r];
+		route.distance = ( portalStates[route.portalHandle - 1] & ( PS_BLOCK_VIEW | PS_BLOCK_AIR ) ) ? doorDistance : 0.0f;
+		route.depth = 1;
+		route.lastRoute = r;
+		route.prevRoute = -1;
+		queue.Append( r );
+		queued[r] = true;
+	}
+
+	// relax the portals entering the areas already reached, the chains are short so a queue is enough
+	for ( int head = 0; head < queue.Num(); head++ ) {
+		int r = queue[head];
+		const soundPortalRoute_t &route = portalRoutes[r];
+		queued[r] = false;
+
+		if ( route.depth >= MAX_PORTAL_TRACE_DEPTH ) {
+			continue;
+		}
+
+		for ( i = areaPortalRoutes[route.area]; i < areaPortalRoutes[route.area + 1]; i++ ) {
+			int q = portalRoutes[i].reverseRoute;
+			if ( q < 0 || portalRoutes[q].area == listenerArea ) {
+				continue;
+			}
+			soundPortalRoute_t &enter = portalRoutes[q];
+			float occlusionDistance = ( portalStates[enter.portalHandle - 1] & ( PS_BLOCK_VIEW | PS_BLOCK_AIR ) ) ? doorDistance : 0.0f;
+			float dist = route.distance + ( enter.center - route.center ).LengthFast() + occlusionDistance;
+			if ( enter.distance >= 0.0f && dist >= enter.distance ) {
+				continue;
+			}
+			enter.distance = dist;
+			enter.depth = route.depth + 1;
+			enter.lastRoute = route.lastRoute;
+			enter.prevRoute = ( route.depth == 1 ) ? q : route.prevRoute;
+			if ( !queued[q] ) {
+				queue.Append( q );
+				queued[q] = true;
+			}
+		}
+	}
+
+	portalRoutesArea = listenerArea;
+}
+
+/*
+===================
+idSoundWorldLocal::ResolveOriginCached
+
+Same as ResolveOrigin from the routes of UpdatePortalRoutes, only the exit portals of
+the sound area are checked. The virtual origin is placed on the portal entering the
+listener area. Returns false if the routes aren't valid for the listener area.
+  this is called by the main thread
+===================
+*/
+bool idSoundWorldLocal::ResolveOriginCached( const int soundArea, const idVec3& soundOrigin, idSoundEmitterLocal *def ) {
+	int i;
+
+	if ( !idSoundSystemLocal::s_portalRoutes.GetBool() || portalRoutesArea != listenerArea || soundArea < 0 || soundArea >= areaPortalRoutes.Num() - 1 ) {
+		return false;
+	}
+
+	// the listener side of every chain is the center of its last portal, it is refined below
+	int best = -1;
+	float bestDist = def->distance;
+	for ( i = areaPortalRoutes[soundArea]; i < areaPortalRoutes[soundArea + 1]; i++ ) {
+		const soundPortalRoute_t &route = portalRoutes[i];
+		if ( route.distance < 0.0f ) {
+			continue;
+		}
+		const soundPortalRoute_t &last = portalRoutes[route.lastRoute];
+		float dist = ( route.center - soundOrigin ).LengthFast() + route.distance + ( listenerQU - last.center ).LengthFast();
+		if ( dist < bestDist ) {
+			bestDist = dist;
+			best = i;
+		}
+	}
+
+	if ( best == -1 ) {
+		// we can't possibly hear the sound through any chain of portals
+		return true;
+	}
+
+	const soundPortalRoute_t &route = portalRoutes[best];
+	const soundPortalRoute_t &last = portalRoutes[route.lastRoute];
+
+	// distance to the portal before the last one, the last one already has the door distance
+	idVec3 from = soundOrigin;
+	float dist = last.distance;
+	if ( route.prevRoute != -1 ) {
+		from = portalRoutes[route.prevRoute].center;
+		dist += ( route.center - soundOrigin ).LengthFast() + route.distance - last.distance - ( last.center - from ).LengthFast();
+	}
+
+	exitPortal_t re = rw->GetPortal( last.area, last.portalNum );
+	idVec3 source = PortalSoundOrigin( re.w, from, listenerQU );
+
+	dist += ( source - from ).LengthFast() + ( listenerQU - source ).LengthFast();
+	if ( dist < def->distance ) {
+		def->distance = dist;
+		def->spatializedOrigin = source;
+	}
+
+	return true;
+}
+
 /*
 ===================
 idSoundWorldLocal::PlaceListener
@@ -977,6 +1479,18 @@ void idSoundWorldLocal::ForegroundUpdate( int current44kHzTime ) {
 	// although the sound may still need to play if it has
 	// just become occluded so it can ramp down to 0
 	//
+	double spatializeStart = Sys_GetClockTicks();
+
+	spatializeEmitters = 0;
+	spatializeCached = 0;
+	spatializeTraced = 0;
+
+	if ( idSoundSystemLocal::s_portalRoutes.GetBool() ) {
+		UpdatePortalRoutes();
+	}
+
+	spatializeTicks = Sys_GetClockTicks() - spatializeStart;
+
 	for ( j = 1; j < emitters.Num(); j++ ) {
 		def = emitters[j];
 
@@ -992,7 +1506,10 @@ void idSoundWorldLocal::ForegroundUpdate( int current44kHzTime ) {
 		}
 
 		// update virtual origin / distance, etc
+		spatializeStart = Sys_GetClockTicks();
 		def->Spatialize( listenerPos, listenerArea, rw );
+		spatializeTicks += Sys_GetClockTicks() - spatializeStart;
+		spatializeEmitters++;
 
 		// per-sound debug options
 		if ( idSoundSystemLocal::s_drawSounds.GetInteger() && rw ) {
@@ -1041,6 +1558,11 @@ void idSoundWorldLocal::ForegroundUpdate( int current44kHzTime ) {
 
 	Sys_LeaveCriticalSection();
 
+	if ( idSoundSystemLocal::s_showSpatialize.GetBool() ) {
+		common->Printf( "spatialize: %d emitters, %d cached, %d traced, %.3f msec\n", spatializeEmitters, spatializeCached, spatializeTraced,
+						spatializeTicks * 1000.0 / Sys_ClockTicksPerSecond() );
+	}
+
 	//
 	// the sound meter
 	//
@@ -1565,11 +2087,11 @@ Adds the contribution of a single sound channel to finalMixBuffer
 this is called from the async thread
 
 Mixes MIXBUFFER_SAMPLES samples starting at current44kHz sample time into
-finalMixBuffer
+finalMixBuffer, or queues them in mixBatch when it is not NULL
 ===============
 */
 void idSoundWorldLocal::AddChannelContribution( idSoundEmitterLocal *sound, idSoundChannel *chan,
-				   int current44kHz, int numSpeakers, float *finalMixBuffer ) {
+				   int current44kHz, int numSpeakers, float *finalMixBuffer, idSoundMixBatch *mixBatch ) {
 	int j;
 	float volume;
 
@@ -1886,7 +2408,9 @@ void idSoundWorldLocal::AddChannelContribution( idSoundEmitterLocal *sound, idSo
 			}
 		}
 
-		if ( numSpeakers == 6 ) {
+		if ( mixBatch ) {
+			mixBatch->AddChannel( alignedInputSamples, sample->objectInfo.nChannels, chan->lastV, ears );
+		} else if ( numSpeakers == 6 ) {
 			if ( sample->objectInfo.nChannels == 1 ) {
 				SIMDProcessor->MixSoundSixSpeakerMono( finalMixBuffer, alignedInputSamples, MIXBUFFER_SAMPLES, chan->lastV, ears );
 			} else {
@@ -1906,7 +2430,7 @@ void idSoundWorldLocal::AddChannelContribution( idSoundEmitterLocal *sound, idSo
 
 	}
 
-	soundSystemLocal.soundStats.activeSounds++;
+	Sys_InterlockedIncrement( soundSystemLocal.soundStats.activeSounds );
 
 }
 
@@ -37,6 +37,10 @@ If you have questions concerning this license or the applicable additional terms
 #include <sys/types.h>
 #include <fcntl.h>
 
+#if defined( __i386__ ) || defined( __x86_64__ )
+#include <cpuid.h>
+#endif
+
 #ifdef ID_MCHECK
 #include <mcheck.h>
 #endif
@@ -207,7 +211,59 @@ Sys_GetProcessorId
 ===============
 */
 cpuid_t Sys_GetProcessorId( void ) {
+#if defined( __i386__ ) || defined( __x86_64__ )
+	unsigned int eax, ebx, ecx, edx;
+	unsigned int maxLevel, vendorEBX;
+	int flags;
+
+	if ( !__get_cpuid( 0, &maxLevel, &vendorEBX, &ecx, &edx ) ) {
+		return CPUID_GENERIC;
+	}
+
+	// "Auth" of "AuthenticAMD"
+	flags = ( vendorEBX == 0x68747541 ) ? CPUID_AMD : CPUID_INTEL;
+
+	__get_cpuid( 1, &eax, &ebx, &ecx, &edx );
+	if ( edx & ( 1 << 23 ) ) {
+		flags |= CPUID_MMX;
+	}
+	if ( edx & ( 1 << 25 ) ) {
+		flags |= CPUID_SSE;
+	}
+	if ( edx & ( 1 << 26 ) ) {
+		flags |= CPUID_SSE2;
+	}
+	if ( ecx & ( 1 << 0 ) ) {
+		flags |= CPUID_SSE3;
+	}
+	if ( edx & ( 1 << 28 ) ) {
+		flags |= CPUID_HTT;
+	}
+	if ( edx & ( 1 << 15 ) ) {
+		flags |= CPUID_CMOV;
+	}
+
+	// the ymm registers are only usable when the kernel saves them on a context switch
+	if ( ecx & ( 1 << 27 ) ) {
+		unsigned int xcr0Low, xcr0High;
+		__asm__ __volatile__ ( "xgetbv" : "=a" ( xcr0Low ), "=d" ( xcr0High ) : "c" ( 0 ) );
+		if ( ( xcr0Low & 6 ) == 6 ) {
+			if ( ecx & ( 1 << 12 ) ) {
+				flags |= CPUID_FMA;
+			}
+			if ( maxLevel >= 7 ) {
+				__cpuid_count( 7, 0, eax, ebx, ecx, edx );
+				if ( ebx & ( 1 << 5 ) ) {
+					flags |= CPUID_AVX2;
+				}
+			}
+		}
+	}
+
+	return (cpuid_t)flags;
+#else
 	return CPUID_GENERIC;
+#endif
 }
 
 /*
@@ -216,7 +272,39 @@ Sys_GetProcessorString
 ===============
 */
 const char *Sys_GetProcessorString( void ) {
-	return "generic";
+	static idStr string;
+	int cpuid = Sys_GetProcessorId();
+
+	if ( cpuid == CPUID_GENERIC ) {
+		return "generic";
+	}
+
+	string = ( cpuid & CPUID_AMD ) ? "AMD CPU" : "Intel CPU";
+	string += " with ";
+	if ( cpuid & CPUID_MMX ) {
+		string += "MMX & ";
+	}
+	if ( cpuid & CPUID_SSE ) {
+		string += "SSE & ";
+	}
+	if ( cpuid & CPUID_SSE2 ) {
+		string += "SSE2 & ";
+	}
+	if ( cpuid & CPUID_SSE3 ) {
+		string += "SSE3 & ";
+	}
+	if ( cpuid & CPUID_AVX2 ) {
+		string += "AVX2 & ";
+	}
+	if ( cpuid & CPUID_FMA ) {
+		string += "FMA & ";
+	}
+	if ( cpuid & CPUID_HTT ) {
+		string += "HTT & ";
+	}
+	string.StripTrailing( " & " );
+	string.StripTrailing( " with " );
+	return string.c_str();
 }
 
 /*
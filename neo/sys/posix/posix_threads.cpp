@@ -35,6 +35,7 @@ If you have questions concerning this license or the applicable additional terms
 #include <sys/time.h>
 #include <pwd.h>
 #include <pthread.h>
+#include <sched.h>
 
 #include "../../idlib/precompiled.h"
 #include "posix_public.h"
@@ -142,6 +143,131 @@ void Sys_TriggerEvent( int index ) {
 	Sys_LeaveCriticalSection( MAX_LOCAL_CRITICAL_SECTIONS - 1 );
 }
 
+/*
+======================================================
+signals
+======================================================
+*/
+
+typedef struct {
+	pthread_mutex_t		mutex;
+	pthread_cond_t		cond;
+	bool				manualReset;
+	bool				raised;
+} posixSignal_t;
+
+/*
+==================
+Sys_SignalCreate
+==================
+*/
+signalHandle_t Sys_SignalCreate( bool manualReset ) {
+	posixSignal_t *signal = new posixSignal_t;
+	pthread_mutex_init( &signal->mutex, NULL );
+	pthread_cond_init( &signal->cond, NULL );
+	signal->manualReset = manualReset;
+	signal->raised = false;
+	return (signalHandle_t) signal;
+}
+
+/*
+==================
+Sys_SignalDestroy
+==================
+*/
+void Sys_SignalDestroy( signalHandle_t handle ) {
+	posixSignal_t *signal = (posixSignal_t *) handle;
+	pthread_cond_destroy( &signal->cond );
+	pthread_mutex_destroy( &signal->mutex );
+	delete signal;
+}
+
+/*
+==================
+Sys_SignalRaise
+==================
+*/
+void Sys_SignalRaise( signalHandle_t handle ) {
+	posixSignal_t *signal = (posixSignal_t *) handle;
+	pthread_mutex_lock( &signal->mutex );
+	signal->raised = true;
+	if ( signal->manualReset ) {
+		pthread_cond_broadcast( &signal->cond );
+	} else {
+		pthread_cond_signal( &signal->cond );
+	}
+	pthread_mutex_unlock( &signal->mutex );
+}
+
+/*
+==================
+Sys_SignalClear
+==================
+*/
+void Sys_SignalClear( signalHandle_t handle ) {
+	posixSignal_t *signal = (posixSignal_t *) handle;
+	pthread_mutex_lock( &signal->mutex );
+	signal->raised = false;
+	pthread_mutex_unlock( &signal->mutex );
+}
+
+/*
+==================
+Sys_SignalWait
+==================
+*/
+bool Sys_SignalWait( signalHandle_t handle, int timeout ) {
+	posixSignal_t *signal = (posixSignal_t *) handle;
+	struct timespec ts;
+	int result = 0;
+
+	if ( timeout != SIGNAL_WAIT_INFINITE ) {
+		struct timeval tv;
+		gettimeofday( &tv, NULL );
+		ts.tv_sec = tv.tv_sec + timeout / 1000;
+		ts.tv_nsec = ( tv.tv_usec + ( timeout % 1000 ) * 1000 ) * 1000;
+		if ( ts.tv_nsec >= 1000000000 ) {
+			ts.tv_sec++;
+			ts.tv_nsec -= 1000000000;
+		}
+	}
+
+	pthread_mutex_lock( &signal->mutex );
+	while ( !signal->raised && result != ETIMEDOUT ) {
+		if ( timeout == SIGNAL_WAIT_INFINITE ) {
+			pthread_cond_wait( &signal->cond, &signal->mutex );
+		} else {
+			result = pthread_cond_timedwait( &signal->cond, &signal->mutex, &ts );
+		}
+	}
+	bool raised = signal->raised;
+	if ( !signal->manualReset ) {
+		signal->raised = false;
+	}
+	pthread_mutex_unlock( &signal->mutex );
+
+	return raised;
+}
+
+/*
+==================
+Sys_NumCpuCores
+==================
+*/
+int Sys_NumCpuCores( void ) {
+	long count = sysconf( _SC_NPROCESSORS_ONLN );
+	return ( count > 0 ) ? (int)count : 1;
+}
+
+/*
+==================
+Sys_Yield
+==================
+*/
+void Sys_Yield( void ) {
+	sched_yield();
+}
+
 /*
 ======================================================
 thread create and destroy
@@ -149,7 +275,6 @@ thread create and destroy
 */
 
 // not a hard limit, just what we keep track of for debugging
-#define MAX_THREADS 10
 xthreadInfo *g_threads[MAX_THREADS];
 
 int g_thread_count = 0;
@@ -189,7 +314,9 @@ Sys_DestroyThread
 void Sys_DestroyThread( xthreadInfo& info ) {
 	// the target thread must have a cancelation point, otherwise pthread_cancel is useless
 	assert( info.threadHandle );
-	if ( pthread_cancel( ( pthread_t )info.threadHandle ) != 0 ) {
+	// a thread that already returned can't be canceled, but still has to be joined
+	int result = pthread_cancel( ( pthread_t )info.threadHandle );
+	if ( result != 0 && result != ESRCH ) {
 		common->Error( "ERROR: pthread_cancel %s failed\n", info.name );
 	}
 	if ( pthread_join( ( pthread_t )info.threadHandle, NULL ) != 0 ) {
@@ -107,7 +107,7 @@ If you have questions concerning this license or the applicable additional terms
 #endif
 
 #define _alloca							alloca
-#define _alloca16( x )					((void *)((((int)alloca( (x)+15 )) + 15) & ~15))
+#define _alloca16( x )					((void *)((((intptr_t)alloca( (x)+15 )) + 15) & ~15))
 
 #define PATHSEPERATOR_STR				"/"
 #define PATHSEPERATOR_CHAR				'/'
@@ -138,7 +138,7 @@ If you have questions concerning this license or the applicable additional terms
 #endif
 
 #define _alloca							alloca
-#define _alloca16( x )					((void *)((((int)alloca( (x)+15 )) + 15) & ~15))
+#define _alloca16( x )					((void *)((((intptr_t)alloca( (x)+15 )) + 15) & ~15))
 
 #define ALIGN16( x )					x
 #define PACKED							__attribute__((packed))
@@ -174,6 +174,8 @@ typedef enum {
 	CPUID_SSE2							= 0x00080,	// Streaming SIMD Extensions 2
 	CPUID_SSE3							= 0x00100,	// Streaming SIMD Extentions 3 aka Prescott's New Instructions
 	CPUID_ALTIVEC						= 0x00200,	// AltiVec
+	CPUID_AVX2							= 0x00400,	// Advanced Vector Extensions 2 with operating system support for the ymm registers
+	CPUID_FMA							= 0x00800,	// Fused Multiply-Add (FMA3) instructions
 	CPUID_HTT							= 0x01000,	// Hyper-Threading Technology
 	CPUID_CMOV							= 0x02000,	// Conditional Move (CMOV) and fast floating point comparison (FCOMI) instructions
 	CPUID_FTZ							= 0x04000,	// Flush-To-Zero mode (denormal results are flushed to zero)
@@ -514,7 +516,7 @@ typedef struct {
 	unsigned long	threadId;
 } xthreadInfo;
 
-const int MAX_THREADS				= 10;
+const int MAX_THREADS				= 32;
 extern xthreadInfo *g_threads[MAX_THREADS];
 extern int			g_thread_count;
 
@@ -549,6 +551,89 @@ enum {
 void				Sys_WaitForEvent( int index = TRIGGER_EVENT_ZERO );
 void				Sys_TriggerEvent( int index = TRIGGER_EVENT_ZERO );
 
+// signals can be created on demand, unlike the trigger events above
+// an auto reset signal is cleared when a single waiting thread is released
+typedef intptr_t	signalHandle_t;
+
+const int SIGNAL_WAIT_INFINITE		= -1;
+
+signalHandle_t		Sys_SignalCreate( bool manualReset );
+void				Sys_SignalDestroy( signalHandle_t handle );
+void				Sys_SignalRaise( signalHandle_t handle );
+void				Sys_SignalClear( signalHandle_t handle );
+// returns false if the timeout (in milliseconds) expired
+bool				Sys_SignalWait( signalHandle_t handle, int timeout );
+
+// number of logical processors the process can run on
+int					Sys_NumCpuCores( void );
+// give up the rest of the time slice
+void				Sys_Yield( void );
+
+/*
+==============================================================
+
+	Atomic operations
+
+	These are inline so they can be used from idLib and the game module
+	as well as the engine. All of them are full memory barriers.
+
+==============================================================
+*/
+
+#ifdef _WIN32
+
+#include <intrin.h>
+
+#define ID_THREAD_LOCAL					__declspec( thread )
+
+ID_INLINE int	Sys_InterlockedIncrement( volatile int &value ) { return _InterlockedIncrement( (volatile long *)&value ); }
+ID_INLINE int	Sys_InterlockedDecrement( volatile int &value ) { return _InterlockedDecrement( (volatile long *)&value ); }
+ID_INLINE int	Sys_InterlockedAdd( volatile int &value, int i ) { return _InterlockedExchangeAdd( (volatile long *)&value, i ) + i; }
+ID_INLINE int	Sys_InterlockedExchange( volatile int &value, int exchange ) { return _InterlockedExchange( (volatile long *)&value, exchange ); }
+ID_INLINE int	Sys_InterlockedCompareExchange( volatile int &value, int comparand, int exchange ) { return _InterlockedCompareExchange( (volatile long *)&value, exchange, comparand ); }
+ID_INLINE void *Sys_InterlockedExchangePointer( void * volatile &ptr, void *exchange ) { return _InterlockedExchangePointer( &ptr, exchange ); }
+ID_INLINE void *Sys_InterlockedCompareExchangePointer( void * volatile &ptr, void *comparand, void *exchange ) { return _InterlockedCompareExchangePointer( &ptr, exchange, comparand ); }
+ID_INLINE void	Sys_CpuPause( void ) { _mm_pause(); }
+
+#else
+
+#define ID_THREAD_LOCAL					__thread
+
+ID_INLINE int	Sys_InterlockedIncrement( volatile int &value ) { return __atomic_add_fetch( &value, 1, __ATOMIC_SEQ_CST ); }
+ID_INLINE int	Sys_InterlockedDecrement( volatile int &value ) { return __atomic_sub_fetch( &value, 1, __ATOMIC_SEQ_CST ); }
+ID_INLINE int	Sys_InterlockedAdd( volatile int &value, int i ) { return __atomic_add_fetch( &value, i, __ATOMIC_SEQ_CST ); }
+ID_INLINE int	Sys_InterlockedExchange( volatile int &value, int exchange ) { return __atomic_exchange_n( &value, exchange, __ATOMIC_SEQ_CST ); }
+ID_INLINE int	Sys_InterlockedCompareExchange( volatile int &value, int comparand, int exchange ) { return __sync_val_compare_and_swap( &value, comparand, exchange ); }
+ID_INLINE void *Sys_InterlockedExchangePointer( void * volatile &ptr, void *exchange ) { return __atomic_exchange_n( &ptr, exchange, __ATOMIC_SEQ_CST ); }
+ID_INLINE void *Sys_InterlockedCompareExchangePointer( void * volatile &ptr, void *comparand, void *exchange ) { return __sync_val_compare_and_swap( &ptr, comparand, exchange ); }
+#if defined( __i386__ ) || defined( __x86_64__ )
+ID_INLINE void	Sys_CpuPause( void ) { __builtin_ia32_pause(); }
+#else
+ID_INLINE void	Sys_CpuPause( void ) { }
+#endif
+
+#endif
+
+/*
+================================================
+idSysSpinLock
+
+Busy waiting lock for very short critical sections, usable from any
+module. Never hold one across anything that can block.
+================================================
+*/
+class idSysSpinLock {
+public:
+					idSysSpinLock( void ) : locked( 0 ) {}
+
+	void			Lock( void ) { while ( Sys_InterlockedCompareExchange( locked, 0, 1 ) != 0 ) { while ( locked ) { Sys_CpuPause(); } } }
+	bool			TryLock( void ) { return Sys_InterlockedCompareExchange( locked, 0, 1 ) == 0; }
+	void			Unlock( void ) { Sys_InterlockedExchange( locked, 0 ); }
+
+private:
+	volatile int	locked;
+};
+
 /*
 ==============================================================
 
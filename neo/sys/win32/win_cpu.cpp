@@ -30,6 +30,8 @@ If you have questions concerning this license or the applicable additional terms
 #pragma hdrstop
 
 #include "win_local.h"
+#include <intrin.h>
+#include <immintrin.h>
 
 
 /*
@@ -354,6 +356,81 @@ static bool HasSSE3( void ) {
 	return false;
 }
 
+/*
+================
+HasOSXSAVE
+
+  the operating system saves the ymm registers on a context switch
+================
+*/
+static bool HasOSXSAVE( void ) {
+	unsigned regs[4];
+
+	// get CPU feature bits
+	CPUID( 1, regs );
+
+	// bit 27 of ECX denotes XGETBV and OS support for XSAVE
+	if ( !( regs[_REG_ECX] & ( 1 << 27 ) ) ) {
+		return false;
+	}
+
+	// bits 1 and 2 of XCR0 denote the xmm and ymm state is saved
+	if ( ( _xgetbv( 0 ) & 6 ) != 6 ) {
+		return false;
+	}
+	return true;
+}
+
+/*
+================
+HasAVX2
+================
+*/
+static bool HasAVX2( void ) {
+	unsigned regs[4];
+	int info[4];
+
+	CPUID( 0, regs );
+	if ( regs[_REG_EAX] < 7 ) {
+		return false;
+	}
+
+	if ( !HasOSXSAVE() ) {
+		return false;
+	}
+
+	// get structured extended feature bits
+	__cpuidex( info, 7, 0 );
+
+	// bit 5 of EBX denotes AVX2 existence
+	if ( info[_REG_EBX] & ( 1 << 5 ) ) {
+		return true;
+	}
+	return false;
+}
+
+/*
+================
+HasFMA
+================
+*/
+static bool HasFMA( void ) {
+	unsigned regs[4];
+
+	if ( !HasOSXSAVE() ) {
+		return false;
+	}
+
+	// get CPU feature bits
+	CPUID( 1, regs );
+
+	// bit 12 of ECX denotes FMA3 existence
+	if ( regs[_REG_ECX] & ( 1 << 12 ) ) {
+		return true;
+	}
+	return false;
+}
+
 /*
 ================
 LogicalProcPerPhysicalProc
@@ -610,6 +687,16 @@ cpuid_t Sys_GetCPUId( void ) {
 		flags |= CPUID_SSE3;
 	}
 
+	// check for Advanced Vector Extensions 2
+	if ( HasAVX2() ) {
+		flags |= CPUID_AVX2;
+	}
+
+	// check for Fused Multiply-Add
+	if ( HasFMA() ) {
+		flags |= CPUID_FMA;
+	}
+
 	// check for Hyper-Threading Technology
 	if ( HasHTT() ) {
 		flags |= CPUID_HTT;
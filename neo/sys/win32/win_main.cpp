@@ -200,6 +200,88 @@ void Sys_TriggerEvent( int index ) {
 	SetEvent( win32.backgroundDownloadSemaphore );
 }
 
+/*
+==================
+Sys_SignalCreate
+==================
+*/
+signalHandle_t Sys_SignalCreate( bool manualReset ) {
+	HANDLE handle = CreateEvent( NULL, manualReset, FALSE, NULL );
+	if ( !handle ) {
+		common->FatalError( "Sys_SignalCreate: CreateEvent failed (%d)", GetLastError() );
+	}
+	return (signalHandle_t) handle;
+}
+
+/*
+==================
+Sys_SignalDestroy
+==================
+*/
+void Sys_SignalDestroy( signalHandle_t handle ) {
+	CloseHandle( (HANDLE) handle );
+}
+
+/*
+==================
+Sys_SignalRaise
+==================
+*/
+void Sys_SignalRaise( signalHandle_t handle ) {
+	SetEvent( (HANDLE) handle );
+}
+
+/*
+==================
+Sys_SignalClear
+==================
+*/
+void Sys_SignalClear( signalHandle_t handle ) {
+	ResetEvent( (HANDLE) handle );
+}
+
+/*
+==================
+Sys_SignalWait
+==================
+*/
+bool Sys_SignalWait( signalHandle_t handle, int timeout ) {
+	DWORD result = WaitForSingleObject( (HANDLE) handle, timeout == SIGNAL_WAIT_INFINITE ? INFINITE : timeout );
+	assert( result == WAIT_OBJECT_0 || ( timeout != SIGNAL_WAIT_INFINITE && result == WAIT_TIMEOUT ) );
+	return ( result == WAIT_OBJECT_0 );
+}
+
+/*
+==================
+Sys_NumCpuCores
+==================
+*/
+int Sys_NumCpuCores( void ) {
+	DWORD_PTR processMask, systemMask;
+	int count = 0;
+
+	if ( GetProcessAffinityMask( GetCurrentProcess(), &processMask, &systemMask ) ) {
+		for ( ; processMask; processMask &= processMask - 1 ) {
+			count++;
+		}
+	}
+	if ( count <= 0 ) {
+		SYSTEM_INFO info;
+		GetSystemInfo( &info );
+		count = info.dwNumberOfProcessors;
+	}
+	return Max( count, 1 );
+}
+
+/*
+==================
+Sys_Yield
+==================
+*/
+void Sys_Yield( void ) {
+	SwitchToThread();
+}
+
 
 
 #pragma optimize( "", on )
@@ -1075,6 +1157,12 @@ void Sys_Init( void ) {
 		if ( win32.cpuid & CPUID_SSE3 ) {
 			string += "SSE3 & ";
 		}
+		if ( win32.cpuid & CPUID_AVX2 ) {
+			string += "AVX2 & ";
+		}
+		if ( win32.cpuid & CPUID_FMA ) {
+			string += "FMA & ";
+		}
 		if ( win32.cpuid & CPUID_HTT ) {
 			string += "HTT & ";
 		}
@@ -1104,6 +1192,10 @@ void Sys_Init( void ) {
 				id |= CPUID_SSE2;
 			} else if ( token.Icmp( "sse3" ) == 0 ) {
 				id |= CPUID_SSE3;
+			} else if ( token.Icmp( "avx2" ) == 0 ) {
+				id |= CPUID_AVX2;
+			} else if ( token.Icmp( "fma" ) == 0 ) {
+				id |= CPUID_FMA;
 			} else if ( token.Icmp( "htt" ) == 0 ) {
 				id |= CPUID_HTT;
 			}